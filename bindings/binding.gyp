@@ -4,8 +4,7 @@
       "target_name": "darling",
       "sources": [
         "src/darling_node.cc",
-        "../core/src/darling.c",
-        "../core/src/platform/win32/window_win32.c"
+        "../core/src/darling.c"
       ],
       "include_dirs": [
         "../core/include",
@@ -21,7 +20,14 @@
         "NAPI_DISABLE_CPP_EXCEPTIONS"   
       ],
       "conditions": [
+        ["OS!='win'", {
+          "sources": [ "../core/src/platform/headless/window_headless.c" ]
+        }],
+        ["OS=='linux'", {
+          "libraries": [ "-lrt" ]
+        }],
         ["OS=='win'", {
+          "sources": [ "../core/src/platform/win32/window_win32.c" ],
           "msvs_settings": {
             "VCCLCompilerTool": {
               "ExceptionHandling": 1,
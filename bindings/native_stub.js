@@ -9,6 +9,21 @@ module.exports = {
     onCloseRequestedForWindow() {
         throw new Error('native addon not built — onCloseRequestedForWindow() not available')
     },
+    onDpiChangedForWindow() {
+        throw new Error('native addon not built — onDpiChangedForWindow() not available')
+    },
+    onFrameRequestedForWindow() {
+        throw new Error('native addon not built — onFrameRequestedForWindow() not available')
+    },
+    onTilesRequestedForWindow() {
+        throw new Error('native addon not built — onTilesRequestedForWindow() not available')
+    },
+    onVisibilityChangedForWindow() {
+        throw new Error('native addon not built — onVisibilityChangedForWindow() not available')
+    },
+    onAnimationDoneForWindow() {
+        throw new Error('native addon not built — onAnimationDoneForWindow() not available')
+    },
     setParent() {
         throw new Error('native addon not built — setParent() not available')
     },
@@ -72,6 +87,45 @@ module.exports = {
     setCornerPreference() {
         throw new Error('native addon not built — setCornerPreference() not available')
     },
+    beginAppearanceUpdate() {
+        throw new Error('native addon not built — beginAppearanceUpdate() not available')
+    },
+    commitAppearanceUpdate() {
+        throw new Error('native addon not built — commitAppearanceUpdate() not available')
+    },
+    layoutAdd() {
+        throw new Error('native addon not built — layoutAdd() not available')
+    },
+    layoutSetChild() {
+        throw new Error('native addon not built — layoutSetChild() not available')
+    },
+    layoutSetSize() {
+        throw new Error('native addon not built — layoutSetSize() not available')
+    },
+    layoutSetActive() {
+        throw new Error('native addon not built — layoutSetActive() not available')
+    },
+    layoutClear() {
+        throw new Error('native addon not built — layoutClear() not available')
+    },
+    layoutApply() {
+        throw new Error('native addon not built — layoutApply() not available')
+    },
+    hitRegionAdd() {
+        throw new Error('native addon not built — hitRegionAdd() not available')
+    },
+    hitRegionSet() {
+        throw new Error('native addon not built — hitRegionSet() not available')
+    },
+    hitRegionRemove() {
+        throw new Error('native addon not built — hitRegionRemove() not available')
+    },
+    hitRegionClear() {
+        throw new Error('native addon not built — hitRegionClear() not available')
+    },
+    hitTest() {
+        throw new Error('native addon not built — hitTest() not available')
+    },
     flashWindow() {
         throw new Error('native addon not built — flashWindow() not available')
     },
@@ -80,5 +134,200 @@ module.exports = {
     },
     getScaleFactor() {
         throw new Error('native addon not built — getScaleFactor() not available')
+    },
+    setMemoryBudget() {
+        throw new Error('native addon not built — setMemoryBudget() not available')
+    },
+    getMemoryStats() {
+        throw new Error('native addon not built — getMemoryStats() not available')
+    },
+    setThreadPool() {
+        throw new Error('native addon not built — setThreadPool() not available')
+    },
+    getThreadPoolStats() {
+        throw new Error('native addon not built — getThreadPoolStats() not available')
+    },
+    getWindowMemoryStats() {
+        throw new Error('native addon not built — getWindowMemoryStats() not available')
+    },
+    inputRingBytes() {
+        throw new Error('native addon not built — inputRingBytes() not available')
+    },
+    attachInputRing() {
+        throw new Error('native addon not built — attachInputRing() not available')
+    },
+    detachInputRing() {
+        throw new Error('native addon not built — detachInputRing() not available')
+    },
+    stateMirrorBytes() {
+        throw new Error('native addon not built — stateMirrorBytes() not available')
+    },
+    attachStateMirror() {
+        throw new Error('native addon not built — attachStateMirror() not available')
+    },
+    detachStateMirror() {
+        throw new Error('native addon not built — detachStateMirror() not available')
+    },
+    getInputStats() {
+        throw new Error('native addon not built — getInputStats() not available')
+    },
+    inputNow() {
+        throw new Error('native addon not built — inputNow() not available')
+    },
+    paintFrameWindow() {
+        throw new Error('native addon not built — paintFrameWindow() not available')
+    },
+    paintFrameHwnd() {
+        throw new Error('native addon not built — paintFrameHwnd() not available')
+    },
+    frameRingPresentHwnd() {
+        throw new Error('native addon not built — frameRingPresentHwnd() not available')
+    },
+    paintYuvWindow() {
+        throw new Error('native addon not built — paintYuvWindow() not available')
+    },
+    getFrameRecord() {
+        throw new Error('native addon not built — getFrameRecord() not available')
+    },
+    getFrameTiming() {
+        throw new Error('native addon not built — getFrameTiming() not available')
+    },
+    resetFrameTiming() {
+        throw new Error('native addon not built — resetFrameTiming() not available')
+    },
+    setFrameOverlay() {
+        throw new Error('native addon not built — setFrameOverlay() not available')
+    },
+    layerCreate() {
+        throw new Error('native addon not built — layerCreate() not available')
+    },
+    layerDestroy() {
+        throw new Error('native addon not built — layerDestroy() not available')
+    },
+    layerSetPosition() {
+        throw new Error('native addon not built — layerSetPosition() not available')
+    },
+    layerSetZ() {
+        throw new Error('native addon not built — layerSetZ() not available')
+    },
+    layerSetOpacity() {
+        throw new Error('native addon not built — layerSetOpacity() not available')
+    },
+    layerSetVisible() {
+        throw new Error('native addon not built — layerSetVisible() not available')
+    },
+    layerUpdate() {
+        throw new Error('native addon not built — layerUpdate() not available')
+    },
+    getCompositorStats() {
+        throw new Error('native addon not built — getCompositorStats() not available')
+    },
+    frameRingCreate() {
+        throw new Error('native addon not built — frameRingCreate() not available')
+    },
+    frameRingClose() {
+        throw new Error('native addon not built — frameRingClose() not available')
+    },
+    frameRingPresent() {
+        throw new Error('native addon not built — frameRingPresent() not available')
+    },
+    getFrameRingStats() {
+        throw new Error('native addon not built — getFrameRingStats() not available')
+    },
+    getThumbnail() {
+        throw new Error('native addon not built — getThumbnail() not available')
+    },
+    releaseThumbnails() {
+        throw new Error('native addon not built — releaseThumbnails() not available')
+    },
+    getThumbnailStats() {
+        throw new Error('native addon not built — getThumbnailStats() not available')
+    },
+    saveSnapshot() {
+        throw new Error('native addon not built — saveSnapshot() not available')
+    },
+    readSnapshotInfo() {
+        throw new Error('native addon not built — readSnapshotInfo() not available')
+    },
+    setSplashSnapshot() {
+        throw new Error('native addon not built — setSplashSnapshot() not available')
+    },
+    endSplash() {
+        throw new Error('native addon not built — endSplash() not available')
+    },
+    getSplashStats() {
+        throw new Error('native addon not built — getSplashStats() not available')
+    },
+    drawSubmit() {
+        throw new Error('native addon not built — drawSubmit() not available')
+    },
+    drawImageUpload() {
+        throw new Error('native addon not built — drawImageUpload() not available')
+    },
+    drawImageRelease() {
+        throw new Error('native addon not built — drawImageRelease() not available')
+    },
+    getDrawStats() {
+        throw new Error('native addon not built — getDrawStats() not available')
+    },
+    surfaceCreate() {
+        throw new Error('native addon not built — surfaceCreate() not available')
+    },
+    surfaceClose() {
+        throw new Error('native addon not built — surfaceClose() not available')
+    },
+    surfaceUploadTile() {
+        throw new Error('native addon not built — surfaceUploadTile() not available')
+    },
+    surfaceScrollTo() {
+        throw new Error('native addon not built — surfaceScrollTo() not available')
+    },
+    surfaceInvalidate() {
+        throw new Error('native addon not built — surfaceInvalidate() not available')
+    },
+    getSurfaceStats() {
+        throw new Error('native addon not built — getSurfaceStats() not available')
+    },
+    setThrottlePolicy() {
+        throw new Error('native addon not built — setThrottlePolicy() not available')
+    },
+    getPowerStats() {
+        throw new Error('native addon not built — getPowerStats() not available')
+    },
+    setPresentMode() {
+        throw new Error('native addon not built — setPresentMode() not available')
+    },
+    getPresentStats() {
+        throw new Error('native addon not built — getPresentStats() not available')
+    },
+    animate() {
+        throw new Error('native addon not built — animate() not available')
+    },
+    animateCancel() {
+        throw new Error('native addon not built — animateCancel() not available')
+    },
+    getAnimationStats() {
+        throw new Error('native addon not built — getAnimationStats() not available')
+    },
+    createWindowAsync() {
+        throw new Error('native addon not built — createWindowAsync() not available')
+    },
+    setAppearanceAsync() {
+        throw new Error('native addon not built — setAppearanceAsync() not available')
+    },
+    showWindowAsync() {
+        throw new Error('native addon not built — showWindowAsync() not available')
+    },
+    hideWindowAsync() {
+        throw new Error('native addon not built — hideWindowAsync() not available')
+    },
+    focusWindowAsync() {
+        throw new Error('native addon not built — focusWindowAsync() not available')
+    },
+    cancelAsync() {
+        throw new Error('native addon not built — cancelAsync() not available')
+    },
+    getUiThreadStats() {
+        throw new Error('native addon not built — getUiThreadStats() not available')
     }
 }
\ No newline at end of file
@@ -8,40 +8,138 @@
 #endif
 #include <windows.h>
 #endif
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "darling.h"
 
 using namespace Napi;
 
-static ThreadSafeFunction tsfn_on_close;
-static std::unordered_map<uint64_t, ThreadSafeFunction> tsfn_on_close_by_hwnd;
-static std::mutex g_close_callbacks_mutex;
+struct DarlingAsyncOp;
+
+// Per-environment state. The addon may be loaded by the main thread and by
+// any number of worker_threads; each Node environment gets its own instance,
+// torn down by a cleanup hook when the environment exits.
+struct DarlingAddonData {
+    ThreadSafeFunction onClose;
+
+    // Input rings live in JS-owned SharedArrayBuffers; hold a reference while
+    // attached so the memory outlives native writes. This environment's
+    // thread only.
+    std::unordered_map<uint64_t, Napi::ObjectReference> inputRingByHwnd;
+
+    // State mirrors likewise; the window writes a final record as it is
+    // destroyed, so these are released after it.
+    std::unordered_map<uint64_t, Napi::ObjectReference> stateMirrorByHwnd;
+
+    // Windows created here, destroyed with the environment, and the subset
+    // created on the UI thread by createWindowAsync, which is destroyed
+    // there. Guarded by g_callbacks_mutex.
+    std::unordered_set<DarlingWindow*> windows;
+    std::unordered_set<DarlingWindow*> uiWindows;
+
+    // Async operations not yet settled, by id, and how many target each
+    // window; destroying a window this thread owns waits for them. This
+    // environment's thread only.
+    std::unordered_map<uint32_t, DarlingAsyncOp*> asyncOps;
+    std::unordered_map<DarlingWindow*, uint32_t> asyncOpsByWindow;
+    std::unordered_set<DarlingWindow*> destroyAfterOps;
+    uint32_t nextAsyncId = 1;
+};
+
+// The core library's callbacks are process-wide, so per-window callbacks
+// are registered process-wide as well, each tagged with the environment
+// whose ThreadSafeFunction it is.
+struct DarlingCallback {
+    ThreadSafeFunction tsfn;
+    DarlingAddonData* owner;
+};
+
+using DarlingCallbackMap = std::unordered_map<uint64_t, DarlingCallback>;
+
+// Callbacks are invoked with the mutex held so an environment shutting down
+// cannot release one mid-call; BlockingCall on an unbounded queue does not
+// block.
+static std::mutex g_callbacks_mutex;
+static std::unordered_set<DarlingAddonData*> g_environments;
+static DarlingCallbackMap g_close_by_hwnd;
+static DarlingCallbackMap g_dpi_by_hwnd;
+static DarlingCallbackMap g_frame_request_by_hwnd;
+static DarlingCallbackMap g_tile_request_by_hwnd;
+static DarlingCallbackMap g_visibility_by_hwnd;
+static DarlingCallbackMap g_animation_by_hwnd;
 static bool g_close_hook_registered = false;
+static bool g_dpi_hook_registered = false;
+static bool g_frame_request_hook_registered = false;
+static bool g_tile_request_hook_registered = false;
+static bool g_visibility_hook_registered = false;
+static bool g_animation_hook_registered = false;
 
-static void c_callback_on_close() {
-    if (tsfn_on_close) {
-        tsfn_on_close.BlockingCall();
+static DarlingAddonData* addon_data(Napi::Env env) {
+    return env.GetInstanceData<DarlingAddonData>();
+}
+
+// Replace the callback for `hwnd`, releasing the previous one.
+static void set_callback(DarlingCallbackMap& map, uint64_t hwnd, ThreadSafeFunction tsfn, DarlingAddonData* owner) {
+    auto it = map.find(hwnd);
+    if (it != map.end() && it->second.tsfn) {
+        it->second.tsfn.Release();
     }
+    map[hwnd] = DarlingCallback{ tsfn, owner };
 }
 
-// C-side close callback trampoline.
-static void c_callback_on_close_hwnd(uintptr_t hwnd) {
-    ThreadSafeFunction hwnd_tsfn;
+static void erase_callback(DarlingCallbackMap& map, uint64_t hwnd) {
+    auto it = map.find(hwnd);
+    if (it != map.end()) {
+        if (it->second.tsfn) {
+            it->second.tsfn.Release();
+        }
+        map.erase(it);
+    }
+}
 
-    {
-        std::lock_guard<std::mutex> lock(g_close_callbacks_mutex);
-        auto it = tsfn_on_close_by_hwnd.find((uint64_t)hwnd);
-        if (it != tsfn_on_close_by_hwnd.end()) {
-            hwnd_tsfn = it->second;
+// Release every callback an environment registered.
+static void erase_callbacks_of(DarlingCallbackMap& map, DarlingAddonData* owner) {
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->second.owner == owner) {
+            if (it->second.tsfn) {
+                it->second.tsfn.Release();
+            }
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// C-side close callback for the main window: every environment that asked
+// is told.
+static void c_callback_on_close() {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    for (DarlingAddonData* data : g_environments) {
+        if (data->onClose) {
+            data->onClose.BlockingCall();
         }
     }
+}
 
-    if (hwnd_tsfn) {
-        hwnd_tsfn.BlockingCall();
+// C-side close callback trampoline.
+static void c_callback_on_close_hwnd(uintptr_t hwnd) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_close_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_close_by_hwnd.end() && it->second.tsfn) {
+        it->second.tsfn.BlockingCall();
     }
 }
 
+// Called with g_callbacks_mutex held.
 static void ensure_close_hook_registered() {
     if (!g_close_hook_registered) {
         darling_set_close_callback_hwnd(c_callback_on_close_hwnd);
@@ -49,6 +147,133 @@ static void ensure_close_hook_registered() {
     }
 }
 
+// C-side DPI change trampoline; the JS callback receives the new DPI.
+static void c_callback_on_dpi_changed(uintptr_t hwnd, uint32_t dpi) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_dpi_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_dpi_by_hwnd.end() && it->second.tsfn) {
+        it->second.tsfn.BlockingCall([dpi](Napi::Env env, Function callback) {
+            callback.Call({ Napi::Number::New(env, dpi) });
+        });
+    }
+}
+
+// C-side frame request trampoline for windows whose backing store was released.
+static void c_callback_on_frame_request(uintptr_t hwnd) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_frame_request_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_frame_request_by_hwnd.end() && it->second.tsfn) {
+        it->second.tsfn.BlockingCall();
+    }
+}
+
+// C-side tile request trampoline; the JS callback receives the tiles as a
+// flat array of column, row pairs.
+static void c_callback_on_tile_request(uintptr_t hwnd, const int32_t* tiles, uint32_t count) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_tile_request_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_tile_request_by_hwnd.end() && it->second.tsfn) {
+        auto pairs = std::make_shared<std::vector<int32_t>>(tiles, tiles + (size_t)count * 2u);
+        it->second.tsfn.BlockingCall([pairs](Napi::Env env, Function callback) {
+            Napi::Array array = Napi::Array::New(env, pairs->size());
+            for (uint32_t i = 0; i < pairs->size(); i++) {
+                array.Set(i, Napi::Number::New(env, (*pairs)[i]));
+            }
+            callback.Call({ array });
+        });
+    }
+}
+
+// C-side visibility trampoline; the JS callback receives the visibility,
+// whether the window is throttled and the rate asked of producers.
+static void c_callback_on_visibility(uintptr_t hwnd, uint32_t visibility, uint32_t throttled, uint32_t rate) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_visibility_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_visibility_by_hwnd.end() && it->second.tsfn) {
+        it->second.tsfn.BlockingCall([visibility, throttled, rate](Napi::Env env, Function callback) {
+            callback.Call({
+                Napi::Number::New(env, visibility),
+                Napi::Boolean::New(env, throttled != 0),
+                Napi::Number::New(env, rate)
+            });
+        });
+    }
+}
+
+// C-side animation trampoline; the JS callback receives the tween's id,
+// its property and whether it ran to the end (false if cancelled or
+// replaced).
+static void c_callback_on_animation(uintptr_t hwnd, uint32_t id, uint32_t property, uint32_t finished) {
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    auto it = g_animation_by_hwnd.find((uint64_t)hwnd);
+    if (it != g_animation_by_hwnd.end() && it->second.tsfn) {
+        it->second.tsfn.BlockingCall([id, property, finished](Napi::Env env, Function callback) {
+            callback.Call({
+                Napi::Number::New(env, id),
+                Napi::Number::New(env, property),
+                Napi::Boolean::New(env, finished != 0)
+            });
+        });
+    }
+}
+
+static void destroy_window_task(void* ctx) {
+    darling_destroy_window((DarlingWindow*)ctx);
+}
+
+// Destroy a window on its own thread. One on the UI thread is destroyed
+// there, after the tasks already queued for it; the memory it writes into
+// is detached first, since its JS owner is released before then.
+static void destroy_window_on(DarlingWindow* win, bool ui_thread) {
+    if (ui_thread) {
+        darling_input_detach(win);
+        darling_state_detach(win);
+        if (darling_ui_post(destroy_window_task, win)) {
+            return;
+        }
+    }
+    darling_destroy_window(win);
+}
+
+static void async_drain(DarlingAddonData* data);
+
+// Environment cleanup hook: release this environment's callbacks and
+// destroy the windows it created, so nothing calls into or writes memory
+// of an environment that is gone.
+static void addon_cleanup(DarlingAddonData* data) {
+    std::unordered_set<DarlingWindow*> windows;
+    std::unordered_set<DarlingWindow*> uiWindows;
+
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        erase_callbacks_of(g_close_by_hwnd, data);
+        erase_callbacks_of(g_dpi_by_hwnd, data);
+        erase_callbacks_of(g_frame_request_by_hwnd, data);
+        erase_callbacks_of(g_tile_request_by_hwnd, data);
+        erase_callbacks_of(g_visibility_by_hwnd, data);
+        erase_callbacks_of(g_animation_by_hwnd, data);
+        if (data->onClose) {
+            data->onClose.Release();
+            data->onClose = ThreadSafeFunction();
+        }
+        g_environments.erase(data);
+        windows.swap(data->windows);
+        uiWindows.swap(data->uiWindows);
+    }
+
+    // Once no async operation can still touch them, windows whose destroy
+    // waited for one go with the rest
+    async_drain(data);
+    for (DarlingWindow* win : data->destroyAfterOps) {
+        windows.insert(win);
+    }
+    for (DarlingWindow* win : windows) {
+        destroy_window_on(win, uiWindows.count(win) > 0);
+    }
+    data->inputRingByHwnd.clear();
+    data->stateMirrorByHwnd.clear();
+}
+
 // Bind a JS close callback through a ThreadSafeFunction.
 Napi::Value SetOnCloseCallback(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -57,11 +282,8 @@ Napi::Value SetOnCloseCallback(const Napi::CallbackInfo& info) {
         return env.Undefined();
     }
 
-    if (tsfn_on_close) {
-        tsfn_on_close.Release();
-    }
-
-    tsfn_on_close = ThreadSafeFunction::New(
+    DarlingAddonData* data = addon_data(env);
+    ThreadSafeFunction tsfn = ThreadSafeFunction::New(
         env,
         info[0].As<Function>(),     // JS function to call
         "DarlingOnClose",           // Resource name
@@ -69,6 +291,12 @@ Napi::Value SetOnCloseCallback(const Napi::CallbackInfo& info) {
         1                           // Initial thread count
     );
 
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    if (data->onClose) {
+        data->onClose.Release();
+    }
+    data->onClose = tsfn;
+
     // Register legacy callback and ensure HWND callback is also active.
     darling_set_close_callback(c_callback_on_close);
     ensure_close_hook_registered();
@@ -88,6 +316,24 @@ static uint64_t value_to_u64(const Napi::Value& v) {
     return 0;
 }
 
+// View the bytes of a Buffer, typed array or ArrayBuffer (frames may come
+// from a worker as transferred ArrayBuffers). False for anything else.
+static bool frame_bytes(const Napi::Value& v, const uint8_t** data, size_t* length) {
+    if (v.IsTypedArray()) {
+        auto view = v.As<Napi::TypedArray>();
+        *data = (const uint8_t*)view.ArrayBuffer().Data() + view.ByteOffset();
+        *length = view.ByteLength();
+        return true;
+    }
+    if (v.IsArrayBuffer()) {
+        auto buffer = v.As<Napi::ArrayBuffer>();
+        *data = (const uint8_t*)buffer.Data();
+        *length = buffer.ByteLength();
+        return true;
+    }
+    return false;
+}
+
 // Create a native Darling window.
 Napi::Value CreateDarlingWindow(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -99,6 +345,10 @@ Napi::Value CreateDarlingWindow(const Napi::CallbackInfo& info) {
     }
 
     DarlingWindow* win = darling_create_window(w, h, parent_hwnd);
+    if (win) {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        addon_data(env)->windows.insert(win);
+    }
     return Napi::External<DarlingWindow>::New(env, win);
 }
 
@@ -113,7 +363,18 @@ Napi::Value GetWindowHWND(const Napi::CallbackInfo& info) {
     return Napi::BigInt::New(env, (uint64_t)hwnd);
 }
 
-Napi::Value SetOnCloseCallbackForWindow(const Napi::CallbackInfo& info) {
+// Bind the JS callback in info[1] to the window in info[0]. `map` holds the
+// per-window callbacks; the C hook is installed through `setter` the first
+// time any window asks for one.
+template <typename Hook>
+static Napi::Value set_window_callback(
+    const Napi::CallbackInfo& info,
+    DarlingCallbackMap& map,
+    const char* resource,
+    bool& registered,
+    void (*setter)(Hook),
+    Hook hook
+) {
     Napi::Env env = info.Env();
     if (info.Length() < 2 || !info[0].IsExternal()) {
         Napi::TypeError::New(env, "Expected window handle and callback").ThrowAsJavaScriptException();
@@ -135,41 +396,91 @@ Napi::Value SetOnCloseCallbackForWindow(const Napi::CallbackInfo& info) {
     ThreadSafeFunction tsfn = ThreadSafeFunction::New(
         env,
         info[1].As<Function>(),
-        "DarlingOnCloseByWindow",
+        resource,
         0,
         1
     );
 
-    {
-        std::lock_guard<std::mutex> lock(g_close_callbacks_mutex);
-        auto it = tsfn_on_close_by_hwnd.find(hwnd);
-        if (it != tsfn_on_close_by_hwnd.end() && it->second) {
-            it->second.Release();
-        }
-        tsfn_on_close_by_hwnd[hwnd] = tsfn;
-    }
+    std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+    set_callback(map, hwnd, tsfn, addon_data(env));
 
-    ensure_close_hook_registered();
+    if (!registered) {
+        setter(hook);
+        registered = true;
+    }
     return env.Undefined();
 }
 
+Napi::Value SetOnCloseCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_close_by_hwnd, "DarlingOnCloseByWindow",
+        g_close_hook_registered, darling_set_close_callback_hwnd, c_callback_on_close_hwnd);
+}
+
+Napi::Value SetOnDpiChangedCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_dpi_by_hwnd, "DarlingOnDpiChangedByWindow",
+        g_dpi_hook_registered, darling_set_dpi_changed_callback, c_callback_on_dpi_changed);
+}
+
+Napi::Value SetOnFrameRequestedCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_frame_request_by_hwnd, "DarlingOnFrameRequestedByWindow",
+        g_frame_request_hook_registered, darling_set_frame_request_callback, c_callback_on_frame_request);
+}
+
+// Called with the tiles a window's virtual surface needs uploaded.
+Napi::Value SetOnTilesRequestedCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_tile_request_by_hwnd, "DarlingOnTilesRequestedByWindow",
+        g_tile_request_hook_registered, darling_set_tile_request_callback, c_callback_on_tile_request);
+}
+
+// Called when a window is hidden, minimized, covered or shown again.
+Napi::Value SetOnVisibilityChangedCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_visibility_by_hwnd, "DarlingOnVisibilityChangedByWindow",
+        g_visibility_hook_registered, darling_set_visibility_callback, c_callback_on_visibility);
+}
+
+// Called when a tween ends, finished or not.
+Napi::Value SetOnAnimationDoneCallbackForWindow(const Napi::CallbackInfo& info) {
+    return set_window_callback(info, g_animation_by_hwnd, "DarlingOnAnimationDoneByWindow",
+        g_animation_hook_registered, darling_set_animation_callback, c_callback_on_animation);
+}
+
 // Destroy the window and release resources.
 void DestroyDarlingWindow(const Napi::CallbackInfo& info) {
     auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingAddonData* data = addon_data(info.Env());
     uint64_t hwnd = (uint64_t)darling_get_window_hwnd(win);
-    darling_destroy_window(win);
+    bool uiThread = false;
+
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        data->windows.erase(win);
+        uiThread = data->uiWindows.erase(win) > 0;
+    }
+
+    // Async operations still queued for a window this thread owns finish
+    // first; the last to settle destroys it
+    if (!uiThread && data->asyncOpsByWindow.count(win) > 0) {
+        darling_input_detach(win);
+        darling_state_detach(win);
+        data->destroyAfterOps.insert(win);
+    } else {
+        destroy_window_on(win, uiThread);
+    }
 
     if (hwnd != 0) {
-        std::lock_guard<std::mutex> lock(g_close_callbacks_mutex);
-        auto it = tsfn_on_close_by_hwnd.find(hwnd);
-        if (it != tsfn_on_close_by_hwnd.end()) {
-            if (it->second) {
-                it->second.Release();
-            }
-            tsfn_on_close_by_hwnd.erase(it);
-        }
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        erase_callback(g_close_by_hwnd, hwnd);
+        erase_callback(g_dpi_by_hwnd, hwnd);
+        erase_callback(g_frame_request_by_hwnd, hwnd);
+        erase_callback(g_tile_request_by_hwnd, hwnd);
+        erase_callback(g_visibility_by_hwnd, hwnd);
+        erase_callback(g_animation_by_hwnd, hwnd);
     }
 
+    if (hwnd != 0) {
+        data->inputRingByHwnd.erase(hwnd);
+        data->stateMirrorByHwnd.erase(hwnd);
+    }
 }
 
 // Show a Darling window.
@@ -218,6 +529,119 @@ Napi::Value SetChildWindowWrapped(const Napi::CallbackInfo& info) {
     return env.Undefined();
 }
 
+// Add a layout node; returns its id (-1 on failure).
+Napi::Value LayoutAddWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t parent = info[1].As<Napi::Number>().Int32Value();
+    uint32_t kind = info[2].As<Napi::Number>().Uint32Value();
+    uint32_t fixed = info[3].As<Napi::Number>().Uint32Value();
+    float weight = info[4].As<Napi::Number>().FloatValue();
+    int32_t id = darling_layout_add(win, parent, (DarlingLayoutKind)kind, fixed, weight);
+    return Napi::Number::New(env, id);
+}
+
+// Attach a child HWND to a layout leaf.
+Napi::Value LayoutSetChildWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t node = info[1].As<Napi::Number>().Int32Value();
+    uint64_t child = value_to_u64(info[2]);
+    darling_layout_set_child(win, node, (uintptr_t)child);
+    return env.Undefined();
+}
+
+// Change a layout node's fixed size or weight.
+Napi::Value LayoutSetSizeWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t node = info[1].As<Napi::Number>().Int32Value();
+    uint32_t fixed = info[2].As<Napi::Number>().Uint32Value();
+    float weight = info[3].As<Napi::Number>().FloatValue();
+    darling_layout_set_size(win, node, fixed, weight);
+    return env.Undefined();
+}
+
+// Select the visible child of a stack node.
+Napi::Value LayoutSetActiveWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t node = info[1].As<Napi::Number>().Int32Value();
+    uint32_t index = info[2].As<Napi::Number>().Uint32Value();
+    darling_layout_set_active(win, node, index);
+    return env.Undefined();
+}
+
+// Remove the layout tree.
+Napi::Value LayoutClearWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_layout_clear(win);
+    return env.Undefined();
+}
+
+// Recompute the layout and reposition changed children in one batch.
+Napi::Value LayoutApplyWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_layout_apply(win);
+    return env.Undefined();
+}
+
+// Add a typed hit-test region; returns its id (-1 on failure).
+Napi::Value HitRegionAddWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t kind = info[1].As<Napi::Number>().Uint32Value();
+    int32_t left = info[2].As<Napi::Number>().Int32Value();
+    int32_t top = info[3].As<Napi::Number>().Int32Value();
+    int32_t right = info[4].As<Napi::Number>().Int32Value();
+    int32_t bottom = info[5].As<Napi::Number>().Int32Value();
+    uint32_t anchors = info[6].As<Napi::Number>().Uint32Value();
+    int32_t id = darling_hit_region_add(win, (DarlingHitKind)kind, left, top, right, bottom, anchors);
+    return Napi::Number::New(env, id);
+}
+
+// Move a hit-test region.
+Napi::Value HitRegionSetWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    int32_t left = info[2].As<Napi::Number>().Int32Value();
+    int32_t top = info[3].As<Napi::Number>().Int32Value();
+    int32_t right = info[4].As<Napi::Number>().Int32Value();
+    int32_t bottom = info[5].As<Napi::Number>().Int32Value();
+    uint32_t anchors = info[6].As<Napi::Number>().Uint32Value();
+    darling_hit_region_set(win, id, left, top, right, bottom, anchors);
+    return env.Undefined();
+}
+
+// Remove one hit-test region.
+Napi::Value HitRegionRemoveWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    darling_hit_region_remove(win, id);
+    return env.Undefined();
+}
+
+// Remove all hit-test regions.
+Napi::Value HitRegionClearWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_hit_region_clear(win);
+    return env.Undefined();
+}
+
+// Kind of the hit-test region at a client point (-1 if none).
+Napi::Value HitTestWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t x = info[1].As<Napi::Number>().Int32Value();
+    int32_t y = info[2].As<Napi::Number>().Int32Value();
+    return Napi::Number::New(env, darling_hit_test(win, x, y));
+}
+
 // Set the Win32 window title.
 Napi::Value SetWindowTitleWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -335,6 +759,22 @@ Napi::Value SetDarkModeWrapped(const Napi::CallbackInfo& info) {
     return env.Undefined();
 }
 
+// Defer frame recalculation for the appearance setters that follow.
+Napi::Value BeginAppearanceUpdateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_begin_appearance_update(win);
+    return env.Undefined();
+}
+
+// Apply deferred appearance changes with a single frame recalculation.
+Napi::Value CommitAppearanceUpdateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_commit_appearance_update(win);
+    return env.Undefined();
+}
+
 // Apply system theme to a Darling window.
 Napi::Value SetAutoDarkModeWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -396,6 +836,179 @@ Napi::Value GetScaleFactorWrapped(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, scale);
 }
 
+// Convert memory stats to a plain JS object.
+static Napi::Object memory_stats_to_object(Napi::Env env, const DarlingMemoryStats& s) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("backingBytes", Napi::Number::New(env, (double)s.backingBytes));
+    obj.Set("compressedBytes", Napi::Number::New(env, (double)s.compressedBytes));
+    obj.Set("gdiObjects", Napi::Number::New(env, s.gdiObjects));
+    obj.Set("backingStores", Napi::Number::New(env, s.backingStores));
+    obj.Set("evictedStores", Napi::Number::New(env, s.evictedStores));
+    obj.Set("evictions", Napi::Number::New(env, (double)s.evictions));
+    obj.Set("restores", Napi::Number::New(env, (double)s.restores));
+    obj.Set("frameRequests", Napi::Number::New(env, (double)s.frameRequests));
+    obj.Set("budgetBytes", Napi::Number::New(env, (double)s.budgetBytes));
+    return obj;
+}
+
+// Set the global backing-store budget and eviction mode.
+Napi::Value SetMemoryBudgetWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint64_t bytes = value_to_u64(info[0]);
+    uint32_t mode = info.Length() >= 2 ? info[1].As<Napi::Number>().Uint32Value() : 0;
+    darling_set_memory_budget(bytes, (DarlingEvictionMode)mode);
+    return env.Undefined();
+}
+
+// Size the frame thread pool (0 = one thread per CPU) and pin its workers
+// to the CPUs in a Number or BigInt mask (0 = not pinned).
+Napi::Value SetThreadPoolWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint32_t threads = info.Length() >= 1 && info[0].IsNumber() ? info[0].As<Napi::Number>().Uint32Value() : 0;
+    uint64_t affinity = info.Length() >= 2 ? value_to_u64(info[1]) : 0;
+    darling_set_thread_pool(threads, affinity);
+    return env.Undefined();
+}
+
+// Get frame thread pool counters.
+Napi::Value GetThreadPoolStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    DarlingThreadPoolStats stats = {};
+    darling_get_thread_pool_stats(&stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("workers", Napi::Number::New(env, stats.workers));
+    obj.Set("jobs", Napi::Number::New(env, (double)stats.jobs));
+    obj.Set("inlineJobs", Napi::Number::New(env, (double)stats.inlineJobs));
+    obj.Set("bands", Napi::Number::New(env, (double)stats.bands));
+    obj.Set("steals", Napi::Number::New(env, (double)stats.steals));
+    return obj;
+}
+
+// Get process-wide backing-store memory stats.
+Napi::Value GetMemoryStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    DarlingMemoryStats stats = {};
+    darling_get_memory_stats(&stats);
+    return memory_stats_to_object(env, stats);
+}
+
+// Get backing-store memory stats for one window.
+Napi::Value GetWindowMemoryStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingMemoryStats stats = {};
+    darling_get_window_memory_stats(win, &stats);
+    return memory_stats_to_object(env, stats);
+}
+
+// Bytes needed for an input ring of `capacity` events.
+Napi::Value InputRingBytesWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint32_t capacity = info[0].As<Napi::Number>().Uint32Value();
+    return Napi::Number::New(env, (double)darling_input_ring_bytes(capacity));
+}
+
+// Attach a typed array over a SharedArrayBuffer as the window's input ring.
+// Returns the ring capacity, or 0 if the memory is too small or misaligned.
+Napi::Value AttachInputRingWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    if (!info[1].IsTypedArray()) {
+        Napi::TypeError::New(env, "Expected a typed array for the input ring").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto view = info[1].As<Napi::TypedArray>();
+    auto buffer = view.ArrayBuffer();
+    void* memory = (uint8_t*)buffer.Data() + view.ByteOffset();
+
+    uint32_t capacity = darling_input_attach(win, memory, view.ByteLength());
+    uint64_t hwnd = (uint64_t)darling_get_window_hwnd(win);
+
+    DarlingAddonData* data = addon_data(env);
+
+    if (capacity) {
+        data->inputRingByHwnd[hwnd] = Napi::Persistent(view.As<Napi::Object>());
+    } else {
+        data->inputRingByHwnd.erase(hwnd);
+    }
+
+    return Napi::Number::New(env, capacity);
+}
+
+// Stop writing input events and release the ring memory.
+Napi::Value DetachInputRingWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_input_detach(win);
+    addon_data(env)->inputRingByHwnd.erase((uint64_t)darling_get_window_hwnd(win));
+    return env.Undefined();
+}
+
+// Bytes needed for a window state mirror.
+Napi::Value StateMirrorBytesWrapped(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)darling_state_mirror_bytes());
+}
+
+// Attach a typed array over a SharedArrayBuffer as the window's state
+// mirror. Returns false if the memory is too small or misaligned.
+Napi::Value AttachStateMirrorWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    if (!info[1].IsTypedArray()) {
+        Napi::TypeError::New(env, "Expected a typed array for the state mirror").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto view = info[1].As<Napi::TypedArray>();
+    auto buffer = view.ArrayBuffer();
+    void* memory = (uint8_t*)buffer.Data() + view.ByteOffset();
+
+    int attached = darling_state_attach(win, memory, view.ByteLength());
+    uint64_t hwnd = (uint64_t)darling_get_window_hwnd(win);
+
+    DarlingAddonData* data = addon_data(env);
+
+    // A failed attach has detached the window, so the old buffer can go
+    if (attached) {
+        data->stateMirrorByHwnd[hwnd] = Napi::Persistent(view.As<Napi::Object>());
+    } else {
+        data->stateMirrorByHwnd.erase(hwnd);
+    }
+
+    return Napi::Boolean::New(env, attached != 0);
+}
+
+// Stop mirroring window state and release the memory.
+Napi::Value DetachStateMirrorWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_state_detach(win);
+    addon_data(env)->stateMirrorByHwnd.erase((uint64_t)darling_get_window_hwnd(win));
+    return env.Undefined();
+}
+
+// Get input ring counters for one window.
+Napi::Value GetInputStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingInputStats stats = {};
+    darling_input_get_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("capacity", Napi::Number::New(env, stats.capacity));
+    obj.Set("pending", Napi::Number::New(env, stats.pending));
+    obj.Set("written", Napi::Number::New(env, stats.written));
+    obj.Set("dropped", Napi::Number::New(env, stats.dropped));
+    return obj;
+}
+
+// Current time on the input event clock, in milliseconds.
+Napi::Value InputNowWrapped(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), darling_input_now());
+}
+
 // Call SetWindowPos on a raw HWND.
 Napi::Value SetWindowPosWrapped(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
@@ -442,12 +1055,1269 @@ Napi::Value PaintFrameWrapped(const Napi::CallbackInfo& info) {
     return env.Undefined();
 }
 
-// Export all native bindings.
-Napi::Object Init(Napi::Env env, Napi::Object exports) {
+// Paint a BGRA buffer to a specific window, optionally tagged with a frame
+// ID and the producer's submit time (ms on the inputNow clock).
+Napi::Value PaintFrameWindowWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    const uint8_t* pixels = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[1], &pixels, &length)) {
+        Napi::TypeError::New(env, "Expected a Buffer or ArrayBuffer for the frame data").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    uint32_t w = info[2].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[3].As<Napi::Number>().Uint32Value();
+
+    if (length < (size_t)w * (size_t)h * 4u) {
+        Napi::RangeError::New(env, "Frame buffer is smaller than width * height * 4").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    if (info.Length() >= 5 && !info[4].IsUndefined()) {
+        double submit = info.Length() >= 6 && info[5].IsNumber() ? info[5].As<Napi::Number>().DoubleValue() : 0.0;
+        darling_frame_tag(win, value_to_u64(info[4]), submit);
+    }
+
+    darling_paint_frame_window(win, pixels, w, h);
+    return env.Undefined();
+}
+
+// Paint a frame to the window with this HWND from any environment, e.g. a
+// worker that received the HWND and renders into transferable ArrayBuffers.
+// Returns false if the window no longer exists.
+Napi::Value PaintFrameHwndWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint64_t hwnd = value_to_u64(info[0]);
+    const uint8_t* pixels = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[1], &pixels, &length)) {
+        Napi::TypeError::New(env, "Expected a Buffer or ArrayBuffer for the frame data").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    uint32_t w = info[2].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t format = info.Length() >= 5 && info[4].IsNumber() ? info[4].As<Napi::Number>().Uint32Value() : 0;
+    uint64_t frame_id = info.Length() >= 6 && !info[5].IsUndefined() ? value_to_u64(info[5]) : 0;
+
+    if (length < (size_t)w * (size_t)h * 4u) {
+        Napi::RangeError::New(env, "Frame buffer is smaller than width * height * 4").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    int painted = darling_paint_frame_hwnd((uintptr_t)hwnd, pixels, w, h, (DarlingPixelFormat)format, frame_id);
+    return Napi::Boolean::New(env, painted != 0);
+}
+
+// Read one plane of a YUV frame object: `bytes` and an optional stride
+// (default `row_bytes`). Returns false, with an exception pending, if it is
+// missing or shorter than `rows` rows.
+static bool yuv_plane(Napi::Env env, const Napi::Object& frame, const char* name, const char* stride_name,
+                      uint32_t row_bytes, uint32_t rows, const uint8_t** data, uint32_t* stride) {
+    size_t length = 0;
+    if (!frame_bytes(frame.Get(name), data, &length)) {
+        Napi::TypeError::New(env, std::string("Expected a Buffer or ArrayBuffer for the ") + name + " plane")
+            .ThrowAsJavaScriptException();
+        return false;
+    }
+
+    Napi::Value s = frame.Get(stride_name);
+    *stride = s.IsNumber() ? s.As<Napi::Number>().Uint32Value() : row_bytes;
+    if (*stride < row_bytes || length < (size_t)*stride * (rows - 1u) + row_bytes) {
+        Napi::RangeError::New(env, std::string("The ") + name + " plane is smaller than its rows")
+            .ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Paint an I420 or NV12 frame: { width, height, layout, matrix, range, y, u,
+// v, yStride, uStride, vStride } with NV12's interleaved plane in `u`.
+// Converted to BGRA natively, scaled to the client size if requested, and
+// optionally tagged like paintFrameWindow.
+Napi::Value PaintYuvWindowWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    if (!info[1].IsObject()) {
+        Napi::TypeError::New(env, "Expected a YUV frame object").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    Napi::Object obj = info[1].As<Napi::Object>();
+    bool scale = info.Length() >= 3 && info[2].ToBoolean().Value();
+
+    DarlingYuvFrame frame = {};
+    frame.width = obj.Get("width").As<Napi::Number>().Uint32Value();
+    frame.height = obj.Get("height").As<Napi::Number>().Uint32Value();
+    frame.layout = obj.Get("layout").As<Napi::Number>().Uint32Value();
+    frame.matrix = obj.Get("matrix").As<Napi::Number>().Uint32Value();
+    frame.range = obj.Get("range").As<Napi::Number>().Uint32Value();
+    if (frame.width == 0 || frame.height == 0) {
+        return env.Undefined();
+    }
+
+    uint32_t chroma_w = (frame.width + 1u) / 2u;
+    uint32_t chroma_h = (frame.height + 1u) / 2u;
+    bool nv12 = frame.layout == DARLING_YUV_NV12;
+    if (!yuv_plane(env, obj, "y", "yStride", frame.width, frame.height, &frame.planes[0], &frame.strides[0]) ||
+        !yuv_plane(env, obj, "u", "uStride", nv12 ? chroma_w * 2u : chroma_w, chroma_h,
+                   &frame.planes[1], &frame.strides[1]) ||
+        (!nv12 && !yuv_plane(env, obj, "v", "vStride", chroma_w, chroma_h, &frame.planes[2], &frame.strides[2]))) {
+        return env.Undefined();
+    }
+
+    if (info.Length() >= 4 && !info[3].IsUndefined()) {
+        double submit = info.Length() >= 5 && info[4].IsNumber() ? info[4].As<Napi::Number>().DoubleValue() : 0.0;
+        darling_frame_tag(win, value_to_u64(info[3]), submit);
+    }
+
+    darling_paint_yuv_window(win, &frame, scale ? 1 : 0);
+    return env.Undefined();
+}
+
+// Convert a frame record to a plain JS object; stages are ms timestamps.
+static Napi::Object frame_record_to_object(Napi::Env env, const DarlingFrameRecord& r) {
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("frameId", Napi::Number::New(env, (double)r.frameId));
+    obj.Set("submit", Napi::Number::New(env, r.stamps[DARLING_STAGE_SUBMIT]));
+    obj.Set("entry", Napi::Number::New(env, r.stamps[DARLING_STAGE_ENTRY]));
+    obj.Set("copied", Napi::Number::New(env, r.stamps[DARLING_STAGE_COPIED]));
+    obj.Set("invalidated", Napi::Number::New(env, r.stamps[DARLING_STAGE_INVALIDATED]));
+    obj.Set("paintStart", Napi::Number::New(env, r.stamps[DARLING_STAGE_PAINT_START]));
+    if (r.stamps[DARLING_STAGE_PRESENTED] != 0.0) {
+        obj.Set("presented", Napi::Number::New(env, r.stamps[DARLING_STAGE_PRESENTED]));
+    } else {
+        obj.Set("presented", env.Null());
+    }
+    return obj;
+}
+
+// Look up a recent frame by ID; null while in flight or unknown.
+Napi::Value GetFrameRecordWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingFrameRecord record = {};
+    if (!darling_get_frame_record(win, value_to_u64(info[1]), &record)) {
+        return env.Null();
+    }
+    return frame_record_to_object(env, record);
+}
+
+// Get per-window FPS and stage latency summaries.
+Napi::Value GetFrameTimingWrapped(const Napi::CallbackInfo& info) {
+    static const char* k_spans[DARLING_LATENCY_SPAN_COUNT] = {
+        "producer", "copy", "invalidate", "queue", "blit", "total"
+    };
+
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingFrameTimingStats stats = {};
+    darling_get_frame_timing(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("presented", Napi::Number::New(env, (double)stats.presented));
+    obj.Set("superseded", Napi::Number::New(env, (double)stats.superseded));
+    obj.Set("fps", Napi::Number::New(env, stats.fps));
+
+    for (uint32_t i = 0; i < DARLING_LATENCY_SPAN_COUNT; i++) {
+        const DarlingLatencySummary& s = stats.spans[i];
+        Napi::Object span = Napi::Object::New(env);
+        span.Set("count", Napi::Number::New(env, (double)s.count));
+        span.Set("mean", Napi::Number::New(env, s.mean));
+        span.Set("p50", Napi::Number::New(env, s.p50));
+        span.Set("p90", Napi::Number::New(env, s.p90));
+        span.Set("p99", Napi::Number::New(env, s.p99));
+        span.Set("max", Napi::Number::New(env, s.max));
+        obj.Set(k_spans[i], span);
+    }
+    return obj;
+}
+
+// Clear the latency histograms and frame records of a window.
+Napi::Value ResetFrameTimingWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_reset_frame_timing(win);
+    return info.Env().Undefined();
+}
+
+// Toggle the FPS / p99 latency overlay.
+Napi::Value SetFrameOverlayWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    bool enable = info[1].As<Napi::Boolean>().Value();
+    darling_set_frame_overlay(win, enable ? 1 : 0);
+    return info.Env().Undefined();
+}
+
+// Create a transparent overlay layer; returns its id (-1 on failure).
+Napi::Value LayerCreateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t x = info[1].As<Napi::Number>().Int32Value();
+    int32_t y = info[2].As<Napi::Number>().Int32Value();
+    uint32_t w = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[4].As<Napi::Number>().Uint32Value();
+    int32_t z = info.Length() >= 6 && info[5].IsNumber() ? info[5].As<Napi::Number>().Int32Value() : 0;
+    return Napi::Number::New(env, darling_layer_create(win, x, y, w, h, z));
+}
+
+// Destroy an overlay layer.
+Napi::Value LayerDestroyWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    darling_layer_destroy(win, id);
+    return info.Env().Undefined();
+}
+
+// Move a layer in client coordinates.
+Napi::Value LayerSetPositionWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    int32_t x = info[2].As<Napi::Number>().Int32Value();
+    int32_t y = info[3].As<Napi::Number>().Int32Value();
+    darling_layer_set_position(win, id, x, y);
+    return info.Env().Undefined();
+}
+
+// Change a layer's z order.
+Napi::Value LayerSetZWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    int32_t z = info[2].As<Napi::Number>().Int32Value();
+    darling_layer_set_z(win, id, z);
+    return info.Env().Undefined();
+}
+
+// Set layer opacity (0-255).
+Napi::Value LayerSetOpacityWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    uint32_t opacity = info[2].As<Napi::Number>().Uint32Value();
+    if (opacity > 255) {
+        opacity = 255;
+    }
+    darling_layer_set_opacity(win, id, (uint8_t)opacity);
+    return info.Env().Undefined();
+}
+
+// Show or hide a layer.
+Napi::Value LayerSetVisibleWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    bool visible = info[2].As<Napi::Boolean>().Value();
+    darling_layer_set_visible(win, id, visible ? 1 : 0);
+    return info.Env().Undefined();
+}
+
+// Replace a rectangle of a layer with BGRA pixels (straight alpha unless
+// `premultiplied` is true).
+Napi::Value LayerUpdateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t id = info[1].As<Napi::Number>().Int32Value();
+    if (!info[2].IsBuffer()) {
+        Napi::TypeError::New(env, "Expected a Buffer for the layer pixels").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    auto buffer = info[2].As<Napi::Buffer<unsigned char>>();
+    uint32_t x = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t y = info[4].As<Napi::Number>().Uint32Value();
+    uint32_t w = info[5].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[6].As<Napi::Number>().Uint32Value();
+    bool premultiplied = info.Length() >= 8 && info[7].ToBoolean().Value();
+
+    if (buffer.Length() < (size_t)w * (size_t)h * 4u) {
+        Napi::RangeError::New(env, "Layer buffer is smaller than width * height * 4").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    darling_layer_update(win, id, buffer.Data(), x, y, w, h, premultiplied ? 1 : 0);
+    return env.Undefined();
+}
+
+// Get layer count and compositing counters for a window.
+Napi::Value GetCompositorStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingCompositorStats stats = {};
+    darling_get_compositor_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("layers", Napi::Number::New(env, stats.layers));
+    obj.Set("damageRects", Napi::Number::New(env, stats.damageRects));
+    obj.Set("flushes", Napi::Number::New(env, (double)stats.flushes));
+    obj.Set("compositedPixels", Napi::Number::New(env, (double)stats.compositedPixels));
+    obj.Set("culledPixels", Napi::Number::New(env, (double)stats.culledPixels));
+    return obj;
+}
+
+// Create a named shared-memory frame ring for an external producer.
+Napi::Value FrameRingCreateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    std::string name = info[1].As<Napi::String>().Utf8Value();
+    uint32_t w = info[2].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t slots = info.Length() >= 5 && info[4].IsNumber() ? info[4].As<Napi::Number>().Uint32Value() : 0;
+    return Napi::Boolean::New(env, darling_frame_ring_create(win, name.c_str(), w, h, slots) != 0);
+}
+
+// Close and unlink a window's frame ring.
+Napi::Value FrameRingCloseWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_frame_ring_close(win);
+    return info.Env().Undefined();
+}
+
+// Present the newest complete frame in the ring, if any.
+Napi::Value FrameRingPresentWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    return Napi::Boolean::New(info.Env(), darling_frame_ring_present(win) != 0);
+}
+
+// Present the newest frame-ring frame of the window with this HWND.
+Napi::Value FrameRingPresentHwndWrapped(const Napi::CallbackInfo& info) {
+    uint64_t hwnd = value_to_u64(info[0]);
+    return Napi::Boolean::New(info.Env(), darling_frame_ring_present_hwnd((uintptr_t)hwnd) != 0);
+}
+
+// Get frame ring counters for a window.
+Napi::Value GetFrameRingStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingFrameRingStats stats = {};
+    darling_get_frame_ring_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("slots", Napi::Number::New(env, stats.slots));
+    obj.Set("maxWidth", Napi::Number::New(env, stats.maxWidth));
+    obj.Set("maxHeight", Napi::Number::New(env, stats.maxHeight));
+    obj.Set("published", Napi::Number::New(env, stats.published));
+    obj.Set("dropped", Napi::Number::New(env, stats.dropped));
+    obj.Set("presented", Napi::Number::New(env, (double)stats.presented));
+    obj.Set("skipped", Napi::Number::New(env, (double)stats.skipped));
+    return obj;
+}
+
+// Returns a width x height BGRA Buffer, or null if the window has nothing
+// to preview (never painted, or evicted before its pyramid caught up).
+Napi::Value GetThumbnailWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t w = info[1].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[2].As<Napi::Number>().Uint32Value();
+    if (w == 0 || h == 0) {
+        return env.Null();
+    }
+
+    auto buffer = Napi::Buffer<uint8_t>::New(env, (size_t)w * h * 4u);
+    if (!darling_get_thumbnail(win, buffer.Data(), w, h)) {
+        return env.Null();
+    }
+    return buffer;
+}
+
+Napi::Value ReleaseThumbnailsWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_release_thumbnails(win);
+    return info.Env().Undefined();
+}
+
+Napi::Value GetThumbnailStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingThumbnailStats stats = {};
+    darling_get_thumbnail_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("levels", Napi::Number::New(env, stats.levels));
+    obj.Set("width", Napi::Number::New(env, stats.width));
+    obj.Set("height", Napi::Number::New(env, stats.height));
+    obj.Set("bytes", Napi::Number::New(env, (double)stats.bytes));
+    obj.Set("requests", Napi::Number::New(env, (double)stats.requests));
+    obj.Set("updatedPixels", Napi::Number::New(env, (double)stats.updatedPixels));
+    obj.Set("rebuilds", Napi::Number::New(env, (double)stats.rebuilds));
+    return obj;
+}
+
+// Save a splash snapshot for the next launch. Without frames it saves what
+// the window last presented; with them, `count` frames of width x height
+// BGRA (a strip shown `frameMs` apart). Returns false if nothing was saved.
+Napi::Value SaveSnapshotWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    std::string path = info[1].As<Napi::String>().Utf8Value();
+
+    if (info.Length() < 3 || info[2].IsUndefined() || info[2].IsNull()) {
+        return Napi::Boolean::New(env, darling_snapshot_save(win, path.c_str(), nullptr, 0, 0, 0, 0) != 0);
+    }
+
+    const uint8_t* pixels = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[2], &pixels, &length)) {
+        Napi::TypeError::New(env, "Expected a Buffer or ArrayBuffer for the snapshot frames").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    uint32_t w = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[4].As<Napi::Number>().Uint32Value();
+    uint32_t count = info.Length() >= 6 && info[5].IsNumber() ? info[5].As<Napi::Number>().Uint32Value() : 1;
+    uint32_t frame_ms = info.Length() >= 7 && info[6].IsNumber() ? info[6].As<Napi::Number>().Uint32Value() : 0;
+
+    if (length < (size_t)w * (size_t)h * 4u * count) {
+        Napi::RangeError::New(env, "Snapshot buffer is smaller than width * height * 4 * count").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    return Napi::Boolean::New(env, darling_snapshot_save(win, path.c_str(), pixels, w, h, count, frame_ms) != 0);
+}
+
+// Describe a snapshot file, or null if it is missing or not a valid one.
+Napi::Value ReadSnapshotInfoWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    DarlingSnapshotInfo snapshot = {};
+    if (!darling_snapshot_read_info(path.c_str(), &snapshot)) {
+        return env.Null();
+    }
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("width", Napi::Number::New(env, snapshot.width));
+    obj.Set("height", Napi::Number::New(env, snapshot.height));
+    obj.Set("frames", Napi::Number::New(env, snapshot.frames));
+    obj.Set("frameMs", Napi::Number::New(env, snapshot.frameMs));
+    obj.Set("x", Napi::Number::New(env, snapshot.x));
+    obj.Set("y", Napi::Number::New(env, snapshot.y));
+    obj.Set("windowWidth", Napi::Number::New(env, snapshot.windowWidth));
+    obj.Set("windowHeight", Napi::Number::New(env, snapshot.windowHeight));
+    obj.Set("dpi", Napi::Number::New(env, snapshot.dpi));
+    obj.Set("flags", Napi::Number::New(env, snapshot.flags));
+    return obj;
+}
+
+// Show this snapshot in the next top-level window created; null cancels.
+Napi::Value SetSplashSnapshotWrapped(const Napi::CallbackInfo& info) {
+    if (info.Length() < 1 || !info[0].IsString()) {
+        darling_set_splash_snapshot(nullptr);
+        return info.Env().Undefined();
+    }
+    std::string path = info[0].As<Napi::String>().Utf8Value();
+    darling_set_splash_snapshot(path.c_str());
+    return info.Env().Undefined();
+}
+
+// Stop showing the splash, e.g. once the embedded content is visible.
+Napi::Value EndSplashWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_end_splash(win);
+    return info.Env().Undefined();
+}
+
+Napi::Value GetSplashStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingSplashStats stats = {};
+    darling_get_splash_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("showing", Napi::Boolean::New(env, stats.showing != 0));
+    obj.Set("frames", Napi::Number::New(env, stats.frames));
+    obj.Set("shown", Napi::Number::New(env, (double)stats.shown));
+    obj.Set("firstPixelMs", Napi::Number::New(env, stats.firstPixelMs));
+    return obj;
+}
+
+// Display Lists
+// Replace the window's display list with a Uint32Array (or its
+// ArrayBuffer) of commands. Returns false if the list is malformed.
+Napi::Value DrawSubmitWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    const uint8_t* words = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[1], &words, &length)) {
+        Napi::TypeError::New(env, "Expected a Uint32Array or ArrayBuffer for the display list").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (((uintptr_t)words & 3u) != 0) {
+        Napi::RangeError::New(env, "Display list must be 4-byte aligned").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    uint32_t background = info.Length() >= 3 && info[2].IsNumber() ? info[2].As<Napi::Number>().Uint32Value() : 0xFF000000u;
+    return Napi::Boolean::New(env, darling_draw_submit(win, (const uint32_t*)words, length / 4u, background) != 0);
+}
+
+// Upload a width x height BGRA image for IMAGE and GLYPHS commands to use
+// by ID. Straight alpha unless `premultiplied` is true.
+Napi::Value DrawImageUploadWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t id = info[1].As<Napi::Number>().Uint32Value();
+    const uint8_t* pixels = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[2], &pixels, &length)) {
+        Napi::TypeError::New(env, "Expected a Buffer or ArrayBuffer for the image").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    uint32_t w = info[3].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[4].As<Napi::Number>().Uint32Value();
+    bool premultiplied = info.Length() >= 6 && info[5].IsBoolean() && info[5].As<Napi::Boolean>().Value();
+
+    if (length < (size_t)w * (size_t)h * 4u) {
+        Napi::RangeError::New(env, "Image buffer is smaller than width * height * 4").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    return Napi::Boolean::New(env, darling_draw_image_upload(win, id, pixels, w, h, premultiplied ? 1 : 0) != 0);
+}
+
+Napi::Value DrawImageReleaseWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_draw_image_release(win, info[1].As<Napi::Number>().Uint32Value());
+    return info.Env().Undefined();
+}
+
+Napi::Value GetDrawStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingDrawStats stats = {};
+    darling_get_draw_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("commands", Napi::Number::New(env, stats.commands));
+    obj.Set("images", Napi::Number::New(env, stats.images));
+    obj.Set("imageBytes", Napi::Number::New(env, (double)stats.imageBytes));
+    obj.Set("submits", Napi::Number::New(env, (double)stats.submits));
+    obj.Set("reusedCommands", Napi::Number::New(env, (double)stats.reusedCommands));
+    obj.Set("changedCommands", Napi::Number::New(env, (double)stats.changedCommands));
+    obj.Set("fullRedraws", Napi::Number::New(env, (double)stats.fullRedraws));
+    obj.Set("rasterPixels", Napi::Number::New(env, (double)stats.rasterPixels));
+    return obj;
+}
+
+// Virtual Surfaces
+// Give the window a virtual surface of width x height; tileSize, budget
+// (bytes) and background (BGRA) are optional.
+Napi::Value SurfaceCreateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t w = info[1].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[2].As<Napi::Number>().Uint32Value();
+    uint32_t tile_size = info.Length() >= 4 && info[3].IsNumber() ? info[3].As<Napi::Number>().Uint32Value() : 0;
+    uint64_t budget = info.Length() >= 5 && info[4].IsNumber() ? (uint64_t)info[4].As<Napi::Number>().Int64Value() : 0;
+    uint32_t background = info.Length() >= 6 && info[5].IsNumber() ? info[5].As<Napi::Number>().Uint32Value() : 0xFF000000u;
+    return Napi::Boolean::New(env, darling_surface_create(win, w, h, tile_size, budget, background) != 0);
+}
+
+Napi::Value SurfaceCloseWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_surface_close(win);
+    return info.Env().Undefined();
+}
+
+// Upload the tile at (col, row): tileSize * tileSize BGRA pixels.
+Napi::Value SurfaceUploadTileWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int32_t col = info[1].As<Napi::Number>().Int32Value();
+    int32_t row = info[2].As<Napi::Number>().Int32Value();
+    const uint8_t* pixels = nullptr;
+    size_t length = 0;
+    if (!frame_bytes(info[3], &pixels, &length)) {
+        Napi::TypeError::New(env, "Expected a Buffer or ArrayBuffer for the tile").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    DarlingSurfaceStats stats = {};
+    darling_get_surface_stats(win, &stats);
+    if (length < (size_t)stats.tileSize * stats.tileSize * 4u) {
+        Napi::RangeError::New(env, "Tile buffer is smaller than tileSize * tileSize * 4").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    return Napi::Boolean::New(env, darling_surface_upload_tile(win, col, row, pixels) != 0);
+}
+
+Napi::Value SurfaceScrollToWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    int64_t x = info[1].As<Napi::Number>().Int64Value();
+    int64_t y = info[2].As<Napi::Number>().Int64Value();
+    darling_surface_scroll_to(win, x > 0 ? (uint32_t)(x < UINT32_MAX ? x : UINT32_MAX) : 0,
+        y > 0 ? (uint32_t)(y < UINT32_MAX ? y : UINT32_MAX) : 0);
+    return info.Env().Undefined();
+}
+
+Napi::Value SurfaceInvalidateWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    darling_surface_invalidate(
+        win,
+        info[1].As<Napi::Number>().Uint32Value(),
+        info[2].As<Napi::Number>().Uint32Value(),
+        info[3].As<Napi::Number>().Uint32Value(),
+        info[4].As<Napi::Number>().Uint32Value()
+    );
+    return info.Env().Undefined();
+}
+
+Napi::Value GetSurfaceStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingSurfaceStats stats = {};
+    darling_get_surface_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("width", Napi::Number::New(env, stats.width));
+    obj.Set("height", Napi::Number::New(env, stats.height));
+    obj.Set("tileSize", Napi::Number::New(env, stats.tileSize));
+    obj.Set("x", Napi::Number::New(env, stats.x));
+    obj.Set("y", Napi::Number::New(env, stats.y));
+    obj.Set("cachedTiles", Napi::Number::New(env, stats.cachedTiles));
+    obj.Set("pendingTiles", Napi::Number::New(env, stats.pendingTiles));
+    obj.Set("tileBytes", Napi::Number::New(env, (double)stats.tileBytes));
+    obj.Set("budgetBytes", Napi::Number::New(env, (double)stats.budgetBytes));
+    obj.Set("hits", Napi::Number::New(env, (double)stats.hits));
+    obj.Set("misses", Napi::Number::New(env, (double)stats.misses));
+    obj.Set("requests", Napi::Number::New(env, (double)stats.requests));
+    obj.Set("uploads", Napi::Number::New(env, (double)stats.uploads));
+    obj.Set("evictions", Napi::Number::New(env, (double)stats.evictions));
+    obj.Set("scrolls", Napi::Number::New(env, (double)stats.scrolls));
+    obj.Set("shiftedPixels", Napi::Number::New(env, (double)stats.shiftedPixels));
+    obj.Set("copiedPixels", Napi::Number::New(env, (double)stats.copiedPixels));
+    obj.Set("fullRedraws", Napi::Number::New(env, (double)stats.fullRedraws));
+    return obj;
+}
+
+// Power Throttling
+// Set the throttling policy from an object; fields left out keep their
+// defaults, and no object (or enabled: false) turns throttling off.
+Napi::Value SetThrottlePolicyWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsObject()) {
+        darling_set_throttle_policy(nullptr);
+        return env.Undefined();
+    }
+
+    Napi::Object o = info[0].As<Napi::Object>();
+    DarlingThrottlePolicy policy = { 1, 1, 0, 0, 0, 0 };
+
+    Napi::Value enabled = o.Get("enabled");
+    if (enabled.IsBoolean()) {
+        policy.enabled = enabled.As<Napi::Boolean>().Value() ? 1 : 0;
+    }
+    Napi::Value occluded = o.Get("throttleOccluded");
+    if (occluded.IsBoolean()) {
+        policy.throttleOccluded = occluded.As<Napi::Boolean>().Value() ? 1 : 0;
+    }
+
+    const char* rates[] = { "occludedRate", "minimizedRate", "hiddenRate", "checkMs" };
+    uint32_t* fields[] = { &policy.occludedRate, &policy.minimizedRate, &policy.hiddenRate, &policy.checkMs };
+    for (size_t i = 0; i < 4; i++) {
+        Napi::Value v = o.Get(rates[i]);
+        if (v.IsNumber()) {
+            *fields[i] = v.As<Napi::Number>().Uint32Value();
+        }
+    }
+
+    darling_set_throttle_policy(&policy);
+    return env.Undefined();
+}
+
+// Get a window's visibility, throttling and present timing.
+Napi::Value GetPowerStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingPowerStats stats = {};
+    darling_get_power_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("visibility", Napi::Number::New(env, stats.visibility));
+    obj.Set("throttled", Napi::Boolean::New(env, stats.throttled != 0));
+    obj.Set("rate", Napi::Number::New(env, stats.rate));
+    obj.Set("transitions", Napi::Number::New(env, (double)stats.transitions));
+    obj.Set("presents", Napi::Number::New(env, (double)stats.presents));
+    obj.Set("skippedPresents", Napi::Number::New(env, (double)stats.skippedPresents));
+    obj.Set("presentMs", Napi::Number::New(env, stats.presentMs));
+    obj.Set("presentCpuMs", Napi::Number::New(env, stats.presentCpuMs));
+    obj.Set("throttledMs", Napi::Number::New(env, stats.throttledMs));
+    return obj;
+}
+
+// Present Mode
+// Present the window opaque (0) or as a per-pixel-alpha layered window
+// (1). Returns false for an unknown mode.
+Napi::Value SetPresentModeWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsExternal() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected window handle and present mode").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t mode = info[1].As<Napi::Number>().Uint32Value();
+    return Napi::Boolean::New(env, darling_set_present_mode(win, (DarlingPresentMode)mode) != 0);
+}
+
+// Get a window's present mode and layered present counters.
+Napi::Value GetPresentStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingPresentStats stats = {};
+    darling_get_present_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("mode", Napi::Number::New(env, stats.mode));
+    obj.Set("layeredPresents", Napi::Number::New(env, (double)stats.layeredPresents));
+    obj.Set("dirtyPixels", Napi::Number::New(env, (double)stats.dirtyPixels));
+    obj.Set("cleanPixels", Napi::Number::New(env, (double)stats.cleanPixels));
+    obj.Set("convertedPixels", Napi::Number::New(env, (double)stats.convertedPixels));
+    return obj;
+}
+
+// Animations
+// Read up to two numbers from an array into `out`.
+static bool tween_pair(const Napi::Value& v, int32_t out[2]) {
+    if (!v.IsArray()) {
+        return false;
+    }
+    Napi::Object a = v.As<Napi::Object>();
+    for (uint32_t i = 0; i < 2; i++) {
+        Napi::Value n = a.Get(i);
+        out[i] = n.IsNumber() ? n.As<Napi::Number>().Int32Value() : 0;
+    }
+    return true;
+}
+
+// Start a tween from an object { property, to, from?, duration, delay?,
+// easing?, bezier? }; `to` and `from` are [value] or [x, y]. Returns its
+// id, or 0 if the tween was refused.
+Napi::Value AnimateWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsExternal() || !info[1].IsObject()) {
+        Napi::TypeError::New(env, "Expected window handle and tween").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    Napi::Object o = info[1].As<Napi::Object>();
+    DarlingTween tween = {};
+
+    Napi::Value property = o.Get("property");
+    if (!property.IsNumber() || !tween_pair(o.Get("to"), tween.to)) {
+        Napi::TypeError::New(env, "Expected a property and a target").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    tween.property = property.As<Napi::Number>().Uint32Value();
+    tween.hasFrom = tween_pair(o.Get("from"), tween.from) ? 1 : 0;
+
+    Napi::Value easing = o.Get("easing");
+    tween.easing = easing.IsNumber() ? easing.As<Napi::Number>().Uint32Value() : (uint32_t)DARLING_EASE;
+    Napi::Value duration = o.Get("duration");
+    tween.durationMs = duration.IsNumber() ? duration.As<Napi::Number>().DoubleValue() : 0.0;
+    Napi::Value delay = o.Get("delay");
+    tween.delayMs = delay.IsNumber() ? delay.As<Napi::Number>().DoubleValue() : 0.0;
+
+    Napi::Value bezier = o.Get("bezier");
+    if (bezier.IsArray()) {
+        Napi::Object b = bezier.As<Napi::Object>();
+        for (uint32_t i = 0; i < 4; i++) {
+            Napi::Value n = b.Get(i);
+            tween.bezier[i] = n.IsNumber() ? (float)n.As<Napi::Number>().DoubleValue() : 0.0f;
+        }
+    }
+
+    return Napi::Number::New(env, darling_animate(win, &tween));
+}
+
+// Cancel a tween by id, or all of a window's tweens with no id.
+Napi::Value AnimateCancelWrapped(const Napi::CallbackInfo& info) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    uint32_t id = info.Length() >= 2 && info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : 0;
+    darling_animate_cancel(win, id);
+    return info.Env().Undefined();
+}
+
+// Get a window's running tweens, refresh period and tween counters.
+Napi::Value GetAnimationStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    DarlingAnimationStats stats = {};
+    darling_get_animation_stats(win, &stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("active", Napi::Number::New(env, stats.active));
+    obj.Set("refreshMs", Napi::Number::New(env, stats.refreshMs));
+    obj.Set("started", Napi::Number::New(env, (double)stats.started));
+    obj.Set("finished", Napi::Number::New(env, (double)stats.finished));
+    obj.Set("cancelled", Napi::Number::New(env, (double)stats.cancelled));
+    obj.Set("ticks", Napi::Number::New(env, (double)stats.ticks));
+    obj.Set("applied", Napi::Number::New(env, (double)stats.applied));
+    return obj;
+}
+
+// Async Operations
+// Promise-returning variants of the calls that create or restyle a window.
+// Each is a C++20 coroutine: it starts on the calling JS thread, hops to the
+// library's UI thread (darling_ui_post) for the native work and comes back
+// through a ThreadSafeFunction to settle its promise. The promise carries
+// the operation's `opId` for cancelAsync and, once settled, its `timing`.
+// If the UI thread cannot take the task the work runs inline instead.
+
+enum DarlingAsyncState : int {
+    DARLING_ASYNC_QUEUED = 0,
+    DARLING_ASYNC_RUNNING = 1,
+    DARLING_ASYNC_CANCELLED = 2
+};
+
+struct DarlingAsyncOp {
+    DarlingAddonData* data;
+    napi_env env;
+    uint32_t id = 0;
+    DarlingWindow* win;                 // window operated on, NULL for a create
+    Napi::Promise::Deferred deferred;
+    Napi::ObjectReference promise;
+    ThreadSafeFunction tsfn;
+    std::atomic<int> state{ DARLING_ASYNC_QUEUED };
+    bool onUiThread = false;            // ran on the UI thread, not inline
+    bool orphaned = false;              // environment exited before it settled
+
+    // ms on the darling_input_now clock
+    double submitted = 0.0;
+    double started = 0.0;
+    double finished = 0.0;
+
+    DarlingAsyncOp(Napi::Env e, DarlingWindow* target)
+        : data(addon_data(e)), env(e), win(target), deferred(Napi::Promise::Deferred::New(e)) {}
+};
+
+// Fire-and-forget coroutine: runs until its first hop when called and frees
+// its frame when it finishes
+struct DarlingAsyncTask {
+    struct promise_type {
+        DarlingAsyncTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+static void resume_task(void* ctx) {
+    std::coroutine_handle<>::from_address(ctx).resume();
+}
+
+// Continue on the UI thread. Yields false if the task could not be posted
+// and the coroutine continued inline.
+struct DarlingOnUiThread {
+    bool posted = false;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        posted = true;
+        if (darling_ui_post(resume_task, h.address())) {
+            return true;
+        }
+        posted = false;
+        return false;
+    }
+    bool await_resume() const noexcept { return posted; }
+};
+
+// Continue on the op's JS thread. Yields false, still on the UI thread, if
+// that environment has exited; the op then must not touch it.
+struct DarlingOnJsThread {
+    DarlingAsyncOp* op;
+
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(std::coroutine_handle<> h) {
+        ThreadSafeFunction tsfn = op->tsfn;
+        {
+            std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+            if (g_environments.count(op->data) > 0 &&
+                tsfn.BlockingCall([h](Napi::Env, Napi::Function) { h.resume(); }) == napi_ok) {
+                tsfn.Release();
+                return true;
+            }
+        }
+        op->orphaned = true;
+        return false;
+    }
+    bool await_resume() const noexcept { return !op->orphaned; }
+};
+
+// On the UI thread: claim the op. False if it was cancelled while queued.
+static bool async_begin(DarlingAsyncOp* op) {
+    int queued = DARLING_ASYNC_QUEUED;
+    op->started = darling_input_now();
+    return op->state.compare_exchange_strong(queued, DARLING_ASYNC_RUNNING);
+}
+
+// Register an op with its environment and return its promise
+static Napi::Promise async_submit(DarlingAsyncOp* op) {
+    Napi::Env env(op->env);
+    DarlingAddonData* data = op->data;
+
+    op->id = data->nextAsyncId++;
+    op->submitted = darling_input_now();
+    op->tsfn = ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "DarlingAsync", 0, 1);
+
+    Napi::Promise promise = op->deferred.Promise();
+    promise.Set("opId", Napi::Number::New(env, op->id));
+    op->promise = Napi::Persistent(promise.As<Napi::Object>());
+
+    data->asyncOps[op->id] = op;
+    if (op->win) {
+        data->asyncOpsByWindow[op->win]++;
+    }
+    return promise;
+}
+
+// One fewer op on `win`; a destroy that waited for them runs now
+static void async_release_window(DarlingAddonData* data, DarlingWindow* win) {
+    auto it = data->asyncOpsByWindow.find(win);
+    if (it == data->asyncOpsByWindow.end() || --it->second > 0) {
+        return;
+    }
+    data->asyncOpsByWindow.erase(it);
+    if (data->destroyAfterOps.erase(win) > 0) {
+        darling_destroy_window(win);
+    }
+}
+
+// Back on the JS thread: record the op's timing on its promise, drop its
+// bookkeeping and settle it with `value`, or reject with `error`.
+static void async_settle(DarlingAsyncOp* op, Napi::Value value, const char* error) {
+    Napi::Env env(op->env);
+    DarlingAddonData* data = op->data;
+    double settled = darling_input_now();
+    bool ran = op->state.load() == DARLING_ASYNC_RUNNING;
+
+    Napi::Object timing = Napi::Object::New(env);
+    timing.Set("queuedMs", Napi::Number::New(env, op->started - op->submitted));
+    timing.Set("runMs", Napi::Number::New(env, ran ? op->finished - op->started : 0.0));
+    timing.Set("settleMs", Napi::Number::New(env, settled - op->finished));
+    timing.Set("totalMs", Napi::Number::New(env, settled - op->submitted));
+    timing.Set("uiThread", Napi::Boolean::New(env, op->onUiThread));
+    op->promise.Value().Set("timing", timing);
+    op->promise.Reset();
+
+    data->asyncOps.erase(op->id);
+    if (op->win) {
+        async_release_window(data, op->win);
+    }
+
+    if (!ran) {
+        Napi::Object abort = Napi::Error::New(env, "Operation cancelled").Value();
+        abort.Set("name", Napi::String::New(env, "AbortError"));
+        abort.Set("code", Napi::String::New(env, "ABORT_ERR"));
+        op->deferred.Reject(abort);
+    } else if (error) {
+        op->deferred.Reject(Napi::Error::New(env, error).Value());
+    } else {
+        op->deferred.Resolve(value);
+    }
+}
+
+// Track a window created by an async call like one from createWindow. If
+// its environment has already exited, destroy it on the thread it was
+// created on.
+static void async_adopt_window(DarlingAddonData* data, DarlingWindow* win, bool ui_thread) {
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        if (g_environments.count(data) > 0) {
+            data->windows.insert(win);
+            if (ui_thread) {
+                data->uiWindows.insert(win);
+            }
+            return;
+        }
+    }
+    darling_destroy_window(win);
+}
+
+// Environment exit: cancel the operations still queued and wait for the UI
+// thread to get past them. None settles; each finds the environment gone.
+static void async_drain(DarlingAddonData* data) {
+    struct Fence {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool done = false;
+    } fence;
+
+    if (data->asyncOps.empty()) {
+        return;
+    }
+    for (auto& entry : data->asyncOps) {
+        int queued = DARLING_ASYNC_QUEUED;
+        entry.second->state.compare_exchange_strong(queued, DARLING_ASYNC_CANCELLED);
+    }
+
+    auto reached = [](void* ctx) {
+        Fence* f = (Fence*)ctx;
+        std::lock_guard<std::mutex> lock(f->mutex);
+        f->done = true;
+        f->cv.notify_one();
+    };
+    if (!darling_ui_post(reached, &fence)) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(fence.mutex);
+    fence.cv.wait(lock, [&fence] { return fence.done; });
+}
+
+static DarlingAsyncTask create_window_op(std::unique_ptr<DarlingAsyncOp> op, uint32_t w, uint32_t h, uintptr_t parent) {
+    op->onUiThread = co_await DarlingOnUiThread{};
+
+    DarlingWindow* win = nullptr;
+    if (async_begin(op.get())) {
+        win = darling_create_window(w, h, parent);
+        if (win) {
+            async_adopt_window(op->data, win, op->onUiThread);
+        }
+    }
+    op->finished = darling_input_now();
+
+    if (!co_await DarlingOnJsThread{ op.get() }) {
+        op->promise.SuppressDestruct();
+        co_return;
+    }
+
+    Napi::Env env(op->env);
+    Napi::HandleScope scope(env);
+    if (win) {
+        async_settle(op.get(), Napi::External<DarlingWindow>::New(env, win), nullptr);
+    } else {
+        async_settle(op.get(), env.Undefined(), "Failed to create window");
+    }
+}
+
+// Appearance fields given to setAppearanceAsync; unset ones are left alone
+struct DarlingAppearance {
+    int darkMode = -1;                  // 0 light, 1 dark, 2 follow the system
+    int iconVisible = -1;
+    int opacity = -1;
+    int cornerPreference = -1;
+    bool hasTitlebarColor = false;
+    bool hasTitlebarColors = false;
+    bool hasTitle = false;
+    uint32_t titlebarColor = 0;         // 0xRRGGBB
+    uint32_t titlebarBackground = 0;    // 0xRRGGBBAA
+    uint32_t titlebarText = 0;          // 0xRRGGBBAA
+    std::u16string title;
+};
+
+static DarlingAppearance appearance_from(const Napi::Object& o) {
+    DarlingAppearance a;
+
+    Napi::Value dark = o.Get("darkMode");
+    if (dark.IsBoolean()) {
+        a.darkMode = dark.As<Napi::Boolean>().Value() ? 1 : 0;
+    } else if (dark.IsString() && dark.As<Napi::String>().Utf8Value() == "system") {
+        a.darkMode = 2;
+    }
+
+    Napi::Value icon = o.Get("iconVisible");
+    if (icon.IsBoolean()) {
+        a.iconVisible = icon.As<Napi::Boolean>().Value() ? 1 : 0;
+    }
+
+    Napi::Value opacity = o.Get("opacity");
+    if (opacity.IsNumber()) {
+        uint32_t v = opacity.As<Napi::Number>().Uint32Value();
+        a.opacity = v > 255 ? 255 : (int)v;
+    }
+
+    Napi::Value corner = o.Get("cornerPreference");
+    if (corner.IsNumber()) {
+        a.cornerPreference = corner.As<Napi::Number>().Int32Value();
+    }
+
+    Napi::Value color = o.Get("titlebarColor");
+    if (color.IsNumber()) {
+        a.hasTitlebarColor = true;
+        a.titlebarColor = color.As<Napi::Number>().Uint32Value();
+    }
+
+    Napi::Value colors = o.Get("titlebarColors");
+    if (colors.IsObject()) {
+        Napi::Object c = colors.As<Napi::Object>();
+        a.hasTitlebarColors = true;
+        a.titlebarBackground = c.Get("background").ToNumber().Uint32Value();
+        a.titlebarText = c.Get("text").ToNumber().Uint32Value();
+    }
+
+    Napi::Value title = o.Get("title");
+    if (title.IsString()) {
+        a.hasTitle = true;
+        a.title = title.As<Napi::String>().Utf16Value();
+    }
+    return a;
+}
+
+// Apply as one appearance update, so the frame is recalculated once
+static void apply_appearance(DarlingWindow* win, const DarlingAppearance& a) {
+    darling_begin_appearance_update(win);
+    if (a.hasTitle) {
+        darling_set_window_title(win, (const wchar_t*)a.title.c_str());
+    }
+    if (a.iconVisible >= 0) {
+        darling_set_window_icon_visible(win, a.iconVisible);
+    }
+    if (a.darkMode == 2) {
+        darling_set_auto_dark_mode(win);
+    } else if (a.darkMode >= 0) {
+        darling_set_dark_mode(win, a.darkMode);
+    }
+    if (a.hasTitlebarColors) {
+        darling_set_titlebar_colors(win, a.titlebarBackground, a.titlebarText);
+    } else if (a.hasTitlebarColor) {
+        darling_set_titlebar_color(win, a.titlebarColor);
+    }
+    if (a.cornerPreference >= 0) {
+        darling_set_corner_preference(win, (DarlingCornerPreference)a.cornerPreference);
+    }
+    if (a.opacity >= 0) {
+        darling_set_window_opacity(win, (uint8_t)a.opacity);
+    }
+    darling_commit_appearance_update(win);
+}
+
+static DarlingAsyncTask appearance_op(std::unique_ptr<DarlingAsyncOp> op, DarlingAppearance appearance) {
+    op->onUiThread = co_await DarlingOnUiThread{};
+
+    if (async_begin(op.get())) {
+        apply_appearance(op->win, appearance);
+    }
+    op->finished = darling_input_now();
+
+    if (!co_await DarlingOnJsThread{ op.get() }) {
+        op->promise.SuppressDestruct();
+        co_return;
+    }
+
+    Napi::Env env(op->env);
+    Napi::HandleScope scope(env);
+    async_settle(op.get(), env.Undefined(), nullptr);
+}
+
+static DarlingAsyncTask window_op(std::unique_ptr<DarlingAsyncOp> op, void (*fn)(DarlingWindow*)) {
+    op->onUiThread = co_await DarlingOnUiThread{};
+
+    if (async_begin(op.get())) {
+        fn(op->win);
+    }
+    op->finished = darling_input_now();
+
+    if (!co_await DarlingOnJsThread{ op.get() }) {
+        op->promise.SuppressDestruct();
+        co_return;
+    }
+
+    Napi::Env env(op->env);
+    Napi::HandleScope scope(env);
+    async_settle(op.get(), env.Undefined(), nullptr);
+}
+
+// Create a window on the UI thread; resolves to the window. It belongs to
+// the UI thread, which dispatches its messages, and is destroyed there.
+Napi::Value CreateWindowAsyncWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint32_t w = info[0].As<Napi::Number>().Uint32Value();
+    uint32_t h = info[1].As<Napi::Number>().Uint32Value();
+    uintptr_t parent = 0;
+    if (info.Length() >= 3 && !info[2].IsUndefined() && !info[2].IsNull()) {
+        parent = (uintptr_t)value_to_u64(info[2]);
+    }
+
+    auto op = std::make_unique<DarlingAsyncOp>(env, nullptr);
+    Napi::Promise promise = async_submit(op.get());
+    create_window_op(std::move(op), w, h, parent);
+    return promise;
+}
+
+// Apply several appearance settings in one batched update on the UI thread.
+Napi::Value SetAppearanceAsyncWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    if (!info[1].IsObject()) {
+        Napi::TypeError::New(env, "Expected an appearance object").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto op = std::make_unique<DarlingAsyncOp>(env, win);
+    Napi::Promise promise = async_submit(op.get());
+    appearance_op(std::move(op), appearance_from(info[1].As<Napi::Object>()));
+    return promise;
+}
+
+static Napi::Value window_op_async(const Napi::CallbackInfo& info, void (*fn)(DarlingWindow*)) {
+    auto win = info[0].As<Napi::External<DarlingWindow>>().Data();
+    auto op = std::make_unique<DarlingAsyncOp>(info.Env(), win);
+    Napi::Promise promise = async_submit(op.get());
+    window_op(std::move(op), fn);
+    return promise;
+}
+
+Napi::Value ShowWindowAsyncWrapped(const Napi::CallbackInfo& info) {
+    return window_op_async(info, darling_show_window);
+}
+
+Napi::Value HideWindowAsyncWrapped(const Napi::CallbackInfo& info) {
+    return window_op_async(info, darling_hide_window);
+}
+
+Napi::Value FocusWindowAsyncWrapped(const Napi::CallbackInfo& info) {
+    return window_op_async(info, darling_focus_window);
+}
+
+// Cancel an async operation that has not started; its promise rejects with
+// an AbortError. False if it already started or settled.
+Napi::Value CancelAsyncWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uint32_t id = info[0].As<Napi::Number>().Uint32Value();
+    DarlingAddonData* data = addon_data(env);
+
+    auto it = data->asyncOps.find(id);
+    if (it == data->asyncOps.end()) {
+        return Napi::Boolean::New(env, false);
+    }
+
+    int queued = DARLING_ASYNC_QUEUED;
+    return Napi::Boolean::New(env, it->second->state.compare_exchange_strong(queued, DARLING_ASYNC_CANCELLED));
+}
+
+Napi::Value GetUiThreadStatsWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    DarlingUiThreadStats stats = {};
+    darling_get_ui_thread_stats(&stats);
+
+    Napi::Object obj = Napi::Object::New(env);
+    obj.Set("running", Napi::Boolean::New(env, stats.running != 0));
+    obj.Set("pending", Napi::Number::New(env, stats.pending));
+    obj.Set("peak", Napi::Number::New(env, stats.peak));
+    obj.Set("posted", Napi::Number::New(env, (double)stats.posted));
+    obj.Set("run", Napi::Number::New(env, (double)stats.run));
+    obj.Set("inFlight", Napi::Number::New(env, (double)addon_data(env)->asyncOps.size()));
+    return obj;
+}
+
+// Export all native bindings. Runs once per environment that loads the addon.
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    DarlingAddonData* data = new DarlingAddonData();
+    env.SetInstanceData(data);
+    env.AddCleanupHook(addon_cleanup, data);
+
+    {
+        std::lock_guard<std::mutex> lock(g_callbacks_mutex);
+        g_environments.insert(data);
+    }
+
     exports.Set("createWindow", Napi::Function::New(env, CreateDarlingWindow));
     exports.Set("destroyWindow", Napi::Function::New(env, DestroyDarlingWindow));
     exports.Set("onCloseRequested", Napi::Function::New(env, SetOnCloseCallback));
     exports.Set("onCloseRequestedForWindow", Napi::Function::New(env, SetOnCloseCallbackForWindow));
+    exports.Set("onDpiChangedForWindow", Napi::Function::New(env, SetOnDpiChangedCallbackForWindow));
+    exports.Set("onFrameRequestedForWindow", Napi::Function::New(env, SetOnFrameRequestedCallbackForWindow));
+    exports.Set("onTilesRequestedForWindow", Napi::Function::New(env, SetOnTilesRequestedCallbackForWindow));
+    exports.Set("onVisibilityChangedForWindow", Napi::Function::New(env, SetOnVisibilityChangedCallbackForWindow));
+    exports.Set("onAnimationDoneForWindow", Napi::Function::New(env, SetOnAnimationDoneCallbackForWindow));
     exports.Set("showDarlingWindow", Napi::Function::New(env, ShowWindowWrapped));
     exports.Set("hideDarlingWindow", Napi::Function::New(env, HideWindowWrapped));
     exports.Set("focusDarlingWindow", Napi::Function::New(env, FocusWindowWrapped));
@@ -462,6 +2332,51 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set("getHWND", Napi::Function::New(env, GetHWND));
     exports.Set("getWindowHWND", Napi::Function::New(env, GetWindowHWND));
     exports.Set("paintFrame", Napi::Function::New(env, PaintFrameWrapped));
+    exports.Set("paintFrameWindow", Napi::Function::New(env, PaintFrameWindowWrapped));
+    exports.Set("paintFrameHwnd", Napi::Function::New(env, PaintFrameHwndWrapped));
+    exports.Set("paintYuvWindow", Napi::Function::New(env, PaintYuvWindowWrapped));
+    exports.Set("getFrameRecord", Napi::Function::New(env, GetFrameRecordWrapped));
+    exports.Set("getFrameTiming", Napi::Function::New(env, GetFrameTimingWrapped));
+    exports.Set("resetFrameTiming", Napi::Function::New(env, ResetFrameTimingWrapped));
+    exports.Set("setFrameOverlay", Napi::Function::New(env, SetFrameOverlayWrapped));
+    exports.Set("layerCreate", Napi::Function::New(env, LayerCreateWrapped));
+    exports.Set("layerDestroy", Napi::Function::New(env, LayerDestroyWrapped));
+    exports.Set("layerSetPosition", Napi::Function::New(env, LayerSetPositionWrapped));
+    exports.Set("layerSetZ", Napi::Function::New(env, LayerSetZWrapped));
+    exports.Set("layerSetOpacity", Napi::Function::New(env, LayerSetOpacityWrapped));
+    exports.Set("layerSetVisible", Napi::Function::New(env, LayerSetVisibleWrapped));
+    exports.Set("layerUpdate", Napi::Function::New(env, LayerUpdateWrapped));
+    exports.Set("getCompositorStats", Napi::Function::New(env, GetCompositorStatsWrapped));
+    exports.Set("frameRingCreate", Napi::Function::New(env, FrameRingCreateWrapped));
+    exports.Set("frameRingClose", Napi::Function::New(env, FrameRingCloseWrapped));
+    exports.Set("frameRingPresent", Napi::Function::New(env, FrameRingPresentWrapped));
+    exports.Set("frameRingPresentHwnd", Napi::Function::New(env, FrameRingPresentHwndWrapped));
+    exports.Set("getFrameRingStats", Napi::Function::New(env, GetFrameRingStatsWrapped));
+    exports.Set("getThumbnail", Napi::Function::New(env, GetThumbnailWrapped));
+    exports.Set("releaseThumbnails", Napi::Function::New(env, ReleaseThumbnailsWrapped));
+    exports.Set("getThumbnailStats", Napi::Function::New(env, GetThumbnailStatsWrapped));
+    exports.Set("saveSnapshot", Napi::Function::New(env, SaveSnapshotWrapped));
+    exports.Set("readSnapshotInfo", Napi::Function::New(env, ReadSnapshotInfoWrapped));
+    exports.Set("setSplashSnapshot", Napi::Function::New(env, SetSplashSnapshotWrapped));
+    exports.Set("endSplash", Napi::Function::New(env, EndSplashWrapped));
+    exports.Set("getSplashStats", Napi::Function::New(env, GetSplashStatsWrapped));
+    exports.Set("drawSubmit", Napi::Function::New(env, DrawSubmitWrapped));
+    exports.Set("drawImageUpload", Napi::Function::New(env, DrawImageUploadWrapped));
+    exports.Set("drawImageRelease", Napi::Function::New(env, DrawImageReleaseWrapped));
+    exports.Set("getDrawStats", Napi::Function::New(env, GetDrawStatsWrapped));
+    exports.Set("surfaceCreate", Napi::Function::New(env, SurfaceCreateWrapped));
+    exports.Set("surfaceClose", Napi::Function::New(env, SurfaceCloseWrapped));
+    exports.Set("surfaceUploadTile", Napi::Function::New(env, SurfaceUploadTileWrapped));
+    exports.Set("surfaceScrollTo", Napi::Function::New(env, SurfaceScrollToWrapped));
+    exports.Set("surfaceInvalidate", Napi::Function::New(env, SurfaceInvalidateWrapped));
+    exports.Set("getSurfaceStats", Napi::Function::New(env, GetSurfaceStatsWrapped));
+    exports.Set("setThrottlePolicy", Napi::Function::New(env, SetThrottlePolicyWrapped));
+    exports.Set("getPowerStats", Napi::Function::New(env, GetPowerStatsWrapped));
+    exports.Set("setPresentMode", Napi::Function::New(env, SetPresentModeWrapped));
+    exports.Set("getPresentStats", Napi::Function::New(env, GetPresentStatsWrapped));
+    exports.Set("animate", Napi::Function::New(env, AnimateWrapped));
+    exports.Set("animateCancel", Napi::Function::New(env, AnimateCancelWrapped));
+    exports.Set("getAnimationStats", Napi::Function::New(env, GetAnimationStatsWrapped));
     exports.Set("setParent", Napi::Function::New(env, SetParentWrapped));
     exports.Set("setWindowStyles", Napi::Function::New(env, SetWindowStylesWrapped));
     exports.Set("setWindowExStyles", Napi::Function::New(env, SetWindowExStylesWrapped));
@@ -473,9 +2388,42 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set("setTitlebarColors", Napi::Function::New(env, SetTitlebarColorsWrapped));
     exports.Set("setTitlebarColor", Napi::Function::New(env, SetTitlebarColorWrapped));
     exports.Set("setCornerPreference", Napi::Function::New(env, SetCornerPreferenceWrapped));
+    exports.Set("layoutAdd", Napi::Function::New(env, LayoutAddWrapped));
+    exports.Set("layoutSetChild", Napi::Function::New(env, LayoutSetChildWrapped));
+    exports.Set("layoutSetSize", Napi::Function::New(env, LayoutSetSizeWrapped));
+    exports.Set("layoutSetActive", Napi::Function::New(env, LayoutSetActiveWrapped));
+    exports.Set("layoutClear", Napi::Function::New(env, LayoutClearWrapped));
+    exports.Set("layoutApply", Napi::Function::New(env, LayoutApplyWrapped));
+    exports.Set("hitRegionAdd", Napi::Function::New(env, HitRegionAddWrapped));
+    exports.Set("hitRegionSet", Napi::Function::New(env, HitRegionSetWrapped));
+    exports.Set("hitRegionRemove", Napi::Function::New(env, HitRegionRemoveWrapped));
+    exports.Set("hitRegionClear", Napi::Function::New(env, HitRegionClearWrapped));
+    exports.Set("hitTest", Napi::Function::New(env, HitTestWrapped));
+    exports.Set("beginAppearanceUpdate", Napi::Function::New(env, BeginAppearanceUpdateWrapped));
+    exports.Set("commitAppearanceUpdate", Napi::Function::New(env, CommitAppearanceUpdateWrapped));
     exports.Set("flashWindow", Napi::Function::New(env, FlashWindowWrapped));
     exports.Set("getDpi", Napi::Function::New(env, GetDpiWrapped));
     exports.Set("getScaleFactor", Napi::Function::New(env, GetScaleFactorWrapped));
+    exports.Set("setMemoryBudget", Napi::Function::New(env, SetMemoryBudgetWrapped));
+    exports.Set("getMemoryStats", Napi::Function::New(env, GetMemoryStatsWrapped));
+    exports.Set("getWindowMemoryStats", Napi::Function::New(env, GetWindowMemoryStatsWrapped));
+    exports.Set("setThreadPool", Napi::Function::New(env, SetThreadPoolWrapped));
+    exports.Set("getThreadPoolStats", Napi::Function::New(env, GetThreadPoolStatsWrapped));
+    exports.Set("inputRingBytes", Napi::Function::New(env, InputRingBytesWrapped));
+    exports.Set("attachInputRing", Napi::Function::New(env, AttachInputRingWrapped));
+    exports.Set("detachInputRing", Napi::Function::New(env, DetachInputRingWrapped));
+    exports.Set("stateMirrorBytes", Napi::Function::New(env, StateMirrorBytesWrapped));
+    exports.Set("attachStateMirror", Napi::Function::New(env, AttachStateMirrorWrapped));
+    exports.Set("detachStateMirror", Napi::Function::New(env, DetachStateMirrorWrapped));
+    exports.Set("getInputStats", Napi::Function::New(env, GetInputStatsWrapped));
+    exports.Set("inputNow", Napi::Function::New(env, InputNowWrapped));
+    exports.Set("createWindowAsync", Napi::Function::New(env, CreateWindowAsyncWrapped));
+    exports.Set("setAppearanceAsync", Napi::Function::New(env, SetAppearanceAsyncWrapped));
+    exports.Set("showWindowAsync", Napi::Function::New(env, ShowWindowAsyncWrapped));
+    exports.Set("hideWindowAsync", Napi::Function::New(env, HideWindowAsyncWrapped));
+    exports.Set("focusWindowAsync", Napi::Function::New(env, FocusWindowAsyncWrapped));
+    exports.Set("cancelAsync", Napi::Function::New(env, CancelAsyncWrapped));
+    exports.Set("getUiThreadStats", Napi::Function::New(env, GetUiThreadStatsWrapped));
     return exports;
 }
 
@@ -0,0 +1,253 @@
+#include "bench.h"
+#include "darling.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+DarlingBenchOptions g_bench_options = { NULL, NULL, 7, 20000000ull };
+
+typedef struct DarlingBenchResult {
+    char name[64];
+    char params[160];
+    uint64_t iterations;
+    double nsMedian;
+    double nsMin;
+    double bytesPerOp;
+    double itemsPerOp;
+} DarlingBenchResult;
+
+static DarlingBenchResult* g_results = NULL;
+static size_t g_result_count = 0;
+static size_t g_result_capacity = 0;
+static uint32_t g_failures = 0;
+
+uint64_t darling_bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int darling_bench_enabled(const char* name) {
+    return !g_bench_options.filter || strstr(name, g_bench_options.filter) != NULL;
+}
+
+int darling_bench_expect(const char* suite, const char* step, int ok) {
+    if (!ok) {
+        g_failures++;
+        fprintf(stderr, "  check %s: %s failed\n", suite, step);
+    }
+    return ok;
+}
+
+uint32_t darling_bench_failures(void) {
+    return g_failures;
+}
+
+uint32_t darling_bench_rand(uint32_t* state) {
+    uint32_t x = *state ? *state : 0x9E3779B9u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+void darling_bench_fill(void* buf, size_t size, uint32_t seed) {
+    uint8_t* p = (uint8_t*)buf;
+    uint32_t state = seed;
+    for (size_t i = 0; i < size; i++) {
+        p[i] = (uint8_t)darling_bench_rand(&state);
+    }
+}
+
+static int darling_bench_cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void darling_bench_record(const DarlingBenchResult* r) {
+    if (g_result_count == g_result_capacity) {
+        size_t cap = g_result_capacity ? g_result_capacity * 2u : 64u;
+        DarlingBenchResult* grown = (DarlingBenchResult*)realloc(g_results, cap * sizeof(*grown));
+        if (!grown) {
+            return;
+        }
+        g_results = grown;
+        g_result_capacity = cap;
+    }
+    g_results[g_result_count++] = *r;
+}
+
+void darling_bench_run(const DarlingBenchCase* c) {
+    if (!darling_bench_enabled(c->name)) {
+        return;
+    }
+
+    // Calibrate: double the iteration count until one sample is long enough
+    uint64_t iters = 1;
+    for (;;) {
+        uint64_t t0 = darling_bench_now_ns();
+        c->run(c->ctx, iters);
+        uint64_t elapsed = darling_bench_now_ns() - t0;
+
+        if (elapsed >= g_bench_options.sampleNs || iters >= (1ull << 40)) {
+            break;
+        }
+
+        // Jump close to the target instead of doubling from tiny counts
+        if (elapsed > 0 && elapsed * 8u < g_bench_options.sampleNs) {
+            iters *= 8u;
+        } else {
+            iters *= 2u;
+        }
+    }
+
+    uint32_t n = g_bench_options.samples ? g_bench_options.samples : 1u;
+    double* samples = (double*)malloc(n * sizeof(double));
+    if (!samples) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t t0 = darling_bench_now_ns();
+        c->run(c->ctx, iters);
+        uint64_t elapsed = darling_bench_now_ns() - t0;
+        samples[i] = (double)elapsed / (double)iters;
+    }
+
+    qsort(samples, n, sizeof(double), darling_bench_cmp_double);
+
+    DarlingBenchResult r;
+    memset(&r, 0, sizeof(r));
+    snprintf(r.name, sizeof(r.name), "%s", c->name);
+    snprintf(r.params, sizeof(r.params), "%s", c->params ? c->params : "{}");
+    r.iterations = iters;
+    r.nsMedian = (n % 2u) ? samples[n / 2u] : 0.5 * (samples[n / 2u - 1u] + samples[n / 2u]);
+    r.nsMin = samples[0];
+    r.bytesPerOp = c->bytesPerOp;
+    r.itemsPerOp = c->itemsPerOp;
+    free(samples);
+
+    fprintf(stderr, "%-28s %-44s %12.1f ns/op", r.name, r.params, r.nsMedian);
+    if (r.bytesPerOp > 0.0) {
+        fprintf(stderr, "  %8.2f GB/s", r.bytesPerOp / r.nsMedian);
+    }
+    if (r.itemsPerOp > 0.0) {
+        fprintf(stderr, "  %10.2f M/s", r.itemsPerOp * 1000.0 / r.nsMedian);
+    }
+    fputc('\n', stderr);
+
+    darling_bench_record(&r);
+}
+
+static void darling_bench_write_json(FILE* f) {
+    fprintf(f, "{\n  \"samples\": %u,\n  \"sample_ns\": %llu,\n  \"benchmarks\": [\n",
+        g_bench_options.samples, (unsigned long long)g_bench_options.sampleNs);
+
+    for (size_t i = 0; i < g_result_count; i++) {
+        const DarlingBenchResult* r = &g_results[i];
+        fprintf(f,
+            "    {\"name\": \"%s\", \"params\": %s, \"iterations\": %llu, "
+            "\"ns_per_op_median\": %.3f, \"ns_per_op_min\": %.3f",
+            r->name, r->params, (unsigned long long)r->iterations, r->nsMedian, r->nsMin);
+
+        if (r->bytesPerOp > 0.0) {
+            fprintf(f, ", \"bytes_per_op\": %.0f, \"gb_per_s\": %.3f",
+                r->bytesPerOp, r->bytesPerOp / r->nsMedian);
+        }
+        if (r->itemsPerOp > 0.0) {
+            fprintf(f, ", \"items_per_op\": %.0f, \"items_per_s\": %.1f",
+                r->itemsPerOp, r->itemsPerOp * 1e9 / r->nsMedian);
+        }
+
+        fprintf(f, "}%s\n", i + 1 < g_result_count ? "," : "");
+    }
+
+    fprintf(f, "  ]\n}\n");
+}
+
+static void darling_bench_usage(void) {
+    fprintf(stderr,
+        "usage: darling_bench [--filter <substr>] [--samples <n>] [--sample-ms <ms>]\n"
+        "                     [--quick] [--out <file.json>]\n");
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--filter") == 0 && value) {
+            g_bench_options.filter = value;
+            i++;
+        } else if (strcmp(arg, "--samples") == 0 && value) {
+            g_bench_options.samples = (uint32_t)strtoul(value, NULL, 10);
+            i++;
+        } else if (strcmp(arg, "--sample-ms") == 0 && value) {
+            g_bench_options.sampleNs = strtoull(value, NULL, 10) * 1000000ull;
+            i++;
+        } else if (strcmp(arg, "--out") == 0 && value) {
+            g_bench_options.out = value;
+            i++;
+        } else if (strcmp(arg, "--quick") == 0) {
+            g_bench_options.samples = 3;
+            g_bench_options.sampleNs = 2000000ull;
+        } else {
+            darling_bench_usage();
+            return 2;
+        }
+    }
+
+    darling_init();
+
+    darling_bench_suite_frame();
+    darling_bench_suite_list();
+    darling_bench_suite_events();
+    darling_bench_suite_lock();
+    darling_bench_suite_settings();
+    darling_bench_suite_appearance();
+    darling_bench_suite_layout();
+    darling_bench_suite_memory();
+    darling_bench_suite_hittest();
+    darling_bench_suite_input();
+    darling_bench_suite_timing();
+    darling_bench_suite_compositor();
+    darling_bench_suite_pool();
+    darling_bench_suite_framering();
+    darling_bench_suite_yuv();
+    darling_bench_suite_thumbnail();
+    darling_bench_suite_mirror();
+    darling_bench_suite_uithread();
+    darling_bench_suite_snapshot();
+    darling_bench_suite_displaylist();
+    darling_bench_suite_surface();
+    darling_bench_suite_power();
+    darling_bench_suite_anim();
+    darling_bench_suite_layered();
+
+    FILE* f = stdout;
+    if (g_bench_options.out) {
+        f = fopen(g_bench_options.out, "w");
+        if (!f) {
+            perror(g_bench_options.out);
+            return 1;
+        }
+    }
+
+    darling_bench_write_json(f);
+
+    if (f != stdout) {
+        fclose(f);
+    }
+
+    free(g_results);
+    darling_cleanup();
+
+    if (g_failures) {
+        fprintf(stderr, "%u checks failed\n", g_failures);
+        return 1;
+    }
+    return 0;
+}
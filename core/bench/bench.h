@@ -0,0 +1,75 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Minimal microbenchmark harness for darling_bench.
+// Each case is calibrated so one sample runs for at least the configured
+// sample time, then measured `samples` times; median and min ns/op are kept.
+
+typedef void (*DarlingBenchFn)(void* ctx, uint64_t iterations);
+
+typedef struct DarlingBenchCase {
+    const char* name;       // e.g. "frame_copy_full"
+    const char* params;     // JSON object text, e.g. {"width":1920,"height":1080}
+    DarlingBenchFn run;
+    void* ctx;
+    double bytesPerOp;      // 0 if not a throughput case
+    double itemsPerOp;      // 0 if not an item-rate case
+} DarlingBenchCase;
+
+typedef struct DarlingBenchOptions {
+    const char* filter;     // run only cases whose name contains this
+    const char* out;        // JSON output path (stdout if NULL)
+    uint32_t samples;
+    uint64_t sampleNs;
+} DarlingBenchOptions;
+
+extern DarlingBenchOptions g_bench_options;
+
+// Monotonic clock in nanoseconds
+uint64_t darling_bench_now_ns(void);
+
+// Return 1 if the case name passes the --filter option
+int darling_bench_enabled(const char* name);
+
+// Calibrate, measure and record a case
+void darling_bench_run(const DarlingBenchCase* c);
+
+// Record a correctness check. A failed one is reported under `suite` and
+// makes darling_bench exit non-zero. Returns `ok`.
+int darling_bench_expect(const char* suite, const char* step, int ok);
+
+// Checks failed so far
+uint32_t darling_bench_failures(void);
+
+// Deterministic xorshift PRNG for workloads
+uint32_t darling_bench_rand(uint32_t* state);
+
+// Fill a buffer with pseudo-random bytes
+void darling_bench_fill(void* buf, size_t size, uint32_t seed);
+
+// Suites (one per file)
+void darling_bench_suite_frame(void);
+void darling_bench_suite_list(void);
+void darling_bench_suite_events(void);
+void darling_bench_suite_lock(void);
+void darling_bench_suite_settings(void);
+void darling_bench_suite_appearance(void);
+void darling_bench_suite_layout(void);
+void darling_bench_suite_memory(void);
+void darling_bench_suite_hittest(void);
+void darling_bench_suite_input(void);
+void darling_bench_suite_timing(void);
+void darling_bench_suite_compositor(void);
+void darling_bench_suite_pool(void);
+void darling_bench_suite_framering(void);
+void darling_bench_suite_yuv(void);
+void darling_bench_suite_thumbnail(void);
+void darling_bench_suite_mirror(void);
+void darling_bench_suite_uithread(void);
+void darling_bench_suite_snapshot(void);
+void darling_bench_suite_displaylist(void);
+void darling_bench_suite_surface(void);
+void darling_bench_suite_power(void);
+void darling_bench_suite_anim(void);
+void darling_bench_suite_layered(void);
@@ -0,0 +1,390 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Animations: 64 windows each fading, moving, resizing and recoloring
+// their titlebar back and forth, ticked once per 60 Hz refresh on a fake
+// clock (restarted from the completion callback), and evaluating the
+// cubic-bezier easing. A final check runs tweens on the fake clock against
+// values worked out by hand: linear and eased values at each tick, exact
+// end values and completion events, replacement, delays, cancellation and
+// the once-per-refresh cap for a poller running faster than the monitor.
+
+#define AN_WINDOWS 64u
+#define AN_REFRESH (1000.0 / 60.0)
+
+typedef struct AnCtx {
+    DarlingWindow* wins[AN_WINDOWS];
+    uint32_t flips[AN_WINDOWS];
+    double now;
+    uint32_t seed;
+    double sink;
+} AnCtx;
+
+static double an_clock(void* ctx) {
+    return *(const double*)ctx;
+}
+
+static AnCtx* g_an_ctx = NULL;
+
+static void an_start(AnCtx* c, uint32_t i, uint32_t property) {
+    DarlingTween t;
+    memset(&t, 0, sizeof(t));
+    BOOL back = (c->flips[i] & 1u) != 0;
+    t.property = property;
+    t.easing = DARLING_EASE_IN_OUT;
+    t.durationMs = 250.0 + 50.0 * (double)(i % 4u);
+    switch (property) {
+        case DARLING_ANIM_OPACITY:
+            t.to[0] = back ? 255 : 64;
+            break;
+        case DARLING_ANIM_POSITION:
+            t.to[0] = back ? 0 : 300;
+            t.to[1] = back ? 0 : 200;
+            break;
+        case DARLING_ANIM_SIZE:
+            t.to[0] = back ? 640 : 800;
+            t.to[1] = back ? 480 : 600;
+            break;
+        default:
+            t.to[0] = back ? 0x202020 : 0x3A6EA5;
+            break;
+    }
+    darling_animate(c->wins[i], &t);
+}
+
+// Each finished tween turns round
+static void an_on_end(uintptr_t hwnd, uint32_t id, uint32_t property, uint32_t finished) {
+    (void)id;
+    AnCtx* c = g_an_ctx;
+    for (uint32_t i = 0; c && finished && i < AN_WINDOWS; i++) {
+        if ((uintptr_t)c->wins[i]->hwnd == hwnd) {
+            if (property == DARLING_ANIM_OPACITY) {
+                c->flips[i]++;
+            }
+            an_start(c, i, property);
+            return;
+        }
+    }
+}
+
+static void run_tick(void* p, uint64_t n) {
+    AnCtx* c = (AnCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->now += AN_REFRESH;
+        darling_anim_poll();
+    }
+}
+
+static void run_ease(void* p, uint64_t n) {
+    AnCtx* c = (AnCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        double x = (double)(darling_bench_rand(&c->seed) & 0xFFFFu) / 65535.0;
+        c->sink += darling_anim_ease(DARLING_EASE, NULL, x);
+    }
+}
+
+typedef struct AnEvents {
+    uint32_t finished;
+    uint32_t cancelled;
+    uint32_t lastId;
+} AnEvents;
+
+static AnEvents g_an_events;
+
+static void an_check_on_end(uintptr_t hwnd, uint32_t id, uint32_t property, uint32_t finished) {
+    (void)hwnd;
+    (void)property;
+    g_an_events.lastId = id;
+    if (finished) {
+        g_an_events.finished++;
+    } else {
+        g_an_events.cancelled++;
+    }
+}
+
+// Within one step of rounding
+static BOOL an_near(int32_t v, double expected) {
+    double d = (double)v - expected;
+    return d > -1.0 && d < 1.0;
+}
+
+// The eased value compared with the curve sampled at 20000 points
+static double an_ease_error(uint32_t easing, const float* b) {
+    static const float curves[][4] = {
+        { 0.0f, 0.0f, 1.0f, 1.0f }, { 0.25f, 0.1f, 0.25f, 1.0f }, { 0.42f, 0.0f, 1.0f, 1.0f },
+        { 0.0f, 0.0f, 0.58f, 1.0f }, { 0.42f, 0.0f, 0.58f, 1.0f }
+    };
+    const float* p = easing == DARLING_EASE_CUBIC_BEZIER ? b : curves[easing];
+    double worst = 0.0;
+    double prevX = 0.0;
+    double prevY = 0.0;
+
+    for (uint32_t i = 1; i <= 20000u; i++) {
+        double t = (double)i / 20000.0;
+        double u = 1.0 - t;
+        double x = 3.0 * u * u * t * p[0] + 3.0 * u * t * t * p[2] + t * t * t;
+        double y = 3.0 * u * u * t * p[1] + 3.0 * u * t * t * p[3] + t * t * t;
+
+        // Halfway along this step of x, the curve is between the two ys
+        double mid = (prevX + x) * 0.5;
+        double e = darling_anim_ease(easing, b, mid);
+        double lo = prevY < y ? prevY : y;
+        double hi = prevY < y ? y : prevY;
+        double err = e < lo ? lo - e : e > hi ? e - hi : 0.0;
+        worst = err > worst ? err : worst;
+        prevX = x;
+        prevY = y;
+    }
+    return worst;
+}
+
+static void check_anim(AnCtx* c) {
+    DarlingWindow* win = darling_create_window(640, 480, 0);
+    DarlingAnimationStats st;
+    DarlingTween t;
+
+    darling_set_animation_callback(an_check_on_end);
+    memset(&g_an_events, 0, sizeof(g_an_events));
+    c->now = 1000.0;
+
+    // Linear fade over 10 refreshes: every tick on the hand-worked value
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_OPACITY;
+    t.durationMs = AN_REFRESH * 10.0;
+    t.hasFrom = 1;
+    t.from[0] = 0;
+    t.to[0] = 255;
+    uint32_t fade = darling_animate(win, &t);
+    BOOL exact = TRUE;
+    for (uint32_t i = 0; i <= 10u; i++) {
+        darling_poll_events();
+        exact = exact && an_near(win->opacity, 255.0 * (double)i / 10.0);
+        c->now += AN_REFRESH;
+    }
+    darling_get_animation_stats(win, &st);
+    darling_bench_expect("anim", "linear fade", exact && st.active == 0 && st.finished == 1 && st.ticks == 11 &&
+        g_an_events.finished == 1 && g_an_events.lastId == fade);
+
+    // Eased move and resize together: the symmetric curve is halfway at
+    // half time, and each tick is one window move
+    uint64_t moves = win->windowPosCount;
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_POSITION;
+    t.easing = DARLING_EASE_IN_OUT;
+    t.durationMs = AN_REFRESH * 8.0;
+    t.to[0] = 400;
+    t.to[1] = -200;
+    darling_animate(win, &t);
+    t.property = DARLING_ANIM_SIZE;
+    t.to[0] = 1040;
+    t.to[1] = 880;
+    darling_animate(win, &t);
+    BOOL halfway = FALSE;
+    for (uint32_t i = 0; i <= 8u; i++) {
+        darling_poll_events();
+        if (i == 4u) {
+            halfway = an_near(win->x, 200.0) && an_near(win->y, -100.0) &&
+                an_near((int32_t)win->clientWidth, 840.0) && an_near((int32_t)win->clientHeight, 680.0);
+        }
+        c->now += AN_REFRESH;
+    }
+    darling_bench_expect("anim", "eased move and resize", halfway && win->x == 400 && win->y == -200 &&
+        win->clientWidth == 1040 && win->clientHeight == 880 && win->windowPosCount - moves == 9u &&
+        g_an_events.finished == 3);
+
+    // A new tween takes over from where the running one got to
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_POSITION;
+    t.durationMs = AN_REFRESH * 4.0;
+    t.to[0] = 0;
+    t.to[1] = 0;
+    darling_animate(win, &t);
+    darling_poll_events();
+    c->now += AN_REFRESH * 2.0;
+    darling_poll_events();
+    int32_t x = win->x;
+    t.to[0] = 100;
+    t.to[1] = 100;
+    darling_animate(win, &t);
+    darling_bench_expect("anim", "replace cancels", g_an_events.cancelled == 1);
+    darling_poll_events();
+    darling_bench_expect("anim", "replace continues", win->x == x);
+    c->now += AN_REFRESH * 4.0;
+    darling_poll_events();
+    darling_bench_expect("anim", "replace ends", win->x == 100 && win->y == 100 && g_an_events.finished == 4);
+
+    // Nothing moves during a delay
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_TITLEBAR_COLOR;
+    t.durationMs = AN_REFRESH * 2.0;
+    t.delayMs = 100.0;
+    t.hasFrom = 1;
+    t.from[0] = 0x000000;
+    t.to[0] = 0xFF8040;
+    darling_animate(win, &t);
+    BOOL still = TRUE;
+    for (double end = c->now + 99.0; c->now < end; c->now += AN_REFRESH / 2.0) {
+        darling_poll_events();
+        still = still && !win->titlebarColorSet;
+    }
+    c->now += 100.0;
+    darling_poll_events();
+    darling_bench_expect("anim", "delay", still && win->titlebarColor == 0xFF8040u && g_an_events.finished == 5);
+
+    // Channels are interpolated on their own
+    t.delayMs = 0.0;
+    t.from[0] = 0x00FF00;
+    t.to[0] = 0xFF0000;
+    darling_animate(win, &t);
+    darling_poll_events();
+    c->now += AN_REFRESH;
+    darling_poll_events();
+    uint32_t color = win->titlebarColor;
+    darling_bench_expect("anim", "color", an_near((int32_t)(color >> 16), 127.5) && an_near((int32_t)((color >> 8) & 0xFFu), 127.5) &&
+        (color & 0xFFu) == 0);
+
+    // Cancel stops in place
+    darling_animate_cancel(win, 0);
+    c->now += AN_REFRESH * 4.0;
+    darling_poll_events();
+    darling_get_animation_stats(win, &st);
+    darling_bench_expect("anim", "cancel", win->titlebarColor == color && st.active == 0 && g_an_events.cancelled == 2);
+
+    // Polled four times a refresh for a second: 60 ticks
+    darling_get_animation_stats(win, &st);
+    uint64_t ticks = st.ticks;
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_OPACITY;
+    t.durationMs = 1000.0;
+    t.hasFrom = 1;
+    t.to[0] = 255;
+    darling_animate(win, &t);
+    for (uint32_t i = 0; i < 240u; i++) {
+        darling_poll_events();
+        c->now += AN_REFRESH / 4.0;
+    }
+    darling_poll_events();
+    darling_get_animation_stats(win, &st);
+    darling_bench_expect("anim", "refresh cap", st.ticks - ticks >= 60u && st.ticks - ticks <= 61u && win->opacity == 255);
+
+    // A curve that overshoots keeps the property in range
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_OPACITY;
+    t.easing = DARLING_EASE_CUBIC_BEZIER;
+    t.bezier[0] = 0.3f;
+    t.bezier[1] = 1.8f;
+    t.bezier[2] = 0.6f;
+    t.bezier[3] = 1.8f;
+    t.durationMs = AN_REFRESH * 20.0;
+    t.hasFrom = 1;
+    t.from[0] = 200;
+    t.to[0] = 250;
+    darling_animate(win, &t);
+    BOOL inside = TRUE;
+    BOOL capped = FALSE;
+    for (uint32_t i = 0; i < 24u; i++) {
+        c->now += AN_REFRESH;
+        darling_poll_events();
+        inside = inside && win->opacity >= 200;
+        capped = capped || win->opacity == 255;
+    }
+    darling_bench_expect("anim", "overshoot clamped", inside && capped && win->opacity == 250);
+
+    // Invalid tweens are refused, whichever end is out of range
+    memset(&t, 0, sizeof(t));
+    t.property = DARLING_ANIM_OPACITY;
+    t.to[0] = 300;
+    BOOL refused = darling_animate(win, &t) == 0;
+    t.to[0] = 10;
+    t.hasFrom = 1;
+    t.from[0] = -1;
+    refused = refused && darling_animate(win, &t) == 0;
+    t.hasFrom = 0;
+    t.to[0] = 10;
+    t.easing = DARLING_EASE_CUBIC_BEZIER;
+    t.bezier[0] = 1.5f;
+    refused = refused && darling_animate(win, &t) == 0;
+    t.property = DARLING_ANIM_SIZE;
+    t.easing = DARLING_EASE_LINEAR;
+    t.to[1] = 0;
+    refused = refused && darling_animate(win, &t) == 0;
+    darling_bench_expect("anim", "refused", refused);
+
+    double worst = 0.0;
+    for (uint32_t e = DARLING_EASE_LINEAR; e <= DARLING_EASE_IN_OUT; e++) {
+        double err = an_ease_error(e, NULL);
+        worst = err > worst ? err : worst;
+    }
+    const float steep[4] = { 0.9f, -0.6f, 0.1f, 1.6f };
+    double err = an_ease_error(DARLING_EASE_CUBIC_BEZIER, steep);
+    worst = err > worst ? err : worst;
+    darling_bench_expect("anim", "easing curves", worst < 1e-4);
+
+    fprintf(stderr, "  check anim: %u finished, %u cancelled, worst easing error %.2g\n",
+        g_an_events.finished, g_an_events.cancelled, worst);
+
+    darling_set_animation_callback(NULL);
+    darling_destroy_window(win);
+}
+
+void darling_bench_suite_anim(void) {
+    AnCtx c;
+    memset(&c, 0, sizeof(c));
+    c.seed = 5;
+    c.now = 0.0;
+
+    darling_set_animation_clock(an_clock, &c.now);
+
+    for (uint32_t i = 0; i < AN_WINDOWS; i++) {
+        c.wins[i] = darling_create_window(640, 480, 0);
+        if (!c.wins[i]) {
+            for (uint32_t k = 0; k < i; k++) {
+                darling_destroy_window(c.wins[k]);
+            }
+            darling_set_animation_clock(NULL, NULL);
+            return;
+        }
+    }
+
+    g_an_ctx = &c;
+    darling_set_animation_callback(an_on_end);
+    for (uint32_t i = 0; i < AN_WINDOWS; i++) {
+        for (uint32_t p = 0; p < DARLING_ANIM_PROPERTY_COUNT; p++) {
+            an_start(&c, i, p);
+        }
+    }
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"windows\":%u,\"properties\":%u}", AN_WINDOWS, DARLING_ANIM_PROPERTY_COUNT);
+    DarlingBenchCase tick = { "anim_tick", params, run_tick, &c, 0, AN_WINDOWS };
+    darling_bench_run(&tick);
+    if (darling_bench_enabled(tick.name)) {
+        DarlingAnimationStats st;
+        darling_get_animation_stats(c.wins[0], &st);
+        fprintf(stderr, "  %s: %llu ticks, %.2f property writes each, %llu tweens finished\n", tick.name,
+            (unsigned long long)st.ticks, (double)st.applied / (double)(st.ticks ? st.ticks : 1),
+            (unsigned long long)st.finished);
+    }
+
+    darling_set_animation_callback(NULL);
+    g_an_ctx = NULL;
+    for (uint32_t i = 0; i < AN_WINDOWS; i++) {
+        darling_destroy_window(c.wins[i]);
+    }
+
+    DarlingBenchCase ease = { "anim_ease_bezier", "{\"curve\":\"ease\"}", run_ease, &c, 0, 1 };
+    darling_bench_run(&ease);
+
+    if (darling_bench_enabled(tick.name)) {
+        uint32_t failures = darling_bench_failures();
+        check_anim(&c);
+        fprintf(stderr, "  check anim: %u failures\n", darling_bench_failures() - failures);
+    }
+
+    darling_set_animation_clock(NULL, NULL);
+    darling_poll_events();
+}
@@ -0,0 +1,93 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+
+// Appearance transactions: the startup sequence of theme + titlebar colors +
+// icon, applied one by one vs. inside begin/commit. The headless backend
+// counts non-client frame recalculations so the saving is visible directly.
+
+static void apply_startup_appearance(DarlingWindow* win, uint64_t i) {
+    darling_set_dark_mode(win, (int)(i & 1));
+    darling_set_titlebar_colors(win, 0x202020, 0xFFFFFF);
+    darling_set_titlebar_color(win, 0x303030);
+    darling_set_window_icon_visible(win, 0);
+}
+
+static void run_unbatched(void* p, uint64_t n) {
+    DarlingWindow* win = (DarlingWindow*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        apply_startup_appearance(win, i);
+    }
+}
+
+static void run_batched(void* p, uint64_t n) {
+    DarlingWindow* win = (DarlingWindow*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_begin_appearance_update(win);
+        apply_startup_appearance(win, i);
+        darling_commit_appearance_update(win);
+    }
+}
+
+// Nested transactions only recalculate once the outer one commits
+static void run_nested(void* p, uint64_t n) {
+    DarlingWindow* win = (DarlingWindow*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_begin_appearance_update(win);
+        darling_set_dark_mode(win, (int)(i & 1));
+        darling_begin_appearance_update(win);
+        darling_set_titlebar_colors(win, 0x202020, 0xFFFFFF);
+        darling_set_titlebar_color(win, 0x303030);
+        darling_commit_appearance_update(win);
+        darling_set_window_icon_visible(win, 0);
+        darling_commit_appearance_update(win);
+    }
+}
+
+static void run_empty(void* p, uint64_t n) {
+    DarlingWindow* win = (DarlingWindow*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_begin_appearance_update(win);
+        darling_commit_appearance_update(win);
+    }
+}
+
+static void check_frame_changes(const DarlingBenchCase* bc, DarlingWindow* win, uint64_t expected) {
+    if (!darling_bench_enabled(bc->name)) {
+        return;
+    }
+
+    uint64_t before = win->frameChangeCount;
+    bc->run(win, 1);
+
+    uint64_t changes = win->frameChangeCount - before;
+    fprintf(stderr, "  frame recalculations per sequence: %llu\n", (unsigned long long)changes);
+    darling_bench_expect("appearance", bc->name, changes == expected);
+}
+
+void darling_bench_suite_appearance(void) {
+    DarlingWindow* win = darling_create_window(640, 480, 0);
+    if (!win) {
+        fprintf(stderr, "appearance suite: window creation failed\n");
+        return;
+    }
+
+    DarlingBenchCase unbatched = { "appearance_unbatched", "{\"setters\":4}", run_unbatched, win, 0, 1 };
+    darling_bench_run(&unbatched);
+    check_frame_changes(&unbatched, win, 4);
+
+    DarlingBenchCase batched = { "appearance_batched", "{\"setters\":4}", run_batched, win, 0, 1 };
+    darling_bench_run(&batched);
+    check_frame_changes(&batched, win, 1);
+
+    DarlingBenchCase nested = { "appearance_nested", "{\"setters\":4}", run_nested, win, 0, 1 };
+    darling_bench_run(&nested);
+    check_frame_changes(&nested, win, 1);
+
+    DarlingBenchCase empty = { "appearance_empty_commit", "{\"setters\":0}", run_empty, win, 0, 1 };
+    darling_bench_run(&empty);
+    check_frame_changes(&empty, win, 0);
+
+    darling_destroy_window(win);
+}
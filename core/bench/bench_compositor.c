@@ -0,0 +1,259 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Layer compositor: the blend kernel against a straightforward per-channel
+// reference (and a bit-exactness check between the two), then a HUD layer
+// updated over a static 1080p frame versus repainting the whole frame, and
+// a full repaint under an opaque layer that occlusion culling skips.
+
+#define COMP_W 1920u
+#define COMP_H 1080u
+#define COMP_HUD_W 320u
+#define COMP_HUD_H 96u
+#define COMP_BLEND_PIXELS (256u * 1024u)
+
+typedef struct BlendCtx {
+    uint32_t* dst;
+    uint32_t* src;
+    uint8_t opacity;
+} BlendCtx;
+
+typedef struct CompositorCtx {
+    DarlingWindow* win;
+    uint8_t* frame;
+    uint8_t* hud;
+    int32_t layer;
+    uint32_t tick;
+} CompositorCtx;
+
+static uint32_t ref_div255(uint32_t x) {
+    return (x * 2u + 255u) / 510u;
+}
+
+static uint32_t ref_blend(uint32_t d, uint32_t s, uint32_t opacity) {
+    uint32_t sc[4];
+    uint32_t out = 0;
+
+    for (uint32_t c = 0; c < 4; c++) {
+        sc[c] = ref_div255(((s >> (c * 8u)) & 0xFFu) * opacity);
+    }
+
+    for (uint32_t c = 0; c < 4; c++) {
+        uint32_t v = sc[c] + ref_div255(((d >> (c * 8u)) & 0xFFu) * (255u - sc[3]));
+        out |= (v > 255u ? 255u : v) << (c * 8u);
+    }
+    return out;
+}
+
+static void run_blend_kernel(void* p, uint64_t n) {
+    BlendCtx* c = (BlendCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_blend_over(c->dst, c->src, COMP_BLEND_PIXELS, c->opacity);
+    }
+}
+
+static void run_blend_reference(void* p, uint64_t n) {
+    BlendCtx* c = (BlendCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        for (uint32_t j = 0; j < COMP_BLEND_PIXELS; j++) {
+            c->dst[j] = ref_blend(c->dst[j], c->src[j], c->opacity);
+        }
+    }
+}
+
+// Random premultiplied pixels with a mix of transparent, opaque and partial alpha
+static void fill_premultiplied(uint32_t* px, size_t count, uint32_t seed) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t r = darling_bench_rand(&seed);
+        uint32_t a = r >> 24;
+
+        if ((r & 7u) == 0) {
+            a = 0;
+        } else if ((r & 7u) == 1) {
+            a = 255;
+        }
+
+        uint32_t b = (r & 0xFFu) * a / 255u;
+        uint32_t g = ((r >> 8) & 0xFFu) * a / 255u;
+        uint32_t rr = ((r >> 16) & 0xFFu) * a / 255u;
+        px[i] = b | (g << 8) | (rr << 16) | (a << 24);
+    }
+}
+
+static void check_blend(BlendCtx* c) {
+    static const uint8_t k_opacity[] = { 255, 200, 128, 1 };
+    size_t mismatches = 0;
+
+    for (size_t k = 0; k < sizeof(k_opacity); k++) {
+        fill_premultiplied(c->src, COMP_BLEND_PIXELS, 11u + (uint32_t)k);
+        fill_premultiplied(c->dst, COMP_BLEND_PIXELS, 23u + (uint32_t)k);
+
+        uint32_t* expected = (uint32_t*)malloc(COMP_BLEND_PIXELS * 4u);
+        if (!expected) {
+            return;
+        }
+
+        for (uint32_t j = 0; j < COMP_BLEND_PIXELS; j++) {
+            expected[j] = ref_blend(c->dst[j], c->src[j], k_opacity[k]);
+        }
+
+        // Odd length exercises the scalar tail as well
+        darling_frame_blend_over(c->dst, c->src, COMP_BLEND_PIXELS - 3u, k_opacity[k]);
+        darling_frame_blend_over(c->dst + COMP_BLEND_PIXELS - 3u, c->src + COMP_BLEND_PIXELS - 3u, 3u, k_opacity[k]);
+
+        for (uint32_t j = 0; j < COMP_BLEND_PIXELS; j++) {
+            mismatches += c->dst[j] != expected[j];
+        }
+        free(expected);
+    }
+
+    fprintf(stderr, "  blend vs reference: %zu mismatched pixels\n", mismatches);
+    darling_bench_expect("compositor", "blend vs reference", mismatches == 0);
+}
+
+static void run_hud_update(void* p, uint64_t n) {
+    CompositorCtx* c = (CompositorCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        c->hud[(c->tick++ % (COMP_HUD_W * COMP_HUD_H)) * 4u] ^= 0xFFu;
+        darling_layer_update(c->win, c->layer, c->hud, 0, 0, COMP_HUD_W, COMP_HUD_H, 0);
+        darling_poll_events();
+    }
+}
+
+static void run_full_repaint(void* p, uint64_t n) {
+    CompositorCtx* c = (CompositorCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        c->frame[(c->tick++ % (COMP_W * COMP_H)) * 4u] ^= 0xFFu;
+        darling_paint_frame_window(c->win, c->frame, COMP_W, COMP_H);
+        darling_poll_events();
+    }
+}
+
+static void report_stats(DarlingWindow* win, uint64_t* lastComposited, uint64_t* lastCulled) {
+    DarlingCompositorStats stats;
+    darling_get_compositor_stats(win, &stats);
+
+    fprintf(stderr, "  layers %u, flushes %llu, composited %llu px, culled %llu px\n",
+        stats.layers, (unsigned long long)stats.flushes,
+        (unsigned long long)(stats.compositedPixels - *lastComposited),
+        (unsigned long long)(stats.culledPixels - *lastCulled));
+
+    *lastComposited = stats.compositedPixels;
+    *lastCulled = stats.culledPixels;
+}
+
+static void bench_blend(void) {
+    BlendCtx c = { 0 };
+
+    c.dst = (uint32_t*)malloc(COMP_BLEND_PIXELS * 4u);
+    c.src = (uint32_t*)malloc(COMP_BLEND_PIXELS * 4u);
+    if (!c.dst || !c.src) {
+        fprintf(stderr, "compositor suite: allocation failed\n");
+        free(c.dst);
+        free(c.src);
+        return;
+    }
+
+    fill_premultiplied(c.src, COMP_BLEND_PIXELS, 5u);
+    fill_premultiplied(c.dst, COMP_BLEND_PIXELS, 9u);
+
+    for (int partial = 0; partial <= 1; partial++) {
+        char params[64];
+        c.opacity = partial ? 200 : 255;
+        snprintf(params, sizeof(params), "{\"pixels\":%u,\"opacity\":%u}", COMP_BLEND_PIXELS, (unsigned)c.opacity);
+
+        DarlingBenchCase kernel = { "layer_blend", params, run_blend_kernel, &c, (double)COMP_BLEND_PIXELS * 4.0, 0 };
+        darling_bench_run(&kernel);
+
+        DarlingBenchCase reference = { "layer_blend_reference", params, run_blend_reference, &c, (double)COMP_BLEND_PIXELS * 4.0, 0 };
+        darling_bench_run(&reference);
+    }
+
+    if (darling_bench_enabled("layer_blend")) {
+        check_blend(&c);
+    }
+
+    free(c.dst);
+    free(c.src);
+}
+
+void darling_bench_suite_compositor(void) {
+    bench_blend();
+
+    CompositorCtx c = { 0 };
+    size_t frameBytes = (size_t)COMP_W * COMP_H * 4u;
+    size_t hudBytes = (size_t)COMP_HUD_W * COMP_HUD_H * 4u;
+    char params[96];
+
+    c.frame = (uint8_t*)malloc(frameBytes);
+    c.hud = (uint8_t*)malloc(hudBytes);
+    c.win = darling_create_window(COMP_W, COMP_H, 0);
+
+    if (!c.frame || !c.hud || !c.win) {
+        fprintf(stderr, "compositor suite: allocation failed\n");
+        free(c.frame);
+        free(c.hud);
+        if (c.win) {
+            darling_destroy_window(c.win);
+        }
+        return;
+    }
+
+    darling_bench_fill(c.frame, frameBytes, 3u);
+    darling_bench_fill(c.hud, hudBytes, 4u);
+
+    // Same full-frame repaint with no layers, for comparison
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"layers\":0}", COMP_W, COMP_H);
+    DarlingBenchCase baseline = { "compositor_full_repaint", params, run_full_repaint, &c, (double)frameBytes, 0 };
+    darling_bench_run(&baseline);
+
+    darling_paint_frame_window(c.win, c.frame, COMP_W, COMP_H);
+    c.layer = darling_layer_create(c.win, 40, 40, COMP_HUD_W, COMP_HUD_H, 1);
+    darling_layer_set_opacity(c.win, c.layer, 220);
+    darling_poll_events();
+
+    DarlingCompositorStats start;
+    darling_get_compositor_stats(c.win, &start);
+    uint64_t composited = start.compositedPixels;
+    uint64_t culled = start.culledPixels;
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"hud\":\"%ux%u\"}", COMP_W, COMP_H, COMP_HUD_W, COMP_HUD_H);
+    DarlingBenchCase hud = { "compositor_hud_update", params, run_hud_update, &c, (double)hudBytes, 0 };
+    darling_bench_run(&hud);
+    if (darling_bench_enabled(hud.name)) {
+        report_stats(c.win, &composited, &culled);
+    }
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"layers\":1}", COMP_W, COMP_H);
+    DarlingBenchCase repaint = { "compositor_full_repaint", params, run_full_repaint, &c, (double)frameBytes, 0 };
+    darling_bench_run(&repaint);
+    if (darling_bench_enabled(repaint.name)) {
+        report_stats(c.win, &composited, &culled);
+    }
+
+    // An opaque window-sized layer (e.g. a modal sheet) hides the content
+    int32_t sheet = darling_layer_create(c.win, 0, 0, COMP_W, COMP_H, 0);
+    for (size_t i = 3; i < frameBytes; i += 4) {
+        c.frame[i] = 0xFFu;
+    }
+    darling_layer_update(c.win, sheet, c.frame, 0, 0, COMP_W, COMP_H, 1);
+    darling_poll_events();
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"layers\":2,\"occluded\":true}", COMP_W, COMP_H);
+    DarlingBenchCase occluded = { "compositor_full_repaint", params, run_full_repaint, &c, (double)frameBytes, 0 };
+    darling_bench_run(&occluded);
+    if (darling_bench_enabled(occluded.name)) {
+        report_stats(c.win, &composited, &culled);
+    }
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.frame);
+    free(c.hud);
+}
@@ -0,0 +1,275 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Display lists: a 1920x1080 dashboard (panels, grid lines, icon sprites,
+// labels from a glyph atlas) updated by submitting its list again with one
+// value changed, with a tenth of the values changed, and with everything
+// redrawn, against sending the same dashboard as a full frame through
+// darling_paint_frame_window (the copy alone; rendering the frame in
+// JavaScript is not counted). A final check applies random edits and
+// compares the retained window with one drawn from scratch each time.
+
+#define DL_W 1920u
+#define DL_H 1080u
+#define DL_COLS 8u
+#define DL_ROWS 6u
+#define DL_PANELS (DL_COLS * DL_ROWS)
+#define DL_LABEL 12u                    // glyphs per value label
+#define DL_GLYPH_W 8u
+#define DL_GLYPH_H 16u
+#define DL_ATLAS 1u
+#define DL_ICONS 2u
+#define DL_CHECK_EDITS 300u
+
+typedef struct DlCtx {
+    DarlingWindow* win;
+    uint32_t* words;
+    size_t count;
+    size_t labelAt[DL_PANELS];          // word offset of each panel's value label
+    uint32_t* frame;
+    uint32_t seed;
+    uint32_t tick;
+} DlCtx;
+
+static size_t put_rect(uint32_t* w, int32_t x, int32_t y, uint32_t width, uint32_t height, uint32_t color) {
+    w[0] = DARLING_DRAW_RECT | 6u << 8;
+    w[1] = (uint32_t)x;
+    w[2] = (uint32_t)y;
+    w[3] = width;
+    w[4] = height;
+    w[5] = color;
+    return 6;
+}
+
+static size_t put_line(uint32_t* w, int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color, uint32_t width) {
+    w[0] = DARLING_DRAW_LINE | 7u << 8;
+    w[1] = (uint32_t)x0;
+    w[2] = (uint32_t)y0;
+    w[3] = (uint32_t)x1;
+    w[4] = (uint32_t)y1;
+    w[5] = color;
+    w[6] = width;
+    return 7;
+}
+
+static size_t put_sprite(uint32_t* w, uint32_t image, int32_t x, int32_t y, uint32_t size) {
+    w[0] = DARLING_DRAW_IMAGE | 8u << 8;
+    w[1] = image;
+    w[2] = (uint32_t)x;
+    w[3] = (uint32_t)y;
+    w[4] = 0;
+    w[5] = 0;
+    w[6] = size;
+    w[7] = size;
+    return 8;
+}
+
+// A label of DL_LABEL glyphs from a 16 x 6 atlas of printable ASCII
+static void set_label(uint32_t* w, uint32_t value) {
+    for (uint32_t i = 0; i < DL_LABEL; i++) {
+        uint32_t digit = (value >> ((i % 8u) * 4u)) & 0xFu;
+        uint32_t ch = (i < 8u ? '0' + digit % 10u : 'A' + i) - 32u;
+        uint32_t* g = w + 5u + i * 3u;
+        g[0] = i * DL_GLYPH_W;
+        g[1] = (ch % 16u) * DL_GLYPH_W | ((ch / 16u) * DL_GLYPH_H) << 16;
+        g[2] = DL_GLYPH_W | DL_GLYPH_H << 16;
+    }
+}
+
+static size_t put_label(uint32_t* w, int32_t x, int32_t y, uint32_t color, uint32_t value) {
+    w[0] = DARLING_DRAW_GLYPHS | (5u + DL_LABEL * 3u) << 8;
+    w[1] = DL_ATLAS;
+    w[2] = color;
+    w[3] = (uint32_t)x;
+    w[4] = (uint32_t)y;
+    set_label(w, value);
+    return 5u + DL_LABEL * 3u;
+}
+
+static void build_dashboard(DlCtx* c) {
+    uint32_t* w = c->words;
+    size_t n = 0;
+    uint32_t pw = DL_W / DL_COLS;
+    uint32_t ph = (DL_H - 40u) / DL_ROWS;
+
+    n += put_rect(w + n, 0, 0, DL_W, 40, 0xFF2D2D30u);
+    for (uint32_t p = 0; p < DL_PANELS; p++) {
+        int32_t x = (int32_t)((p % DL_COLS) * pw);
+        int32_t y = 40 + (int32_t)((p / DL_COLS) * ph);
+
+        n += put_rect(w + n, x + 4, y + 4, pw - 8u, ph - 8u, 0xFF252526u);
+        n += put_rect(w + n, x + 4, y + 4, pw - 8u, 24, 0xFF333337u);
+        n += put_sprite(w + n, DL_ICONS, x + 8, y + 8, 16);
+        for (uint32_t k = 1; k < 4; k++) {
+            int32_t gy = y + 40 + (int32_t)(k * (ph - 60u) / 4u);
+            n += put_line(w + n, x + 12, gy, x + (int32_t)pw - 12, gy, 0x40FFFFFFu, 1);
+        }
+        n += put_line(w + n, x + 12, y + (int32_t)ph - 20, x + (int32_t)pw - 12, y + 50, 0xFF3794FFu, 2);
+        c->labelAt[p] = n;
+        n += put_label(w + n, x + 30, y + 8, 0xFFD4D4D4u, p * 2654435761u);
+    }
+    c->count = n;
+}
+
+static void upload_images(DarlingWindow* win) {
+    uint32_t atlas[16u * DL_GLYPH_W * 6u * DL_GLYPH_H];
+    uint32_t icon[16 * 16];
+    uint32_t seed = 99;
+
+    // Glyph coverage: strokes of varying alpha
+    for (size_t i = 0; i < sizeof(atlas) / sizeof(atlas[0]); i++) {
+        uint32_t r = darling_bench_rand(&seed);
+        atlas[i] = (r & 3u) == 0u ? 0xFFFFFFFFu : (r & 3u) == 1u ? 0x80FFFFFFu : 0;
+    }
+    for (uint32_t i = 0; i < 16u * 16u; i++) {
+        uint32_t x = i % 16u;
+        uint32_t y = i / 16u;
+        icon[i] = (x - 8u) * (x - 8u) + (y - 8u) * (y - 8u) < 49u ? 0xFF4EC9B0u : 0;
+    }
+
+    darling_draw_image_upload(win, DL_ATLAS, (const uint8_t*)atlas, 16u * DL_GLYPH_W, 6u * DL_GLYPH_H, 0);
+    darling_draw_image_upload(win, DL_ICONS, (const uint8_t*)icon, 16, 16, 0);
+}
+
+static void change_value(DlCtx* c, uint32_t panel) {
+    set_label(c->words + c->labelAt[panel], darling_bench_rand(&c->seed));
+}
+
+static void run_one_value(void* p, uint64_t n) {
+    DlCtx* c = (DlCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        change_value(c, c->tick++ % DL_PANELS);
+        darling_draw_submit(c->win, c->words, c->count, 0xFF1E1E1Eu);
+    }
+}
+
+static void run_tenth(void* p, uint64_t n) {
+    DlCtx* c = (DlCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        for (uint32_t k = 0; k < DL_PANELS / 10u; k++) {
+            change_value(c, c->tick++ % DL_PANELS);
+        }
+        darling_draw_submit(c->win, c->words, c->count, 0xFF1E1E1Eu);
+    }
+}
+
+// A background change redraws the whole window
+static void run_full_raster(void* p, uint64_t n) {
+    DlCtx* c = (DlCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_draw_submit(c->win, c->words, c->count, (c->tick++ & 1u) ? 0xFF1E1E1Eu : 0xFF1F1F1Fu);
+    }
+}
+
+static void run_full_frame(void* p, uint64_t n) {
+    DlCtx* c = (DlCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->frame[c->tick++ % (DL_W * DL_H)] ^= 1u;
+        darling_paint_frame_window(c->win, (const uint8_t*)c->frame, DL_W, DL_H);
+    }
+}
+
+// Random edits (values, moved panels, commands added and removed), each
+// compared with the list drawn from scratch into a fresh window
+static void check_retained(DlCtx* c) {
+    uint32_t* words = (uint32_t*)malloc(c->count * 2u * sizeof(uint32_t));
+    if (!words) {
+        return;
+    }
+
+    DarlingWindow* win = darling_create_window(DL_W, DL_H, 0);
+    upload_images(win);
+    memcpy(words, c->words, c->count * sizeof(uint32_t));
+    size_t count = c->count;
+    uint32_t mismatches = 0;
+
+    for (uint32_t e = 0; e < DL_CHECK_EDITS; e++) {
+        uint32_t r = darling_bench_rand(&c->seed);
+        switch (r % 4u) {
+            case 0:
+                set_label(words + c->labelAt[r / 4u % DL_PANELS], r);
+                break;
+            case 1:
+                words[c->labelAt[r / 4u % DL_PANELS] + 3u] += r % 9u;
+                break;
+            case 2:
+                if (count + 6u <= c->count * 2u) {
+                    count += put_rect(words + count, (int32_t)(r % DL_W), (int32_t)(r / 7u % DL_H), 90, 40, 0x80FF8000u);
+                }
+                break;
+            default:
+                count = count > c->count ? count - 6u : count;
+                break;
+        }
+        darling_draw_submit(win, words, count, 0xFF1E1E1Eu);
+
+        if (e % 30u == 29u) {
+            DarlingWindow* fresh = darling_create_window(DL_W, DL_H, 0);
+            upload_images(fresh);
+            darling_draw_submit(fresh, words, count, 0xFF1E1E1Eu);
+            mismatches += memcmp(win->dibBits, fresh->dibBits, (size_t)DL_W * DL_H * 4u) != 0 ? 1u : 0u;
+            darling_destroy_window(fresh);
+        }
+    }
+
+    DarlingDrawStats stats;
+    darling_get_draw_stats(win, &stats);
+    fprintf(stderr, "  check retained: %u edits, %u mismatches, %llu commands reused, %llu changed, %.1f%% of full-redraw pixels rasterized\n",
+        DL_CHECK_EDITS, mismatches, (unsigned long long)stats.reusedCommands, (unsigned long long)stats.changedCommands,
+        100.0 * (double)stats.rasterPixels / ((double)stats.submits * DL_W * DL_H));
+    darling_bench_expect("retained", "matches a full redraw", mismatches == 0);
+    darling_destroy_window(win);
+    free(words);
+}
+
+void darling_bench_suite_displaylist(void) {
+    DlCtx c;
+    memset(&c, 0, sizeof(c));
+    c.seed = 7;
+    c.words = (uint32_t*)malloc(DL_PANELS * 128u * sizeof(uint32_t) + 64u);
+    c.frame = (uint32_t*)calloc((size_t)DL_W * DL_H, 4u);
+    c.win = darling_create_window(DL_W, DL_H, 0);
+    if (!c.words || !c.frame || !c.win) {
+        free(c.words);
+        free(c.frame);
+        darling_destroy_window(c.win);
+        return;
+    }
+
+    build_dashboard(&c);
+    upload_images(c.win);
+    darling_draw_submit(c.win, c.words, c.count, 0xFF1E1E1Eu);
+
+    // The full-frame path sends the dashboard as pixels
+    memcpy(c.frame, c.win->dibBits, (size_t)DL_W * DL_H * 4u);
+
+    char params[96];
+    snprintf(params, sizeof(params), "{\"w\":%u,\"h\":%u,\"panels\":%u,\"listBytes\":%zu}", DL_W, DL_H, DL_PANELS,
+        c.count * sizeof(uint32_t));
+    size_t listBytes = c.count * sizeof(uint32_t);
+
+    DarlingBenchCase one = { "draw_submit_one_value", params, run_one_value, &c, listBytes, 1 };
+    darling_bench_run(&one);
+
+    DarlingBenchCase tenth = { "draw_submit_tenth_values", params, run_tenth, &c, listBytes, 1 };
+    darling_bench_run(&tenth);
+
+    DarlingBenchCase raster = { "draw_submit_full_raster", params, run_full_raster, &c, listBytes, 1 };
+    darling_bench_run(&raster);
+
+    DarlingBenchCase frame = { "draw_full_frame_paint", params, run_full_frame, &c, (uint64_t)DL_W * DL_H * 4u, 1 };
+    darling_bench_run(&frame);
+
+    if (darling_bench_enabled(one.name)) {
+        check_retained(&c);
+    }
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.words);
+    free(c.frame);
+}
@@ -0,0 +1,60 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Event dispatch: post + darling_poll_events (lookup + window procedure)
+
+#define EVENT_BATCH 1024u
+
+typedef struct EventCtx {
+    DarlingWindow** windows;
+    uint32_t count;
+} EventCtx;
+
+static void run_dispatch(void* p, uint64_t n) {
+    EventCtx* c = (EventCtx*)p;
+    uint64_t posted = 0;
+    uint32_t target = 0;
+
+    // Drain in batches like a message loop polled once per frame
+    while (posted < n) {
+        uint64_t batch = n - posted < EVENT_BATCH ? n - posted : EVENT_BATCH;
+        for (uint64_t i = 0; i < batch; i++) {
+            darling_post_message(c->windows[target]->hwnd, DARLING_MSG_NULL, 0, 0);
+            target = target + 1u == c->count ? 0u : target + 1u;
+        }
+        darling_poll_events();
+        posted += batch;
+    }
+}
+
+void darling_bench_suite_events(void) {
+    static const uint32_t k_counts[] = { 1, 64, 1024 };
+
+    for (size_t s = 0; s < sizeof(k_counts) / sizeof(k_counts[0]); s++) {
+        EventCtx c = {0};
+        c.count = k_counts[s];
+        c.windows = (DarlingWindow**)calloc(c.count, sizeof(DarlingWindow*));
+        if (!c.windows) {
+            fprintf(stderr, "events suite: allocation failed\n");
+            return;
+        }
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            c.windows[i] = darling_create_window(64, 64, 0);
+        }
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"windows\":%u,\"batch\":%u}", c.count, EVENT_BATCH);
+
+        DarlingBenchCase dispatch = { "event_dispatch", params, run_dispatch, &c, 0, 1 };
+        darling_bench_run(&dispatch);
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            darling_destroy_window(c.windows[i]);
+        }
+        free(c.windows);
+    }
+}
@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Frame copies (paint.c) and pixel conversion at common resolutions
+
+typedef struct FrameCtx {
+    DarlingWindow* win;
+    uint8_t* src;
+    uint8_t* dst;
+    uint32_t width;
+    uint32_t height;
+    uint32_t rectX;
+    uint32_t rectY;
+    uint32_t rectW;
+    uint32_t rectH;
+} FrameCtx;
+
+static const uint32_t k_resolutions[][2] = {
+    { 1280, 720 },
+    { 1920, 1080 },
+    { 2560, 1440 },
+    { 3840, 2160 },
+};
+
+static void run_paint_full(void* p, uint64_t n) {
+    FrameCtx* c = (FrameCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_paint_frame_window(c->win, c->src, c->width, c->height);
+    }
+    darling_poll_events();
+}
+
+static void run_paint_region(void* p, uint64_t n) {
+    FrameCtx* c = (FrameCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_paint_frame_window_region(c->win, c->src, c->rectX, c->rectY, c->rectW, c->rectH);
+    }
+    darling_poll_events();
+}
+
+static void run_rgba_to_bgra(void* p, uint64_t n) {
+    FrameCtx* c = (FrameCtx*)p;
+    size_t pixels = (size_t)c->width * (size_t)c->height;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_rgba_to_bgra(c->dst, c->src, pixels);
+    }
+}
+
+static void run_paint_rgba(void* p, uint64_t n) {
+    FrameCtx* c = (FrameCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_paint_frame_window_format(c->win, c->src, c->width, c->height, DARLING_PIXEL_FORMAT_RGBA8);
+    }
+    darling_poll_events();
+}
+
+void darling_bench_suite_frame(void) {
+    for (size_t r = 0; r < sizeof(k_resolutions) / sizeof(k_resolutions[0]); r++) {
+        FrameCtx c = {0};
+        c.width = k_resolutions[r][0];
+        c.height = k_resolutions[r][1];
+
+        size_t bytes = (size_t)c.width * (size_t)c.height * 4u;
+        c.src = (uint8_t*)malloc(bytes);
+        c.dst = (uint8_t*)malloc(bytes);
+        c.win = darling_create_window(c.width, c.height, 0);
+        if (!c.src || !c.dst || !c.win) {
+            fprintf(stderr, "frame suite: allocation failed\n");
+            free(c.src);
+            free(c.dst);
+            darling_destroy_window(c.win);
+            return;
+        }
+
+        darling_bench_fill(c.src, bytes, 0xF00Du + (uint32_t)r);
+
+        // Prime the backing store so cases measure copies, not allocation
+        darling_paint_frame_window(c.win, c.src, c.width, c.height);
+
+        char params[128];
+        snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u}", c.width, c.height);
+
+        DarlingBenchCase full = { "frame_copy_full", params, run_paint_full, &c, (double)bytes, 0 };
+        darling_bench_run(&full);
+
+        // Partial updates: a 256x256 tile and a centered quarter-area rectangle
+        const uint32_t rects[2][2] = {
+            { 256, 256 },
+            { c.width / 2u, c.height / 2u },
+        };
+
+        for (int k = 0; k < 2; k++) {
+            c.rectW = rects[k][0];
+            c.rectH = rects[k][1];
+            c.rectX = (c.width - c.rectW) / 2u;
+            c.rectY = (c.height - c.rectH) / 2u;
+
+            char rparams[160];
+            snprintf(rparams, sizeof(rparams),
+                "{\"width\":%u,\"height\":%u,\"rect_w\":%u,\"rect_h\":%u}",
+                c.width, c.height, c.rectW, c.rectH);
+
+            DarlingBenchCase part = {
+                "frame_copy_partial", rparams, run_paint_region, &c,
+                (double)c.rectW * (double)c.rectH * 4.0, 0
+            };
+            darling_bench_run(&part);
+        }
+
+        DarlingBenchCase conv = { "pixel_rgba_to_bgra", params, run_rgba_to_bgra, &c, (double)bytes, 0 };
+        darling_bench_run(&conv);
+
+        DarlingBenchCase paintRgba = { "frame_paint_rgba", params, run_paint_rgba, &c, (double)bytes, 0 };
+        darling_bench_run(&paintRgba);
+
+        darling_destroy_window(c.win);
+        free(c.src);
+        free(c.dst);
+    }
+}
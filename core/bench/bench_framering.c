@@ -0,0 +1,224 @@
+#include "bench.h"
+#include "darling.h"
+#include "darling_producer.h"
+#include "platform/headless/impl/internal.h"
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Shared-memory frame ring: a forked producer process drawing 1080p frames
+// through the producer SDK while this process presents them, against the
+// same frames streamed over a pipe (the copy-through-IPC path), then a
+// check that no presented frame was torn.
+
+#define RING_W 1920u
+#define RING_H 1080u
+#define RING_CHECK_FRAMES 300u
+
+typedef struct RingCtx {
+    DarlingWindow* win;
+    uint8_t* frame;
+    int pipeFd;
+} RingCtx;
+
+// Every pixel of a frame holds its counter, so a mix of two frames shows
+static void fill_frame(uint8_t* px, uint32_t value) {
+    uint32_t* p = (uint32_t*)px;
+    for (size_t i = 0; i < (size_t)RING_W * RING_H; i++) {
+        p[i] = value;
+    }
+}
+
+static void run_producer(const char* name) {
+    DarlingProducer* producer = NULL;
+    uint32_t counter = 0;
+
+    while (!(producer = darling_producer_open(name))) {
+        usleep(1000);
+    }
+
+    for (;;) {
+        uint8_t* px = darling_producer_begin(producer, RING_W, RING_H);
+        if (!px) {
+            break;
+        }
+        fill_frame(px, ++counter | 0xFF000000u);
+        darling_producer_commit(producer, DARLING_FRAME_RING_BGRA8, 0.0);
+    }
+
+    darling_producer_close(producer);
+}
+
+static void run_pipe_producer(int fd) {
+    size_t bytes = (size_t)RING_W * RING_H * 4u;
+    uint8_t* frame = (uint8_t*)malloc(bytes);
+    uint32_t counter = 0;
+
+    signal(SIGPIPE, SIG_IGN);
+    while (frame) {
+        fill_frame(frame, ++counter | 0xFF000000u);
+        for (size_t off = 0; off < bytes;) {
+            ssize_t n = write(fd, frame + off, bytes - off);
+            if (n <= 0) {
+                free(frame);
+                return;
+            }
+            off += (size_t)n;
+        }
+    }
+}
+
+static void run_ring(void* p, uint64_t n) {
+    RingCtx* c = (RingCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        while (!darling_frame_ring_present(c->win)) {
+            sched_yield();
+        }
+        darling_poll_events();
+    }
+}
+
+static void run_pipe(void* p, uint64_t n) {
+    RingCtx* c = (RingCtx*)p;
+    size_t bytes = (size_t)RING_W * RING_H * 4u;
+
+    for (uint64_t i = 0; i < n; i++) {
+        for (size_t off = 0; off < bytes;) {
+            ssize_t got = read(c->pipeFd, c->frame + off, bytes - off);
+            if (got <= 0) {
+                return;
+            }
+            off += (size_t)got;
+        }
+        darling_paint_frame_window(c->win, c->frame, RING_W, RING_H);
+        darling_poll_events();
+    }
+}
+
+static void check_frames(RingCtx* c) {
+    const uint32_t* px = (const uint32_t*)c->win->dibBits;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    uint32_t last = 0;
+
+    for (uint32_t f = 0; f < RING_CHECK_FRAMES; f++) {
+        while (!darling_frame_ring_present(c->win)) {
+            sched_yield();
+        }
+        darling_poll_events();
+
+        px = (const uint32_t*)c->win->dibBits;
+        uint32_t value = px[0];
+        for (size_t i = 1; i < (size_t)RING_W * RING_H; i++) {
+            if (px[i] != value) {
+                torn++;
+                break;
+            }
+        }
+        backwards += value <= last;
+        last = value;
+    }
+
+    DarlingFrameRingStats stats;
+    darling_get_frame_ring_stats(c->win, &stats);
+    fprintf(stderr, "  check: %u torn, %u out of order in %u frames; published %u, presented %llu, skipped %llu, producer dropped %u\n",
+        torn, backwards, RING_CHECK_FRAMES, stats.published, (unsigned long long)stats.presented,
+        (unsigned long long)stats.skipped, stats.dropped);
+    darling_bench_expect("framering", "frames whole and in order", torn == 0 && backwards == 0);
+}
+
+static void bench_ring(RingCtx* c) {
+    char name[64];
+    char params[128];
+    snprintf(name, sizeof(name), "darling-bench-%d", (int)getpid());
+
+    // A producer forked for a filtered-out case would wait for a ring that
+    // is already gone
+    if (!darling_bench_enabled("framering_present")) {
+        return;
+    }
+
+    if (!darling_frame_ring_create(c->win, name, RING_W, RING_H, 3)) {
+        fprintf(stderr, "framering suite: cannot create ring %s\n", name);
+        return;
+    }
+
+    pid_t child = fork();
+    if (child == 0) {
+        run_producer(name);
+        _exit(0);
+    }
+    if (child < 0) {
+        darling_frame_ring_close(c->win);
+        return;
+    }
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"slots\":3,\"transport\":\"ring\"}", RING_W, RING_H);
+    DarlingBenchCase ring = { "framering_present", params, run_ring, c, (double)RING_W * RING_H * 4.0, 1 };
+    darling_bench_run(&ring);
+
+    if (darling_bench_enabled(ring.name)) {
+        check_frames(c);
+    }
+
+    // The producer sees the ring closed and exits
+    darling_frame_ring_close(c->win);
+    waitpid(child, NULL, 0);
+}
+
+static void bench_pipe(RingCtx* c) {
+    char params[128];
+    int fds[2];
+
+    if (!darling_bench_enabled("framering_present") || pipe(fds) != 0) {
+        return;
+    }
+
+    pid_t child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        run_pipe_producer(fds[1]);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    if (child < 0) {
+        close(fds[0]);
+        return;
+    }
+
+    c->pipeFd = fds[0];
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"transport\":\"pipe\"}", RING_W, RING_H);
+    DarlingBenchCase piped = { "framering_present", params, run_pipe, c, (double)RING_W * RING_H * 4.0, 1 };
+    darling_bench_run(&piped);
+
+    close(fds[0]);
+    waitpid(child, NULL, 0);
+}
+
+void darling_bench_suite_framering(void) {
+    RingCtx c = { 0 };
+
+    c.frame = (uint8_t*)malloc((size_t)RING_W * RING_H * 4u);
+    c.win = darling_create_window(RING_W, RING_H, 0);
+    if (!c.frame || !c.win) {
+        fprintf(stderr, "framering suite: allocation failed\n");
+        free(c.frame);
+        if (c.win) {
+            darling_destroy_window(c.win);
+        }
+        return;
+    }
+
+    bench_ring(&c);
+    bench_pipe(&c);
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.frame);
+}
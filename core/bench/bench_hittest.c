@@ -0,0 +1,186 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Hit-test index: point queries against a custom titlebar with hundreds of
+// regions (caption, buttons, resize edges, a long tab strip and toolbar
+// items), compared with a linear scan, plus the incremental resize path.
+
+#define HIT_W 1600
+#define HIT_H 900
+#define HIT_POINTS 4096u
+
+typedef struct HitCtx {
+    DarlingHitIndex index;
+    int32_t xs[HIT_POINTS];
+    int32_t ys[HIT_POINTS];
+    volatile int32_t sink;
+} HitCtx;
+
+// Reference: newest region first, exactly what the grid must reproduce
+static int32_t linear_query(const DarlingHitIndex* index, int32_t x, int32_t y) {
+    if (x < 0 || y < 0 || x >= index->width || y >= index->height) {
+        return DARLING_HIT_NONE;
+    }
+
+    int32_t best = DARLING_HIT_NONE;
+    uint32_t bestSeq = 0;
+
+    for (uint32_t i = 0; i < index->count; i++) {
+        const DarlingHitRegion* r = &index->regions[i];
+        if (r->used && x >= r->x0 && x < r->x1 && y >= r->y0 && y < r->y1 &&
+            (best == DARLING_HIT_NONE || r->seq > bestSeq)) {
+            best = (int32_t)r->kind;
+            bestSeq = r->seq;
+        }
+    }
+
+    return best;
+}
+
+// Titlebar 40px high: caption, tabs (passthrough) and toolbar buttons, with
+// the window buttons and the 8 resize edges anchored to the far sides
+static void build_titlebar(DarlingHitIndex* index, uint32_t tabs) {
+    const uint32_t FAR_X = DARLING_HIT_FAR_LEFT | DARLING_HIT_FAR_RIGHT;
+    const uint32_t FAR_Y = DARLING_HIT_FAR_TOP | DARLING_HIT_FAR_BOTTOM;
+
+    darling_hit_index_resize(index, HIT_W, HIT_H);
+    darling_hit_index_add(index, DARLING_HIT_CAPTION, 0, 0, 0, 40, DARLING_HIT_FAR_RIGHT);
+
+    // Tabs shrink to fit, like a browser tab strip
+    int32_t strip = HIT_W - 400;
+    for (uint32_t i = 0; i < tabs; i++) {
+        int32_t x0 = 80 + (int32_t)((int64_t)strip * i / tabs);
+        int32_t x1 = 80 + (int32_t)((int64_t)strip * (i + 1) / tabs) - 1;
+        darling_hit_index_add(index, DARLING_HIT_CLIENT, x0, 6, x1, 40, 0);
+    }
+
+    for (int32_t i = 0; i < 4; i++) {
+        darling_hit_index_add(index, DARLING_HIT_CLIENT, 8 + i * 18, 8, 24 + i * 18, 32, 0);
+    }
+
+    darling_hit_index_add(index, DARLING_HIT_MINIMIZE, 138, 0, 92, 40, FAR_X);
+    darling_hit_index_add(index, DARLING_HIT_MAXIMIZE, 92, 0, 46, 40, FAR_X);
+    darling_hit_index_add(index, DARLING_HIT_CLOSE, 46, 0, 0, 40, FAR_X);
+
+    darling_hit_index_add(index, DARLING_HIT_LEFT, 0, 0, 4, 0, DARLING_HIT_FAR_BOTTOM);
+    darling_hit_index_add(index, DARLING_HIT_RIGHT, 4, 0, 0, 0, FAR_X | DARLING_HIT_FAR_BOTTOM);
+    darling_hit_index_add(index, DARLING_HIT_TOP, 0, 0, 0, 4, DARLING_HIT_FAR_RIGHT);
+    darling_hit_index_add(index, DARLING_HIT_BOTTOM, 0, 4, 0, 0, FAR_Y | DARLING_HIT_FAR_RIGHT);
+    darling_hit_index_add(index, DARLING_HIT_TOP_LEFT, 0, 0, 8, 8, 0);
+    darling_hit_index_add(index, DARLING_HIT_TOP_RIGHT, 8, 0, 0, 8, FAR_X);
+    darling_hit_index_add(index, DARLING_HIT_BOTTOM_LEFT, 0, 8, 8, 0, FAR_Y);
+    darling_hit_index_add(index, DARLING_HIT_BOTTOM_RIGHT, 8, 8, 0, 0, FAR_X | FAR_Y);
+}
+
+// Mouse moves: mostly over the titlebar, the rest anywhere in the window
+static void fill_points(HitCtx* c) {
+    uint32_t seed = 0x9e3779b9u;
+
+    for (uint32_t i = 0; i < HIT_POINTS; i++) {
+        c->xs[i] = (int32_t)(darling_bench_rand(&seed) % HIT_W);
+        c->ys[i] = (i & 3u) ? (int32_t)(darling_bench_rand(&seed) % 48u)
+                            : (int32_t)(darling_bench_rand(&seed) % HIT_H);
+    }
+}
+
+static void run_query(void* p, uint64_t n) {
+    HitCtx* c = (HitCtx*)p;
+    int32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i++) {
+        uint32_t k = (uint32_t)i & (HIT_POINTS - 1u);
+        acc += darling_hit_index_query(&c->index, c->xs[k], c->ys[k]);
+    }
+
+    c->sink = acc;
+}
+
+static void run_linear(void* p, uint64_t n) {
+    HitCtx* c = (HitCtx*)p;
+    int32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i++) {
+        uint32_t k = (uint32_t)i & (HIT_POINTS - 1u);
+        acc += linear_query(&c->index, c->xs[k], c->ys[k]);
+    }
+
+    c->sink = acc;
+}
+
+static void run_resize(void* p, uint64_t n) {
+    HitCtx* c = (HitCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        // Drag the right edge back and forth by up to 256px
+        int32_t w = HIT_W - 256 + (int32_t)(i & 255u);
+        darling_hit_index_resize(&c->index, w, HIT_H);
+    }
+}
+
+static uint32_t count_mismatches(HitCtx* c) {
+    uint32_t mismatches = 0;
+
+    for (uint32_t i = 0; i < HIT_POINTS; i++) {
+        if (darling_hit_index_query(&c->index, c->xs[i], c->ys[i]) != linear_query(&c->index, c->xs[i], c->ys[i])) {
+            mismatches++;
+        }
+    }
+
+    return mismatches;
+}
+
+void darling_bench_suite_hittest(void) {
+    static const uint32_t k_tabs[] = { 16, 200, 500 };
+
+    HitCtx* c = (HitCtx*)calloc(1, sizeof(HitCtx));
+    if (!c) {
+        fprintf(stderr, "hittest suite: allocation failed\n");
+        return;
+    }
+
+    fill_points(c);
+
+    for (size_t t = 0; t < sizeof(k_tabs) / sizeof(k_tabs[0]); t++) {
+        build_titlebar(&c->index, k_tabs[t]);
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"regions\":%u}", c->index.live);
+
+        DarlingBenchCase query = { "hittest_query", params, run_query, c, 0, 1 };
+        darling_bench_run(&query);
+
+        if (darling_bench_enabled(query.name)) {
+            uint32_t mismatches = count_mismatches(c);
+            fprintf(stderr, "  mismatches vs linear scan: %u of %u points\n", mismatches, HIT_POINTS);
+            darling_bench_expect("hittest", "index vs linear scan", mismatches == 0);
+        }
+
+        DarlingBenchCase linear = { "hittest_query_linear", params, run_linear, c, 0, 1 };
+        darling_bench_run(&linear);
+
+        uint64_t rebuilds = c->index.rebuilds;
+        uint64_t rebins = c->index.rebins;
+
+        DarlingBenchCase resize = { "hittest_resize", params, run_resize, c, 0, 1 };
+        darling_bench_run(&resize);
+
+        if (darling_bench_enabled(resize.name)) {
+            darling_hit_index_resize(&c->index, HIT_W - 37, HIT_H);
+            uint32_t mismatches = count_mismatches(c);
+            fprintf(stderr, "  grid rebuilds %llu, regions re-binned %llu; after resize: %u mismatches\n",
+                (unsigned long long)(c->index.rebuilds - rebuilds),
+                (unsigned long long)(c->index.rebins - rebins),
+                mismatches);
+            darling_bench_expect("hittest", "index after resize", mismatches == 0);
+        }
+
+        darling_hit_index_free(&c->index);
+        c->index.width = 0;
+        c->index.height = 0;
+    }
+
+    free(c);
+}
@@ -0,0 +1,190 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Input ring: raw push/pop cost, the window-procedure capture path (post,
+// dispatch, timestamp, push) drained once per simulated frame, and a
+// producer/consumer thread pair checking the SPSC semantics: order kept,
+// no torn events, and every event either received or counted as dropped.
+
+#define INPUT_CAPACITY 1024u
+#define INPUT_BATCH 64u             // events per simulated frame
+#define INPUT_SPSC_EVENTS 2000000u
+
+typedef struct InputCtx {
+    void* memory;
+    DarlingInputRing* ring;
+    DarlingWindow* win;
+    DarlingInputEvent out[INPUT_CAPACITY];
+    volatile uint32_t sink;
+} InputCtx;
+
+static void run_push_pop(void* p, uint64_t n) {
+    InputCtx* c = (InputCtx*)p;
+    DarlingInputEvent ev = { 0.0, DARLING_INPUT_MOUSE_MOVE, 0, 0, 0, 0, 0 };
+    uint32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i += INPUT_BATCH) {
+        for (uint32_t k = 0; k < INPUT_BATCH; k++) {
+            ev.x = (int32_t)k;
+            darling_input_ring_push(c->ring, &ev);
+        }
+        acc += darling_input_ring_pop(c->ring, c->out, INPUT_BATCH);
+    }
+
+    c->sink = acc;
+}
+
+static void run_capture(void* p, uint64_t n) {
+    InputCtx* c = (InputCtx*)p;
+    uint32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i += INPUT_BATCH) {
+        for (uint32_t k = 0; k < INPUT_BATCH; k++) {
+            darling_post_message(c->win->hwnd, DARLING_MSG_MOUSEMOVE, 0, DARLING_INPUT_POINT(k, k));
+        }
+        darling_poll_events();
+        acc += darling_input_read(c->win, c->out, INPUT_CAPACITY);
+    }
+
+    c->sink = acc;
+}
+
+// SPSC check: the payload of event i is derived from i so the consumer can
+// detect reordering and torn copies. The producer writes in bursts paced
+// like real input, wrapping the ring many times, then ends with a burst
+// twice the capacity so drops are exercised too.
+
+typedef struct SpscState {
+    DarlingInputRing* ring;
+    uint32_t events;
+    volatile uint32_t done;
+} SpscState;
+
+static void* spsc_producer(void* p) {
+    SpscState* s = (SpscState*)p;
+    DarlingInputEvent ev;
+
+    uint32_t overflowFrom = s->events - 2u * INPUT_CAPACITY;
+
+    for (uint32_t i = 0; i < s->events; i++) {
+        if (i < overflowFrom && (i % (INPUT_CAPACITY / 4u)) == 0) {
+            while (s->ring->writeIndex - darling_input_load_acquire(&s->ring->readIndex) > INPUT_CAPACITY / 2u) {
+            }
+        }
+
+        ev.time = (double)i;
+        ev.type = DARLING_INPUT_MOUSE_MOVE;
+        ev.modifiers = i ^ 0xA5A5A5A5u;
+        ev.x = (int32_t)i;
+        ev.y = (int32_t)~i;
+        ev.code = (int32_t)(i * 3u);
+        ev.value = (int32_t)(i * 7u);
+        darling_input_ring_push(s->ring, &ev);
+    }
+
+    __atomic_store_n(&s->done, 1u, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void spsc_check(InputCtx* c) {
+    SpscState s = { c->ring, INPUT_SPSC_EVENTS, 0 };
+    uint64_t received = 0;
+    uint64_t torn = 0;
+    uint64_t reordered = 0;
+    int64_t last = -1;
+
+    darling_input_ring_init(c->memory, darling_input_ring_bytes(INPUT_CAPACITY));
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, spsc_producer, &s);
+
+    for (;;) {
+        int finished = __atomic_load_n(&s.done, __ATOMIC_ACQUIRE) != 0;
+        uint32_t n = darling_input_ring_pop(c->ring, c->out, INPUT_CAPACITY);
+
+        for (uint32_t k = 0; k < n; k++) {
+            const DarlingInputEvent* ev = &c->out[k];
+            uint32_t i = (uint32_t)ev->x;
+
+            if (ev->time != (double)i || ev->modifiers != (i ^ 0xA5A5A5A5u) || ev->y != (int32_t)~i ||
+                ev->code != (int32_t)(i * 3u) || ev->value != (int32_t)(i * 7u)) {
+                torn++;
+            }
+            if ((int64_t)i <= last) {
+                reordered++;
+            }
+            last = (int64_t)i;
+        }
+
+        received += n;
+
+        // The last pop after `done` drains everything the producer wrote
+        if (finished && n == 0) {
+            break;
+        }
+    }
+
+    pthread_join(producer, NULL);
+
+    uint32_t dropped = darling_input_load_acquire(&c->ring->dropped);
+    fprintf(stderr, "  spsc: sent %u, received %llu, dropped %u (%s), torn %llu, reordered %llu\n",
+        s.events, (unsigned long long)received, dropped,
+        received + dropped == s.events ? "accounted" : "LOST",
+        (unsigned long long)torn, (unsigned long long)reordered);
+    darling_bench_expect("spsc", "every event accounted for", received + dropped == s.events);
+    darling_bench_expect("spsc", "events whole and in order", torn == 0 && reordered == 0);
+}
+
+void darling_bench_suite_input(void) {
+    InputCtx* c = (InputCtx*)calloc(1, sizeof(InputCtx));
+    size_t bytes = darling_input_ring_bytes(INPUT_CAPACITY);
+
+    if (c) {
+        c->memory = calloc(1, bytes);
+    }
+
+    if (!c || !c->memory) {
+        fprintf(stderr, "input suite: allocation failed\n");
+        free(c);
+        return;
+    }
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"capacity\":%u,\"batch\":%u}", INPUT_CAPACITY, INPUT_BATCH);
+
+    c->ring = (DarlingInputRing*)c->memory;
+    darling_input_ring_init(c->memory, bytes);
+
+    DarlingBenchCase pushPop = { "input_ring_push_pop", params, run_push_pop, c, 0, 1 };
+    darling_bench_run(&pushPop);
+
+    c->win = darling_create_window(640, 480, 0);
+    if (c->win) {
+        darling_input_attach(c->win, c->memory, bytes);
+
+        DarlingBenchCase capture = { "input_capture", params, run_capture, c, 0, 1 };
+        darling_bench_run(&capture);
+
+        if (darling_bench_enabled(capture.name)) {
+            DarlingInputStats stats;
+            darling_input_get_stats(c->win, &stats);
+            fprintf(stderr, "  capture: written %u, pending %u, dropped %u\n",
+                stats.written, stats.pending, stats.dropped);
+        }
+
+        darling_input_detach(c->win);
+        darling_destroy_window(c->win);
+        darling_poll_events();
+    }
+
+    if (darling_bench_enabled("input_spsc")) {
+        spsc_check(c);
+    }
+
+    free(c->memory);
+    free(c);
+}
@@ -0,0 +1,327 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Per-pixel-alpha presents: the premultiply and unpremultiply kernels on a
+// 1080p frame shaped like a translucent window (opaque body, soft shadow
+// edge) against straightforward per-channel references, then a 720p
+// layered window presenting a small region paint versus a full frame. A
+// final check compares both kernels with the references over every
+// (colour, alpha) pair, round-trips premultiplied pixels, converts a
+// window's store through both mode switches and follows the dirty
+// rectangle through a few presents.
+
+#define LY_W 1920u
+#define LY_H 1080u
+#define LY_EDGE 32u
+#define LY_WIN_W 1280u
+#define LY_WIN_H 720u
+#define LY_REGION_W 256u
+#define LY_REGION_H 64u
+
+typedef struct LayeredCtx {
+    uint8_t* src;
+    uint8_t* dst;
+    size_t pixels;
+} LayeredCtx;
+
+typedef struct PresentCtx {
+    DarlingWindow* win;
+    uint8_t* frame;
+    uint32_t tick;
+} PresentCtx;
+
+static uint32_t ref_div255(uint32_t x) {
+    return (x * 2u + 255u) / 510u;
+}
+
+static uint32_t ref_premultiply(uint32_t px) {
+    uint32_t a = px >> 24;
+    uint32_t out = a << 24;
+    for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+        out |= ref_div255(((px >> shift) & 0xFFu) * a) << shift;
+    }
+    return out;
+}
+
+static uint32_t ref_unpremultiply(uint32_t px) {
+    uint32_t a = px >> 24;
+    uint32_t out = a << 24;
+    for (uint32_t shift = 0; a && shift < 24u; shift += 8u) {
+        uint32_t c = (px >> shift) & 0xFFu;
+        c = c > a ? a : c;
+        out |= ((c * 255u + a / 2u) / a) << shift;
+    }
+    return out;
+}
+
+// Random colours; alpha ramps up over the outer LY_EDGE pixels
+static void fill_window(uint32_t* px, uint32_t w, uint32_t h, uint32_t seed) {
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t dx = x < w - 1u - x ? x : w - 1u - x;
+            uint32_t dy = y < h - 1u - y ? y : h - 1u - y;
+            uint32_t d = dx < dy ? dx : dy;
+            uint32_t a = d >= LY_EDGE ? 255u : d * 255u / LY_EDGE;
+            px[(size_t)y * w + x] = (darling_bench_rand(&seed) & 0x00FFFFFFu) | (a << 24);
+        }
+    }
+}
+
+static void run_premultiply(void* p, uint64_t n) {
+    LayeredCtx* c = (LayeredCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_premultiply(c->dst, c->src, c->pixels);
+    }
+}
+
+static void run_premultiply_reference(void* p, uint64_t n) {
+    LayeredCtx* c = (LayeredCtx*)p;
+    const uint32_t* src = (const uint32_t*)c->src;
+    uint32_t* dst = (uint32_t*)c->dst;
+    for (uint64_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < c->pixels; j++) {
+            dst[j] = ref_premultiply(src[j]);
+        }
+    }
+}
+
+static void run_unpremultiply(void* p, uint64_t n) {
+    LayeredCtx* c = (LayeredCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_unpremultiply(c->src, c->dst, c->pixels);
+    }
+}
+
+static void run_unpremultiply_reference(void* p, uint64_t n) {
+    LayeredCtx* c = (LayeredCtx*)p;
+    const uint32_t* src = (const uint32_t*)c->dst;
+    uint32_t* dst = (uint32_t*)c->src;
+    for (uint64_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < c->pixels; j++) {
+            dst[j] = ref_unpremultiply(src[j]);
+        }
+    }
+}
+
+// A spinner-sized region moving across the window, presented each time
+static void run_present_region(void* p, uint64_t n) {
+    PresentCtx* c = (PresentCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        uint32_t x = (c->tick * 37u) % (LY_WIN_W - LY_REGION_W);
+        uint32_t y = (c->tick * 11u) % (LY_WIN_H - LY_REGION_H);
+        c->tick++;
+        darling_paint_frame_window_region(c->win, c->frame, x, y, LY_REGION_W, LY_REGION_H);
+        darling_poll_events();
+    }
+}
+
+static void run_present_full(void* p, uint64_t n) {
+    PresentCtx* c = (PresentCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_paint_frame_window(c->win, c->frame, LY_WIN_W, LY_WIN_H);
+        darling_poll_events();
+    }
+}
+
+static void report_present(const char* name, DarlingWindow* win, DarlingPresentStats* last) {
+    DarlingPresentStats st;
+    darling_get_present_stats(win, &st);
+    uint64_t presents = st.layeredPresents - last->layeredPresents;
+    uint64_t dirty = st.dirtyPixels - last->dirtyPixels;
+    uint64_t clean = st.cleanPixels - last->cleanPixels;
+    fprintf(stderr, "  %s: %llu presents, %.0f dirty / %.0f clean pixels each\n", name,
+        (unsigned long long)presents, (double)dirty / (double)(presents ? presents : 1),
+        (double)clean / (double)(presents ? presents : 1));
+    *last = st;
+}
+
+static BOOL ly_stats_moved(DarlingWindow* win, DarlingPresentStats* last, uint64_t presents, uint64_t dirty) {
+    DarlingPresentStats st;
+    darling_get_present_stats(win, &st);
+    BOOL ok = st.layeredPresents - last->layeredPresents == presents && st.dirtyPixels - last->dirtyPixels == dirty;
+    *last = st;
+    return ok;
+}
+
+static void check_layered(void) {
+    // Every (colour, alpha) pair, blue and red walking opposite ways; an
+    // odd length runs the scalar tail too
+    size_t count = 65536u + 3u;
+    uint32_t* in = (uint32_t*)malloc(count * 4u);
+    uint32_t* out = (uint32_t*)malloc(count * 4u);
+    uint32_t* back = (uint32_t*)malloc(count * 4u);
+    if (!in || !out || !back) {
+        free(in);
+        free(back);
+        free(out);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t c = (uint32_t)i & 0xFFu;
+        uint32_t a = ((uint32_t)i >> 8) & 0xFFu;
+        in[i] = c | ((c * 7u & 0xFFu) << 8) | ((255u - c) << 16) | (a << 24);
+    }
+
+    size_t mismatches = 0;
+    darling_frame_unpremultiply((uint8_t*)out, (const uint8_t*)in, count);
+    for (size_t i = 0; i < count; i++) {
+        mismatches += out[i] != ref_unpremultiply(in[i]);
+    }
+    darling_bench_expect("layered", "unpremultiply vs reference", mismatches == 0);
+
+    size_t premultiplyMismatches = 0;
+    darling_frame_premultiply((uint8_t*)out, (const uint8_t*)in, count);
+    for (size_t i = 0; i < count; i++) {
+        premultiplyMismatches += out[i] != ref_premultiply(in[i]);
+    }
+    darling_bench_expect("layered", "premultiply vs reference", premultiplyMismatches == 0);
+
+    // Premultiplied pixels come back unchanged from straight alpha, so
+    // switching modes back and forth does not drift
+    size_t drift = 0;
+    darling_frame_unpremultiply((uint8_t*)back, (const uint8_t*)out, count);
+    darling_frame_premultiply((uint8_t*)back, (const uint8_t*)back, count);
+    for (size_t i = 0; i < count; i++) {
+        drift += back[i] != out[i];
+    }
+    darling_bench_expect("layered", "round trip", drift == 0);
+
+    // Switching a painted window's mode converts its store both ways
+    DarlingWindow* win = darling_create_window(64, 32, 0);
+    uint32_t* frame = (uint32_t*)malloc(64u * 32u * 4u);
+    if (win && frame) {
+        fill_window(frame, 64, 32, 3u);
+        darling_paint_frame_window(win, (const uint8_t*)frame, 64, 32);
+        darling_poll_events();
+
+        BOOL premultiplied = darling_set_present_mode(win, DARLING_PRESENT_PER_PIXEL_ALPHA) == 1;
+        const uint32_t* store = (const uint32_t*)win->dibBits;
+        for (size_t i = 0; premultiplied && i < 64u * 32u; i++) {
+            premultiplied = store[i] == ref_premultiply(frame[i]);
+        }
+        darling_bench_expect("layered", "switch premultiplies", premultiplied);
+
+        DarlingPresentStats last;
+        darling_get_present_stats(win, &last);
+        darling_poll_events();
+        darling_bench_expect("layered", "switch presents all", ly_stats_moved(win, &last, 1, 64u * 32u));
+
+        // Two region paints before a present: one dirty rectangle around both
+        darling_paint_frame_window_region(win, (const uint8_t*)frame, 4, 2, 8, 4);
+        darling_paint_frame_window_region(win, (const uint8_t*)frame, 20, 10, 4, 4);
+        darling_poll_events();
+        darling_bench_expect("layered", "dirty rectangle", ly_stats_moved(win, &last, 1, 20u * 12u));
+        darling_poll_events();
+        darling_bench_expect("layered", "nothing to present", ly_stats_moved(win, &last, 0, 0));
+
+        // Premultiplied frames go in as they are
+        uint64_t converted = last.convertedPixels;
+        darling_paint_frame_window_format(win, (const uint8_t*)store, 64, 32, DARLING_PIXEL_FORMAT_BGRA8_PREMULTIPLIED);
+        darling_poll_events();
+        darling_bench_expect("layered", "premultiplied format", ly_stats_moved(win, &last, 1, 64u * 32u) && last.convertedPixels == converted);
+
+        memcpy(frame, store, 64u * 32u * 4u);
+        BOOL straight = darling_set_present_mode(win, DARLING_PRESENT_OPAQUE) == 1;
+        for (size_t i = 0; straight && i < 64u * 32u; i++) {
+            straight = store[i] == ref_unpremultiply(frame[i]);
+        }
+        darling_poll_events();
+        darling_bench_expect("layered", "switch unpremultiplies", straight && ly_stats_moved(win, &last, 0, 0) && last.mode == DARLING_PRESENT_OPAQUE);
+        darling_bench_expect("layered", "invalid mode", darling_set_present_mode(win, (DarlingPresentMode)7) == 0);
+    }
+
+    fprintf(stderr, "  check layered: %zu unpremultiply and %zu premultiply mismatches, %zu round-trip changes\n",
+        mismatches, premultiplyMismatches, drift);
+
+    if (win) {
+        darling_destroy_window(win);
+    }
+    darling_poll_events();
+    free(frame);
+    free(in);
+    free(out);
+    free(back);
+}
+
+void darling_bench_suite_layered(void) {
+    LayeredCtx c;
+    char params[96];
+    c.pixels = (size_t)LY_W * LY_H;
+    c.src = (uint8_t*)malloc(c.pixels * 4u);
+    c.dst = (uint8_t*)malloc(c.pixels * 4u);
+
+    PresentCtx pc;
+    memset(&pc, 0, sizeof(pc));
+    pc.frame = (uint8_t*)malloc((size_t)LY_WIN_W * LY_WIN_H * 4u);
+    pc.win = darling_create_window(LY_WIN_W, LY_WIN_H, 0);
+
+    if (!c.src || !c.dst || !pc.frame || !pc.win) {
+        fprintf(stderr, "layered suite: allocation failed\n");
+        free(c.src);
+        free(c.dst);
+        free(pc.frame);
+        if (pc.win) {
+            darling_destroy_window(pc.win);
+        }
+        return;
+    }
+
+    fill_window((uint32_t*)c.src, LY_W, LY_H, 7u);
+    darling_frame_premultiply(c.dst, c.src, c.pixels);
+
+    double bytes = (double)c.pixels * 4.0;
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"edge\":%u}", LY_W, LY_H, LY_EDGE);
+    DarlingBenchCase premultiply = { "layered_premultiply", params, run_premultiply, &c, bytes, 0 };
+    darling_bench_run(&premultiply);
+    DarlingBenchCase premultiplyRef = { "layered_premultiply_reference", params, run_premultiply_reference, &c, bytes, 0 };
+    darling_bench_run(&premultiplyRef);
+    DarlingBenchCase unpremultiply = { "layered_unpremultiply", params, run_unpremultiply, &c, bytes, 0 };
+    darling_bench_run(&unpremultiply);
+    DarlingBenchCase unpremultiplyRef = { "layered_unpremultiply_reference", params, run_unpremultiply_reference, &c, bytes, 0 };
+    darling_bench_run(&unpremultiplyRef);
+
+    fill_window((uint32_t*)pc.frame, LY_WIN_W, LY_WIN_H, 9u);
+    darling_paint_frame_window(pc.win, pc.frame, LY_WIN_W, LY_WIN_H);
+    darling_set_present_mode(pc.win, DARLING_PRESENT_PER_PIXEL_ALPHA);
+    darling_poll_events();
+
+    DarlingPresentStats last;
+    darling_get_present_stats(pc.win, &last);
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"region\":\"%ux%u\"}",
+        LY_WIN_W, LY_WIN_H, LY_REGION_W, LY_REGION_H);
+    DarlingBenchCase region = {
+        "layered_present_region", params, run_present_region, &pc, (double)LY_REGION_W * LY_REGION_H * 4.0, 0
+    };
+    darling_bench_run(&region);
+    if (darling_bench_enabled(region.name)) {
+        report_present(region.name, pc.win, &last);
+    }
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u}", LY_WIN_W, LY_WIN_H);
+    DarlingBenchCase full = {
+        "layered_present_full", params, run_present_full, &pc, (double)LY_WIN_W * LY_WIN_H * 4.0, 0
+    };
+    darling_bench_run(&full);
+    if (darling_bench_enabled(full.name)) {
+        report_present(full.name, pc.win, &last);
+    }
+
+    darling_destroy_window(pc.win);
+    darling_poll_events();
+
+    if (darling_bench_enabled(region.name)) {
+        uint32_t failures = darling_bench_failures();
+        check_layered();
+        fprintf(stderr, "  check layered: %u failures\n", darling_bench_failures() - failures);
+    }
+
+    free(c.src);
+    free(c.dst);
+    free(pc.frame);
+}
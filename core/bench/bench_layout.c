@@ -0,0 +1,140 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+
+// Child layout engine: rect computation for deep split trees, and the full
+// resize path (WM_SIZE -> compute -> one batch of child moves) on the
+// headless backend.
+
+// Build a complete binary tree of alternating splits `depth` levels deep
+static int32_t build_split_tree(DarlingLayoutTree* tree, int32_t parent, uint32_t depth, uint32_t level) {
+    if (level == depth) {
+        int32_t leaf = darling_layout_tree_add(tree, parent, DARLING_LAYOUT_NODE_LEAF, 0, 1.0f);
+        if (leaf != DARLING_LAYOUT_NONE) {
+            tree->nodes[leaf].child = (uintptr_t)(leaf + 1) * 0x10u;
+        }
+        return leaf;
+    }
+
+    uint32_t kind = (level & 1u) ? DARLING_LAYOUT_NODE_SPLIT_V : DARLING_LAYOUT_NODE_SPLIT_H;
+    float weight = 1.0f + (float)(level % 3u);
+    int32_t node = darling_layout_tree_add(tree, parent, kind, 0, weight);
+
+    // Every other level puts a fixed-size pane (toolbar/sidebar) first
+    if (level % 2u == 0u) {
+        darling_layout_tree_add(tree, node, DARLING_LAYOUT_NODE_LEAF, 24, 0.0f);
+    }
+
+    build_split_tree(tree, node, depth, level + 1);
+    build_split_tree(tree, node, depth, level + 1);
+    return node;
+}
+
+// Leaves must tile the client area exactly: no gaps, no overlap
+static int check_coverage(const DarlingLayoutTree* tree, int32_t w, int32_t h) {
+    int64_t area = 0;
+
+    for (uint32_t i = 0; i < tree->count; i++) {
+        const DarlingLayoutNode* n = &tree->nodes[i];
+        if (n->kind != DARLING_LAYOUT_NODE_LEAF) {
+            continue;
+        }
+        if (n->rect.w < 0 || n->rect.h < 0 || n->rect.x < 0 || n->rect.y < 0 ||
+            n->rect.x + n->rect.w > w || n->rect.y + n->rect.h > h) {
+            return 0;
+        }
+        area += (int64_t)n->rect.w * n->rect.h;
+    }
+
+    return area == (int64_t)w * h;
+}
+
+static void run_compute(void* p, uint64_t n) {
+    DarlingLayoutTree* tree = (DarlingLayoutTree*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        // Vary the size like an interactive resize drag
+        darling_layout_compute(tree, 1280 + (int32_t)(i & 255u), 720 + (int32_t)((i >> 1) & 127u));
+    }
+}
+
+typedef struct ResizeCtx {
+    DarlingWindow* host;
+    uint32_t step;
+} ResizeCtx;
+
+static void run_resize(void* p, uint64_t n) {
+    ResizeCtx* c = (ResizeCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->step++;
+        darling_post_message(c->host->hwnd, DARLING_MSG_SIZE, 1280 + (c->step & 63u), 720);
+        darling_poll_events();
+    }
+}
+
+// Editor-style host: sidebar | (tabs of 3 / terminal), plus a fixed toolbar
+static void build_editor_layout(DarlingWindow* host) {
+    int32_t root = darling_layout_add(host, -1, DARLING_LAYOUT_SPLIT_V, 0, 1.0f);
+    int32_t toolbar = darling_layout_add(host, root, DARLING_LAYOUT_LEAF, 32, 0.0f);
+    int32_t body = darling_layout_add(host, root, DARLING_LAYOUT_SPLIT_H, 0, 1.0f);
+    int32_t sidebar = darling_layout_add(host, body, DARLING_LAYOUT_LEAF, 240, 0.0f);
+    int32_t main = darling_layout_add(host, body, DARLING_LAYOUT_SPLIT_V, 0, 1.0f);
+    int32_t tabs = darling_layout_add(host, main, DARLING_LAYOUT_STACK, 0, 3.0f);
+    int32_t terminal = darling_layout_add(host, main, DARLING_LAYOUT_LEAF, 0, 1.0f);
+
+    uintptr_t hwnd = 0x1000;
+    darling_layout_set_child(host, toolbar, hwnd += 0x10);
+    darling_layout_set_child(host, sidebar, hwnd += 0x10);
+    darling_layout_set_child(host, terminal, hwnd += 0x10);
+    for (int i = 0; i < 3; i++) {
+        int32_t tab = darling_layout_add(host, tabs, DARLING_LAYOUT_LEAF, 0, 1.0f);
+        darling_layout_set_child(host, tab, hwnd += 0x10);
+    }
+}
+
+void darling_bench_suite_layout(void) {
+    static const uint32_t k_depths[] = { 2, 6, 10 };
+
+    for (size_t d = 0; d < sizeof(k_depths) / sizeof(k_depths[0]); d++) {
+        DarlingLayoutTree tree = { NULL, 0, 0 };
+        build_split_tree(&tree, DARLING_LAYOUT_NONE, k_depths[d], 0);
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"depth\":%u,\"nodes\":%u}", k_depths[d], tree.count);
+
+        DarlingBenchCase compute = { "layout_compute", params, run_compute, &tree, 0, tree.count };
+        darling_bench_run(&compute);
+
+        if (darling_bench_enabled(compute.name)) {
+            darling_layout_compute(&tree, 1283, 719);
+            int exact = check_coverage(&tree, 1283, 719);
+            fprintf(stderr, "  leaf coverage: %s\n", exact ? "exact" : "MISMATCH");
+            darling_bench_expect("layout", "leaf coverage", exact);
+        }
+
+        darling_layout_tree_free(&tree);
+    }
+
+    DarlingWindow* host = darling_create_window(1280, 720, 0);
+    if (!host) {
+        fprintf(stderr, "layout suite: window creation failed\n");
+        return;
+    }
+
+    build_editor_layout(host);
+    darling_layout_apply(host);
+
+    ResizeCtx c = { host, 0 };
+    uint64_t batches = host->layoutBatchCount;
+    uint64_t moves = host->layoutMoveCount;
+
+    DarlingBenchCase resize = { "layout_resize_apply", "{\"children\":6}", run_resize, &c, 0, 1 };
+    darling_bench_run(&resize);
+
+    if (darling_bench_enabled(resize.name) && host->layoutBatchCount > batches) {
+        fprintf(stderr, "  child moves per batch: %.2f\n",
+            (double)(host->layoutMoveCount - moves) / (double)(host->layoutBatchCount - batches));
+    }
+
+    darling_destroy_window(host);
+}
@@ -0,0 +1,85 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Window list (list.c): add/remove churn and HWND lookup at scale
+
+typedef struct ListCtx {
+    DarlingWindow* windows;
+    uint32_t count;
+    uint32_t rng;
+} ListCtx;
+
+static void run_add_remove(void* p, uint64_t n) {
+    ListCtx* c = (ListCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* w = &c->windows[darling_bench_rand(&c->rng) % c->count];
+        darling_list_remove(w);
+        darling_list_add(w);
+    }
+}
+
+static void run_lookup(void* p, uint64_t n) {
+    ListCtx* c = (ListCtx*)p;
+    uintptr_t hits = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* w = &c->windows[darling_bench_rand(&c->rng) % c->count];
+        hits += (uintptr_t)darling_list_find(w->hwnd);
+    }
+    // Keep the lookups observable
+    if (hits == 1) {
+        fputc(' ', stderr);
+    }
+}
+
+static void run_lookup_miss(void* p, uint64_t n) {
+    (void)p;
+    uintptr_t hits = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        // Handles never handed out by the list (foreign HWNDs in the queue)
+        hits += (uintptr_t)darling_list_find((HWND)(uintptr_t)(0x7F000001u + (i << 4)));
+    }
+    if (hits == 1) {
+        fputc(' ', stderr);
+    }
+}
+
+void darling_bench_suite_list(void) {
+    static const uint32_t k_counts[] = { 16, 256, 4096 };
+
+    for (size_t s = 0; s < sizeof(k_counts) / sizeof(k_counts[0]); s++) {
+        ListCtx c = {0};
+        c.count = k_counts[s];
+        c.rng = 0xC0FFEEu;
+        c.windows = (DarlingWindow*)calloc(c.count, sizeof(DarlingWindow));
+        if (!c.windows) {
+            fprintf(stderr, "list suite: allocation failed\n");
+            return;
+        }
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            c.windows[i].hwnd = (HWND)(uintptr_t)(0x10000000u + ((uintptr_t)i << 4));
+            c.windows[i].isChild = (i % 4u) == 3u;
+            darling_list_add(&c.windows[i]);
+        }
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"windows\":%u}", c.count);
+
+        DarlingBenchCase churn = { "list_add_remove", params, run_add_remove, &c, 0, 1 };
+        darling_bench_run(&churn);
+
+        DarlingBenchCase lookup = { "list_lookup_hit", params, run_lookup, &c, 0, 1 };
+        darling_bench_run(&lookup);
+
+        DarlingBenchCase miss = { "list_lookup_miss", params, run_lookup_miss, &c, 0, 1 };
+        darling_bench_run(&miss);
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            darling_list_remove(&c.windows[i]);
+        }
+        free(c.windows);
+    }
+}
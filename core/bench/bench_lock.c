@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <pthread.h>
+#include <stdio.h>
+
+// Global lock (darling_lock/darling_unlock) acquire/release under contention
+
+#define LOCK_MAX_THREADS 8u
+
+typedef struct LockCtx {
+    uint32_t threads;
+} LockCtx;
+
+typedef struct LockWorker {
+    uint64_t iterations;
+    volatile uint64_t* counter;
+} LockWorker;
+
+static volatile uint64_t g_shared_counter = 0;
+
+static void* lock_worker(void* p) {
+    LockWorker* w = (LockWorker*)p;
+    for (uint64_t i = 0; i < w->iterations; i++) {
+        darling_lock();
+        (*w->counter)++;
+        darling_unlock();
+    }
+    return NULL;
+}
+
+static void run_lock(void* p, uint64_t n) {
+    LockCtx* c = (LockCtx*)p;
+
+    if (c->threads == 1) {
+        LockWorker w = { n, &g_shared_counter };
+        lock_worker(&w);
+        return;
+    }
+
+    pthread_t tids[LOCK_MAX_THREADS];
+    LockWorker workers[LOCK_MAX_THREADS];
+    uint64_t per = n / c->threads + 1u;
+
+    for (uint32_t t = 0; t < c->threads; t++) {
+        workers[t].iterations = per;
+        workers[t].counter = &g_shared_counter;
+        pthread_create(&tids[t], NULL, lock_worker, &workers[t]);
+    }
+    for (uint32_t t = 0; t < c->threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+}
+
+void darling_bench_suite_lock(void) {
+    static const uint32_t k_threads[] = { 1, 2, 4, LOCK_MAX_THREADS };
+
+    for (size_t s = 0; s < sizeof(k_threads) / sizeof(k_threads[0]); s++) {
+        LockCtx c = { k_threads[s] };
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"threads\":%u}", c.threads);
+
+        DarlingBenchCase lock = { "lock_acquire_release", params, run_lock, &c, 0, 1 };
+        darling_bench_run(&lock);
+    }
+}
@@ -0,0 +1,191 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Backing-store memory: the RLE codec used to keep evicted stores, and the
+// hide -> evict -> show -> restore cycle under a global budget.
+
+#define MEMORY_WINDOWS 8u
+#define MEMORY_W 1280u
+#define MEMORY_H 720u
+
+// App-like content: flat panels, a few borders and a noisy "image" strip
+static void fill_ui_frame(uint32_t* px, uint32_t w, uint32_t h, uint32_t seed) {
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t c = x < w / 5u ? 0xFF252526u : 0xFF1E1E1Eu;
+            if (y < 32u) {
+                c = 0xFF3C3C3Cu;
+            } else if (x == w / 5u || y == 32u) {
+                c = 0xFF454545u;
+            }
+            px[(size_t)y * w + x] = c;
+        }
+    }
+
+    // Noise strip (1/8 of the height) defeats run-length coding locally
+    uint32_t top = h / 2u;
+    uint32_t state = seed | 1u;
+    for (uint32_t y = top; y < top + h / 8u; y++) {
+        for (uint32_t x = w / 5u + 1u; x < w; x++) {
+            state = state * 1664525u + 1013904223u;
+            px[(size_t)y * w + x] = 0xFF000000u | (state >> 8);
+        }
+    }
+}
+
+typedef struct CodecCtx {
+    uint32_t* frame;
+    uint32_t* packed;
+    uint32_t* decoded;
+    size_t pixels;
+    size_t capacity;
+    size_t words;
+} CodecCtx;
+
+static void run_encode(void* p, uint64_t n) {
+    CodecCtx* c = (CodecCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->words = darling_frame_rle_encode(c->frame, c->pixels, c->packed, c->capacity);
+    }
+}
+
+static void run_decode(void* p, uint64_t n) {
+    CodecCtx* c = (CodecCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_rle_decode(c->packed, c->words, c->decoded, c->pixels);
+    }
+}
+
+// Stands in for the app re-rendering a window whose store was released
+static const uint32_t* g_repaint_frame = NULL;
+
+static void on_frame_request(uintptr_t hwnd) {
+    DarlingWindow* win = darling_list_find((HWND)hwnd);
+    if (win && g_repaint_frame) {
+        darling_paint_frame_window(win, (const unsigned char*)g_repaint_frame, MEMORY_W, MEMORY_H);
+    }
+}
+
+typedef struct CycleCtx {
+    DarlingWindow* windows[MEMORY_WINDOWS];
+    uint32_t* frame;
+    uint32_t next;
+} CycleCtx;
+
+// Hide one window (evicting the LRU hidden store) and show the next
+// hidden one (restoring it), like switching between tabs
+static void run_cycle(void* p, uint64_t n) {
+    CycleCtx* c = (CycleCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* shown = c->windows[c->next % MEMORY_WINDOWS];
+        DarlingWindow* hidden = c->windows[(c->next + MEMORY_WINDOWS / 2u) % MEMORY_WINDOWS];
+        darling_hide_window(shown);
+        darling_show_window(hidden);
+        c->next++;
+    }
+    darling_poll_events();
+}
+
+static void bench_codec(void) {
+    CodecCtx c = {0};
+    c.pixels = (size_t)MEMORY_W * MEMORY_H;
+    c.capacity = c.pixels / 2u;
+    c.frame = (uint32_t*)malloc(c.pixels * 4u);
+    c.packed = (uint32_t*)malloc(c.capacity * 4u);
+    c.decoded = (uint32_t*)malloc(c.pixels * 4u);
+
+    if (!c.frame || !c.packed || !c.decoded) {
+        fprintf(stderr, "memory suite: allocation failed\n");
+        free(c.frame);
+        free(c.packed);
+        free(c.decoded);
+        return;
+    }
+
+    fill_ui_frame(c.frame, MEMORY_W, MEMORY_H, 7u);
+    c.words = darling_frame_rle_encode(c.frame, c.pixels, c.packed, c.capacity);
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u}", MEMORY_W, MEMORY_H);
+
+    DarlingBenchCase encode = { "frame_rle_encode", params, run_encode, &c, c.pixels * 4u, c.pixels };
+    darling_bench_run(&encode);
+
+    if (darling_bench_enabled(encode.name)) {
+        fprintf(stderr, "  compressed to %.1f%% of raw\n", 100.0 * (double)(c.words * 4u) / (double)(c.pixels * 4u));
+    }
+
+    DarlingBenchCase decode = { "frame_rle_decode", params, run_decode, &c, c.pixels * 4u, c.pixels };
+    darling_bench_run(&decode);
+
+    if (darling_bench_enabled(decode.name)) {
+        int ok = c.words && darling_frame_rle_decode(c.packed, c.words, c.decoded, c.pixels) &&
+                 memcmp(c.frame, c.decoded, c.pixels * 4u) == 0;
+        fprintf(stderr, "  round trip: %s\n", ok ? "exact" : "MISMATCH");
+        darling_bench_expect("memory", "rle round trip", ok);
+    }
+
+    free(c.frame);
+    free(c.packed);
+    free(c.decoded);
+}
+
+static void bench_cycle(DarlingEvictionMode mode, const char* params) {
+    CycleCtx c = {0};
+    c.frame = (uint32_t*)malloc((size_t)MEMORY_W * MEMORY_H * 4u);
+    if (!c.frame) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < MEMORY_WINDOWS; i++) {
+        c.windows[i] = darling_create_window(MEMORY_W, MEMORY_H, 0);
+        fill_ui_frame(c.frame, MEMORY_W, MEMORY_H, i + 1u);
+        darling_paint_frame_window(c.windows[i], (const unsigned char*)c.frame, MEMORY_W, MEMORY_H);
+    }
+
+    // Half the windows are hidden; the budget only fits the visible half
+    for (uint32_t i = MEMORY_WINDOWS / 2u; i < MEMORY_WINDOWS; i++) {
+        darling_hide_window(c.windows[i]);
+    }
+    darling_set_memory_budget((uint64_t)MEMORY_WINDOWS / 2u * MEMORY_W * MEMORY_H * 4u, mode);
+
+    g_repaint_frame = c.frame;
+    darling_set_frame_request_callback(on_frame_request);
+
+    DarlingMemoryStats before;
+    darling_get_memory_stats(&before);
+
+    DarlingBenchCase cycle = { "memory_evict_restore_cycle", params, run_cycle, &c, 0, 1 };
+    darling_bench_run(&cycle);
+
+    if (darling_bench_enabled(cycle.name)) {
+        DarlingMemoryStats s;
+        darling_get_memory_stats(&s);
+        fprintf(stderr, "  live %.1f MiB in %u stores, kept %.1f MiB compressed; "
+            "evictions %llu, restores %llu, frame requests %llu\n",
+            (double)s.backingBytes / 1048576.0, s.backingStores,
+            (double)s.compressedBytes / 1048576.0,
+            (unsigned long long)(s.evictions - before.evictions),
+            (unsigned long long)(s.restores - before.restores),
+            (unsigned long long)(s.frameRequests - before.frameRequests));
+    }
+
+    darling_set_frame_request_callback(NULL);
+    g_repaint_frame = NULL;
+    darling_set_memory_budget(0, DARLING_EVICT_RELEASE);
+    for (uint32_t i = 0; i < MEMORY_WINDOWS; i++) {
+        darling_destroy_window(c.windows[i]);
+    }
+    darling_poll_events();
+    free(c.frame);
+}
+
+void darling_bench_suite_memory(void) {
+    bench_codec();
+    bench_cycle(DARLING_EVICT_RELEASE, "{\"windows\":8,\"mode\":\"release\"}");
+    bench_cycle(DARLING_EVICT_COMPRESS, "{\"windows\":8,\"mode\":\"compress\"}");
+}
@@ -0,0 +1,186 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Window state mirror: a seqlock read of the mirrored record against the
+// four native queries it replaces (on headless those are plain field
+// reads, so this is the floor of the call path, not the Win32 cost), the
+// publish path the window procedure runs, and a writer/reader thread pair
+// checking that every record read is one the writer wrote whole and that
+// records never go backwards. The same pair without the sequence check
+// shows what the lock prevents.
+
+#define MIRROR_CHECK_WRITES 2000000u
+
+typedef struct MirrorCtx {
+    void* memory;
+    DarlingWindow* win;
+    volatile uint32_t sink;
+} MirrorCtx;
+
+typedef struct MirrorWriter {
+    DarlingStateMirror* mirror;
+    uint32_t writes;
+    int done;
+} MirrorWriter;
+
+static void run_mirror_read(void* p, uint64_t n) {
+    MirrorCtx* c = (MirrorCtx*)p;
+    DarlingWindowState state;
+    uint32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i++) {
+        darling_state_read(c->memory, &state);
+        acc += state.flags + state.dpi;
+    }
+
+    c->sink = acc;
+}
+
+static void run_native_query(void* p, uint64_t n) {
+    MirrorCtx* c = (MirrorCtx*)p;
+    uint32_t acc = 0;
+
+    for (uint64_t i = 0; i < n; i++) {
+        acc += (uint32_t)darling_is_visible(c->win) + (uint32_t)darling_is_focused(c->win);
+        acc += darling_get_dpi(c->win) + (uint32_t)darling_get_scale_factor(c->win);
+    }
+
+    c->sink = acc;
+}
+
+static void run_publish(void* p, uint64_t n) {
+    MirrorCtx* c = (MirrorCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_state_publish(c->win);
+    }
+}
+
+// Every field derives from the write number, so a mix of two writes shows
+static void make_record(uint32_t i, DarlingWindowState* s) {
+    s->flags = i & 31u;
+    s->dpi = i;
+    s->clientWidth = (int32_t)(i + 1u);
+    s->clientHeight = (int32_t)(i + 2u);
+    s->x = -(int32_t)(i & 0xFFFFFu);
+    s->y = (int32_t)(i + 3u);
+    s->width = (int32_t)(i + 4u);
+    s->height = (int32_t)(i + 5u);
+}
+
+static int record_whole(const DarlingWindowState* s) {
+    uint32_t i = s->dpi;
+    return s->flags == (i & 31u) && s->clientWidth == (int32_t)(i + 1u) && s->clientHeight == (int32_t)(i + 2u) &&
+        s->x == -(int32_t)(i & 0xFFFFFu) && s->y == (int32_t)(i + 3u) && s->width == (int32_t)(i + 4u) &&
+        s->height == (int32_t)(i + 5u);
+}
+
+static void* mirror_writer(void* p) {
+    MirrorWriter* w = (MirrorWriter*)p;
+    DarlingWindowState s;
+
+    for (uint32_t i = 1; i <= w->writes; i++) {
+        make_record(i, &s);
+        darling_state_mirror_write(w->mirror, &s);
+    }
+
+    __atomic_store_n(&w->done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+// Field loads with no sequence check, as a reader without the lock would
+static void read_unguarded(const DarlingStateMirror* m, DarlingWindowState* s) {
+    s->flags = (uint32_t)darling_state_load(&m->fields[0]);
+    s->dpi = (uint32_t)darling_state_load(&m->fields[1]);
+    s->clientWidth = darling_state_load(&m->fields[2]);
+    s->clientHeight = darling_state_load(&m->fields[3]);
+    s->x = darling_state_load(&m->fields[4]);
+    s->y = darling_state_load(&m->fields[5]);
+    s->width = darling_state_load(&m->fields[6]);
+    s->height = darling_state_load(&m->fields[7]);
+}
+
+static void check_pair(void* memory, int guarded) {
+    DarlingStateMirror* mirror = (DarlingStateMirror*)memory;
+    MirrorWriter w = { mirror, MIRROR_CHECK_WRITES, 0 };
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t backwards = 0;
+    uint32_t last = 0;
+
+    darling_state_mirror_init(memory, DARLING_STATE_BYTES);
+
+    pthread_t writer;
+    pthread_create(&writer, NULL, mirror_writer, &w);
+
+    while (!__atomic_load_n(&w.done, __ATOMIC_ACQUIRE)) {
+        DarlingWindowState s;
+        if (guarded) {
+            darling_state_read(memory, &s);
+        } else {
+            read_unguarded(mirror, &s);
+        }
+
+        reads++;
+        if (s.dpi == 0) {
+            continue;
+        }
+        torn += record_whole(&s) ? 0u : 1u;
+        backwards += s.dpi < last ? 1u : 0u;
+        last = s.dpi > last ? s.dpi : last;
+    }
+
+    pthread_join(writer, NULL);
+
+    DarlingWindowState final;
+    darling_state_read(memory, &final);
+    fprintf(stderr, "  %s: %u writes, %llu reads, torn %llu, backwards %llu, final record %s (updates %u)\n",
+        guarded ? "seqlock" : "unguarded", w.writes, (unsigned long long)reads, (unsigned long long)torn,
+        (unsigned long long)backwards, final.dpi == w.writes && record_whole(&final) ? "ok" : "WRONG",
+        final.updates);
+
+    // Unguarded reads are expected to tear; they show what the seqlock prevents
+    if (guarded) {
+        darling_bench_expect("seqlock", "records whole and in order", torn == 0 && backwards == 0);
+        darling_bench_expect("seqlock", "final record", final.dpi == w.writes && record_whole(&final));
+    }
+}
+
+void darling_bench_suite_mirror(void) {
+    MirrorCtx c = { 0 };
+    size_t bytes = darling_state_mirror_bytes();
+
+    c.memory = calloc(1, bytes);
+    c.win = darling_create_window(1280, 720, 0);
+    if (!c.memory || !c.win || !darling_state_attach(c.win, c.memory, bytes)) {
+        fprintf(stderr, "mirror suite: setup failed\n");
+        free(c.memory);
+        if (c.win) {
+            darling_destroy_window(c.win);
+        }
+        return;
+    }
+
+    DarlingBenchCase read = { "state_mirror_read", "{}", run_mirror_read, &c, 0, 1 };
+    darling_bench_run(&read);
+
+    DarlingBenchCase query = { "state_native_query", "{\"calls\":4}", run_native_query, &c, 0, 1 };
+    darling_bench_run(&query);
+
+    DarlingBenchCase publish = { "state_mirror_publish", "{}", run_publish, &c, 0, 1 };
+    darling_bench_run(&publish);
+
+    darling_state_detach(c.win);
+    darling_destroy_window(c.win);
+    darling_poll_events();
+
+    if (darling_bench_enabled("state_mirror_read")) {
+        check_pair(c.memory, 1);
+        check_pair(c.memory, 0);
+    }
+
+    free(c.memory);
+}
@@ -0,0 +1,153 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Frame thread pool: full-frame copy and RGBA->BGRA conversion at 4K and
+// 8K from 1 thread up to one per CPU, the fixed cost of dispatching a job,
+// and a check that every row of a job is processed exactly once.
+
+#define POOL_CHECK_ROWS 997u
+#define POOL_CHECK_JOBS 2000u
+
+typedef struct PoolCtx {
+    uint8_t* dst;
+    uint8_t* src;
+    uint32_t width;
+    uint32_t height;
+    DarlingPoolOp op;
+} PoolCtx;
+
+typedef struct CoverageCtx {
+    uint8_t hits[POOL_CHECK_ROWS];
+} CoverageCtx;
+
+static void run_convert(void* p, uint64_t n) {
+    PoolCtx* c = (PoolCtx*)p;
+    size_t stride = (size_t)c->width * 4u;
+
+    for (uint64_t i = 0; i < n; i++) {
+        darling_pool_convert(c->dst, stride, c->src, stride, c->width, c->height, c->op);
+    }
+}
+
+static void empty_rows(void* ctx, uint32_t begin, uint32_t end) {
+    (void)ctx;
+    (void)begin;
+    (void)end;
+}
+
+static void run_dispatch(void* p, uint64_t n) {
+    (void)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_pool_for_rows(1024u, DARLING_POOL_MIN_BYTES / 1024u, empty_rows, NULL);
+    }
+}
+
+static void count_rows(void* ctx, uint32_t begin, uint32_t end) {
+    CoverageCtx* c = (CoverageCtx*)ctx;
+    for (uint32_t row = begin; row < end; row++) {
+        c->hits[row]++;
+    }
+}
+
+static void check_coverage(void) {
+    CoverageCtx c;
+    size_t bad = 0;
+
+    for (uint32_t job = 0; job < POOL_CHECK_JOBS; job++) {
+        memset(c.hits, 0, sizeof(c.hits));
+        // Rows of ~4.7 KB: 13-row bands with a short last one
+        darling_pool_for_rows(POOL_CHECK_ROWS, 4800u, count_rows, &c);
+
+        for (uint32_t row = 0; row < POOL_CHECK_ROWS; row++) {
+            bad += c.hits[row] != 1u;
+        }
+    }
+
+    DarlingThreadPoolStats stats;
+    darling_get_thread_pool_stats(&stats);
+    fprintf(stderr, "  coverage: %zu rows missed or repeated over %u jobs (%u workers, %llu steals)\n",
+        bad, POOL_CHECK_JOBS, stats.workers, (unsigned long long)stats.steals);
+    darling_bench_expect("pool", "every row once", bad == 0);
+}
+
+static void report_steals(uint64_t* last) {
+    DarlingThreadPoolStats stats;
+    darling_get_thread_pool_stats(&stats);
+    fprintf(stderr, "  %u workers, %llu bands stolen\n",
+        stats.workers, (unsigned long long)(stats.steals - *last));
+    *last = stats.steals;
+}
+
+void darling_bench_suite_pool(void) {
+    static const uint32_t k_sizes[][2] = { { 3840u, 2160u }, { 7680u, 4320u } };
+    static const DarlingPoolOp k_ops[] = { DARLING_POOL_COPY, DARLING_POOL_SWIZZLE };
+    static const char* k_op_names[] = { "copy", "rgba_to_bgra" };
+
+    uint32_t cpus = darling_cpu_count();
+    size_t maxBytes = (size_t)7680u * 4320u * 4u;
+    PoolCtx c = { 0 };
+    uint64_t steals = 0;
+
+    // 1, 2, 4, ... threads, then one per CPU
+    uint32_t counts[8];
+    uint32_t countN = 0;
+    for (uint32_t t = 1; t < cpus && countN < 7u; t *= 2u) {
+        counts[countN++] = t;
+    }
+    counts[countN++] = cpus;
+
+    c.src = (uint8_t*)malloc(maxBytes);
+    c.dst = (uint8_t*)malloc(maxBytes);
+    if (!c.src || !c.dst) {
+        fprintf(stderr, "pool suite: allocation failed\n");
+        free(c.src);
+        free(c.dst);
+        return;
+    }
+
+    darling_bench_fill(c.src, maxBytes, 13u);
+    memset(c.dst, 0, maxBytes);
+
+    for (size_t s = 0; s < sizeof(k_sizes) / sizeof(k_sizes[0]); s++) {
+        for (size_t o = 0; o < sizeof(k_ops) / sizeof(k_ops[0]); o++) {
+            for (uint32_t t = 0; t < countN; t++) {
+                uint32_t threads = counts[t];
+                char params[128];
+                c.width = k_sizes[s][0];
+                c.height = k_sizes[s][1];
+                c.op = k_ops[o];
+                snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"op\":\"%s\",\"threads\":%u}",
+                    c.width, c.height, k_op_names[o], threads);
+
+                darling_set_thread_pool(threads, 0);
+
+                DarlingBenchCase convert = { "pool_frame", params, run_convert, &c, (double)c.width * c.height * 4.0, 0 };
+                darling_bench_run(&convert);
+                if (darling_bench_enabled(convert.name) && threads > 1) {
+                    report_steals(&steals);
+                }
+            }
+        }
+    }
+
+    darling_set_thread_pool(0, 0);
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"bytes\":%u,\"threads\":%u}", DARLING_POOL_MIN_BYTES, cpus);
+    DarlingBenchCase dispatch = { "pool_dispatch", params, run_dispatch, NULL, 0, 1 };
+    darling_bench_run(&dispatch);
+
+    // At least four threads so stealing is exercised on small machines too
+    if (darling_bench_enabled("pool_dispatch")) {
+        darling_set_thread_pool(cpus < 4u ? 4u : cpus, 0);
+        check_coverage();
+        darling_set_thread_pool(0, 0);
+    }
+
+    free(c.src);
+    free(c.dst);
+}
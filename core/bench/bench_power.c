@@ -0,0 +1,236 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Power throttling: presenting 1920x1080 frames to a visible window against
+// presenting them to the same window minimized under an enabled policy
+// (skipped), and the occlusion test on a screen tiled with windows. A final
+// check compares the occlusion test with a brute-force pixel grid and walks
+// a window through minimize, occlusion, hide and policy changes.
+
+#define PW_W 1920u
+#define PW_H 1080u
+#define PW_ABOVE 48u
+#define PW_CHECK_TRIALS 4000u
+#define PW_GRID 48
+
+typedef struct PwCtx {
+    DarlingWindow* win;
+    uint32_t* frame;
+    DarlingDamageRect target;
+    DarlingDamageRect above[PW_ABOVE];
+    uint32_t tick;
+} PwCtx;
+
+static void run_present(void* p, uint64_t n) {
+    PwCtx* c = (PwCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->frame[c->tick++ % (PW_W * PW_H)] ^= 1u;
+        darling_paint_frame_window(c->win, (const uint8_t*)c->frame, PW_W, PW_H);
+    }
+}
+
+static void run_covered(void* p, uint64_t n) {
+    PwCtx* c = (PwCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->tick += darling_power_covered(&c->target, c->above, PW_ABOVE) ? 1u : 0u;
+    }
+}
+
+// Flush posted state changes and recheck occlusion at once
+static void pw_settle(void) {
+    darling_poll_events();
+}
+
+typedef struct PwEvents {
+    uint32_t changes;
+    uint32_t visibility;
+    uint32_t throttled;
+    uint32_t rate;
+    uint32_t frameRequests;
+} PwEvents;
+
+static PwEvents g_pw_events;
+
+static void pw_on_visibility(uintptr_t hwnd, uint32_t visibility, uint32_t throttled, uint32_t rate) {
+    (void)hwnd;
+    g_pw_events.changes++;
+    g_pw_events.visibility = visibility;
+    g_pw_events.throttled = throttled;
+    g_pw_events.rate = rate;
+}
+
+static void pw_on_frame_request(uintptr_t hwnd) {
+    (void)hwnd;
+    g_pw_events.frameRequests++;
+}
+
+// Random windows over a small screen, each answer compared with a grid of
+// covered pixels. Running out of pieces may only ever answer "visible".
+static void check_covered(uint32_t* wrong, uint32_t* conservative) {
+    uint32_t seed = 21;
+    uint8_t grid[PW_GRID * PW_GRID];
+
+    for (uint32_t t = 0; t < PW_CHECK_TRIALS; t++) {
+        DarlingDamageRect rects[24];
+        uint32_t count = 1u + darling_bench_rand(&seed) % 24u;
+        DarlingDamageRect target = { 8, 8, 40, 40 };
+        memset(grid, 0, sizeof(grid));
+
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t r = darling_bench_rand(&seed);
+            int32_t x0 = (int32_t)(r % PW_GRID);
+            int32_t y0 = (int32_t)((r >> 8) % PW_GRID);
+            rects[i].x0 = x0;
+            rects[i].y0 = y0;
+            rects[i].x1 = x0 + 1 + (int32_t)((r >> 16) % (PW_GRID - (uint32_t)x0));
+            rects[i].y1 = y0 + 1 + (int32_t)((r >> 24) % (PW_GRID - (uint32_t)y0));
+            for (int32_t y = rects[i].y0; y < rects[i].y1; y++) {
+                memset(grid + y * PW_GRID + rects[i].x0, 1, (size_t)(rects[i].x1 - rects[i].x0));
+            }
+        }
+
+        BOOL expected = TRUE;
+        for (int32_t y = target.y0; y < target.y1 && expected; y++) {
+            for (int32_t x = target.x0; x < target.x1; x++) {
+                if (!grid[y * PW_GRID + x]) {
+                    expected = FALSE;
+                    break;
+                }
+            }
+        }
+
+        BOOL covered = darling_power_covered(&target, rects, count);
+        if (covered && !expected) {
+            (*wrong)++;
+        } else if (!covered && expected) {
+            (*conservative)++;
+        }
+    }
+}
+
+static void check_transitions(PwCtx* c) {
+    DarlingThrottlePolicy policy = { 1, 1, 5, 0, 0, 1 };
+    DarlingPowerStats before;
+    DarlingPowerStats st;
+    HWND hwnd = c->win->hwnd;
+
+    darling_set_throttle_policy(&policy);
+    darling_set_visibility_callback(pw_on_visibility);
+    darling_set_frame_request_callback(pw_on_frame_request);
+    memset(&g_pw_events, 0, sizeof(g_pw_events));
+    darling_get_power_stats(c->win, &before);
+
+    darling_post_message(hwnd, DARLING_MSG_MINIMIZE, 1, 0);
+    pw_settle();
+    run_present(c, 3);
+    darling_get_power_stats(c->win, &st);
+    darling_bench_expect("power", "minimize", g_pw_events.changes == 1 && g_pw_events.throttled == 1 &&
+        g_pw_events.visibility == DARLING_VISIBILITY_MINIMIZED && g_pw_events.rate == 0 &&
+        st.skippedPresents == before.skippedPresents + 3u && st.presents == before.presents);
+
+    darling_post_message(hwnd, DARLING_MSG_MINIMIZE, 0, 0);
+    pw_settle();
+    darling_bench_expect("power", "restore", g_pw_events.changes == 2 && g_pw_events.throttled == 0 && g_pw_events.frameRequests == 1);
+
+    darling_post_message(hwnd, DARLING_MSG_OCCLUDE, 1, 0);
+    pw_settle();
+    run_present(c, 1);
+    darling_bench_expect("power", "occlude", g_pw_events.throttled == 1 && g_pw_events.rate == 5 &&
+        g_pw_events.visibility == DARLING_VISIBILITY_OCCLUDED);
+
+    // Covered windows keep presenting once the policy leaves them alone
+    policy.throttleOccluded = 0;
+    darling_set_throttle_policy(&policy);
+    darling_bench_expect("power", "policy change", g_pw_events.throttled == 0 && g_pw_events.frameRequests == 2);
+    darling_get_power_stats(c->win, &before);
+    run_present(c, 1);
+    darling_get_power_stats(c->win, &st);
+    darling_bench_expect("power", "occluded present", st.presents == before.presents + 1u);
+
+    darling_post_message(hwnd, DARLING_MSG_OCCLUDE, 0, 0);
+    pw_settle();
+    darling_hide_window(c->win);
+    darling_bench_expect("power", "hide", g_pw_events.throttled == 1 && g_pw_events.visibility == DARLING_VISIBILITY_HIDDEN);
+    darling_show_window(c->win);
+    darling_bench_expect("power", "show", g_pw_events.throttled == 0 && g_pw_events.visibility == DARLING_VISIBILITY_VISIBLE &&
+        g_pw_events.frameRequests == 2);
+
+    darling_get_power_stats(c->win, &st);
+    fprintf(stderr, "  check power: %u transitions reported, %u frames requested, %.1f ms throttled\n",
+        g_pw_events.changes, g_pw_events.frameRequests, st.throttledMs);
+
+    darling_set_frame_request_callback(NULL);
+    darling_set_visibility_callback(NULL);
+}
+
+void darling_bench_suite_power(void) {
+    PwCtx c;
+    memset(&c, 0, sizeof(c));
+    c.frame = (uint32_t*)calloc((size_t)PW_W * PW_H, 4u);
+    c.win = darling_create_window(PW_W, PW_H, 0);
+    if (!c.frame || !c.win) {
+        free(c.frame);
+        darling_destroy_window(c.win);
+        return;
+    }
+
+    DarlingThrottlePolicy policy = { 1, 1, 0, 0, 0, 0 };
+    darling_set_throttle_policy(&policy);
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"w\":%u,\"h\":%u}", PW_W, PW_H);
+
+    DarlingBenchCase visible = { "power_present_visible", params, run_present, &c, (uint64_t)PW_W * PW_H * 4u, 1 };
+    darling_bench_run(&visible);
+    if (darling_bench_enabled(visible.name)) {
+        DarlingPowerStats st;
+        darling_get_power_stats(c.win, &st);
+        fprintf(stderr, "  %s: %llu presents, %.3f ms wall and %.3f ms CPU each\n", visible.name,
+            (unsigned long long)st.presents, st.presentMs / (double)st.presents, st.presentCpuMs / (double)st.presents);
+    }
+
+    darling_post_message(c.win->hwnd, DARLING_MSG_MINIMIZE, 1, 0);
+    pw_settle();
+    DarlingBenchCase minimized = { "power_present_minimized", params, run_present, &c, 0, 1 };
+    darling_bench_run(&minimized);
+    darling_post_message(c.win->hwnd, DARLING_MSG_MINIMIZE, 0, 0);
+    pw_settle();
+
+    // A window under a screen tiled with 6 x 8 others, each overlapping the
+    // next: the worst case splits the window into many pieces first
+    c.target.x0 = 200;
+    c.target.y0 = 150;
+    c.target.x1 = 1700;
+    c.target.y1 = 950;
+    for (uint32_t i = 0; i < PW_ABOVE; i++) {
+        int32_t x = (int32_t)(i % 8u) * 240;
+        int32_t y = (int32_t)(i / 8u) * 180;
+        DarlingDamageRect r = { x, y, x + 260, y + 200 };
+        c.above[i] = r;
+    }
+    snprintf(params, sizeof(params), "{\"above\":%u}", PW_ABOVE);
+    DarlingBenchCase covered = { "power_occlusion_test", params, run_covered, &c, 0, PW_ABOVE };
+    darling_bench_run(&covered);
+
+    if (darling_bench_enabled(visible.name)) {
+        uint32_t wrong = 0;
+        uint32_t conservative = 0;
+        check_covered(&wrong, &conservative);
+        fprintf(stderr, "  check occlusion: %u trials, %u wrongly covered, %u covered reported visible, tiled screen %s\n",
+            PW_CHECK_TRIALS, wrong, conservative, darling_power_covered(&c.target, c.above, PW_ABOVE) ? "covered" : "visible");
+        darling_bench_expect("occlusion", "never wrongly covered", wrong == 0);
+
+        uint32_t failures = darling_bench_failures();
+        check_transitions(&c);
+        fprintf(stderr, "  check power: %u failures\n", darling_bench_failures() - failures);
+    }
+
+    darling_set_throttle_policy(NULL);
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.frame);
+}
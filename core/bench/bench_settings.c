@@ -0,0 +1,103 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// System settings service: cached queries and broadcast refresh + fan-out,
+// driven by a fake provider so no OS source is involved.
+
+typedef struct FakeSource {
+    DarlingSystemSettings current;
+} FakeSource;
+
+static int fake_read(void* ctx, DarlingSystemSettings* out) {
+    *out = ((FakeSource*)ctx)->current;
+    return 1;
+}
+
+typedef struct SettingsCtx {
+    FakeSource* source;
+    DarlingWindow** windows;
+    uint32_t count;
+    uint64_t flips;
+} SettingsCtx;
+
+static void run_cached_get(void* p, uint64_t n) {
+    (void)p;
+    int dark = 0;
+    for (uint64_t i = 0; i < n; i++) {
+        dark += darling_is_dark_mode();
+    }
+    if (dark == -1) {
+        fputc(' ', stderr);
+    }
+}
+
+// One theme flip as Windows delivers it: the change notification reaches
+// every top-level window, then the single scheduled refresh runs.
+static void run_broadcast(void* p, uint64_t n) {
+    SettingsCtx* c = (SettingsCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->source->current.darkMode = !c->source->current.darkMode;
+        for (uint32_t w = 0; w < c->count; w++) {
+            darling_post_message(c->windows[w]->hwnd, DARLING_MSG_SETTINGCHANGE, 0, 0);
+        }
+        darling_poll_events();
+    }
+    c->flips += n;
+}
+
+void darling_bench_suite_settings(void) {
+    static const uint32_t k_counts[] = { 1, 16, 256 };
+
+    FakeSource source = { { 0, 0x0078D4, 0 } };
+    DarlingSettingsProvider provider = { fake_read, &source };
+    darling_settings_set_provider(&provider);
+
+    DarlingBenchCase cached = { "settings_get_cached", "{}", run_cached_get, NULL, 0, 1 };
+    darling_bench_run(&cached);
+
+    for (size_t s = 0; s < sizeof(k_counts) / sizeof(k_counts[0]); s++) {
+        SettingsCtx c = { &source, NULL, k_counts[s], 0 };
+        c.windows = (DarlingWindow**)calloc(c.count, sizeof(DarlingWindow*));
+        if (!c.windows) {
+            fprintf(stderr, "settings suite: allocation failed\n");
+            break;
+        }
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            c.windows[i] = darling_create_window(64, 64, 0);
+        }
+
+        char params[64];
+        snprintf(params, sizeof(params), "{\"windows\":%u}", c.count);
+
+        uint64_t readsBefore = darling_settings_read_count();
+        DarlingBenchCase broadcast = { "settings_broadcast_fanout", params, run_broadcast, &c, 0, 1 };
+        darling_bench_run(&broadcast);
+
+        if (darling_bench_enabled(broadcast.name)) {
+            uint64_t reads = darling_settings_read_count() - readsBefore;
+            fprintf(stderr, "  provider reads during run: %llu over %llu flips\n",
+                (unsigned long long)reads, (unsigned long long)c.flips);
+            darling_bench_expect("settings", "one provider read per broadcast", reads == c.flips);
+
+            // Every window follows the last flip
+            uint32_t stale = 0;
+            for (uint32_t i = 0; i < c.count; i++) {
+                if (!c.windows[i]->darkMode != !source.current.darkMode) {
+                    stale++;
+                }
+            }
+            darling_bench_expect("settings", "windows follow the flip", stale == 0);
+        }
+
+        for (uint32_t i = 0; i < c.count; i++) {
+            darling_destroy_window(c.windows[i]);
+        }
+        free(c.windows);
+    }
+
+    darling_settings_set_provider(NULL);
+}
@@ -0,0 +1,217 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Splash snapshot: time from window creation to its first pixel (create,
+// present, destroy) with the snapshot mapped and copied as stored, against
+// the same frame read() from a file then painted, against an RLE-compressed
+// copy decoded then painted, and against a window left blank. Saving the
+// presented frame is measured on its own. The file stays in the page cache
+// throughout, as it would on a relaunch. A final check compares the splash
+// with the saved pixels, lets a strip advance and ends it with a frame.
+
+#define SNAP_W 1280u
+#define SNAP_H 720u
+#define SNAP_STRIP 4u
+
+typedef struct SnapCtx {
+    char path[64];
+    char rawPath[64];
+    uint32_t* frame;
+    uint32_t* rle;
+    size_t rleWords;
+    uint32_t* decoded;
+    uint64_t shown;
+} SnapCtx;
+
+// Flat panels with text-like noise in bands, like an app's UI
+static void fill_ui(uint32_t* px, uint32_t w, uint32_t h, uint32_t seed) {
+    for (uint32_t y = 0; y < h; y++) {
+        uint32_t panel = y < 48u ? 0xFF202020u : (y / 160u) % 2u ? 0xFF2B2B2Bu : 0xFF252526u;
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t v = panel;
+            if ((y % 24u) >= 8u && (y % 24u) < 18u && x > 64u && x < w - 64u) {
+                v = (darling_bench_rand(&seed) & 3u) == 0u ? 0xFFD4D4D4u : panel;
+            }
+            px[(size_t)y * w + x] = v;
+        }
+    }
+}
+
+static void run_splash(void* p, uint64_t n) {
+    SnapCtx* c = (SnapCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_set_splash_snapshot(c->path);
+        DarlingWindow* win = darling_create_window(SNAP_W, SNAP_H, 0);
+        c->shown += win->presentCount;
+        darling_destroy_window(win);
+    }
+}
+
+static void run_read_paint(void* p, uint64_t n) {
+    SnapCtx* c = (SnapCtx*)p;
+    size_t bytes = (size_t)SNAP_W * SNAP_H * 4u;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* win = darling_create_window(SNAP_W, SNAP_H, 0);
+        FILE* f = fopen(c->rawPath, "rb");
+        if (f) {
+            if (fread(c->decoded, 1, bytes, f) == bytes) {
+                darling_paint_frame_window(win, (const uint8_t*)c->decoded, SNAP_W, SNAP_H);
+            }
+            fclose(f);
+        }
+        c->shown += win->presentCount;
+        darling_destroy_window(win);
+    }
+}
+
+static void run_decode_paint(void* p, uint64_t n) {
+    SnapCtx* c = (SnapCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* win = darling_create_window(SNAP_W, SNAP_H, 0);
+        if (darling_frame_rle_decode(c->rle, c->rleWords, c->decoded, (size_t)SNAP_W * SNAP_H)) {
+            darling_paint_frame_window(win, (const uint8_t*)c->decoded, SNAP_W, SNAP_H);
+        }
+        c->shown += win->presentCount;
+        darling_destroy_window(win);
+    }
+}
+
+static void run_blank(void* p, uint64_t n) {
+    SnapCtx* c = (SnapCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        DarlingWindow* win = darling_create_window(SNAP_W, SNAP_H, 0);
+        c->shown += win->presentCount;
+        darling_destroy_window(win);
+    }
+}
+
+typedef struct SaveCtx {
+    DarlingWindow* win;
+    const char* path;
+    uint32_t failed;
+} SaveCtx;
+
+static void run_save(void* p, uint64_t n) {
+    SaveCtx* s = (SaveCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        s->failed += darling_snapshot_save(s->win, s->path, NULL, 0, 0, 0, 0) ? 0u : 1u;
+    }
+}
+
+static void check_splash(SnapCtx* c) {
+    size_t pixels = (size_t)SNAP_W * SNAP_H;
+    uint32_t* strip = (uint32_t*)malloc(pixels * 4u * SNAP_STRIP);
+    if (!strip) {
+        return;
+    }
+
+    // A still: the splash shows the saved pixels and keeps the saved theme
+    DarlingSplashStats stats;
+    darling_set_splash_snapshot(c->path);
+    DarlingWindow* win = darling_create_window(SNAP_W, SNAP_H, 0);
+    darling_get_splash_stats(win, &stats);
+    int same = win->dibBits && memcmp(win->dibBits, c->frame, pixels * 4u) == 0;
+    fprintf(stderr, "  check still: showing %u, pixels %s, dark %d, first pixel %.3f ms\n",
+        stats.showing, same ? "match" : "DIFFER", win->darkMode ? 1 : 0, stats.firstPixelMs);
+    darling_bench_expect("still", "saved pixels shown", stats.showing && same);
+    darling_destroy_window(win);
+
+    // A strip: advances with darling_poll_events until a frame of the app's
+    for (uint32_t f = 0; f < SNAP_STRIP; f++) {
+        fill_ui(strip + pixels * f, SNAP_W, SNAP_H, 7u + f);
+    }
+    win = darling_create_window(SNAP_W, SNAP_H, 0);
+    int saved = darling_snapshot_save(win, c->path, (const uint8_t*)strip, SNAP_W, SNAP_H, SNAP_STRIP, 1);
+    darling_destroy_window(win);
+
+    darling_set_splash_snapshot(c->path);
+    win = darling_create_window(SNAP_W, SNAP_H, 0);
+    uint64_t end = darling_bench_now_ns() + 20000000u;
+    while (darling_bench_now_ns() < end) {
+        darling_poll_events();
+    }
+    darling_get_splash_stats(win, &stats);
+    uint64_t played = stats.shown;
+
+    darling_paint_frame_window(win, (const uint8_t*)c->frame, SNAP_W, SNAP_H);
+    end = darling_bench_now_ns() + 5000000u;
+    while (darling_bench_now_ns() < end) {
+        darling_poll_events();
+    }
+    darling_get_splash_stats(win, &stats);
+    same = memcmp(win->dibBits, c->frame, pixels * 4u) == 0;
+    fprintf(stderr, "  check strip: saved %d, %llu frames in 20 ms, after an app frame showing %u, %llu more, app pixels %s\n",
+        saved, (unsigned long long)played, stats.showing, (unsigned long long)(stats.shown - played),
+        same ? "kept" : "OVERWRITTEN");
+    darling_bench_expect("strip", "saved and ended by an app frame", saved && !stats.showing && same);
+    darling_destroy_window(win);
+    free(strip);
+}
+
+void darling_bench_suite_snapshot(void) {
+    SnapCtx c;
+    memset(&c, 0, sizeof(c));
+    size_t pixels = (size_t)SNAP_W * SNAP_H;
+    c.frame = (uint32_t*)malloc(pixels * 4u);
+    c.decoded = (uint32_t*)malloc(pixels * 4u);
+    c.rle = (uint32_t*)malloc(pixels * 8u);
+    if (!c.frame || !c.decoded || !c.rle) {
+        free(c.frame);
+        free(c.decoded);
+        free(c.rle);
+        return;
+    }
+
+    snprintf(c.path, sizeof(c.path), "/tmp/darling-bench-%d.snap", (int)getpid());
+    snprintf(c.rawPath, sizeof(c.rawPath), "/tmp/darling-bench-%d.raw", (int)getpid());
+    fill_ui(c.frame, SNAP_W, SNAP_H, 1u);
+    c.rleWords = darling_frame_rle_encode(c.frame, pixels, c.rle, pixels * 2u);
+
+    FILE* raw = fopen(c.rawPath, "wb");
+    if (raw) {
+        fwrite(c.frame, 4, pixels, raw);
+        fclose(raw);
+    }
+
+    // The snapshot under test: this frame, saved from a dark window
+    SaveCtx save = { darling_create_window(SNAP_W, SNAP_H, 0), c.path, 0 };
+    darling_set_dark_mode(save.win, 1);
+    darling_paint_frame_window(save.win, (const uint8_t*)c.frame, SNAP_W, SNAP_H);
+    darling_snapshot_save(save.win, c.path, NULL, 0, 0, 0, 0);
+
+    char params[96];
+    snprintf(params, sizeof(params), "{\"w\":%u,\"h\":%u,\"rleRatio\":%.3f}", SNAP_W, SNAP_H,
+        (double)c.rleWords / (double)pixels);
+
+    DarlingBenchCase splash = { "snapshot_first_pixel_mapped", params, run_splash, &c, pixels * 4u, 1 };
+    darling_bench_run(&splash);
+
+    DarlingBenchCase readPaint = { "snapshot_first_pixel_read", params, run_read_paint, &c, pixels * 4u, 1 };
+    darling_bench_run(&readPaint);
+
+    DarlingBenchCase decodePaint = { "snapshot_first_pixel_rle", params, run_decode_paint, &c, pixels * 4u, 1 };
+    darling_bench_run(&decodePaint);
+
+    DarlingBenchCase blank = { "snapshot_create_blank", params, run_blank, &c, 0, 1 };
+    darling_bench_run(&blank);
+
+    DarlingBenchCase saveCase = { "snapshot_save", params, run_save, &save, pixels * 4u, 1 };
+    darling_bench_run(&saveCase);
+
+    if (darling_bench_enabled(splash.name)) {
+        check_splash(&c);
+    }
+
+    darling_destroy_window(save.win);
+    darling_poll_events();
+    unlink(c.path);
+    unlink(c.rawPath);
+    free(c.frame);
+    free(c.decoded);
+    free(c.rle);
+}
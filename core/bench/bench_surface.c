@@ -0,0 +1,246 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Virtual surfaces: a 1920x1080 viewport over a 200000 x 200000 surface of
+// 256-pixel tiles. Smooth scrolling (8 pixels a step, down and back) over
+// cached tiles, scrolling into tiles the app has to upload when asked, and
+// jumping to cached places, against painting every step as a full frame
+// through darling_paint_frame_window (the copy alone; rendering the frame
+// in JavaScript is not counted). A final check scrolls at random with a
+// budget smaller than the viewport and compares every pixel with the
+// surface's content.
+
+#define SF_W 1920u
+#define SF_H 1080u
+#define SF_SURFACE 200000u
+#define SF_TILE 256u
+#define SF_STEP 8
+#define SF_CHECK_STEPS 400u
+
+typedef struct SfCtx {
+    DarlingWindow* win;
+    uint32_t* tile;
+    uint32_t* frame;
+    uint32_t x;
+    uint32_t y;
+    int32_t dir;
+    uint32_t seed;
+} SfCtx;
+
+static SfCtx* g_sf_ctx = NULL;
+
+// Requested tiles are answered at once with the same prepared pixels
+static void sf_on_tiles(uintptr_t hwnd, const int32_t* tiles, uint32_t count) {
+    (void)hwnd;
+    SfCtx* c = g_sf_ctx;
+    for (uint32_t i = 0; c && i < count; i++) {
+        darling_surface_upload_tile(c->win, tiles[i * 2u], tiles[i * 2u + 1u], (const uint8_t*)c->tile);
+    }
+}
+
+static void run_scroll_cached(void* p, uint64_t n) {
+    SfCtx* c = (SfCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        if ((c->dir > 0 && c->y >= 2000u) || (c->dir < 0 && c->y < (uint32_t)SF_STEP)) {
+            c->dir = -c->dir;
+        }
+        c->y = (uint32_t)((int32_t)c->y + c->dir * SF_STEP);
+        darling_surface_scroll_to(c->win, c->x, c->y);
+    }
+}
+
+// Always onward, so a new row of tiles every 32 steps
+static void run_scroll_fetch(void* p, uint64_t n) {
+    SfCtx* c = (SfCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->y = c->y + SF_STEP < SF_SURFACE - SF_H ? c->y + SF_STEP : 0;
+        darling_surface_scroll_to(c->win, c->x, c->y);
+    }
+}
+
+static void run_jump(void* p, uint64_t n) {
+    SfCtx* c = (SfCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        uint32_t r = darling_bench_rand(&c->seed);
+        darling_surface_scroll_to(c->win, r % 1000u, (r >> 10) % 1000u);
+    }
+}
+
+static void run_full_frame(void* p, uint64_t n) {
+    SfCtx* c = (SfCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->frame[c->seed++ % (SF_W * SF_H)] ^= 1u;
+        darling_paint_frame_window(c->win, (const uint8_t*)c->frame, SF_W, SF_H);
+    }
+}
+
+static uint8_t g_sf_gen[64 * 64];
+
+static uint32_t sf_content(uint32_t x, uint32_t y) {
+    return ((x * 2654435761u) ^ (y * 40503u) ^ g_sf_gen[y / 64u % 64u * 64u + x / 64u % 64u]) | 0xFF000000u;
+}
+
+static DarlingWindow* g_sf_check_win = NULL;
+
+static void sf_check_tiles(uintptr_t hwnd, const int32_t* tiles, uint32_t count) {
+    (void)hwnd;
+    uint32_t px[64 * 64];
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t col = (uint32_t)tiles[i * 2u];
+        uint32_t row = (uint32_t)tiles[i * 2u + 1u];
+        for (uint32_t k = 0; k < 64u * 64u; k++) {
+            px[k] = sf_content(col * 64u + k % 64u, row * 64u + k / 64u);
+        }
+        darling_surface_upload_tile(g_sf_check_win, (int32_t)col, (int32_t)row, (const uint8_t*)px);
+    }
+}
+
+// 64-pixel tiles, 48 of them cached (fewer than the viewport shows): small
+// and large scrolls, jumps and edits, every pixel compared after each
+static void check_surface(void) {
+    const uint32_t w = 640;
+    const uint32_t h = 480;
+    const uint32_t size = 4096;
+    uint32_t seed = 11;
+    uint32_t mismatches = 0;
+
+    memset(g_sf_gen, 0, sizeof(g_sf_gen));
+    g_sf_check_win = darling_create_window(w, h, 0);
+    darling_set_tile_request_callback(sf_check_tiles);
+    darling_surface_create(g_sf_check_win, size, size, 64, 48u * 64u * 64u * 4u, 0xFF000000u);
+
+    uint32_t x = 0;
+    uint32_t y = 0;
+    for (uint32_t s = 0; s < SF_CHECK_STEPS; s++) {
+        uint32_t r = darling_bench_rand(&seed);
+        switch (r % 4u) {
+            case 0:
+                x = r % size;
+                y = (r >> 12) % size;
+                break;
+            case 1:
+                x += r % 41u - 20u;
+                y += (r >> 8) % 41u - 20u;
+                break;
+            case 2:
+                y += (r >> 8) % 900u - 450u;
+                break;
+            default: {
+                // Edit a block of content the app then reports
+                uint32_t ex = (r >> 4) % size;
+                uint32_t ey = (r >> 16) % size;
+                for (uint32_t ty = ey / 64u; ty <= (ey + 99u) / 64u && ty < size / 64u; ty++) {
+                    for (uint32_t tx = ex / 64u; tx <= (ex + 99u) / 64u && tx < size / 64u; tx++) {
+                        g_sf_gen[ty * 64u + tx]++;
+                    }
+                }
+                darling_surface_invalidate(g_sf_check_win, ex, ey, 100, 100);
+                break;
+            }
+        }
+        x = x > size ? 0 : x;
+        y = y > size ? 0 : y;
+        darling_surface_scroll_to(g_sf_check_win, x, y);
+
+        DarlingSurfaceStats st;
+        darling_get_surface_stats(g_sf_check_win, &st);
+        const uint32_t* px = (const uint32_t*)g_sf_check_win->dibBits;
+        for (uint32_t i = 0; i < w * h; i++) {
+            if (px[i] != sf_content(st.x + i % w, st.y + i / w)) {
+                mismatches++;
+                break;
+            }
+        }
+    }
+
+    DarlingSurfaceStats st;
+    darling_get_surface_stats(g_sf_check_win, &st);
+    fprintf(stderr, "  check surface: %u steps, %u mismatches, %u tiles cached of 48, %llu evictions, hit rate %.1f%%\n",
+        SF_CHECK_STEPS, mismatches, st.cachedTiles, (unsigned long long)st.evictions,
+        100.0 * (double)st.hits / (double)(st.hits + st.misses));
+    darling_bench_expect("surface", "viewport matches content", mismatches == 0);
+
+    darling_set_tile_request_callback(NULL);
+    darling_destroy_window(g_sf_check_win);
+    g_sf_check_win = NULL;
+}
+
+static void sf_print_stats(const char* name, DarlingWindow* win) {
+    DarlingSurfaceStats st;
+    darling_get_surface_stats(win, &st);
+    fprintf(stderr, "  %s: %u tiles cached (%.0f MB of %.0f), hit rate %.1f%%, %llu requested, %llu evicted\n", name,
+        st.cachedTiles, (double)st.tileBytes / 1048576.0, (double)st.budgetBytes / 1048576.0,
+        100.0 * (double)st.hits / (double)(st.hits + st.misses), (unsigned long long)st.requests,
+        (unsigned long long)st.evictions);
+}
+
+void darling_bench_suite_surface(void) {
+    SfCtx c;
+    memset(&c, 0, sizeof(c));
+    c.dir = 1;
+    c.seed = 3;
+    c.tile = (uint32_t*)malloc((size_t)SF_TILE * SF_TILE * 4u);
+    c.frame = (uint32_t*)calloc((size_t)SF_W * SF_H, 4u);
+    c.win = darling_create_window(SF_W, SF_H, 0);
+    if (!c.tile || !c.frame || !c.win) {
+        free(c.tile);
+        free(c.frame);
+        darling_destroy_window(c.win);
+        return;
+    }
+
+    for (uint32_t i = 0; i < SF_TILE * SF_TILE; i++) {
+        c.tile[i] = 0xFF000000u | (i * 2654435761u >> 8);
+    }
+
+    g_sf_ctx = &c;
+    darling_set_tile_request_callback(sf_on_tiles);
+    darling_surface_create(c.win, SF_SURFACE, SF_SURFACE, SF_TILE, 256u << 20, 0xFF1E1E1Eu);
+
+    char params[96];
+    snprintf(params, sizeof(params), "{\"w\":%u,\"h\":%u,\"tile\":%u,\"step\":%d}", SF_W, SF_H, SF_TILE, SF_STEP);
+
+    // Cached: the first pass uploads what the range needs
+    DarlingBenchCase cached = { "surface_scroll_cached", params, run_scroll_cached, &c, (uint64_t)SF_W * SF_H * 4u, 1 };
+    darling_bench_run(&cached);
+    if (darling_bench_enabled(cached.name)) {
+        sf_print_stats(cached.name, c.win);
+    }
+
+    // Cache everything the jumps can show
+    for (uint32_t y = 0; y <= 1000u; y += 500u) {
+        for (uint32_t x = 0; x <= 1000u; x += 500u) {
+            darling_surface_scroll_to(c.win, x, y);
+        }
+    }
+    DarlingBenchCase jump = { "surface_jump_cached", params, run_jump, &c, (uint64_t)SF_W * SF_H * 4u, 1 };
+    darling_bench_run(&jump);
+
+    c.x = 4096;
+    c.y = 0;
+    darling_surface_scroll_to(c.win, c.x, c.y);
+    DarlingBenchCase fetch = { "surface_scroll_fetch", params, run_scroll_fetch, &c, (uint64_t)SF_W * SF_H * 4u, 1 };
+    darling_bench_run(&fetch);
+    if (darling_bench_enabled(fetch.name)) {
+        sf_print_stats(fetch.name, c.win);
+    }
+
+    DarlingBenchCase frame = { "surface_full_frame_paint", params, run_full_frame, &c, (uint64_t)SF_W * SF_H * 4u, 1 };
+    darling_bench_run(&frame);
+
+    darling_set_tile_request_callback(NULL);
+    g_sf_ctx = NULL;
+
+    if (darling_bench_enabled(cached.name)) {
+        check_surface();
+    }
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.tile);
+    free(c.frame);
+}
@@ -0,0 +1,280 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Thumbnails: the 2x box-filter kernel halving a 4K frame against a
+// per-channel reference (and a bit-exactness check between the two on odd
+// widths), then a thumbnail request after a full rebuild of the pyramid,
+// after a small region paint, and with nothing dirty. A final check
+// compares a pyramid updated through many region paints with one built
+// from scratch.
+
+#define THUMB_W 3840u
+#define THUMB_H 2160u
+#define THUMB_OUT_W 320u
+#define THUMB_OUT_H 180u
+#define THUMB_REGION 128u
+
+typedef struct BoxCtx {
+    uint32_t* dst;
+    const uint32_t* src;
+} BoxCtx;
+
+typedef struct ThumbCtx {
+    DarlingWindow* win;
+    uint8_t* region;
+    uint8_t* out;
+    uint32_t tick;
+} ThumbCtx;
+
+static uint32_t ref_box4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    uint32_t out = 0;
+    for (uint32_t shift = 0; shift < 32u; shift += 8u) {
+        uint32_t sum = ((a >> shift) & 0xFFu) + ((b >> shift) & 0xFFu) + ((c >> shift) & 0xFFu) +
+            ((d >> shift) & 0xFFu);
+        out |= ((sum + 2u) >> 2) << shift;
+    }
+    return out;
+}
+
+// Rows of `sw` pixels halved to `dw`, the last column and row repeated
+// when odd
+static void ref_box2x(uint32_t* dst, const uint32_t* src, uint32_t sw, uint32_t sh) {
+    uint32_t dw = (sw + 1u) / 2u;
+    uint32_t dh = (sh + 1u) / 2u;
+
+    for (uint32_t y = 0; y < dh; y++) {
+        const uint32_t* r0 = src + (size_t)(2u * y) * sw;
+        const uint32_t* r1 = 2u * y + 1u < sh ? r0 + sw : r0;
+        for (uint32_t x = 0; x < dw; x++) {
+            uint32_t c0 = 2u * x;
+            uint32_t c1 = c0 + 1u < sw ? c0 + 1u : c0;
+            dst[(size_t)y * dw + x] = ref_box4(r0[c0], r0[c1], r1[c0], r1[c1]);
+        }
+    }
+}
+
+static void run_box_kernel(void* p, uint64_t n) {
+    BoxCtx* c = (BoxCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        for (uint32_t y = 0; y < THUMB_H / 2u; y++) {
+            const uint32_t* r0 = c->src + (size_t)(2u * y) * THUMB_W;
+            darling_frame_box2x_row(c->dst + (size_t)y * (THUMB_W / 2u), r0, r0 + THUMB_W, THUMB_W / 2u, THUMB_W);
+        }
+    }
+}
+
+static void run_box_reference(void* p, uint64_t n) {
+    BoxCtx* c = (BoxCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        ref_box2x(c->dst, c->src, THUMB_W, THUMB_H);
+    }
+}
+
+static void check_box(const uint32_t* src) {
+    static const uint32_t k_widths[] = { 1u, 2u, 7u, 8u, 9u, 17u, 255u, 1001u };
+    uint32_t* got = (uint32_t*)malloc(512u * 4u);
+    uint32_t* want = (uint32_t*)malloc(512u * 4u);
+    size_t mismatches = 0;
+
+    if (!got || !want) {
+        free(got);
+        free(want);
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(k_widths) / sizeof(k_widths[0]); i++) {
+        uint32_t sw = k_widths[i];
+        uint32_t dw = (sw + 1u) / 2u;
+
+        // Two rows of the frame read as one `sw`-wide, 2-row image
+        darling_frame_box2x_row(got, src, src + sw, dw, sw);
+        ref_box2x(want, src, sw, 2u);
+        for (uint32_t x = 0; x < dw; x++) {
+            mismatches += got[x] != want[x] ? 1u : 0u;
+        }
+    }
+
+    fprintf(stderr, "  check box2x against reference: %zu mismatched pixels\n", mismatches);
+    darling_bench_expect("thumbnail", "box2x against reference", mismatches == 0);
+    free(got);
+    free(want);
+}
+
+static void bench_box(void) {
+    size_t pixels = (size_t)THUMB_W * THUMB_H;
+    BoxCtx c;
+    uint32_t* src = (uint32_t*)malloc(pixels * 4u);
+    c.dst = (uint32_t*)malloc(pixels);
+    c.src = src;
+
+    if (!src || !c.dst) {
+        fprintf(stderr, "thumbnail suite: allocation failed\n");
+        free(src);
+        free(c.dst);
+        return;
+    }
+
+    darling_bench_fill(src, pixels * 4u, 51u);
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u}", THUMB_W, THUMB_H);
+    DarlingBenchCase kernel = { "thumbnail_box2x", params, run_box_kernel, &c, (double)pixels * 4.0, 0 };
+    darling_bench_run(&kernel);
+
+    DarlingBenchCase reference = { "thumbnail_box2x_reference", params, run_box_reference, &c, (double)pixels * 4.0, 0 };
+    darling_bench_run(&reference);
+
+    if (darling_bench_enabled(kernel.name)) {
+        check_box(src);
+    }
+
+    free(src);
+    free(c.dst);
+}
+
+static void run_rebuild(void* p, uint64_t n) {
+    ThumbCtx* c = (ThumbCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_release_thumbnails(c->win);
+        darling_get_thumbnail(c->win, c->out, THUMB_OUT_W, THUMB_OUT_H);
+    }
+}
+
+// A small region moving across the frame, as a cursor or caret would
+static void run_region_update(void* p, uint64_t n) {
+    ThumbCtx* c = (ThumbCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        uint32_t x = (c->tick * 97u) % (THUMB_W - THUMB_REGION);
+        uint32_t y = (c->tick * 61u) % (THUMB_H - THUMB_REGION);
+        c->tick++;
+        darling_paint_frame_window_region(c->win, c->region, x, y, THUMB_REGION, THUMB_REGION);
+        darling_get_thumbnail(c->win, c->out, THUMB_OUT_W, THUMB_OUT_H);
+    }
+}
+
+static void run_clean_request(void* p, uint64_t n) {
+    ThumbCtx* c = (ThumbCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_get_thumbnail(c->win, c->out, THUMB_OUT_W, THUMB_OUT_H);
+    }
+}
+
+// Paint scattered regions (more than the dirty list holds between some
+// requests), then compare every level with a fresh build
+static void check_incremental(ThumbCtx* c) {
+    DarlingThumbnailCache* t = &c->win->thumbnails;
+    size_t mismatches = 0;
+    size_t levelPixels = 0;
+    uint32_t seed = 54u;
+
+    for (uint32_t round = 0; round < 40u; round++) {
+        uint32_t paints = 1u + round % 11u;
+        for (uint32_t i = 0; i < paints; i++) {
+            uint32_t w = 1u + darling_bench_rand(&seed) % THUMB_REGION;
+            uint32_t h = 1u + darling_bench_rand(&seed) % THUMB_REGION;
+            uint32_t x = darling_bench_rand(&seed) % (THUMB_W - w);
+            uint32_t y = darling_bench_rand(&seed) % (THUMB_H - h);
+            darling_paint_frame_window_region(c->win, c->region, x, y, w, h);
+        }
+        darling_get_thumbnail(c->win, c->out, THUMB_OUT_W, THUMB_OUT_H);
+    }
+
+    DarlingThumbLevel kept[DARLING_THUMB_MAX_LEVELS];
+    uint32_t count = t->levelCount;
+    for (uint32_t i = 0; i < count; i++) {
+        size_t bytes = (size_t)t->levels[i].width * t->levels[i].height * 4u;
+        kept[i] = t->levels[i];
+        kept[i].pixels = (uint32_t*)malloc(bytes);
+        if (kept[i].pixels) {
+            memcpy(kept[i].pixels, t->levels[i].pixels, bytes);
+        }
+    }
+
+    darling_release_thumbnails(c->win);
+    darling_get_thumbnail(c->win, c->out, THUMB_OUT_W, THUMB_OUT_H);
+
+    for (uint32_t i = 0; i < count && i < t->levelCount; i++) {
+        size_t n = (size_t)kept[i].width * kept[i].height;
+        for (size_t k = 0; kept[i].pixels && k < n; k++) {
+            mismatches += kept[i].pixels[k] != t->levels[i].pixels[k] ? 1u : 0u;
+        }
+        levelPixels += n;
+        free(kept[i].pixels);
+    }
+
+    fprintf(stderr, "  check incremental against rebuild: %u levels, %zu of %zu pixels differ\n",
+        count, mismatches, levelPixels);
+    darling_bench_expect("thumbnail", "incremental against rebuild", mismatches == 0);
+}
+
+static void report_stats(DarlingWindow* win) {
+    DarlingThumbnailStats stats;
+    darling_get_thumbnail_stats(win, &stats);
+    fprintf(stderr, "  pyramid: %u levels from %ux%u, %.1f MB, %llu requests, %llu rebuilds, %llu level pixels updated\n",
+        stats.levels, stats.width, stats.height, (double)stats.bytes / (1024.0 * 1024.0),
+        (unsigned long long)stats.requests, (unsigned long long)stats.rebuilds,
+        (unsigned long long)stats.updatedPixels);
+}
+
+void darling_bench_suite_thumbnail(void) {
+    bench_box();
+
+    ThumbCtx c = { 0 };
+    size_t frameBytes = (size_t)THUMB_W * THUMB_H * 4u;
+    size_t regionBytes = (size_t)THUMB_REGION * THUMB_REGION * 4u;
+    uint8_t* frame = (uint8_t*)malloc(frameBytes);
+
+    c.region = (uint8_t*)malloc(regionBytes);
+    c.out = (uint8_t*)malloc((size_t)THUMB_OUT_W * THUMB_OUT_H * 4u);
+    c.win = darling_create_window(THUMB_W, THUMB_H, 0);
+
+    if (!frame || !c.region || !c.out || !c.win) {
+        fprintf(stderr, "thumbnail suite: allocation failed\n");
+        free(frame);
+        free(c.region);
+        free(c.out);
+        if (c.win) {
+            darling_destroy_window(c.win);
+        }
+        return;
+    }
+
+    darling_bench_fill(frame, frameBytes, 52u);
+    darling_bench_fill(c.region, regionBytes, 53u);
+    darling_paint_frame_window(c.win, frame, THUMB_W, THUMB_H);
+
+    char params[128];
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"thumbnail\":\"%ux%u\"}",
+        THUMB_W, THUMB_H, THUMB_OUT_W, THUMB_OUT_H);
+
+    DarlingBenchCase rebuild = { "thumbnail_rebuild", params, run_rebuild, &c, (double)frameBytes, 0 };
+    darling_bench_run(&rebuild);
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"thumbnail\":\"%ux%u\",\"region\":%u}",
+        THUMB_W, THUMB_H, THUMB_OUT_W, THUMB_OUT_H, THUMB_REGION);
+    DarlingBenchCase update = { "thumbnail_region_update", params, run_region_update, &c, (double)regionBytes, 0 };
+    darling_bench_run(&update);
+    if (darling_bench_enabled(update.name)) {
+        report_stats(c.win);
+    }
+
+    snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"thumbnail\":\"%ux%u\"}",
+        THUMB_W, THUMB_H, THUMB_OUT_W, THUMB_OUT_H);
+    DarlingBenchCase clean = { "thumbnail_clean_request", params, run_clean_request, &c,
+        (double)THUMB_OUT_W * THUMB_OUT_H * 4.0, 0 };
+    darling_bench_run(&clean);
+
+    if (darling_bench_enabled(update.name)) {
+        check_incremental(&c);
+    }
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(frame);
+    free(c.region);
+    free(c.out);
+}
@@ -0,0 +1,125 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Frame timing: cost of the per-frame pipeline hooks on their own, and a
+// full paint + dispatch loop with and without the FPS/latency overlay,
+// reporting the per-stage latency summary the histograms collected.
+
+#define TIMING_W 1280u
+#define TIMING_H 720u
+
+typedef struct TimingCtx {
+    DarlingWindow* win;
+    uint8_t* src;
+    uint64_t frameId;
+} TimingCtx;
+
+static void run_hooks(void* p, uint64_t n) {
+    TimingCtx* c = (TimingCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        darling_timing_begin(c->win);
+        darling_timing_stamp(c->win, DARLING_STAGE_COPIED);
+        darling_timing_stamp(c->win, DARLING_STAGE_INVALIDATED);
+        darling_timing_paint_start(c->win);
+        darling_timing_presented(c->win);
+    }
+}
+
+static void run_pipeline(void* p, uint64_t n) {
+    TimingCtx* c = (TimingCtx*)p;
+
+    for (uint64_t i = 0; i < n; i++) {
+        darling_frame_tag(c->win, ++c->frameId, darling_input_now());
+        darling_paint_frame_window(c->win, c->src, TIMING_W, TIMING_H);
+        darling_poll_events();
+    }
+}
+
+static void report_timing(DarlingWindow* win) {
+    static const char* k_spans[DARLING_LATENCY_SPAN_COUNT] = {
+        "producer", "copy", "invalidate", "queue", "blit", "total"
+    };
+
+    DarlingFrameTimingStats stats;
+    darling_get_frame_timing(win, &stats);
+
+    fprintf(stderr, "  presented %llu, superseded %llu\n",
+        (unsigned long long)stats.presented, (unsigned long long)stats.superseded);
+
+    for (uint32_t i = 0; i < DARLING_LATENCY_SPAN_COUNT; i++) {
+        const DarlingLatencySummary* s = &stats.spans[i];
+        fprintf(stderr, "  %-10s mean %8.4f  p50 %8.4f  p99 %8.4f  max %8.4f ms\n",
+            k_spans[i], s->mean, s->p50, s->p99, s->max);
+    }
+}
+
+// A tagged frame can be read back once presented, a replaced one as superseded
+static void check_records(TimingCtx* c) {
+    DarlingFrameRecord record;
+
+    darling_frame_tag(c->win, 1000001u, 0.0);
+    darling_paint_frame_window(c->win, c->src, TIMING_W, TIMING_H);
+    darling_frame_tag(c->win, 1000002u, 0.0);
+    darling_paint_frame_window(c->win, c->src, TIMING_W, TIMING_H);
+    int pending = darling_get_frame_record(c->win, 1000002u, &record);
+    darling_poll_events();
+
+    int replaced = darling_get_frame_record(c->win, 1000001u, &record) &&
+        record.stamps[DARLING_STAGE_PRESENTED] == 0.0;
+    int presented = darling_get_frame_record(c->win, 1000002u, &record) &&
+        record.stamps[DARLING_STAGE_PRESENTED] >= record.stamps[DARLING_STAGE_PAINT_START] &&
+        record.stamps[DARLING_STAGE_PAINT_START] >= record.stamps[DARLING_STAGE_INVALIDATED];
+
+    fprintf(stderr, "  records: in flight hidden %s, replaced %s, presented %s\n",
+        pending ? "NO" : "yes", replaced ? "yes" : "NO", presented ? "yes" : "NO");
+    darling_bench_expect("records", "lifecycle", !pending && replaced && presented);
+}
+
+void darling_bench_suite_timing(void) {
+    TimingCtx c = { 0 };
+    size_t bytes = (size_t)TIMING_W * TIMING_H * 4u;
+
+    c.src = (uint8_t*)malloc(bytes);
+    c.win = darling_create_window(TIMING_W, TIMING_H, 0);
+
+    if (!c.src || !c.win) {
+        fprintf(stderr, "timing suite: allocation failed\n");
+        free(c.src);
+        if (c.win) {
+            darling_destroy_window(c.win);
+        }
+        return;
+    }
+
+    darling_bench_fill(c.src, bytes, 7u);
+
+    DarlingBenchCase hooks = { "frame_timing_hooks", "{}", run_hooks, &c, 0, 1 };
+    darling_bench_run(&hooks);
+
+    for (int overlay = 0; overlay <= 1; overlay++) {
+        char params[96];
+        snprintf(params, sizeof(params), "{\"width\":%u,\"height\":%u,\"overlay\":%d}", TIMING_W, TIMING_H, overlay);
+
+        darling_set_frame_overlay(c.win, overlay);
+        darling_reset_frame_timing(c.win);
+
+        DarlingBenchCase pipeline = { "frame_pipeline", params, run_pipeline, &c, (double)bytes, 0 };
+        darling_bench_run(&pipeline);
+
+        if (darling_bench_enabled(pipeline.name)) {
+            report_timing(c.win);
+        }
+    }
+
+    if (darling_bench_enabled("frame_pipeline")) {
+        check_records(&c);
+    }
+
+    darling_destroy_window(c.win);
+    darling_poll_events();
+    free(c.src);
+}
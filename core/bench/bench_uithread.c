@@ -0,0 +1,206 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// UI thread: the round trip of one posted task (wake, run, observed done by
+// the poster), a burst of tasks per wake, and window setup (create, a
+// batched appearance update, destroy) done inline before some caller work
+// against the same setup posted to the UI thread while the caller works.
+// Headless setup costs less than a wake, so overlapping it loses here; on
+// Win32, where creating a window takes milliseconds, the wake is noise.
+// A final check posts from several threads at once and verifies that each
+// poster's tasks ran once each, in its order.
+
+#define UI_BURST 64u
+#define UI_CALLER_WORK_NS 20000u
+#define UI_CHECK_POSTERS 4u
+#define UI_CHECK_TASKS 200000u
+
+typedef struct UiCtx {
+    volatile int32_t done;
+    volatile uint32_t sink;
+} UiCtx;
+
+static void task_mark(void* p) {
+    UiCtx* c = (UiCtx*)p;
+    __atomic_add_fetch(&c->done, 1, __ATOMIC_RELEASE);
+}
+
+static void wait_done(UiCtx* c, int32_t target) {
+    while (__atomic_load_n(&c->done, __ATOMIC_ACQUIRE) < target) {
+        darling_thread_yield();
+    }
+}
+
+static void run_roundtrip(void* p, uint64_t n) {
+    UiCtx* c = (UiCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->done = 0;
+        darling_ui_post(task_mark, c);
+        wait_done(c, 1);
+    }
+}
+
+static void run_burst(void* p, uint64_t n) {
+    UiCtx* c = (UiCtx*)p;
+    for (uint64_t i = 0; i < n; i += UI_BURST) {
+        c->done = 0;
+        for (uint32_t k = 0; k < UI_BURST; k++) {
+            darling_ui_post(task_mark, c);
+        }
+        wait_done(c, (int32_t)UI_BURST);
+    }
+}
+
+// Stands in for JavaScript the caller runs meanwhile (e.g. building the
+// BrowserWindow)
+static void caller_work(UiCtx* c) {
+    uint64_t end = darling_bench_now_ns() + UI_CALLER_WORK_NS;
+    uint32_t acc = c->sink;
+    while (darling_bench_now_ns() < end) {
+        acc = acc * 1664525u + 1013904223u;
+    }
+    c->sink = acc;
+}
+
+static void task_window_setup(void* p) {
+    UiCtx* c = (UiCtx*)p;
+    DarlingWindow* win = darling_create_window(1280, 720, 0);
+
+    darling_begin_appearance_update(win);
+    darling_set_dark_mode(win, 1);
+    darling_set_titlebar_colors(win, 0x202020FFu, 0xFFFFFFFFu);
+    darling_set_corner_preference(win, DARLING_CORNER_LARGE);
+    darling_commit_appearance_update(win);
+    darling_show_window(win);
+    darling_destroy_window(win);
+
+    __atomic_add_fetch(&c->done, 1, __ATOMIC_RELEASE);
+}
+
+static void run_setup_inline(void* p, uint64_t n) {
+    UiCtx* c = (UiCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->done = 0;
+        task_window_setup(c);
+        caller_work(c);
+        darling_poll_events();
+    }
+}
+
+static void run_setup_overlapped(void* p, uint64_t n) {
+    UiCtx* c = (UiCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        c->done = 0;
+        darling_ui_post(task_window_setup, c);
+        caller_work(c);
+        wait_done(c, 1);
+        darling_poll_events();
+    }
+}
+
+// Order check: task i of poster k carries (k, i); the UI thread keeps the
+// last index run per poster
+typedef struct UiOrderCheck {
+    uint32_t next[UI_CHECK_POSTERS];
+    uint64_t outOfOrder;
+    volatile int32_t done;
+} UiOrderCheck;
+
+typedef struct UiOrderTask {
+    UiOrderCheck* check;
+    uint32_t poster;
+    uint32_t index;
+} UiOrderTask;
+
+typedef struct UiPoster {
+    UiOrderCheck* check;
+    UiOrderTask* tasks;
+    uint32_t poster;
+    uint32_t failed;
+} UiPoster;
+
+static void task_order(void* p) {
+    UiOrderTask* t = (UiOrderTask*)p;
+    UiOrderCheck* check = t->check;
+
+    // Only the UI thread touches next[] and outOfOrder
+    check->outOfOrder += check->next[t->poster] != t->index ? 1u : 0u;
+    check->next[t->poster] = t->index + 1u;
+    __atomic_add_fetch(&check->done, 1, __ATOMIC_RELEASE);
+}
+
+static void* order_poster(void* p) {
+    UiPoster* poster = (UiPoster*)p;
+    for (uint32_t i = 0; i < UI_CHECK_TASKS; i++) {
+        UiOrderTask* t = &poster->tasks[i];
+        t->check = poster->check;
+        t->poster = poster->poster;
+        t->index = i;
+        poster->failed += darling_ui_post(task_order, t) ? 0u : 1u;
+    }
+    return NULL;
+}
+
+static void check_order(void) {
+    UiOrderCheck check = { { 0 }, 0, 0 };
+    UiPoster posters[UI_CHECK_POSTERS];
+    pthread_t threads[UI_CHECK_POSTERS];
+    UiOrderTask* tasks = (UiOrderTask*)malloc((size_t)UI_CHECK_POSTERS * UI_CHECK_TASKS * sizeof(UiOrderTask));
+    uint32_t failed = 0;
+
+    if (!tasks) {
+        return;
+    }
+
+    for (uint32_t k = 0; k < UI_CHECK_POSTERS; k++) {
+        posters[k] = (UiPoster){ &check, tasks + (size_t)k * UI_CHECK_TASKS, k, 0 };
+        pthread_create(&threads[k], NULL, order_poster, &posters[k]);
+    }
+    for (uint32_t k = 0; k < UI_CHECK_POSTERS; k++) {
+        pthread_join(threads[k], NULL);
+        failed += posters[k].failed;
+    }
+
+    while (__atomic_load_n(&check.done, __ATOMIC_ACQUIRE) < (int32_t)(UI_CHECK_POSTERS * UI_CHECK_TASKS - failed)) {
+        darling_thread_yield();
+    }
+
+    uint32_t missing = 0;
+    for (uint32_t k = 0; k < UI_CHECK_POSTERS; k++) {
+        missing += UI_CHECK_TASKS - check.next[k];
+    }
+
+    DarlingUiThreadStats stats;
+    darling_get_ui_thread_stats(&stats);
+    fprintf(stderr, "  check order: %u posters x %u tasks, %u refused, %u missing, %llu out of order, peak queue %u\n",
+        UI_CHECK_POSTERS, UI_CHECK_TASKS, failed, missing, (unsigned long long)check.outOfOrder, stats.peak);
+    darling_bench_expect("order", "every task run in order", missing == 0 && check.outOfOrder == 0);
+    free(tasks);
+}
+
+void darling_bench_suite_uithread(void) {
+    UiCtx c = { 0, 0 };
+
+    DarlingBenchCase roundtrip = { "ui_post_roundtrip", "{}", run_roundtrip, &c, 0, 1 };
+    darling_bench_run(&roundtrip);
+
+    char params[64];
+    snprintf(params, sizeof(params), "{\"burst\":%u}", UI_BURST);
+    DarlingBenchCase burst = { "ui_post_burst", params, run_burst, &c, 0, 1 };
+    darling_bench_run(&burst);
+
+    snprintf(params, sizeof(params), "{\"callerWorkUs\":%u}", UI_CALLER_WORK_NS / 1000u);
+    DarlingBenchCase inlineSetup = { "ui_window_setup_inline", params, run_setup_inline, &c, 0, 1 };
+    darling_bench_run(&inlineSetup);
+
+    DarlingBenchCase overlapped = { "ui_window_setup_overlapped", params, run_setup_overlapped, &c, 0, 1 };
+    darling_bench_run(&overlapped);
+
+    if (darling_bench_enabled(roundtrip.name)) {
+        check_order();
+    }
+}
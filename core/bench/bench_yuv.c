@@ -0,0 +1,287 @@
+#include "bench.h"
+#include "darling.h"
+#include "platform/headless/impl/internal.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// YUV conversion: I420 and NV12 to BGRA at 1080p and 4K, scaled to a
+// different client size in the same pass, and a floating-point per-pixel
+// reference for comparison, then a check of every matrix, range and
+// layout against that reference on odd-sized frames. The check frames are
+// noise, the worst case for scaling: 1/256 filter weights move a
+// resampled sample by up to a step, and the chroma gains (about 2) double
+// that. A pixel with a channel off by more than the tolerance fails.
+
+#define YUV_TOLERANCE 1u            // at the frame's own size: rounding only
+#define YUV_TOLERANCE_SCALED 5u     // a step of luma and of chroma through its gain, rounded twice
+
+#define YUV_MAX_W 3840u
+#define YUV_MAX_H 2160u
+
+typedef struct YuvCtx {
+    DarlingYuvFrame frame;
+    uint8_t* dst;
+    uint32_t dstWidth;
+    uint32_t dstHeight;
+} YuvCtx;
+
+typedef struct YuvPlanes {
+    uint8_t* y;
+    uint8_t* u;
+    uint8_t* v;
+    uint8_t* uv;
+} YuvPlanes;
+
+static uint8_t ref_clamp(double x) {
+    x = floor(x + 0.5);
+    return (uint8_t)(x < 0.0 ? 0.0 : x > 255.0 ? 255.0 : x);
+}
+
+// Exact conversion of one sample in double precision
+static uint32_t ref_pixel(double y, double u, double v, uint32_t matrix, uint32_t range) {
+    double kr = matrix == DARLING_YUV_BT709 ? 0.2126 : 0.299;
+    double kb = matrix == DARLING_YUV_BT709 ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+
+    if (range == DARLING_YUV_LIMITED) {
+        y = (y - 16.0) * 255.0 / 219.0;
+        u = (u - 128.0) * 255.0 / 224.0;
+        v = (v - 128.0) * 255.0 / 224.0;
+    } else {
+        u -= 128.0;
+        v -= 128.0;
+    }
+
+    uint32_t r = ref_clamp(y + 2.0 * (1.0 - kr) * v);
+    uint32_t g = ref_clamp(y - 2.0 * (1.0 - kb) * kb / kg * u - 2.0 * (1.0 - kr) * kr / kg * v);
+    uint32_t b = ref_clamp(y + 2.0 * (1.0 - kb) * u);
+    return 0xFF000000u | (r << 16) | (g << 8) | b;
+}
+
+// Plane sample `i` of `n` at destination sample `d` of `dn`, centers aligned
+static double ref_coord(uint32_t d, uint32_t dn, uint32_t n, uint32_t* i0, uint32_t* i1) {
+    double pos = ((double)d + 0.5) * n / dn - 0.5;
+    if (pos < 0.0) {
+        pos = 0.0;
+    }
+    *i0 = (uint32_t)pos;
+    *i1 = *i0 + 1u < n ? *i0 + 1u : *i0;
+    return pos - *i0;
+}
+
+static double ref_sample(const uint8_t* plane, size_t stride, size_t step, uint32_t x, uint32_t xn, uint32_t w,
+    uint32_t y, uint32_t yn, uint32_t h) {
+    uint32_t x0, x1, y0, y1;
+    double fx = ref_coord(x, xn, w, &x0, &x1);
+    double fy = ref_coord(y, yn, h, &y0, &y1);
+    const uint8_t* r0 = plane + y0 * stride;
+    const uint8_t* r1 = plane + y1 * stride;
+    double a = r0[x0 * step] * (1.0 - fx) + r0[x1 * step] * fx;
+    double b = r1[x0 * step] * (1.0 - fx) + r1[x1 * step] * fx;
+
+    // Resampled planes are 8-bit, as from any separate scaler
+    return floor(a * (1.0 - fy) + b * fy + 0.5);
+}
+
+// Reference frame: chroma replicated at the frame's size, everything
+// bilinear when scaled
+static void ref_convert(uint32_t* dst, uint32_t dw, uint32_t dh, const DarlingYuvFrame* f) {
+    BOOL nv12 = f->layout == DARLING_YUV_NV12;
+    const uint8_t* u = f->planes[1];
+    const uint8_t* v = nv12 ? f->planes[1] + 1 : f->planes[2];
+    size_t vStride = nv12 ? f->strides[1] : f->strides[2];
+    size_t step = nv12 ? 2u : 1u;
+    uint32_t cw = (f->width + 1u) / 2u;
+    uint32_t ch = (f->height + 1u) / 2u;
+
+    for (uint32_t y = 0; y < dh; y++) {
+        for (uint32_t x = 0; x < dw; x++) {
+            double ys, us, vs;
+            if (dw == f->width && dh == f->height) {
+                ys = f->planes[0][(size_t)y * f->strides[0] + x];
+                us = u[(size_t)(y / 2u) * f->strides[1] + (x / 2u) * step];
+                vs = v[(size_t)(y / 2u) * vStride + (x / 2u) * step];
+            } else {
+                ys = ref_sample(f->planes[0], f->strides[0], 1, x, dw, f->width, y, dh, f->height);
+                us = ref_sample(u, f->strides[1], step, x, dw, cw, y, dh, ch);
+                vs = ref_sample(v, vStride, step, x, dw, cw, y, dh, ch);
+            }
+            dst[(size_t)y * dw + x] = ref_pixel(ys, us, vs, f->matrix, f->range);
+        }
+    }
+}
+
+static void set_frame(DarlingYuvFrame* f, const YuvPlanes* p, uint32_t w, uint32_t h, uint32_t layout,
+    uint32_t matrix, uint32_t range) {
+    uint32_t cw = (w + 1u) / 2u;
+
+    memset(f, 0, sizeof(*f));
+    f->width = w;
+    f->height = h;
+    f->layout = layout;
+    f->matrix = matrix;
+    f->range = range;
+    f->planes[0] = p->y;
+    f->strides[0] = w;
+    if (layout == DARLING_YUV_NV12) {
+        f->planes[1] = p->uv;
+        f->strides[1] = cw * 2u;
+    } else {
+        f->planes[1] = p->u;
+        f->planes[2] = p->v;
+        f->strides[1] = cw;
+        f->strides[2] = cw;
+    }
+}
+
+static void run_convert(void* p, uint64_t n) {
+    YuvCtx* c = (YuvCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        darling_yuv_convert(c->dst, (size_t)c->dstWidth * 4u, c->dstWidth, c->dstHeight, &c->frame);
+    }
+}
+
+static void run_reference(void* p, uint64_t n) {
+    YuvCtx* c = (YuvCtx*)p;
+    for (uint64_t i = 0; i < n; i++) {
+        ref_convert((uint32_t*)c->dst, c->dstWidth, c->dstHeight, &c->frame);
+    }
+}
+
+typedef struct YuvError {
+    uint32_t max;
+    uint64_t sum;                   // over every channel compared
+    uint64_t channels;
+    uint64_t outside;               // pixels with a channel off by more than the tolerance
+} YuvError;
+
+static void compare(const uint32_t* a, const uint32_t* b, size_t count, uint32_t tolerance, YuvError* err) {
+    for (size_t i = 0; i < count; i++) {
+        BOOL over = FALSE;
+        for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+            int32_t d = (int32_t)((a[i] >> shift) & 0xFFu) - (int32_t)((b[i] >> shift) & 0xFFu);
+            uint32_t diff = (uint32_t)(d < 0 ? -d : d);
+            err->max = diff > err->max ? diff : err->max;
+            err->sum += diff;
+            over |= diff > tolerance;
+        }
+        err->channels += 3u;
+        err->outside += over ? 1u : 0u;
+    }
+}
+
+static void check_reference(const YuvPlanes* p) {
+    static const uint32_t k_sizes[][4] = {
+        { 321u, 179u, 321u, 179u },     // odd, at its own size
+        { 321u, 179u, 640u, 360u },     // upscaled
+        { 640u, 360u, 257u, 143u }      // downscaled
+    };
+    size_t maxPixels = 640u * 360u;
+    uint32_t* got = (uint32_t*)malloc(maxPixels * 4u);
+    uint32_t* want = (uint32_t*)malloc(maxPixels * 4u);
+    if (!got || !want) {
+        free(got);
+        free(want);
+        return;
+    }
+
+    for (size_t s = 0; s < sizeof(k_sizes) / sizeof(k_sizes[0]); s++) {
+        YuvError err;
+        memset(&err, 0, sizeof(err));
+        uint32_t dw = k_sizes[s][2];
+        uint32_t dh = k_sizes[s][3];
+        uint32_t tolerance = dw == k_sizes[s][0] && dh == k_sizes[s][1] ? YUV_TOLERANCE : YUV_TOLERANCE_SCALED;
+
+        for (uint32_t layout = 0; layout < 2u; layout++) {
+            for (uint32_t matrix = 0; matrix < 2u; matrix++) {
+                for (uint32_t range = 0; range < 2u; range++) {
+                    DarlingYuvFrame f;
+                    set_frame(&f, p, k_sizes[s][0], k_sizes[s][1], layout, matrix, range);
+                    darling_yuv_convert((uint8_t*)got, (size_t)dw * 4u, dw, dh, &f);
+                    ref_convert(want, dw, dh, &f);
+                    compare(got, want, (size_t)dw * dh, tolerance, &err);
+                }
+            }
+        }
+
+        fprintf(stderr, "  check %ux%u -> %ux%u: max channel error %u, mean %.3f, %llu pixels off by more than %u (8 variants)\n",
+            k_sizes[s][0], k_sizes[s][1], dw, dh, err.max, (double)err.sum / (double)err.channels,
+            (unsigned long long)err.outside, tolerance);
+        darling_bench_expect("yuv", "within tolerance of the reference", err.outside == 0);
+    }
+
+    free(got);
+    free(want);
+}
+
+void darling_bench_suite_yuv(void) {
+    static const uint32_t k_cases[][4] = {
+        { 1920u, 1080u, 1920u, 1080u },
+        { 3840u, 2160u, 3840u, 2160u },
+        { 1920u, 1080u, 2560u, 1440u },
+        { 3840u, 2160u, 1920u, 1080u }
+    };
+    static const char* k_layouts[] = { "i420", "nv12" };
+
+    size_t lumaBytes = (size_t)YUV_MAX_W * YUV_MAX_H;
+    YuvPlanes p;
+    YuvCtx c;
+    memset(&c, 0, sizeof(c));
+
+    p.y = (uint8_t*)malloc(lumaBytes);
+    p.u = (uint8_t*)malloc(lumaBytes / 4u);
+    p.v = (uint8_t*)malloc(lumaBytes / 4u);
+    p.uv = (uint8_t*)malloc(lumaBytes / 2u);
+    c.dst = (uint8_t*)malloc(lumaBytes * 4u);
+    if (!p.y || !p.u || !p.v || !p.uv || !c.dst) {
+        fprintf(stderr, "yuv suite: allocation failed\n");
+        free(p.y);
+        free(p.u);
+        free(p.v);
+        free(p.uv);
+        free(c.dst);
+        return;
+    }
+
+    darling_bench_fill(p.y, lumaBytes, 41u);
+    darling_bench_fill(p.u, lumaBytes / 4u, 42u);
+    darling_bench_fill(p.v, lumaBytes / 4u, 43u);
+    darling_bench_fill(p.uv, lumaBytes / 2u, 44u);
+
+    for (size_t s = 0; s < sizeof(k_cases) / sizeof(k_cases[0]); s++) {
+        for (uint32_t layout = 0; layout < 2u; layout++) {
+            char params[160];
+            set_frame(&c.frame, &p, k_cases[s][0], k_cases[s][1], layout, DARLING_YUV_BT709, DARLING_YUV_LIMITED);
+            c.dstWidth = k_cases[s][2];
+            c.dstHeight = k_cases[s][3];
+            snprintf(params, sizeof(params),
+                "{\"width\":%u,\"height\":%u,\"layout\":\"%s\",\"dstWidth\":%u,\"dstHeight\":%u}",
+                c.frame.width, c.frame.height, k_layouts[layout], c.dstWidth, c.dstHeight);
+
+            DarlingBenchCase convert = { "yuv_convert", params, run_convert, &c,
+                (double)c.dstWidth * c.dstHeight * 4.0, 0 };
+            darling_bench_run(&convert);
+        }
+    }
+
+    // The same 1080p frame through the double-precision reference
+    char params[128];
+    set_frame(&c.frame, &p, 1920u, 1080u, DARLING_YUV_I420, DARLING_YUV_BT709, DARLING_YUV_LIMITED);
+    c.dstWidth = 1920u;
+    c.dstHeight = 1080u;
+    snprintf(params, sizeof(params), "{\"width\":1920,\"height\":1080,\"layout\":\"i420\"}");
+    DarlingBenchCase reference = { "yuv_reference", params, run_reference, &c, 1920.0 * 1080.0 * 4.0, 0 };
+    darling_bench_run(&reference);
+
+    if (darling_bench_enabled("yuv_convert")) {
+        check_reference(&p);
+    }
+
+    free(p.y);
+    free(p.u);
+    free(p.v);
+    free(p.uv);
+    free(c.dst);
+}
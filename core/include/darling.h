@@ -1,4 +1,5 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef _WIN32
@@ -17,6 +18,13 @@ extern "C" {
 
 typedef struct DarlingWindow DarlingWindow;
 typedef void (*DarlingCloseCallbackHWND)(uintptr_t hwnd);
+typedef void (*DarlingDpiChangedCallback)(uintptr_t hwnd, uint32_t dpi);
+typedef void (*DarlingFrameRequestCallback)(uintptr_t hwnd);
+typedef void (*DarlingUiTask)(void* ctx);
+typedef void (*DarlingTileRequestCallback)(uintptr_t hwnd, const int32_t* tiles, uint32_t count);
+typedef void (*DarlingVisibilityCallback)(uintptr_t hwnd, uint32_t visibility, uint32_t throttled, uint32_t rate);
+typedef void (*DarlingAnimationCallback)(uintptr_t hwnd, uint32_t id, uint32_t property, uint32_t finished);
+typedef double (*DarlingClock)(void* ctx);
 
 typedef enum DarlingCornerPreference {
     DARLING_CORNER_DEFAULT = 0,
@@ -25,6 +33,425 @@ typedef enum DarlingCornerPreference {
     DARLING_CORNER_LARGE = 3
 } DarlingCornerPreference;
 
+typedef enum DarlingPixelFormat {
+    DARLING_PIXEL_FORMAT_BGRA8 = 0,
+    DARLING_PIXEL_FORMAT_RGBA8 = 1,
+    DARLING_PIXEL_FORMAT_BGRA8_PREMULTIPLIED = 2
+} DarlingPixelFormat;
+
+// How a window's backing store reaches the screen
+typedef enum DarlingPresentMode {
+    DARLING_PRESENT_OPAQUE = 0,             // painted; alpha is ignored
+    DARLING_PRESENT_PER_PIXEL_ALPHA = 1     // premultiplied, a per-pixel-alpha layered window
+} DarlingPresentMode;
+
+typedef enum DarlingYuvLayout {
+    DARLING_YUV_I420 = 0,           // Y plane, then U and V planes
+    DARLING_YUV_NV12 = 1            // Y plane, then one plane of interleaved U,V pairs
+} DarlingYuvLayout;
+
+typedef enum DarlingYuvMatrix {
+    DARLING_YUV_BT601 = 0,          // SD video
+    DARLING_YUV_BT709 = 1           // HD video
+} DarlingYuvMatrix;
+
+typedef enum DarlingYuvRange {
+    DARLING_YUV_LIMITED = 0,        // Y 16-235, U and V 16-240 (broadcast video)
+    DARLING_YUV_FULL = 1            // 0-255 (JPEG, most screen capture)
+} DarlingYuvRange;
+
+typedef enum DarlingLayoutKind {
+    DARLING_LAYOUT_LEAF = 0,        // holds one child window
+    DARLING_LAYOUT_SPLIT_H = 1,     // children side by side, left to right
+    DARLING_LAYOUT_SPLIT_V = 2,     // children top to bottom
+    DARLING_LAYOUT_STACK = 3        // children overlap; only the active one is shown
+} DarlingLayoutKind;
+
+// What a point in a custom titlebar drawn in web content does
+typedef enum DarlingHitKind {
+    DARLING_HIT_CLIENT = 0,         // passthrough to the content (e.g. tabs)
+    DARLING_HIT_CAPTION = 1,        // drag area
+    DARLING_HIT_MINIMIZE = 2,
+    DARLING_HIT_MAXIMIZE = 3,
+    DARLING_HIT_CLOSE = 4,
+    DARLING_HIT_LEFT = 5,           // resize edges and corners
+    DARLING_HIT_RIGHT = 6,
+    DARLING_HIT_TOP = 7,
+    DARLING_HIT_BOTTOM = 8,
+    DARLING_HIT_TOP_LEFT = 9,
+    DARLING_HIT_TOP_RIGHT = 10,
+    DARLING_HIT_BOTTOM_LEFT = 11,
+    DARLING_HIT_BOTTOM_RIGHT = 12
+} DarlingHitKind;
+
+// Hit region edges measured from the right/bottom of the client area
+// instead of the left/top (flags)
+typedef enum DarlingHitAnchor {
+    DARLING_HIT_ANCHOR_NONE = 0,
+    DARLING_HIT_LEFT_FROM_RIGHT = 1,
+    DARLING_HIT_TOP_FROM_BOTTOM = 2,
+    DARLING_HIT_RIGHT_FROM_RIGHT = 4,
+    DARLING_HIT_BOTTOM_FROM_BOTTOM = 8
+} DarlingHitAnchor;
+
+typedef enum DarlingInputType {
+    DARLING_INPUT_MOUSE_MOVE = 1,
+    DARLING_INPUT_MOUSE_DOWN = 2,   // code = button (0 left, 1 right, 2 middle, 3/4 X1/X2)
+    DARLING_INPUT_MOUSE_UP = 3,
+    DARLING_INPUT_WHEEL = 4,        // value = delta, 120 per notch
+    DARLING_INPUT_HWHEEL = 5,
+    DARLING_INPUT_KEY_DOWN = 6,     // code = virtual key, value = scan code
+    DARLING_INPUT_KEY_UP = 7,
+    DARLING_INPUT_CHAR = 8,         // code = UTF-16 code unit
+    DARLING_INPUT_TOUCH_DOWN = 9,   // code = pointer id
+    DARLING_INPUT_TOUCH_MOVE = 10,
+    DARLING_INPUT_TOUCH_UP = 11,
+    DARLING_INPUT_MOUSE_LEAVE = 12
+} DarlingInputType;
+
+// Modifier and state bits in DarlingInputEvent.modifiers
+#define DARLING_INPUT_MOD_SHIFT     0x0001u
+#define DARLING_INPUT_MOD_CTRL      0x0002u
+#define DARLING_INPUT_MOD_ALT       0x0004u
+#define DARLING_INPUT_MOD_META      0x0008u
+#define DARLING_INPUT_BUTTON_LEFT   0x0010u     // buttons held during the event
+#define DARLING_INPUT_BUTTON_RIGHT  0x0020u
+#define DARLING_INPUT_BUTTON_MIDDLE 0x0040u
+#define DARLING_INPUT_KEY_REPEAT    0x0100u
+#define DARLING_INPUT_FROM_TOUCH    0x0200u     // mouse event synthesized from touch or pen
+
+// One input event, 32 bytes. Pointer positions are client pixels.
+typedef struct DarlingInputEvent {
+    double time;                    // ms on the darling_input_now clock
+    uint32_t type;                  // DarlingInputType
+    uint32_t modifiers;
+    int32_t x;
+    int32_t y;
+    int32_t code;
+    int32_t value;
+} DarlingInputEvent;
+
+typedef struct DarlingInputStats {
+    uint32_t capacity;              // events the ring holds (0 = no ring)
+    uint32_t pending;               // written but not read yet
+    uint32_t written;               // total written (wraps at 2^32)
+    uint32_t dropped;               // lost because the ring was full (wraps)
+} DarlingInputStats;
+
+// Window state bits in DarlingWindowState.flags
+typedef enum DarlingWindowStateFlags {
+    DARLING_STATE_VISIBLE = 1 << 0,
+    DARLING_STATE_FOCUSED = 1 << 1,
+    DARLING_STATE_MINIMIZED = 1 << 2,
+    DARLING_STATE_MAXIMIZED = 1 << 3,
+    DARLING_STATE_DARK = 1 << 4
+} DarlingWindowStateFlags;
+
+// A window's state as mirrored for lock-free readers. Sizes and positions
+// are physical pixels; x, y, width and height are the outer window rect.
+typedef struct DarlingWindowState {
+    uint32_t flags;                 // DarlingWindowStateFlags
+    uint32_t dpi;
+    int32_t clientWidth;
+    int32_t clientHeight;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+    uint32_t updates;               // records written since the mirror was attached
+} DarlingWindowState;
+
+// Stages of a frame's trip through the paint pipeline
+typedef enum DarlingFrameStage {
+    DARLING_STAGE_SUBMIT = 0,           // producer submitted it (darling_frame_tag), else = ENTRY
+    DARLING_STAGE_ENTRY = 1,            // paint call entered
+    DARLING_STAGE_COPIED = 2,           // pixels are in the backing store
+    DARLING_STAGE_INVALIDATED = 3,      // repaint requested
+    DARLING_STAGE_PAINT_START = 4,      // WM_PAINT began
+    DARLING_STAGE_PRESENTED = 5,        // blit to the window complete
+    DARLING_STAGE_COUNT = 6
+} DarlingFrameStage;
+
+// Latency histograms kept per window, each between two stages
+typedef enum DarlingLatencySpan {
+    DARLING_LATENCY_PRODUCER = 0,       // SUBMIT -> ENTRY
+    DARLING_LATENCY_COPY = 1,           // ENTRY -> COPIED
+    DARLING_LATENCY_INVALIDATE = 2,     // COPIED -> INVALIDATED (includes the overlay)
+    DARLING_LATENCY_QUEUE = 3,          // INVALIDATED -> PAINT_START (message loop)
+    DARLING_LATENCY_BLIT = 4,           // PAINT_START -> PRESENTED
+    DARLING_LATENCY_TOTAL = 5,          // SUBMIT -> PRESENTED
+    DARLING_LATENCY_SPAN_COUNT = 6
+} DarlingLatencySpan;
+
+typedef struct DarlingFrameRecord {
+    uint64_t frameId;
+    double stamps[DARLING_STAGE_COUNT]; // ms on the darling_input_now clock;
+                                        // PRESENTED is 0 if a newer frame replaced it
+} DarlingFrameRecord;
+
+typedef struct DarlingLatencySummary {
+    uint64_t count;
+    double mean;                        // ms
+    double p50;                         // percentiles are bucket upper bounds (<= max)
+    double p90;
+    double p99;
+    double max;
+} DarlingLatencySummary;
+
+typedef struct DarlingFrameTimingStats {
+    uint64_t presented;                 // frames that reached the screen
+    uint64_t superseded;                // frames replaced before they were presented
+    double fps;                         // presents over the last second
+    DarlingLatencySummary spans[DARLING_LATENCY_SPAN_COUNT];
+} DarlingFrameTimingStats;
+
+// Layer compositor counters for one window
+typedef struct DarlingCompositorStats {
+    uint32_t layers;                    // live layers
+    uint32_t damageRects;               // rectangles waiting for the next paint
+    uint64_t flushes;                   // paints that recomposited something
+    uint64_t compositedPixels;          // pixels recomposited so far
+    uint64_t culledPixels;              // layer pixels skipped under opaque layers
+} DarlingCompositorStats;
+
+// Commands in a display list (darling_draw_submit). Each command is 32-bit
+// words: a header word (op | length in words, header included, << 8), then
+// its operands. Coordinates are signed backing-store pixels; colors are
+// 0xAARRGGBB with straight alpha.
+typedef enum DarlingDrawOp {
+    DARLING_DRAW_RECT = 1,      // x, y, width, height, color
+    DARLING_DRAW_LINE = 2,      // x0, y0, x1, y1, color, width
+    DARLING_DRAW_IMAGE = 3,     // image, x, y, srcX, srcY, width, height
+    DARLING_DRAW_GLYPHS = 4     // atlas, color, x, y, then 3 words per glyph (below)
+} DarlingDrawOp;
+
+// A glyph is (dx | dy << 16), (srcX | srcY << 16), (width | height << 16):
+// dx and dy are signed offsets from the command's x, y; the rest index the
+// atlas image, whose alpha is the glyph coverage tinted by the color.
+
+// Display list counters for one window
+typedef struct DarlingDrawStats {
+    uint32_t commands;                  // in the current list
+    uint32_t images;
+    uint64_t imageBytes;
+    uint64_t submits;
+    uint64_t reusedCommands;            // matched to the previous list, not redrawn for themselves
+    uint64_t changedCommands;           // added, removed or edited
+    uint64_t fullRedraws;               // the whole target rasterized
+    uint64_t rasterPixels;              // pixels rasterized so far
+} DarlingDrawStats;
+
+// Virtual surface and tile cache counters for one window
+typedef struct DarlingSurfaceStats {
+    uint32_t width;                     // 0 when the window has no surface
+    uint32_t height;
+    uint32_t tileSize;
+    uint32_t x;                         // viewport origin last drawn
+    uint32_t y;
+    uint32_t cachedTiles;
+    uint32_t pendingTiles;              // requested, not uploaded yet
+    uint64_t tileBytes;
+    uint64_t budgetBytes;
+    uint64_t hits;                      // tiles found cached while filling the viewport
+    uint64_t misses;                    // tiles missing (background shown instead)
+    uint64_t requests;                  // tiles requested from the app
+    uint64_t uploads;
+    uint64_t evictions;                 // tiles dropped over budget
+    uint64_t scrolls;
+    uint64_t shiftedPixels;             // moved within the backing store by scrolling
+    uint64_t copiedPixels;              // copied in from tiles
+    uint64_t fullRedraws;
+} DarlingSurfaceStats;
+
+// Visibility, throttling and present cost for one window
+typedef struct DarlingPowerStats {
+    uint32_t visibility;                // DarlingVisibility
+    uint32_t throttled;                 // presents are skipped
+    uint32_t rate;                      // frame rate asked of producers while throttled
+    uint64_t transitions;
+    uint64_t presents;                  // presents that ran
+    uint64_t skippedPresents;           // presents dropped while throttled
+    double presentMs;                   // wall time in present paths
+    double presentCpuMs;                // presenting thread's CPU time in them (pool workers not counted)
+    double throttledMs;                 // time spent throttled, up to now
+} DarlingPowerStats;
+
+// Animations run for one window
+typedef struct DarlingAnimationStats {
+    uint32_t active;                    // tweens running or waiting out their delay
+    double refreshMs;                   // tick interval (the monitor's refresh period)
+    uint64_t started;
+    uint64_t finished;                  // ran to their end value
+    uint64_t cancelled;                 // cancelled, replaced, or the window went away
+    uint64_t ticks;                     // ticks that moved at least one tween
+    uint64_t applied;                   // property writes to the window
+} DarlingAnimationStats;
+
+// Present mode and layered present counters for one window
+typedef struct DarlingPresentStats {
+    uint32_t mode;                      // DarlingPresentMode
+    uint64_t layeredPresents;           // layered window updates
+    uint64_t dirtyPixels;               // pixels in their dirty rectangles
+    uint64_t cleanPixels;               // backing store pixels they left out
+    uint64_t convertedPixels;           // premultiplied or unpremultiplied on the way in or on a mode change
+} DarlingPresentStats;
+
+// Frame thread pool counters
+typedef struct DarlingThreadPoolStats {
+    uint32_t workers;                   // worker threads running (the caller also takes part)
+    uint64_t jobs;                      // operations split across the pool
+    uint64_t inlineJobs;                // operations run on the calling thread
+    uint64_t bands;                     // row bands processed by pooled jobs
+    uint64_t steals;                    // bands taken from another thread's queue
+} DarlingThreadPoolStats;
+
+// Shared-memory frame ring counters for one window
+typedef struct DarlingFrameRingStats {
+    uint32_t slots;                     // 0 when no ring is open
+    uint32_t maxWidth;
+    uint32_t maxHeight;
+    uint32_t published;                 // last sequence number the producer published
+    uint32_t dropped;                   // frames the producer overwrote before they were taken
+    uint64_t presented;                 // frames copied into the backing store
+    uint64_t skipped;                   // published frames never presented (dropped or superseded)
+} DarlingFrameRingStats;
+
+// UI thread queue counters
+typedef struct DarlingUiThreadStats {
+    uint32_t running;                   // 1 once the thread has started
+    uint32_t pending;                   // tasks queued and not yet started
+    uint32_t peak;                      // most tasks ever queued at once
+    uint64_t posted;
+    uint64_t run;
+} DarlingUiThreadStats;
+
+// What a splash snapshot file holds
+typedef struct DarlingSnapshotInfo {
+    uint32_t width;                     // frame size, pixels
+    uint32_t height;
+    uint32_t frames;                    // 1 for a still
+    uint32_t frameMs;                   // strip frame interval
+    int32_t x;                          // window rectangle when saved
+    int32_t y;
+    int32_t windowWidth;
+    int32_t windowHeight;
+    uint32_t dpi;
+    uint32_t flags;                     // DarlingWindowStateFlags when saved
+} DarlingSnapshotInfo;
+
+// Splash shown by one window
+typedef struct DarlingSplashStats {
+    uint32_t showing;                   // 1 until the app's first frame
+    uint32_t frames;                    // strip length, 0 if none was shown
+    uint64_t shown;                     // splash frames painted
+    double firstPixelMs;                // window creation to the first frame
+} DarlingSplashStats;
+
+// Thumbnail pyramid for one window
+typedef struct DarlingThumbnailStats {
+    uint32_t levels;                    // 0 until the first thumbnail request
+    uint32_t width;                     // largest level (half the backing store)
+    uint32_t height;
+    uint64_t bytes;                     // all levels
+    uint64_t requests;                  // thumbnails returned
+    uint64_t updatedPixels;             // level pixels recomputed from dirty regions
+    uint64_t rebuilds;                  // pyramids built from scratch (first request, resize)
+} DarlingThumbnailStats;
+
+// What happens to the backing store of a hidden window evicted over budget
+typedef enum DarlingEvictionMode {
+    DARLING_EVICT_RELEASE = 0,      // free it; a frame is requested when shown
+    DARLING_EVICT_COMPRESS = 1      // keep a compressed copy and restore it when shown
+} DarlingEvictionMode;
+
+// Whether a window can be seen, most visible first
+typedef enum DarlingVisibility {
+    DARLING_VISIBILITY_VISIBLE = 0,
+    DARLING_VISIBILITY_OCCLUDED = 1,    // covered by other windows, off every monitor, or cloaked
+    DARLING_VISIBILITY_MINIMIZED = 2,
+    DARLING_VISIBILITY_HIDDEN = 3
+} DarlingVisibility;
+
+// What happens to windows that cannot be seen. Rates are the frame rates
+// producers are asked to drop to (0 = pause).
+typedef struct DarlingThrottlePolicy {
+    int enabled;                    // 0: track visibility and report it only
+    int throttleOccluded;           // treat covered windows like minimized ones
+    uint32_t occludedRate;
+    uint32_t minimizedRate;
+    uint32_t hiddenRate;
+    uint32_t checkMs;               // occlusion recheck interval (0 = 250)
+} DarlingThrottlePolicy;
+
+// Window properties a tween animates. Positions are the outer window's
+// top-left corner (screen pixels, or the parent's client pixels for child
+// windows); sizes are the outer window's.
+typedef enum DarlingAnimProperty {
+    DARLING_ANIM_OPACITY = 0,       // 0-255
+    DARLING_ANIM_POSITION = 1,      // x, y
+    DARLING_ANIM_SIZE = 2,          // width, height
+    DARLING_ANIM_TITLEBAR_COLOR = 3,    // 0xRRGGBB, each channel interpolated
+    DARLING_ANIM_PROPERTY_COUNT = 4
+} DarlingAnimProperty;
+
+// Easing curves; the named ones are the CSS cubic-beziers
+typedef enum DarlingEasing {
+    DARLING_EASE_LINEAR = 0,
+    DARLING_EASE = 1,
+    DARLING_EASE_IN = 2,
+    DARLING_EASE_OUT = 3,
+    DARLING_EASE_IN_OUT = 4,
+    DARLING_EASE_CUBIC_BEZIER = 5   // DarlingTween.bezier
+} DarlingEasing;
+
+// Animate a property from its current value (or `from` when hasFrom) to
+// `to`. Values are from[0] and to[0], with [1] the second coordinate for
+// position and size.
+typedef struct DarlingTween {
+    uint32_t property;              // DarlingAnimProperty
+    uint32_t easing;                // DarlingEasing
+    int32_t to[2];
+    int32_t from[2];
+    int hasFrom;
+    double durationMs;
+    double delayMs;
+    float bezier[4];                // x1, y1, x2, y2; x1 and x2 within 0-1
+} DarlingTween;
+
+// One 8-bit 4:2:0 frame. The chroma planes are (width + 1) / 2 samples
+// wide (pairs for NV12) and (height + 1) / 2 rows high.
+typedef struct DarlingYuvFrame {
+    uint32_t width;
+    uint32_t height;
+    uint32_t layout;                // DarlingYuvLayout
+    uint32_t matrix;                // DarlingYuvMatrix
+    uint32_t range;                 // DarlingYuvRange
+    const uint8_t* planes[3];       // Y, U (NV12: UV), V (NV12: unused)
+    uint32_t strides[3];            // bytes per row of each plane
+} DarlingYuvFrame;
+
+// Backing-store memory, globally or for one window
+typedef struct DarlingMemoryStats {
+    uint64_t backingBytes;          // live backing-store pixels
+    uint64_t compressedBytes;       // compressed copies of evicted stores
+    uint32_t gdiObjects;            // memory DCs and bitmaps (0 on headless)
+    uint32_t backingStores;         // live backing stores
+    uint32_t evictedStores;         // stores currently released or compressed
+    uint64_t evictions;             // evictions so far
+    uint64_t restores;              // stores restored from a compressed copy
+    uint64_t frameRequests;         // stores that had to be re-rendered
+    uint64_t budgetBytes;           // global budget (0 = unlimited)
+} DarlingMemoryStats;
+
+// Optional OS features, resolved once when the library initializes
+typedef enum DarlingCapability {
+    DARLING_CAP_PER_WINDOW_DPI = 0,         // GetDpiForWindow
+    DARLING_CAP_DPI_SCALED_FRAME = 1,       // AdjustWindowRectExForDpi
+    DARLING_CAP_DARK_TITLEBAR = 2,          // DWMWA_USE_IMMERSIVE_DARK_MODE
+    DARLING_CAP_TITLEBAR_COLORS = 3,        // DWMWA_CAPTION_COLOR / DWMWA_TEXT_COLOR
+    DARLING_CAP_CORNER_PREFERENCE = 4       // DWMWA_WINDOW_CORNER_PREFERENCE
+} DarlingCapability;
+
 // Window Management
 
 // Create a Darling native window. If `parent_hwnd` is non-zero on Windows,
@@ -56,6 +483,75 @@ DARLING_API uintptr_t darling_get_window_hwnd(DarlingWindow* win);
 // Associate a child HWND with a Darling window (used for resize parenting)
 DARLING_API void darling_set_child_hwnd(DarlingWindow* win, uintptr_t child_hwnd);
 
+// Child Layout
+// A per-window tree that positions any number of embedded child windows.
+// When a tree is set it replaces the single-child stretch on resize. Edits
+// take effect on the next resize or darling_layout_apply.
+
+// Add a node under `parent` and return its id (-1 on failure). Pass
+// parent = -1 to start a new tree; its root is always node 0. Inside a split
+// a node is `fixed_size` pixels along the split axis, or a `weight` share of
+// the remaining space when fixed_size is 0.
+DARLING_API int32_t darling_layout_add(
+    DarlingWindow* win,
+    int32_t parent,
+    DarlingLayoutKind kind,
+    uint32_t fixed_size,
+    float weight
+);
+
+// Attach a child HWND to a leaf node
+DARLING_API void darling_layout_set_child(DarlingWindow* win, int32_t node, uintptr_t child_hwnd);
+
+// Change a node's fixed size or weight (e.g. dragging a splitter)
+DARLING_API void darling_layout_set_size(DarlingWindow* win, int32_t node, uint32_t fixed_size, float weight);
+
+// Select the visible child of a stack node
+DARLING_API void darling_layout_set_active(DarlingWindow* win, int32_t node, uint32_t index);
+
+// Remove the tree; child windows stay where they are
+DARLING_API void darling_layout_clear(DarlingWindow* win);
+
+// Recompute the layout for the current client size and move every changed
+// child in one batch
+DARLING_API void darling_layout_apply(DarlingWindow* win);
+
+// Hit-Test Regions
+// Typed regions answered natively on WM_NCHITTEST, so dragging, caption
+// buttons and resizing work without a round trip through web content.
+// Edges are client pixels from the left/top, or from the right/bottom when
+// the matching DarlingHitAnchor flag is set, so regions follow resizes.
+// Where regions overlap, the most recently added one wins. Points outside
+// every region behave as usual.
+
+// Add a region and return its id (-1 on failure)
+DARLING_API int32_t darling_hit_region_add(
+    DarlingWindow* win,
+    DarlingHitKind kind,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+);
+
+// Move a region, keeping its stacking order
+DARLING_API void darling_hit_region_set(
+    DarlingWindow* win,
+    int32_t id,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+);
+
+DARLING_API void darling_hit_region_remove(DarlingWindow* win, int32_t id);
+DARLING_API void darling_hit_region_clear(DarlingWindow* win);
+
+// Kind of the region at a client point, or -1 if none
+DARLING_API int32_t darling_hit_test(DarlingWindow* win, int32_t x, int32_t y);
+
 // Set the title text for a Darling window
 DARLING_API void darling_set_window_title(DarlingWindow* win, const wchar_t* title);
 
@@ -82,6 +578,12 @@ DARLING_API void darling_set_always_on_top(DarlingWindow* win, int enable);
 // Check if system is in dark mode (1 = dark, 0 = light)
 DARLING_API int darling_is_dark_mode(void);
 
+// System accent color as 0xRRGGBB (cached, refreshed on theme change)
+DARLING_API uint32_t darling_get_accent_color(void);
+
+// Check if high-contrast mode is on (1 = on, 0 = off)
+DARLING_API int darling_is_high_contrast(void);
+
 // Manually set dark mode for a window (1 = dark, 0 = light)
 DARLING_API void darling_set_dark_mode(DarlingWindow* win, int enable);
 
@@ -107,13 +609,24 @@ DARLING_API void darling_set_corner_preference(
     DarlingCornerPreference pref
 );
 
+// Appearance Transactions
+// Setters called between begin and commit (theme, titlebar colors, icon)
+// record their attributes but defer the non-client frame recalculation and
+// redraw; the outermost commit applies them once. Calls may nest.
+DARLING_API void darling_begin_appearance_update(DarlingWindow* win);
+DARLING_API void darling_commit_appearance_update(DarlingWindow* win);
+
 // Flash the window (continuous = 1 for continuous flashing)
 DARLING_API void darling_flash_window(DarlingWindow* win, int continuous);
 
 // DPI helpers
+// Values are cached per window and refreshed on WM_DPICHANGED.
 DARLING_API uint32_t darling_get_dpi(DarlingWindow* win);
 DARLING_API float darling_get_scale_factor(DarlingWindow* win);
 
+// Returns 1 if the running OS supports `cap`
+DARLING_API int darling_has_capability(DarlingCapability cap);
+
 // Rendering
 
 // Paint a BGRA bitmap onto the main window
@@ -131,6 +644,406 @@ DARLING_API void darling_paint_frame_window(
     uint32_t height
 );
 
+// Paint a bitmap in the given pixel format onto a specific window
+// (converted to BGRA, and premultiplied for a per-pixel-alpha window, while
+// copying into the backing store)
+DARLING_API void darling_paint_frame_window_format(
+    DarlingWindow* win,
+    const unsigned char* data,
+    uint32_t width,
+    uint32_t height,
+    DarlingPixelFormat format
+);
+
+// Update a rectangle of the window's current backing store with BGRA pixels
+// (`bgra_data` is width * 4 bytes per row). Only that rectangle is repainted.
+// Ignored if no frame has been painted yet or the rectangle is out of bounds.
+DARLING_API void darling_paint_frame_window_region(
+    DarlingWindow* win,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height
+);
+
+// Video
+// Decoded I420 and NV12 frames are converted to BGRA straight into the
+// backing store (SSE2 where available, on the frame thread pool), with no
+// intermediate RGB frame.
+
+// Paint a YUV frame. With `scale_to_client` the frame is resampled
+// (bilinear) to the window's client size in the same pass; otherwise the
+// backing store takes the frame's size. Ignored if a plane is missing or a
+// stride is too short.
+DARLING_API void darling_paint_yuv_window(DarlingWindow* win, const DarlingYuvFrame* frame, int scale_to_client);
+
+// Thumbnails
+// Previews come from a pyramid of 2x box downscales of the backing store,
+// built on the first request. Later paints only mark their rectangles
+// dirty; the next request recomputes those and nothing else. The pyramid
+// outlives an evicted backing store.
+
+// Write a `width` x `height` BGRA thumbnail (width * 4 bytes per row) to
+// `out`, scaled from the smallest level at least that size. Returns 1 on
+// success, 0 if the window has never been painted or was evicted before
+// its pyramid caught up.
+DARLING_API int darling_get_thumbnail(DarlingWindow* win, uint8_t* out, uint32_t width, uint32_t height);
+
+// Free the pyramid; the next request rebuilds it
+DARLING_API void darling_release_thumbnails(DarlingWindow* win);
+
+DARLING_API void darling_get_thumbnail_stats(DarlingWindow* win, DarlingThumbnailStats* out);
+
+// Frame Timing
+// Every paint call is timed through copy, invalidation, WM_PAINT and the
+// blit to the window, feeding per-window latency histograms. A newer frame
+// painted before the previous one was presented replaces it.
+
+// Give the next frame painted on `win` an ID and the time the producer
+// submitted it (ms on the darling_input_now clock; 0 = at paint entry).
+// Untagged frames get increasing IDs.
+DARLING_API void darling_frame_tag(DarlingWindow* win, uint64_t frame_id, double submit_ms);
+
+// Look up one of the last 64 frames by ID. Returns 1 and fills `out` once
+// the frame has been presented or replaced, 0 while in flight or unknown.
+DARLING_API int darling_get_frame_record(DarlingWindow* win, uint64_t frame_id, DarlingFrameRecord* out);
+
+DARLING_API void darling_get_frame_timing(DarlingWindow* win, DarlingFrameTimingStats* out);
+DARLING_API void darling_reset_frame_timing(DarlingWindow* win);
+
+// Draw FPS and p99 total latency into the top-left corner of the backing
+// store on every frame (enable = 1)
+DARLING_API void darling_set_frame_overlay(DarlingWindow* win, int enable);
+
+// Layers
+// Overlays composited above the window content: each has a position, z
+// order, opacity and its own premultiplied BGRA surface. While a window
+// has layers, painted frames become its content layer and only the damaged
+// parts of the window are recomposited, skipping anything hidden under an
+// opaque layer.
+
+// Create a fully transparent layer. Returns its ID, or -1 on failure.
+DARLING_API int32_t darling_layer_create(DarlingWindow* win, int32_t x, int32_t y, uint32_t width, uint32_t height, int32_t z);
+DARLING_API void darling_layer_destroy(DarlingWindow* win, int32_t id);
+
+DARLING_API void darling_layer_set_position(DarlingWindow* win, int32_t id, int32_t x, int32_t y);
+DARLING_API void darling_layer_set_z(DarlingWindow* win, int32_t id, int32_t z);
+DARLING_API void darling_layer_set_opacity(DarlingWindow* win, int32_t id, uint8_t opacity);
+DARLING_API void darling_layer_set_visible(DarlingWindow* win, int32_t id, int visible);
+
+// Replace a rectangle of the layer's surface with tightly packed BGRA.
+// Straight alpha is premultiplied on the way in unless `premultiplied`.
+DARLING_API void darling_layer_update(
+    DarlingWindow* win,
+    int32_t id,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height,
+    int premultiplied
+);
+
+DARLING_API void darling_get_compositor_stats(DarlingWindow* win, DarlingCompositorStats* out);
+
+// Display Lists
+// A window can be drawn from a list of commands (rectangles, lines, image
+// sprites, text from a glyph atlas) instead of frames. The list is
+// retained: each submit is compared with the last one and only the
+// bounding boxes of commands that were added, removed or edited are
+// rasterized again, in software, on the frame thread pool. The list draws
+// at the client size over a solid background, into the content layer when
+// the window has layers.
+
+// Replace the window's list with `count` words. Returns 1 if drawn (or
+// kept for when the window has a client area), 0 if the list is malformed,
+// which leaves the current one in place.
+DARLING_API int darling_draw_submit(DarlingWindow* win, const uint32_t* words, size_t count, uint32_t background);
+
+// Upload an image (tightly packed BGRA) for IMAGE and GLYPHS commands to
+// refer to by `id`, replacing any image with that ID; commands using it
+// are redrawn. Straight alpha is premultiplied unless `premultiplied`.
+// Returns 1 on success.
+DARLING_API int darling_draw_image_upload(
+    DarlingWindow* win,
+    uint32_t id,
+    const unsigned char* bgra_data,
+    uint32_t width,
+    uint32_t height,
+    int premultiplied
+);
+
+// Free an image; commands using it draw nothing until it is uploaded again
+DARLING_API void darling_draw_image_release(DarlingWindow* win, uint32_t id);
+
+DARLING_API void darling_get_draw_stats(DarlingWindow* win, DarlingDrawStats* out);
+
+// Virtual Surfaces
+// A surface far larger than the window (a map, a timeline, a spreadsheet)
+// uploaded as sparse square tiles into a cache bounded by a byte budget,
+// least recently used tiles evicted first. The window shows a viewport into
+// it at the client size. Scrolling shifts what the backing store already
+// shows and copies in only the newly exposed strips. Tiles missing from
+// the cache show the background and are requested through the tile
+// request callback, once until they arrive or leave the viewport. The
+// surface draws into the content layer when the window has layers.
+
+// Give the window a width x height surface of `tile_size` tiles (a power of
+// two, 16-2048; 0 = 256) cached within `budget_bytes` (0 = 64 MB), over a
+// BGRA `background`, and show it from the origin. Replaces any surface the
+// window had. Returns 1 on success.
+DARLING_API int darling_surface_create(
+    DarlingWindow* win,
+    uint32_t width,
+    uint32_t height,
+    uint32_t tile_size,
+    uint64_t budget_bytes,
+    uint32_t background
+);
+
+// Drop the surface and its tiles; the window keeps showing the viewport
+DARLING_API void darling_surface_close(DarlingWindow* win);
+
+// Store the tile at column `col`, row `row` (tile_size * tile_size BGRA,
+// tile_size * 4 bytes per row; past the surface's edge is not shown) and
+// redraw its part of the viewport. Returns 1 if stored.
+DARLING_API int darling_surface_upload_tile(DarlingWindow* win, int32_t col, int32_t row, const uint8_t* bgra_data);
+
+// Move the viewport's top-left corner, clamped to keep it on the surface
+DARLING_API void darling_surface_scroll_to(DarlingWindow* win, uint32_t x, uint32_t y);
+
+// Content in this surface rectangle changed: its cached tiles are dropped
+// and the visible ones requested again, still showing until replaced
+DARLING_API void darling_surface_invalidate(DarlingWindow* win, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+DARLING_API void darling_get_surface_stats(DarlingWindow* win, DarlingSurfaceStats* out);
+
+// Set the callback told which tiles a window needs, as `count` (col, row)
+// pairs in `tiles`; called on the thread that moved the viewport
+DARLING_API void darling_set_tile_request_callback(DarlingTileRequestCallback callback);
+
+// Frame Thread Pool
+// Frame copies, pixel-format conversion, premultiplication and layer
+// compositing on large frames are split into row bands and run on a shared
+// pool of worker threads. Frames under 1 MB run on the calling thread.
+
+// Number of threads taking part, including the caller (0 = one per CPU,
+// 1 = no workers). Workers are pinned round-robin to the CPUs set in
+// `affinity_mask` (0 = not pinned). Takes effect on the next large frame.
+DARLING_API void darling_set_thread_pool(uint32_t threads, uint64_t affinity_mask);
+
+DARLING_API void darling_get_thread_pool_stats(DarlingThreadPoolStats* out);
+
+// Shared-Memory Frame Ring
+// A named shared-memory ring another process writes frames into with the
+// producer SDK (darling_producer.h), so native renderers and decoders
+// reach the backing store without going through JavaScript. The newest
+// complete frame is presented on each darling_poll_events, or on demand.
+
+// Create the ring `name` (letters, digits, '.', '_', '-') for frames up to
+// max_width x max_height, with `slots` slots (3-8, 0 = 3). Replaces any
+// ring the window had. Returns 1 on success, 0 if the name is taken or
+// invalid or the memory cannot be mapped.
+DARLING_API int darling_frame_ring_create(
+    DarlingWindow* win,
+    const char* name,
+    uint32_t max_width,
+    uint32_t max_height,
+    uint32_t slots
+);
+
+// Close and unlink the ring (also done when the window is destroyed)
+DARLING_API void darling_frame_ring_close(DarlingWindow* win);
+
+// Present the newest complete frame if there is one. Returns 1 if a frame
+// was presented.
+DARLING_API int darling_frame_ring_present(DarlingWindow* win);
+
+DARLING_API void darling_get_frame_ring_stats(DarlingWindow* win, DarlingFrameRingStats* out);
+
+// Access by HWND
+// For threads that hold a window's HWND but not its DarlingWindow (e.g. a
+// Node worker painting for a window the main thread created). A window
+// destroyed in the meantime is skipped rather than touched.
+
+// Paint a frame (see darling_paint_frame_window_format), tagged with
+// `frame_id` unless 0. Returns 1 if the window exists.
+DARLING_API int darling_paint_frame_hwnd(
+    uintptr_t hwnd,
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    DarlingPixelFormat format,
+    uint64_t frame_id
+);
+
+// darling_frame_ring_present for the window with this HWND
+DARLING_API int darling_frame_ring_present_hwnd(uintptr_t hwnd);
+
+// Backing-Store Memory
+
+// Global budget for live backing stores (0 = unlimited). When exceeded,
+// stores of hidden or minimized windows are evicted least recently
+// presented first; visible windows are never evicted.
+DARLING_API void darling_set_memory_budget(uint64_t bytes, DarlingEvictionMode mode);
+
+DARLING_API void darling_get_memory_stats(DarlingMemoryStats* out);
+DARLING_API void darling_get_window_memory_stats(DarlingWindow* win, DarlingMemoryStats* out);
+
+// Set a callback invoked when a window whose backing store was released is
+// shown again and needs a new frame
+DARLING_API void darling_set_frame_request_callback(DarlingFrameRequestCallback callback);
+
+// Power Throttling
+// Each window's visibility is tracked from show, size and position changes,
+// with occlusion by other windows rechecked from darling_poll_events. Under
+// an enabled policy, frames, display lists and surface redraws sent to a
+// window that cannot be seen are skipped; once it can be seen again it is
+// redrawn from what it retains, or a frame is requested. Transitions are
+// reported with the rate producers should drop to.
+
+// Replace the policy for all windows (NULL: disabled, the default)
+DARLING_API void darling_set_throttle_policy(const DarlingThrottlePolicy* policy);
+
+DARLING_API void darling_get_power_stats(DarlingWindow* win, DarlingPowerStats* out);
+
+// Set the callback told when a window's visibility or throttling changes;
+// called on the thread that noticed (window procedure or poll)
+DARLING_API void darling_set_visibility_callback(DarlingVisibilityCallback callback);
+
+// Present Mode
+// A window in DARLING_PRESENT_PER_PIXEL_ALPHA keeps its backing store
+// premultiplied and is presented as a per-pixel-alpha layered window, for
+// shaped and translucent overlays. Frames painted to it in straight alpha
+// are premultiplied on the way in. Damage gathers into one dirty rectangle,
+// and only that is sent with the next present. The window takes the size of
+// its backing store, so use it with frameless windows. Its opacity is
+// applied as the layered window's constant alpha.
+
+// Switch a window's present mode, converting the backing store it has.
+// Returns 1 on success.
+DARLING_API int darling_set_present_mode(DarlingWindow* win, DarlingPresentMode mode);
+
+DARLING_API void darling_get_present_stats(DarlingWindow* win, DarlingPresentStats* out);
+
+// Animations
+// Tweens of a window's opacity, position, size and titlebar color run in
+// the library: on the thread that owns the window, once per refresh of its
+// monitor, each tick writing every property that moved in one call to the
+// OS. Windows owned by the UI thread animate there without any caller
+// polling; others advance from darling_poll_events, at most once per
+// refresh. A property has one tween at a time: a new one starts from
+// where the running one got to, which is cancelled.
+
+// Start a tween. Returns its ID (never 0), or 0 if it is invalid.
+DARLING_API uint32_t darling_animate(DarlingWindow* win, const DarlingTween* tween);
+
+// Stop a tween where it is (id 0: all of the window's tweens)
+DARLING_API void darling_animate_cancel(DarlingWindow* win, uint32_t id);
+
+DARLING_API void darling_get_animation_stats(DarlingWindow* win, DarlingAnimationStats* out);
+
+// Set the callback told when a tween ends: finished = 1 at its end value,
+// 0 when cancelled. Called on the thread that ticked or cancelled it.
+DARLING_API void darling_set_animation_callback(DarlingAnimationCallback callback);
+
+// Time animations by `clock` (ms) instead of darling_input_now, e.g. a
+// fake clock in tests; NULL restores it. Set it while nothing animates.
+DARLING_API void darling_set_animation_clock(DarlingClock clock, void* ctx);
+
+// Input Ring
+// Mouse, wheel, keyboard and touch input is written, timestamped, into a
+// single-producer/single-consumer ring in caller-owned memory (e.g. a
+// SharedArrayBuffer) so a consumer can drain it once per frame instead of
+// taking a callback per event. When the ring is full new events are
+// dropped and counted.
+
+// Bytes of memory needed for a ring of `capacity` events
+DARLING_API size_t darling_input_ring_bytes(uint32_t capacity);
+
+// Start writing a window's input into `memory`, which must stay valid until
+// darling_input_detach. The capacity is the largest power of two that fits.
+// Returns the capacity, or 0 if the memory is too small or misaligned.
+DARLING_API uint32_t darling_input_attach(DarlingWindow* win, void* memory, size_t bytes);
+DARLING_API void darling_input_detach(DarlingWindow* win);
+
+// Consume up to `max` events (for native consumers). Returns the count.
+DARLING_API uint32_t darling_input_read(DarlingWindow* win, DarlingInputEvent* out, uint32_t max);
+
+DARLING_API void darling_input_get_stats(DarlingWindow* win, DarlingInputStats* out);
+
+// Current time on the monotonic clock used for event timestamps, in ms
+DARLING_API double darling_input_now(void);
+
+// Window State Mirror
+// Visibility, focus, minimized/maximized, client and window rects, DPI and
+// theme, rewritten into caller-owned memory (e.g. a SharedArrayBuffer) by
+// the window procedure as they change, under a sequence lock. Readers on
+// any thread or in JavaScript see a consistent record without a call into
+// the library.
+
+// Bytes of memory needed for a mirror
+DARLING_API size_t darling_state_mirror_bytes(void);
+
+// Start mirroring a window's state into `memory`, which must stay valid
+// until darling_state_detach. Returns 1, or 0 if the memory is too small
+// or misaligned; a failed attach also detaches any earlier memory.
+DARLING_API int darling_state_attach(DarlingWindow* win, void* memory, size_t bytes);
+DARLING_API void darling_state_detach(DarlingWindow* win);
+
+// Read a consistent record from attached mirror memory, retrying while a
+// write is in progress. Returns 0 if `memory` is not a mirror.
+DARLING_API int darling_state_read(const void* memory, DarlingWindowState* out);
+
+// UI Thread
+// A library-owned thread for callers that should not wait on window
+// operations (the Node bindings run their promise-returning calls on it).
+// Tasks run one at a time in the order posted. Windows created by a task
+// belong to the UI thread, which dispatches their messages; destroy them
+// from a task as well.
+
+// Queue `task` on the UI thread, starting the thread on first use. Returns
+// 0, and the task never runs, if the thread cannot start or is stopping.
+DARLING_API int darling_ui_post(DarlingUiTask task, void* ctx);
+
+DARLING_API void darling_get_ui_thread_stats(DarlingUiThreadStats* out);
+
+// Splash Snapshot
+// A window's frame saved to a file with its rectangle and theme. Set as
+// the splash, the next launch's first top-level window shows it as it is
+// created, mapped straight from the file, until the app paints its first
+// frame. A file with several frames plays them as a looping strip, advanced
+// by darling_poll_events. Paths are UTF-8.
+
+// Save `count` frames of width x height BGRA (width * 4 bytes per row, back
+// to back) to `path`, replacing it whole. With `frames` NULL, save the
+// window's presented image instead; 0 if it has none (never painted, or its
+// backing store was evicted).
+DARLING_API int darling_snapshot_save(
+    DarlingWindow* win,
+    const char* path,
+    const uint8_t* frames,
+    uint32_t width,
+    uint32_t height,
+    uint32_t count,
+    uint32_t frame_ms
+);
+
+// 0 if `path` is missing or not a snapshot this build can show
+DARLING_API int darling_snapshot_read_info(const char* path, DarlingSnapshotInfo* out);
+
+// The next top-level window darling_create_window creates shows this
+// snapshot, and takes its theme; NULL cancels. A file that is missing or
+// invalid by then is ignored.
+DARLING_API void darling_set_splash_snapshot(const char* path);
+
+// Stop showing the splash before the app paints a frame of its own, e.g.
+// once a child window covering the client area is shown
+DARLING_API void darling_end_splash(DarlingWindow* win);
+
+DARLING_API void darling_get_splash_stats(DarlingWindow* win, DarlingSplashStats* out);
+
 // Event Loop
 
 // Process all pending window messages
@@ -142,12 +1055,16 @@ DARLING_API void darling_set_close_callback(void (*callback)());
 // Set a callback invoked with the closing window HWND on WM_CLOSE
 DARLING_API void darling_set_close_callback_hwnd(DarlingCloseCallbackHWND callback);
 
+// Set a callback invoked with the window HWND and its new DPI when the
+// window moves to a monitor with a different scale
+DARLING_API void darling_set_dpi_changed_callback(DarlingDpiChangedCallback callback);
+
 // Initialization
 
 // Initialize global state (thread-safety, etc)
 DARLING_API void darling_init(void);
 
-// Clean up global state and unregister the window class
+// Stop the UI thread, clean up global state and unregister the window class
 DARLING_API void darling_cleanup(void);
 
 #ifdef __cplusplus
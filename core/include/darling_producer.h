@@ -0,0 +1,129 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Darling Frame Producer SDK
+// Writes frames into a shared-memory frame ring created by Darling with
+// darling_frame_ring_create, from any process (a native renderer, a video
+// decoder, a game). Standalone: link darling_producer, not darling.
+//
+// Ring layout (shared between processes, fixed for a version):
+//
+//   byte    0  uint32 magic, version, slotCount, maxWidth, maxHeight, headerBytes,
+//              uint64 slotBytes
+//   byte   64  uint32 published, dropped       (written by the producer only)
+//   byte  128  uint32 presented, closed        (written by Darling only)
+//   byte  192  slotCount * 64-byte slot headers
+//   headerBytes + i * slotBytes   slot i pixels, tightly packed rows
+//
+// Each slot moves FREE -> WRITING -> READY -> READING -> FREE. The producer
+// claims a FREE slot (or, when Darling is behind, the oldest READY one,
+// counting a drop), fills it and publishes it READY with the next sequence
+// number. Darling takes the newest READY slot, copies it into the window's
+// backing store and frees it along with any older READY slots. Every state
+// change is a compare-and-swap on the slot's state word, so neither side
+// ever sees a partly written frame and the producer never waits.
+//
+// One producer per ring. Sequence numbers wrap at 2^32.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DARLING_FRAME_RING_MAGIC 0x52465244u       // "DRFR"
+#define DARLING_FRAME_RING_VERSION 1u
+#define DARLING_FRAME_RING_MIN_SLOTS 3u
+#define DARLING_FRAME_RING_MAX_SLOTS 8u
+#define DARLING_FRAME_RING_HEADER_BYTES 4096u       // slot pixels start page aligned
+#define DARLING_FRAME_RING_NAME_MAX 64u
+
+typedef enum DarlingFrameSlotState {
+    DARLING_FRAME_SLOT_FREE = 0,
+    DARLING_FRAME_SLOT_WRITING = 1,
+    DARLING_FRAME_SLOT_READY = 2,
+    DARLING_FRAME_SLOT_READING = 3
+} DarlingFrameSlotState;
+
+// Pixel formats (same values as DarlingPixelFormat)
+#define DARLING_FRAME_RING_BGRA8 0u
+#define DARLING_FRAME_RING_RGBA8 1u
+
+typedef struct DarlingFrameSlot {
+    volatile uint32_t state;        // DarlingFrameSlotState
+    volatile uint32_t seq;          // sequence number of the frame held
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t reserved0;
+    double submitMs;                // producer timestamp on the darling_input_now clock
+    uint32_t reserved1[8];
+} DarlingFrameSlot;
+
+typedef struct DarlingFrameRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t maxWidth;
+    uint32_t maxHeight;
+    uint32_t headerBytes;
+    uint64_t slotBytes;
+    uint32_t reserved0[8];
+
+    volatile uint32_t published;    // last sequence number published
+    volatile uint32_t dropped;      // READY frames reused before Darling took them
+    uint32_t reserved1[14];
+
+    volatile uint32_t presented;    // last sequence number presented
+    volatile uint32_t closed;       // Darling has closed the ring
+    volatile uint32_t throttled;    // the window cannot be seen; frames wait in the ring
+    volatile uint32_t rate;         // frame rate asked for while throttled (0 = pause)
+    uint32_t reserved2[12];
+
+    DarlingFrameSlot slots[DARLING_FRAME_RING_MAX_SLOTS];
+} DarlingFrameRingHeader;
+
+typedef struct DarlingProducer DarlingProducer;
+
+// Open the ring Darling created under `name`. Returns NULL if it does not
+// exist or has an incompatible layout.
+DarlingProducer* darling_producer_open(const char* name);
+void darling_producer_close(DarlingProducer* producer);
+
+// Largest frame the ring holds
+void darling_producer_get_size(DarlingProducer* producer, uint32_t* max_width, uint32_t* max_height);
+
+// Claim a slot and return its pixels (width * 4 bytes per row) to draw a
+// width x height frame into. Returns NULL if the frame is too large or
+// Darling has closed the ring. Each begin must be followed by a commit.
+uint8_t* darling_producer_begin(DarlingProducer* producer, uint32_t width, uint32_t height);
+
+// Publish the claimed slot. `submit_ms` of 0 stamps it now. Returns the
+// frame's sequence number, or 0 if no slot was claimed.
+uint32_t darling_producer_commit(DarlingProducer* producer, uint32_t format, double submit_ms);
+
+// begin, copy tightly packed `pixels`, commit. Returns the sequence number,
+// or 0 on failure.
+uint32_t darling_producer_write(
+    DarlingProducer* producer,
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t format
+);
+
+// Frames reused before Darling presented them
+uint32_t darling_producer_dropped(DarlingProducer* producer);
+
+// 1 once Darling has closed the ring
+int darling_producer_closed(DarlingProducer* producer);
+
+// 1 while the window cannot be seen and Darling is not presenting; `rate`
+// (optional) gets the frame rate to drop to meanwhile, 0 to pause
+int darling_producer_throttled(DarlingProducer* producer, uint32_t* rate);
+
+// Current time on the clock used by darling_input_now, in ms
+double darling_producer_now(void);
+
+#ifdef __cplusplus
+}
+#endif
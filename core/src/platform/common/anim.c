@@ -0,0 +1,414 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend reads and writes the animated
+// properties (darling_anim_read, darling_anim_apply), says which windows
+// the calling thread owns and their refresh period, and calls
+// darling_anim_poll from darling_poll_events and its UI thread's wait.
+#include <string.h>
+
+// Animations
+
+static DarlingClock g_anim_clock = NULL;
+static void* g_anim_clock_ctx = NULL;
+static DarlingAnimationCallback g_anim_callback = NULL;
+static uint32_t g_anim_next_id = 0;
+
+double darling_anim_now(void) {
+    return g_anim_clock ? g_anim_clock(g_anim_clock_ctx) : darling_input_now();
+}
+
+// Easing
+
+static double darling_bezier_at(double p1, double p2, double t) {
+    double u = 1.0 - t;
+    return 3.0 * u * u * t * p1 + 3.0 * u * t * t * p2 + t * t * t;
+}
+
+static double darling_bezier_slope(double p1, double p2, double t) {
+    double u = 1.0 - t;
+    return 3.0 * u * u * p1 + 6.0 * u * t * (p2 - p1) + 3.0 * t * t * (1.0 - p2);
+}
+
+// y at x on the curve (0,0) (x1,y1) (x2,y2) (1,1): Newton's method for the
+// t where the curve reaches x, bisection where that stalls on a flat part
+static double darling_bezier_ease(const float b[4], double x) {
+    double t = x;
+    for (int i = 0; i < 8; i++) {
+        double err = darling_bezier_at(b[0], b[2], t) - x;
+        if (err > -1e-7 && err < 1e-7) {
+            return darling_bezier_at(b[1], b[3], t);
+        }
+        double slope = darling_bezier_slope(b[0], b[2], t);
+        if (slope > -1e-6 && slope < 1e-6) {
+            break;
+        }
+        t -= err / slope;
+    }
+
+    double lo = 0.0;
+    double hi = 1.0;
+    t = x;
+    for (int i = 0; i < 32; i++) {
+        double at = darling_bezier_at(b[0], b[2], t);
+        if (at > x - 1e-7 && at < x + 1e-7) {
+            break;
+        }
+        if (at < x) {
+            lo = t;
+        } else {
+            hi = t;
+        }
+        t = (lo + hi) * 0.5;
+    }
+    return darling_bezier_at(b[1], b[3], t);
+}
+
+static const float g_ease_curves[][4] = {
+    { 0.0f, 0.0f, 1.0f, 1.0f },         // linear
+    { 0.25f, 0.1f, 0.25f, 1.0f },       // ease
+    { 0.42f, 0.0f, 1.0f, 1.0f },        // ease-in
+    { 0.0f, 0.0f, 0.58f, 1.0f },        // ease-out
+    { 0.42f, 0.0f, 0.58f, 1.0f }        // ease-in-out
+};
+
+double darling_anim_ease(uint32_t easing, const float bezier[4], double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+    if (easing == DARLING_EASE_LINEAR) {
+        return x;
+    }
+    return darling_bezier_ease(easing == DARLING_EASE_CUBIC_BEZIER ? bezier : g_ease_curves[easing], x);
+}
+
+// Rounded to the nearest whole value in [lo, hi]
+static int32_t darling_anim_lerp(int32_t from, int32_t to, double e, int32_t lo, int32_t hi) {
+    double v = (double)from + ((double)to - (double)from) * e;
+    v = v < 0.0 ? v - 0.5 : v + 0.5;
+    return v <= (double)lo ? lo : v >= (double)hi ? hi : (int32_t)v;
+}
+
+// The tween's value at eased progress `e`. A curve that overshoots (a
+// bezier with y outside 0..1) still gives a value the property can take.
+static void darling_anim_value(uint32_t property, const DarlingAnimTween* t, double e, int32_t out[2]) {
+    out[1] = 0;
+
+    switch (property) {
+        case DARLING_ANIM_OPACITY:
+            out[0] = darling_anim_lerp(t->from[0], t->to[0], e, 0, 255);
+            return;
+
+        case DARLING_ANIM_TITLEBAR_COLOR: {
+            uint32_t from = (uint32_t)t->from[0];
+            uint32_t to = (uint32_t)t->to[0];
+            uint32_t color = 0;
+            for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+                int32_t c = darling_anim_lerp((int32_t)((from >> shift) & 0xFFu), (int32_t)((to >> shift) & 0xFFu), e, 0, 255);
+                color |= (uint32_t)c << shift;
+            }
+            out[0] = (int32_t)color;
+            return;
+        }
+
+        case DARLING_ANIM_SIZE:
+            out[0] = darling_anim_lerp(t->from[0], t->to[0], e, 1, INT32_MAX);
+            out[1] = darling_anim_lerp(t->from[1], t->to[1], e, 1, INT32_MAX);
+            return;
+
+        default:
+            out[0] = darling_anim_lerp(t->from[0], t->to[0], e, INT32_MIN, INT32_MAX);
+            out[1] = darling_anim_lerp(t->from[1], t->to[1], e, INT32_MIN, INT32_MAX);
+            return;
+    }
+}
+
+// FALSE for a value the property cannot take; a colour keeps its RGB bits
+static BOOL darling_anim_accept(uint32_t property, int32_t v[2]) {
+    if (property == DARLING_ANIM_OPACITY && (v[0] < 0 || v[0] > 255)) {
+        return FALSE;
+    }
+    if (property == DARLING_ANIM_SIZE && (v[0] < 1 || v[1] < 1)) {
+        return FALSE;
+    }
+    if (property == DARLING_ANIM_TITLEBAR_COLOR) {
+        v[0] &= 0xFFFFFF;
+    }
+    return TRUE;
+}
+
+// Free a slot and note its end. Called with the lock held.
+static void darling_anim_end(DarlingAnimator* a, uint32_t property, BOOL finished, DarlingAnimEnds* ends) {
+    DarlingAnimTween* t = &a->tweens[property];
+    ends->ids[ends->count] = t->id;
+    ends->properties[ends->count] = property;
+    ends->count++;
+
+    t->id = 0;
+    a->active--;
+    if (finished) {
+        a->finished++;
+    } else {
+        a->cancelled++;
+    }
+}
+
+static void darling_anim_report(HWND hwnd, const DarlingAnimEnds* ends, uint32_t finished) {
+    DarlingAnimationCallback callback = g_anim_callback;
+    for (uint32_t i = 0; callback && i < ends->count; i++) {
+        callback((uintptr_t)hwnd, ends->ids[i], ends->properties[i], finished);
+    }
+}
+
+// Advance a window's tweens to `now` if a tick is due. Ticks keep to the
+// refresh period even when polled early, so a poller faster than the
+// monitor does not tick faster. Values that did not change since the last
+// write are left out of the frame. Called with the lock held.
+static void darling_anim_tick_window(DarlingWindow* win, double now, DarlingAnimFrame* frame, DarlingAnimEnds* ends) {
+    DarlingAnimator* a = &win->anim;
+    frame->mask = 0;
+    ends->count = 0;
+
+    if (now < a->lastTickMs + a->refreshMs * (1.0 - DARLING_ANIM_SLACK)) {
+        return;
+    }
+    double next = a->lastTickMs + a->refreshMs;
+    a->lastTickMs = now - a->lastTickMs < a->refreshMs * 2.0 ? next : now;
+
+    for (uint32_t p = 0; p < DARLING_ANIM_PROPERTY_COUNT; p++) {
+        DarlingAnimTween* t = &a->tweens[p];
+        if (!t->id || now < t->startMs) {
+            continue;
+        }
+
+        // Within a microsecond of the end is the end
+        double elapsed = now - t->startMs;
+        double x = elapsed >= t->durationMs - 1e-3 ? 1.0 : elapsed / t->durationMs;
+        int32_t v[2];
+        darling_anim_value(p, t, darling_anim_ease(t->easing, t->bezier, x), v);
+
+        if (!t->written || v[0] != t->current[0] || v[1] != t->current[1]) {
+            t->current[0] = v[0];
+            t->current[1] = v[1];
+            t->written = TRUE;
+            frame->values[p][0] = v[0];
+            frame->values[p][1] = v[1];
+            frame->mask |= 1u << p;
+            a->applied++;
+        }
+        if (x >= 1.0) {
+            darling_anim_end(a, p, TRUE, ends);
+        }
+    }
+
+    if (frame->mask) {
+        a->ticks++;
+    }
+}
+
+// Tick every window the calling thread owns that has tweens, writing and
+// reporting outside the lock (writes re-enter the window procedure).
+// Windows are taken in batches; a window destroyed meanwhile would be
+// destroyed on this thread, so none goes away between the two halves.
+void darling_anim_poll(void) {
+    typedef struct DarlingAnimWork {
+        DarlingWindow* win;
+        HWND hwnd;
+        DarlingAnimFrame frame;
+        DarlingAnimEnds ends;
+    } DarlingAnimWork;
+
+    DarlingAnimWork work[DARLING_ANIM_BATCH];
+    DarlingWindow* resume = NULL;
+    double now = darling_anim_now();
+
+    do {
+        uint32_t count = 0;
+
+        darling_lock();
+        DarlingWindow* it = resume ? resume : g_window_head;
+        resume = NULL;
+        for (; it; it = it->next) {
+            if (!it->anim.active || !darling_window_is_local(it)) {
+                continue;
+            }
+            if (count == DARLING_ANIM_BATCH) {
+                resume = it;
+                break;
+            }
+
+            DarlingAnimWork* w = &work[count];
+            darling_anim_tick_window(it, now, &w->frame, &w->ends);
+            if (w->frame.mask || w->ends.count) {
+                w->win = it;
+                w->hwnd = it->hwnd;
+                count++;
+            }
+        }
+        darling_unlock();
+
+        for (uint32_t i = 0; i < count; i++) {
+            if (work[i].frame.mask) {
+                darling_anim_apply(work[i].win, &work[i].frame);
+            }
+            darling_anim_report(work[i].hwnd, &work[i].ends, 1u);
+        }
+    } while (resume);
+}
+
+// Milliseconds until the next tick of a window the calling thread owns,
+// or -1 if none is animating
+double darling_anim_wait_ms(void) {
+    double now = darling_anim_now();
+    double wait = -1.0;
+
+    darling_lock();
+    for (DarlingWindow* it = g_window_head; it; it = it->next) {
+        const DarlingAnimator* a = &it->anim;
+        if (!a->active || !darling_window_is_local(it)) {
+            continue;
+        }
+
+        double due = a->lastTickMs + a->refreshMs - now;
+        due = due > 0.0 ? due : 0.0;
+        wait = wait < 0.0 || due < wait ? due : wait;
+    }
+    darling_unlock();
+    return wait;
+}
+
+void darling_anim_free(DarlingWindow* win) {
+    DarlingAnimator* a = &win->anim;
+    a->cancelled += a->active;
+    memset(a->tweens, 0, sizeof(a->tweens));
+    a->active = 0;
+}
+
+// Public API - Animations
+
+uint32_t darling_animate(DarlingWindow* win, const DarlingTween* tween) {
+    if (!win || !win->hwnd || !tween || tween->property >= DARLING_ANIM_PROPERTY_COUNT ||
+        tween->easing > DARLING_EASE_CUBIC_BEZIER || !(tween->durationMs >= 0.0) || !(tween->delayMs >= 0.0)) {
+        return 0;
+    }
+
+    const float* b = tween->bezier;
+    if (tween->easing == DARLING_EASE_CUBIC_BEZIER && !(b[0] >= 0.0f && b[0] <= 1.0f && b[2] >= 0.0f && b[2] <= 1.0f)) {
+        return 0;
+    }
+
+    uint32_t property = tween->property;
+    DarlingAnimTween t;
+    memset(&t, 0, sizeof(t));
+    t.easing = tween->easing;
+    memcpy(t.bezier, tween->bezier, sizeof(t.bezier));
+    t.to[0] = tween->to[0];
+    t.to[1] = tween->to[1];
+    t.durationMs = tween->durationMs;
+
+    if (!darling_anim_accept(property, t.to)) {
+        return 0;
+    }
+
+    // Read the window before taking the lock; a running tween's last
+    // value replaces it below
+    if (tween->hasFrom) {
+        t.from[0] = tween->from[0];
+        t.from[1] = tween->from[1];
+        if (!darling_anim_accept(property, t.from)) {
+            return 0;
+        }
+    } else {
+        darling_anim_read(win, property, t.from);
+    }
+    double refreshMs = darling_anim_refresh_ms(win);
+
+    DarlingAnimEnds replaced = {0};
+
+    darling_lock();
+    DarlingAnimator* a = &win->anim;
+    DarlingAnimTween* slot = &a->tweens[property];
+    if (slot->id) {
+        if (!tween->hasFrom && slot->written) {
+            t.from[0] = slot->current[0];
+            t.from[1] = slot->current[1];
+        }
+        darling_anim_end(a, property, FALSE, &replaced);
+    }
+
+    g_anim_next_id = g_anim_next_id + 1u ? g_anim_next_id + 1u : 1u;
+    t.id = g_anim_next_id;
+    t.startMs = darling_anim_now() + tween->delayMs;
+    *slot = t;
+
+    // An idle window ticks at once
+    if (!a->active) {
+        a->lastTickMs = -1e300;
+    }
+    a->active++;
+    a->started++;
+    a->refreshMs = refreshMs;
+    HWND hwnd = win->hwnd;
+    uint32_t id = t.id;
+    darling_unlock();
+
+    darling_anim_report(hwnd, &replaced, 0u);
+    darling_anim_wake(win);
+    return id;
+}
+
+void darling_animate_cancel(DarlingWindow* win, uint32_t id) {
+    if (!win) {
+        return;
+    }
+
+    DarlingAnimEnds ends;
+    ends.count = 0;
+
+    darling_lock();
+    DarlingAnimator* a = &win->anim;
+    for (uint32_t p = 0; p < DARLING_ANIM_PROPERTY_COUNT; p++) {
+        if (a->tweens[p].id && (id == 0 || a->tweens[p].id == id)) {
+            darling_anim_end(a, p, FALSE, &ends);
+        }
+    }
+    HWND hwnd = win->hwnd;
+    darling_unlock();
+
+    darling_anim_report(hwnd, &ends, 0u);
+}
+
+void darling_get_animation_stats(DarlingWindow* win, DarlingAnimationStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingAnimationStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        const DarlingAnimator* a = &win->anim;
+        stats.active = a->active;
+        stats.refreshMs = a->refreshMs;
+        stats.started = a->started;
+        stats.finished = a->finished;
+        stats.cancelled = a->cancelled;
+        stats.ticks = a->ticks;
+        stats.applied = a->applied;
+        darling_unlock();
+    }
+
+    *out = stats;
+}
+
+void darling_set_animation_callback(DarlingAnimationCallback callback) {
+    g_anim_callback = callback;
+}
+
+void darling_set_animation_clock(DarlingClock clock, void* ctx) {
+    darling_lock();
+    g_anim_clock = clock;
+    g_anim_clock_ctx = ctx;
+    darling_unlock();
+}
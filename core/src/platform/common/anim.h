@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+
+// Animations
+// One tween slot per property. A tick evaluates the running tweens at the
+// animation clock's time into a frame of new values, which the backend
+// writes to the window together, outside the library lock.
+
+#define DARLING_ANIM_REFRESH_MS (1000.0 / 60.0)     // when the monitor's rate is unknown
+#define DARLING_ANIM_SLACK 0.25                     // of a period a poller may tick early
+#define DARLING_ANIM_BATCH 32u                      // windows ticked per pass
+
+typedef struct DarlingAnimTween {
+    uint32_t id;                    // 0 when the slot is free
+    uint32_t easing;
+    float bezier[4];
+    int32_t from[2];
+    int32_t to[2];
+    int32_t current[2];             // last value written
+    BOOL written;                   // `current` holds a value
+    double startMs;                 // clock time it starts moving, after the delay
+    double durationMs;
+} DarlingAnimTween;
+
+// Values to write to a window at once
+typedef struct DarlingAnimFrame {
+    uint32_t mask;                  // 1 << property for each value set
+    int32_t values[DARLING_ANIM_PROPERTY_COUNT][2];
+} DarlingAnimFrame;
+
+// Tweens that ended in a tick or a cancel
+typedef struct DarlingAnimEnds {
+    uint32_t count;
+    uint32_t ids[DARLING_ANIM_PROPERTY_COUNT];
+    uint32_t properties[DARLING_ANIM_PROPERTY_COUNT];
+} DarlingAnimEnds;
+
+typedef struct DarlingAnimator {
+    DarlingAnimTween tweens[DARLING_ANIM_PROPERTY_COUNT];
+    uint32_t active;
+    double refreshMs;               // 0 until the first tween
+    double lastTickMs;
+
+    uint64_t started;
+    uint64_t finished;
+    uint64_t cancelled;
+    uint64_t ticks;
+    uint64_t applied;
+} DarlingAnimator;
@@ -0,0 +1,46 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides darling_apply_frame_change.
+
+// Appearance Transactions
+// Attribute setters request a frame change instead of recalculating the
+// non-client area themselves. Outside a transaction the change is applied
+// immediately; inside one it is deferred to the outermost commit, so any
+// number of setters cost a single frame recalculation and redraw.
+
+void darling_request_frame_change(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    if (win->appearanceDepth > 0) {
+        win->frameChangePending = TRUE;
+        return;
+    }
+
+    darling_apply_frame_change(win);
+}
+
+// Public API - Appearance Transactions
+
+void darling_begin_appearance_update(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    win->appearanceDepth++;
+}
+
+void darling_commit_appearance_update(DarlingWindow* win) {
+    if (!win || win->appearanceDepth == 0) {
+        return;
+    }
+
+    win->appearanceDepth--;
+
+    if (win->appearanceDepth == 0 && win->frameChangePending) {
+        win->frameChangePending = FALSE;
+        if (win->hwnd) {
+            darling_apply_frame_change(win);
+        }
+    }
+}
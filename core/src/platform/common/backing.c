@@ -0,0 +1,260 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h and list.c. The backend provides
+// darling_alloc_backing_store, darling_present_backing_store,
+// darling_free_gdi and darling_is_window_hidden.
+#include <stdlib.h>
+#include <string.h>
+
+// Backing-Store Accounting
+// Totals are maintained incrementally under the global lock as stores are
+// allocated and freed, so stats and budget checks never walk the list.
+
+static DarlingMemoryStats g_memory;
+static DarlingEvictionMode g_eviction_mode = DARLING_EVICT_RELEASE;
+static DarlingFrameRequestCallback g_frame_request_callback = NULL;
+static uint64_t g_present_clock = 0;
+
+static uint64_t darling_backing_bytes(const DarlingWindow* win) {
+    return win->dibBits ? (uint64_t)win->bitmapWidth * win->bitmapHeight * 4u : 0;
+}
+
+static void darling_backing_drop_evicted_locked(DarlingWindow* win) {
+    if (!win->evicted) {
+        return;
+    }
+
+    g_memory.compressedBytes -= win->evictedSize;
+    g_memory.evictedStores--;
+
+    free(win->evictedPixels);
+    win->evictedPixels = NULL;
+    win->evictedSize = 0;
+    win->evicted = FALSE;
+}
+
+void darling_backing_account_alloc(DarlingWindow* win, uint32_t gdi_objects) {
+    darling_lock();
+
+    // A fresh store supersedes anything kept from an eviction
+    darling_backing_drop_evicted_locked(win);
+
+    win->gdiObjects = gdi_objects;
+    g_memory.backingBytes += darling_backing_bytes(win);
+    g_memory.gdiObjects += gdi_objects;
+    g_memory.backingStores++;
+
+    darling_unlock();
+}
+
+void darling_backing_account_free(DarlingWindow* win) {
+    if (!win->dibBits) {
+        return;
+    }
+
+    darling_lock();
+
+    g_memory.backingBytes -= darling_backing_bytes(win);
+    g_memory.gdiObjects -= win->gdiObjects;
+    g_memory.backingStores--;
+    win->gdiObjects = 0;
+
+    darling_unlock();
+}
+
+// Record a present for LRU ordering; a store allocated for it may have
+// pushed the total over budget
+void darling_backing_touch(DarlingWindow* win) {
+    darling_lock();
+
+    win->lastPresent = ++g_present_clock;
+    if (g_memory.budgetBytes && g_memory.backingBytes > g_memory.budgetBytes) {
+        darling_backing_enforce_budget();
+    }
+
+    darling_unlock();
+}
+
+// Keep a compressed copy only when it is at most half the raw size
+static void darling_backing_compress_locked(DarlingWindow* win) {
+    size_t pixels = (size_t)win->bitmapWidth * (size_t)win->bitmapHeight;
+    size_t capacity = pixels / 2u;
+    if (capacity < 2) {
+        return;
+    }
+
+    uint32_t* words = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (!words) {
+        return;
+    }
+
+    size_t used = darling_frame_rle_encode((const uint32_t*)win->dibBits, pixels, words, capacity);
+    if (used == 0) {
+        free(words);
+        return;
+    }
+
+    uint32_t* shrunk = (uint32_t*)realloc(words, used * sizeof(uint32_t));
+    win->evictedPixels = shrunk ? shrunk : words;
+    win->evictedSize = used * sizeof(uint32_t);
+}
+
+static void darling_backing_evict_locked(DarlingWindow* win) {
+    uint32_t w = win->bitmapWidth;
+    uint32_t h = win->bitmapHeight;
+
+    if (g_eviction_mode == DARLING_EVICT_COMPRESS) {
+        darling_backing_compress_locked(win);
+    }
+
+    // Previews keep showing the last contents
+    darling_thumbnail_sync(win);
+
+    darling_free_gdi(win);
+
+    win->evicted = TRUE;
+    win->evictedWidth = w;
+    win->evictedHeight = h;
+    win->evictionCount++;
+
+    g_memory.compressedBytes += win->evictedSize;
+    g_memory.evictedStores++;
+    g_memory.evictions++;
+}
+
+// Evict hidden windows, least recently presented first, until live stores
+// fit the budget. Visible windows are never evicted.
+void darling_backing_enforce_budget(void) {
+    darling_lock();
+
+    while (g_memory.budgetBytes && g_memory.backingBytes > g_memory.budgetBytes) {
+        DarlingWindow* victim = NULL;
+
+        for (DarlingWindow* it = g_window_head; it; it = it->next) {
+            if (!it->dibBits || !darling_is_window_hidden(it)) {
+                continue;
+            }
+            if (!victim || it->lastPresent < victim->lastPresent) {
+                victim = it;
+            }
+        }
+
+        if (!victim) {
+            break;
+        }
+
+        darling_backing_evict_locked(victim);
+    }
+
+    darling_unlock();
+}
+
+// Called when a window becomes visible again
+void darling_backing_on_shown(DarlingWindow* win) {
+    if (!win || !win->hwnd || !win->evicted) {
+        return;
+    }
+
+    darling_lock();
+
+    if (!win->evicted) {
+        darling_unlock();
+        return;
+    }
+
+    uint32_t* packed = (uint32_t*)win->evictedPixels;
+    size_t words = win->evictedSize / sizeof(uint32_t);
+    size_t pixels = (size_t)win->evictedWidth * (size_t)win->evictedHeight;
+    BOOL restored = FALSE;
+
+    // Detach the copy first: allocating the store drops evicted state
+    win->evictedPixels = NULL;
+    g_memory.compressedBytes -= win->evictedSize;
+    win->evictedSize = 0;
+
+    if (packed && darling_alloc_backing_store(win, win->evictedWidth, win->evictedHeight)) {
+        restored = darling_frame_rle_decode(packed, words, (uint32_t*)win->dibBits, pixels) ? TRUE : FALSE;
+        if (!restored) {
+            memset(win->dibBits, 0, pixels * 4u);
+            darling_thumbnail_damage(win, 0, 0, (int32_t)win->evictedWidth, (int32_t)win->evictedHeight);
+        }
+    }
+
+    free(packed);
+
+    if (win->evicted) {
+        win->evicted = FALSE;
+        g_memory.evictedStores--;
+    }
+
+    if (restored) {
+        g_memory.restores++;
+    } else {
+        g_memory.frameRequests++;
+    }
+
+    darling_unlock();
+
+    if (restored) {
+        darling_present_backing_store(win);
+        darling_backing_touch(win);
+    } else if (win->surface.width) {
+        // A virtual surface redraws itself from its tiles
+        darling_surface_refresh(win);
+    } else if (g_frame_request_callback) {
+        g_frame_request_callback((uintptr_t)win->hwnd);
+    }
+}
+
+// Called when a window is destroyed
+void darling_backing_discard(DarlingWindow* win) {
+    darling_lock();
+    darling_backing_drop_evicted_locked(win);
+    darling_unlock();
+}
+
+// Public API - Backing-Store Memory
+
+void darling_set_memory_budget(uint64_t bytes, DarlingEvictionMode mode) {
+    darling_lock();
+    g_memory.budgetBytes = bytes;
+    g_eviction_mode = mode == DARLING_EVICT_COMPRESS ? DARLING_EVICT_COMPRESS : DARLING_EVICT_RELEASE;
+    darling_unlock();
+
+    darling_backing_enforce_budget();
+}
+
+void darling_get_memory_stats(DarlingMemoryStats* out) {
+    if (!out) {
+        return;
+    }
+
+    darling_lock();
+    *out = g_memory;
+    darling_unlock();
+}
+
+void darling_get_window_memory_stats(DarlingWindow* win, DarlingMemoryStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingMemoryStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        stats.backingBytes = darling_backing_bytes(win);
+        stats.compressedBytes = win->evictedSize;
+        stats.gdiObjects = win->gdiObjects;
+        stats.backingStores = win->dibBits ? 1u : 0u;
+        stats.evictedStores = win->evicted ? 1u : 0u;
+        stats.evictions = win->evictionCount;
+        stats.budgetBytes = g_memory.budgetBytes;
+        darling_unlock();
+    }
+
+    *out = stats;
+}
+
+void darling_set_frame_request_callback(DarlingFrameRequestCallback callback) {
+    g_frame_request_callback = callback;
+}
@@ -0,0 +1,591 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides darling_compositor_invalidate
+// and calls darling_compositor_flush when the window is painted.
+#include <stdlib.h>
+#include <string.h>
+
+// Damage Rectangles
+
+static int64_t darling_rect_area(const DarlingDamageRect* r) {
+    if (r->x1 <= r->x0 || r->y1 <= r->y0) {
+        return 0;
+    }
+    return (int64_t)(r->x1 - r->x0) * (int64_t)(r->y1 - r->y0);
+}
+
+static DarlingDamageRect darling_rect_union(const DarlingDamageRect* a, const DarlingDamageRect* b) {
+    DarlingDamageRect u;
+    u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return u;
+}
+
+static BOOL darling_rect_intersect(const DarlingDamageRect* a, const DarlingDamageRect* b, DarlingDamageRect* out) {
+    out->x0 = a->x0 > b->x0 ? a->x0 : b->x0;
+    out->y0 = a->y0 > b->y0 ? a->y0 : b->y0;
+    out->x1 = a->x1 < b->x1 ? a->x1 : b->x1;
+    out->y1 = a->y1 < b->y1 ? a->y1 : b->y1;
+    return out->x0 < out->x1 && out->y0 < out->y1;
+}
+
+static DarlingDamageRect darling_layer_rect(const DarlingLayer* layer) {
+    DarlingDamageRect r = {
+        layer->x, layer->y,
+        layer->x + (int32_t)layer->width, layer->y + (int32_t)layer->height
+    };
+    return r;
+}
+
+// Add `r` to a list of at most DARLING_DAMAGE_MAX rectangles. Rectangles
+// whose union wastes at most a quarter of its area merge; when the list is
+// full, whichever rectangle grows least absorbs `r`.
+static void darling_damage_insert(DarlingDamageRect* rects, uint32_t* count, DarlingDamageRect r) {
+    BOOL merged = TRUE;
+
+    while (merged) {
+        merged = FALSE;
+        for (uint32_t i = 0; i < *count; i++) {
+            DarlingDamageRect u = darling_rect_union(&rects[i], &r);
+            int64_t sum = darling_rect_area(&rects[i]) + darling_rect_area(&r);
+
+            if (darling_rect_area(&u) * 4 <= sum * 5) {
+                r = u;
+                rects[i] = rects[--*count];
+                merged = TRUE;
+                break;
+            }
+        }
+    }
+
+    if (*count < DARLING_DAMAGE_MAX) {
+        rects[(*count)++] = r;
+        return;
+    }
+
+    uint32_t best = 0;
+    int64_t bestGrowth = INT64_MAX;
+    for (uint32_t i = 0; i < *count; i++) {
+        DarlingDamageRect u = darling_rect_union(&rects[i], &r);
+        int64_t growth = darling_rect_area(&u) - darling_rect_area(&rects[i]);
+        if (growth < bestGrowth) {
+            bestGrowth = growth;
+            best = i;
+        }
+    }
+    rects[best] = darling_rect_union(&rects[best], &r);
+}
+
+void darling_compositor_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    DarlingDamageRect r = { x0 < 0 ? 0 : x0, y0 < 0 ? 0 : y0, x1, y1 };
+    if (darling_rect_area(&r) == 0) {
+        return;
+    }
+
+    darling_lock();
+    darling_damage_insert(win->compositor.damage, &win->compositor.damageCount, r);
+    darling_unlock();
+
+    darling_compositor_invalidate(win, &r);
+}
+
+// Content Frame
+
+static BOOL darling_compositor_active(const DarlingCompositor* c) {
+    return c->count > 0 || c->content != NULL;
+}
+
+// Keep the content frame the size of the backing store. A new buffer starts
+// from the current backing store so what is on screen is preserved.
+static BOOL darling_compositor_fit_content(DarlingWindow* win) {
+    DarlingCompositor* c = &win->compositor;
+    uint32_t w = win->bitmapWidth;
+    uint32_t h = win->bitmapHeight;
+
+    if (c->content && c->contentWidth == w && c->contentHeight == h) {
+        return TRUE;
+    }
+
+    free(c->content);
+    c->content = NULL;
+    c->contentWidth = 0;
+    c->contentHeight = 0;
+
+    if (!win->dibBits || !darling_frame_size_ok(w, h)) {
+        return FALSE;
+    }
+
+    c->content = (uint32_t*)malloc((size_t)w * (size_t)h * 4u);
+    if (!c->content) {
+        return FALSE;
+    }
+
+    memcpy(c->content, win->dibBits, (size_t)w * (size_t)h * 4u);
+    c->contentWidth = w;
+    c->contentHeight = h;
+
+    DarlingDamageRect all = { 0, 0, (int32_t)w, (int32_t)h };
+    darling_damage_insert(c->damage, &c->damageCount, all);
+    return TRUE;
+}
+
+// Where the paint path writes content pixels: the content frame while the
+// window has layers, NULL when it paints the backing store directly
+uint8_t* darling_compositor_content(DarlingWindow* win) {
+    DarlingCompositor* c = &win->compositor;
+    uint8_t* content = NULL;
+
+    darling_lock();
+    if (darling_compositor_active(c) && darling_compositor_fit_content(win)) {
+        content = (uint8_t*)c->content;
+    }
+    darling_unlock();
+
+    return content;
+}
+
+// Composition
+
+static void darling_compose_copy(uint32_t* dst, size_t dstStride, const uint32_t* src, size_t srcStride, const DarlingDamageRect* r) {
+    uint32_t w = (uint32_t)(r->x1 - r->x0);
+    for (int32_t y = r->y0; y < r->y1; y++) {
+        memcpy(dst + (size_t)y * dstStride + (size_t)r->x0, src + (size_t)y * srcStride + (size_t)r->x0, (size_t)w * 4u);
+    }
+}
+
+static void darling_compose_layer(uint32_t* dst, size_t dstStride, const DarlingLayer* layer, const DarlingDamageRect* r, BOOL copy) {
+    uint32_t w = (uint32_t)(r->x1 - r->x0);
+
+    for (int32_t y = r->y0; y < r->y1; y++) {
+        uint32_t* row = dst + (size_t)y * dstStride + (size_t)r->x0;
+        const uint32_t* src = layer->pixels + (size_t)(y - layer->y) * layer->width + (size_t)(r->x0 - layer->x);
+
+        if (copy) {
+            memcpy(row, src, (size_t)w * 4u);
+        } else {
+            darling_frame_blend_over(row, src, w, layer->opacity);
+        }
+    }
+}
+
+typedef struct DarlingComposeJob {
+    DarlingWindow* win;
+    DarlingDamageRect rect;
+    int32_t start;              // bottom layer drawn, -1 = content
+} DarlingComposeJob;
+
+// Rows [begin, end) of the job's rectangle; run on the frame thread pool
+static void darling_compose_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingComposeJob* job = (const DarlingComposeJob*)ctx;
+    const DarlingCompositor* c = &job->win->compositor;
+    uint32_t* dib = (uint32_t*)job->win->dibBits;
+    size_t stride = job->win->bitmapWidth;
+
+    DarlingDamageRect r = job->rect;
+    r.y0 = job->rect.y0 + (int32_t)begin;
+    r.y1 = job->rect.y0 + (int32_t)end;
+
+    if (job->start < 0) {
+        darling_compose_copy(dib, stride, c->content, c->contentWidth, &r);
+    } else {
+        darling_compose_layer(dib, stride, &c->layers[job->start], &r, TRUE);
+    }
+
+    for (uint32_t i = (uint32_t)(job->start + 1); i < c->count; i++) {
+        const DarlingLayer* layer = &c->layers[i];
+        DarlingDamageRect lr = darling_layer_rect(layer);
+        DarlingDamageRect part;
+
+        if (layer->visible && layer->opacity != 0 && darling_rect_intersect(&lr, &r, &part)) {
+            darling_compose_layer(dib, stride, layer, &part, FALSE);
+        }
+    }
+}
+
+static void darling_compose_rect(DarlingWindow* win, const DarlingDamageRect* r) {
+    DarlingCompositor* c = &win->compositor;
+    int64_t area = darling_rect_area(r);
+
+    // Topmost opaque layer covering the whole rectangle hides everything below
+    int32_t start = -1;
+    for (int32_t i = (int32_t)c->count - 1; i >= 0; i--) {
+        const DarlingLayer* layer = &c->layers[i];
+        DarlingDamageRect lr = darling_layer_rect(layer);
+        DarlingDamageRect part;
+
+        if (!layer->visible || layer->opacity == 0 || !darling_rect_intersect(&lr, r, &part)) {
+            continue;
+        }
+        if (layer->opacity == 255 && layer->translucent == 0 &&
+            lr.x0 <= r->x0 && lr.y0 <= r->y0 && lr.x1 >= r->x1 && lr.y1 >= r->y1) {
+            start = i;
+            break;
+        }
+    }
+
+    if (start >= 0) {
+        c->culledPixels += (uint64_t)area;
+        for (int32_t i = 0; i < start; i++) {
+            DarlingDamageRect lr = darling_layer_rect(&c->layers[i]);
+            DarlingDamageRect part;
+            if (c->layers[i].visible && darling_rect_intersect(&lr, r, &part)) {
+                c->culledPixels += (uint64_t)darling_rect_area(&part);
+            }
+        }
+    }
+
+    DarlingComposeJob job = { win, *r, start };
+    darling_pool_for_rows((uint32_t)(r->y1 - r->y0), (size_t)(r->x1 - r->x0) * 4u, darling_compose_rows, &job);
+
+    c->compositedPixels += (uint64_t)area;
+    darling_thumbnail_damage(win, r->x0, r->y0, r->x1, r->y1);
+}
+
+// Composite the damaged rectangles into the backing store. Called by the
+// backend before it presents; returns TRUE if anything was composited.
+BOOL darling_compositor_flush(DarlingWindow* win) {
+    DarlingCompositor* c = &win->compositor;
+
+    if (!darling_compositor_active(c) || c->damageCount == 0) {
+        return FALSE;
+    }
+
+    darling_lock();
+
+    // Layers can exist before the first content frame
+    if (!win->dibBits) {
+        int32_t cw = 0;
+        int32_t ch = 0;
+        darling_query_client_size(win, &cw, &ch);
+        if (cw <= 0 || ch <= 0 || !darling_alloc_backing_store(win, (uint32_t)cw, (uint32_t)ch)) {
+            darling_unlock();
+            return FALSE;
+        }
+        memset(win->dibBits, 0, (size_t)win->bitmapWidth * win->bitmapHeight * 4u);
+        darling_thumbnail_damage(win, 0, 0, (int32_t)win->bitmapWidth, (int32_t)win->bitmapHeight);
+    }
+
+    if (!darling_compositor_fit_content(win)) {
+        darling_unlock();
+        return FALSE;
+    }
+
+    DarlingDamageRect bounds = { 0, 0, (int32_t)win->bitmapWidth, (int32_t)win->bitmapHeight };
+    for (uint32_t i = 0; i < c->damageCount; i++) {
+        DarlingDamageRect r;
+        if (darling_rect_intersect(&c->damage[i], &bounds, &r)) {
+            darling_compose_rect(win, &r);
+        }
+    }
+
+    c->damageCount = 0;
+    c->flushes++;
+
+    // Back to painting the backing store directly once the last layer is gone
+    if (c->count == 0) {
+        free(c->content);
+        c->content = NULL;
+        c->contentWidth = 0;
+        c->contentHeight = 0;
+    }
+
+    darling_unlock();
+
+    darling_timing_draw_overlay(win);
+    return TRUE;
+}
+
+void darling_compositor_free(DarlingWindow* win) {
+    DarlingCompositor* c = &win->compositor;
+
+    for (uint32_t i = 0; i < c->count; i++) {
+        free(c->layers[i].pixels);
+    }
+
+    free(c->layers);
+    free(c->content);
+    memset(c, 0, sizeof(*c));
+}
+
+// Layers
+
+static int32_t darling_layer_index(const DarlingCompositor* c, int32_t id) {
+    for (uint32_t i = 0; i < c->count; i++) {
+        if (c->layers[i].id == id) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Restore (z, id) order after layer `index` changed its z
+static void darling_layer_resort(DarlingCompositor* c, uint32_t index) {
+    DarlingLayer moved = c->layers[index];
+
+    while (index > 0 && (c->layers[index - 1].z > moved.z ||
+           (c->layers[index - 1].z == moved.z && c->layers[index - 1].id > moved.id))) {
+        c->layers[index] = c->layers[index - 1];
+        index--;
+    }
+    while (index + 1 < c->count && (c->layers[index + 1].z < moved.z ||
+           (c->layers[index + 1].z == moved.z && c->layers[index + 1].id < moved.id))) {
+        c->layers[index] = c->layers[index + 1];
+        index++;
+    }
+
+    c->layers[index] = moved;
+}
+
+static size_t darling_count_translucent(const uint32_t* px, uint32_t stride, uint32_t w, uint32_t h) {
+    size_t n = 0;
+    for (uint32_t y = 0; y < h; y++) {
+        const uint32_t* row = px + (size_t)y * stride;
+        for (uint32_t x = 0; x < w; x++) {
+            n += (row[x] >> 24) != 255u;
+        }
+    }
+    return n;
+}
+
+static void darling_damage_layer(DarlingWindow* win, const DarlingLayer* layer) {
+    DarlingDamageRect r = darling_layer_rect(layer);
+    darling_compositor_damage(win, r.x0, r.y0, r.x1, r.y1);
+}
+
+// Public API - Layers
+
+int32_t darling_layer_create(DarlingWindow* win, int32_t x, int32_t y, uint32_t width, uint32_t height, int32_t z) {
+    if (!win || !darling_frame_size_ok(width, height) || width > INT32_MAX || height > INT32_MAX) {
+        return -1;
+    }
+
+    uint32_t* pixels = (uint32_t*)calloc((size_t)width * (size_t)height, 4u);
+    if (!pixels) {
+        return -1;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+    int32_t id = -1;
+
+    darling_lock();
+
+    if (c->count == c->capacity) {
+        uint32_t grown = c->capacity ? c->capacity * 2u : 4u;
+        DarlingLayer* layers = (DarlingLayer*)realloc(c->layers, grown * sizeof(DarlingLayer));
+        if (!layers) {
+            darling_unlock();
+            free(pixels);
+            return -1;
+        }
+        c->layers = layers;
+        c->capacity = grown;
+    }
+
+    // The first layer moves the current frame into the content buffer
+    if (c->count == 0 && win->dibBits) {
+        darling_compositor_fit_content(win);
+    }
+
+    DarlingLayer* layer = &c->layers[c->count];
+    memset(layer, 0, sizeof(*layer));
+    layer->id = id = c->nextId++;
+    layer->x = x;
+    layer->y = y;
+    layer->width = width;
+    layer->height = height;
+    layer->z = z;
+    layer->opacity = 255;
+    layer->visible = TRUE;
+    layer->pixels = pixels;
+    layer->translucent = (size_t)width * (size_t)height;
+    c->count++;
+    darling_layer_resort(c, c->count - 1u);
+
+    darling_unlock();
+
+    // Fully transparent until updated, so there is nothing to damage yet
+    return id;
+}
+
+void darling_layer_destroy(DarlingWindow* win, int32_t id) {
+    if (!win) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0) {
+        darling_unlock();
+        return;
+    }
+
+    DarlingLayer removed = c->layers[index];
+    memmove(&c->layers[index], &c->layers[index + 1], (c->count - (uint32_t)index - 1u) * sizeof(DarlingLayer));
+    c->count--;
+    darling_unlock();
+
+    darling_damage_layer(win, &removed);
+    free(removed.pixels);
+}
+
+void darling_layer_set_position(DarlingWindow* win, int32_t id, int32_t x, int32_t y) {
+    if (!win) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0 || (c->layers[index].x == x && c->layers[index].y == y)) {
+        darling_unlock();
+        return;
+    }
+
+    DarlingLayer before = c->layers[index];
+    c->layers[index].x = x;
+    c->layers[index].y = y;
+    DarlingLayer after = c->layers[index];
+    darling_unlock();
+
+    darling_damage_layer(win, &before);
+    darling_damage_layer(win, &after);
+}
+
+void darling_layer_set_z(DarlingWindow* win, int32_t id, int32_t z) {
+    if (!win) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0 || c->layers[index].z == z) {
+        darling_unlock();
+        return;
+    }
+
+    c->layers[index].z = z;
+    DarlingLayer layer = c->layers[index];
+    darling_layer_resort(c, (uint32_t)index);
+    darling_unlock();
+
+    darling_damage_layer(win, &layer);
+}
+
+void darling_layer_set_opacity(DarlingWindow* win, int32_t id, uint8_t opacity) {
+    if (!win) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0 || c->layers[index].opacity == opacity) {
+        darling_unlock();
+        return;
+    }
+
+    c->layers[index].opacity = opacity;
+    DarlingLayer layer = c->layers[index];
+    darling_unlock();
+
+    darling_damage_layer(win, &layer);
+}
+
+void darling_layer_set_visible(DarlingWindow* win, int32_t id, int visible) {
+    if (!win) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+    BOOL show = visible ? TRUE : FALSE;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0 || c->layers[index].visible == show) {
+        darling_unlock();
+        return;
+    }
+
+    c->layers[index].visible = show;
+    DarlingLayer layer = c->layers[index];
+    darling_unlock();
+
+    darling_damage_layer(win, &layer);
+}
+
+void darling_layer_update(
+    DarlingWindow* win,
+    int32_t id,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height,
+    int premultiplied
+) {
+    if (!win || !bgra_data || width == 0 || height == 0) {
+        return;
+    }
+
+    DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    int32_t index = darling_layer_index(c, id);
+    if (index < 0) {
+        darling_unlock();
+        return;
+    }
+
+    DarlingLayer* layer = &c->layers[index];
+    if (x >= layer->width || y >= layer->height || width > layer->width - x || height > layer->height - y) {
+        darling_unlock();
+        return;
+    }
+
+    uint32_t* dst = layer->pixels + (size_t)y * layer->width + x;
+    size_t rowBytes = (size_t)width * 4u;
+
+    layer->translucent -= darling_count_translucent(dst, layer->width, width, height);
+
+    DarlingPoolOp op = premultiplied ? DARLING_POOL_COPY : DARLING_POOL_PREMULTIPLY;
+    darling_pool_convert((uint8_t*)dst, (size_t)layer->width * 4u, bgra_data, rowBytes, width, height, op);
+
+    layer->translucent += darling_count_translucent(dst, layer->width, width, height);
+
+    int32_t x0 = layer->x + (int32_t)x;
+    int32_t y0 = layer->y + (int32_t)y;
+    BOOL visible = layer->visible && layer->opacity != 0;
+    darling_unlock();
+
+    if (visible) {
+        darling_compositor_damage(win, x0, y0, x0 + (int32_t)width, y0 + (int32_t)height);
+    }
+}
+
+void darling_get_compositor_stats(DarlingWindow* win, DarlingCompositorStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    const DarlingCompositor* c = &win->compositor;
+
+    darling_lock();
+    out->layers = c->count;
+    out->damageRects = c->damageCount;
+    out->flushes = c->flushes;
+    out->compositedPixels = c->compositedPixels;
+    out->culledPixels = c->culledPixels;
+    darling_unlock();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <stdint.h>
+
+// Layer Compositor
+// A window with layers keeps its content frame in `content` instead of the
+// backing store and composites content plus layers (premultiplied BGRA,
+// ascending z) into the backing store when it is painted. Only damaged
+// rectangles are recomposited, and inside each one everything below the
+// topmost opaque layer covering it is skipped.
+
+#define DARLING_DAMAGE_MAX 16u
+
+typedef struct DarlingDamageRect {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;                 // exclusive
+    int32_t y1;
+} DarlingDamageRect;
+
+typedef struct DarlingLayer {
+    int32_t id;
+    int32_t x;
+    int32_t y;
+    uint32_t width;
+    uint32_t height;
+    int32_t z;
+    uint8_t opacity;
+    BOOL visible;
+    uint32_t* pixels;           // premultiplied BGRA, width * height
+    size_t translucent;         // pixels with alpha < 255
+} DarlingLayer;
+
+typedef struct DarlingCompositor {
+    DarlingLayer* layers;       // sorted by (z, id)
+    uint32_t count;
+    uint32_t capacity;
+    int32_t nextId;
+
+    uint32_t* content;          // content frame, bitmap-sized
+    uint32_t contentWidth;
+    uint32_t contentHeight;
+
+    DarlingDamageRect damage[DARLING_DAMAGE_MAX];
+    uint32_t damageCount;
+
+    uint64_t flushes;
+    uint64_t compositedPixels;
+    uint64_t culledPixels;
+} DarlingCompositor;
@@ -0,0 +1,710 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h, and after frame.c and compositor.c, whose pixel and
+// rectangle helpers it uses. Drawing only needs the backend's backing store
+// and rectangle invalidation (darling_compositor_invalidate).
+#include <stdlib.h>
+#include <string.h>
+
+// Display List
+
+#define DARLING_DRAW_COORD_MAX 0x40000000           // coordinates are clamped to +-2^30
+
+static int64_t darling_draw_clamp(int64_t v) {
+    return v < -DARLING_DRAW_COORD_MAX ? -DARLING_DRAW_COORD_MAX : v > DARLING_DRAW_COORD_MAX ? DARLING_DRAW_COORD_MAX : v;
+}
+
+static DarlingDamageRect darling_draw_box(int64_t x0, int64_t y0, int64_t x1, int64_t y1) {
+    DarlingDamageRect r = {
+        (int32_t)darling_draw_clamp(x0), (int32_t)darling_draw_clamp(y0),
+        (int32_t)darling_draw_clamp(x1), (int32_t)darling_draw_clamp(y1)
+    };
+    return r;
+}
+
+// Straight 0xAARRGGBB to premultiplied BGRA
+static uint32_t darling_draw_color(uint32_t argb) {
+    return darling_scale_pixel(argb | 0xFF000000u, argb >> 24);
+}
+
+// TRUE if `length` words make a well-formed command of this op
+static BOOL darling_draw_length_ok(uint32_t op, uint32_t length) {
+    switch (op) {
+        case DARLING_DRAW_RECT:
+            return length == 6u;
+        case DARLING_DRAW_LINE:
+            return length == 7u;
+        case DARLING_DRAW_IMAGE:
+            return length == 8u;
+        case DARLING_DRAW_GLYPHS:
+            return length >= 5u && (length - 5u) % 3u == 0u;
+        default:
+            return FALSE;
+    }
+}
+
+static DarlingDamageRect darling_draw_bounds(const uint32_t* w) {
+    uint32_t op = w[0] & 0xFFu;
+
+    if (op == DARLING_DRAW_RECT) {
+        int64_t x = (int32_t)w[1];
+        int64_t y = (int32_t)w[2];
+        return darling_draw_box(x, y, x + (int64_t)w[3], y + (int64_t)w[4]);
+    }
+
+    if (op == DARLING_DRAW_LINE) {
+        int64_t x0 = (int32_t)w[1];
+        int64_t y0 = (int32_t)w[2];
+        int64_t x1 = (int32_t)w[3];
+        int64_t y1 = (int32_t)w[4];
+        int64_t pad = w[6] ? (int64_t)w[6] : 1;
+        return darling_draw_box((x0 < x1 ? x0 : x1) - pad, (y0 < y1 ? y0 : y1) - pad,
+            (x0 > x1 ? x0 : x1) + pad + 1, (y0 > y1 ? y0 : y1) + pad + 1);
+    }
+
+    if (op == DARLING_DRAW_IMAGE) {
+        int64_t x = (int32_t)w[2];
+        int64_t y = (int32_t)w[3];
+        return darling_draw_box(x, y, x + (int64_t)w[6], y + (int64_t)w[7]);
+    }
+
+    // Glyphs: the union of their boxes
+    DarlingDamageRect box = { 0, 0, 0, 0 };
+    uint32_t glyphs = ((w[0] >> 8) - 5u) / 3u;
+    int64_t x = (int32_t)w[3];
+    int64_t y = (int32_t)w[4];
+
+    for (uint32_t i = 0; i < glyphs; i++) {
+        const uint32_t* g = w + 5u + i * 3u;
+        int64_t gx = x + (int16_t)(g[0] & 0xFFFFu);
+        int64_t gy = y + (int16_t)(g[0] >> 16);
+        DarlingDamageRect r = darling_draw_box(gx, gy, gx + (g[2] & 0xFFFFu), gy + (g[2] >> 16));
+        box = darling_rect_area(&box) == 0 ? r : darling_rect_area(&r) == 0 ? box : darling_rect_union(&box, &r);
+    }
+    return box;
+}
+
+static uint64_t darling_draw_hash(const uint32_t* w, uint32_t length) {
+    uint64_t h = 14695981039346656037ull;
+    for (uint32_t i = 0; i < length; i++) {
+        h ^= w[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Split `words` into commands. Returns the count, or -1 if malformed.
+static int64_t darling_draw_parse(const uint32_t* words, size_t count, DarlingDrawCommand* out) {
+    int64_t n = 0;
+    size_t at = 0;
+
+    while (at < count) {
+        uint32_t op = words[at] & 0xFFu;
+        uint32_t length = words[at] >> 8;
+        if (!darling_draw_length_ok(op, length) || length > count - at) {
+            return -1;
+        }
+
+        if (out) {
+            DarlingDrawCommand* c = &out[n];
+            c->offset = (uint32_t)at;
+            c->length = length;
+            c->hash = darling_draw_hash(words + at, length);
+            c->bounds = darling_draw_bounds(words + at);
+        }
+        n++;
+        at += length;
+    }
+    return n;
+}
+
+static BOOL darling_draw_same(const uint32_t* wa, const DarlingDrawCommand* a, const uint32_t* wb, const DarlingDrawCommand* b) {
+    return a->hash == b->hash && a->length == b->length &&
+        memcmp(wa + a->offset, wb + b->offset, (size_t)a->length * 4u) == 0;
+}
+
+static void darling_draw_damage(DarlingDisplayList* dl, const DarlingDamageRect* r) {
+    if (darling_rect_area(r) > 0) {
+        darling_damage_insert(dl->dirty, &dl->dirtyCount, *r);
+    }
+}
+
+// Match the new commands against the old ones in order, searching a window
+// ahead for each. Whatever stays unmatched on either side is damaged; the
+// matched commands keep their relative order, so every pixel outside the
+// damage is drawn by the same commands in the same order as before.
+static void darling_draw_diff(
+    DarlingDisplayList* dl,
+    const uint32_t* oldWords,
+    const DarlingDrawCommand* oldCmds,
+    uint32_t oldCount,
+    const uint32_t* newWords,
+    const DarlingDrawCommand* newCmds,
+    uint32_t newCount
+) {
+    uint32_t next = 0;
+
+    for (uint32_t j = 0; j < newCount; j++) {
+        uint32_t limit = oldCount - next < DARLING_DRAW_MATCH_WINDOW ? oldCount : next + DARLING_DRAW_MATCH_WINDOW;
+        uint32_t k = next;
+        while (k < limit && !darling_draw_same(oldWords, &oldCmds[k], newWords, &newCmds[j])) {
+            k++;
+        }
+
+        if (k == limit) {
+            darling_draw_damage(dl, &newCmds[j].bounds);
+            dl->changed++;
+            continue;
+        }
+
+        for (; next < k; next++) {
+            darling_draw_damage(dl, &oldCmds[next].bounds);
+            dl->changed++;
+        }
+        next = k + 1u;
+        dl->reused++;
+    }
+
+    for (; next < oldCount; next++) {
+        darling_draw_damage(dl, &oldCmds[next].bounds);
+        dl->changed++;
+    }
+}
+
+static DarlingDrawImage* darling_draw_image(const DarlingDisplayList* dl, uint32_t id) {
+    for (uint32_t i = 0; i < dl->imageCount; i++) {
+        if (dl->images[i].id == id) {
+            return &dl->images[i];
+        }
+    }
+    return NULL;
+}
+
+// Rasterization
+// Every draw is clipped to `clip`, which lies inside the target.
+
+static void darling_draw_span(uint32_t* row, int64_t n, uint32_t color) {
+    if ((color >> 24) == 255u) {
+        for (int64_t x = 0; x < n; x++) {
+            row[x] = color;
+        }
+    } else if (color != 0) {
+        for (int64_t x = 0; x < n; x++) {
+            row[x] = darling_blend_pixel(row[x], color, 255u);
+        }
+    }
+}
+
+static void darling_draw_fill(uint32_t* target, size_t stride, const DarlingDamageRect* r, uint32_t color) {
+    for (int32_t y = r->y0; y < r->y1; y++) {
+        darling_draw_span(target + (size_t)y * stride + (size_t)r->x0, r->x1 - r->x0, color);
+    }
+}
+
+// One pixel-wide step along the major axis draws `width` pixels across it,
+// so no pixel is blended twice
+static void darling_draw_line(uint32_t* target, size_t stride, const DarlingDamageRect* clip, const uint32_t* w) {
+    int64_t x0 = darling_draw_clamp((int32_t)w[1]);
+    int64_t y0 = darling_draw_clamp((int32_t)w[2]);
+    int64_t x1 = darling_draw_clamp((int32_t)w[3]);
+    int64_t y1 = darling_draw_clamp((int32_t)w[4]);
+    uint32_t color = darling_draw_color(w[5]);
+    int64_t width = w[6] ? (int64_t)(w[6] < 4096u ? w[6] : 4096u) : 1;
+
+    BOOL xMajor = (x1 > x0 ? x1 - x0 : x0 - x1) >= (y1 > y0 ? y1 - y0 : y0 - y1);
+    int64_t a0 = xMajor ? x0 : y0;              // major axis
+    int64_t b0 = xMajor ? y0 : x0;              // minor axis
+    int64_t da = xMajor ? x1 - x0 : y1 - y0;
+    int64_t db = xMajor ? y1 - y0 : x1 - x0;
+    int64_t sa = da < 0 ? -1 : 1;
+    int64_t sb = db < 0 ? -1 : 1;
+    da = da < 0 ? -da : da;
+    db = db < 0 ? -db : db;
+
+    // Only the steps whose major coordinate falls inside the clip
+    int64_t c0 = xMajor ? clip->x0 : clip->y0;
+    int64_t c1 = xMajor ? clip->x1 : clip->y1;
+    int64_t first = sa > 0 ? c0 - a0 : a0 - c1 + 1;
+    int64_t last = sa > 0 ? c1 - a0 : a0 - c0 + 1;
+    first = first < 0 ? 0 : first;
+    last = last > da + 1 ? da + 1 : last;
+    if (first >= last) {
+        return;
+    }
+
+    // Bresenham with err starting at da / 2, advanced to step `first`
+    int64_t err0 = da / 2;
+    int64_t minorSteps = first * db > err0 && da > 0 ? (first * db - err0 + da - 1) / da : 0;
+    int64_t err = err0 - first * db + minorSteps * da;
+    int64_t b = b0 + sb * minorSteps;
+    int64_t m0 = xMajor ? clip->y0 : clip->x0;
+    int64_t m1 = xMajor ? clip->y1 : clip->x1;
+    int64_t offset = (width - 1) / 2;
+
+    for (int64_t i = first; i < last; i++) {
+        int64_t a = a0 + sa * i;
+        int64_t lo = b - offset;
+        int64_t hi = lo + width;
+        lo = lo < m0 ? m0 : lo;
+        hi = hi > m1 ? m1 : hi;
+
+        if (xMajor) {
+            for (int64_t y = lo; y < hi; y++) {
+                uint32_t* px = target + (size_t)y * stride + (size_t)a;
+                *px = (color >> 24) == 255u ? color : darling_blend_pixel(*px, color, 255u);
+            }
+        } else if (lo < hi) {
+            darling_draw_span(target + (size_t)a * stride + (size_t)lo, hi - lo, color);
+        }
+
+        err -= db;
+        if (err < 0) {
+            b += sb;
+            err += da;
+        }
+    }
+}
+
+// The part of a `width` x `height` source at (sx, sy), drawn at (x, y), that
+// lies inside both the image and the clip. FALSE if none does.
+static BOOL darling_draw_blit_rect(
+    const DarlingDrawImage* img,
+    const DarlingDamageRect* clip,
+    int64_t x,
+    int64_t y,
+    uint32_t sx,
+    uint32_t sy,
+    uint32_t width,
+    uint32_t height,
+    DarlingDamageRect* out
+) {
+    if (sx >= img->width || sy >= img->height) {
+        return FALSE;
+    }
+
+    uint32_t w = width < img->width - sx ? width : img->width - sx;
+    uint32_t h = height < img->height - sy ? height : img->height - sy;
+    DarlingDamageRect r = darling_draw_box(x, y, x + w, y + h);
+    return darling_rect_intersect(&r, clip, out);
+}
+
+static void darling_draw_sprite(const DarlingDisplayList* dl, uint32_t* target, size_t stride, const DarlingDamageRect* clip, const uint32_t* w) {
+    const DarlingDrawImage* img = darling_draw_image(dl, w[1]);
+    int64_t x = (int32_t)w[2];
+    int64_t y = (int32_t)w[3];
+    DarlingDamageRect r;
+
+    if (!img || !darling_draw_blit_rect(img, clip, x, y, w[4], w[5], w[6], w[7], &r)) {
+        return;
+    }
+
+    for (int32_t ry = r.y0; ry < r.y1; ry++) {
+        const uint32_t* src = img->pixels + (size_t)(w[5] + (uint32_t)(ry - y)) * img->width + w[4] + (uint32_t)(r.x0 - x);
+        darling_frame_blend_over(target + (size_t)ry * stride + (size_t)r.x0, src, (size_t)(r.x1 - r.x0), 255);
+    }
+}
+
+static void darling_draw_glyphs(const DarlingDisplayList* dl, uint32_t* target, size_t stride, const DarlingDamageRect* clip, const uint32_t* w) {
+    const DarlingDrawImage* atlas = darling_draw_image(dl, w[1]);
+    if (!atlas) {
+        return;
+    }
+
+    uint32_t color = darling_draw_color(w[2]);
+    uint32_t glyphs = ((w[0] >> 8) - 5u) / 3u;
+    int64_t x = (int32_t)w[3];
+    int64_t y = (int32_t)w[4];
+
+    for (uint32_t i = 0; i < glyphs; i++) {
+        const uint32_t* g = w + 5u + i * 3u;
+        int64_t gx = x + (int16_t)(g[0] & 0xFFFFu);
+        int64_t gy = y + (int16_t)(g[0] >> 16);
+        uint32_t sx = g[1] & 0xFFFFu;
+        uint32_t sy = g[1] >> 16;
+        DarlingDamageRect r;
+
+        if (!darling_draw_blit_rect(atlas, clip, gx, gy, sx, sy, g[2] & 0xFFFFu, g[2] >> 16, &r)) {
+            continue;
+        }
+
+        for (int32_t ry = r.y0; ry < r.y1; ry++) {
+            const uint32_t* src = atlas->pixels + (size_t)(sy + (uint32_t)(ry - gy)) * atlas->width + sx + (uint32_t)(r.x0 - gx);
+            uint32_t* row = target + (size_t)ry * stride + (size_t)r.x0;
+
+            for (int32_t k = 0; k < r.x1 - r.x0; k++) {
+                uint32_t coverage = src[k] >> 24;
+                if (coverage == 0) {
+                    continue;
+                }
+                uint32_t s = coverage == 255u ? color : darling_scale_pixel(color, coverage);
+                row[k] = (s >> 24) == 255u ? s : darling_blend_pixel(row[k], s, 255u);
+            }
+        }
+    }
+}
+
+typedef struct DarlingDrawJob {
+    const DarlingDisplayList* list;
+    uint32_t* target;
+    size_t stride;
+    DarlingDamageRect rect;
+    const uint32_t* hits;           // commands touching rect, in order
+    uint32_t hitCount;
+} DarlingDrawJob;
+
+// Rows [begin, end) of the job's rectangle; run on the frame thread pool
+static void darling_draw_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingDrawJob* job = (const DarlingDrawJob*)ctx;
+    const DarlingDisplayList* dl = job->list;
+
+    DarlingDamageRect clip = job->rect;
+    clip.y0 = job->rect.y0 + (int32_t)begin;
+    clip.y1 = job->rect.y0 + (int32_t)end;
+
+    for (int32_t y = clip.y0; y < clip.y1; y++) {
+        uint32_t* row = job->target + (size_t)y * job->stride + (size_t)clip.x0;
+        for (int32_t x = 0; x < clip.x1 - clip.x0; x++) {
+            row[x] = dl->background;
+        }
+    }
+
+    for (uint32_t i = 0; i < job->hitCount; i++) {
+        const DarlingDrawCommand* c = &dl->commands[job->hits[i]];
+        const uint32_t* w = dl->words + c->offset;
+        DarlingDamageRect part;
+
+        if (!darling_rect_intersect(&c->bounds, &clip, &part)) {
+            continue;
+        }
+
+        switch (w[0] & 0xFFu) {
+            case DARLING_DRAW_RECT:
+                darling_draw_fill(job->target, job->stride, &part, darling_draw_color(w[5]));
+                break;
+            case DARLING_DRAW_LINE:
+                darling_draw_line(job->target, job->stride, &clip, w);
+                break;
+            case DARLING_DRAW_IMAGE:
+                darling_draw_sprite(dl, job->target, job->stride, &clip, w);
+                break;
+            case DARLING_DRAW_GLYPHS:
+                darling_draw_glyphs(dl, job->target, job->stride, &clip, w);
+                break;
+        }
+    }
+}
+
+// Size the backing store to the client area and damage all of it when it
+// no longer holds what the list drew. FALSE if there is nothing to draw
+// into. Called with the lock held.
+static BOOL darling_draw_target(DarlingWindow* win) {
+    DarlingDisplayList* dl = &win->displayList;
+    int32_t cw = 0;
+    int32_t ch = 0;
+    darling_query_client_size(win, &cw, &ch);
+
+    // A minimized window has no client area; keep the store's size
+    uint32_t w = cw > 0 ? (uint32_t)cw : win->bitmapWidth;
+    uint32_t h = ch > 0 ? (uint32_t)ch : win->bitmapHeight;
+    if (w == 0 || h == 0 || !darling_frame_size_ok(w, h)) {
+        return FALSE;
+    }
+
+    if (!win->dibBits || win->bitmapWidth != w || win->bitmapHeight != h) {
+        if (!darling_alloc_backing_store(win, w, h)) {
+            return FALSE;
+        }
+        dl->valid = FALSE;
+    }
+
+    if (!dl->valid || dl->width != w || dl->height != h || dl->evictions != win->evictionCount) {
+        DarlingDamageRect all = { 0, 0, (int32_t)w, (int32_t)h };
+        dl->dirty[0] = all;
+        dl->dirtyCount = 1;
+        dl->width = w;
+        dl->height = h;
+        dl->evictions = win->evictionCount;
+        dl->fullRedraws++;
+    }
+    return TRUE;
+}
+
+// Rasterize the dirty rectangles into the window and present them
+static void darling_draw_rasterize(DarlingWindow* win) {
+    DarlingDisplayList* dl = &win->displayList;
+    DarlingDamageRect rects[DARLING_DAMAGE_MAX];
+    uint32_t count = 0;
+
+    darling_lock();
+
+    if (!darling_draw_target(win)) {
+        dl->valid = FALSE;
+        dl->dirtyCount = 0;
+        darling_unlock();
+        return;
+    }
+
+    if (dl->dirtyCount == 0) {
+        darling_unlock();
+        return;
+    }
+
+    uint32_t* hits = dl->count ? (uint32_t*)malloc((size_t)dl->count * sizeof(uint32_t)) : NULL;
+    if (dl->count && !hits) {
+        dl->valid = FALSE;
+        darling_unlock();
+        return;
+    }
+
+    darling_paint_enter(win, DARLING_PAINT_DISPLAY_LIST);
+    darling_timing_begin(win);
+
+    // With layers the list draws the content layer
+    uint8_t* content = darling_compositor_content(win);
+    uint32_t* target = (uint32_t*)(content ? content : (uint8_t*)win->dibBits);
+    DarlingDamageRect bounds = { 0, 0, (int32_t)dl->width, (int32_t)dl->height };
+
+    for (uint32_t d = 0; d < dl->dirtyCount; d++) {
+        DarlingDrawJob job = { dl, target, dl->width, { 0, 0, 0, 0 }, hits, 0 };
+        if (!darling_rect_intersect(&dl->dirty[d], &bounds, &job.rect)) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < dl->count; i++) {
+            DarlingDamageRect part;
+            if (darling_rect_intersect(&dl->commands[i].bounds, &job.rect, &part)) {
+                hits[job.hitCount++] = i;
+            }
+        }
+
+        darling_pool_for_rows((uint32_t)(job.rect.y1 - job.rect.y0), (size_t)(job.rect.x1 - job.rect.x0) * 4u, darling_draw_rows, &job);
+        dl->rasterPixels += (uint64_t)darling_rect_area(&job.rect);
+        rects[count++] = job.rect;
+    }
+
+    dl->dirtyCount = 0;
+    dl->valid = TRUE;
+    free(hits);
+
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+    darling_unlock();
+
+    for (uint32_t i = 0; i < count; i++) {
+        const DarlingDamageRect* r = &rects[i];
+        if (content) {
+            darling_compositor_damage(win, r->x0, r->y0, r->x1, r->y1);
+        } else {
+            darling_thumbnail_damage(win, r->x0, r->y0, r->x1, r->y1);
+            darling_compositor_invalidate(win, r);
+        }
+    }
+
+    if (!content) {
+        darling_timing_draw_overlay(win);
+    }
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+}
+
+static void darling_draw_flush(DarlingWindow* win) {
+    DarlingPowerSample power;
+    if (!darling_power_begin(win, &power)) {
+        // Drawn in full once the window can be seen again
+        darling_lock();
+        win->displayList.valid = FALSE;
+        darling_unlock();
+        return;
+    }
+
+    darling_draw_rasterize(win);
+    darling_power_end(win, &power);
+}
+
+// Redraw the retained list after presents to it were skipped
+void darling_draw_refresh(DarlingWindow* win) {
+    if (win && win->displayList.submits) {
+        darling_draw_flush(win);
+    }
+}
+
+void darling_draw_free(DarlingWindow* win) {
+    DarlingDisplayList* dl = &win->displayList;
+
+    for (uint32_t i = 0; i < dl->imageCount; i++) {
+        free(dl->images[i].pixels);
+    }
+
+    free(dl->images);
+    free(dl->words);
+    free(dl->commands);
+    memset(dl, 0, sizeof(*dl));
+}
+
+// Public API - Display Lists
+
+int darling_draw_submit(DarlingWindow* win, const uint32_t* words, size_t count, uint32_t background) {
+    if (!win || !win->hwnd || (!words && count) || count > UINT32_MAX) {
+        return 0;
+    }
+
+    int64_t parsed = darling_draw_parse(words, count, NULL);
+    if (parsed < 0) {
+        return 0;
+    }
+
+    uint32_t* copy = count ? (uint32_t*)malloc(count * 4u) : NULL;
+    DarlingDrawCommand* commands = parsed ? (DarlingDrawCommand*)malloc((size_t)parsed * sizeof(DarlingDrawCommand)) : NULL;
+    if ((count && !copy) || (parsed && !commands)) {
+        free(copy);
+        free(commands);
+        return 0;
+    }
+
+    if (count) {
+        memcpy(copy, words, count * 4u);
+    }
+    darling_draw_parse(copy, count, commands);
+
+    darling_lock();
+    DarlingDisplayList* dl = &win->displayList;
+    uint32_t bg = darling_draw_color(background);
+
+    if (dl->valid && dl->background == bg) {
+        darling_draw_diff(dl, dl->words, dl->commands, dl->count, copy, commands, (uint32_t)parsed);
+    } else {
+        dl->valid = FALSE;
+        dl->changed += (uint64_t)parsed;
+    }
+
+    free(dl->words);
+    free(dl->commands);
+    dl->words = copy;
+    dl->commands = commands;
+    dl->count = (uint32_t)parsed;
+    dl->background = bg;
+    dl->submits++;
+    darling_unlock();
+
+    darling_draw_flush(win);
+    return 1;
+}
+
+int darling_draw_image_upload(
+    DarlingWindow* win,
+    uint32_t id,
+    const unsigned char* bgra_data,
+    uint32_t width,
+    uint32_t height,
+    int premultiplied
+) {
+    if (!win || !bgra_data || !darling_frame_size_ok(width, height) || width == 0 || height == 0) {
+        return 0;
+    }
+
+    size_t bytes = (size_t)width * (size_t)height * 4u;
+    uint32_t* pixels = (uint32_t*)malloc(bytes);
+    if (!pixels) {
+        return 0;
+    }
+
+    DarlingPoolOp op = premultiplied ? DARLING_POOL_COPY : DARLING_POOL_PREMULTIPLY;
+    darling_pool_convert((uint8_t*)pixels, (size_t)width * 4u, bgra_data, (size_t)width * 4u, width, height, op);
+
+    darling_lock();
+    DarlingDisplayList* dl = &win->displayList;
+    DarlingDrawImage* img = darling_draw_image(dl, id);
+
+    if (!img) {
+        if (dl->imageCount == dl->imageCapacity) {
+            uint32_t grown = dl->imageCapacity ? dl->imageCapacity * 2u : 4u;
+            DarlingDrawImage* images = (DarlingDrawImage*)realloc(dl->images, grown * sizeof(DarlingDrawImage));
+            if (!images) {
+                darling_unlock();
+                free(pixels);
+                return 0;
+            }
+            dl->images = images;
+            dl->imageCapacity = grown;
+        }
+        img = &dl->images[dl->imageCount++];
+        memset(img, 0, sizeof(*img));
+        img->id = id;
+    }
+
+    dl->imageBytes -= (uint64_t)img->width * img->height * 4u;
+    free(img->pixels);
+    img->pixels = pixels;
+    img->width = width;
+    img->height = height;
+    dl->imageBytes += bytes;
+
+    // Redraw what uses it
+    for (uint32_t i = 0; i < dl->count; i++) {
+        const uint32_t* w = dl->words + dl->commands[i].offset;
+        uint32_t op = w[0] & 0xFFu;
+        if ((op == DARLING_DRAW_IMAGE || op == DARLING_DRAW_GLYPHS) && w[1] == id) {
+            darling_draw_damage(dl, &dl->commands[i].bounds);
+        }
+    }
+    BOOL drawn = dl->submits > 0;
+    darling_unlock();
+
+    if (drawn) {
+        darling_draw_flush(win);
+    }
+    return 1;
+}
+
+void darling_draw_image_release(DarlingWindow* win, uint32_t id) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingDisplayList* dl = &win->displayList;
+    DarlingDrawImage* img = darling_draw_image(dl, id);
+    if (!img) {
+        darling_unlock();
+        return;
+    }
+
+    dl->imageBytes -= (uint64_t)img->width * img->height * 4u;
+    free(img->pixels);
+    *img = dl->images[--dl->imageCount];
+
+    for (uint32_t i = 0; i < dl->count; i++) {
+        const uint32_t* w = dl->words + dl->commands[i].offset;
+        uint32_t op = w[0] & 0xFFu;
+        if ((op == DARLING_DRAW_IMAGE || op == DARLING_DRAW_GLYPHS) && w[1] == id) {
+            darling_draw_damage(dl, &dl->commands[i].bounds);
+        }
+    }
+    BOOL drawn = dl->submits > 0;
+    darling_unlock();
+
+    if (drawn) {
+        darling_draw_flush(win);
+    }
+}
+
+void darling_get_draw_stats(DarlingWindow* win, DarlingDrawStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    const DarlingDisplayList* dl = &win->displayList;
+    out->commands = dl->count;
+    out->images = dl->imageCount;
+    out->imageBytes = dl->imageBytes;
+    out->submits = dl->submits;
+    out->reusedCommands = dl->reused;
+    out->changedCommands = dl->changed;
+    out->fullRedraws = dl->fullRedraws;
+    out->rasterPixels = dl->rasterPixels;
+    darling_unlock();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+// Display List
+// A retained list of draw commands rasterized in software into the
+// backing store (or the compositor's content frame). Each command keeps a
+// hash and its bounding box. A new list is matched against the old one in
+// order; commands left unmatched on either side are the only ones whose
+// boxes are rasterized again, and inside each box every command of the new
+// list that touches it is drawn, in order, over the background.
+
+#define DARLING_DRAW_MATCH_WINDOW 64u       // old commands searched ahead per new command
+
+typedef struct DarlingDrawCommand {
+    uint32_t offset;                // first word in the list
+    uint32_t length;                // words, header included
+    uint64_t hash;
+    DarlingDamageRect bounds;       // may extend past the target
+} DarlingDrawCommand;
+
+typedef struct DarlingDrawImage {
+    uint32_t id;
+    uint32_t width;
+    uint32_t height;
+    uint32_t* pixels;               // premultiplied BGRA
+} DarlingDrawImage;
+
+typedef struct DarlingDisplayList {
+    uint32_t* words;
+    DarlingDrawCommand* commands;
+    uint32_t count;
+    uint32_t background;            // premultiplied
+
+    DarlingDrawImage* images;
+    uint32_t imageCount;
+    uint32_t imageCapacity;
+    uint64_t imageBytes;
+
+    DarlingDamageRect dirty[DARLING_DAMAGE_MAX];
+    uint32_t dirtyCount;
+
+    uint32_t width;                 // target last drawn at, 0 before the first
+    uint32_t height;
+    uint64_t evictions;             // the window's eviction count then
+    BOOL valid;                     // the target still holds what the list drew
+
+    uint64_t submits;
+    uint64_t reused;
+    uint64_t changed;
+    uint64_t fullRedraws;
+    uint64_t rasterPixels;
+} DarlingDisplayList;
@@ -0,0 +1,427 @@
+#include "frame.h"
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DARLING_FRAME_SSE2 1
+#endif
+
+// Frame Copy
+
+void darling_frame_copy(void* dst, const void* src, uint32_t w, uint32_t h) {
+    if (!dst || !src || !darling_frame_size_ok(w, h)) {
+        return;
+    }
+
+    memcpy(dst, src, (size_t)w * (size_t)h * 4u);
+}
+
+void darling_frame_copy_rect(
+    uint8_t* dst,
+    size_t dst_stride,
+    const uint8_t* src,
+    size_t src_stride,
+    uint32_t w,
+    uint32_t h
+) {
+    if (!dst || !src || w == 0 || h == 0) {
+        return;
+    }
+
+    size_t rowBytes = (size_t)w * 4u;
+
+    // Contiguous rows collapse into a single copy
+    if (dst_stride == rowBytes && src_stride == rowBytes) {
+        memcpy(dst, src, rowBytes * (size_t)h);
+        return;
+    }
+
+    for (uint32_t y = 0; y < h; y++) {
+        memcpy(dst, src, rowBytes);
+        dst += dst_stride;
+        src += src_stride;
+    }
+}
+
+// Pixel Conversion
+
+void darling_frame_rgba_to_bgra(uint8_t* dst, const uint8_t* src, size_t pixel_count) {
+    if (!dst || !src) {
+        return;
+    }
+
+    // Operate on whole 32-bit pixels: swap bytes 0 and 2, keep G and A.
+    // Compilers vectorize this loop at -O2 (SSE2/NEON byte shuffles).
+    for (size_t i = 0; i < pixel_count; i++) {
+        uint32_t px;
+        memcpy(&px, src + i * 4u, sizeof(px));
+
+        uint32_t ga = px & 0xFF00FF00u;
+        uint32_t rb = px & 0x00FF00FFu;
+        px = ga | (rb << 16) | (rb >> 16);
+
+        memcpy(dst + i * 4u, &px, sizeof(px));
+    }
+}
+
+// Alpha Blending
+// Premultiplied BGRA throughout. x / 255 is rounded with the exact
+// (x + 128 + ((x + 128) >> 8)) >> 8 for x <= 255 * 255, in both the scalar
+// and SSE2 paths, so they agree bit for bit. Other targets use the scalar
+// loops, which compilers vectorize at -O2.
+
+static inline uint32_t darling_div255(uint32_t x) {
+    x += 128u;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline uint32_t darling_scale_pixel(uint32_t px, uint32_t scale) {
+    uint32_t b = darling_div255((px & 0xFFu) * scale);
+    uint32_t g = darling_div255(((px >> 8) & 0xFFu) * scale);
+    uint32_t r = darling_div255(((px >> 16) & 0xFFu) * scale);
+    uint32_t a = darling_div255((px >> 24) * scale);
+    return b | (g << 8) | (r << 16) | (a << 24);
+}
+
+static inline uint32_t darling_blend_pixel(uint32_t d, uint32_t s, uint32_t opacity) {
+    if (opacity != 255u) {
+        s = darling_scale_pixel(s, opacity);
+    }
+
+    uint32_t inv = 255u - (s >> 24);
+    uint32_t b = (s & 0xFFu) + darling_div255((d & 0xFFu) * inv);
+    uint32_t g = ((s >> 8) & 0xFFu) + darling_div255(((d >> 8) & 0xFFu) * inv);
+    uint32_t r = ((s >> 16) & 0xFFu) + darling_div255(((d >> 16) & 0xFFu) * inv);
+    uint32_t a = (s >> 24) + darling_div255((d >> 24) * inv);
+
+    // Valid premultiplied input never exceeds 255; clamp like packus does
+    b = b > 255u ? 255u : b;
+    g = g > 255u ? 255u : g;
+    r = r > 255u ? 255u : r;
+    a = a > 255u ? 255u : a;
+    return b | (g << 8) | (r << 16) | (a << 24);
+}
+
+#ifdef DARLING_FRAME_SSE2
+static inline __m128i darling_div255_epi16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Alpha of each of two pixels broadcast to its four 16-bit lanes
+static inline __m128i darling_alpha_epi16(__m128i px16) {
+    px16 = _mm_shufflelo_epi16(px16, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(px16, _MM_SHUFFLE(3, 3, 3, 3));
+}
+#endif
+
+void darling_frame_premultiply(uint8_t* dst, const uint8_t* src, size_t pixel_count) {
+    if (!dst || !src) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef DARLING_FRAME_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+
+    for (; i + 4u <= pixel_count; i += 4u) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(src + i * 4u));
+
+        // Overlays are mostly opaque or clear; both need no multiply
+        __m128i alpha = _mm_and_si128(px, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i * 4u), px);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i * 4u), zero);
+            continue;
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+        // Colour lanes scale by alpha; the alpha lane by 255, i.e. unchanged
+        __m128i aLo = _mm_or_si128(darling_alpha_epi16(lo), alphaLanes);
+        __m128i aHi = _mm_or_si128(darling_alpha_epi16(hi), alphaLanes);
+
+        lo = darling_div255_epi16(_mm_mullo_epi16(lo, aLo));
+        hi = darling_div255_epi16(_mm_mullo_epi16(hi, aHi));
+        _mm_storeu_si128((__m128i*)(dst + i * 4u), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; i < pixel_count; i++) {
+        uint32_t px;
+        memcpy(&px, src + i * 4u, sizeof(px));
+
+        uint32_t a = px >> 24;
+        px = (darling_scale_pixel(px, a) & 0x00FFFFFFu) | (a << 24);
+
+        memcpy(dst + i * 4u, &px, sizeof(px));
+    }
+}
+
+// Rounded c * 255 / a for c <= a is (c * 255 + a / 2) / a in integers. The
+// SSE2 path divides in single precision: c * 255 and a are exact, the
+// quotient is at most 255 and correctly rounded, and its distance from a
+// rounding boundary is a multiple of 1 / (2a), far above float precision,
+// so adding 0.5 and truncating gives the same result.
+static inline uint32_t darling_unpremultiply_pixel(uint32_t px) {
+    uint32_t a = px >> 24;
+    if (a == 0) {
+        return 0;
+    }
+
+    uint32_t out = a << 24;
+    for (uint32_t shift = 0; shift < 24u; shift += 8u) {
+        uint32_t c = (px >> shift) & 0xFFu;
+        c = c > a ? a : c;
+        out |= ((c * 255u + a / 2u) / a) << shift;
+    }
+    return out;
+}
+
+#ifdef DARLING_FRAME_SSE2
+// Four channels of one pixel, widened to 32-bit lanes, divided out
+static inline __m128 darling_unpremultiply_ps(__m128i c16, __m128i a16, int high) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i c = high ? _mm_unpackhi_epi16(c16, zero) : _mm_unpacklo_epi16(c16, zero);
+    __m128i a = high ? _mm_unpackhi_epi16(a16, zero) : _mm_unpacklo_epi16(a16, zero);
+    __m128 q = _mm_div_ps(_mm_cvtepi32_ps(c), _mm_cvtepi32_ps(a));
+    return _mm_add_ps(q, _mm_set1_ps(0.5f));
+}
+#endif
+
+void darling_frame_unpremultiply(uint8_t* dst, const uint8_t* src, size_t pixel_count) {
+    if (!dst || !src) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef DARLING_FRAME_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    for (; i + 4u <= pixel_count; i += 4u) {
+        __m128i px = _mm_loadu_si128((const __m128i*)(src + i * 4u));
+
+        __m128i alpha = _mm_and_si128(px, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i * 4u), px);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i * 4u), zero);
+            continue;
+        }
+
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+        // Colour lanes divide by alpha, the alpha lane by 255 (unchanged);
+        // clamping to alpha leaves alpha 0 as 0 / 1
+        __m128i aLo = _mm_or_si128(darling_alpha_epi16(lo), alphaLanes);
+        __m128i aHi = _mm_or_si128(darling_alpha_epi16(hi), alphaLanes);
+        lo = _mm_min_epi16(lo, aLo);
+        hi = _mm_min_epi16(hi, aHi);
+        lo = _mm_mullo_epi16(lo, _mm_set1_epi16(255));
+        hi = _mm_mullo_epi16(hi, _mm_set1_epi16(255));
+        aLo = _mm_max_epi16(aLo, one);
+        aHi = _mm_max_epi16(aHi, one);
+
+        __m128i p0 = _mm_cvttps_epi32(darling_unpremultiply_ps(lo, aLo, 0));
+        __m128i p1 = _mm_cvttps_epi32(darling_unpremultiply_ps(lo, aLo, 1));
+        __m128i p2 = _mm_cvttps_epi32(darling_unpremultiply_ps(hi, aHi, 0));
+        __m128i p3 = _mm_cvttps_epi32(darling_unpremultiply_ps(hi, aHi, 1));
+        __m128i out = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        _mm_storeu_si128((__m128i*)(dst + i * 4u), out);
+    }
+#endif
+
+    for (; i < pixel_count; i++) {
+        uint32_t px;
+        memcpy(&px, src + i * 4u, sizeof(px));
+        px = darling_unpremultiply_pixel(px);
+        memcpy(dst + i * 4u, &px, sizeof(px));
+    }
+}
+
+void darling_frame_blend_over(uint32_t* dst, const uint32_t* src, size_t pixel_count, uint8_t opacity) {
+    if (!dst || !src || opacity == 0) {
+        return;
+    }
+
+    size_t i = 0;
+
+#ifdef DARLING_FRAME_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i lane255 = _mm_set1_epi16(255);
+    const __m128i opacity16 = _mm_set1_epi16((short)opacity);
+
+    for (; i + 4u <= pixel_count; i += 4u) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i alpha = _mm_and_si128(s, alphaMask);
+
+        // Fully transparent source leaves dst unchanged
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF) {
+            continue;
+        }
+
+        // Fully opaque source at full opacity replaces dst
+        if (opacity == 255u && _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i*)(dst + i), s);
+            continue;
+        }
+
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i sLo = _mm_unpacklo_epi8(s, zero);
+        __m128i sHi = _mm_unpackhi_epi8(s, zero);
+
+        if (opacity != 255u) {
+            sLo = darling_div255_epi16(_mm_mullo_epi16(sLo, opacity16));
+            sHi = darling_div255_epi16(_mm_mullo_epi16(sHi, opacity16));
+        }
+
+        __m128i invLo = _mm_sub_epi16(lane255, darling_alpha_epi16(sLo));
+        __m128i invHi = _mm_sub_epi16(lane255, darling_alpha_epi16(sHi));
+
+        __m128i dLo = darling_div255_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invLo));
+        __m128i dHi = darling_div255_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invHi));
+
+        __m128i out = _mm_packus_epi16(_mm_add_epi16(sLo, dLo), _mm_add_epi16(sHi, dHi));
+        _mm_storeu_si128((__m128i*)(dst + i), out);
+    }
+#endif
+
+    for (; i < pixel_count; i++) {
+        if (src[i] != 0) {
+            dst[i] = darling_blend_pixel(dst[i], src[i], opacity);
+        }
+    }
+}
+
+// Box Downscaling
+// Each output pixel is the rounded mean of a 2x2 block, (a + b + c + d + 2)
+// >> 2 per channel, in both the scalar and SSE2 paths.
+
+static inline uint32_t darling_box4(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    // Two channels per word; each 16-bit lane sums to at most 1022
+    uint32_t rb = (a & 0x00FF00FFu) + (b & 0x00FF00FFu) + (c & 0x00FF00FFu) + (d & 0x00FF00FFu) + 0x00020002u;
+    uint32_t ga = ((a >> 8) & 0x00FF00FFu) + ((b >> 8) & 0x00FF00FFu) + ((c >> 8) & 0x00FF00FFu) +
+        ((d >> 8) & 0x00FF00FFu) + 0x00020002u;
+    return ((rb >> 2) & 0x00FF00FFu) | (((ga >> 2) & 0x00FF00FFu) << 8);
+}
+
+void darling_frame_box2x_row(uint32_t* dst, const uint32_t* r0, const uint32_t* r1, uint32_t dst_w, uint32_t src_w) {
+    if (!dst || !r0 || !r1) {
+        return;
+    }
+
+    uint32_t x = 0;
+
+#ifdef DARLING_FRAME_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    uint32_t whole = src_w / 2u < dst_w ? src_w / 2u : dst_w;
+
+    // Four output pixels from eight columns of each row
+    for (; x + 4u <= whole; x += 4u) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(r0 + 2u * x));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(r0 + 2u * x + 4u));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(r1 + 2u * x));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(r1 + 2u * x + 4u));
+
+        // Column sums: each register holds two adjacent columns
+        __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+        // Even columns plus odd columns
+        __m128i q01 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+        __m128i q23 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+        q01 = _mm_srli_epi16(_mm_add_epi16(q01, two), 2);
+        q23 = _mm_srli_epi16(_mm_add_epi16(q23, two), 2);
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(q01, q23));
+    }
+#endif
+
+    for (; x < dst_w; x++) {
+        uint32_t c0 = 2u * x;
+        uint32_t c1 = c0 + 1u < src_w ? c0 + 1u : c0;
+        dst[x] = darling_box4(r0[c0], r0[c1], r1[c0], r1[c1]);
+    }
+}
+
+// Run-Length Coding
+// UI frames are dominated by flat fills, which collapse to a few runs per
+// row. Used to keep evicted backing stores at a fraction of their size.
+
+size_t darling_frame_rle_encode(const uint32_t* src, size_t pixel_count, uint32_t* dst, size_t dst_words) {
+    if (!src || !dst || pixel_count == 0) {
+        return 0;
+    }
+
+    size_t out = 0;
+    size_t i = 0;
+
+    while (i < pixel_count) {
+        uint32_t px = src[i];
+        size_t run = 1;
+
+        while (i + run < pixel_count && src[i + run] == px && run < UINT32_MAX) {
+            run++;
+        }
+
+        if (dst_words - out < 2) {
+            return 0;
+        }
+
+        dst[out++] = (uint32_t)run;
+        dst[out++] = px;
+        i += run;
+    }
+
+    return out;
+}
+
+int darling_frame_rle_decode(const uint32_t* src, size_t src_words, uint32_t* dst, size_t pixel_count) {
+    if (!src || !dst || (src_words & 1u)) {
+        return 0;
+    }
+
+    size_t pos = 0;
+
+    for (size_t i = 0; i < src_words; i += 2) {
+        size_t run = src[i];
+        uint32_t px = src[i + 1];
+
+        if (run > pixel_count - pos) {
+            return 0;
+        }
+
+        for (size_t k = 0; k < run; k++) {
+            dst[pos + k] = px;
+        }
+        pos += run;
+    }
+
+    return pos == pixel_count ? 1 : 0;
+}
+
+int darling_frame_size_ok(uint32_t w, uint32_t h) {
+    if (w == 0 || h == 0) {
+        return 0;
+    }
+
+    return w <= SIZE_MAX / h / 4u ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Portable pixel kernels shared by every platform backend.
+// All buffers are 32-bit pixels; strides are in bytes.
+
+// Copy a tightly packed w*h frame (w * 4 bytes per row)
+void darling_frame_copy(void* dst, const void* src, uint32_t w, uint32_t h);
+
+// Copy a w*h rectangle between two strided buffers
+void darling_frame_copy_rect(
+    uint8_t* dst,
+    size_t dst_stride,
+    const uint8_t* src,
+    size_t src_stride,
+    uint32_t w,
+    uint32_t h
+);
+
+// Convert RGBA8 to BGRA8 (swap R and B). `dst` may equal `src`.
+void darling_frame_rgba_to_bgra(uint8_t* dst, const uint8_t* src, size_t pixel_count);
+
+// Premultiply BGRA8 by its alpha. `dst` may equal `src`.
+void darling_frame_premultiply(uint8_t* dst, const uint8_t* src, size_t pixel_count);
+
+// Undo darling_frame_premultiply: each colour channel becomes
+// round(c * 255 / a), with c clamped to a; alpha 0 gives 0. `dst` may
+// equal `src`.
+void darling_frame_unpremultiply(uint8_t* dst, const uint8_t* src, size_t pixel_count);
+
+// One row of a 2x box downscale: dst[x] is the rounded mean of columns 2x
+// and 2x + 1 of rows r0 and r1 (r1 = r0 for the last row of an odd
+// height). A block past src_w repeats the last column.
+void darling_frame_box2x_row(uint32_t* dst, const uint32_t* r0, const uint32_t* r1, uint32_t dst_w, uint32_t src_w);
+
+// Composite premultiplied BGRA8 `src` over `dst` ("source over"), with
+// `src` scaled by `opacity` (255 = as is). Results match the scalar
+// formula exactly: channels are rounded x / 255 at every step.
+void darling_frame_blend_over(uint32_t* dst, const uint32_t* src, size_t pixel_count, uint8_t opacity);
+
+// Run-length encode 32-bit pixels as (count, pixel) word pairs. Returns the
+// number of words written, or 0 if the output would exceed `dst_words`.
+size_t darling_frame_rle_encode(const uint32_t* src, size_t pixel_count, uint32_t* dst, size_t dst_words);
+
+// Decode darling_frame_rle_encode output. Returns 1 only if the runs fill
+// exactly `pixel_count` pixels.
+int darling_frame_rle_decode(const uint32_t* src, size_t src_words, uint32_t* dst, size_t pixel_count);
+
+// Return 1 if a w*h*4 byte frame fits in size_t, 0 otherwise
+int darling_frame_size_ok(uint32_t w, uint32_t h);
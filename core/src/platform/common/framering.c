@@ -0,0 +1,234 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides the named shared memory
+// (darling_shm_create, darling_shm_close).
+#include <string.h>
+
+// Shared-Memory Frame Ring
+
+// Same rule as the producer SDK: letters, digits, '.', '_' and '-'
+static BOOL darling_frame_ring_name_valid(const char* name) {
+    size_t len = name ? strlen(name) : 0;
+    if (len == 0 || len > DARLING_FRAME_RING_NAME_MAX) {
+        return FALSE;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '.' || c == '_' || c == '-')) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static const uint8_t* darling_frame_ring_pixels(const DarlingFrameRingView* view, uint32_t slot) {
+    return (const uint8_t*)view->header + view->headerBytes + view->slotBytes * slot;
+}
+
+// Newest READY slot published after `after`, or -1
+static int32_t darling_frame_ring_newest(const DarlingFrameRingView* view, uint32_t after) {
+    DarlingFrameRingHeader* h = view->header;
+    int32_t newest = -1;
+
+    for (uint32_t i = 0; i < view->slotCount; i++) {
+        DarlingFrameSlot* slot = &h->slots[i];
+        if (darling_atomic_load(&slot->state) != DARLING_FRAME_SLOT_READY ||
+            (int32_t)(slot->seq - after) <= 0) {
+            continue;
+        }
+        if (newest < 0 || (int32_t)(slot->seq - h->slots[newest].seq) > 0) {
+            newest = (int32_t)i;
+        }
+    }
+
+    return newest;
+}
+
+static void darling_frame_ring_release(DarlingFrameRingView* view) {
+    if (!view->header) {
+        return;
+    }
+
+    // Tell the producer before the object goes away under it
+    darling_atomic_store(&view->header->closed, 1u);
+    darling_shm_close(&view->shm);
+    memset(view, 0, sizeof(*view));
+}
+
+// Present every open ring that has a new frame. Called from
+// darling_poll_events before messages are dispatched, so the paint it
+// causes goes out in the same call.
+void darling_frame_ring_poll(void) {
+    darling_lock();
+    for (DarlingWindow* it = g_window_head; it; it = it->next) {
+        if (it->frameRing.header) {
+            darling_frame_ring_present(it);
+        }
+    }
+    darling_unlock();
+}
+
+void darling_frame_ring_free(DarlingWindow* win) {
+    darling_frame_ring_release(&win->frameRing);
+}
+
+// Public API - Shared-Memory Frame Ring
+
+int darling_frame_ring_create(
+    DarlingWindow* win,
+    const char* name,
+    uint32_t max_width,
+    uint32_t max_height,
+    uint32_t slots
+) {
+    if (!win || !darling_frame_ring_name_valid(name) || max_width == 0 || max_height == 0 ||
+        max_width > 16384u || max_height > 16384u) {
+        return 0;
+    }
+
+    if (slots == 0) {
+        slots = DARLING_FRAME_RING_MIN_SLOTS;
+    }
+    if (slots < DARLING_FRAME_RING_MIN_SLOTS || slots > DARLING_FRAME_RING_MAX_SLOTS) {
+        return 0;
+    }
+
+    // Page multiples, so every slot starts page aligned
+    uint64_t slotBytes = ((uint64_t)max_width * max_height * 4u + 4095u) & ~(uint64_t)4095u;
+    uint64_t bytes = DARLING_FRAME_RING_HEADER_BYTES + slotBytes * slots;
+    if (bytes != (size_t)bytes) {
+        return 0;
+    }
+
+    darling_lock();
+    darling_frame_ring_release(&win->frameRing);
+
+    DarlingFrameRingView* view = &win->frameRing;
+    if (!darling_shm_create(&view->shm, name, (size_t)bytes)) {
+        darling_unlock();
+        return 0;
+    }
+
+    // New objects are zero filled: every slot starts FREE
+    DarlingFrameRingHeader* h = (DarlingFrameRingHeader*)view->shm.base;
+    h->version = DARLING_FRAME_RING_VERSION;
+    h->slotCount = slots;
+    h->maxWidth = max_width;
+    h->maxHeight = max_height;
+    h->headerBytes = DARLING_FRAME_RING_HEADER_BYTES;
+    h->slotBytes = slotBytes;
+
+    // A producer polling for the ring accepts it once the magic is set
+    darling_atomic_store(&h->magic, DARLING_FRAME_RING_MAGIC);
+
+    view->header = h;
+    view->slotCount = slots;
+    view->maxWidth = max_width;
+    view->maxHeight = max_height;
+    view->headerBytes = DARLING_FRAME_RING_HEADER_BYTES;
+    view->slotBytes = (size_t)slotBytes;
+    darling_power_signal(win);
+    darling_unlock();
+    return 1;
+}
+
+void darling_frame_ring_close(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_frame_ring_release(&win->frameRing);
+    darling_unlock();
+}
+
+int darling_frame_ring_present(DarlingWindow* win) {
+    if (!win) {
+        return 0;
+    }
+
+    darling_lock();
+
+    DarlingFrameRingView* view = &win->frameRing;
+    DarlingFrameRingHeader* h = view->header;
+    if (!h || darling_atomic_load(&h->published) == view->lastSeq) {
+        darling_unlock();
+        return 0;
+    }
+
+    // While throttled the newest frame stays in the ring until it can be seen
+    if (win->power.throttled) {
+        darling_unlock();
+        return 0;
+    }
+
+    // The producer may take the slot back between the scan and the swap
+    int32_t index;
+    do {
+        index = darling_frame_ring_newest(view, view->lastSeq);
+        if (index < 0) {
+            darling_unlock();
+            return 0;
+        }
+    } while (!darling_atomic_cas(&h->slots[index].state, DARLING_FRAME_SLOT_READY, DARLING_FRAME_SLOT_READING));
+
+    DarlingFrameSlot* slot = &h->slots[index];
+    uint32_t seq = slot->seq;
+    uint32_t w = slot->width;
+    uint32_t hgt = slot->height;
+    uint32_t format = slot->format;
+    BOOL valid = w > 0 && hgt > 0 && w <= view->maxWidth && hgt <= view->maxHeight &&
+        (format == DARLING_FRAME_RING_BGRA8 || format == DARLING_FRAME_RING_RGBA8);
+
+    if (valid) {
+        darling_frame_tag(win, seq, slot->submitMs);
+        darling_paint_frame_window_format(win, darling_frame_ring_pixels(view, (uint32_t)index), w, hgt,
+            (DarlingPixelFormat)format);
+    }
+
+    darling_atomic_store(&slot->state, DARLING_FRAME_SLOT_FREE);
+
+    // Older frames still waiting will never be shown. Each is held while its
+    // sequence number is read, so a frame published meanwhile is not lost.
+    for (uint32_t i = 0; i < view->slotCount; i++) {
+        DarlingFrameSlot* other = &h->slots[i];
+        if (darling_atomic_cas(&other->state, DARLING_FRAME_SLOT_READY, DARLING_FRAME_SLOT_READING)) {
+            BOOL stale = (int32_t)(other->seq - seq) < 0;
+            darling_atomic_store(&other->state, stale ? DARLING_FRAME_SLOT_FREE : DARLING_FRAME_SLOT_READY);
+        }
+    }
+
+    // Sequence numbers start at 1
+    view->skipped += (uint32_t)(seq - view->lastSeq - 1u);
+    view->lastSeq = seq;
+    view->presented += valid ? 1u : 0u;
+    darling_atomic_store(&h->presented, seq);
+
+    darling_unlock();
+    return valid ? 1 : 0;
+}
+
+void darling_get_frame_ring_stats(DarlingWindow* win, DarlingFrameRingStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingFrameRingView* view = &win->frameRing;
+    if (view->header) {
+        out->slots = view->slotCount;
+        out->maxWidth = view->maxWidth;
+        out->maxHeight = view->maxHeight;
+        out->published = darling_atomic_load(&view->header->published);
+        out->dropped = darling_atomic_load(&view->header->dropped);
+    }
+    out->presented = view->presented;
+    out->skipped = view->skipped;
+    darling_unlock();
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "darling_producer.h"
+
+// Shared-Memory Frame Ring
+// A named ring of frame slots another process writes with the producer SDK
+// (darling_producer.h has the layout and slot protocol). Darling owns the
+// object: it creates it, presents the newest READY slot straight into the
+// window's backing store, and unlinks it when the ring or window closes.
+//
+// The backend maps the object; everything else is shared.
+
+typedef struct DarlingFrameRingView {
+    DarlingSharedMemory shm;
+    DarlingFrameRingHeader* header;     // NULL when no ring is open
+
+    // The geometry as created. The header's copy is writable by the
+    // producer, so only these are trusted.
+    uint32_t slotCount;
+    uint32_t maxWidth;
+    uint32_t maxHeight;
+    size_t headerBytes;
+    size_t slotBytes;
+
+    uint32_t lastSeq;                   // sequence number last presented
+    uint64_t presented;
+    uint64_t skipped;                   // published frames never presented
+} DarlingFrameRingView;
@@ -0,0 +1,418 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides darling_query_client_size and
+// answers its native hit-test message with darling_hit_index_query.
+#include <stdlib.h>
+#include <string.h>
+
+// Hit-Test Index
+
+// Not clamped to the client area: queries outside it are rejected, so a
+// region anchored only to the top-left keeps the same rect at any size
+static int32_t darling_hit_resolve_edge(int32_t offset, int32_t size, uint32_t anchors, uint32_t far) {
+    return (anchors & far) ? size - offset : offset;
+}
+
+static void darling_hit_resolve(const DarlingHitIndex* index, DarlingHitRegion* r) {
+    r->x0 = darling_hit_resolve_edge(r->left, index->width, r->anchors, DARLING_HIT_FAR_LEFT);
+    r->y0 = darling_hit_resolve_edge(r->top, index->height, r->anchors, DARLING_HIT_FAR_TOP);
+    r->x1 = darling_hit_resolve_edge(r->right, index->width, r->anchors, DARLING_HIT_FAR_RIGHT);
+    r->y1 = darling_hit_resolve_edge(r->bottom, index->height, r->anchors, DARLING_HIT_FAR_BOTTOM);
+}
+
+// Cell range of the resolved rect, clipped to the grid
+static void darling_hit_cell_range(const DarlingHitIndex* index, const DarlingHitRegion* r, int32_t out[4]) {
+    int32_t gridW = (int32_t)(index->cols << DARLING_HIT_CELL_SHIFT);
+    int32_t gridH = (int32_t)(index->rows << DARLING_HIT_CELL_SHIFT);
+    int32_t x0 = r->x0 > 0 ? r->x0 : 0;
+    int32_t y0 = r->y0 > 0 ? r->y0 : 0;
+    int32_t x1 = r->x1 < gridW ? r->x1 : gridW;
+    int32_t y1 = r->y1 < gridH ? r->y1 : gridH;
+
+    if (x1 <= x0 || y1 <= y0) {
+        out[0] = 0;
+        out[1] = 0;
+        out[2] = -1;
+        out[3] = -1;
+        return;
+    }
+
+    out[0] = x0 >> DARLING_HIT_CELL_SHIFT;
+    out[1] = y0 >> DARLING_HIT_CELL_SHIFT;
+    out[2] = (x1 - 1) >> DARLING_HIT_CELL_SHIFT;
+    out[3] = (y1 - 1) >> DARLING_HIT_CELL_SHIFT;
+}
+
+// Cells keep slots oldest first, so new regions append and queries scan
+// from the end
+static int darling_hit_cell_insert(DarlingHitIndex* index, DarlingHitCell* cell, uint32_t slot) {
+    if (cell->count == cell->capacity) {
+        uint32_t capacity = cell->capacity ? cell->capacity * 2u : 4u;
+        uint32_t* items = (uint32_t*)realloc(cell->items, (size_t)capacity * sizeof(uint32_t));
+        if (!items) {
+            return 0;
+        }
+        cell->items = items;
+        cell->capacity = capacity;
+    }
+
+    uint32_t seq = index->regions[slot].seq;
+    uint32_t pos = cell->count;
+    while (pos > 0 && index->regions[cell->items[pos - 1]].seq > seq) {
+        pos--;
+    }
+
+    memmove(&cell->items[pos + 1], &cell->items[pos], (size_t)(cell->count - pos) * sizeof(uint32_t));
+    cell->items[pos] = slot;
+    cell->count++;
+    return 1;
+}
+
+static void darling_hit_cell_erase(DarlingHitCell* cell, uint32_t slot) {
+    for (uint32_t i = 0; i < cell->count; i++) {
+        if (cell->items[i] == slot) {
+            memmove(&cell->items[i], &cell->items[i + 1], (size_t)(cell->count - i - 1) * sizeof(uint32_t));
+            cell->count--;
+            return;
+        }
+    }
+}
+
+static void darling_hit_unbin(DarlingHitIndex* index, uint32_t slot) {
+    DarlingHitRegion* r = &index->regions[slot];
+
+    for (int32_t cy = r->cy0; cy <= r->cy1; cy++) {
+        for (int32_t cx = r->cx0; cx <= r->cx1; cx++) {
+            darling_hit_cell_erase(&index->cells[(uint32_t)cy * index->cols + (uint32_t)cx], slot);
+        }
+    }
+
+    r->cx0 = 0;
+    r->cy0 = 0;
+    r->cx1 = -1;
+    r->cy1 = -1;
+}
+
+static int darling_hit_bin(DarlingHitIndex* index, uint32_t slot) {
+    DarlingHitRegion* r = &index->regions[slot];
+    int32_t range[4];
+    darling_hit_cell_range(index, r, range);
+
+    r->cx0 = range[0];
+    r->cy0 = range[1];
+    r->cx1 = range[2];
+    r->cy1 = range[3];
+
+    for (int32_t cy = r->cy0; cy <= r->cy1; cy++) {
+        for (int32_t cx = r->cx0; cx <= r->cx1; cx++) {
+            if (!darling_hit_cell_insert(index, &index->cells[(uint32_t)cy * index->cols + (uint32_t)cx], slot)) {
+                darling_hit_unbin(index, slot);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void darling_hit_free_cells(DarlingHitIndex* index) {
+    if (index->cells) {
+        for (uint32_t i = 0; i < index->cols * index->rows; i++) {
+            free(index->cells[i].items);
+        }
+    }
+
+    free(index->cells);
+    index->cells = NULL;
+    index->cols = 0;
+    index->rows = 0;
+}
+
+// Grow the grid to cover the client area with some slack, so a resize drag
+// does not regrow it on every step, then re-bin everything
+static void darling_hit_grow_grid(DarlingHitIndex* index, uint32_t needCols, uint32_t needRows) {
+    uint32_t cols = needCols > index->cols ? needCols + needCols / 2u : index->cols;
+    uint32_t rows = needRows > index->rows ? needRows + needRows / 2u : index->rows;
+
+    darling_hit_free_cells(index);
+
+    index->cells = (DarlingHitCell*)calloc((size_t)cols * rows, sizeof(DarlingHitCell));
+    if (!index->cells) {
+        return;
+    }
+    index->cols = cols;
+    index->rows = rows;
+    index->rebuilds++;
+
+    for (uint32_t i = 0; i < index->count; i++) {
+        if (index->regions[i].used) {
+            darling_hit_resolve(index, &index->regions[i]);
+            darling_hit_bin(index, i);
+        }
+    }
+}
+
+// Returns 1 if the grid had to grow (everything was re-binned)
+static int darling_hit_ensure_grid(DarlingHitIndex* index) {
+    uint32_t needCols = ((uint32_t)index->width + (1u << DARLING_HIT_CELL_SHIFT) - 1u) >> DARLING_HIT_CELL_SHIFT;
+    uint32_t needRows = ((uint32_t)index->height + (1u << DARLING_HIT_CELL_SHIFT) - 1u) >> DARLING_HIT_CELL_SHIFT;
+
+    if (needCols <= index->cols && needRows <= index->rows) {
+        return 0;
+    }
+
+    darling_hit_grow_grid(index, needCols, needRows);
+    return 1;
+}
+
+void darling_hit_index_free(DarlingHitIndex* index) {
+    if (!index) {
+        return;
+    }
+
+    darling_hit_free_cells(index);
+    free(index->regions);
+    index->regions = NULL;
+    index->count = 0;
+    index->capacity = 0;
+    index->live = 0;
+}
+
+void darling_hit_index_resize(DarlingHitIndex* index, int32_t w, int32_t h) {
+    if (!index || w < 0 || h < 0 || (w == index->width && h == index->height)) {
+        return;
+    }
+
+    index->width = w;
+    index->height = h;
+
+    if (darling_hit_ensure_grid(index)) {
+        return;
+    }
+
+    // Regions anchored only to the top-left never move
+    for (uint32_t i = 0; i < index->count; i++) {
+        DarlingHitRegion* r = &index->regions[i];
+        if (!r->used || !(r->anchors & DARLING_HIT_FAR_ALL)) {
+            continue;
+        }
+
+        darling_hit_resolve(index, r);
+
+        int32_t range[4];
+        darling_hit_cell_range(index, r, range);
+        if (range[0] == r->cx0 && range[1] == r->cy0 && range[2] == r->cx1 && range[3] == r->cy1) {
+            continue;
+        }
+
+        darling_hit_unbin(index, i);
+        darling_hit_bin(index, i);
+        index->rebins++;
+    }
+}
+
+int32_t darling_hit_index_add(
+    DarlingHitIndex* index,
+    uint32_t kind,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+) {
+    if (!index) {
+        return DARLING_HIT_NONE;
+    }
+
+    darling_hit_ensure_grid(index);
+
+    uint32_t slot = 0;
+    while (slot < index->count && index->regions[slot].used) {
+        slot++;
+    }
+
+    if (slot == index->count) {
+        if (index->count == index->capacity) {
+            uint32_t capacity = index->capacity ? index->capacity * 2u : 16u;
+            DarlingHitRegion* regions =
+                (DarlingHitRegion*)realloc(index->regions, (size_t)capacity * sizeof(DarlingHitRegion));
+            if (!regions) {
+                return DARLING_HIT_NONE;
+            }
+            index->regions = regions;
+            index->capacity = capacity;
+        }
+        index->count++;
+    }
+
+    DarlingHitRegion* r = &index->regions[slot];
+    memset(r, 0, sizeof(*r));
+    r->left = left;
+    r->top = top;
+    r->right = right;
+    r->bottom = bottom;
+    r->anchors = anchors & DARLING_HIT_FAR_ALL;
+    r->kind = kind;
+    r->seq = index->nextSeq++;
+    r->cx1 = -1;
+    r->cy1 = -1;
+    r->used = 1;
+
+    darling_hit_resolve(index, r);
+    if (!darling_hit_bin(index, slot)) {
+        r->used = 0;
+        return DARLING_HIT_NONE;
+    }
+
+    index->live++;
+    return (int32_t)slot;
+}
+
+int darling_hit_index_set(
+    DarlingHitIndex* index,
+    int32_t id,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+) {
+    if (!index || id < 0 || (uint32_t)id >= index->count || !index->regions[id].used) {
+        return 0;
+    }
+
+    DarlingHitRegion* r = &index->regions[id];
+    darling_hit_unbin(index, (uint32_t)id);
+
+    r->left = left;
+    r->top = top;
+    r->right = right;
+    r->bottom = bottom;
+    r->anchors = anchors & DARLING_HIT_FAR_ALL;
+
+    darling_hit_resolve(index, r);
+    if (!darling_hit_bin(index, (uint32_t)id)) {
+        r->used = 0;
+        index->live--;
+        return 0;
+    }
+
+    return 1;
+}
+
+void darling_hit_index_remove(DarlingHitIndex* index, int32_t id) {
+    if (!index || id < 0 || (uint32_t)id >= index->count || !index->regions[id].used) {
+        return;
+    }
+
+    darling_hit_unbin(index, (uint32_t)id);
+    index->regions[id].used = 0;
+    index->live--;
+}
+
+int32_t darling_hit_index_query(const DarlingHitIndex* index, int32_t x, int32_t y) {
+    if (!index || index->live == 0 || x < 0 || y < 0 || x >= index->width || y >= index->height) {
+        return DARLING_HIT_NONE;
+    }
+
+    uint32_t cx = (uint32_t)x >> DARLING_HIT_CELL_SHIFT;
+    uint32_t cy = (uint32_t)y >> DARLING_HIT_CELL_SHIFT;
+    if (cx >= index->cols || cy >= index->rows) {
+        return DARLING_HIT_NONE;
+    }
+
+    const DarlingHitCell* cell = &index->cells[cy * index->cols + cx];
+    for (uint32_t i = cell->count; i > 0; i--) {
+        const DarlingHitRegion* r = &index->regions[cell->items[i - 1]];
+        if (x >= r->x0 && x < r->x1 && y >= r->y0 && y < r->y1) {
+            return (int32_t)r->kind;
+        }
+    }
+
+    return DARLING_HIT_NONE;
+}
+
+// Public API - Hit Testing
+// Coordinates are client-area pixels of the host window.
+
+// The index learns the client size lazily, on the first region added
+static void darling_hit_sync_size_locked(DarlingWindow* win) {
+    if (win->hitIndex.width > 0 && win->hitIndex.height > 0) {
+        return;
+    }
+
+    int32_t w = 0;
+    int32_t h = 0;
+    darling_query_client_size(win, &w, &h);
+    darling_hit_index_resize(&win->hitIndex, w, h);
+}
+
+int32_t darling_hit_region_add(
+    DarlingWindow* win,
+    DarlingHitKind kind,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+) {
+    if (!win || (uint32_t)kind > (uint32_t)DARLING_HIT_BOTTOM_RIGHT) {
+        return DARLING_HIT_NONE;
+    }
+
+    darling_lock();
+    darling_hit_sync_size_locked(win);
+    int32_t id = darling_hit_index_add(&win->hitIndex, (uint32_t)kind, left, top, right, bottom, anchors);
+    darling_unlock();
+
+    return id;
+}
+
+void darling_hit_region_set(
+    DarlingWindow* win,
+    int32_t id,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_hit_index_set(&win->hitIndex, id, left, top, right, bottom, anchors);
+    darling_unlock();
+}
+
+void darling_hit_region_remove(DarlingWindow* win, int32_t id) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_hit_index_remove(&win->hitIndex, id);
+    darling_unlock();
+}
+
+void darling_hit_region_clear(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_hit_index_free(&win->hitIndex);
+    darling_unlock();
+}
+
+int32_t darling_hit_test(DarlingWindow* win, int32_t x, int32_t y) {
+    if (!win) {
+        return DARLING_HIT_NONE;
+    }
+
+    darling_lock();
+    int32_t kind = darling_hit_index_query(&win->hitIndex, x, y);
+    darling_unlock();
+
+    return kind;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <stdint.h>
+
+// Hit-Test Index
+// Portable spatial index answering "which typed region is under this point"
+// for titlebars drawn in web content. Each region edge is an offset from the
+// near (left/top) or far (right/bottom) side of the client area, so regions
+// follow resizes. A uniform grid maps a point to the few regions overlapping
+// its cell. The grid only grows, and a resize re-bins just the regions that
+// are anchored to a far edge and whose cell range changed.
+
+#define DARLING_HIT_NONE (-1)
+
+#define DARLING_HIT_CELL_SHIFT 5u   // 32px cells
+
+// Edges measured from the far side (values match DarlingHitAnchor in darling.h)
+#define DARLING_HIT_FAR_LEFT   1u   // left edge = width - left
+#define DARLING_HIT_FAR_TOP    2u   // top edge = height - top
+#define DARLING_HIT_FAR_RIGHT  4u   // right edge = width - right
+#define DARLING_HIT_FAR_BOTTOM 8u   // bottom edge = height - bottom
+#define DARLING_HIT_FAR_ALL    15u
+
+typedef struct DarlingHitRegion {
+    // As registered
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+    uint32_t anchors;
+    uint32_t kind;
+    uint32_t seq;               // insertion order; later regions win
+
+    // Resolved for the current size, half-open [x0, x1) x [y0, y1)
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+
+    // Cells the region is binned in, inclusive (cx0 > cx1 when empty)
+    int32_t cx0;
+    int32_t cy0;
+    int32_t cx1;
+    int32_t cy1;
+
+    uint8_t used;
+} DarlingHitRegion;
+
+typedef struct DarlingHitCell {
+    uint32_t* items;            // region slots, most recently added first
+    uint32_t count;
+    uint32_t capacity;
+} DarlingHitCell;
+
+typedef struct DarlingHitIndex {
+    DarlingHitRegion* regions;  // slots; removed ones are reused
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t live;
+    uint32_t nextSeq;
+
+    int32_t width;
+    int32_t height;
+
+    DarlingHitCell* cells;      // cols * rows, row-major
+    uint32_t cols;
+    uint32_t rows;
+
+    uint64_t rebuilds;          // full re-bins after the grid grew
+    uint64_t rebins;            // single regions moved between cells
+} DarlingHitIndex;
+
+// Release all regions and cells; the index is left empty and reusable
+void darling_hit_index_free(DarlingHitIndex* index);
+
+// Add a region. Returns its id, or DARLING_HIT_NONE on failure.
+int32_t darling_hit_index_add(
+    DarlingHitIndex* index,
+    uint32_t kind,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+);
+
+// Move a region, keeping its stacking order. Returns 1 on success.
+int darling_hit_index_set(
+    DarlingHitIndex* index,
+    int32_t id,
+    int32_t left,
+    int32_t top,
+    int32_t right,
+    int32_t bottom,
+    uint32_t anchors
+);
+
+void darling_hit_index_remove(DarlingHitIndex* index, int32_t id);
+
+// Follow a new client size
+void darling_hit_index_resize(DarlingHitIndex* index, int32_t w, int32_t h);
+
+// Kind of the topmost region containing (x, y), or DARLING_HIT_NONE
+int32_t darling_hit_index_query(const DarlingHitIndex* index, int32_t x, int32_t y);
@@ -0,0 +1,155 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend translates its native input messages
+// into darling_input_emit calls and provides darling_input_now.
+#include <string.h>
+
+// Input Ring
+
+static DarlingInputEvent* darling_input_slots(DarlingInputRing* ring) {
+    return (DarlingInputEvent*)((unsigned char*)ring + DARLING_INPUT_HEADER_BYTES);
+}
+
+uint32_t darling_input_ring_init(void* memory, size_t bytes) {
+    if (!memory || ((uintptr_t)memory & 7u) || bytes < DARLING_INPUT_HEADER_BYTES + 2u * sizeof(DarlingInputEvent)) {
+        return 0;
+    }
+
+    size_t fits = (bytes - DARLING_INPUT_HEADER_BYTES) / sizeof(DarlingInputEvent);
+    uint32_t capacity = 2u;
+    while ((size_t)capacity * 2u <= fits && capacity < 0x40000000u) {
+        capacity *= 2u;
+    }
+
+    DarlingInputRing* ring = (DarlingInputRing*)memory;
+    memset(ring, 0, DARLING_INPUT_HEADER_BYTES);
+    ring->magic = DARLING_INPUT_MAGIC;
+    ring->version = DARLING_INPUT_VERSION;
+    ring->capacity = capacity;
+    ring->eventSize = (uint32_t)sizeof(DarlingInputEvent);
+    ring->headerBytes = DARLING_INPUT_HEADER_BYTES;
+    return capacity;
+}
+
+int darling_input_ring_push(DarlingInputRing* ring, const DarlingInputEvent* ev) {
+    uint32_t w = ring->writeIndex;
+    uint32_t r = darling_input_load_acquire(&ring->readIndex);
+
+    // Drop the newest event rather than overwrite one the consumer may be
+    // reading; order is preserved and the loss is visible in `dropped`
+    if (w - r >= ring->capacity) {
+        darling_input_store_release(&ring->dropped, ring->dropped + 1u);
+        return 0;
+    }
+
+    darling_input_slots(ring)[w & (ring->capacity - 1u)] = *ev;
+    darling_input_store_release(&ring->writeIndex, w + 1u);
+    return 1;
+}
+
+uint32_t darling_input_ring_pop(DarlingInputRing* ring, DarlingInputEvent* out, uint32_t max) {
+    uint32_t r = ring->readIndex;
+    uint32_t w = darling_input_load_acquire(&ring->writeIndex);
+    uint32_t n = w - r;
+
+    if (n > max) {
+        n = max;
+    }
+
+    const DarlingInputEvent* slots = darling_input_slots(ring);
+    for (uint32_t i = 0; i < n; i++) {
+        out[i] = slots[(r + i) & (ring->capacity - 1u)];
+    }
+
+    darling_input_store_release(&ring->readIndex, r + n);
+    return n;
+}
+
+// Producer side, called from the backend's window procedure
+void darling_input_emit(
+    DarlingWindow* win,
+    uint32_t type,
+    uint32_t modifiers,
+    int32_t x,
+    int32_t y,
+    int32_t code,
+    int32_t value
+) {
+    if (!win || !win->inputRing) {
+        return;
+    }
+
+    DarlingInputEvent ev;
+    ev.time = darling_input_now();
+    ev.type = type;
+    ev.modifiers = modifiers;
+    ev.x = x;
+    ev.y = y;
+    ev.code = code;
+    ev.value = value;
+
+    darling_lock();
+    if (win->inputRing) {
+        darling_input_ring_push(win->inputRing, &ev);
+    }
+    darling_unlock();
+}
+
+// Public API - Input Ring
+
+size_t darling_input_ring_bytes(uint32_t capacity) {
+    return DARLING_INPUT_HEADER_BYTES + (size_t)capacity * sizeof(DarlingInputEvent);
+}
+
+uint32_t darling_input_attach(DarlingWindow* win, void* memory, size_t bytes) {
+    if (!win) {
+        return 0;
+    }
+
+    uint32_t capacity = darling_input_ring_init(memory, bytes);
+
+    darling_lock();
+    win->inputRing = capacity ? (DarlingInputRing*)memory : NULL;
+    darling_unlock();
+
+    return capacity;
+}
+
+void darling_input_detach(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    win->inputRing = NULL;
+    darling_unlock();
+}
+
+uint32_t darling_input_read(DarlingWindow* win, DarlingInputEvent* out, uint32_t max) {
+    if (!win || !out || !win->inputRing) {
+        return 0;
+    }
+
+    return darling_input_ring_pop(win->inputRing, out, max);
+}
+
+void darling_input_get_stats(DarlingWindow* win, DarlingInputStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingInputStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        DarlingInputRing* ring = win->inputRing;
+        if (ring) {
+            stats.capacity = ring->capacity;
+            stats.written = darling_input_load_acquire(&ring->writeIndex);
+            stats.pending = stats.written - darling_input_load_acquire(&ring->readIndex);
+            stats.dropped = darling_input_load_acquire(&ring->dropped);
+        }
+        darling_unlock();
+    }
+
+    *out = stats;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Input Ring
+// Single-producer/single-consumer ring of DarlingInputEvent in caller-owned
+// memory. The layout is fixed so JavaScript can read it through typed-array
+// views of a SharedArrayBuffer with Atomics on the two indices:
+//
+//   byte   0  uint32 magic, version, capacity, eventSize, headerBytes
+//   byte  64  uint32 writeIndex, dropped      (written by the producer only)
+//   byte 128  uint32 readIndex                (written by the consumer only)
+//   byte 192  capacity * 32-byte events
+//
+// Indices run freely and wrap at 2^32; slot = index & (capacity - 1) and
+// pending = writeIndex - readIndex. Each index has its own cache line.
+
+#define DARLING_INPUT_MAGIC 0x4E495244u     // "DRIN"
+#define DARLING_INPUT_VERSION 1u
+#define DARLING_INPUT_HEADER_BYTES 192u
+
+typedef struct DarlingInputRing {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t eventSize;
+    uint32_t headerBytes;
+    uint32_t reserved0[11];
+
+    volatile uint32_t writeIndex;
+    volatile uint32_t dropped;
+    uint32_t reserved1[14];
+
+    volatile uint32_t readIndex;
+    uint32_t reserved2[15];
+} DarlingInputRing;
+
+// Acquire/release on the indices. MSVC has no C11 atomics; a full barrier
+// is correct on x64 and ARM64 alike.
+#if defined(__GNUC__) || defined(__clang__)
+#define darling_input_load_acquire(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define darling_input_store_release(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+static __inline uint32_t darling_input_load_acquire(const volatile uint32_t* p) {
+    uint32_t v = *p;
+    MemoryBarrier();
+    return v;
+}
+
+static __inline void darling_input_store_release(volatile uint32_t* p, uint32_t v) {
+    MemoryBarrier();
+    *p = v;
+}
+#endif
+
+// Format `memory` as an empty ring. Returns the capacity (a power of two),
+// or 0 if it holds fewer than 2 events or is not 8-byte aligned.
+uint32_t darling_input_ring_init(void* memory, size_t bytes);
+
+// Producer: append one event. Returns 0 and counts a drop if the ring is full.
+int darling_input_ring_push(DarlingInputRing* ring, const DarlingInputEvent* ev);
+
+// Consumer: take up to `max` events in order. Returns the count.
+uint32_t darling_input_ring_pop(DarlingInputRing* ring, DarlingInputEvent* out, uint32_t max);
@@ -0,0 +1,156 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h, and after compositor.c, whose rectangle helpers it
+// uses. The backend switches the window's style (darling_layered_style),
+// schedules presents (darling_layered_schedule) and sends the rectangle
+// darling_layered_take hands it.
+#include <string.h>
+
+// Present Mode
+
+BOOL darling_layered_active(DarlingWindow* win) {
+    darling_lock();
+    BOOL active = win->layered.mode == DARLING_PRESENT_PER_PIXEL_ALPHA;
+    darling_unlock();
+    return active;
+}
+
+// The row operation that brings a painted frame into the backing store
+DarlingPoolOp darling_layered_paint_op(DarlingWindow* win, DarlingPixelFormat format, uint32_t w, uint32_t h) {
+    darling_lock();
+    DarlingLayered* l = &win->layered;
+    BOOL premultiply = l->mode == DARLING_PRESENT_PER_PIXEL_ALPHA && format != DARLING_PIXEL_FORMAT_BGRA8_PREMULTIPLIED;
+    if (premultiply) {
+        l->convertedPixels += (uint64_t)w * h;
+    }
+    darling_unlock();
+
+    if (format == DARLING_PIXEL_FORMAT_RGBA8) {
+        return premultiply ? DARLING_POOL_SWIZZLE_PREMULTIPLY : DARLING_POOL_SWIZZLE;
+    }
+    return premultiply ? DARLING_POOL_PREMULTIPLY : DARLING_POOL_COPY;
+}
+
+// Add damage to a per-pixel-alpha window's dirty rectangle (NULL: all of
+// it), scheduling a present if none is. Returns FALSE, doing nothing, for
+// a window presented opaque.
+BOOL darling_layered_damage(DarlingWindow* win, const DarlingDamageRect* rect) {
+    darling_lock();
+    DarlingLayered* l = &win->layered;
+    if (l->mode != DARLING_PRESENT_PER_PIXEL_ALPHA) {
+        darling_unlock();
+        return FALSE;
+    }
+
+    DarlingDamageRect all = { 0, 0, (int32_t)win->bitmapWidth, (int32_t)win->bitmapHeight };
+    DarlingDamageRect r;
+    if (darling_rect_intersect(rect ? rect : &all, &all, &r)) {
+        l->dirty = darling_rect_area(&l->dirty) == 0 ? r : darling_rect_union(&l->dirty, &r);
+    }
+
+    BOOL schedule = !l->pending && darling_rect_area(&l->dirty) > 0;
+    l->pending = l->pending || schedule;
+    darling_unlock();
+
+    if (schedule) {
+        darling_layered_schedule(win);
+    }
+    return TRUE;
+}
+
+// Take the dirty rectangle for a present. Returns FALSE if there is
+// nothing to send.
+BOOL darling_layered_take(DarlingWindow* win, DarlingDamageRect* out) {
+    darling_lock();
+    DarlingLayered* l = &win->layered;
+    DarlingDamageRect all = { 0, 0, (int32_t)win->bitmapWidth, (int32_t)win->bitmapHeight };
+    BOOL any = l->mode == DARLING_PRESENT_PER_PIXEL_ALPHA && win->dibBits &&
+        darling_rect_intersect(&l->dirty, &all, out);
+
+    if (any) {
+        uint64_t dirty = (uint64_t)darling_rect_area(out);
+        l->presents++;
+        l->dirtyPixels += dirty;
+        l->cleanPixels += (uint64_t)darling_rect_area(&all) - dirty;
+    }
+
+    memset(&l->dirty, 0, sizeof(l->dirty));
+    l->pending = FALSE;
+    darling_unlock();
+    return any;
+}
+
+// Premultiply or unpremultiply what the window holds. Called with the lock
+// held.
+static void darling_layered_convert(DarlingWindow* win, DarlingPoolOp op) {
+    DarlingLayered* l = &win->layered;
+    uint32_t w = win->bitmapWidth;
+    uint32_t h = win->bitmapHeight;
+    if (win->dibBits) {
+        darling_pool_convert((uint8_t*)win->dibBits, (size_t)w * 4u, (const uint8_t*)win->dibBits, (size_t)w * 4u, w, h, op);
+        l->convertedPixels += (uint64_t)w * h;
+    }
+
+    // Layers are premultiplied in either mode; the content frame follows
+    // the backing store
+    DarlingCompositor* c = &win->compositor;
+    if (c->content) {
+        size_t stride = (size_t)c->contentWidth * 4u;
+        darling_pool_convert((uint8_t*)c->content, stride, (const uint8_t*)c->content, stride,
+            c->contentWidth, c->contentHeight, op);
+        l->convertedPixels += (uint64_t)c->contentWidth * c->contentHeight;
+    }
+}
+
+void darling_layered_free(DarlingWindow* win) {
+    memset(&win->layered.dirty, 0, sizeof(win->layered.dirty));
+    win->layered.pending = FALSE;
+}
+
+// Public API - Present Mode
+
+int darling_set_present_mode(DarlingWindow* win, DarlingPresentMode mode) {
+    if (!win || !win->hwnd || (mode != DARLING_PRESENT_OPAQUE && mode != DARLING_PRESENT_PER_PIXEL_ALPHA)) {
+        return 0;
+    }
+
+    darling_lock();
+    DarlingLayered* l = &win->layered;
+    if (l->mode == mode) {
+        darling_unlock();
+        return 1;
+    }
+
+    BOOL layered = mode == DARLING_PRESENT_PER_PIXEL_ALPHA;
+    darling_layered_convert(win, layered ? DARLING_POOL_PREMULTIPLY : DARLING_POOL_UNPREMULTIPLY);
+    l->mode = mode;
+    memset(&l->dirty, 0, sizeof(l->dirty));
+    l->pending = FALSE;
+    darling_unlock();
+
+    // The style change sends messages to the window; then all of it is
+    // presented the new way
+    darling_layered_style(win, layered);
+    darling_present_backing_store(win);
+    return 1;
+}
+
+void darling_get_present_stats(DarlingWindow* win, DarlingPresentStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingPresentStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        const DarlingLayered* l = &win->layered;
+        stats.mode = (uint32_t)l->mode;
+        stats.layeredPresents = l->presents;
+        stats.dirtyPixels = l->dirtyPixels;
+        stats.cleanPixels = l->cleanPixels;
+        stats.convertedPixels = l->convertedPixels;
+        darling_unlock();
+    }
+
+    *out = stats;
+}
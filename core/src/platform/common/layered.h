@@ -0,0 +1,17 @@
+#pragma once
+#include <stdint.h>
+
+// Present Mode
+// A per-pixel-alpha window's damage since its last present, as one
+// rectangle: a layered window update takes a single dirty rectangle.
+
+typedef struct DarlingLayered {
+    DarlingPresentMode mode;
+    DarlingDamageRect dirty;        // empty when x0 >= x1
+    BOOL pending;                   // a present is scheduled
+
+    uint64_t presents;
+    uint64_t dirtyPixels;
+    uint64_t cleanPixels;
+    uint64_t convertedPixels;
+} DarlingLayered;
@@ -0,0 +1,273 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides darling_layout_apply.
+#include <stdlib.h>
+
+// Layout Tree
+
+void darling_layout_tree_free(DarlingLayoutTree* tree) {
+    if (!tree) {
+        return;
+    }
+
+    free(tree->nodes);
+    tree->nodes = NULL;
+    tree->count = 0;
+    tree->capacity = 0;
+}
+
+int32_t darling_layout_tree_add(
+    DarlingLayoutTree* tree,
+    int32_t parent,
+    uint32_t kind,
+    uint32_t fixed,
+    float weight
+) {
+    if (!tree || kind > DARLING_LAYOUT_NODE_STACK) {
+        return DARLING_LAYOUT_NONE;
+    }
+
+    if (parent == DARLING_LAYOUT_NONE) {
+        tree->count = 0;
+    } else if (parent < 0 || (uint32_t)parent >= tree->count ||
+               tree->nodes[parent].kind == DARLING_LAYOUT_NODE_LEAF) {
+        return DARLING_LAYOUT_NONE;
+    }
+
+    if (tree->count == tree->capacity) {
+        uint32_t capacity = tree->capacity ? tree->capacity * 2u : 16u;
+        DarlingLayoutNode* nodes =
+            (DarlingLayoutNode*)realloc(tree->nodes, (size_t)capacity * sizeof(DarlingLayoutNode));
+        if (!nodes) {
+            return DARLING_LAYOUT_NONE;
+        }
+        tree->nodes = nodes;
+        tree->capacity = capacity;
+    }
+
+    int32_t id = (int32_t)tree->count++;
+    DarlingLayoutNode* node = &tree->nodes[id];
+
+    node->kind = kind;
+    node->parent = parent;
+    node->firstChild = DARLING_LAYOUT_NONE;
+    node->lastChild = DARLING_LAYOUT_NONE;
+    node->nextSibling = DARLING_LAYOUT_NONE;
+    node->fixed = fixed;
+    node->weight = weight > 0.0f ? weight : 0.0f;
+    node->active = 0;
+    node->child = 0;
+    node->rect = (DarlingLayoutRect){ 0, 0, 0, 0 };
+    node->visible = 0;
+    node->appliedRect = node->rect;
+    node->appliedVisible = 0;
+    node->applied = 0;
+
+    if (parent != DARLING_LAYOUT_NONE) {
+        DarlingLayoutNode* p = &tree->nodes[parent];
+        if (p->lastChild != DARLING_LAYOUT_NONE) {
+            tree->nodes[p->lastChild].nextSibling = id;
+        } else {
+            p->firstChild = id;
+        }
+        p->lastChild = id;
+    }
+
+    return id;
+}
+
+// Fixed children take their size first (clamped to what is left); the
+// remainder is shared by weight. Each flexible child takes its share of
+// what is still unassigned, so rounding never leaves a gap at the end.
+static void darling_layout_split(DarlingLayoutTree* tree, const DarlingLayoutNode* node, int horizontal) {
+    DarlingLayoutNode* nodes = tree->nodes;
+    int32_t total = horizontal ? node->rect.w : node->rect.h;
+    int64_t fixedSum = 0;
+    double weightSum = 0.0;
+    uint32_t flexCount = 0;
+
+    for (int32_t c = node->firstChild; c != DARLING_LAYOUT_NONE; c = nodes[c].nextSibling) {
+        if (nodes[c].fixed) {
+            fixedSum += nodes[c].fixed;
+        } else {
+            weightSum += nodes[c].weight;
+            flexCount++;
+        }
+    }
+
+    // All-zero weights share equally
+    int equalShares = weightSum <= 0.0;
+    if (equalShares) {
+        weightSum = (double)flexCount;
+    }
+
+    int32_t flexLeft = fixedSum < total ? total - (int32_t)fixedSum : 0;
+    double weightLeft = weightSum;
+    int32_t offset = 0;
+
+    for (int32_t c = node->firstChild; c != DARLING_LAYOUT_NONE; c = nodes[c].nextSibling) {
+        DarlingLayoutNode* child = &nodes[c];
+        int32_t avail = total - offset;
+        int32_t size;
+
+        if (child->fixed) {
+            size = (int64_t)child->fixed < avail ? (int32_t)child->fixed : avail;
+        } else {
+            double w = equalShares ? 1.0 : (double)child->weight;
+            flexCount--;
+            if (flexCount == 0 || weightLeft <= 0.0) {
+                size = flexLeft;
+            } else {
+                size = (int32_t)((double)flexLeft * w / weightLeft);
+            }
+            flexLeft -= size;
+            weightLeft -= w;
+        }
+
+        if (size < 0) {
+            size = 0;
+        }
+
+        if (horizontal) {
+            child->rect = (DarlingLayoutRect){ node->rect.x + offset, node->rect.y, size, node->rect.h };
+        } else {
+            child->rect = (DarlingLayoutRect){ node->rect.x, node->rect.y + offset, node->rect.w, size };
+        }
+        child->visible = node->visible;
+        offset += size;
+    }
+}
+
+static void darling_layout_stack(DarlingLayoutTree* tree, const DarlingLayoutNode* node) {
+    uint32_t index = 0;
+
+    for (int32_t c = node->firstChild; c != DARLING_LAYOUT_NONE; c = tree->nodes[c].nextSibling) {
+        DarlingLayoutNode* child = &tree->nodes[c];
+        child->rect = node->rect;
+        child->visible = (uint8_t)(node->visible && index == node->active);
+        index++;
+    }
+}
+
+void darling_layout_compute(DarlingLayoutTree* tree, int32_t w, int32_t h) {
+    if (!tree || tree->count == 0) {
+        return;
+    }
+
+    DarlingLayoutNode* root = &tree->nodes[0];
+    root->rect = (DarlingLayoutRect){ 0, 0, w > 0 ? w : 0, h > 0 ? h : 0 };
+    root->visible = 1;
+
+    // Parents precede children, so each node's rect is final when visited
+    for (uint32_t i = 0; i < tree->count; i++) {
+        const DarlingLayoutNode* node = &tree->nodes[i];
+
+        switch (node->kind) {
+            case DARLING_LAYOUT_NODE_SPLIT_H:
+                darling_layout_split(tree, node, 1);
+                break;
+            case DARLING_LAYOUT_NODE_SPLIT_V:
+                darling_layout_split(tree, node, 0);
+                break;
+            case DARLING_LAYOUT_NODE_STACK:
+                darling_layout_stack(tree, node);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+int darling_layout_leaf_dirty(const DarlingLayoutNode* node) {
+    if (!node->applied || node->visible != node->appliedVisible) {
+        return 1;
+    }
+
+    // Hidden leaves are not moved until they are shown again
+    if (!node->visible) {
+        return 0;
+    }
+
+    return node->rect.x != node->appliedRect.x || node->rect.y != node->appliedRect.y ||
+           node->rect.w != node->appliedRect.w || node->rect.h != node->appliedRect.h;
+}
+
+// Public API - Layout
+// Mutations only edit the tree; they take effect on the next resize or
+// darling_layout_apply, so several edits cost one batched reposition.
+
+static DarlingLayoutNode* darling_layout_node_locked(DarlingWindow* win, int32_t node) {
+    if (node < 0 || (uint32_t)node >= win->layout.count) {
+        return NULL;
+    }
+
+    return &win->layout.nodes[node];
+}
+
+int32_t darling_layout_add(
+    DarlingWindow* win,
+    int32_t parent,
+    DarlingLayoutKind kind,
+    uint32_t fixed_size,
+    float weight
+) {
+    if (!win) {
+        return DARLING_LAYOUT_NONE;
+    }
+
+    darling_lock();
+    int32_t id = darling_layout_tree_add(&win->layout, parent, (uint32_t)kind, fixed_size, weight);
+    darling_unlock();
+
+    return id;
+}
+
+void darling_layout_set_child(DarlingWindow* win, int32_t node, uintptr_t child_hwnd) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingLayoutNode* n = darling_layout_node_locked(win, node);
+    if (n && n->kind == DARLING_LAYOUT_NODE_LEAF) {
+        n->child = child_hwnd;
+        n->applied = 0;
+    }
+    darling_unlock();
+}
+
+void darling_layout_set_size(DarlingWindow* win, int32_t node, uint32_t fixed_size, float weight) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingLayoutNode* n = darling_layout_node_locked(win, node);
+    if (n) {
+        n->fixed = fixed_size;
+        n->weight = weight > 0.0f ? weight : 0.0f;
+    }
+    darling_unlock();
+}
+
+void darling_layout_set_active(DarlingWindow* win, int32_t node, uint32_t index) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingLayoutNode* n = darling_layout_node_locked(win, node);
+    if (n && n->kind == DARLING_LAYOUT_NODE_STACK) {
+        n->active = index;
+    }
+    darling_unlock();
+}
+
+void darling_layout_clear(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_layout_tree_free(&win->layout);
+    darling_unlock();
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <stdint.h>
+
+// Layout Tree
+// Portable layout engine for host windows that embed several child windows.
+// Nodes live in one array and are always added after their parent, so a
+// single forward pass computes every rect without recursion.
+
+#define DARLING_LAYOUT_NONE (-1)
+
+// Node kinds (values match DarlingLayoutKind in darling.h)
+#define DARLING_LAYOUT_NODE_LEAF    0u  // holds one child window
+#define DARLING_LAYOUT_NODE_SPLIT_H 1u  // children side by side, left to right
+#define DARLING_LAYOUT_NODE_SPLIT_V 2u  // children top to bottom
+#define DARLING_LAYOUT_NODE_STACK   3u  // children overlap; only `active` is visible
+
+typedef struct DarlingLayoutRect {
+    int32_t x;
+    int32_t y;
+    int32_t w;
+    int32_t h;
+} DarlingLayoutRect;
+
+typedef struct DarlingLayoutNode {
+    uint32_t kind;
+    int32_t parent;
+    int32_t firstChild;
+    int32_t lastChild;
+    int32_t nextSibling;
+
+    // Size along the parent split axis: `fixed` pixels if non-zero,
+    // otherwise a share of the remaining space proportional to `weight`
+    uint32_t fixed;
+    float weight;
+
+    uint32_t active;        // STACK: index of the visible child
+    uintptr_t child;        // LEAF: native child window handle (0 = empty)
+
+    // Computed by darling_layout_compute
+    DarlingLayoutRect rect;
+    uint8_t visible;
+
+    // Last state handed to the platform, so unchanged leaves are skipped
+    DarlingLayoutRect appliedRect;
+    uint8_t appliedVisible;
+    uint8_t applied;
+} DarlingLayoutNode;
+
+typedef struct DarlingLayoutTree {
+    DarlingLayoutNode* nodes;   // nodes[0] is the root
+    uint32_t count;
+    uint32_t capacity;
+} DarlingLayoutTree;
+
+// Release all nodes; the tree is left empty and reusable
+void darling_layout_tree_free(DarlingLayoutTree* tree);
+
+// Append a node under `parent` (DARLING_LAYOUT_NONE replaces the whole tree
+// with a new root). Returns the node id, or DARLING_LAYOUT_NONE on failure.
+int32_t darling_layout_tree_add(
+    DarlingLayoutTree* tree,
+    int32_t parent,
+    uint32_t kind,
+    uint32_t fixed,
+    float weight
+);
+
+// Compute rect and visibility of every node for a w*h client area
+void darling_layout_compute(DarlingLayoutTree* tree, int32_t w, int32_t h);
+
+// Return 1 if a leaf must be moved or shown/hidden since it was last applied
+int darling_layout_leaf_dirty(const DarlingLayoutNode* node);
@@ -0,0 +1,144 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h, which provides DarlingWindow, BOOL/HWND and the lock.
+
+// Window List Management
+
+void darling_list_add(DarlingWindow* win) {
+    if (!win || win->inList) {
+        return;
+    }
+
+    darling_lock();
+
+    win->prev = NULL;
+    win->next = g_window_head;
+
+    if (g_window_head) {
+        g_window_head->prev = win;
+    }
+
+    g_window_head = win;
+    win->inList = TRUE;
+
+    if (!win->isChild) {
+        g_toplevel_count++;
+    }
+
+    darling_unlock();
+}
+
+void darling_list_remove(DarlingWindow* win) {
+    if (!win || !win->inList) {
+        return;
+    }
+
+    darling_lock();
+
+    if (win->prev) {
+        win->prev->next = win->next;
+    } else {
+        g_window_head = win->next;
+    }
+
+    if (win->next) {
+        win->next->prev = win->prev;
+    }
+
+    win->prev = NULL;
+    win->next = NULL;
+    win->inList = FALSE;
+
+    if (!win->isChild) {
+        g_toplevel_count--;
+        if (g_toplevel_count < 0) {
+            g_toplevel_count = 0;
+        }
+    }
+
+    darling_unlock();
+}
+
+DarlingWindow* darling_list_find(HWND hwnd) {
+    if (!hwnd) {
+        return NULL;
+    }
+
+    DarlingWindow* found = NULL;
+
+    darling_lock();
+
+    DarlingWindow* cur = g_window_head;
+    while (cur) {
+        if (cur->hwnd == hwnd || cur->childHwnd == hwnd) {
+            found = cur;
+            break;
+        }
+        cur = cur->next;
+    }
+
+    darling_unlock();
+
+    return found;
+}
+
+DarlingWindow* darling_select_new_main_window(void) {
+    DarlingWindow* cur = g_window_head;
+
+    while (cur) {
+        if (!cur->isChild) {
+            return cur;
+        }
+        cur = cur->next;
+    }
+
+    return g_window_head;
+}
+
+void darling_update_main_on_remove(DarlingWindow* removed) {
+    if (removed == g_main_window) {
+        g_main_window = darling_select_new_main_window();
+    }
+}
+
+// Public API - Access by HWND
+// The window is looked up and used under the library lock, and windows
+// leave the list under the same lock before they are freed, so a caller on
+// another thread never reaches a destroyed window.
+
+int darling_paint_frame_hwnd(
+    uintptr_t hwnd,
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    DarlingPixelFormat format,
+    uint64_t frame_id
+) {
+    if (!hwnd || !pixels) {
+        return 0;
+    }
+
+    darling_lock();
+    DarlingWindow* win = darling_list_find((HWND)hwnd);
+    if (win) {
+        if (frame_id) {
+            darling_frame_tag(win, frame_id, 0.0);
+        }
+        darling_paint_frame_window_format(win, pixels, width, height, format);
+    }
+    darling_unlock();
+
+    return win ? 1 : 0;
+}
+
+int darling_frame_ring_present_hwnd(uintptr_t hwnd) {
+    if (!hwnd) {
+        return 0;
+    }
+
+    darling_lock();
+    DarlingWindow* win = darling_list_find((HWND)hwnd);
+    int presented = win ? darling_frame_ring_present(win) : 0;
+    darling_unlock();
+
+    return presented;
+}
\ No newline at end of file
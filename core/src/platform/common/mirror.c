@@ -0,0 +1,128 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend calls darling_state_publish from its
+// window procedure whenever visibility, focus, size, position, DPI or theme
+// changes, and provides darling_query_window_state.
+#include <string.h>
+
+// Window State Mirror
+
+int darling_state_mirror_init(void* memory, size_t bytes) {
+    if (!memory || ((uintptr_t)memory & 3u) || bytes < DARLING_STATE_BYTES) {
+        return 0;
+    }
+
+    DarlingStateMirror* mirror = (DarlingStateMirror*)memory;
+    memset(mirror, 0, DARLING_STATE_BYTES);
+    mirror->magic = DARLING_STATE_MAGIC;
+    mirror->version = DARLING_STATE_VERSION;
+    mirror->bytes = DARLING_STATE_BYTES;
+    return 1;
+}
+
+void darling_state_mirror_write(DarlingStateMirror* mirror, const DarlingWindowState* state) {
+    uint32_t seq = mirror->sequence;
+    int32_t updates = darling_state_load(&mirror->fields[8]);
+
+    darling_state_store(&mirror->sequence, seq + 1u);
+    darling_state_fence_release();
+
+    darling_state_store(&mirror->fields[0], (int32_t)state->flags);
+    darling_state_store(&mirror->fields[1], (int32_t)state->dpi);
+    darling_state_store(&mirror->fields[2], state->clientWidth);
+    darling_state_store(&mirror->fields[3], state->clientHeight);
+    darling_state_store(&mirror->fields[4], state->x);
+    darling_state_store(&mirror->fields[5], state->y);
+    darling_state_store(&mirror->fields[6], state->width);
+    darling_state_store(&mirror->fields[7], state->height);
+    darling_state_store(&mirror->fields[8], updates + 1);
+
+    darling_state_fence_release();
+    darling_state_store(&mirror->sequence, seq + 2u);
+}
+
+// Rewrite the mirror from the window's current state, if one is attached
+void darling_state_publish(DarlingWindow* win) {
+    if (!win || !win->stateMirror) {
+        return;
+    }
+
+    DarlingWindowState state;
+    darling_query_window_state(win, &state);
+
+    darling_lock();
+    if (win->stateMirror) {
+        darling_state_mirror_write(win->stateMirror, &state);
+    }
+    darling_unlock();
+}
+
+// Public API - Window State Mirror
+
+size_t darling_state_mirror_bytes(void) {
+    return DARLING_STATE_BYTES;
+}
+
+int darling_state_attach(DarlingWindow* win, void* memory, size_t bytes) {
+    if (!win || !win->hwnd) {
+        return 0;
+    }
+
+    // As with the input ring, a failed attach leaves nothing attached: the
+    // caller is free to release whatever it attached before
+    BOOL ok = darling_state_mirror_init(memory, bytes);
+
+    darling_lock();
+    win->stateMirror = ok ? (DarlingStateMirror*)memory : NULL;
+    darling_unlock();
+
+    if (!ok) {
+        return 0;
+    }
+
+    darling_state_publish(win);
+    return 1;
+}
+
+void darling_state_detach(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    win->stateMirror = NULL;
+    darling_unlock();
+}
+
+int darling_state_read(const void* memory, DarlingWindowState* out) {
+    if (!memory || !out) {
+        return 0;
+    }
+
+    const DarlingStateMirror* mirror = (const DarlingStateMirror*)memory;
+    if (mirror->magic != DARLING_STATE_MAGIC || mirror->version != DARLING_STATE_VERSION) {
+        return 0;
+    }
+
+    for (;;) {
+        uint32_t before = darling_state_load(&mirror->sequence);
+        darling_state_fence_acquire();
+
+        out->flags = (uint32_t)darling_state_load(&mirror->fields[0]);
+        out->dpi = (uint32_t)darling_state_load(&mirror->fields[1]);
+        out->clientWidth = darling_state_load(&mirror->fields[2]);
+        out->clientHeight = darling_state_load(&mirror->fields[3]);
+        out->x = darling_state_load(&mirror->fields[4]);
+        out->y = darling_state_load(&mirror->fields[5]);
+        out->width = darling_state_load(&mirror->fields[6]);
+        out->height = darling_state_load(&mirror->fields[7]);
+        out->updates = (uint32_t)darling_state_load(&mirror->fields[8]);
+
+        darling_state_fence_acquire();
+        uint32_t after = darling_state_load(&mirror->sequence);
+        if (before == after && (before & 1u) == 0) {
+            return 1;
+        }
+
+        darling_thread_yield();
+    }
+}
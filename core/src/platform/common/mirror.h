@@ -0,0 +1,59 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Window State Mirror
+// A window's DarlingWindowState in caller-owned memory, rewritten by the
+// window procedure whenever part of it changes, so JavaScript can read it
+// through an Int32Array over a SharedArrayBuffer instead of a native call
+// per query. The layout is fixed:
+//
+//   byte   0  uint32 magic, version, bytes
+//   byte  64  uint32 sequence
+//   byte 128  int32 flags, dpi, clientWidth, clientHeight, x, y, width,
+//             height, updates
+//
+// A sequence lock guards the fields. The single writer makes the sequence
+// odd, stores the fields and makes it even again; a reader loads the
+// sequence, the fields, then the sequence again, and retries if the two
+// differ or are odd.
+
+#define DARLING_STATE_MAGIC 0x54535244u     // "DRST"
+#define DARLING_STATE_VERSION 1u
+#define DARLING_STATE_BYTES 192u
+
+typedef struct DarlingStateMirror {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bytes;
+    uint32_t reserved0[13];
+
+    volatile uint32_t sequence;
+    uint32_t reserved1[15];
+
+    volatile int32_t fields[9];         // DarlingWindowState, in order
+    uint32_t reserved2[7];
+} DarlingStateMirror;
+
+// Relaxed field accesses ordered by fences, the classic seqlock pairing.
+// MSVC has no C11 atomics; aligned 32-bit accesses are atomic and a full
+// barrier is correct on x64 and ARM64 alike.
+#if defined(__GNUC__) || defined(__clang__)
+#define darling_state_load(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define darling_state_store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define darling_state_fence_acquire() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define darling_state_fence_release() __atomic_thread_fence(__ATOMIC_RELEASE)
+#else
+#define darling_state_load(p) (*(p))
+#define darling_state_store(p, v) (*(p) = (v))
+#define darling_state_fence_acquire() MemoryBarrier()
+#define darling_state_fence_release() MemoryBarrier()
+#endif
+
+// Format `memory` as a mirror of an empty state. Returns 0 if it is smaller
+// than DARLING_STATE_BYTES or not 4-byte aligned.
+int darling_state_mirror_init(void* memory, size_t bytes);
+
+// Writer: publish one record. Callers serialize writes (the backends hold
+// the library lock).
+void darling_state_mirror_write(DarlingStateMirror* mirror, const DarlingWindowState* state);
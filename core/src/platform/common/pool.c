@@ -0,0 +1,373 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides the thread and gate primitives
+// (darling_thread_*, darling_gate_*, darling_cpu_count).
+#include <string.h>
+
+static DarlingPool g_pool;
+static BOOL g_pool_gate_ready = FALSE;
+
+// Deques
+
+// Owner: take the highest band left in its own deque
+static BOOL darling_pool_pop(DarlingPoolDeque* d, int32_t* band) {
+    int32_t b = darling_atomic_load(&d->bottom) - 1;
+    darling_atomic_store(&d->bottom, b);
+    int32_t t = darling_atomic_load(&d->top);
+
+    if (t > b) {
+        darling_atomic_store(&d->bottom, t);
+        return FALSE;
+    }
+
+    if (t == b) {
+        // Last band: a thief may be taking it at the same time
+        BOOL won = darling_atomic_cas(&d->top, t, t + 1);
+        darling_atomic_store(&d->bottom, t + 1);
+        if (!won) {
+            return FALSE;
+        }
+    }
+
+    *band = b;
+    return TRUE;
+}
+
+// Thief: 1 = took the lowest band, 0 = empty, -1 = lost a race (retry)
+static int darling_pool_steal_from(DarlingPoolDeque* d, int32_t* band) {
+    int32_t t = darling_atomic_load(&d->top);
+    int32_t b = darling_atomic_load(&d->bottom);
+
+    if (t >= b) {
+        return 0;
+    }
+
+    if (!darling_atomic_cas(&d->top, t, t + 1)) {
+        return -1;
+    }
+
+    *band = t;
+    return 1;
+}
+
+static BOOL darling_pool_steal(DarlingPool* pool, uint32_t self, int32_t* band) {
+    uint32_t count = pool->workerCount + 1u;
+    BOOL contended = TRUE;
+
+    while (contended) {
+        contended = FALSE;
+        for (uint32_t i = 1; i < count; i++) {
+            int got = darling_pool_steal_from(&pool->deques[(self + i) % count], band);
+            if (got > 0) {
+                darling_atomic_add(&pool->steals, 1);
+                return TRUE;
+            }
+            if (got < 0) {
+                contended = TRUE;
+            }
+        }
+    }
+
+    return FALSE;
+}
+
+// Jobs
+
+static void darling_pool_run_band(DarlingPool* pool, int32_t band) {
+    uint32_t begin = (uint32_t)band * pool->bandRows;
+    uint32_t end = begin + pool->bandRows;
+    if (end > pool->rows) {
+        end = pool->rows;
+    }
+
+    pool->fn(pool->ctx, begin, end);
+    darling_atomic_add(&pool->remaining, -1);
+}
+
+// Run bands until every deque is empty
+static void darling_pool_participate(DarlingPool* pool, uint32_t self) {
+    int32_t band;
+
+    for (;;) {
+        if (darling_pool_pop(&pool->deques[self], &band) || darling_pool_steal(pool, self, &band)) {
+            darling_pool_run_band(pool, band);
+        } else {
+            return;
+        }
+    }
+}
+
+static void darling_pool_worker(void* arg) {
+    DarlingPool* pool = &g_pool;
+    uint32_t self = (uint32_t)(uintptr_t)arg;
+    int32_t seen = darling_atomic_load(&pool->gate.epoch);
+
+    for (;;) {
+        // Spin briefly first: frame jobs tend to arrive back to back
+        uint32_t spin = 0;
+        while (darling_atomic_load(&pool->gate.epoch) == seen && spin++ < DARLING_POOL_SPIN) {
+            darling_cpu_relax();
+        }
+        darling_gate_wait(&pool->gate, seen);
+        seen = darling_atomic_load(&pool->gate.epoch);
+
+        if (darling_atomic_load(&pool->stopping)) {
+            return;
+        }
+
+        // Counted before looking at the job, so its owner waits for us
+        darling_atomic_add(&pool->inside, 1);
+        if (darling_atomic_load(&pool->active)) {
+            darling_pool_participate(pool, self);
+        }
+        darling_atomic_add(&pool->inside, -1);
+    }
+}
+
+// Start the workers if needed. Called with the pool owned.
+static void darling_pool_start(DarlingPool* pool) {
+    if (pool->started) {
+        return;
+    }
+
+    if (!g_pool_gate_ready) {
+        darling_gate_init(&pool->gate);
+        g_pool_gate_ready = TRUE;
+    }
+
+    uint32_t count = pool->configured ? pool->configured : darling_cpu_count();
+    if (count > DARLING_POOL_MAX_THREADS) {
+        count = DARLING_POOL_MAX_THREADS;
+    }
+
+    pool->workerCount = 0;
+    pool->started = TRUE;
+
+    uint32_t cpu = 0;
+    for (uint32_t i = 1; i < count; i++) {
+        // Run with however many threads could be started
+        if (!darling_thread_start(&pool->threads[pool->workerCount], darling_pool_worker, (void*)(uintptr_t)i)) {
+            break;
+        }
+
+        // Workers are pinned round-robin to the CPUs in the mask
+        if (pool->affinity) {
+            while (!(pool->affinity & (1ull << cpu))) {
+                cpu = (cpu + 1u) % 64u;
+            }
+            darling_thread_pin(pool->threads[pool->workerCount], cpu);
+            cpu = (cpu + 1u) % 64u;
+        }
+
+        pool->workerCount++;
+    }
+}
+
+// Join the workers. Called with the pool owned.
+static void darling_pool_stop(DarlingPool* pool) {
+    if (!pool->started) {
+        return;
+    }
+
+    darling_atomic_store(&pool->stopping, 1);
+    darling_gate_open(&pool->gate);
+
+    for (uint32_t i = 0; i < pool->workerCount; i++) {
+        darling_thread_join(pool->threads[i]);
+    }
+
+    darling_atomic_store(&pool->stopping, 0);
+    pool->workerCount = 0;
+    pool->started = FALSE;
+}
+
+// Spin, then give the CPU away: the threads being waited for may not be
+// running if there are more threads than CPUs
+static void darling_pool_backoff(uint32_t* spins) {
+    if (++*spins < DARLING_POOL_SPIN) {
+        darling_cpu_relax();
+    } else {
+        darling_thread_yield();
+    }
+}
+
+static void darling_pool_acquire(DarlingPool* pool) {
+    uint32_t spins = 0;
+    while (!darling_atomic_cas(&pool->busy, 0, 1)) {
+        darling_pool_backoff(&spins);
+    }
+}
+
+// Run fn over `rows` rows of `row_bytes` each, split into bands across the
+// pool. Returns once every row has been processed.
+void darling_pool_for_rows(uint32_t rows, size_t row_bytes, DarlingRowFn fn, void* ctx) {
+    DarlingPool* pool = &g_pool;
+
+    if (rows < 2 || (size_t)rows * row_bytes < DARLING_POOL_MIN_BYTES || pool->configured == 1 ||
+        !darling_atomic_cas(&pool->busy, 0, 1)) {
+        darling_atomic_add(&pool->inlineJobs, 1);
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    darling_pool_start(pool);
+
+    if (pool->workerCount == 0) {
+        darling_atomic_store(&pool->busy, 0);
+        darling_atomic_add(&pool->inlineJobs, 1);
+        fn(ctx, 0, rows);
+        return;
+    }
+
+    uint32_t bandRows = (uint32_t)(DARLING_POOL_BAND_BYTES / (row_bytes ? row_bytes : 1u));
+    if (bandRows == 0) {
+        bandRows = 1;
+    }
+
+    uint32_t bands = (rows + bandRows - 1u) / bandRows;
+    uint32_t count = pool->workerCount + 1u;
+
+    // Each participant starts with a contiguous run of bands
+    for (uint32_t i = 0; i < count; i++) {
+        pool->deques[i].top = (int32_t)((uint64_t)bands * i / count);
+        pool->deques[i].bottom = (int32_t)((uint64_t)bands * (i + 1u) / count);
+    }
+
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->rows = rows;
+    pool->bandRows = bandRows;
+    darling_atomic_store(&pool->remaining, (int32_t)bands);
+    darling_atomic_store(&pool->active, 1);
+    darling_gate_open(&pool->gate);
+
+    darling_pool_participate(pool, 0);
+
+    // Bands other participants took may still be running
+    uint32_t spins = 0;
+    while (darling_atomic_load(&pool->remaining) > 0) {
+        darling_pool_backoff(&spins);
+    }
+
+    darling_atomic_store(&pool->active, 0);
+    while (darling_atomic_load(&pool->inside) > 0) {
+        darling_pool_backoff(&spins);
+    }
+
+    pool->jobs++;
+    pool->bands += bands;
+    darling_atomic_store(&pool->busy, 0);
+}
+
+void darling_pool_shutdown(void) {
+    DarlingPool* pool = &g_pool;
+
+    darling_pool_acquire(pool);
+    darling_pool_stop(pool);
+
+    if (g_pool_gate_ready) {
+        darling_gate_destroy(&pool->gate);
+        g_pool_gate_ready = FALSE;
+    }
+
+    darling_atomic_store(&pool->busy, 0);
+}
+
+// Frame Operations
+
+typedef struct DarlingConvertJob {
+    uint8_t* dst;
+    size_t dstStride;
+    const uint8_t* src;
+    size_t srcStride;
+    uint32_t width;
+    DarlingPoolOp op;
+} DarlingConvertJob;
+
+static void darling_convert_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingConvertJob* job = (const DarlingConvertJob*)ctx;
+    uint8_t* dst = job->dst + (size_t)begin * job->dstStride;
+    const uint8_t* src = job->src + (size_t)begin * job->srcStride;
+    size_t rowBytes = (size_t)job->width * 4u;
+
+    if (job->op == DARLING_POOL_COPY) {
+        darling_frame_copy_rect(dst, job->dstStride, src, job->srcStride, job->width, end - begin);
+        return;
+    }
+
+    // Packed rows convert as one run
+    uint32_t runs = end - begin;
+    size_t pixels = job->width;
+    if (job->dstStride == rowBytes && job->srcStride == rowBytes) {
+        pixels *= runs;
+        runs = 1;
+    }
+
+    for (uint32_t i = 0; i < runs; i++) {
+        uint8_t* d = dst + (size_t)i * job->dstStride;
+        const uint8_t* s = src + (size_t)i * job->srcStride;
+
+        switch (job->op) {
+            case DARLING_POOL_SWIZZLE:
+                darling_frame_rgba_to_bgra(d, s, pixels);
+                break;
+            case DARLING_POOL_SWIZZLE_PREMULTIPLY:
+                // Premultiplied in place while the row is still in cache
+                darling_frame_rgba_to_bgra(d, s, pixels);
+                darling_frame_premultiply(d, d, pixels);
+                break;
+            case DARLING_POOL_UNPREMULTIPLY:
+                darling_frame_unpremultiply(d, s, pixels);
+                break;
+            default:
+                darling_frame_premultiply(d, s, pixels);
+                break;
+        }
+    }
+}
+
+// Copy or convert a w*h rectangle between strided buffers on the pool
+void darling_pool_convert(
+    uint8_t* dst,
+    size_t dst_stride,
+    const uint8_t* src,
+    size_t src_stride,
+    uint32_t w,
+    uint32_t h,
+    DarlingPoolOp op
+) {
+    if (!dst || !src || w == 0 || h == 0) {
+        return;
+    }
+
+    DarlingConvertJob job = { dst, dst_stride, src, src_stride, w, op };
+    darling_pool_for_rows(h, (size_t)w * 4u, darling_convert_rows, &job);
+}
+
+// Public API - Frame Thread Pool
+
+void darling_set_thread_pool(uint32_t threads, uint64_t affinity_mask) {
+    DarlingPool* pool = &g_pool;
+
+    darling_pool_acquire(pool);
+    darling_pool_stop(pool);
+    pool->configured = threads > DARLING_POOL_MAX_THREADS ? DARLING_POOL_MAX_THREADS : threads;
+    pool->affinity = affinity_mask;
+    darling_atomic_store(&pool->busy, 0);
+}
+
+void darling_get_thread_pool_stats(DarlingThreadPoolStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingPool* pool = &g_pool;
+
+    memset(out, 0, sizeof(*out));
+    darling_pool_acquire(pool);
+    out->workers = pool->workerCount;
+    out->jobs = pool->jobs;
+    out->bands = pool->bands;
+    out->inlineJobs = (uint64_t)(uint32_t)darling_atomic_load(&pool->inlineJobs);
+    out->steals = (uint64_t)(uint32_t)darling_atomic_load(&pool->steals);
+    darling_atomic_store(&pool->busy, 0);
+}
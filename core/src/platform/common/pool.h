@@ -0,0 +1,91 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Frame Thread Pool
+// Large frame operations are split into row bands of about
+// DARLING_POOL_BAND_BYTES and run on a pool of worker threads together with
+// the calling thread. Each participant starts with a contiguous run of bands
+// in its own deque, takes from the bottom of it, and when empty steals from
+// the top of the others (Chase-Lev, with band indices as the items).
+//
+// Frames under DARLING_POOL_MIN_BYTES, a pool configured with one thread,
+// and calls made while another job is running (including from inside a
+// band) run inline on the calling thread.
+
+#define DARLING_POOL_MAX_THREADS 64u
+#define DARLING_POOL_BAND_BYTES (64u * 1024u)
+#define DARLING_POOL_MIN_BYTES (1024u * 1024u)
+#define DARLING_POOL_SPIN 4096u             // polls before a worker sleeps
+
+// Process `rows` [begin, end) of the job's frame
+typedef void (*DarlingRowFn)(void* ctx, uint32_t begin, uint32_t end);
+
+// Row operations of darling_pool_convert
+typedef enum DarlingPoolOp {
+    DARLING_POOL_COPY = 0,
+    DARLING_POOL_SWIZZLE = 1,       // RGBA8 -> BGRA8
+    DARLING_POOL_PREMULTIPLY = 2,
+    DARLING_POOL_SWIZZLE_PREMULTIPLY = 3,   // RGBA8 -> premultiplied BGRA8
+    DARLING_POOL_UNPREMULTIPLY = 4
+} DarlingPoolOp;
+
+// Sequentially consistent atomics on 32-bit counters. MSVC has no C11
+// atomics; its Interlocked functions are full barriers.
+#if defined(__GNUC__) || defined(__clang__)
+#define darling_atomic_load(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define darling_atomic_store(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define darling_atomic_add(p, v) __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define darling_atomic_cas(p, expected, desired) \
+    __sync_bool_compare_and_swap((p), (expected), (desired))
+#else
+#define darling_atomic_load(p) InterlockedCompareExchange((volatile LONG*)(p), 0, 0)
+#define darling_atomic_store(p, v) InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+#define darling_atomic_add(p, v) (InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v)) + (LONG)(v))
+#define darling_atomic_cas(p, expected, desired) \
+    (InterlockedCompareExchange((volatile LONG*)(p), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define darling_cpu_relax() _mm_pause()
+#else
+#define darling_cpu_relax() ((void)0)
+#endif
+
+// One participant's band indices [top, bottom); top and bottom on their own
+// cache lines so thieves and the owner do not share one
+typedef struct DarlingPoolDeque {
+    volatile int32_t top;
+    int32_t pad0[15];
+    volatile int32_t bottom;
+    int32_t pad1[15];
+} DarlingPoolDeque;
+
+typedef struct DarlingPool {
+    DarlingThread threads[DARLING_POOL_MAX_THREADS];
+    uint32_t workerCount;           // threads started (participants - 1)
+    uint32_t configured;            // participants requested (0 = one per CPU)
+    uint64_t affinity;              // CPU mask workers are pinned to (0 = any)
+    BOOL started;
+
+    DarlingGate gate;               // opened once per job
+    volatile int32_t stopping;
+
+    // Current job
+    volatile int32_t busy;          // 1 while a caller owns the pool
+    volatile int32_t active;        // bands may be taken
+    volatile int32_t inside;        // workers currently taking bands
+    volatile int32_t remaining;     // bands not yet finished
+    DarlingRowFn fn;
+    void* ctx;
+    uint32_t rows;
+    uint32_t bandRows;
+    DarlingPoolDeque deques[DARLING_POOL_MAX_THREADS];
+
+    // Counters; jobs and bands are only written by the pool owner
+    uint64_t jobs;
+    uint64_t bands;
+    volatile int32_t inlineJobs;
+    volatile int32_t steals;
+} DarlingPool;
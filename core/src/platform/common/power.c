@@ -0,0 +1,314 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h and the common modules it redraws through. The
+// backend provides darling_query_visibility and darling_thread_cpu_ms.
+#include <string.h>
+
+// Power Throttling
+// Visibility is queried again on the window's own show, size and position
+// changes and, since other applications' windows come and go without
+// telling us, for every window from darling_poll_events at most once per
+// checkMs. A change of visibility or throttling is a transition: it is
+// counted, signalled to a native producer through the frame ring header
+// and reported through the visibility callback.
+
+static DarlingThrottlePolicy g_throttle_policy = { 0, 1, 0, 0, 0, DARLING_POWER_CHECK_MS };
+static DarlingVisibilityCallback g_visibility_callback = NULL;
+static double g_power_next_check = 0.0;
+
+// A transition found under the lock, reported once it is released. Only
+// the handle is kept: a window of another thread can be destroyed before
+// the report.
+typedef struct DarlingPowerTransition {
+    uintptr_t hwnd;
+    DarlingVisibility visibility;
+    BOOL throttled;
+    uint32_t rate;
+    BOOL resume;                    // redraw what was skipped
+} DarlingPowerTransition;
+
+static BOOL darling_power_should_throttle(DarlingVisibility visibility) {
+    if (!g_throttle_policy.enabled || visibility == DARLING_VISIBILITY_VISIBLE) {
+        return FALSE;
+    }
+    return visibility != DARLING_VISIBILITY_OCCLUDED || g_throttle_policy.throttleOccluded;
+}
+
+static uint32_t darling_power_rate(DarlingVisibility visibility) {
+    switch (visibility) {
+        case DARLING_VISIBILITY_OCCLUDED:  return g_throttle_policy.occludedRate;
+        case DARLING_VISIBILITY_MINIMIZED: return g_throttle_policy.minimizedRate;
+        case DARLING_VISIBILITY_HIDDEN:    return g_throttle_policy.hiddenRate;
+        default:                           return 0;
+    }
+}
+
+// TRUE if `rects` together cover all of `target`. Each one is cut out of
+// the pieces still uncovered; more pieces than are tracked counts as
+// visible, so a window is never throttled by mistake.
+BOOL darling_power_covered(const DarlingDamageRect* target, const DarlingDamageRect* rects, uint32_t count) {
+    DarlingDamageRect pieces[DARLING_POWER_PIECES];
+    DarlingDamageRect next[DARLING_POWER_PIECES];
+    uint32_t n = 0;
+
+    if (target->x0 >= target->x1 || target->y0 >= target->y1) {
+        return TRUE;
+    }
+    pieces[n++] = *target;
+
+    for (uint32_t i = 0; i < count && n > 0; i++) {
+        uint32_t m = 0;
+
+        for (uint32_t k = 0; k < n; k++) {
+            const DarlingDamageRect* p = &pieces[k];
+            DarlingDamageRect overlap;
+            if (!darling_rect_intersect(p, &rects[i], &overlap)) {
+                if (m == DARLING_POWER_PIECES) {
+                    return FALSE;
+                }
+                next[m++] = *p;
+                continue;
+            }
+
+            // What is left around the overlap: above, below, left, right
+            DarlingDamageRect around[4] = {
+                { p->x0, p->y0, p->x1, overlap.y0 },
+                { p->x0, overlap.y1, p->x1, p->y1 },
+                { p->x0, overlap.y0, overlap.x0, overlap.y1 },
+                { overlap.x1, overlap.y0, p->x1, overlap.y1 }
+            };
+            for (uint32_t j = 0; j < 4; j++) {
+                if (around[j].x0 >= around[j].x1 || around[j].y0 >= around[j].y1) {
+                    continue;
+                }
+                if (m == DARLING_POWER_PIECES) {
+                    return FALSE;
+                }
+                next[m++] = around[j];
+            }
+        }
+
+        memcpy(pieces, next, m * sizeof(DarlingDamageRect));
+        n = m;
+    }
+
+    return n == 0;
+}
+
+// Tell a native producer writing through the frame ring. Called with the
+// lock held.
+void darling_power_signal(DarlingWindow* win) {
+    DarlingFrameRingHeader* h = win->frameRing.header;
+    if (h) {
+        darling_atomic_store(&h->rate, win->power.rate);
+        darling_atomic_store(&h->throttled, win->power.throttled ? 1u : 0u);
+    }
+}
+
+// Redraw what was skipped from what the window retains, or ask for a
+// frame. A frame ring's newest frame waits in the ring for the next poll.
+// Runs on the thread that owns the window.
+void darling_power_resume(DarlingWindow* win) {
+    if (win->surface.width) {
+        darling_surface_refresh(win);
+    } else if (win->displayList.submits) {
+        darling_draw_refresh(win);
+    } else if (!win->frameRing.header && g_frame_request_callback) {
+        g_frame_request_callback((uintptr_t)win->hwnd);
+    }
+}
+
+// Record what the policy makes of `visibility`. Called with the lock held;
+// TRUE, with what to report in `out`, if it was a transition.
+static BOOL darling_power_apply(DarlingWindow* win, DarlingVisibility visibility, DarlingPowerTransition* out) {
+    DarlingPower* p = &win->power;
+    BOOL throttle = darling_power_should_throttle(visibility);
+    uint32_t rate = throttle ? darling_power_rate(visibility) : 0;
+    if (visibility == p->visibility && throttle == p->throttled && rate == p->rate) {
+        return FALSE;
+    }
+
+    if (throttle != p->throttled) {
+        double now = darling_input_now();
+        if (p->throttled) {
+            p->throttledMs += now - p->since;
+        }
+        p->since = now;
+    }
+
+    BOOL resume = p->throttled && !throttle && p->stale;
+    p->visibility = visibility;
+    p->throttled = throttle;
+    p->rate = rate;
+    p->stale = resume ? FALSE : p->stale;
+    p->transitions++;
+    darling_power_signal(win);
+
+    out->hwnd = (uintptr_t)win->hwnd;
+    out->visibility = visibility;
+    out->throttled = throttle;
+    out->rate = rate;
+    out->resume = resume;
+    return TRUE;
+}
+
+// Redraw and tell the app, with the lock released. The window is looked
+// up again: one of this thread's cannot go away meanwhile and is redrawn
+// here, another thread's is asked to redraw itself.
+static void darling_power_report(const DarlingPowerTransition* t) {
+    DarlingWindow* local = NULL;
+
+    darling_lock();
+    DarlingVisibilityCallback callback = g_visibility_callback;
+    if (t->resume) {
+        DarlingWindow* win = darling_list_find((HWND)t->hwnd);
+        if (win && darling_window_is_local(win)) {
+            local = win;
+        } else if (win) {
+            darling_power_post_resume(win);
+        }
+    }
+    darling_unlock();
+
+    if (local) {
+        darling_power_resume(local);
+    }
+    if (callback) {
+        callback(t->hwnd, (uint32_t)t->visibility, t->throttled ? 1u : 0u, t->rate);
+    }
+}
+
+void darling_power_update(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    DarlingVisibility visibility = darling_query_visibility(win);
+    DarlingPowerTransition transition;
+
+    darling_lock();
+    BOOL changed = darling_power_apply(win, visibility, &transition);
+    darling_unlock();
+
+    if (changed) {
+        darling_power_report(&transition);
+    }
+}
+
+// Update every window. Transitions are collected under the lock a batch at
+// a time and reported after it is released. The next batch starts from the
+// handle it stopped at, or from the head if that window is gone; windows
+// already updated have nothing new to report.
+static void darling_power_update_all(void) {
+    DarlingPowerTransition work[DARLING_POWER_BATCH];
+    HWND resume = NULL;
+
+    do {
+        uint32_t count = 0;
+
+        darling_lock();
+        DarlingWindow* it = resume ? darling_list_find(resume) : NULL;
+        it = it ? it : g_window_head;
+        resume = NULL;
+        for (; it; it = it->next) {
+            if (count == DARLING_POWER_BATCH) {
+                resume = it->hwnd;
+                break;
+            }
+            if (it->hwnd && darling_power_apply(it, darling_query_visibility(it), &work[count])) {
+                count++;
+            }
+        }
+        darling_unlock();
+
+        for (uint32_t i = 0; i < count; i++) {
+            darling_power_report(&work[i]);
+        }
+    } while (resume);
+}
+
+void darling_power_poll(void) {
+    double now = darling_input_now();
+
+    darling_lock();
+    BOOL due = now >= g_power_next_check;
+    if (due) {
+        uint32_t interval = g_throttle_policy.checkMs ? g_throttle_policy.checkMs : DARLING_POWER_CHECK_MS;
+        g_power_next_check = now + (double)interval;
+    }
+    darling_unlock();
+
+    if (due) {
+        darling_power_update_all();
+    }
+}
+
+// Start timing a present, or skip it while the window is throttled
+BOOL darling_power_begin(DarlingWindow* win, DarlingPowerSample* sample) {
+    darling_lock();
+    DarlingPower* p = &win->power;
+    if (p->throttled) {
+        p->skipped++;
+        p->stale = TRUE;
+        darling_unlock();
+        return FALSE;
+    }
+    darling_unlock();
+
+    sample->wallMs = darling_input_now();
+    sample->cpuMs = darling_thread_cpu_ms();
+    return TRUE;
+}
+
+void darling_power_end(DarlingWindow* win, const DarlingPowerSample* sample) {
+    double cpu = darling_thread_cpu_ms() - sample->cpuMs;
+    double wall = darling_input_now() - sample->wallMs;
+
+    darling_lock();
+    DarlingPower* p = &win->power;
+    p->presents++;
+    p->presentMs += wall;
+    p->presentCpuMs += cpu;
+    darling_unlock();
+}
+
+// Public API - Power Throttling
+
+void darling_set_throttle_policy(const DarlingThrottlePolicy* policy) {
+    DarlingThrottlePolicy disabled = { 0, 1, 0, 0, 0, DARLING_POWER_CHECK_MS };
+
+    darling_lock();
+    g_throttle_policy = policy ? *policy : disabled;
+    darling_unlock();
+
+    // Windows already hidden pick up the new policy now
+    darling_power_update_all();
+}
+
+void darling_get_power_stats(DarlingWindow* win, DarlingPowerStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingPowerStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        const DarlingPower* p = &win->power;
+        stats.visibility = (uint32_t)p->visibility;
+        stats.throttled = p->throttled ? 1u : 0u;
+        stats.rate = p->rate;
+        stats.transitions = p->transitions;
+        stats.presents = p->presents;
+        stats.skippedPresents = p->skipped;
+        stats.presentMs = p->presentMs;
+        stats.presentCpuMs = p->presentCpuMs;
+        stats.throttledMs = p->throttledMs + (p->throttled ? darling_input_now() - p->since : 0.0);
+        darling_unlock();
+    }
+
+    *out = stats;
+}
+
+void darling_set_visibility_callback(DarlingVisibilityCallback callback) {
+    g_visibility_callback = callback;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+
+// Power Throttling
+// A window's visibility as last seen and what the policy made of it. Each
+// present that runs is timed here; one skipped while throttled leaves the
+// window stale until it is redrawn.
+
+#define DARLING_POWER_CHECK_MS 250u
+#define DARLING_POWER_MAX_ABOVE 256u    // windows above one considered for occlusion
+#define DARLING_POWER_PIECES 64u        // uncovered rectangles tracked before assuming visible
+#define DARLING_POWER_BATCH 32u         // transitions reported per pass of the lock
+
+typedef struct DarlingPowerSample {
+    double wallMs;
+    double cpuMs;
+} DarlingPowerSample;
+
+typedef struct DarlingPower {
+    DarlingVisibility visibility;
+    BOOL throttled;
+    BOOL stale;                     // a present was skipped; redraw when unthrottled
+    uint32_t rate;                  // asked of producers while throttled
+    double since;                   // when `throttled` last changed
+    double throttledMs;             // spent throttled before `since`
+    uint64_t transitions;
+    uint64_t presents;
+    uint64_t skipped;
+    double presentMs;
+    double presentCpuMs;
+} DarlingPower;
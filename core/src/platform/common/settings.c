@@ -0,0 +1,159 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h and list.c.
+
+// System Settings Service
+
+static DarlingSystemSettings g_settings;
+static BOOL g_settings_valid = FALSE;
+static BOOL g_settings_refresh_pending = FALSE;
+static uint64_t g_settings_reads = 0;
+static DarlingSettingsProvider g_settings_provider = { darling_read_system_settings, NULL };
+
+static void darling_settings_read_locked(DarlingSystemSettings* out) {
+    DarlingSystemSettings fresh = {0};
+
+    g_settings_reads++;
+    if (!g_settings_provider.read || !g_settings_provider.read(g_settings_provider.ctx, &fresh)) {
+        // Keep the last known values if the source is unavailable
+        fresh = g_settings;
+    }
+
+    *out = fresh;
+}
+
+void darling_settings_set_provider(const DarlingSettingsProvider* provider) {
+    darling_lock();
+
+    if (provider) {
+        g_settings_provider = *provider;
+    } else {
+        g_settings_provider.read = darling_read_system_settings;
+        g_settings_provider.ctx = NULL;
+    }
+
+    g_settings_valid = FALSE;
+    g_settings_refresh_pending = FALSE;
+
+    darling_unlock();
+}
+
+void darling_settings_get(DarlingSystemSettings* out) {
+    darling_lock();
+
+    if (!g_settings_valid) {
+        darling_settings_read_locked(&g_settings);
+        g_settings_valid = TRUE;
+    }
+
+    *out = g_settings;
+
+    darling_unlock();
+}
+
+int darling_settings_notify_change(void) {
+    darling_lock();
+
+    BOOL first = !g_settings_refresh_pending;
+    g_settings_refresh_pending = TRUE;
+
+    darling_unlock();
+
+    return first ? 1 : 0;
+}
+
+// Re-theme the windows the calling thread owns outside the lock (the frame
+// change re-enters their window procedures); the rest get a message and
+// apply it on their own thread. Windows are taken in batches; one destroyed
+// meanwhile would be destroyed on this thread.
+static void darling_settings_apply_dark_mode(BOOL dark) {
+    DarlingWindow* work[DARLING_SETTINGS_BATCH];
+    DarlingWindow* resume = NULL;
+
+    do {
+        uint32_t count = 0;
+
+        darling_lock();
+        DarlingWindow* it = resume ? resume : g_window_head;
+        resume = NULL;
+        for (; it; it = it->next) {
+            if (it->isChild || !it->hwnd) {
+                continue;
+            }
+            if (!darling_window_is_local(it)) {
+                darling_settings_post_theme(it);
+                continue;
+            }
+            if (count == DARLING_SETTINGS_BATCH) {
+                resume = it;
+                break;
+            }
+            work[count++] = it;
+        }
+        darling_unlock();
+
+        for (uint32_t i = 0; i < count; i++) {
+            darling_apply_dark_mode_internal(work[i], dark);
+        }
+    } while (resume);
+}
+
+uint32_t darling_settings_refresh(void) {
+    uint32_t changed = 0;
+    DarlingSystemSettings fresh;
+
+    darling_lock();
+
+    g_settings_refresh_pending = FALSE;
+    darling_settings_read_locked(&fresh);
+
+    if (!g_settings_valid || fresh.darkMode != g_settings.darkMode) {
+        changed |= DARLING_SETTINGS_CHANGED_DARK_MODE;
+    }
+    if (!g_settings_valid || fresh.accentColor != g_settings.accentColor) {
+        changed |= DARLING_SETTINGS_CHANGED_ACCENT_COLOR;
+    }
+    if (!g_settings_valid || fresh.highContrast != g_settings.highContrast) {
+        changed |= DARLING_SETTINGS_CHANGED_HIGH_CONTRAST;
+    }
+
+    g_settings = fresh;
+    g_settings_valid = TRUE;
+
+    darling_unlock();
+
+    // Fan out to every top-level window in one pass over the list
+    if (changed & DARLING_SETTINGS_CHANGED_DARK_MODE) {
+        darling_settings_apply_dark_mode(fresh.darkMode ? TRUE : FALSE);
+    }
+
+    return changed;
+}
+
+uint64_t darling_settings_read_count(void) {
+    darling_lock();
+    uint64_t reads = g_settings_reads;
+    darling_unlock();
+    return reads;
+}
+
+// Theme Detection
+
+BOOL darling_is_system_dark_mode(void) {
+    DarlingSystemSettings s;
+    darling_settings_get(&s);
+    return s.darkMode ? TRUE : FALSE;
+}
+
+// Public API - System Settings
+
+uint32_t darling_get_accent_color(void) {
+    DarlingSystemSettings s;
+    darling_settings_get(&s);
+    return s.accentColor;
+}
+
+int darling_is_high_contrast(void) {
+    DarlingSystemSettings s;
+    darling_settings_get(&s);
+    return s.highContrast ? 1 : 0;
+}
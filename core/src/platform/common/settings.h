@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+// System Settings Service
+// Process-wide cache of theme-related system settings. Values are read once
+// through a provider and re-read only when the OS reports a change; the new
+// values are then applied to every Darling window in a single pass.
+
+typedef struct DarlingSystemSettings {
+    int darkMode;           // apps use the dark theme
+    uint32_t accentColor;   // 0xRRGGBB
+    int highContrast;       // high-contrast mode is on
+} DarlingSystemSettings;
+
+// Bits returned by darling_settings_refresh
+#define DARLING_SETTINGS_CHANGED_DARK_MODE      0x1u
+#define DARLING_SETTINGS_CHANGED_ACCENT_COLOR   0x2u
+#define DARLING_SETTINGS_CHANGED_HIGH_CONTRAST  0x4u
+
+#define DARLING_SETTINGS_BATCH 32u      // windows re-themed per pass of the lock
+
+// Source of system settings. `read` returns non-zero on success.
+typedef struct DarlingSettingsProvider {
+    int (*read)(void* ctx, DarlingSystemSettings* out);
+    void* ctx;
+} DarlingSettingsProvider;
+
+// Replace the settings source (NULL restores the platform provider).
+// Invalidates the cache; the next query reads from the new provider.
+void darling_settings_set_provider(const DarlingSettingsProvider* provider);
+
+// Copy the cached settings, reading them on first use
+void darling_settings_get(DarlingSystemSettings* out);
+
+// Record a change notification. Returns non-zero only for the first
+// notification since the last refresh; that caller schedules the refresh.
+int darling_settings_notify_change(void);
+
+// Re-read settings once and, if anything changed, apply the new values to
+// all windows. Returns the DARLING_SETTINGS_CHANGED_* mask.
+uint32_t darling_settings_refresh(void);
+
+// Number of provider reads so far (diagnostics and benchmarks)
+uint64_t darling_settings_read_count(void);
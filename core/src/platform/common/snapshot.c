@@ -0,0 +1,305 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend maps files (darling_file_map,
+// darling_file_unmap, darling_file_replace), calls darling_splash_begin from
+// darling_create_window and darling_splash_poll from darling_poll_events.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Splash Snapshot
+
+static char* g_splash_path = NULL;      // shown by the next top-level window
+
+static uint64_t darling_snapshot_frame_bytes(uint32_t w, uint32_t h) {
+    return ((uint64_t)w * h * 4u + 4095u) & ~(uint64_t)4095u;
+}
+
+// The header of a mapped snapshot, or NULL unless it is whole and of this
+// version
+static const DarlingSnapshotHeader* darling_snapshot_header(const DarlingMappedFile* file) {
+    if (!file->base || file->bytes < DARLING_SNAPSHOT_HEADER_BYTES) {
+        return NULL;
+    }
+
+    const DarlingSnapshotHeader* h = (const DarlingSnapshotHeader*)file->base;
+    if (h->magic != DARLING_SNAPSHOT_MAGIC || h->version != DARLING_SNAPSHOT_VERSION ||
+        h->headerBytes != DARLING_SNAPSHOT_HEADER_BYTES || !darling_frame_size_ok(h->width, h->height) ||
+        h->frames == 0 || h->frames > DARLING_SNAPSHOT_MAX_FRAMES ||
+        h->frameBytes != darling_snapshot_frame_bytes(h->width, h->height) ||
+        (uint64_t)file->bytes < DARLING_SNAPSHOT_HEADER_BYTES + h->frameBytes * h->frames) {
+        return NULL;
+    }
+    return h;
+}
+
+static const uint8_t* darling_snapshot_frame(const DarlingSnapshotHeader* h, uint32_t index) {
+    return (const uint8_t*)h + h->headerBytes + h->frameBytes * index;
+}
+
+// Write header and frames (packed, width * 4 bytes per row) to a new file
+static BOOL darling_snapshot_write(const char* path, const DarlingSnapshotHeader* header, const uint8_t* frames) {
+    uint64_t bytes = DARLING_SNAPSHOT_HEADER_BYTES + header->frameBytes * header->frames;
+    if (bytes != (size_t)bytes) {
+        return FALSE;
+    }
+
+    DarlingMappedFile file;
+    if (!darling_file_map(&file, path, (size_t)bytes)) {
+        return FALSE;
+    }
+
+    uint8_t* base = (uint8_t*)file.base;
+    size_t frameSize = (size_t)header->width * header->height * 4u;
+    for (uint32_t i = 0; i < header->frames; i++) {
+        memcpy(base + DARLING_SNAPSHOT_HEADER_BYTES + header->frameBytes * i, frames + frameSize * i, frameSize);
+    }
+    memcpy(base, header, sizeof(*header));
+
+    darling_file_unmap(&file);
+    return TRUE;
+}
+
+// Paint one strip frame. Called with the lock held.
+static void darling_splash_present(DarlingWindow* win, uint32_t index) {
+    DarlingSplash* s = &win->splash;
+    const DarlingSnapshotHeader* h = s->header;
+
+    s->painting = TRUE;
+    darling_paint_frame_window(win, darling_snapshot_frame(h, index), h->width, h->height);
+    s->painting = FALSE;
+    s->shown++;
+}
+
+// Show the pending splash snapshot in a new top-level window: its theme,
+// then its first frame. TRUE if one was shown (the theme is then set).
+BOOL darling_splash_begin(DarlingWindow* win, double created_ms) {
+    DarlingSplash* s = &win->splash;
+
+    darling_lock();
+    char* path = g_splash_path;
+    g_splash_path = NULL;
+    darling_unlock();
+
+    if (!path) {
+        return FALSE;
+    }
+
+    BOOL mapped = darling_file_map(&s->file, path, 0);
+    free(path);
+
+    const DarlingSnapshotHeader* h = mapped ? darling_snapshot_header(&s->file) : NULL;
+    if (!h) {
+        darling_file_unmap(&s->file);
+        return FALSE;
+    }
+
+    darling_apply_dark_mode_internal(win, (h->flags & DARLING_STATE_DARK) != 0);
+
+    darling_lock();
+    s->header = h;
+    s->frames = h->frames;
+    s->showing = TRUE;
+    darling_splash_present(win, 0);
+
+    double now = darling_input_now();
+    s->firstPixelMs = now - created_ms;
+
+    // A still is in the backing store now; a strip stays mapped to play
+    if (h->frames > 1) {
+        s->next = 1;
+        s->nextMs = now + h->frameMs;
+    } else {
+        s->header = NULL;
+        darling_file_unmap(&s->file);
+    }
+    darling_unlock();
+    return TRUE;
+}
+
+// A frame from the app replaces the splash
+void darling_splash_end(DarlingWindow* win) {
+    darling_lock();
+    DarlingSplash* s = &win->splash;
+    if (s->showing && !s->painting) {
+        s->showing = FALSE;
+        s->header = NULL;
+        darling_file_unmap(&s->file);
+    }
+    darling_unlock();
+}
+
+// Advance every playing strip whose next frame is due. Strips loop.
+void darling_splash_poll(void) {
+    double now = darling_input_now();
+
+    darling_lock();
+    for (DarlingWindow* it = g_window_head; it; it = it->next) {
+        DarlingSplash* s = &it->splash;
+        if (!s->header || now < s->nextMs) {
+            continue;
+        }
+
+        darling_splash_present(it, s->next);
+        s->next = (s->next + 1u) % s->frames;
+        s->nextMs = now + s->header->frameMs;
+    }
+    darling_unlock();
+}
+
+void darling_splash_free(DarlingWindow* win) {
+    darling_file_unmap(&win->splash.file);
+    memset(&win->splash, 0, sizeof(win->splash));
+}
+
+// Public API - Splash Snapshot
+
+int darling_snapshot_save(
+    DarlingWindow* win,
+    const char* path,
+    const uint8_t* frames,
+    uint32_t width,
+    uint32_t height,
+    uint32_t count,
+    uint32_t frame_ms
+) {
+    if (!win || !win->hwnd || !path || !path[0]) {
+        return 0;
+    }
+    if (frames && (!darling_frame_size_ok(width, height) || count == 0 || count > DARLING_SNAPSHOT_MAX_FRAMES)) {
+        return 0;
+    }
+
+    DarlingWindowState state;
+    darling_query_window_state(win, &state);
+
+    // Written beside the target and renamed over it, so a launch never maps
+    // a file half written
+    size_t len = strlen(path);
+    char* temp = (char*)malloc(len + 5u);
+    if (!temp) {
+        return 0;
+    }
+    snprintf(temp, len + 5u, "%s.tmp", path);
+
+    // Without caller frames, a copy of the window's presented image, so the
+    // file is written without holding the lock
+    uint8_t* copy = NULL;
+    if (!frames) {
+        darling_lock();
+        if (win->dibBits && !win->evicted) {
+            width = win->bitmapWidth;
+            height = win->bitmapHeight;
+            copy = (uint8_t*)malloc((size_t)width * height * 4u);
+            if (copy) {
+                memcpy(copy, win->dibBits, (size_t)width * height * 4u);
+            }
+        }
+        darling_unlock();
+        if (!copy) {
+            free(temp);
+            return 0;
+        }
+        frames = copy;
+        count = 1;
+        frame_ms = 0;
+    }
+
+    DarlingSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = DARLING_SNAPSHOT_MAGIC;
+    header.version = DARLING_SNAPSHOT_VERSION;
+    header.headerBytes = DARLING_SNAPSHOT_HEADER_BYTES;
+    header.flags = state.flags;
+    header.width = width;
+    header.height = height;
+    header.frames = count;
+    header.frameMs = frame_ms;
+    header.x = state.x;
+    header.y = state.y;
+    header.windowWidth = state.width;
+    header.windowHeight = state.height;
+    header.dpi = state.dpi;
+    header.frameBytes = darling_snapshot_frame_bytes(width, height);
+
+    BOOL ok = darling_snapshot_write(temp, &header, frames);
+    free(copy);
+
+    ok = ok && darling_file_replace(temp, path);
+    if (!ok) {
+        remove(temp);
+    }
+    free(temp);
+    return ok ? 1 : 0;
+}
+
+int darling_snapshot_read_info(const char* path, DarlingSnapshotInfo* out) {
+    if (!path || !out) {
+        return 0;
+    }
+
+    memset(out, 0, sizeof(*out));
+
+    DarlingMappedFile file;
+    if (!darling_file_map(&file, path, 0)) {
+        return 0;
+    }
+
+    const DarlingSnapshotHeader* h = darling_snapshot_header(&file);
+    if (h) {
+        out->width = h->width;
+        out->height = h->height;
+        out->frames = h->frames;
+        out->frameMs = h->frameMs;
+        out->x = h->x;
+        out->y = h->y;
+        out->windowWidth = h->windowWidth;
+        out->windowHeight = h->windowHeight;
+        out->dpi = h->dpi;
+        out->flags = h->flags;
+    }
+
+    darling_file_unmap(&file);
+    return h ? 1 : 0;
+}
+
+void darling_set_splash_snapshot(const char* path) {
+    char* copy = NULL;
+
+    if (path && path[0]) {
+        size_t len = strlen(path);
+        copy = (char*)malloc(len + 1u);
+        if (copy) {
+            memcpy(copy, path, len + 1u);
+        }
+    }
+
+    darling_lock();
+    free(g_splash_path);
+    g_splash_path = copy;
+    darling_unlock();
+}
+
+void darling_end_splash(DarlingWindow* win) {
+    if (win) {
+        darling_splash_end(win);
+    }
+}
+
+void darling_get_splash_stats(DarlingWindow* win, DarlingSplashStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingSplash* s = &win->splash;
+    out->showing = s->showing ? 1u : 0u;
+    out->frames = s->frames;
+    out->shown = s->shown;
+    out->firstPixelMs = s->firstPixelMs;
+    darling_unlock();
+}
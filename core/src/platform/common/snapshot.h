@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+
+// Splash Snapshot
+// A window's last frame saved to a file with its rectangle and theme, so
+// the next launch can show it the moment the window exists, before the app
+// has drawn anything. Frames are stored as the backing store holds them
+// (BGRA, top down, width * 4 bytes per row) and the file is mapped, so
+// showing one is a copy out of the page cache with nothing to decode. A
+// file may hold a short strip of frames, looped until the app's first frame
+// replaces it.
+//
+// The backend maps files; everything else is shared.
+
+#define DARLING_SNAPSHOT_MAGIC 0x504E5344u          // "DSNP"
+#define DARLING_SNAPSHOT_VERSION 1u
+#define DARLING_SNAPSHOT_HEADER_BYTES 4096u         // frames start page aligned
+#define DARLING_SNAPSHOT_MAX_FRAMES 120u
+
+typedef struct DarlingSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerBytes;
+    uint32_t flags;                 // DarlingWindowStateFlags when saved
+    uint32_t width;
+    uint32_t height;
+    uint32_t frames;
+    uint32_t frameMs;
+    int32_t x;
+    int32_t y;
+    int32_t windowWidth;
+    int32_t windowHeight;
+    uint32_t dpi;
+    uint32_t reserved;
+    uint64_t frameBytes;            // width * height * 4, rounded up to a page
+} DarlingSnapshotHeader;
+
+typedef struct DarlingSplash {
+    DarlingMappedFile file;                 // held while a strip plays
+    const DarlingSnapshotHeader* header;    // NULL once nothing is left to play
+    uint32_t next;                          // strip frame shown next
+    double nextMs;                          // when it is due (darling_input_now)
+    BOOL showing;                           // no frame from the app yet
+    BOOL painting;                          // presenting one of its own frames
+    uint32_t frames;
+    uint64_t shown;
+    double firstPixelMs;                    // window creation to the first frame
+} DarlingSplash;
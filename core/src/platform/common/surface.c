@@ -0,0 +1,728 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h, and after compositor.c, whose rectangle helpers it
+// uses. Drawing only needs the backend's backing store and rectangle
+// invalidation (darling_compositor_invalidate).
+#include <stdlib.h>
+#include <string.h>
+
+// Virtual Surface
+
+static DarlingTileRequestCallback g_tile_request_callback = NULL;
+
+static uint32_t darling_surface_hash(int32_t col, int32_t row) {
+    uint32_t h = (uint32_t)col * 0x9E3779B1u ^ (uint32_t)row * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+static int32_t darling_surface_find(const DarlingSurface* s, int32_t col, int32_t row) {
+    int32_t i = s->buckets[darling_surface_hash(col, row) & s->bucketMask];
+    while (i != DARLING_SURFACE_NONE && (s->tiles[i].col != col || s->tiles[i].row != row)) {
+        i = s->tiles[i].next;
+    }
+    return i;
+}
+
+// Unlink a tile from its bucket and return its slot to the free list
+static void darling_surface_remove(DarlingSurface* s, int32_t index) {
+    DarlingSurfaceTile* t = &s->tiles[index];
+    int32_t* link = &s->buckets[darling_surface_hash(t->col, t->row) & s->bucketMask];
+
+    while (*link != index) {
+        link = &s->tiles[*link].next;
+    }
+    *link = t->next;
+
+    if (t->pixels) {
+        free(t->pixels);
+        s->cached--;
+    } else {
+        s->pending--;
+    }
+
+    memset(t, 0, sizeof(*t));
+    t->next = s->freeSlot;
+    s->freeSlot = index;
+}
+
+// Least recently used tile, among those holding pixels or all of them
+static int32_t darling_surface_oldest(const DarlingSurface* s, BOOL with_pixels) {
+    int32_t oldest = DARLING_SURFACE_NONE;
+    for (uint32_t i = 0; i < s->slots; i++) {
+        const DarlingSurfaceTile* t = &s->tiles[i];
+        if (t->lastUse == 0 || (with_pixels && !t->pixels)) {
+            continue;
+        }
+        // A fill in progress may still copy from the tiles it has touched
+        if (s->passStart && t->lastUse > s->passStart) {
+            continue;
+        }
+        if (oldest == DARLING_SURFACE_NONE || t->lastUse < s->tiles[oldest].lastUse) {
+            oldest = (int32_t)i;
+        }
+    }
+    return oldest;
+}
+
+// Add a tile with no pixels yet, evicting the least recently used one if
+// every slot is taken
+static int32_t darling_surface_insert(DarlingSurface* s, int32_t col, int32_t row) {
+    if (s->freeSlot == DARLING_SURFACE_NONE) {
+        int32_t victim = darling_surface_oldest(s, FALSE);
+        if (victim == DARLING_SURFACE_NONE) {
+            return DARLING_SURFACE_NONE;
+        }
+        if (s->tiles[victim].pixels) {
+            s->tileEvictions++;
+        }
+        darling_surface_remove(s, victim);
+    }
+
+    int32_t index = s->freeSlot;
+    DarlingSurfaceTile* t = &s->tiles[index];
+    s->freeSlot = t->next;
+
+    uint32_t bucket = darling_surface_hash(col, row) & s->bucketMask;
+    t->col = col;
+    t->row = row;
+    t->pixels = NULL;
+    t->lastUse = ++s->clock;
+    t->next = s->buckets[bucket];
+    s->buckets[bucket] = index;
+    s->pending++;
+    return index;
+}
+
+static void darling_surface_request(DarlingSurface* s, int32_t col, int32_t row) {
+    if (s->requestCount == s->requestCapacity) {
+        uint32_t grown = s->requestCapacity ? s->requestCapacity * 2u : 64u;
+        int32_t* requests = (int32_t*)realloc(s->requests, (size_t)grown * 2u * sizeof(int32_t));
+        if (!requests) {
+            return;
+        }
+        s->requests = requests;
+        s->requestCapacity = grown;
+    }
+
+    s->requests[s->requestCount * 2u] = col;
+    s->requests[s->requestCount * 2u + 1u] = row;
+    s->requestCount++;
+    s->requested++;
+}
+
+static void darling_surface_fill_rect(uint32_t* target, uint32_t stride, const DarlingDamageRect* r, uint32_t color) {
+    for (int32_t y = r->y0; y < r->y1; y++) {
+        uint32_t* row = target + (size_t)y * stride;
+        for (int32_t x = r->x0; x < r->x1; x++) {
+            row[x] = color;
+        }
+    }
+}
+
+typedef struct DarlingSurfaceJob {
+    uint32_t* target;
+    uint32_t stride;
+    DarlingDamageRect rect;
+    const DarlingSurfacePart* parts;
+    uint32_t partCount;
+    uint32_t background;
+    BOOL outside;                   // the rectangle reaches past the surface
+} DarlingSurfaceJob;
+
+// Rows [begin, end) of the job's rectangle; run on the frame thread pool
+static void darling_surface_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingSurfaceJob* job = (const DarlingSurfaceJob*)ctx;
+    int32_t y0 = job->rect.y0 + (int32_t)begin;
+    int32_t y1 = job->rect.y0 + (int32_t)end;
+
+    if (job->outside) {
+        DarlingDamageRect band = { job->rect.x0, y0, job->rect.x1, y1 };
+        darling_surface_fill_rect(job->target, job->stride, &band, job->background);
+    }
+
+    for (uint32_t i = 0; i < job->partCount; i++) {
+        const DarlingSurfacePart* part = &job->parts[i];
+        int32_t top = part->rect.y0 > y0 ? part->rect.y0 : y0;
+        int32_t bottom = part->rect.y1 < y1 ? part->rect.y1 : y1;
+        if (top >= bottom) {
+            continue;
+        }
+
+        if (!part->src) {
+            DarlingDamageRect r = { part->rect.x0, top, part->rect.x1, bottom };
+            darling_surface_fill_rect(job->target, job->stride, &r, job->background);
+            continue;
+        }
+
+        size_t bytes = (size_t)(part->rect.x1 - part->rect.x0) * 4u;
+        const uint32_t* src = part->src + (size_t)(top - part->rect.y0) * part->srcStride;
+        for (int32_t y = top; y < bottom; y++) {
+            memcpy(job->target + (size_t)y * job->stride + part->rect.x0, src, bytes);
+            src += part->srcStride;
+        }
+    }
+}
+
+// Copy a viewport rectangle in from the tiles under it. Tiles not cached
+// leave the background and are requested, once until they arrive. Tiles
+// are looked up first, then copied on the frame thread pool.
+static BOOL darling_surface_fill(DarlingSurface* s, uint32_t* target, uint32_t stride, const DarlingDamageRect* r) {
+    int64_t ts = s->tileSize;
+    int64_t sx0 = (int64_t)s->x + r->x0;
+    int64_t sy0 = (int64_t)s->y + r->y0;
+    int64_t sx1 = (int64_t)s->x + r->x1;
+    int64_t sy1 = (int64_t)s->y + r->y1;
+
+    DarlingSurfaceJob job = { target, stride, *r, NULL, 0, s->background, FALSE };
+
+    // Past the surface's edges there is only the background
+    job.outside = sx1 > s->width || sy1 > s->height;
+    sx1 = sx1 < s->width ? sx1 : s->width;
+    sy1 = sy1 < s->height ? sy1 : s->height;
+
+    uint64_t needed = sx1 > sx0 && sy1 > sy0 ?
+        (uint64_t)((sx1 - 1) / ts - sx0 / ts + 1) * (uint64_t)((sy1 - 1) / ts - sy0 / ts + 1) : 0;
+    if (needed > s->partCapacity) {
+        DarlingSurfacePart* parts = (DarlingSurfacePart*)realloc(s->parts, (size_t)needed * sizeof(DarlingSurfacePart));
+        if (!parts) {
+            return FALSE;
+        }
+        s->parts = parts;
+        s->partCapacity = (uint32_t)needed;
+    }
+
+    s->passStart = s->clock ? s->clock : ++s->clock;
+    for (int64_t row = sy0 / ts; row * ts < sy1; row++) {
+        for (int64_t col = sx0 / ts; col * ts < sx1; col++) {
+            int64_t x0 = col * ts > sx0 ? col * ts : sx0;
+            int64_t y0 = row * ts > sy0 ? row * ts : sy0;
+            int64_t x1 = (col + 1) * ts < sx1 ? (col + 1) * ts : sx1;
+            int64_t y1 = (row + 1) * ts < sy1 ? (row + 1) * ts : sy1;
+            DarlingSurfacePart* part = &s->parts[job.partCount++];
+            DarlingDamageRect rect = {
+                (int32_t)(x0 - s->x), (int32_t)(y0 - s->y), (int32_t)(x1 - s->x), (int32_t)(y1 - s->y)
+            };
+            part->rect = rect;
+            part->src = NULL;
+            part->srcStride = (uint32_t)ts;
+
+            int32_t i = darling_surface_find(s, (int32_t)col, (int32_t)row);
+            if (i == DARLING_SURFACE_NONE || !s->tiles[i].pixels) {
+                s->misses++;
+                if (i == DARLING_SURFACE_NONE && darling_surface_insert(s, (int32_t)col, (int32_t)row) != DARLING_SURFACE_NONE) {
+                    darling_surface_request(s, (int32_t)col, (int32_t)row);
+                }
+                continue;
+            }
+
+            DarlingSurfaceTile* t = &s->tiles[i];
+            t->lastUse = ++s->clock;
+            s->hits++;
+            part->src = t->pixels + (size_t)(y0 - row * ts) * (size_t)ts + (size_t)(x0 - col * ts);
+            s->copiedPixels += (uint64_t)darling_rect_area(&rect);
+        }
+    }
+
+    job.parts = s->parts;
+    darling_pool_for_rows((uint32_t)(r->y1 - r->y0), (size_t)(r->x1 - r->x0) * 4u, darling_surface_rows, &job);
+    s->passStart = 0;
+    return TRUE;
+}
+
+// Move what the target shows by the viewport's movement: the pixel now at
+// (x, y) is the one that was at (x + dx, y + dy)
+static void darling_surface_shift(uint32_t* px, uint32_t w, uint32_t h, int32_t dx, int32_t dy) {
+    uint32_t cols = w - (uint32_t)(dx < 0 ? -dx : dx);
+    uint32_t rows = h - (uint32_t)(dy < 0 ? -dy : dy);
+    uint32_t srcX = dx > 0 ? (uint32_t)dx : 0;
+    uint32_t dstX = dx < 0 ? (uint32_t)-dx : 0;
+
+    // Whole rows move as one block
+    if (dx == 0) {
+        size_t from = dy > 0 ? (size_t)dy * w : 0;
+        size_t to = dy < 0 ? (size_t)-dy * w : 0;
+        memmove(px + to, px + from, (size_t)rows * w * 4u);
+        return;
+    }
+
+    if (dy >= 0) {
+        for (uint32_t y = 0; y < rows; y++) {
+            memmove(px + (size_t)y * w + dstX, px + (size_t)(y + (uint32_t)dy) * w + srcX, (size_t)cols * 4u);
+        }
+    } else {
+        for (uint32_t y = rows; y-- > 0;) {
+            memmove(px + (size_t)(y + (uint32_t)-dy) * w + dstX, px + (size_t)y * w + srcX, (size_t)cols * 4u);
+        }
+    }
+}
+
+// Forget requests for tiles that left the viewport, so they are asked for
+// again if they come back into view
+static void darling_surface_drop_hidden(DarlingSurface* s) {
+    int64_t ts = s->tileSize;
+    int64_t c0 = (int64_t)s->x / ts;
+    int64_t r0 = (int64_t)s->y / ts;
+    int64_t c1 = ((int64_t)s->x + s->viewWidth + ts - 1) / ts;
+    int64_t r1 = ((int64_t)s->y + s->viewHeight + ts - 1) / ts;
+
+    for (uint32_t i = 0; i < s->slots && s->pending; i++) {
+        const DarlingSurfaceTile* t = &s->tiles[i];
+        if (t->lastUse && !t->pixels && (t->col < c0 || t->col >= c1 || t->row < r0 || t->row >= r1)) {
+            darling_surface_remove(s, (int32_t)i);
+        }
+    }
+}
+
+// Bring the target up to date with the viewport: shift it if the viewport
+// moved, then fill the exposed and dirty rectangles, and present. Returns
+// the number of tiles found missing, with their (col, row) pairs in
+// `requests` for the caller to free.
+static uint32_t darling_surface_draw(DarlingWindow* win, int32_t** requests) {
+    DarlingSurface* s = &win->surface;
+    DarlingDamageRect rects[DARLING_DAMAGE_MAX];
+    uint32_t count = 0;
+    uint32_t requestCount = 0;
+
+    darling_lock();
+
+    if (!s->width) {
+        darling_unlock();
+        return 0;
+    }
+
+    int32_t cw = 0;
+    int32_t ch = 0;
+    darling_query_client_size(win, &cw, &ch);
+
+    // A minimized window has no client area; keep the store's size
+    uint32_t w = cw > 0 ? (uint32_t)cw : win->bitmapWidth;
+    uint32_t h = ch > 0 ? (uint32_t)ch : win->bitmapHeight;
+    if (w == 0 || h == 0 || !darling_frame_size_ok(w, h)) {
+        s->valid = FALSE;
+        darling_unlock();
+        return 0;
+    }
+
+    if (!win->dibBits || win->bitmapWidth != w || win->bitmapHeight != h) {
+        if (!darling_alloc_backing_store(win, w, h)) {
+            s->valid = FALSE;
+            darling_unlock();
+            return 0;
+        }
+        s->valid = FALSE;
+    }
+
+    // Keep the viewport on the surface
+    uint32_t maxX = s->width > w ? s->width - w : 0;
+    uint32_t maxY = s->height > h ? s->height - h : 0;
+    s->x = s->x < maxX ? s->x : maxX;
+    s->y = s->y < maxY ? s->y : maxY;
+
+    int64_t dx = (int64_t)s->x - s->viewX;
+    int64_t dy = (int64_t)s->y - s->viewY;
+    BOOL full = !s->valid || s->viewWidth != w || s->viewHeight != h || s->evictions != win->evictionCount ||
+        (dx < 0 ? -dx : dx) >= (int64_t)w || (dy < 0 ? -dy : dy) >= (int64_t)h;
+    BOOL moved = dx != 0 || dy != 0;
+
+    darling_paint_enter(win, DARLING_PAINT_SURFACE);
+    darling_timing_begin(win);
+    s->valid = TRUE;
+
+    // With layers the surface draws the content layer
+    uint8_t* content = darling_compositor_content(win);
+    uint32_t* target = (uint32_t*)(content ? content : (uint8_t*)win->dibBits);
+    DarlingDamageRect all = { 0, 0, (int32_t)w, (int32_t)h };
+
+    s->viewWidth = w;
+    s->viewHeight = h;
+    s->viewX = s->x;
+    s->viewY = s->y;
+    s->evictions = win->evictionCount;
+
+    if (full) {
+        s->dirty[0] = all;
+        s->dirtyCount = 1;
+        s->fullRedraws++;
+    } else if (moved) {
+        darling_surface_shift(target, w, h, (int32_t)dx, (int32_t)dy);
+        s->shiftedPixels += (uint64_t)(w - (uint32_t)(dx < 0 ? -dx : dx)) * (h - (uint32_t)(dy < 0 ? -dy : dy));
+
+        // Dirty rectangles were in the old viewport's coordinates
+        for (uint32_t i = 0; i < s->dirtyCount; i++) {
+            DarlingDamageRect r = s->dirty[i];
+            r.x0 -= (int32_t)dx;
+            r.x1 -= (int32_t)dx;
+            r.y0 -= (int32_t)dy;
+            r.y1 -= (int32_t)dy;
+            s->dirty[i] = r;
+        }
+
+        if (dx != 0) {
+            DarlingDamageRect strip = { dx > 0 ? (int32_t)(w - dx) : 0, 0, dx > 0 ? (int32_t)w : (int32_t)-dx, (int32_t)h };
+            darling_damage_insert(s->dirty, &s->dirtyCount, strip);
+        }
+        if (dy != 0) {
+            DarlingDamageRect strip = { 0, dy > 0 ? (int32_t)(h - dy) : 0, (int32_t)w, dy > 0 ? (int32_t)h : (int32_t)-dy };
+            darling_damage_insert(s->dirty, &s->dirtyCount, strip);
+        }
+    }
+
+    if (moved) {
+        darling_surface_drop_hidden(s);
+    }
+
+    for (uint32_t i = 0; i < s->dirtyCount; i++) {
+        DarlingDamageRect r;
+        if (darling_rect_intersect(&s->dirty[i], &all, &r)) {
+            if (!darling_surface_fill(s, target, w, &r)) {
+                s->valid = FALSE;
+            }
+            rects[count++] = r;
+        }
+    }
+    s->dirtyCount = 0;
+
+    // Everything moved: present the whole viewport
+    if (moved || full) {
+        rects[0] = all;
+        count = 1;
+    }
+
+    if (s->requestCount) {
+        *requests = (int32_t*)malloc((size_t)s->requestCount * 2u * sizeof(int32_t));
+        if (*requests) {
+            memcpy(*requests, s->requests, (size_t)s->requestCount * 2u * sizeof(int32_t));
+            requestCount = s->requestCount;
+        }
+        s->requestCount = 0;
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+    darling_unlock();
+
+    for (uint32_t i = 0; i < count; i++) {
+        const DarlingDamageRect* r = &rects[i];
+        if (content) {
+            darling_compositor_damage(win, r->x0, r->y0, r->x1, r->y1);
+        } else {
+            darling_thumbnail_damage(win, r->x0, r->y0, r->x1, r->y1);
+            darling_compositor_invalidate(win, r);
+        }
+    }
+
+    if (!content) {
+        darling_timing_draw_overlay(win);
+    }
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+    return requestCount;
+}
+
+// Draw and present the viewport, then ask the app for the missing tiles
+static void darling_surface_paint(DarlingWindow* win) {
+    DarlingPowerSample power;
+    if (!darling_power_begin(win, &power)) {
+        // Redrawn in full, and missing tiles requested, once the window can
+        // be seen again
+        darling_lock();
+        win->surface.valid = FALSE;
+        darling_unlock();
+        return;
+    }
+
+    int32_t* requests = NULL;
+    uint32_t requestCount = darling_surface_draw(win, &requests);
+    darling_power_end(win, &power);
+
+    if (requestCount && g_tile_request_callback) {
+        g_tile_request_callback((uintptr_t)win->hwnd, requests, requestCount);
+    }
+    free(requests);
+}
+
+// Redraw the viewport after a resize or a restore from eviction
+void darling_surface_refresh(DarlingWindow* win) {
+    if (win && win->surface.width) {
+        darling_surface_paint(win);
+    }
+}
+
+void darling_surface_free(DarlingWindow* win) {
+    DarlingSurface* s = &win->surface;
+
+    for (uint32_t i = 0; i < s->slots; i++) {
+        free(s->tiles[i].pixels);
+    }
+
+    free(s->tiles);
+    free(s->buckets);
+    free(s->requests);
+    free(s->parts);
+    memset(s, 0, sizeof(*s));
+}
+
+// Public API - Virtual Surfaces
+
+int darling_surface_create(
+    DarlingWindow* win,
+    uint32_t width,
+    uint32_t height,
+    uint32_t tile_size,
+    uint64_t budget_bytes,
+    uint32_t background
+) {
+    uint32_t ts = tile_size ? tile_size : DARLING_SURFACE_DEFAULT_TILE;
+    if (!win || !win->hwnd || width == 0 || height == 0 || ts < 16u || ts > 2048u || (ts & (ts - 1u)) != 0) {
+        return 0;
+    }
+
+    uint64_t budget = budget_bytes ? budget_bytes : DARLING_SURFACE_DEFAULT_BUDGET;
+    uint64_t tileBytes = (uint64_t)ts * ts * 4u;
+    uint64_t maxTiles = budget / tileBytes;
+    maxTiles = maxTiles < 1u ? 1u : maxTiles > (1u << 20) ? (1u << 20) : maxTiles;
+
+    // Requested tiles take slots without memory, up to a 4K viewport of
+    // 64-pixel tiles
+    uint32_t slots = (uint32_t)maxTiles + DARLING_SURFACE_REQUEST_SLOTS;
+    uint32_t buckets = 1;
+    while (buckets < slots) {
+        buckets <<= 1;
+    }
+
+    DarlingSurfaceTile* tiles = (DarlingSurfaceTile*)calloc(slots, sizeof(DarlingSurfaceTile));
+    int32_t* heads = (int32_t*)malloc((size_t)buckets * sizeof(int32_t));
+    if (!tiles || !heads) {
+        free(tiles);
+        free(heads);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < slots; i++) {
+        tiles[i].next = i + 1u < slots ? (int32_t)(i + 1u) : DARLING_SURFACE_NONE;
+    }
+    for (uint32_t i = 0; i < buckets; i++) {
+        heads[i] = DARLING_SURFACE_NONE;
+    }
+
+    darling_lock();
+    darling_surface_free(win);
+
+    DarlingSurface* s = &win->surface;
+    s->width = width;
+    s->height = height;
+    s->tileSize = ts;
+    s->background = background;
+    s->tiles = tiles;
+    s->slots = slots;
+    s->freeSlot = 0;
+    s->buckets = heads;
+    s->bucketMask = buckets - 1u;
+    s->maxTiles = (uint32_t)maxTiles;
+    s->budgetBytes = budget;
+    darling_unlock();
+
+    darling_surface_paint(win);
+    return 1;
+}
+
+void darling_surface_close(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    darling_surface_free(win);
+    darling_unlock();
+}
+
+int darling_surface_upload_tile(DarlingWindow* win, int32_t col, int32_t row, const uint8_t* bgra_data) {
+    if (!win || !bgra_data) {
+        return 0;
+    }
+
+    darling_lock();
+    DarlingSurface* s = &win->surface;
+    uint32_t ts = s->tileSize;
+    if (!s->width || col < 0 || row < 0 || (uint64_t)col * ts >= s->width || (uint64_t)row * ts >= s->height) {
+        darling_unlock();
+        return 0;
+    }
+    darling_unlock();
+
+    size_t bytes = (size_t)ts * ts * 4u;
+    uint32_t* pixels = (uint32_t*)malloc(bytes);
+    if (!pixels) {
+        return 0;
+    }
+    memcpy(pixels, bgra_data, bytes);
+
+    darling_lock();
+
+    // Closed or replaced meanwhile
+    if (s->tileSize != ts || !s->width) {
+        darling_unlock();
+        free(pixels);
+        return 0;
+    }
+
+    int32_t i = darling_surface_find(s, col, row);
+    if (i == DARLING_SURFACE_NONE) {
+        i = darling_surface_insert(s, col, row);
+        if (i == DARLING_SURFACE_NONE) {
+            darling_unlock();
+            free(pixels);
+            return 0;
+        }
+    }
+
+    DarlingSurfaceTile* t = &s->tiles[i];
+    if (t->pixels) {
+        free(t->pixels);
+    } else {
+        // Over budget: the least recently used tile goes
+        if (s->cached == s->maxTiles) {
+            int32_t victim = darling_surface_oldest(s, TRUE);
+            if (victim != DARLING_SURFACE_NONE) {
+                darling_surface_remove(s, victim);
+                s->tileEvictions++;
+            }
+        }
+        s->pending--;
+        s->cached++;
+    }
+    t->pixels = pixels;
+    t->lastUse = ++s->clock;
+    s->uploads++;
+
+    // Redraw its part of the viewport
+    BOOL visible = FALSE;
+    if (s->valid) {
+        int64_t x0 = (int64_t)col * ts - s->viewX;
+        int64_t y0 = (int64_t)row * ts - s->viewY;
+        if (x0 < (int64_t)s->viewWidth && y0 < (int64_t)s->viewHeight && x0 + ts > 0 && y0 + ts > 0) {
+            DarlingDamageRect r = {
+                (int32_t)(x0 > 0 ? x0 : 0), (int32_t)(y0 > 0 ? y0 : 0),
+                (int32_t)(x0 + ts < s->viewWidth ? x0 + ts : s->viewWidth),
+                (int32_t)(y0 + ts < s->viewHeight ? y0 + ts : s->viewHeight)
+            };
+            darling_damage_insert(s->dirty, &s->dirtyCount, r);
+            visible = TRUE;
+        }
+    }
+    BOOL repaint = visible || !s->valid;
+    darling_unlock();
+
+    if (repaint) {
+        darling_surface_paint(win);
+    }
+    return 1;
+}
+
+void darling_surface_scroll_to(DarlingWindow* win, uint32_t x, uint32_t y) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    DarlingSurface* s = &win->surface;
+    if (!s->width) {
+        darling_unlock();
+        return;
+    }
+    s->x = x;
+    s->y = y;
+    s->scrolls++;
+    darling_unlock();
+
+    darling_surface_paint(win);
+}
+
+void darling_surface_invalidate(DarlingWindow* win, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if (!win || width == 0 || height == 0) {
+        return;
+    }
+
+    darling_lock();
+    DarlingSurface* s = &win->surface;
+    if (!s->width) {
+        darling_unlock();
+        return;
+    }
+
+    // Cached copies go; visible pixels stay until the new tiles arrive
+    int64_t ts = s->tileSize;
+    int64_t c0 = (int64_t)x / ts;
+    int64_t r0 = (int64_t)y / ts;
+    int64_t c1 = ((int64_t)x + width + ts - 1) / ts;
+    int64_t r1 = ((int64_t)y + height + ts - 1) / ts;
+    int64_t vc0 = (int64_t)s->viewX / ts;
+    int64_t vr0 = (int64_t)s->viewY / ts;
+    int64_t vc1 = ((int64_t)s->viewX + s->viewWidth + ts - 1) / ts;
+    int64_t vr1 = ((int64_t)s->viewY + s->viewHeight + ts - 1) / ts;
+    int64_t cols = ((int64_t)s->width + ts - 1) / ts;
+    int64_t rows = ((int64_t)s->height + ts - 1) / ts;
+    vc1 = vc1 < cols ? vc1 : cols;
+    vr1 = vr1 < rows ? vr1 : rows;
+
+    for (uint32_t i = 0; i < s->slots; i++) {
+        const DarlingSurfaceTile* t = &s->tiles[i];
+        if (t->lastUse && t->col >= c0 && t->col < c1 && t->row >= r0 && t->row < r1) {
+            darling_surface_remove(s, (int32_t)i);
+        }
+    }
+
+    // Visible ones are asked for whether or not they were still cached
+    if (s->valid) {
+        for (int64_t row = r0 > vr0 ? r0 : vr0; row < (r1 < vr1 ? r1 : vr1); row++) {
+            for (int64_t col = c0 > vc0 ? c0 : vc0; col < (c1 < vc1 ? c1 : vc1); col++) {
+                if (darling_surface_insert(s, (int32_t)col, (int32_t)row) != DARLING_SURFACE_NONE) {
+                    darling_surface_request(s, (int32_t)col, (int32_t)row);
+                }
+            }
+        }
+    }
+
+    BOOL requested = s->requestCount > 0;
+    darling_unlock();
+
+    if (requested) {
+        darling_surface_paint(win);
+    }
+}
+
+void darling_get_surface_stats(DarlingWindow* win, DarlingSurfaceStats* out) {
+    if (!out) {
+        return;
+    }
+
+    DarlingSurfaceStats stats = {0};
+
+    if (win) {
+        darling_lock();
+        const DarlingSurface* s = &win->surface;
+        stats.width = s->width;
+        stats.height = s->height;
+        stats.tileSize = s->tileSize;
+        stats.x = s->viewX;
+        stats.y = s->viewY;
+        stats.cachedTiles = s->cached;
+        stats.pendingTiles = s->pending;
+        stats.tileBytes = (uint64_t)s->cached * s->tileSize * s->tileSize * 4u;
+        stats.budgetBytes = s->budgetBytes;
+        stats.hits = s->hits;
+        stats.misses = s->misses;
+        stats.requests = s->requested;
+        stats.uploads = s->uploads;
+        stats.evictions = s->tileEvictions;
+        stats.scrolls = s->scrolls;
+        stats.shiftedPixels = s->shiftedPixels;
+        stats.copiedPixels = s->copiedPixels;
+        stats.fullRedraws = s->fullRedraws;
+        darling_unlock();
+    }
+
+    *out = stats;
+}
+
+void darling_set_tile_request_callback(DarlingTileRequestCallback callback) {
+    g_tile_request_callback = callback;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <stdint.h>
+
+// Virtual Surface
+// A surface much larger than the window, held as fixed-size square tiles in
+// a cache bounded by a byte budget, least recently used tiles evicted
+// first. The window shows a viewport into it at the client size. Moving
+// the viewport shifts what the backing store already shows and copies in
+// only the strips that became exposed; tiles missing from the cache are
+// filled with the background and requested from the app.
+
+#define DARLING_SURFACE_NONE (-1)
+#define DARLING_SURFACE_DEFAULT_TILE 256u
+#define DARLING_SURFACE_DEFAULT_BUDGET (64u << 20)
+#define DARLING_SURFACE_REQUEST_SLOTS 4096u
+
+typedef struct DarlingSurfaceTile {
+    int32_t col;
+    int32_t row;
+    uint32_t* pixels;               // tileSize^2 BGRA; NULL while requested
+    uint64_t lastUse;
+    int32_t next;                   // next in the hash bucket
+} DarlingSurfaceTile;
+
+// A piece of a viewport rectangle covered by one tile
+typedef struct DarlingSurfacePart {
+    DarlingDamageRect rect;         // viewport pixels
+    const uint32_t* src;            // tile pixels at rect's corner; NULL for the background
+    uint32_t srcStride;
+} DarlingSurfacePart;
+
+typedef struct DarlingSurface {
+    uint32_t width;                 // 0 when the window has no surface
+    uint32_t height;
+    uint32_t tileSize;
+    uint32_t background;            // BGRA
+    uint32_t x;                     // viewport origin in surface pixels
+    uint32_t y;
+
+    DarlingSurfaceTile* tiles;
+    uint32_t slots;                 // requested and cached tiles together
+    int32_t freeSlot;               // chained through `next`
+    int32_t* buckets;               // power-of-two hash of (col, row)
+    uint32_t bucketMask;
+    uint32_t maxTiles;              // tiles with pixels the budget holds
+    uint32_t cached;
+    uint32_t pending;
+    uint64_t budgetBytes;
+    uint64_t clock;
+    uint64_t passStart;             // clock when the running fill began, 0 between fills
+
+    int32_t* requests;              // (col, row) pairs found missing while painting
+    uint32_t requestCount;
+    uint32_t requestCapacity;
+
+    DarlingDamageRect dirty[DARLING_DAMAGE_MAX];    // viewport rectangles to copy in
+    uint32_t dirtyCount;
+    DarlingSurfacePart* parts;
+    uint32_t partCapacity;
+
+    uint32_t viewWidth;             // viewport last drawn, 0 before the first
+    uint32_t viewHeight;
+    uint32_t viewX;
+    uint32_t viewY;
+    uint64_t evictions;             // the window's eviction count then
+    BOOL valid;                     // the target still shows that viewport
+
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t requested;
+    uint64_t uploads;
+    uint64_t tileEvictions;
+    uint64_t scrolls;
+    uint64_t shiftedPixels;
+    uint64_t copiedPixels;
+    uint64_t fullRedraws;
+} DarlingSurface;
@@ -0,0 +1,330 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. Everything that writes the backing store reports
+// the rectangle with darling_thumbnail_damage.
+#include <stdlib.h>
+#include <string.h>
+
+// Thumbnail Pyramid
+
+typedef struct DarlingThumbJob {
+    uint32_t* dst;                  // level being updated
+    uint32_t dstWidth;
+    const uint32_t* src;            // the level above it, or the backing store
+    uint32_t srcWidth;
+    uint32_t srcHeight;
+    uint32_t x0;                    // level columns [x0, x1) of rows from y0
+    uint32_t x1;
+    uint32_t y0;
+} DarlingThumbJob;
+
+static void darling_thumb_free_levels(DarlingThumbnailCache* t) {
+    for (uint32_t i = 0; i < t->levelCount; i++) {
+        free(t->levels[i].pixels);
+    }
+
+    memset(t->levels, 0, sizeof(t->levels));
+    t->levelCount = 0;
+    t->sourceWidth = 0;
+    t->sourceHeight = 0;
+    t->dirtyCount = 0;
+    t->bytes = 0;
+}
+
+// Halve (rounding up) until the next level would fall under the minimum
+// edge; a store too small for one level is served directly. Everything
+// starts dirty.
+static BOOL darling_thumb_alloc(DarlingThumbnailCache* t, uint32_t w, uint32_t h) {
+    darling_thumb_free_levels(t);
+
+    uint32_t lw = w;
+    uint32_t lh = h;
+    while (t->levelCount < DARLING_THUMB_MAX_LEVELS) {
+        lw = (lw + 1u) / 2u;
+        lh = (lh + 1u) / 2u;
+        if (lw < DARLING_THUMB_MIN_EDGE || lh < DARLING_THUMB_MIN_EDGE) {
+            break;
+        }
+
+        size_t size = (size_t)lw * lh * 4u;
+        uint32_t* pixels = (uint32_t*)malloc(size);
+        if (!pixels) {
+            darling_thumb_free_levels(t);
+            return FALSE;
+        }
+
+        DarlingThumbLevel* level = &t->levels[t->levelCount++];
+        level->pixels = pixels;
+        level->width = lw;
+        level->height = lh;
+        t->bytes += size;
+    }
+
+    t->sourceWidth = w;
+    t->sourceHeight = h;
+    t->dirty[0].x0 = 0;
+    t->dirty[0].y0 = 0;
+    t->dirty[0].x1 = (int32_t)w;
+    t->dirty[0].y1 = (int32_t)h;
+    t->dirtyCount = 1;
+    t->rebuilds++;
+    return TRUE;
+}
+
+static void darling_thumb_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingThumbJob* job = (const DarlingThumbJob*)ctx;
+
+    for (uint32_t i = begin; i < end; i++) {
+        uint32_t y = job->y0 + i;
+        uint32_t s0 = 2u * y;
+        uint32_t s1 = s0 + 1u < job->srcHeight ? s0 + 1u : s0;
+        const uint32_t* r0 = job->src + (size_t)s0 * job->srcWidth + 2u * job->x0;
+        const uint32_t* r1 = job->src + (size_t)s1 * job->srcWidth + 2u * job->x0;
+
+        darling_frame_box2x_row(job->dst + (size_t)y * job->dstWidth + job->x0, r0, r1,
+            job->x1 - job->x0, job->srcWidth - 2u * job->x0);
+    }
+}
+
+// Recompute the dirty rectangles down the pyramid. Each level's rectangle
+// is the one above halved, rounding outwards, so the 2x2 blocks straddling
+// its edges are redone too.
+static void darling_thumb_refresh(DarlingWindow* win) {
+    DarlingThumbnailCache* t = &win->thumbnails;
+
+    for (uint32_t d = 0; d < t->dirtyCount; d++) {
+        DarlingDamageRect r = t->dirty[d];
+        const uint32_t* src = (const uint32_t*)win->dibBits;
+        uint32_t sw = t->sourceWidth;
+        uint32_t sh = t->sourceHeight;
+
+        r.x0 = r.x0 < 0 ? 0 : r.x0;
+        r.y0 = r.y0 < 0 ? 0 : r.y0;
+        r.x1 = r.x1 > (int32_t)sw ? (int32_t)sw : r.x1;
+        r.y1 = r.y1 > (int32_t)sh ? (int32_t)sh : r.y1;
+
+        for (uint32_t i = 0; i < t->levelCount && r.x0 < r.x1 && r.y0 < r.y1; i++) {
+            DarlingThumbLevel* level = &t->levels[i];
+
+            r.x0 /= 2;
+            r.y0 /= 2;
+            r.x1 = (r.x1 + 1) / 2;
+            r.y1 = (r.y1 + 1) / 2;
+
+            DarlingThumbJob job = { level->pixels, level->width, src, sw, sh,
+                (uint32_t)r.x0, (uint32_t)r.x1, (uint32_t)r.y0 };
+            uint32_t rows = (uint32_t)(r.y1 - r.y0);
+
+            // Each output row reads two source rows of twice its width
+            darling_pool_for_rows(rows, (size_t)(r.x1 - r.x0) * 16u, darling_thumb_rows, &job);
+            t->updatedPixels += (uint64_t)rows * (uint64_t)(r.x1 - r.x0);
+
+            src = level->pixels;
+            sw = level->width;
+            sh = level->height;
+        }
+    }
+
+    t->dirtyCount = 0;
+}
+
+// Bilinear weights for output sample `d` of `dn` from `n` samples, centers
+// aligned, in 1/256ths
+static void darling_thumb_tap(uint32_t d, uint32_t dn, uint32_t n, uint32_t* i0, uint32_t* i1, uint32_t* f) {
+    int64_t pos = (((int64_t)d * 2 + 1) * n * 256) / ((int64_t)dn * 2) - 128;
+    if (pos < 0) {
+        pos = 0;
+    }
+
+    *i0 = (uint32_t)(pos >> 8);
+    *i1 = *i0 + 1u < n ? *i0 + 1u : *i0;
+    *f = (uint32_t)(pos & 255);
+}
+
+// Blend two BGRA pixels, (a * (256 - f) + b * f) / 256 per channel
+static inline uint32_t darling_thumb_lerp(uint32_t a, uint32_t b, uint32_t f) {
+    uint32_t g = 256u - f;
+    uint32_t rb = ((a & 0x00FF00FFu) * g + (b & 0x00FF00FFu) * f + 0x00800080u) >> 8;
+    uint32_t ag = (((a >> 8) & 0x00FF00FFu) * g + ((b >> 8) & 0x00FF00FFu) * f + 0x00800080u) >> 8;
+    return (rb & 0x00FF00FFu) | ((ag & 0x00FF00FFu) << 8);
+}
+
+static BOOL darling_thumb_scale(uint8_t* out, uint32_t ow, uint32_t oh, const uint32_t* src, uint32_t sw, uint32_t sh) {
+    uint32_t* dst = (uint32_t*)out;
+
+    if (ow == sw && oh == sh) {
+        memcpy(dst, src, (size_t)sw * sh * 4u);
+        return TRUE;
+    }
+
+    // Horizontal taps are the same for every row
+    uint32_t* taps = (uint32_t*)malloc((size_t)ow * 3u * sizeof(uint32_t));
+    if (!taps) {
+        return FALSE;
+    }
+    for (uint32_t x = 0; x < ow; x++) {
+        darling_thumb_tap(x, ow, sw, &taps[x * 3u], &taps[x * 3u + 1u], &taps[x * 3u + 2u]);
+    }
+
+    for (uint32_t y = 0; y < oh; y++) {
+        uint32_t y0, y1, fy;
+        darling_thumb_tap(y, oh, sh, &y0, &y1, &fy);
+        const uint32_t* r0 = src + (size_t)y0 * sw;
+        const uint32_t* r1 = src + (size_t)y1 * sw;
+        uint32_t* row = dst + (size_t)y * ow;
+
+        for (uint32_t x = 0; x < ow; x++) {
+            const uint32_t* tap = &taps[x * 3u];
+            uint32_t top = darling_thumb_lerp(r0[tap[0]], r0[tap[1]], tap[2]);
+            uint32_t bottom = darling_thumb_lerp(r1[tap[0]], r1[tap[1]], tap[2]);
+            row[x] = darling_thumb_lerp(top, bottom, fy);
+        }
+    }
+
+    free(taps);
+    return TRUE;
+}
+
+// Record a write to the backing store. Nothing is tracked until the first
+// thumbnail request builds the pyramid.
+void darling_thumbnail_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    if (x1 <= x0 || y1 <= y0) {
+        return;
+    }
+
+    darling_lock();
+
+    DarlingThumbnailCache* t = &win->thumbnails;
+    if (t->sourceWidth == 0) {
+        darling_unlock();
+        return;
+    }
+
+    if (t->dirtyCount < DARLING_THUMB_DIRTY_MAX) {
+        DarlingDamageRect* r = &t->dirty[t->dirtyCount++];
+        r->x0 = x0;
+        r->y0 = y0;
+        r->x1 = x1;
+        r->y1 = y1;
+    } else {
+        DarlingDamageRect* r = &t->dirty[0];
+        for (uint32_t i = 1; i < t->dirtyCount; i++) {
+            r->x0 = t->dirty[i].x0 < r->x0 ? t->dirty[i].x0 : r->x0;
+            r->y0 = t->dirty[i].y0 < r->y0 ? t->dirty[i].y0 : r->y0;
+            r->x1 = t->dirty[i].x1 > r->x1 ? t->dirty[i].x1 : r->x1;
+            r->y1 = t->dirty[i].y1 > r->y1 ? t->dirty[i].y1 : r->y1;
+        }
+        r->x0 = x0 < r->x0 ? x0 : r->x0;
+        r->y0 = y0 < r->y0 ? y0 : r->y0;
+        r->x1 = x1 > r->x1 ? x1 : r->x1;
+        r->y1 = y1 > r->y1 ? y1 : r->y1;
+        t->dirtyCount = 1;
+    }
+
+    darling_unlock();
+}
+
+// Bring the pyramid up to date before the backing store goes away, so an
+// evicted window previews its last contents
+void darling_thumbnail_sync(DarlingWindow* win) {
+    darling_lock();
+
+    DarlingThumbnailCache* t = &win->thumbnails;
+    if (t->sourceWidth != 0 && t->dirtyCount > 0 && win->dibBits &&
+        t->sourceWidth == win->bitmapWidth && t->sourceHeight == win->bitmapHeight) {
+        darling_thumb_refresh(win);
+    }
+
+    darling_unlock();
+}
+
+void darling_thumbnail_free(DarlingWindow* win) {
+    darling_lock();
+    darling_thumb_free_levels(&win->thumbnails);
+    darling_unlock();
+}
+
+// Public API - Thumbnails
+
+int darling_get_thumbnail(DarlingWindow* win, uint8_t* out, uint32_t width, uint32_t height) {
+    if (!win || !out || !darling_frame_size_ok(width, height)) {
+        return 0;
+    }
+
+    darling_lock();
+
+    DarlingThumbnailCache* t = &win->thumbnails;
+    const uint32_t* store = (const uint32_t*)win->dibBits;
+
+    if (store) {
+        if (t->sourceWidth != win->bitmapWidth || t->sourceHeight != win->bitmapHeight) {
+            if (!darling_thumb_alloc(t, win->bitmapWidth, win->bitmapHeight)) {
+                darling_unlock();
+                return 0;
+            }
+        }
+        darling_thumb_refresh(win);
+    } else if (t->levelCount == 0 || t->dirtyCount > 0) {
+        // Evicted (or never painted) with nothing current to show
+        darling_unlock();
+        return 0;
+    }
+
+    // Smallest level still at least the requested size; the store itself
+    // when even level 0 is too small
+    const uint32_t* src = store;
+    uint32_t sw = t->sourceWidth;
+    uint32_t sh = t->sourceHeight;
+    for (uint32_t i = t->levelCount; i > 0; i--) {
+        const DarlingThumbLevel* level = &t->levels[i - 1u];
+        if (level->width >= width && level->height >= height) {
+            src = level->pixels;
+            sw = level->width;
+            sh = level->height;
+            break;
+        }
+    }
+
+    if (!src) {
+        src = t->levels[0].pixels;
+        sw = t->levels[0].width;
+        sh = t->levels[0].height;
+    }
+
+    int ok = darling_thumb_scale(out, width, height, src, sw, sh) ? 1 : 0;
+    t->requests += (uint64_t)ok;
+
+    darling_unlock();
+    return ok;
+}
+
+void darling_release_thumbnails(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_thumbnail_free(win);
+}
+
+void darling_get_thumbnail_stats(DarlingWindow* win, DarlingThumbnailStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+
+    const DarlingThumbnailCache* t = &win->thumbnails;
+    out->levels = t->levelCount;
+    out->width = t->levelCount ? t->levels[0].width : 0;
+    out->height = t->levelCount ? t->levels[0].height : 0;
+    out->bytes = (uint64_t)t->bytes;
+    out->requests = t->requests;
+    out->updatedPixels = t->updatedPixels;
+    out->rebuilds = t->rebuilds;
+
+    darling_unlock();
+}
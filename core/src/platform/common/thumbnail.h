@@ -0,0 +1,37 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Thumbnail Pyramid
+// Successive 2x box downscales of the backing store, built on the first
+// thumbnail request. Every write to the backing store records its rectangle;
+// the next request recomputes only those rectangles, level by level, then
+// scales the smallest level that still covers the requested size.
+//
+// The pyramid outlives an evicted backing store, so hidden windows keep
+// serving previews of their last contents.
+
+#define DARLING_THUMB_MAX_LEVELS 16u
+#define DARLING_THUMB_MIN_EDGE 8u           // no level narrower or shorter than this
+#define DARLING_THUMB_DIRTY_MAX 8u          // more rectangles merge into their bounds
+
+typedef struct DarlingThumbLevel {
+    uint32_t* pixels;
+    uint32_t width;
+    uint32_t height;
+} DarlingThumbLevel;
+
+typedef struct DarlingThumbnailCache {
+    DarlingThumbLevel levels[DARLING_THUMB_MAX_LEVELS];    // levels[0] is half the backing store
+    uint32_t levelCount;                // 0 until the first request
+    uint32_t sourceWidth;               // backing-store size the levels were built from
+    uint32_t sourceHeight;
+
+    DarlingDamageRect dirty[DARLING_THUMB_DIRTY_MAX];      // backing-store pixels
+    uint32_t dirtyCount;
+
+    size_t bytes;
+    uint64_t requests;
+    uint64_t updatedPixels;             // level pixels recomputed
+    uint64_t rebuilds;                  // whole pyramids (re)allocated
+} DarlingThumbnailCache;
@@ -0,0 +1,372 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend calls the darling_timing_* hooks from
+// its paint path and provides darling_input_now as the clock.
+#include <stdio.h>
+#include <string.h>
+
+// Latency Histograms
+
+static uint32_t darling_timing_bucket(double ms) {
+    double us = ms * 1000.0;
+    if (!(us >= 1.0)) {
+        return 0;
+    }
+
+    uint64_t v = us >= 1.0e12 ? (uint64_t)1e12 : (uint64_t)us;
+    if (v < 4u) {
+        return (uint32_t)v;
+    }
+
+    uint32_t msb = 2;
+    while ((v >> (msb + 1u)) != 0) {
+        msb++;
+    }
+
+    uint32_t bucket = (msb - 1u) * 4u + (uint32_t)((v >> (msb - 2u)) & 3u);
+    return bucket < DARLING_TIMING_BUCKETS ? bucket : DARLING_TIMING_BUCKETS - 1u;
+}
+
+// Lower bound of a bucket in microseconds
+static double darling_timing_bucket_floor(uint32_t bucket) {
+    if (bucket < 4u) {
+        return (double)bucket;
+    }
+
+    uint32_t msb = bucket / 4u + 1u;
+    return (double)((uint64_t)(4u + bucket % 4u) << (msb - 2u));
+}
+
+static void darling_histogram_add(DarlingLatencyHistogram* h, double ms) {
+    if (ms < 0.0) {
+        ms = 0.0;
+    }
+
+    h->buckets[darling_timing_bucket(ms)]++;
+    h->count++;
+    h->sum += ms;
+    if (ms > h->max) {
+        h->max = ms;
+    }
+}
+
+static double darling_histogram_percentile(const DarlingLatencyHistogram* h, double q) {
+    if (h->count == 0) {
+        return 0.0;
+    }
+
+    uint64_t target = (uint64_t)(q * (double)h->count);
+    if (target < 1u) {
+        target = 1u;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < DARLING_TIMING_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= target) {
+            double upper = darling_timing_bucket_floor(b + 1u) / 1000.0;
+            return upper < h->max ? upper : h->max;
+        }
+    }
+
+    return h->max;
+}
+
+static void darling_histogram_summarize(const DarlingLatencyHistogram* h, DarlingLatencySummary* out) {
+    out->count = h->count;
+    out->mean = h->count ? h->sum / (double)h->count : 0.0;
+    out->p50 = darling_histogram_percentile(h, 0.50);
+    out->p90 = darling_histogram_percentile(h, 0.90);
+    out->p99 = darling_histogram_percentile(h, 0.99);
+    out->max = h->max;
+}
+
+// Frame Records
+
+static void darling_timing_push_record(DarlingFrameTiming* t, const DarlingFrameRecord* r) {
+    t->records[t->recordHead] = *r;
+    t->recordHead = (t->recordHead + 1u) & (DARLING_TIMING_RECORDS - 1u);
+    if (t->recordCount < DARLING_TIMING_RECORDS) {
+        t->recordCount++;
+    }
+}
+
+// Presents per second over the recent window, from the record ring
+static double darling_timing_fps(const DarlingFrameTiming* t, double now) {
+    double newest = 0.0;
+    double oldest = 0.0;
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < t->recordCount; i++) {
+        uint32_t slot = (t->recordHead - 1u - i) & (DARLING_TIMING_RECORDS - 1u);
+        double presented = t->records[slot].stamps[DARLING_STAGE_PRESENTED];
+
+        if (presented == 0.0) {
+            continue;
+        }
+        if (now - presented > DARLING_TIMING_FPS_WINDOW_MS) {
+            break;
+        }
+
+        if (n == 0) {
+            newest = presented;
+        }
+        oldest = presented;
+        n++;
+    }
+
+    if (n < 2u || newest <= oldest) {
+        return 0.0;
+    }
+
+    return (double)(n - 1u) * 1000.0 / (newest - oldest);
+}
+
+// Pipeline Hooks
+
+// Paint call entered: start timing a new frame, replacing one still in flight
+void darling_timing_begin(DarlingWindow* win) {
+    DarlingFrameTiming* t = &win->timing;
+    double now = darling_input_now();
+
+    darling_lock();
+
+    if (t->inFlight) {
+        darling_timing_push_record(t, &t->pending);
+        t->superseded++;
+    }
+
+    memset(&t->pending, 0, sizeof(t->pending));
+    if (t->nextTag) {
+        t->pending.frameId = t->nextTag;
+        t->pending.stamps[DARLING_STAGE_SUBMIT] = t->nextSubmit > 0.0 ? t->nextSubmit : now;
+        t->nextTag = 0;
+    } else {
+        t->pending.frameId = ++t->autoId;
+        t->pending.stamps[DARLING_STAGE_SUBMIT] = now;
+    }
+    t->pending.stamps[DARLING_STAGE_ENTRY] = now;
+    t->inFlight = TRUE;
+
+    darling_unlock();
+}
+
+// Paint call gave up before invalidating: drop the frame it started
+void darling_timing_cancel(DarlingWindow* win) {
+    darling_lock();
+    win->timing.inFlight = FALSE;
+    darling_unlock();
+}
+
+void darling_timing_stamp(DarlingWindow* win, DarlingFrameStage stage) {
+    DarlingFrameTiming* t = &win->timing;
+
+    if (t->inFlight) {
+        t->pending.stamps[stage] = darling_input_now();
+    }
+}
+
+// WM_PAINT began; repaints with no new frame since the last present are ignored
+void darling_timing_paint_start(DarlingWindow* win) {
+    DarlingFrameTiming* t = &win->timing;
+
+    if (t->inFlight && t->pending.stamps[DARLING_STAGE_INVALIDATED] != 0.0 &&
+        t->pending.stamps[DARLING_STAGE_PAINT_START] == 0.0) {
+        t->pending.stamps[DARLING_STAGE_PAINT_START] = darling_input_now();
+    }
+}
+
+// Blit complete: the in-flight frame is on screen
+void darling_timing_presented(DarlingWindow* win) {
+    DarlingFrameTiming* t = &win->timing;
+
+    if (!t->inFlight || t->pending.stamps[DARLING_STAGE_PAINT_START] == 0.0) {
+        return;
+    }
+
+    double now = darling_input_now();
+    const double* s = t->pending.stamps;
+
+    darling_lock();
+
+    t->pending.stamps[DARLING_STAGE_PRESENTED] = now;
+    darling_histogram_add(&t->spans[DARLING_LATENCY_PRODUCER], s[DARLING_STAGE_ENTRY] - s[DARLING_STAGE_SUBMIT]);
+    darling_histogram_add(&t->spans[DARLING_LATENCY_COPY], s[DARLING_STAGE_COPIED] - s[DARLING_STAGE_ENTRY]);
+    darling_histogram_add(&t->spans[DARLING_LATENCY_INVALIDATE], s[DARLING_STAGE_INVALIDATED] - s[DARLING_STAGE_COPIED]);
+    darling_histogram_add(&t->spans[DARLING_LATENCY_QUEUE], s[DARLING_STAGE_PAINT_START] - s[DARLING_STAGE_INVALIDATED]);
+    darling_histogram_add(&t->spans[DARLING_LATENCY_BLIT], now - s[DARLING_STAGE_PAINT_START]);
+    darling_histogram_add(&t->spans[DARLING_LATENCY_TOTAL], now - s[DARLING_STAGE_SUBMIT]);
+
+    darling_timing_push_record(t, &t->pending);
+    t->presented++;
+    t->inFlight = FALSE;
+
+    darling_unlock();
+}
+
+// Overlay
+// 3x5 glyphs drawn at 2x; each row is three bits, most significant leftmost.
+
+static const char k_overlay_chars[] = "0123456789.FPSM-";
+static const uint8_t k_overlay_glyphs[][5] = {
+    { 7, 5, 5, 5, 7 }, { 2, 6, 2, 2, 7 }, { 7, 1, 7, 4, 7 }, { 7, 1, 7, 1, 7 },
+    { 5, 5, 7, 1, 1 }, { 7, 4, 7, 1, 7 }, { 7, 4, 7, 5, 7 }, { 7, 1, 1, 1, 1 },
+    { 7, 5, 7, 5, 7 }, { 7, 5, 7, 1, 7 }, { 0, 0, 0, 0, 2 }, { 7, 4, 6, 4, 4 },
+    { 7, 5, 7, 4, 4 }, { 7, 4, 7, 1, 7 }, { 5, 7, 7, 5, 5 }, { 0, 0, 7, 0, 0 },
+};
+
+#define DARLING_OVERLAY_BACKGROUND 0xFF202020u
+#define DARLING_OVERLAY_INK 0xFF40FF40u
+#define DARLING_OVERLAY_SCALE 2u
+#define DARLING_OVERLAY_ADVANCE 8u
+#define DARLING_OVERLAY_PADDING 3u
+
+static void darling_overlay_text(uint32_t* px, uint32_t stride, uint32_t w, uint32_t h, uint32_t x, uint32_t y, const char* text) {
+    for (; *text; text++, x += DARLING_OVERLAY_ADVANCE) {
+        const char* found = strchr(k_overlay_chars, *text);
+        if (!found) {
+            continue;
+        }
+
+        const uint8_t* glyph = k_overlay_glyphs[found - k_overlay_chars];
+        for (uint32_t row = 0; row < 5u * DARLING_OVERLAY_SCALE; row++) {
+            uint32_t py = y + row;
+            if (py >= h) {
+                break;
+            }
+
+            uint8_t bits = glyph[row / DARLING_OVERLAY_SCALE];
+            for (uint32_t col = 0; col < 3u * DARLING_OVERLAY_SCALE; col++) {
+                uint32_t pxx = x + col;
+                if (pxx < w && (bits & (4u >> (col / DARLING_OVERLAY_SCALE)))) {
+                    px[(size_t)py * stride + pxx] = DARLING_OVERLAY_INK;
+                }
+            }
+        }
+    }
+}
+
+// Draw FPS and p99 total latency into the backing store. Returns TRUE if
+// the overlay was drawn; it covers DARLING_OVERLAY_WIDTH x _HEIGHT at 0,0.
+BOOL darling_timing_draw_overlay(DarlingWindow* win) {
+    if (!win->timing.overlay || !win->dibBits || win->bitmapWidth == 0 || win->bitmapHeight == 0) {
+        return FALSE;
+    }
+
+    char fpsText[24];
+    char p99Text[24];
+
+    darling_lock();
+    double fps = darling_timing_fps(&win->timing, darling_input_now());
+    double p99 = darling_histogram_percentile(&win->timing.spans[DARLING_LATENCY_TOTAL], 0.99);
+    uint64_t count = win->timing.spans[DARLING_LATENCY_TOTAL].count;
+    darling_unlock();
+
+    snprintf(fpsText, sizeof(fpsText), fps < 100.0 ? "%.1f FPS" : "%.0f FPS", fps);
+    if (count) {
+        snprintf(p99Text, sizeof(p99Text), "P99 %.1fMS", p99);
+    } else {
+        snprintf(p99Text, sizeof(p99Text), "P99 -MS");
+    }
+
+    uint32_t* px = (uint32_t*)win->dibBits;
+    uint32_t stride = win->bitmapWidth;
+    uint32_t w = win->bitmapWidth < DARLING_OVERLAY_WIDTH ? win->bitmapWidth : DARLING_OVERLAY_WIDTH;
+    uint32_t h = win->bitmapHeight < DARLING_OVERLAY_HEIGHT ? win->bitmapHeight : DARLING_OVERLAY_HEIGHT;
+
+    for (uint32_t y = 0; y < h; y++) {
+        uint32_t* row = px + (size_t)y * stride;
+        for (uint32_t x = 0; x < w; x++) {
+            row[x] = DARLING_OVERLAY_BACKGROUND;
+        }
+    }
+
+    darling_overlay_text(px, stride, w, h, DARLING_OVERLAY_PADDING, DARLING_OVERLAY_PADDING, fpsText);
+    darling_overlay_text(px, stride, w, h, DARLING_OVERLAY_PADDING,
+        DARLING_OVERLAY_PADDING + 5u * DARLING_OVERLAY_SCALE + 2u, p99Text);
+    darling_thumbnail_damage(win, 0, 0, (int32_t)w, (int32_t)h);
+    return TRUE;
+}
+
+// Public API - Frame Timing
+
+void darling_frame_tag(DarlingWindow* win, uint64_t frame_id, double submit_ms) {
+    if (!win || frame_id == 0) {
+        return;
+    }
+
+    darling_lock();
+    win->timing.nextTag = frame_id;
+    win->timing.nextSubmit = submit_ms;
+    darling_unlock();
+}
+
+int darling_get_frame_record(DarlingWindow* win, uint64_t frame_id, DarlingFrameRecord* out) {
+    if (!win || !out || frame_id == 0) {
+        return 0;
+    }
+
+    int found = 0;
+    const DarlingFrameTiming* t = &win->timing;
+
+    darling_lock();
+    for (uint32_t i = 0; i < t->recordCount; i++) {
+        uint32_t slot = (t->recordHead - 1u - i) & (DARLING_TIMING_RECORDS - 1u);
+        if (t->records[slot].frameId == frame_id) {
+            *out = t->records[slot];
+            found = 1;
+            break;
+        }
+    }
+    darling_unlock();
+
+    return found;
+}
+
+void darling_get_frame_timing(DarlingWindow* win, DarlingFrameTimingStats* out) {
+    if (!out) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (!win) {
+        return;
+    }
+
+    const DarlingFrameTiming* t = &win->timing;
+
+    darling_lock();
+    out->presented = t->presented;
+    out->superseded = t->superseded;
+    out->fps = darling_timing_fps(t, darling_input_now());
+    for (uint32_t i = 0; i < DARLING_LATENCY_SPAN_COUNT; i++) {
+        darling_histogram_summarize(&t->spans[i], &out->spans[i]);
+    }
+    darling_unlock();
+}
+
+void darling_reset_frame_timing(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    DarlingFrameTiming* t = &win->timing;
+
+    darling_lock();
+    memset(t->records, 0, sizeof(t->records));
+    memset(t->spans, 0, sizeof(t->spans));
+    t->recordHead = 0;
+    t->recordCount = 0;
+    t->presented = 0;
+    t->superseded = 0;
+    darling_unlock();
+}
+
+void darling_set_frame_overlay(DarlingWindow* win, int enable) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    win->timing.overlay = enable ? TRUE : FALSE;
+    darling_unlock();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+
+// Frame Timing
+// Each window tracks the frame currently in flight through the paint
+// pipeline and, once it reaches the screen, adds its stage-to-stage spans
+// to per-window latency histograms. Recent frames are kept by ID so a
+// producer can read back when its frame was presented.
+//
+// Histogram buckets are log-linear in microseconds: exact below 4us, then
+// four buckets per power of two (about 19% wide), up to ~16s.
+
+#define DARLING_TIMING_BUCKETS 96u
+#define DARLING_TIMING_RECORDS 64u      // power of two
+#define DARLING_TIMING_FPS_WINDOW_MS 1000.0
+
+typedef struct DarlingLatencyHistogram {
+    uint32_t buckets[DARLING_TIMING_BUCKETS];
+    uint64_t count;
+    double sum;                 // ms
+    double max;                 // ms
+} DarlingLatencyHistogram;
+
+typedef struct DarlingFrameTiming {
+    DarlingFrameRecord pending;     // frame in flight (frameId 0 = none)
+    BOOL inFlight;
+
+    uint64_t nextTag;               // explicit ID for the next frame (0 = auto)
+    double nextSubmit;
+    uint64_t autoId;
+
+    DarlingFrameRecord records[DARLING_TIMING_RECORDS];
+    uint32_t recordHead;            // next slot to write
+    uint32_t recordCount;
+
+    DarlingLatencyHistogram spans[DARLING_LATENCY_SPAN_COUNT];
+    uint64_t presented;
+    uint64_t superseded;
+
+    BOOL overlay;
+} DarlingFrameTiming;
+
+// Overlay box drawn into the top-left corner of the backing store
+#define DARLING_OVERLAY_WIDTH 96u
+#define DARLING_OVERLAY_HEIGHT 28u
@@ -0,0 +1,148 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. The backend provides the darling_ui_signal_*
+// functions; its wait dispatches the UI thread's window messages.
+#include <stdlib.h>
+#include <string.h>
+
+// UI Thread
+
+static DarlingUiThread g_ui;
+
+static void darling_ui_thread_main(void* arg) {
+    DarlingUiThread* ui = (DarlingUiThread*)arg;
+
+    for (;;) {
+        darling_lock();
+        if (ui->count == 0) {
+            BOOL stopping = ui->stopping;
+            darling_unlock();
+
+            // Tasks queued before shutdown still run
+            if (stopping) {
+                return;
+            }
+            darling_ui_signal_wait(&ui->signal);
+            continue;
+        }
+
+        DarlingUiItem item = ui->items[ui->head];
+        ui->head = (ui->head + 1u) & (ui->capacity - 1u);
+        ui->count--;
+        darling_unlock();
+
+        item.fn(item.ctx);
+
+        darling_lock();
+        ui->run++;
+        darling_unlock();
+    }
+}
+
+// Make room for one more task. Called with the lock held.
+static BOOL darling_ui_reserve(DarlingUiThread* ui) {
+    if (ui->count < ui->capacity) {
+        return TRUE;
+    }
+
+    uint32_t capacity = ui->capacity ? ui->capacity * 2u : DARLING_UI_QUEUE_MIN;
+    DarlingUiItem* items = (DarlingUiItem*)malloc((size_t)capacity * sizeof(DarlingUiItem));
+    if (!items) {
+        return FALSE;
+    }
+
+    // Unwrap the ring so the queued tasks start at index 0
+    for (uint32_t i = 0; i < ui->count; i++) {
+        items[i] = ui->items[(ui->head + i) & (ui->capacity - 1u)];
+    }
+
+    free(ui->items);
+    ui->items = items;
+    ui->capacity = capacity;
+    ui->head = 0;
+    return TRUE;
+}
+
+// Start the thread if needed. Called with the lock held.
+static BOOL darling_ui_start(DarlingUiThread* ui) {
+    if (ui->started) {
+        return TRUE;
+    }
+
+    if (!darling_ui_signal_init(&ui->signal)) {
+        return FALSE;
+    }
+
+    if (!darling_thread_start(&ui->thread, darling_ui_thread_main, ui)) {
+        darling_ui_signal_destroy(&ui->signal);
+        return FALSE;
+    }
+
+    ui->started = TRUE;
+    return TRUE;
+}
+
+// Run what is queued, then join the thread. Windows it still owns go with
+// it on Win32.
+void darling_ui_thread_shutdown(void) {
+    DarlingUiThread* ui = &g_ui;
+
+    darling_lock();
+    if (!ui->started) {
+        darling_unlock();
+        return;
+    }
+    ui->stopping = TRUE;
+    darling_unlock();
+
+    darling_ui_signal_raise(&ui->signal);
+    darling_thread_join(ui->thread);
+    darling_ui_signal_destroy(&ui->signal);
+
+    darling_lock();
+    free(ui->items);
+    memset(ui, 0, sizeof(*ui));
+    darling_unlock();
+}
+
+// Public API - UI Thread
+
+int darling_ui_post(DarlingUiTask task, void* ctx) {
+    DarlingUiThread* ui = &g_ui;
+
+    if (!task) {
+        return 0;
+    }
+
+    darling_lock();
+    if (ui->stopping || !darling_ui_start(ui) || !darling_ui_reserve(ui)) {
+        darling_unlock();
+        return 0;
+    }
+
+    ui->items[(ui->head + ui->count) & (ui->capacity - 1u)] = (DarlingUiItem){ task, ctx };
+    ui->count++;
+    ui->posted++;
+    if (ui->count > ui->peak) {
+        ui->peak = ui->count;
+    }
+    darling_unlock();
+
+    darling_ui_signal_raise(&ui->signal);
+    return 1;
+}
+
+void darling_get_ui_thread_stats(DarlingUiThreadStats* out) {
+    DarlingUiThread* ui = &g_ui;
+
+    if (!out) {
+        return;
+    }
+
+    darling_lock();
+    out->running = ui->started ? 1u : 0u;
+    out->pending = ui->count;
+    out->peak = ui->peak;
+    out->posted = ui->posted;
+    out->run = ui->run;
+    darling_unlock();
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+
+// UI Thread
+// A library-owned thread that runs tasks posted from any thread, in the
+// order posted, and owns the windows those tasks create. With no task
+// queued it waits on its signal, which on Win32 also dispatches the
+// messages of its windows. The queue is a ring doubled when full, guarded by
+// the library lock.
+
+#define DARLING_UI_QUEUE_MIN 64u
+
+typedef struct DarlingUiItem {
+    DarlingUiTask fn;
+    void* ctx;
+} DarlingUiItem;
+
+typedef struct DarlingUiThread {
+    DarlingThread thread;
+    DarlingUiSignal signal;
+    BOOL started;
+    BOOL stopping;
+
+    DarlingUiItem* items;
+    uint32_t capacity;              // power of two
+    uint32_t head;
+    uint32_t count;
+    uint32_t peak;
+
+    uint64_t posted;
+    uint64_t run;
+} DarlingUiThread;
@@ -0,0 +1,337 @@
+// Shared by all platform backends. Included by the backend's unity file
+// after its internal.h. Each backend's paint.c converts into its own
+// backing store with darling_yuv_convert.
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DARLING_YUV_SSE2 1
+#endif
+
+// YUV Conversion
+
+void darling_yuv_coeffs(uint32_t matrix, uint32_t range, DarlingYuvCoeffs* out) {
+    double kr = matrix == DARLING_YUV_BT709 ? 0.2126 : 0.299;
+    double kb = matrix == DARLING_YUV_BT709 ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+
+    // Limited range stretches Y 16-235 and C 16-240 to 0-255
+    BOOL full = range == DARLING_YUV_FULL;
+    double yScale = full ? 1.0 : 255.0 / 219.0;
+    double cScale = full ? 1.0 : 255.0 / 224.0;
+    double black = full ? 0.0 : 16.0;
+
+    out->yGain = (uint16_t)(yScale * 32.0 * 255.0 + 0.5);
+    out->yBias = (int16_t)((int32_t)(black * yScale * 32.0 + 0.5) - 16);
+    out->rv = (int16_t)(2.0 * (1.0 - kr) * cScale * 8192.0 + 0.5);
+    out->gu = (int16_t)(2.0 * (1.0 - kb) * kb / kg * cScale * 8192.0 + 0.5);
+    out->gv = (int16_t)(2.0 * (1.0 - kr) * kr / kg * cScale * 8192.0 + 0.5);
+    out->bu = (int16_t)(2.0 * (1.0 - kb) * cScale * 8192.0 + 0.5);
+}
+
+static inline uint32_t darling_yuv_clamp(int32_t x) {
+    return x < 0 ? 0u : x > 255 ? 255u : (uint32_t)x;
+}
+
+static inline uint32_t darling_yuv_pixel(uint32_t y, uint32_t u, uint32_t v, const DarlingYuvCoeffs* k) {
+    int32_t yy = (int32_t)((y * 257u * k->yGain) >> 16) - k->yBias;
+    int32_t uu = ((int32_t)u - 128) * 256;
+    int32_t vv = ((int32_t)v - 128) * 256;
+
+    uint32_t b = darling_yuv_clamp((yy + ((uu * k->bu) >> 16)) >> 5);
+    uint32_t g = darling_yuv_clamp((yy - ((uu * k->gu) >> 16) - ((vv * k->gv) >> 16)) >> 5);
+    uint32_t r = darling_yuv_clamp((yy + ((vv * k->rv) >> 16)) >> 5);
+    return 0xFF000000u | (r << 16) | (g << 8) | b;
+}
+
+#ifdef DARLING_YUV_SSE2
+typedef struct DarlingYuvSse2 {
+    __m128i yGain;
+    __m128i yBias;
+    __m128i rv;
+    __m128i gu;
+    __m128i gv;
+    __m128i bu;
+    __m128i half;                   // 128 << 8
+    __m128i alpha;
+} DarlingYuvSse2;
+
+static inline void darling_yuv_load_sse2(const DarlingYuvCoeffs* k, DarlingYuvSse2* out) {
+    out->yGain = _mm_set1_epi16((short)k->yGain);
+    out->yBias = _mm_set1_epi16(k->yBias);
+    out->rv = _mm_set1_epi16(k->rv);
+    out->gu = _mm_set1_epi16(k->gu);
+    out->gv = _mm_set1_epi16(k->gv);
+    out->bu = _mm_set1_epi16(k->bu);
+    out->half = _mm_set1_epi16((short)0x8000);
+    out->alpha = _mm_set1_epi8((char)0xFF);
+}
+
+// Eight pixels from Y * 257 and (C - 128) << 8 in 16-bit lanes. No step
+// can overflow: every intermediate stays within +/-19000.
+static inline void darling_yuv_px8_sse2(uint8_t* dst, __m128i y, __m128i u, __m128i v, const DarlingYuvSse2* k) {
+    __m128i yy = _mm_sub_epi16(_mm_mulhi_epu16(y, k->yGain), k->yBias);
+    __m128i b = _mm_srai_epi16(_mm_add_epi16(yy, _mm_mulhi_epi16(u, k->bu)), 5);
+    __m128i g = _mm_srai_epi16(
+        _mm_sub_epi16(_mm_sub_epi16(yy, _mm_mulhi_epi16(u, k->gu)), _mm_mulhi_epi16(v, k->gv)), 5);
+    __m128i r = _mm_srai_epi16(_mm_add_epi16(yy, _mm_mulhi_epi16(v, k->rv)), 5);
+
+    __m128i bg = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), _mm_packus_epi16(g, g));
+    __m128i ra = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), k->alpha);
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(bg, ra));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(bg, ra));
+}
+#endif
+
+// One row of a 4:2:0 frame at its own size: each chroma sample covers a
+// pixel pair. `chroma_step` is 1 for planar U and V, 2 for interleaved UV.
+static void darling_yuv_row_420(
+    uint8_t* dst,
+    const uint8_t* y,
+    const uint8_t* u,
+    const uint8_t* v,
+    uint32_t chroma_step,
+    uint32_t width,
+    const DarlingYuvCoeffs* k
+) {
+    uint32_t* out = (uint32_t*)dst;
+    uint32_t x = 0;
+
+#ifdef DARLING_YUV_SSE2
+    DarlingYuvSse2 c;
+    darling_yuv_load_sse2(k, &c);
+    __m128i zero = _mm_setzero_si128();
+    __m128i highBytes = _mm_set1_epi16((short)0xFF00);
+
+    for (; x + 16u <= width; x += 16u) {
+        __m128i yv = _mm_loadu_si128((const __m128i*)(y + x));
+        __m128i cu;
+        __m128i cv;
+
+        if (chroma_step == 2u) {
+            // U is the low byte of each pair, V the high one
+            __m128i uv = _mm_loadu_si128((const __m128i*)(u + x));
+            cu = _mm_slli_epi16(uv, 8);
+            cv = _mm_and_si128(uv, highBytes);
+        } else {
+            cu = _mm_unpacklo_epi8(zero, _mm_loadl_epi64((const __m128i*)(u + x / 2u)));
+            cv = _mm_unpacklo_epi8(zero, _mm_loadl_epi64((const __m128i*)(v + x / 2u)));
+        }
+        cu = _mm_sub_epi16(cu, c.half);
+        cv = _mm_sub_epi16(cv, c.half);
+
+        darling_yuv_px8_sse2(dst + (size_t)x * 4u, _mm_unpacklo_epi8(yv, yv),
+            _mm_unpacklo_epi16(cu, cu), _mm_unpacklo_epi16(cv, cv), &c);
+        darling_yuv_px8_sse2(dst + (size_t)x * 4u + 32u, _mm_unpackhi_epi8(yv, yv),
+            _mm_unpackhi_epi16(cu, cu), _mm_unpackhi_epi16(cv, cv), &c);
+    }
+#endif
+
+    for (; x < width; x++) {
+        size_t ci = (size_t)(x >> 1) * chroma_step;
+        out[x] = darling_yuv_pixel(y[x], u[ci], v[ci], k);
+    }
+}
+
+// One row with a chroma sample per pixel (the resampled rows of a scaled frame)
+static void darling_yuv_row_444(
+    uint8_t* dst,
+    const uint8_t* y,
+    const uint8_t* u,
+    const uint8_t* v,
+    uint32_t width,
+    const DarlingYuvCoeffs* k
+) {
+    uint32_t* out = (uint32_t*)dst;
+    uint32_t x = 0;
+
+#ifdef DARLING_YUV_SSE2
+    DarlingYuvSse2 c;
+    darling_yuv_load_sse2(k, &c);
+    __m128i zero = _mm_setzero_si128();
+
+    for (; x + 8u <= width; x += 8u) {
+        __m128i yv = _mm_loadl_epi64((const __m128i*)(y + x));
+        __m128i cu = _mm_unpacklo_epi8(zero, _mm_loadl_epi64((const __m128i*)(u + x)));
+        __m128i cv = _mm_unpacklo_epi8(zero, _mm_loadl_epi64((const __m128i*)(v + x)));
+
+        darling_yuv_px8_sse2(dst + (size_t)x * 4u, _mm_unpacklo_epi8(yv, yv),
+            _mm_sub_epi16(cu, c.half), _mm_sub_epi16(cv, c.half), &c);
+    }
+#endif
+
+    for (; x < width; x++) {
+        out[x] = darling_yuv_pixel(y[x], u[x], v[x], k);
+    }
+}
+
+// Source position of destination sample `i` with sample centers aligned,
+// in 1/256 steps
+static DarlingYuvTap darling_yuv_tap(uint32_t i, uint32_t dst, uint32_t src) {
+    int64_t pos = ((2 * (int64_t)i + 1) * src * 256) / (2 * (int64_t)dst) - 128;
+    DarlingYuvTap tap;
+
+    if (pos < 0) {
+        pos = 0;
+    }
+    tap.i0 = (uint32_t)(pos >> 8);
+    tap.i1 = tap.i0 + 1u < src ? tap.i0 + 1u : tap.i0;
+    tap.f = (uint32_t)(pos & 255);
+    return tap;
+}
+
+// Vertical pass: two source rows blended into 8.8 fixed point
+static void darling_yuv_blend_rows(uint16_t* dst, const uint8_t* r0, const uint8_t* r1, uint32_t f, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = (uint16_t)(r0[i] * (256u - f) + r1[i] * f);
+    }
+}
+
+// Horizontal pass, rounded back to 8 bits
+static inline uint8_t darling_yuv_lerp(const uint16_t* row, const DarlingYuvTap* x) {
+    return (uint8_t)((row[x->i0] * (256u - x->f) + row[x->i1] * x->f + 32768u) >> 16);
+}
+
+typedef struct DarlingYuvJob {
+    uint8_t* dst;
+    size_t dstStride;
+    uint32_t dstWidth;
+    uint32_t dstHeight;
+    const DarlingYuvFrame* frame;
+    const uint8_t* u;
+    const uint8_t* v;
+    size_t vStride;
+    uint32_t chromaStep;
+    DarlingYuvCoeffs k;
+
+    // Scaled frames: per destination column, offsets into a Y row and a
+    // chroma row (already multiplied by chromaStep)
+    const DarlingYuvTap* lumaX;
+    const DarlingYuvTap* chromaX;
+} DarlingYuvJob;
+
+static void darling_yuv_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingYuvJob* job = (const DarlingYuvJob*)ctx;
+    const DarlingYuvFrame* f = job->frame;
+
+    for (uint32_t row = begin; row < end; row++) {
+        size_t c = (size_t)(row >> 1);
+        darling_yuv_row_420(job->dst + (size_t)row * job->dstStride,
+            f->planes[0] + (size_t)row * f->strides[0],
+            job->u + c * f->strides[1], job->v + c * job->vStride,
+            job->chromaStep, f->width, &job->k);
+    }
+}
+
+// Each row: blend the two source rows of every plane, resample a chunk of
+// the blends into Y, U and V runs, then convert the runs while they are
+// still in cache
+static void darling_yuv_scaled_rows(void* ctx, uint32_t begin, uint32_t end) {
+    const DarlingYuvJob* job = (const DarlingYuvJob*)ctx;
+    const DarlingYuvFrame* f = job->frame;
+    uint32_t chromaRows = (f->height + 1u) / 2u;
+    uint32_t chromaBytes = (f->width + 1u) / 2u * job->chromaStep;
+    BOOL nv12 = job->chromaStep == 2u;
+    uint8_t ys[DARLING_YUV_CHUNK];
+    uint8_t us[DARLING_YUV_CHUNK];
+    uint8_t vs[DARLING_YUV_CHUNK];
+
+    // NV12 blends U and V together in one interleaved row
+    uint16_t* blendY = (uint16_t*)malloc(sizeof(uint16_t) * ((size_t)f->width + 2u * chromaBytes));
+    if (!blendY) {
+        return;
+    }
+    uint16_t* blendU = blendY + f->width;
+    uint16_t* blendV = nv12 ? blendU + 1 : blendU + chromaBytes;
+
+    for (uint32_t row = begin; row < end; row++) {
+        DarlingYuvTap ty = darling_yuv_tap(row, job->dstHeight, f->height);
+        DarlingYuvTap tc = darling_yuv_tap(row, job->dstHeight, chromaRows);
+        uint8_t* out = job->dst + (size_t)row * job->dstStride;
+
+        darling_yuv_blend_rows(blendY, f->planes[0] + (size_t)ty.i0 * f->strides[0],
+            f->planes[0] + (size_t)ty.i1 * f->strides[0], ty.f, f->width);
+        darling_yuv_blend_rows(blendU, job->u + (size_t)tc.i0 * f->strides[1],
+            job->u + (size_t)tc.i1 * f->strides[1], tc.f, chromaBytes);
+        if (!nv12) {
+            darling_yuv_blend_rows(blendV, job->v + (size_t)tc.i0 * job->vStride,
+                job->v + (size_t)tc.i1 * job->vStride, tc.f, chromaBytes);
+        }
+
+        for (uint32_t x = 0; x < job->dstWidth; x += DARLING_YUV_CHUNK) {
+            uint32_t n = job->dstWidth - x < DARLING_YUV_CHUNK ? job->dstWidth - x : DARLING_YUV_CHUNK;
+            const DarlingYuvTap* lx = job->lumaX + x;
+            const DarlingYuvTap* cx = job->chromaX + x;
+
+            for (uint32_t i = 0; i < n; i++) {
+                ys[i] = darling_yuv_lerp(blendY, &lx[i]);
+                us[i] = darling_yuv_lerp(blendU, &cx[i]);
+                vs[i] = darling_yuv_lerp(blendV, &cx[i]);
+            }
+            darling_yuv_row_444(out + (size_t)x * 4u, ys, us, vs, n, &job->k);
+        }
+    }
+
+    free(blendY);
+}
+
+BOOL darling_yuv_frame_ok(const DarlingYuvFrame* frame) {
+    if (!frame || !darling_frame_size_ok(frame->width, frame->height) ||
+        frame->matrix > DARLING_YUV_BT709 || frame->range > DARLING_YUV_FULL ||
+        !frame->planes[0] || !frame->planes[1] || frame->strides[0] < frame->width) {
+        return FALSE;
+    }
+
+    uint32_t chromaWidth = (frame->width + 1u) / 2u;
+    if (frame->layout == DARLING_YUV_NV12) {
+        return frame->strides[1] >= chromaWidth * 2u;
+    }
+    return frame->layout == DARLING_YUV_I420 && frame->planes[2] &&
+        frame->strides[1] >= chromaWidth && frame->strides[2] >= chromaWidth;
+}
+
+// Convert a checked frame into a dst_w x dst_h BGRA8 buffer on the pool,
+// resampling when the sizes differ. FALSE if scaling tables cannot be
+// allocated.
+BOOL darling_yuv_convert(uint8_t* dst, size_t dst_stride, uint32_t dst_w, uint32_t dst_h, const DarlingYuvFrame* frame) {
+    DarlingYuvJob job;
+    BOOL nv12 = frame->layout == DARLING_YUV_NV12;
+
+    memset(&job, 0, sizeof(job));
+    job.dst = dst;
+    job.dstStride = dst_stride;
+    job.dstWidth = dst_w;
+    job.dstHeight = dst_h;
+    job.frame = frame;
+    job.u = frame->planes[1];
+    job.v = nv12 ? frame->planes[1] + 1 : frame->planes[2];
+    job.vStride = nv12 ? frame->strides[1] : frame->strides[2];
+    job.chromaStep = nv12 ? 2u : 1u;
+    darling_yuv_coeffs(frame->matrix, frame->range, &job.k);
+
+    if (dst_w == frame->width && dst_h == frame->height) {
+        darling_pool_for_rows(dst_h, (size_t)dst_w * 4u, darling_yuv_rows, &job);
+        return TRUE;
+    }
+
+    DarlingYuvTap* taps = (DarlingYuvTap*)malloc(sizeof(DarlingYuvTap) * dst_w * 2u);
+    if (!taps) {
+        return FALSE;
+    }
+
+    uint32_t chromaWidth = (frame->width + 1u) / 2u;
+    for (uint32_t x = 0; x < dst_w; x++) {
+        DarlingYuvTap c = darling_yuv_tap(x, dst_w, chromaWidth);
+        c.i0 *= job.chromaStep;
+        c.i1 *= job.chromaStep;
+        taps[x] = darling_yuv_tap(x, dst_w, frame->width);
+        taps[dst_w + x] = c;
+    }
+
+    job.lumaX = taps;
+    job.chromaX = taps + dst_w;
+    darling_pool_for_rows(dst_h, (size_t)dst_w * 4u, darling_yuv_scaled_rows, &job);
+    free(taps);
+    return TRUE;
+}
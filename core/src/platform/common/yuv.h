@@ -0,0 +1,36 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// YUV Conversion
+// 8-bit 4:2:0 video (I420, NV12) to BGRA8 in 16-bit fixed point with five
+// fractional bits. The SSE2 rows and the scalar pixel use the same integer
+// formula, so every target produces the same bytes; the result is within
+// one step of the exact BT.601/BT.709 conversion.
+//
+//   Y' = (Y * 257 * yGain) >> 16 - yBias           (Y scaled to full range)
+//   C' = (C - 128) << 8
+//   B  = (Y' + (U' * bu) >> 16) >> 5
+//   G  = (Y' - (U' * gu) >> 16 - (V' * gv) >> 16) >> 5
+//   R  = (Y' + (V' * rv) >> 16) >> 5
+//
+// Chroma is replicated across each pixel pair when the frame is painted at
+// its own size, and resampled bilinearly with luma when it is scaled.
+
+#define DARLING_YUV_CHUNK 256u              // pixels resampled per pass when scaling
+
+typedef struct DarlingYuvCoeffs {
+    uint16_t yGain;
+    int16_t yBias;                  // black level, less half a step for rounding
+    int16_t rv;
+    int16_t gu;
+    int16_t gv;
+    int16_t bu;
+} DarlingYuvCoeffs;
+
+// One bilinear tap: source samples i0 and i1 weighted (256 - f) and f
+typedef struct DarlingYuvTap {
+    uint32_t i0;
+    uint32_t i1;
+    uint32_t f;
+} DarlingYuvTap;
@@ -0,0 +1,400 @@
+#pragma once
+#include <pthread.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Headless backend: an in-memory implementation of the Darling API with no
+// OS windows. Windows own a heap backing store, messages go through a
+// process-local queue drained by darling_poll_events. Used for benchmarks and
+// CI on machines without Win32.
+
+// Win32-shaped aliases so code shared with the Win32 backend compiles unchanged
+typedef int BOOL;
+typedef struct DarlingHeadlessHandle* HWND;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+// Constants
+#define DARLING_DEFAULT_DPI 96u
+#define DARLING_QUEUE_INITIAL_CAPACITY 256u
+
+// Messages
+typedef enum DarlingMessage {
+    DARLING_MSG_NULL = 0,
+    DARLING_MSG_PAINT,
+    DARLING_MSG_SIZE,
+    DARLING_MSG_CLOSE,
+    DARLING_MSG_SETTINGCHANGE,
+    DARLING_MSG_SETTINGS_REFRESH,
+    DARLING_MSG_DPICHANGED,         // wp = new DPI (simulated monitor change)
+    DARLING_MSG_MINIMIZE,           // wp = 1 minimized, 0 restored (simulated)
+    DARLING_MSG_OCCLUDE,            // wp = 1 covered by other windows, 0 uncovered (simulated)
+    DARLING_MSG_POWER_RESUME,       // another thread unthrottled the window
+
+    // Simulated input, Win32-shaped: points are packed into lp as
+    // DARLING_INPUT_POINT(x, y) (client coordinates)
+    DARLING_MSG_MOUSEMOVE,          // lp = point
+    DARLING_MSG_BUTTONDOWN,         // wp = button (0 left, 1 right, 2 middle), lp = point
+    DARLING_MSG_BUTTONUP,           // wp = button, lp = point
+    DARLING_MSG_WHEEL,              // wp = signed delta (120 per notch), lp = point
+    DARLING_MSG_KEYDOWN,            // wp = virtual-key code, lp = scan code
+    DARLING_MSG_KEYUP,              // wp = virtual-key code, lp = scan code
+    DARLING_MSG_CHAR                // wp = UTF-16 code unit
+} DarlingMessage;
+
+#define DARLING_INPUT_POINT(x, y) ((intptr_t)(((uint32_t)(uint16_t)(int16_t)(x)) | ((uint32_t)(uint16_t)(int16_t)(y) << 16)))
+#define DARLING_INPUT_POINT_X(lp) ((int32_t)(int16_t)(uint16_t)((uint32_t)(lp) & 0xFFFFu))
+#define DARLING_INPUT_POINT_Y(lp) ((int32_t)(int16_t)(uint16_t)(((uint32_t)(lp) >> 16) & 0xFFFFu))
+
+typedef struct DarlingQueuedMessage {
+    HWND hwnd;
+    uint32_t msg;
+    uintptr_t wp;
+    intptr_t lp;
+} DarlingQueuedMessage;
+
+// Child Layout Tree (platform/common/layout.c)
+#include "../../common/layout.h"
+
+// Hit-Test Index (platform/common/hittest.c)
+#include "../../common/hittest.h"
+
+// Input Ring (platform/common/input.c)
+#include "../../common/input.h"
+
+// Window State Mirror (platform/common/mirror.c)
+#include "../../common/mirror.h"
+
+// Frame Timing (platform/common/timing.c)
+#include "../../common/timing.h"
+
+// Layer Compositor (platform/common/compositor.c)
+#include "../../common/compositor.h"
+
+// Display List (platform/common/displaylist.c)
+#include "../../common/displaylist.h"
+
+// Virtual Surface (platform/common/surface.c)
+#include "../../common/surface.h"
+
+// Power Throttling (platform/common/power.c)
+#include "../../common/power.h"
+
+// Animations (platform/common/anim.c)
+#include "../../common/anim.h"
+
+// Present Mode (platform/common/layered.c)
+#include "../../common/layered.h"
+
+// Worker Threads (utils.c)
+typedef pthread_t DarlingThread;
+
+typedef struct DarlingGate {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    volatile int32_t epoch;
+} DarlingGate;
+
+// Set by darling_ui_signal_raise until the waiter next returns
+typedef struct DarlingUiSignal {
+    DarlingGate gate;
+    int32_t seen;
+} DarlingUiSignal;
+
+// Frame Thread Pool (platform/common/pool.c)
+#include "../../common/pool.h"
+
+// UI Thread (platform/common/uithread.c)
+#include "../../common/uithread.h"
+
+// Shared Memory (utils.c)
+typedef struct DarlingSharedMemory {
+    void* base;
+    size_t bytes;
+    char name[80];                  // "/" + ring name, for shm_unlink
+} DarlingSharedMemory;
+
+// Mapped Files (utils.c)
+typedef struct DarlingMappedFile {
+    void* base;
+    size_t bytes;
+} DarlingMappedFile;
+
+// Shared-Memory Frame Ring (platform/common/framering.c)
+#include "../../common/framering.h"
+
+// Thumbnail Pyramid (platform/common/thumbnail.c)
+#include "../../common/thumbnail.h"
+
+// Splash Snapshot (platform/common/snapshot.c)
+#include "../../common/snapshot.h"
+
+// Types
+
+typedef struct DarlingWindow {
+    HWND hwnd;
+    void* dibBits;
+    uint32_t bitmapWidth;
+    uint32_t bitmapHeight;
+
+    // Backing-store accounting (platform/common/backing.c)
+    uint32_t gdiObjects;
+    uint64_t lastPresent;       // LRU tick of the last present
+    BOOL evicted;
+    void* evictedPixels;        // compressed copy, or NULL if released
+    size_t evictedSize;
+    uint32_t evictedWidth;
+    uint32_t evictedHeight;
+    uint64_t evictionCount;
+
+    uint32_t clientWidth;
+    uint32_t clientHeight;
+    uint32_t dpi;
+
+    DarlingLayoutTree layout;
+    uint64_t layoutBatchCount;   // DeferWindowPos batches
+    uint64_t layoutMoveCount;    // children moved/shown/hidden
+
+    DarlingHitIndex hitIndex;
+
+    DarlingInputRing* inputRing;    // caller-owned, NULL when detached
+    DarlingStateMirror* stateMirror;    // caller-owned, NULL when detached
+    uint32_t inputModifiers;        // keys and buttons held, from simulated input
+
+    DarlingFrameTiming timing;
+    DarlingCompositor compositor;
+    DarlingDisplayList displayList;
+    DarlingSurface surface;
+    DarlingPower power;
+    DarlingAnimator anim;
+    DarlingLayered layered;
+    DarlingFrameRingView frameRing;
+    DarlingThumbnailCache thumbnails;
+    DarlingSplash splash;
+
+    BOOL isChild;
+    BOOL inList;
+    BOOL darkMode;
+    BOOL visible;
+    BOOL minimized;
+    BOOL occluded;
+    BOOL paintPending;
+    HWND childHwnd;
+
+    uint8_t opacity;
+    BOOL topmost;
+    int32_t x;                   // outer window position; only animations move it
+    int32_t y;
+    uint32_t titlebarColor;      // 0xRRGGBB, once set or animated
+    BOOL titlebarColorSet;
+    uint64_t presentCount;
+
+    uint32_t appearanceDepth;
+    BOOL frameChangePending;
+    uint64_t frameChangeCount;   // non-client recalculations (SWP_FRAMECHANGED)
+    uint64_t windowPosCount;     // moves and resizes (SetWindowPos)
+
+    struct DarlingWindow* prev;
+    struct DarlingWindow* next;
+} DarlingWindow;
+
+// Global State (defined in impl/window.c)
+
+extern DarlingWindow* g_main_window;
+extern DarlingWindow* g_window_head;
+extern DarlingWindow* g_focus_window;
+extern void (*g_close_callback)(void);
+extern DarlingCloseCallbackHWND g_close_callback_hwnd;
+extern DarlingDpiChangedCallback g_dpi_changed_callback;
+extern pthread_mutex_t g_lock;
+extern BOOL g_lock_initialized;
+extern int g_toplevel_count;
+
+// Internal Function Declarations
+
+// Thread Safety (utils.c)
+void darling_ensure_lock(void);
+void darling_lock(void);
+void darling_unlock(void);
+
+// Logging (utils.c)
+void darling_log(const char* fmt, ...);
+
+// System Settings (utils.c provider, platform/common/settings.c cache)
+#include "../../common/settings.h"
+int darling_read_system_settings(void* ctx, DarlingSystemSettings* out);
+void darling_settings_post_theme(DarlingWindow* win);     // backend: re-theme on the window's own thread
+BOOL darling_is_system_dark_mode(void);
+
+// Theme Application (window.c)
+void darling_apply_dark_mode_internal(DarlingWindow* win, BOOL enable);
+void darling_apply_frame_change(DarlingWindow* win);
+
+// Hit Testing (window.c)
+void darling_query_client_size(DarlingWindow* win, int32_t* w, int32_t* h);
+
+// Frame Timing (platform/common/timing.c)
+void darling_timing_begin(DarlingWindow* win);
+void darling_timing_cancel(DarlingWindow* win);
+void darling_timing_stamp(DarlingWindow* win, DarlingFrameStage stage);
+void darling_timing_paint_start(DarlingWindow* win);
+void darling_timing_presented(DarlingWindow* win);
+BOOL darling_timing_draw_overlay(DarlingWindow* win);
+
+// Layer Compositor (platform/common/compositor.c)
+void darling_compositor_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+uint8_t* darling_compositor_content(DarlingWindow* win);
+BOOL darling_compositor_flush(DarlingWindow* win);
+void darling_compositor_free(DarlingWindow* win);
+void darling_compositor_invalidate(DarlingWindow* win, const DarlingDamageRect* rect);   // backend
+
+// Display List (platform/common/displaylist.c)
+void darling_draw_refresh(DarlingWindow* win);
+void darling_draw_free(DarlingWindow* win);
+
+// Virtual Surface (platform/common/surface.c)
+void darling_surface_refresh(DarlingWindow* win);
+void darling_surface_free(DarlingWindow* win);
+
+// Power Throttling (platform/common/power.c)
+BOOL darling_power_covered(const DarlingDamageRect* target, const DarlingDamageRect* rects, uint32_t count);
+void darling_power_update(DarlingWindow* win);
+void darling_power_poll(void);
+void darling_power_signal(DarlingWindow* win);
+BOOL darling_power_begin(DarlingWindow* win, DarlingPowerSample* sample);
+void darling_power_end(DarlingWindow* win, const DarlingPowerSample* sample);
+void darling_power_resume(DarlingWindow* win);
+void darling_power_post_resume(DarlingWindow* win);                 // backend: resume on the window's own thread
+DarlingVisibility darling_query_visibility(DarlingWindow* win);     // backend
+
+// Animations (platform/common/anim.c)
+double darling_anim_now(void);
+double darling_anim_ease(uint32_t easing, const float bezier[4], double x);
+void darling_anim_poll(void);
+double darling_anim_wait_ms(void);
+void darling_anim_free(DarlingWindow* win);
+void darling_anim_read(DarlingWindow* win, uint32_t property, int32_t out[2]);     // backend
+void darling_anim_apply(DarlingWindow* win, const DarlingAnimFrame* frame);       // backend
+double darling_anim_refresh_ms(DarlingWindow* win);                                // backend
+void darling_anim_wake(DarlingWindow* win);                                        // backend
+BOOL darling_window_is_local(DarlingWindow* win);                                  // backend: owned by the calling thread
+
+// Present Mode (platform/common/layered.c)
+BOOL darling_layered_active(DarlingWindow* win);
+DarlingPoolOp darling_layered_paint_op(DarlingWindow* win, DarlingPixelFormat format, uint32_t w, uint32_t h);
+BOOL darling_layered_damage(DarlingWindow* win, const DarlingDamageRect* rect);
+BOOL darling_layered_take(DarlingWindow* win, DarlingDamageRect* out);
+void darling_layered_free(DarlingWindow* win);
+void darling_layered_style(DarlingWindow* win, BOOL enable);       // backend
+void darling_layered_schedule(DarlingWindow* win);                 // backend
+
+// Worker Threads (utils.c)
+BOOL darling_thread_start(DarlingThread* thread, void (*fn)(void*), void* arg);
+void darling_thread_join(DarlingThread thread);
+void darling_thread_pin(DarlingThread thread, uint32_t cpu);
+void darling_thread_yield(void);
+double darling_thread_cpu_ms(void);                          // calling thread's CPU time
+uint32_t darling_cpu_count(void);
+void darling_gate_init(DarlingGate* gate);
+void darling_gate_destroy(DarlingGate* gate);
+void darling_gate_wait(DarlingGate* gate, int32_t seen);     // until epoch != seen
+void darling_gate_open(DarlingGate* gate);                   // epoch++, wake all
+
+// Frame Thread Pool (platform/common/pool.c)
+void darling_pool_for_rows(uint32_t rows, size_t row_bytes, DarlingRowFn fn, void* ctx);
+void darling_pool_convert(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, uint32_t w, uint32_t h, DarlingPoolOp op);
+void darling_pool_shutdown(void);
+
+// UI Thread (platform/common/uithread.c)
+void darling_ui_thread_shutdown(void);
+BOOL darling_ui_signal_init(DarlingUiSignal* signal);        // backend
+void darling_ui_signal_destroy(DarlingUiSignal* signal);     // backend
+void darling_ui_signal_raise(DarlingUiSignal* signal);       // backend
+void darling_ui_signal_wait(DarlingUiSignal* signal);        // backend
+
+// Shared Memory (utils.c)
+BOOL darling_shm_create(DarlingSharedMemory* shm, const char* name, size_t bytes);
+void darling_shm_close(DarlingSharedMemory* shm);
+
+// Mapped Files (utils.c)
+BOOL darling_file_map(DarlingMappedFile* file, const char* path, size_t bytes);   // bytes 0: existing file, read only
+void darling_file_unmap(DarlingMappedFile* file);
+BOOL darling_file_replace(const char* from, const char* to);
+
+// Splash Snapshot (platform/common/snapshot.c)
+BOOL darling_splash_begin(DarlingWindow* win, double created_ms);
+void darling_splash_end(DarlingWindow* win);
+void darling_splash_poll(void);
+void darling_splash_free(DarlingWindow* win);
+
+// Shared-Memory Frame Ring (platform/common/framering.c)
+void darling_frame_ring_poll(void);
+void darling_frame_ring_free(DarlingWindow* win);
+
+// Input Ring (platform/common/input.c)
+void darling_input_emit(DarlingWindow* win, uint32_t type, uint32_t modifiers, int32_t x, int32_t y, int32_t code, int32_t value);
+
+// Window State Mirror (platform/common/mirror.c)
+void darling_state_publish(DarlingWindow* win);
+void darling_query_window_state(DarlingWindow* win, DarlingWindowState* out);     // backend
+
+// Appearance Transactions (platform/common/appearance.c)
+void darling_request_frame_change(DarlingWindow* win);
+
+// Frame Kernels (platform/common/frame.c)
+#include "../../common/frame.h"
+
+// YUV Conversion (platform/common/yuv.c)
+#include "../../common/yuv.h"
+void darling_yuv_coeffs(uint32_t matrix, uint32_t range, DarlingYuvCoeffs* out);
+BOOL darling_yuv_frame_ok(const DarlingYuvFrame* frame);
+BOOL darling_yuv_convert(uint8_t* dst, size_t dst_stride, uint32_t dst_w, uint32_t dst_h, const DarlingYuvFrame* frame);
+
+// Thumbnail Pyramid (platform/common/thumbnail.c)
+void darling_thumbnail_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+void darling_thumbnail_sync(DarlingWindow* win);
+void darling_thumbnail_free(DarlingWindow* win);
+
+// Backing Store (paint.c)
+typedef enum DarlingPaintSource {
+    DARLING_PAINT_FRAME,            // a frame from the app (or the splash)
+    DARLING_PAINT_DISPLAY_LIST,
+    DARLING_PAINT_SURFACE
+} DarlingPaintSource;
+
+void darling_free_gdi(DarlingWindow* win);
+void darling_resize_backing_store(DarlingWindow* win, uint32_t w, uint32_t h);
+BOOL darling_alloc_backing_store(DarlingWindow* win, uint32_t w, uint32_t h);
+void darling_present_backing_store(DarlingWindow* win);
+void darling_paint_enter(DarlingWindow* win, DarlingPaintSource source);
+BOOL darling_is_window_hidden(DarlingWindow* win);
+
+// Backing-Store Accounting (platform/common/backing.c)
+void darling_backing_account_alloc(DarlingWindow* win, uint32_t gdi_objects);
+void darling_backing_account_free(DarlingWindow* win);
+void darling_backing_touch(DarlingWindow* win);
+void darling_backing_enforce_budget(void);
+void darling_backing_on_shown(DarlingWindow* win);
+void darling_backing_discard(DarlingWindow* win);
+
+// Window List Management (platform/common/list.c)
+void darling_list_add(DarlingWindow* win);
+void darling_list_remove(DarlingWindow* win);
+DarlingWindow* darling_list_find(HWND hwnd);
+DarlingWindow* darling_select_new_main_window(void);
+void darling_update_main_on_remove(DarlingWindow* removed);
+
+// Message Queue (message.c)
+BOOL darling_post_message(HWND hwnd, uint32_t msg, uintptr_t wp, intptr_t lp);
+void darling_wnd_proc(DarlingWindow* win, const DarlingQueuedMessage* m);
+size_t darling_pending_message_count(void);
+void darling_free_message_queue(void);
+
+// Window Teardown (window.c)
+void darling_detach_window(DarlingWindow* win);
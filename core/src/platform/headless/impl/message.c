@@ -0,0 +1,299 @@
+#include "internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Message Queue
+// Growable ring buffer guarded by its own mutex so posting from worker
+// threads does not contend with the window list lock.
+
+static DarlingQueuedMessage* g_queue = NULL;
+static size_t g_queue_capacity = 0;
+static size_t g_queue_head = 0;
+static size_t g_queue_count = 0;
+static pthread_mutex_t g_queue_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static BOOL darling_queue_grow(void) {
+    size_t newCapacity = g_queue_capacity ? g_queue_capacity * 2u : DARLING_QUEUE_INITIAL_CAPACITY;
+    DarlingQueuedMessage* grown =
+        (DarlingQueuedMessage*)malloc(newCapacity * sizeof(DarlingQueuedMessage));
+
+    if (!grown) {
+        return FALSE;
+    }
+
+    // Unwrap the ring into the new buffer
+    for (size_t i = 0; i < g_queue_count; i++) {
+        grown[i] = g_queue[(g_queue_head + i) % g_queue_capacity];
+    }
+
+    free(g_queue);
+    g_queue = grown;
+    g_queue_capacity = newCapacity;
+    g_queue_head = 0;
+    return TRUE;
+}
+
+BOOL darling_post_message(HWND hwnd, uint32_t msg, uintptr_t wp, intptr_t lp) {
+    BOOL ok = TRUE;
+
+    pthread_mutex_lock(&g_queue_lock);
+
+    if (g_queue_count == g_queue_capacity) {
+        ok = darling_queue_grow();
+    }
+
+    if (ok) {
+        DarlingQueuedMessage* slot = &g_queue[(g_queue_head + g_queue_count) % g_queue_capacity];
+        slot->hwnd = hwnd;
+        slot->msg = msg;
+        slot->wp = wp;
+        slot->lp = lp;
+        g_queue_count++;
+    }
+
+    pthread_mutex_unlock(&g_queue_lock);
+    return ok;
+}
+
+static BOOL darling_take_message(DarlingQueuedMessage* out) {
+    BOOL ok = FALSE;
+
+    pthread_mutex_lock(&g_queue_lock);
+
+    if (g_queue_count > 0) {
+        *out = g_queue[g_queue_head];
+        g_queue_head = (g_queue_head + 1) % g_queue_capacity;
+        g_queue_count--;
+        ok = TRUE;
+    }
+
+    pthread_mutex_unlock(&g_queue_lock);
+    return ok;
+}
+
+size_t darling_pending_message_count(void) {
+    pthread_mutex_lock(&g_queue_lock);
+    size_t count = g_queue_count;
+    pthread_mutex_unlock(&g_queue_lock);
+    return count;
+}
+
+void darling_free_message_queue(void) {
+    pthread_mutex_lock(&g_queue_lock);
+    free(g_queue);
+    g_queue = NULL;
+    g_queue_capacity = 0;
+    g_queue_head = 0;
+    g_queue_count = 0;
+    pthread_mutex_unlock(&g_queue_lock);
+}
+
+// Input Simulation
+
+static uint32_t darling_button_modifier(uintptr_t button) {
+    switch (button) {
+        case 0:  return DARLING_INPUT_BUTTON_LEFT;
+        case 1:  return DARLING_INPUT_BUTTON_RIGHT;
+        case 2:  return DARLING_INPUT_BUTTON_MIDDLE;
+        default: return 0;
+    }
+}
+
+// VK_SHIFT, VK_CONTROL, VK_MENU, VK_LWIN/VK_RWIN
+static uint32_t darling_key_modifier(uintptr_t vk) {
+    switch (vk) {
+        case 0x10: return DARLING_INPUT_MOD_SHIFT;
+        case 0x11: return DARLING_INPUT_MOD_CTRL;
+        case 0x12: return DARLING_INPUT_MOD_ALT;
+        case 0x5B:
+        case 0x5C: return DARLING_INPUT_MOD_META;
+        default:   return 0;
+    }
+}
+
+static void darling_handle_input(DarlingWindow* win, const DarlingQueuedMessage* m) {
+    int32_t x = DARLING_INPUT_POINT_X(m->lp);
+    int32_t y = DARLING_INPUT_POINT_Y(m->lp);
+
+    switch (m->msg) {
+        case DARLING_MSG_MOUSEMOVE:
+            darling_input_emit(win, DARLING_INPUT_MOUSE_MOVE, win->inputModifiers, x, y, 0, 0);
+            return;
+
+        case DARLING_MSG_BUTTONDOWN:
+            win->inputModifiers |= darling_button_modifier(m->wp);
+            darling_input_emit(win, DARLING_INPUT_MOUSE_DOWN, win->inputModifiers, x, y, (int32_t)m->wp, 0);
+            return;
+
+        case DARLING_MSG_BUTTONUP:
+            win->inputModifiers &= ~darling_button_modifier(m->wp);
+            darling_input_emit(win, DARLING_INPUT_MOUSE_UP, win->inputModifiers, x, y, (int32_t)m->wp, 0);
+            return;
+
+        case DARLING_MSG_WHEEL:
+            darling_input_emit(win, DARLING_INPUT_WHEEL, win->inputModifiers, x, y, 0, (int32_t)(intptr_t)m->wp);
+            return;
+
+        case DARLING_MSG_KEYDOWN: {
+            uint32_t bit = darling_key_modifier(m->wp);
+            uint32_t mods = win->inputModifiers;
+            if (bit && (mods & bit)) {
+                mods |= DARLING_INPUT_KEY_REPEAT;
+            }
+            win->inputModifiers |= bit;
+            darling_input_emit(win, DARLING_INPUT_KEY_DOWN, mods | bit, 0, 0, (int32_t)m->wp, (int32_t)m->lp);
+            return;
+        }
+
+        case DARLING_MSG_KEYUP:
+            win->inputModifiers &= ~darling_key_modifier(m->wp);
+            darling_input_emit(win, DARLING_INPUT_KEY_UP, win->inputModifiers, 0, 0, (int32_t)m->wp, (int32_t)m->lp);
+            return;
+
+        case DARLING_MSG_CHAR:
+            darling_input_emit(win, DARLING_INPUT_CHAR, win->inputModifiers, 0, 0, (int32_t)m->wp, 0);
+            return;
+    }
+}
+
+// Window Procedure
+
+void darling_wnd_proc(DarlingWindow* win, const DarlingQueuedMessage* m) {
+    switch (m->msg) {
+        case DARLING_MSG_PAINT:
+            // Stand-in for BitBlt (or a layered window update of the dirty
+            // rectangle): the backing store is the presented image
+            win->paintPending = FALSE;
+            darling_timing_paint_start(win);
+            darling_compositor_flush(win);
+            if (darling_layered_active(win)) {
+                DarlingDamageRect dirty;
+                darling_layered_take(win, &dirty);
+            }
+            win->presentCount++;
+            darling_timing_presented(win);
+            return;
+
+        case DARLING_MSG_SIZE:
+            win->clientWidth = (uint32_t)m->wp;
+            win->clientHeight = (uint32_t)m->lp;
+            darling_lock();
+            darling_hit_index_resize(&win->hitIndex, (int32_t)win->clientWidth, (int32_t)win->clientHeight);
+            darling_unlock();
+            darling_layout_apply(win);
+            darling_surface_refresh(win);
+            darling_state_publish(win);
+            return;
+
+        case DARLING_MSG_CLOSE: {
+            HWND hwnd = win->hwnd;
+            darling_log("[CLOSE] hwnd=%p\n", (void*)hwnd);
+            if (g_close_callback_hwnd) {
+                g_close_callback_hwnd((uintptr_t)hwnd);
+            }
+            if (g_close_callback) {
+                g_close_callback();
+            }
+            darling_detach_window(win);
+            return;
+        }
+
+        case DARLING_MSG_SETTINGCHANGE:
+            // One refresh per broadcast, applied to all windows at once
+            if (darling_settings_notify_change()) {
+                if (!darling_post_message(win->hwnd, DARLING_MSG_SETTINGS_REFRESH, 0, 0)) {
+                    darling_settings_refresh();
+                }
+            }
+            return;
+
+        case DARLING_MSG_SETTINGS_REFRESH:
+            // Non-zero: another thread's refresh re-themes this window
+            if (m->wp) {
+                darling_apply_dark_mode_internal(win, darling_is_system_dark_mode());
+            } else {
+                darling_settings_refresh();
+            }
+            return;
+
+        case DARLING_MSG_DPICHANGED: {
+            // Mirrors WM_DPICHANGED: the suggested rect keeps the logical size
+            uint32_t dpi = (uint32_t)m->wp;
+            if (dpi == 0 || dpi == win->dpi) {
+                return;
+            }
+
+            uint32_t oldDpi = win->dpi ? win->dpi : DARLING_DEFAULT_DPI;
+            win->clientWidth = (uint32_t)((uint64_t)win->clientWidth * dpi / oldDpi);
+            win->clientHeight = (uint32_t)((uint64_t)win->clientHeight * dpi / oldDpi);
+            win->dpi = dpi;
+
+            darling_resize_backing_store(win, win->clientWidth, win->clientHeight);
+            darling_lock();
+            darling_hit_index_resize(&win->hitIndex, (int32_t)win->clientWidth, (int32_t)win->clientHeight);
+            darling_unlock();
+            darling_layout_apply(win);
+            darling_surface_refresh(win);
+            darling_state_publish(win);
+
+            if (g_dpi_changed_callback) {
+                g_dpi_changed_callback((uintptr_t)win->hwnd, dpi);
+            }
+            return;
+        }
+
+        case DARLING_MSG_MINIMIZE:
+            // Like WM_SIZE with SIZE_MINIMIZED / SIZE_RESTORED; the client
+            // size is kept for the restore
+            win->minimized = m->wp != 0;
+            if (win->minimized) {
+                darling_backing_enforce_budget();
+            } else {
+                darling_backing_on_shown(win);
+            }
+            darling_power_update(win);
+            darling_state_publish(win);
+            return;
+
+        case DARLING_MSG_OCCLUDE:
+            win->occluded = m->wp != 0;
+            darling_power_update(win);
+            return;
+
+        case DARLING_MSG_POWER_RESUME:
+            darling_power_resume(win);
+            return;
+
+        case DARLING_MSG_MOUSEMOVE:
+        case DARLING_MSG_BUTTONDOWN:
+        case DARLING_MSG_BUTTONUP:
+        case DARLING_MSG_WHEEL:
+        case DARLING_MSG_KEYDOWN:
+        case DARLING_MSG_KEYUP:
+        case DARLING_MSG_CHAR:
+            darling_handle_input(win, m);
+            return;
+
+        default:
+            return;
+    }
+}
+
+// Public API - Event Loop
+
+void darling_poll_events(void) {
+    DarlingQueuedMessage m;
+
+    darling_frame_ring_poll();
+    darling_splash_poll();
+    darling_power_poll();
+    darling_anim_poll();
+
+    while (darling_take_message(&m)) {
+        // dispatch HWND in Darling window list
+        DarlingWindow* win = darling_list_find(m.hwnd);
+        if (win && win->hwnd == m.hwnd) {
+            darling_wnd_proc(win, &m);
+        }
+    }
+}
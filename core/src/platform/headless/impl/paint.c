@@ -0,0 +1,297 @@
+#include "internal.h"
+#include <stdlib.h>
+
+// Backing Store Management
+
+void darling_free_gdi(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_backing_account_free(win);
+    free(win->dibBits);
+    win->dibBits = NULL;
+    win->bitmapWidth = 0;
+    win->bitmapHeight = 0;
+}
+
+static BOOL darling_ensure_backing_store(DarlingWindow* win, uint32_t w, uint32_t h) {
+    if (win->dibBits && win->bitmapWidth == w && win->bitmapHeight == h) {
+        return TRUE;
+    }
+
+    darling_free_gdi(win);
+
+    win->dibBits = malloc((size_t)w * (size_t)h * 4u);
+    if (!win->dibBits) {
+        return FALSE;
+    }
+
+    win->bitmapWidth = w;
+    win->bitmapHeight = h;
+
+    // Heap memory only; no GDI objects
+    darling_backing_account_alloc(win, 0);
+    return TRUE;
+}
+
+BOOL darling_alloc_backing_store(DarlingWindow* win, uint32_t w, uint32_t h) {
+    if (!win || !win->hwnd || !darling_frame_size_ok(w, h)) {
+        return FALSE;
+    }
+
+    return darling_ensure_backing_store(win, w, h);
+}
+
+BOOL darling_is_window_hidden(DarlingWindow* win) {
+    return !win || !win->hwnd || !win->visible || win->minimized;
+}
+
+// Reallocate an existing backing store ahead of frames at a new size (DPI
+// change); windows that have never been painted keep allocating lazily.
+void darling_resize_backing_store(DarlingWindow* win, uint32_t w, uint32_t h) {
+    if (!win || !win->hwnd || !win->dibBits || !darling_frame_size_ok(w, h)) {
+        return;
+    }
+
+    darling_ensure_backing_store(win, w, h);
+}
+
+// Coalesce repaint requests like InvalidateRect/WM_PAINT
+static void darling_post_paint(DarlingWindow* win) {
+    if (!win->paintPending) {
+        win->paintPending = darling_post_message(win->hwnd, DARLING_MSG_PAINT, 0, 0);
+    }
+}
+
+// Repaint a rectangle (NULL: all); a per-pixel-alpha window gathers it
+// into its dirty rectangle instead
+static void darling_invalidate(DarlingWindow* win, const DarlingDamageRect* rect) {
+    if (!darling_layered_damage(win, rect)) {
+        darling_post_paint(win);
+    }
+}
+
+void darling_compositor_invalidate(DarlingWindow* win, const DarlingDamageRect* rect) {
+    darling_invalidate(win, rect);
+}
+
+void darling_present_backing_store(DarlingWindow* win) {
+    if (win && win->hwnd) {
+        darling_invalidate(win, NULL);
+    }
+}
+
+// Paint entry: `source` is about to overwrite the backing store. The splash
+// ends, and a display list or surface that drew the store before redraws
+// in full next time.
+void darling_paint_enter(DarlingWindow* win, DarlingPaintSource source) {
+    darling_lock();
+    if (win->splash.showing) {
+        darling_splash_end(win);
+    }
+    if (source != DARLING_PAINT_DISPLAY_LIST) {
+        win->displayList.valid = FALSE;
+    }
+    if (source != DARLING_PAINT_SURFACE) {
+        win->surface.valid = FALSE;
+    }
+    darling_unlock();
+}
+
+// Present Mode (layered presents come through DARLING_MSG_PAINT too)
+
+void darling_layered_style(DarlingWindow* win, BOOL enable) {
+    (void)win;
+    (void)enable;
+}
+
+void darling_layered_schedule(DarlingWindow* win) {
+    darling_post_paint(win);
+}
+
+// Window Painting
+// Each paint call copies into the backing store (or the content layer) and
+// invalidates what changed. The public calls wrap these so that every
+// exit past darling_power_begin reaches darling_power_end, and a frame
+// that never reached the store leaves no timing record behind. They hold
+// the lock from finding the store to invalidating it: windows are painted
+// from the JS thread, their own UI thread and producers, and the store can
+// be rebuilt or evicted by any of them.
+
+// Writes a whole w x h frame at dst, w * 4 bytes per row; FALSE if the
+// source could not be converted
+typedef BOOL (*DarlingFrameConvert)(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src);
+
+typedef struct DarlingFramePixels {
+    const unsigned char* data;
+    DarlingPixelFormat format;
+} DarlingFramePixels;
+
+static BOOL darling_convert_pixels(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src) {
+    const DarlingFramePixels* px = (const DarlingFramePixels*)src;
+    DarlingPoolOp op = darling_layered_paint_op(win, px->format, w, h);
+    darling_pool_convert(dst, (size_t)w * 4u, px->data, (size_t)w * 4u, w, h, op);
+    return TRUE;
+}
+
+static BOOL darling_convert_yuv(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src) {
+    (void)win;
+    return darling_yuv_convert(dst, (size_t)w * 4u, w, h, (const DarlingYuvFrame*)src);
+}
+
+// FALSE if the backing store could not be had or the frame not converted
+static BOOL darling_paint_whole(DarlingWindow* win, uint32_t w, uint32_t h, DarlingFrameConvert convert, const void* src) {
+    darling_paint_enter(win, DARLING_PAINT_FRAME);
+    darling_timing_begin(win);
+
+    if (!darling_ensure_backing_store(win, w, h)) {
+        return FALSE;
+    }
+
+    // With layers the frame is the content layer, composited at paint time
+    uint8_t* content = darling_compositor_content(win);
+    uint8_t* dst = content ? content : (uint8_t*)win->dibBits;
+    if (!convert(win, dst, w, h, src)) {
+        return FALSE;
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+
+    if (content) {
+        darling_compositor_damage(win, 0, 0, (int32_t)w, (int32_t)h);
+    } else {
+        darling_thumbnail_damage(win, 0, 0, (int32_t)w, (int32_t)h);
+        darling_timing_draw_overlay(win);
+        darling_invalidate(win, NULL);
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+    return TRUE;
+}
+
+// The rectangle is inside the backing store
+static void darling_paint_region(
+    DarlingWindow* win,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t w,
+    uint32_t h
+) {
+    darling_paint_enter(win, DARLING_PAINT_FRAME);
+    darling_timing_begin(win);
+
+    uint8_t* content = darling_compositor_content(win);
+    size_t dstStride = (size_t)win->bitmapWidth * 4u;
+    uint8_t* dst = (content ? content : (uint8_t*)win->dibBits) + (size_t)y * dstStride + (size_t)x * 4u;
+
+    DarlingPoolOp op = darling_layered_paint_op(win, DARLING_PIXEL_FORMAT_BGRA8, w, h);
+    darling_pool_convert(dst, dstStride, bgra_data, (size_t)w * 4u, w, h, op);
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+
+    if (content) {
+        darling_compositor_damage(win, (int32_t)x, (int32_t)y, (int32_t)(x + w), (int32_t)(y + h));
+    } else {
+        DarlingDamageRect r = { (int32_t)x, (int32_t)y, (int32_t)(x + w), (int32_t)(y + h) };
+        darling_thumbnail_damage(win, r.x0, r.y0, r.x1, r.y1);
+        darling_invalidate(win, &r);
+
+        if (darling_timing_draw_overlay(win)) {
+            DarlingDamageRect overlay = { 0, 0, (int32_t)DARLING_OVERLAY_WIDTH, (int32_t)DARLING_OVERLAY_HEIGHT };
+            darling_invalidate(win, &overlay);
+        }
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+}
+
+// Public API - Window Painting
+
+void darling_paint_frame_window_format(
+    DarlingWindow* win,
+    const unsigned char* data,
+    uint32_t w,
+    uint32_t h,
+    DarlingPixelFormat format
+) {
+    if (!win || !win->hwnd || !data || !darling_frame_size_ok(w, h)) {
+        return;
+    }
+
+    DarlingFramePixels px = { data, format };
+
+    darling_lock();
+    DarlingPowerSample power;
+    if (darling_power_begin(win, &power)) {
+        if (!darling_paint_whole(win, w, h, darling_convert_pixels, &px)) {
+            darling_timing_cancel(win);
+        }
+        darling_power_end(win, &power);
+    }
+    darling_unlock();
+}
+
+void darling_paint_frame_window(DarlingWindow* win, const unsigned char* bgra_data, uint32_t w, uint32_t h) {
+    darling_paint_frame_window_format(win, bgra_data, w, h, DARLING_PIXEL_FORMAT_BGRA8);
+}
+
+void darling_paint_yuv_window(DarlingWindow* win, const DarlingYuvFrame* frame, int scale_to_client) {
+    if (!win || !win->hwnd || !darling_yuv_frame_ok(frame)) {
+        return;
+    }
+
+    uint32_t w = frame->width;
+    uint32_t h = frame->height;
+    if (scale_to_client) {
+        int32_t cw = 0;
+        int32_t ch = 0;
+        darling_query_client_size(win, &cw, &ch);
+
+        // A minimized window has no client area; keep the frame's size
+        if (cw > 0 && ch > 0 && darling_frame_size_ok((uint32_t)cw, (uint32_t)ch)) {
+            w = (uint32_t)cw;
+            h = (uint32_t)ch;
+        }
+    }
+
+    darling_lock();
+    DarlingPowerSample power;
+    if (darling_power_begin(win, &power)) {
+        if (!darling_paint_whole(win, w, h, darling_convert_yuv, frame)) {
+            darling_timing_cancel(win);
+        }
+        darling_power_end(win, &power);
+    }
+    darling_unlock();
+}
+
+void darling_paint_frame_window_region(
+    DarlingWindow* win,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t w,
+    uint32_t h
+) {
+    if (!win || !win->hwnd || !bgra_data || w == 0 || h == 0) {
+        return;
+    }
+
+    darling_lock();
+    BOOL inside = win->dibBits && x < win->bitmapWidth && y < win->bitmapHeight &&
+        w <= win->bitmapWidth - x && h <= win->bitmapHeight - y;
+
+    DarlingPowerSample power;
+    if (inside && darling_power_begin(win, &power)) {
+        darling_paint_region(win, bgra_data, x, y, w, h);
+        darling_power_end(win, &power);
+    }
+    darling_unlock();
+}
+
+void darling_paint_frame(const unsigned char* bgra_data, uint32_t w, uint32_t h) {
+    darling_paint_frame_window(g_main_window, bgra_data, w, h);
+}
@@ -0,0 +1,287 @@
+#include "internal.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Thread Safety
+
+void darling_ensure_lock(void) {
+    if (!g_lock_initialized) {
+        // Recursive, like the CRITICAL_SECTION used by the Win32 backend
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&g_lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+        g_lock_initialized = TRUE;
+    }
+}
+
+void darling_lock(void) {
+    if (!g_lock_initialized) {
+        darling_ensure_lock();
+    }
+    pthread_mutex_lock(&g_lock);
+}
+
+void darling_unlock(void) {
+    if (g_lock_initialized) {
+        pthread_mutex_unlock(&g_lock);
+    }
+}
+
+// Worker Threads
+
+typedef struct DarlingThreadStart {
+    void (*fn)(void*);
+    void* arg;
+} DarlingThreadStart;
+
+static void* darling_thread_main(void* param) {
+    DarlingThreadStart start = *(DarlingThreadStart*)param;
+    free(param);
+    start.fn(start.arg);
+    return NULL;
+}
+
+BOOL darling_thread_start(DarlingThread* thread, void (*fn)(void*), void* arg) {
+    DarlingThreadStart* start = (DarlingThreadStart*)malloc(sizeof(DarlingThreadStart));
+    if (!start) {
+        return FALSE;
+    }
+
+    start->fn = fn;
+    start->arg = arg;
+
+    if (pthread_create(thread, NULL, darling_thread_main, start) != 0) {
+        free(start);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void darling_thread_join(DarlingThread thread) {
+    pthread_join(thread, NULL);
+}
+
+void darling_thread_pin(DarlingThread thread, uint32_t cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+    (void)thread;
+    (void)cpu;
+#endif
+}
+
+void darling_thread_yield(void) {
+    sched_yield();
+}
+
+double darling_thread_cpu_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+uint32_t darling_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1u;
+}
+
+void darling_gate_init(DarlingGate* gate) {
+    pthread_mutex_init(&gate->lock, NULL);
+    pthread_cond_init(&gate->cond, NULL);
+    gate->epoch = 0;
+}
+
+void darling_gate_destroy(DarlingGate* gate) {
+    pthread_cond_destroy(&gate->cond);
+    pthread_mutex_destroy(&gate->lock);
+}
+
+void darling_gate_wait(DarlingGate* gate, int32_t seen) {
+    pthread_mutex_lock(&gate->lock);
+    while (darling_atomic_load(&gate->epoch) == seen) {
+        pthread_cond_wait(&gate->cond, &gate->lock);
+    }
+    pthread_mutex_unlock(&gate->lock);
+}
+
+void darling_gate_open(DarlingGate* gate) {
+    pthread_mutex_lock(&gate->lock);
+    darling_atomic_add(&gate->epoch, 1);
+    pthread_cond_broadcast(&gate->cond);
+    pthread_mutex_unlock(&gate->lock);
+}
+
+// UI Thread Signal
+// A gate whose epoch the waiter remembers, so a raise is not lost when it
+// comes before the wait. No messages to dispatch here: headless windows are
+// served by darling_poll_events on any thread.
+
+BOOL darling_ui_signal_init(DarlingUiSignal* signal) {
+    darling_gate_init(&signal->gate);
+    signal->seen = 0;
+    return TRUE;
+}
+
+void darling_ui_signal_destroy(DarlingUiSignal* signal) {
+    darling_gate_destroy(&signal->gate);
+}
+
+void darling_ui_signal_raise(DarlingUiSignal* signal) {
+    darling_gate_open(&signal->gate);
+}
+
+void darling_ui_signal_wait(DarlingUiSignal* signal) {
+    darling_gate_wait(&signal->gate, signal->seen);
+    signal->seen = darling_atomic_load(&signal->gate.epoch);
+}
+
+// Shared Memory
+
+// POSIX shared memory named "/<name>". Like the Win32 backend, a name that
+// is already taken fails: unlinking it would hand the ring to whoever holds
+// the old object, or pull it from under another live ring.
+BOOL darling_shm_create(DarlingSharedMemory* shm, const char* name, size_t bytes) {
+    memset(shm, 0, sizeof(*shm));
+    snprintf(shm->name, sizeof(shm->name), "/%s", name);
+
+    int fd = shm_open(shm->name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        darling_log("shm_open(%s) failed: %d", shm->name, errno);
+        return FALSE;
+    }
+
+    void* base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)bytes) == 0) {
+        base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        darling_log("mapping %s (%zu bytes) failed: %d", shm->name, bytes, errno);
+        shm_unlink(shm->name);
+        return FALSE;
+    }
+
+    shm->base = base;
+    shm->bytes = bytes;
+    return TRUE;
+}
+
+void darling_shm_close(DarlingSharedMemory* shm) {
+    if (!shm->base) {
+        return;
+    }
+
+    munmap(shm->base, shm->bytes);
+    shm_unlink(shm->name);
+    shm->base = NULL;
+}
+
+// Mapped Files
+
+// With `bytes` 0, map an existing file read only; otherwise create or
+// truncate it to `bytes` and map it writable.
+BOOL darling_file_map(DarlingMappedFile* file, const char* path, size_t bytes) {
+    memset(file, 0, sizeof(*file));
+
+    BOOL writable = bytes != 0;
+    int fd = writable ? open(path, O_RDWR | O_CREAT | O_TRUNC, 0644) : open(path, O_RDONLY);
+    if (fd < 0) {
+        return FALSE;
+    }
+
+    struct stat st;
+    if (writable ? ftruncate(fd, (off_t)bytes) != 0 : fstat(fd, &st) != 0) {
+        close(fd);
+        return FALSE;
+    }
+    if (!writable) {
+        bytes = (size_t)st.st_size;
+    }
+
+    void* base = bytes ? mmap(NULL, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (base == MAP_FAILED) {
+        return FALSE;
+    }
+
+    file->base = base;
+    file->bytes = bytes;
+    return TRUE;
+}
+
+void darling_file_unmap(DarlingMappedFile* file) {
+    if (!file->base) {
+        return;
+    }
+
+    munmap(file->base, file->bytes);
+    file->base = NULL;
+    file->bytes = 0;
+}
+
+BOOL darling_file_replace(const char* from, const char* to) {
+    return rename(from, to) == 0;
+}
+
+// Input Clock
+
+double darling_input_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+}
+
+// Logging and Debugging
+
+void darling_log(const char* fmt, ...) {
+    static int enabled = -1;
+    if (enabled < 0) {
+        enabled = getenv("DARLING_DEBUG") != NULL;
+    }
+    if (!enabled) return;
+
+    va_list args;
+    va_start(args, fmt);
+    fputs("[Darling][headless] ", stderr);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+// System Settings Provider
+
+static int darling_env_flag(const char* name) {
+    const char* value = getenv(name);
+    return (value && value[0] == '1') ? 1 : 0;
+}
+
+int darling_read_system_settings(void* ctx, DarlingSystemSettings* out) {
+    (void)ctx;
+
+    // No desktop to query; environment variables simulate one
+    out->darkMode = darling_env_flag("DARLING_HEADLESS_DARK");
+    out->highContrast = darling_env_flag("DARLING_HEADLESS_HIGH_CONTRAST");
+    out->accentColor = 0x0078D4;
+
+    const char* accent = getenv("DARLING_HEADLESS_ACCENT");
+    if (accent) {
+        out->accentColor = (uint32_t)strtoul(accent, NULL, 16) & 0xFFFFFFu;
+    }
+
+    return 1;
+}
@@ -0,0 +1,465 @@
+#include "internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Global State
+
+DarlingWindow* g_main_window = NULL;
+DarlingWindow* g_window_head = NULL;
+DarlingWindow* g_focus_window = NULL;
+void (*g_close_callback)(void) = NULL;
+DarlingCloseCallbackHWND g_close_callback_hwnd = NULL;
+DarlingDpiChangedCallback g_dpi_changed_callback = NULL;
+
+pthread_mutex_t g_lock;
+BOOL g_lock_initialized = FALSE;
+int g_toplevel_count = 0;
+
+static uintptr_t g_next_handle = 0;
+
+// Window Creation
+
+DarlingWindow* darling_create_window(uint32_t w, uint32_t h, uintptr_t parent_hwnd) {
+    double createdMs = darling_input_now();
+    darling_ensure_lock();
+
+    DarlingWindow* win = (DarlingWindow*)calloc(1, sizeof(DarlingWindow));
+    if (!win) {
+        darling_log("calloc failed in darling_create_window\n");
+        return NULL;
+    }
+
+    darling_lock();
+    // Opaque, never-zero handles aligned like real HWNDs
+    g_next_handle += 0x10;
+    win->hwnd = (HWND)g_next_handle;
+    darling_unlock();
+
+    win->isChild = parent_hwnd != (uintptr_t)0;
+    win->visible = TRUE;
+    win->opacity = 255;
+    win->clientWidth = w;
+    win->clientHeight = h;
+    win->dpi = DARLING_DEFAULT_DPI;
+
+    darling_list_add(win);
+
+    darling_lock();
+    if (!g_main_window || (g_main_window->isChild && !win->isChild)) {
+        g_main_window = win;
+    }
+    darling_unlock();
+
+    // A splash snapshot brings its own theme
+    if (!win->isChild && !darling_splash_begin(win, createdMs)) {
+        darling_apply_dark_mode_internal(win, darling_is_system_dark_mode());
+    }
+
+    return win;
+}
+
+// Window Lifecycle
+
+// Equivalent of WM_NCDESTROY: the handle dies but the DarlingWindow
+// stays allocated until darling_destroy_window.
+void darling_detach_window(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    if (g_focus_window == win) {
+        g_focus_window = NULL;
+    }
+    darling_unlock();
+
+    if (win->inList) {
+        darling_list_remove(win);
+        darling_update_main_on_remove(win);
+    }
+
+    win->hwnd = NULL;
+    win->childHwnd = NULL;
+    win->visible = FALSE;
+
+    // An all-zero record tells mirror readers the window is gone
+    darling_state_publish(win);
+}
+
+void darling_destroy_window(DarlingWindow* win) {
+    if (!win) {
+        return;
+    }
+
+    darling_detach_window(win);
+    darling_backing_discard(win);
+    darling_free_gdi(win);
+    darling_layout_tree_free(&win->layout);
+    darling_hit_index_free(&win->hitIndex);
+    darling_compositor_free(win);
+    darling_frame_ring_free(win);
+    darling_thumbnail_free(win);
+    darling_splash_free(win);
+    darling_draw_free(win);
+    darling_surface_free(win);
+    darling_anim_free(win);
+    darling_layered_free(win);
+    free(win);
+}
+
+void darling_show_window(DarlingWindow* win) {
+    if (win && win->hwnd) {
+        win->visible = TRUE;
+        darling_backing_on_shown(win);
+        darling_power_update(win);
+        darling_state_publish(win);
+    }
+}
+
+void darling_hide_window(DarlingWindow* win) {
+    if (win && win->hwnd) {
+        win->visible = FALSE;
+        darling_backing_enforce_budget();
+        darling_power_update(win);
+        darling_state_publish(win);
+    }
+}
+
+void darling_focus_window(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    darling_lock();
+    DarlingWindow* previous = g_focus_window;
+    g_focus_window = win;
+    darling_unlock();
+
+    if (previous != win) {
+        darling_state_publish(previous);
+        darling_state_publish(win);
+    }
+}
+
+int darling_is_visible(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return 0;
+    }
+
+    return win->visible ? 1 : 0;
+}
+
+int darling_is_focused(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return 0;
+    }
+
+    return g_focus_window == win ? 1 : 0;
+}
+
+void darling_power_post_resume(DarlingWindow* win) {
+    darling_post_message(win->hwnd, DARLING_MSG_POWER_RESUME, 0, 0);
+}
+
+// No frame or position: the window rect is the client area at 0,0
+// Occlusion is simulated with DARLING_MSG_OCCLUDE
+DarlingVisibility darling_query_visibility(DarlingWindow* win) {
+    if (!win->visible) {
+        return DARLING_VISIBILITY_HIDDEN;
+    }
+    if (win->minimized) {
+        return DARLING_VISIBILITY_MINIMIZED;
+    }
+    return win->occluded ? DARLING_VISIBILITY_OCCLUDED : DARLING_VISIBILITY_VISIBLE;
+}
+
+void darling_query_window_state(DarlingWindow* win, DarlingWindowState* out) {
+    memset(out, 0, sizeof(*out));
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    out->flags = (win->visible ? DARLING_STATE_VISIBLE : 0) |
+        (win->minimized ? DARLING_STATE_MINIMIZED : 0) |
+        (g_focus_window == win ? DARLING_STATE_FOCUSED : 0) |
+        (win->darkMode ? DARLING_STATE_DARK : 0);
+    out->dpi = win->dpi;
+    out->clientWidth = (int32_t)win->clientWidth;
+    out->clientHeight = (int32_t)win->clientHeight;
+    out->x = win->x;
+    out->y = win->y;
+    out->width = (int32_t)win->clientWidth;
+    out->height = (int32_t)win->clientHeight;
+}
+
+void darling_set_child_hwnd(DarlingWindow* win, uintptr_t child_hwnd) {
+    if (!win) {
+        return;
+    }
+
+    darling_lock();
+    win->childHwnd = (HWND)child_hwnd;
+    darling_unlock();
+}
+
+uintptr_t darling_get_main_hwnd(void) {
+    if (!g_main_window || !g_main_window->hwnd) {
+        return (uintptr_t)0;
+    }
+
+    return (uintptr_t)g_main_window->hwnd;
+}
+
+uintptr_t darling_get_window_hwnd(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return (uintptr_t)0;
+    }
+
+    return (uintptr_t)win->hwnd;
+}
+
+void darling_set_close_callback(void (*callback)(void)) {
+    g_close_callback = callback;
+}
+
+void darling_set_close_callback_hwnd(DarlingCloseCallbackHWND callback) {
+    g_close_callback_hwnd = callback;
+}
+
+void darling_set_dpi_changed_callback(DarlingDpiChangedCallback callback) {
+    g_dpi_changed_callback = callback;
+}
+
+void darling_init(void) {
+    darling_ensure_lock();
+}
+
+void darling_cleanup(void) {
+    darling_ui_thread_shutdown();
+    darling_free_message_queue();
+    darling_pool_shutdown();
+
+    if (g_lock_initialized) {
+        pthread_mutex_destroy(&g_lock);
+        g_lock_initialized = FALSE;
+    }
+}
+
+// Window Appearance (no non-client area: state is recorded only)
+
+// Counts what would be a SetWindowPos(SWP_FRAMECHANGED) + RedrawWindow on Win32
+void darling_apply_frame_change(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    win->frameChangeCount++;
+}
+
+void darling_set_window_title(DarlingWindow* win, const wchar_t* title) {
+    (void)win;
+    (void)title;
+}
+
+void darling_set_window_icon_visible(DarlingWindow* win, int visible) {
+    (void)visible;
+
+    if (win && win->hwnd && !win->isChild) {
+        darling_request_frame_change(win);
+    }
+}
+
+void darling_set_window_opacity(DarlingWindow* win, uint8_t opacity) {
+    if (win && win->hwnd) {
+        win->opacity = opacity;
+    }
+}
+
+void darling_set_always_on_top(DarlingWindow* win, int enable) {
+    if (win && win->hwnd) {
+        win->topmost = enable ? TRUE : FALSE;
+    }
+}
+
+void darling_flash_window(DarlingWindow* win, int continuous) {
+    (void)win;
+    (void)continuous;
+}
+
+// Theme
+
+void darling_apply_dark_mode_internal(DarlingWindow* win, BOOL enable) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    win->darkMode = enable;
+    darling_request_frame_change(win);
+    darling_state_publish(win);
+}
+
+// Handled as DARLING_MSG_SETTINGS_REFRESH with a non-zero wp
+void darling_settings_post_theme(DarlingWindow* win) {
+    darling_post_message(win->hwnd, DARLING_MSG_SETTINGS_REFRESH, 1, 0);
+}
+
+int darling_is_dark_mode(void) {
+    return darling_is_system_dark_mode() ? 1 : 0;
+}
+
+void darling_set_dark_mode(DarlingWindow* win, int enable) {
+    darling_apply_dark_mode_internal(win, enable ? TRUE : FALSE);
+}
+
+void darling_set_auto_dark_mode(DarlingWindow* win) {
+    darling_apply_dark_mode_internal(win, darling_is_system_dark_mode());
+}
+
+void darling_set_titlebar_colors(DarlingWindow* win, uint32_t bg_color, uint32_t text_color) {
+    (void)text_color;
+    darling_set_titlebar_color(win, bg_color >> 8);
+}
+
+void darling_set_titlebar_color(DarlingWindow* win, uint32_t color) {
+    if (win && win->hwnd) {
+        win->titlebarColor = color & 0xFFFFFFu;
+        win->titlebarColorSet = TRUE;
+    }
+    darling_request_frame_change(win);
+}
+
+void darling_set_corner_preference(DarlingWindow* win, DarlingCornerPreference pref) {
+    (void)win;
+    (void)pref;
+}
+
+// Animations (the window rect is the client area, moved by animations only)
+
+void darling_anim_read(DarlingWindow* win, uint32_t property, int32_t out[2]) {
+    out[1] = 0;
+    switch (property) {
+        case DARLING_ANIM_OPACITY:
+            out[0] = win->opacity;
+            return;
+        case DARLING_ANIM_POSITION:
+            out[0] = win->x;
+            out[1] = win->y;
+            return;
+        case DARLING_ANIM_SIZE:
+            out[0] = (int32_t)win->clientWidth;
+            out[1] = (int32_t)win->clientHeight;
+            return;
+        default:
+            out[0] = (int32_t)(win->titlebarColorSet ? win->titlebarColor : win->darkMode ? 0x202020u : 0xFFFFFFu);
+            return;
+    }
+}
+
+// A resize is sent, not posted, as SetWindowPos sends WM_SIZE
+void darling_anim_apply(DarlingWindow* win, const DarlingAnimFrame* frame) {
+    if (!win->hwnd) {
+        return;
+    }
+
+    if (frame->mask & (1u << DARLING_ANIM_OPACITY)) {
+        win->opacity = (uint8_t)frame->values[DARLING_ANIM_OPACITY][0];
+    }
+    if (frame->mask & (1u << DARLING_ANIM_TITLEBAR_COLOR)) {
+        win->titlebarColor = (uint32_t)frame->values[DARLING_ANIM_TITLEBAR_COLOR][0];
+        win->titlebarColorSet = TRUE;
+    }
+    if (!(frame->mask & ((1u << DARLING_ANIM_POSITION) | (1u << DARLING_ANIM_SIZE)))) {
+        return;
+    }
+
+    win->windowPosCount++;
+    if (frame->mask & (1u << DARLING_ANIM_SIZE)) {
+        DarlingQueuedMessage m = {
+            win->hwnd, DARLING_MSG_SIZE,
+            (uintptr_t)frame->values[DARLING_ANIM_SIZE][0], (intptr_t)frame->values[DARLING_ANIM_SIZE][1]
+        };
+        darling_wnd_proc(win, &m);
+    }
+    if (frame->mask & (1u << DARLING_ANIM_POSITION)) {
+        win->x = frame->values[DARLING_ANIM_POSITION][0];
+        win->y = frame->values[DARLING_ANIM_POSITION][1];
+        darling_state_publish(win);
+    }
+}
+
+double darling_anim_refresh_ms(DarlingWindow* win) {
+    (void)win;
+    return DARLING_ANIM_REFRESH_MS;
+}
+
+// Messages are not tied to threads; whoever polls ticks
+void darling_anim_wake(DarlingWindow* win) {
+    (void)win;
+}
+
+BOOL darling_window_is_local(DarlingWindow* win) {
+    (void)win;
+    return TRUE;
+}
+
+// Child Layout (counts what Win32 would batch into one DeferWindowPos)
+
+void darling_layout_apply(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    darling_lock();
+
+    DarlingLayoutTree* tree = &win->layout;
+    if (tree->count > 0) {
+        darling_layout_compute(tree, (int32_t)win->clientWidth, (int32_t)win->clientHeight);
+
+        uint32_t moved = 0;
+        for (uint32_t i = 0; i < tree->count; i++) {
+            DarlingLayoutNode* node = &tree->nodes[i];
+            if (node->kind != DARLING_LAYOUT_NODE_LEAF || !node->child || !darling_layout_leaf_dirty(node)) {
+                continue;
+            }
+
+            node->appliedRect = node->rect;
+            node->appliedVisible = node->visible;
+            node->applied = 1;
+            moved++;
+        }
+
+        if (moved) {
+            win->layoutBatchCount++;
+            win->layoutMoveCount += moved;
+        }
+    }
+
+    darling_unlock();
+}
+
+// Hit Testing (no non-client messages: regions are queried directly)
+
+void darling_query_client_size(DarlingWindow* win, int32_t* w, int32_t* h) {
+    *w = win ? (int32_t)win->clientWidth : 0;
+    *h = win ? (int32_t)win->clientHeight : 0;
+}
+
+// DPI
+
+uint32_t darling_get_dpi(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return DARLING_DEFAULT_DPI;
+    }
+
+    return win->dpi;
+}
+
+float darling_get_scale_factor(DarlingWindow* win) {
+    return (float)darling_get_dpi(win) / 96.0f;
+}
+
+// Capabilities: only per-window DPI is simulated; there is no DWM
+
+int darling_has_capability(DarlingCapability cap) {
+    return cap == DARLING_CAP_PER_WINDOW_DPI ? 1 : 0;
+}
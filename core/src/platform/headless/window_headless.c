@@ -0,0 +1,34 @@
+// pthread_setaffinity_np for the frame thread pool
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "darling.h"
+
+// Include all implementation files
+#include "impl/utils.c"
+#include "../common/frame.c"
+#include "../common/list.c"
+#include "impl/message.c"
+#include "impl/paint.c"
+#include "impl/window.c"
+#include "../common/appearance.c"
+#include "../common/layout.c"
+#include "../common/hittest.c"
+#include "../common/settings.c"
+#include "../common/backing.c"
+#include "../common/input.c"
+#include "../common/timing.c"
+#include "../common/compositor.c"
+#include "../common/displaylist.c"
+#include "../common/surface.c"
+#include "../common/pool.c"
+#include "../common/framering.c"
+#include "../common/yuv.c"
+#include "../common/thumbnail.c"
+#include "../common/mirror.c"
+#include "../common/uithread.c"
+#include "../common/snapshot.c"
+#include "../common/power.c"
+#include "../common/anim.c"
+#include "../common/layered.c"
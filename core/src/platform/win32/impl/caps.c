@@ -0,0 +1,107 @@
+#include "internal.h"
+
+// OS Capability Table
+// Optional user32 entry points and DWM attribute support are resolved once;
+// call sites test the table instead of probing the OS on every call.
+
+DarlingCaps g_caps = {0};
+
+typedef LONG (WINAPI *DarlingRtlGetVersionFn)(OSVERSIONINFOW*);
+
+// GetVersionEx is shimmed for unmanifested processes; RtlGetVersion is not
+static DWORD darling_os_build(void) {
+    HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+    if (!ntdll) {
+        return 0;
+    }
+
+    DarlingRtlGetVersionFn rtlGetVersion =
+        (DarlingRtlGetVersionFn)GetProcAddress(ntdll, "RtlGetVersion");
+
+    if (!rtlGetVersion) {
+        return 0;
+    }
+
+    OSVERSIONINFOW info = {0};
+    info.dwOSVersionInfoSize = sizeof(info);
+
+    if (rtlGetVersion(&info) != 0) {
+        return 0;
+    }
+
+    return info.dwBuildNumber;
+}
+
+void darling_probe_capabilities(void) {
+    if (g_caps.probed) {
+        return;
+    }
+
+    HMODULE user32 = GetModuleHandleW(L"user32.dll");
+    if (user32) {
+        g_caps.getDpiForWindow =
+            (DarlingGetDpiForWindowFn)GetProcAddress(user32, "GetDpiForWindow");
+        g_caps.getDpiForSystem =
+            (DarlingGetDpiForSystemFn)GetProcAddress(user32, "GetDpiForSystem");
+        g_caps.adjustWindowRectExForDpi =
+            (DarlingAdjustWindowRectExForDpiFn)GetProcAddress(user32, "AdjustWindowRectExForDpi");
+        g_caps.getPointerType =
+            (DarlingGetPointerTypeFn)GetProcAddress(user32, "GetPointerType");
+    }
+
+    DWORD build = darling_os_build();
+    g_caps.osBuild = build;
+
+    if (build == 0) {
+        // Unknown build: keep the previous behaviour and let DWM reject what it lacks
+        g_caps.dwmDarkModeAttribute = DWMWA_USE_IMMERSIVE_DARK_MODE;
+        g_caps.dwmCaptionColor = TRUE;
+        g_caps.dwmCornerPreference = TRUE;
+    } else {
+        // Attribute 20 since build 18985; 1809-1909 used the undocumented 19
+        if (build >= 18985) {
+            g_caps.dwmDarkModeAttribute = DWMWA_USE_IMMERSIVE_DARK_MODE;
+        } else if (build >= 17763) {
+            g_caps.dwmDarkModeAttribute = DWMWA_USE_IMMERSIVE_DARK_MODE_BEFORE_20H1;
+        }
+
+        g_caps.dwmCaptionColor = build >= 22000;
+        g_caps.dwmCornerPreference = build >= 22000;
+    }
+
+    g_caps.probed = TRUE;
+}
+
+// Query the OS for a window's DPI; only used to (re)fill the per-window cache
+uint32_t darling_query_window_dpi(HWND hwnd) {
+    UINT dpi = 0;
+
+    if (hwnd && g_caps.getDpiForWindow) {
+        dpi = g_caps.getDpiForWindow(hwnd);
+    } else if (g_caps.getDpiForSystem) {
+        dpi = g_caps.getDpiForSystem();
+    }
+
+    return dpi ? (uint32_t)dpi : 96u;
+}
+
+// Public API - Capabilities
+
+int darling_has_capability(DarlingCapability cap) {
+    darling_probe_capabilities();
+
+    switch (cap) {
+        case DARLING_CAP_PER_WINDOW_DPI:
+            return g_caps.getDpiForWindow != NULL;
+        case DARLING_CAP_DPI_SCALED_FRAME:
+            return g_caps.adjustWindowRectExForDpi != NULL;
+        case DARLING_CAP_DARK_TITLEBAR:
+            return g_caps.dwmDarkModeAttribute != 0;
+        case DARLING_CAP_TITLEBAR_COLORS:
+            return g_caps.dwmCaptionColor ? 1 : 0;
+        case DARLING_CAP_CORNER_PREFERENCE:
+            return g_caps.dwmCornerPreference ? 1 : 0;
+    }
+
+    return 0;
+}
@@ -11,11 +11,32 @@
 #define DARLING_LOG_PARAMS_SIZE 512
 #define DARLING_WINDOW_CLASS L"DarlingWindowClass"
 
+// Private window messages
+#define DARLING_WM_SETTINGS_REFRESH (WM_APP + 1)
+#define DARLING_WM_LAYERED_PRESENT (WM_APP + 2)
+#define DARLING_WM_POWER_RESUME (WM_APP + 3)
+
+#ifndef WM_DPICHANGED
+#define WM_DPICHANGED 0x02E0
+#endif
+
+#ifndef WM_DPICHANGED_AFTERPARENT
+#define WM_DPICHANGED_AFTERPARENT 0x02E3
+#endif
+
+#ifndef SPI_SETHIGHCONTRAST
+#define SPI_SETHIGHCONTRAST 0x0043
+#endif
+
 // DWM Attributes (for older Windows SDKs)
 #ifndef DWMWA_USE_IMMERSIVE_DARK_MODE
 #define DWMWA_USE_IMMERSIVE_DARK_MODE 20
 #endif
 
+#ifndef DWMWA_USE_IMMERSIVE_DARK_MODE_BEFORE_20H1
+#define DWMWA_USE_IMMERSIVE_DARK_MODE_BEFORE_20H1 19
+#endif
+
 #ifndef DWMWA_CAPTION_COLOR
 #define DWMWA_CAPTION_COLOR 35
 #endif
@@ -28,6 +49,92 @@
 #define DWMWA_WINDOW_CORNER_PREFERENCE 33
 #endif
 
+// Child Layout Tree (platform/common/layout.c)
+#include "../../common/layout.h"
+
+// Hit-Test Index (platform/common/hittest.c)
+#include "../../common/hittest.h"
+
+// Input Ring (platform/common/input.c)
+#include "../../common/input.h"
+
+// Window State Mirror (platform/common/mirror.c)
+#include "../../common/mirror.h"
+
+// Frame Timing (platform/common/timing.c)
+#include "../../common/timing.h"
+
+// Layer Compositor (platform/common/compositor.c)
+#include "../../common/compositor.h"
+
+// Display List (platform/common/displaylist.c)
+#include "../../common/displaylist.h"
+
+// Virtual Surface (platform/common/surface.c)
+#include "../../common/surface.h"
+
+// Power Throttling (platform/common/power.c)
+#include "../../common/power.h"
+
+// Animations (platform/common/anim.c)
+#include "../../common/anim.h"
+
+// Present Mode (platform/common/layered.c)
+#include "../../common/layered.h"
+
+// Worker Threads (utils.c)
+typedef HANDLE DarlingThread;
+
+typedef struct DarlingGate {
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond;
+    volatile int32_t epoch;
+} DarlingGate;
+
+typedef HANDLE DarlingUiSignal;     // auto-reset event
+
+// Frame Thread Pool (platform/common/pool.c)
+#include "../../common/pool.h"
+
+// UI Thread (platform/common/uithread.c)
+#include "../../common/uithread.h"
+
+// Shared Memory (utils.c)
+typedef struct DarlingSharedMemory {
+    void* base;
+    size_t bytes;
+    HANDLE mapping;
+} DarlingSharedMemory;
+
+// Mapped Files (utils.c)
+typedef struct DarlingMappedFile {
+    void* base;
+    size_t bytes;
+} DarlingMappedFile;
+
+// Shared-Memory Frame Ring (platform/common/framering.c)
+#include "../../common/framering.h"
+
+// Thumbnail Pyramid (platform/common/thumbnail.c)
+#include "../../common/thumbnail.h"
+
+// Splash Snapshot (platform/common/snapshot.c)
+#include "../../common/snapshot.h"
+
+#ifndef WM_MOUSEHWHEEL
+#define WM_MOUSEHWHEEL 0x020E
+#endif
+
+#ifndef WM_POINTERUPDATE
+#define WM_POINTERUPDATE 0x0245
+#define WM_POINTERDOWN 0x0246
+#define WM_POINTERUP 0x0247
+#endif
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 // Types
 
 typedef struct DarlingWindow {
@@ -37,27 +144,89 @@ typedef struct DarlingWindow {
     uint32_t bitmapWidth;
     uint32_t bitmapHeight;
     void* dibBits;
-    
+
+    // Backing-store accounting (platform/common/backing.c)
+    uint32_t gdiObjects;
+    uint64_t lastPresent;       // LRU tick of the last present
+    BOOL evicted;
+    void* evictedPixels;        // compressed copy, or NULL if released
+    size_t evictedSize;
+    uint32_t evictedWidth;
+    uint32_t evictedHeight;
+    uint64_t evictionCount;
+
     BOOL isChild;
     BOOL inList;
     BOOL darkMode;
     HWND childHwnd;
 
     HICON customIcon;
+    uint32_t titlebarColor;         // 0xRRGGBB, once set or animated
+    BOOL titlebarColorSet;
+    uint8_t opacity;                // constant alpha, 255 unless set
+
+    uint32_t dpi;
+
+    DarlingLayoutTree layout;
+    DarlingHitIndex hitIndex;
+
+    DarlingInputRing* inputRing;    // caller-owned, NULL when detached
+    DarlingStateMirror* stateMirror;    // caller-owned, NULL when detached
+    BOOL active;                    // from WM_ACTIVATE
+    BOOL trackingMouseLeave;
+
+    DarlingFrameTiming timing;
+    DarlingCompositor compositor;
+    DarlingDisplayList displayList;
+    DarlingSurface surface;
+    DarlingPower power;
+    DarlingAnimator anim;
+    DarlingLayered layered;
+    DarlingFrameRingView frameRing;
+    DarlingThumbnailCache thumbnails;
+    DarlingSplash splash;
+
+    uint32_t appearanceDepth;
+    BOOL frameChangePending;
     
     struct DarlingWindow* prev;
     struct DarlingWindow* next;
 } DarlingWindow;
 
+typedef UINT (WINAPI *DarlingGetDpiForWindowFn)(HWND);
+typedef UINT (WINAPI *DarlingGetDpiForSystemFn)(void);
+typedef BOOL (WINAPI *DarlingAdjustWindowRectExForDpiFn)(LPRECT, DWORD, BOOL, DWORD, UINT);
+typedef BOOL (WINAPI *DarlingGetPointerTypeFn)(UINT32, DWORD*);
+
+typedef struct DarlingCaps {
+    BOOL probed;
+    DWORD osBuild;                  // 0 if unknown
+
+    DarlingGetDpiForWindowFn getDpiForWindow;
+    DarlingGetDpiForSystemFn getDpiForSystem;
+    DarlingAdjustWindowRectExForDpiFn adjustWindowRectExForDpi;
+    DarlingGetPointerTypeFn getPointerType;     // Windows 8+
+
+    DWORD dwmDarkModeAttribute;     // 20, 19 before 20H1, 0 if unsupported
+    BOOL dwmCaptionColor;           // DWMWA_CAPTION_COLOR and DWMWA_TEXT_COLOR
+    BOOL dwmCornerPreference;
+} DarlingCaps;
+
 // Global State (defined in window/core/window_core.c)
 
 extern DarlingWindow* g_main_window;
 extern DarlingWindow* g_window_head;
 extern void (*g_close_callback)(void);
 extern DarlingCloseCallbackHWND g_close_callback_hwnd;
+extern DarlingDpiChangedCallback g_dpi_changed_callback;
 extern BOOL g_class_registered;
 extern CRITICAL_SECTION g_lock;
 extern BOOL g_lock_initialized;
+extern int g_toplevel_count;
+
+// Capability Table (defined in caps.c)
+
+extern DarlingCaps g_caps;
 
 // Internal Function Declarations
 
@@ -71,16 +240,58 @@ void darling_output_debug(const wchar_t* text);
 void darling_log_last_error(const wchar_t* context);
 void darling_log_create_params(uint32_t w, uint32_t h, uintptr_t parent_hwnd, DWORD styles);
 
-// Theme Detection (utils.c)
+// OS Capabilities (caps.c)
+void darling_probe_capabilities(void);
+uint32_t darling_query_window_dpi(HWND hwnd);
+
+// System Settings (utils.c provider, platform/common/settings.c cache)
+#include "../../common/settings.h"
+int darling_read_system_settings(void* ctx, DarlingSystemSettings* out);
+void darling_settings_post_theme(DarlingWindow* win);     // backend: re-theme on the window's own thread
 BOOL darling_is_system_dark_mode(void);
 
 // GDI Resource Management (paint.c)
+typedef enum DarlingPaintSource {
+    DARLING_PAINT_FRAME,            // a frame from the app (or the splash)
+    DARLING_PAINT_DISPLAY_LIST,
+    DARLING_PAINT_SURFACE
+} DarlingPaintSource;
+
 void darling_free_gdi(DarlingWindow* win);
 void darling_handle_paint(DarlingWindow* win, HWND hwnd);
+void darling_layered_present(DarlingWindow* win);
+void darling_resize_backing_store(DarlingWindow* win, uint32_t w, uint32_t h);
+BOOL darling_alloc_backing_store(DarlingWindow* win, uint32_t w, uint32_t h);
+void darling_present_backing_store(DarlingWindow* win);
+void darling_paint_enter(DarlingWindow* win, DarlingPaintSource source);
+BOOL darling_is_window_hidden(DarlingWindow* win);
+
+// Backing-Store Accounting (platform/common/backing.c)
+void darling_backing_account_alloc(DarlingWindow* win, uint32_t gdi_objects);
+void darling_backing_account_free(DarlingWindow* win);
+void darling_backing_touch(DarlingWindow* win);
+void darling_backing_enforce_budget(void);
+void darling_backing_on_shown(DarlingWindow* win);
+void darling_backing_discard(DarlingWindow* win);
 
-// Window List Management (list.c)
+// Frame Kernels (platform/common/frame.c)
+#include "../../common/frame.h"
+
+// YUV Conversion (platform/common/yuv.c)
+#include "../../common/yuv.h"
+void darling_yuv_coeffs(uint32_t matrix, uint32_t range, DarlingYuvCoeffs* out);
+BOOL darling_yuv_frame_ok(const DarlingYuvFrame* frame);
+BOOL darling_yuv_convert(uint8_t* dst, size_t dst_stride, uint32_t dst_w, uint32_t dst_h, const DarlingYuvFrame* frame);
+
+// Thumbnail Pyramid (platform/common/thumbnail.c)
+void darling_thumbnail_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+void darling_thumbnail_sync(DarlingWindow* win);
+void darling_thumbnail_free(DarlingWindow* win);
+
+// Window List Management (platform/common/list.c)
 void darling_list_add(DarlingWindow* win);
 void darling_list_remove(DarlingWindow* win);
+DarlingWindow* darling_list_find(HWND hwnd);
 DarlingWindow* darling_select_new_main_window(void);
 void darling_update_main_on_remove(DarlingWindow* removed);
 
@@ -91,6 +302,123 @@ BOOL darling_register_class(void);
 // Window Appearance (window/appearance/window_appearance.c)
 void darling_set_window_icon_visible(DarlingWindow* win, int visible);
 void darling_cleanup_window_icon(DarlingWindow* win);
+void darling_apply_frame_change(DarlingWindow* win);
+
+// Hit Testing (window/hittest/window_hittest.c)
+void darling_query_client_size(DarlingWindow* win, int32_t* w, int32_t* h);
+BOOL darling_handle_nchittest(DarlingWindow* win, HWND hwnd, LPARAM lp, LRESULT* result);
+void darling_hit_attach_child(DarlingWindow* win, HWND child);
+
+// Input Capture (window/input/window_input.c)
+void darling_handle_input(DarlingWindow* win, HWND hwnd, UINT msg, WPARAM wp, LPARAM lp);
+
+// Frame Timing (platform/common/timing.c)
+void darling_timing_begin(DarlingWindow* win);
+void darling_timing_cancel(DarlingWindow* win);
+void darling_timing_stamp(DarlingWindow* win, DarlingFrameStage stage);
+void darling_timing_paint_start(DarlingWindow* win);
+void darling_timing_presented(DarlingWindow* win);
+BOOL darling_timing_draw_overlay(DarlingWindow* win);
+
+// Layer Compositor (platform/common/compositor.c)
+void darling_compositor_damage(DarlingWindow* win, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+uint8_t* darling_compositor_content(DarlingWindow* win);
+BOOL darling_compositor_flush(DarlingWindow* win);
+void darling_compositor_free(DarlingWindow* win);
+void darling_compositor_invalidate(DarlingWindow* win, const DarlingDamageRect* rect);   // backend
+
+// Display List (platform/common/displaylist.c)
+void darling_draw_refresh(DarlingWindow* win);
+void darling_draw_free(DarlingWindow* win);
+
+// Virtual Surface (platform/common/surface.c)
+void darling_surface_refresh(DarlingWindow* win);
+void darling_surface_free(DarlingWindow* win);
+
+// Power Throttling (platform/common/power.c)
+BOOL darling_power_covered(const DarlingDamageRect* target, const DarlingDamageRect* rects, uint32_t count);
+void darling_power_update(DarlingWindow* win);
+void darling_power_poll(void);
+void darling_power_signal(DarlingWindow* win);
+BOOL darling_power_begin(DarlingWindow* win, DarlingPowerSample* sample);
+void darling_power_end(DarlingWindow* win, const DarlingPowerSample* sample);
+void darling_power_resume(DarlingWindow* win);
+void darling_power_post_resume(DarlingWindow* win);                 // backend: resume on the window's own thread
+DarlingVisibility darling_query_visibility(DarlingWindow* win);     // backend
+
+// Animations (platform/common/anim.c)
+double darling_anim_now(void);
+double darling_anim_ease(uint32_t easing, const float bezier[4], double x);
+void darling_anim_poll(void);
+double darling_anim_wait_ms(void);
+void darling_anim_free(DarlingWindow* win);
+void darling_anim_read(DarlingWindow* win, uint32_t property, int32_t out[2]);     // backend
+void darling_anim_apply(DarlingWindow* win, const DarlingAnimFrame* frame);       // backend
+double darling_anim_refresh_ms(DarlingWindow* win);                                // backend
+void darling_anim_wake(DarlingWindow* win);                                        // backend
+BOOL darling_window_is_local(DarlingWindow* win);                                  // backend: owned by the calling thread
+
+// Present Mode (platform/common/layered.c)
+BOOL darling_layered_active(DarlingWindow* win);
+DarlingPoolOp darling_layered_paint_op(DarlingWindow* win, DarlingPixelFormat format, uint32_t w, uint32_t h);
+BOOL darling_layered_damage(DarlingWindow* win, const DarlingDamageRect* rect);
+BOOL darling_layered_take(DarlingWindow* win, DarlingDamageRect* out);
+void darling_layered_free(DarlingWindow* win);
+void darling_layered_style(DarlingWindow* win, BOOL enable);       // backend
+void darling_layered_schedule(DarlingWindow* win);                 // backend
+
+// Worker Threads (utils.c)
+BOOL darling_thread_start(DarlingThread* thread, void (*fn)(void*), void* arg);
+void darling_thread_join(DarlingThread thread);
+void darling_thread_pin(DarlingThread thread, uint32_t cpu);
+void darling_thread_yield(void);
+double darling_thread_cpu_ms(void);                          // calling thread's CPU time
+uint32_t darling_cpu_count(void);
+void darling_gate_init(DarlingGate* gate);
+void darling_gate_destroy(DarlingGate* gate);
+void darling_gate_wait(DarlingGate* gate, int32_t seen);     // until epoch != seen
+void darling_gate_open(DarlingGate* gate);                   // epoch++, wake all
+
+// Frame Thread Pool (platform/common/pool.c)
+void darling_pool_for_rows(uint32_t rows, size_t row_bytes, DarlingRowFn fn, void* ctx);
+void darling_pool_convert(uint8_t* dst, size_t dst_stride, const uint8_t* src, size_t src_stride, uint32_t w, uint32_t h, DarlingPoolOp op);
+void darling_pool_shutdown(void);
+
+// UI Thread (platform/common/uithread.c)
+void darling_ui_thread_shutdown(void);
+BOOL darling_ui_signal_init(DarlingUiSignal* signal);        // backend
+void darling_ui_signal_destroy(DarlingUiSignal* signal);     // backend
+void darling_ui_signal_raise(DarlingUiSignal* signal);       // backend
+void darling_ui_signal_wait(DarlingUiSignal* signal);        // backend
+
+// Shared Memory (utils.c)
+BOOL darling_shm_create(DarlingSharedMemory* shm, const char* name, size_t bytes);
+void darling_shm_close(DarlingSharedMemory* shm);
+
+// Mapped Files (utils.c)
+BOOL darling_file_map(DarlingMappedFile* file, const char* path, size_t bytes);   // bytes 0: existing file, read only
+void darling_file_unmap(DarlingMappedFile* file);
+BOOL darling_file_replace(const char* from, const char* to);
+
+// Splash Snapshot (platform/common/snapshot.c)
+BOOL darling_splash_begin(DarlingWindow* win, double created_ms);
+void darling_splash_end(DarlingWindow* win);
+void darling_splash_poll(void);
+void darling_splash_free(DarlingWindow* win);
+
+// Shared-Memory Frame Ring (platform/common/framering.c)
+void darling_frame_ring_poll(void);
+void darling_frame_ring_free(DarlingWindow* win);
+
+// Input Ring (platform/common/input.c)
+void darling_input_emit(DarlingWindow* win, uint32_t type, uint32_t modifiers, int32_t x, int32_t y, int32_t code, int32_t value);
+
+// Window State Mirror (platform/common/mirror.c)
+void darling_state_publish(DarlingWindow* win);
+void darling_query_window_state(DarlingWindow* win, DarlingWindowState* out);     // backend
+
+// Appearance Transactions (platform/common/appearance.c)
+void darling_request_frame_change(DarlingWindow* win);
 
 // Theme Application (window/theme/window_theme.c)
 void darling_apply_dark_mode_internal(DarlingWindow* win, BOOL enable);
\ No newline at end of file
@@ -1,5 +1,4 @@
 #include "internal.h"
-#include <string.h>
 
 // GDI Resource Management
 
@@ -8,6 +7,8 @@ void darling_free_gdi(DarlingWindow* win) {
         return;
     }
 
+    darling_backing_account_free(win);
+
     if (win->hdcMem) {
         DeleteDC(win->hdcMem);
         win->hdcMem = NULL;
@@ -28,7 +29,13 @@ void darling_free_gdi(DarlingWindow* win) {
 void darling_handle_paint(DarlingWindow* win, HWND hwnd) {
     PAINTSTRUCT ps;
     HDC hdc = BeginPaint(hwnd, &ps);
-    
+
+    if (win) {
+        darling_timing_paint_start(win);
+        darling_compositor_flush(win);
+        darling_lock();
+    }
+
     if (win && win->hdcMem) {
         int srcLeft = ps.rcPaint.left;
         int srcTop = ps.rcPaint.top;
@@ -72,76 +79,495 @@ void darling_handle_paint(DarlingWindow* win, HWND hwnd) {
                 SRCCOPY
             );
         }
+
+        darling_timing_presented(win);
     }
-    
+
+    if (win) {
+        darling_unlock();
+    }
+
     EndPaint(hwnd, &ps);
 }
 
-// Public API - Window Painting
+// Layered Presents
+// A per-pixel-alpha window has no WM_PAINT: the backing store, already
+// premultiplied, goes to the compositor with UpdateLayeredWindowIndirect,
+// which reads only the dirty rectangle.
 
-void darling_paint_frame_window(DarlingWindow* win, const unsigned char* bgra_data, uint32_t w, uint32_t h) {
-    if (!win || !win->hwnd || !bgra_data || w == 0 || h == 0) {
+void darling_layered_style(DarlingWindow* win, BOOL enable) {
+    LONG exStyle = GetWindowLongW(win->hwnd, GWL_EXSTYLE);
+
+    darling_lock();
+    uint8_t opacity = win->opacity;
+    darling_unlock();
+
+    // Clearing the style first drops whichever kind of layering the window
+    // had: one given SetLayeredWindowAttributes takes no layered updates
+    // until it is made layered afresh. Leaving the mode goes back to the
+    // constant alpha, if any.
+    SetWindowLongW(win->hwnd, GWL_EXSTYLE, exStyle & ~WS_EX_LAYERED);
+    if (enable || opacity < 255) {
+        SetWindowLongW(win->hwnd, GWL_EXSTYLE, exStyle | WS_EX_LAYERED);
+    }
+    if (!enable && opacity < 255) {
+        SetLayeredWindowAttributes(win->hwnd, 0, opacity, LWA_ALPHA);
+    }
+}
+
+void darling_layered_schedule(DarlingWindow* win) {
+    PostMessageW(win->hwnd, DARLING_WM_LAYERED_PRESENT, 0, 0);
+}
+
+void darling_layered_present(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
         return;
     }
 
-    HWND hwnd = win->hwnd;
-    HDC hdc = GetDC(hwnd);
-    if (!hdc) {
+    darling_timing_paint_start(win);
+    darling_compositor_flush(win);
+
+    // The store can be rebuilt or evicted by another thread: hold the lock
+    // from taking the dirty rectangle until the compositor has read it
+    darling_lock();
+
+    DarlingDamageRect dirty;
+    if (!win->hdcMem || !darling_layered_take(win, &dirty)) {
+        darling_unlock();
         return;
     }
 
+    SIZE size = { (LONG)win->bitmapWidth, (LONG)win->bitmapHeight };
+    BLENDFUNCTION blend = { AC_SRC_OVER, 0, win->opacity, AC_SRC_ALPHA };
+    POINT origin = { 0, 0 };
+    RECT rc = { dirty.x0, dirty.y0, dirty.x1, dirty.y1 };
+
+    UPDATELAYEREDWINDOWINFO info;
+    memset(&info, 0, sizeof(info));
+    info.cbSize = sizeof(info);
+    info.psize = &size;
+    info.hdcSrc = win->hdcMem;
+    info.pptSrc = &origin;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = &rc;
+
+    if (!UpdateLayeredWindowIndirect(win->hwnd, &info)) {
+        darling_log_last_error(L"UpdateLayeredWindowIndirect");
+        darling_unlock();
+        return;
+    }
+
+    darling_unlock();
+    darling_timing_presented(win);
+}
+
+// Backing Store
+
+static BOOL darling_ensure_backing_store(DarlingWindow* win, HDC hdc, uint32_t w, uint32_t h) {
+    if (win->hdcMem && win->bitmapWidth == w && win->bitmapHeight == h) {
+        return TRUE;
+    }
+
     // Recreate bitmap if size changed
-    if (!win->hdcMem || win->bitmapWidth != w || win->bitmapHeight != h) {
+    darling_free_gdi(win);
+
+    win->hdcMem = CreateCompatibleDC(hdc);
+    if (!win->hdcMem) {
+        return FALSE;
+    }
+
+    win->bitmapWidth = w;
+    win->bitmapHeight = h;
+
+    BITMAPINFO bmi = {0};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = (LONG)w;
+    bmi.bmiHeader.biHeight = -((LONG)h);  // Top-down
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    void* pBits = NULL;
+    win->hBitmap = CreateDIBSection(win->hdcMem, &bmi, DIB_RGB_COLORS, &pBits, NULL, 0);
+    
+    if (!win->hBitmap || !pBits) {
         darling_free_gdi(win);
+        return FALSE;
+    }
+
+    win->dibBits = pBits;
+    SelectObject(win->hdcMem, win->hBitmap);
+
+    // Memory DC + DIB section
+    darling_backing_account_alloc(win, 2);
+    return TRUE;
+}
+
+BOOL darling_alloc_backing_store(DarlingWindow* win, uint32_t w, uint32_t h) {
+    if (!win || !win->hwnd || !darling_frame_size_ok(w, h)) {
+        return FALSE;
+    }
+
+    HDC hdc = GetDC(win->hwnd);
+    if (!hdc) {
+        return FALSE;
+    }
+
+    BOOL ok = darling_ensure_backing_store(win, hdc, w, h);
+    ReleaseDC(win->hwnd, hdc);
+    return ok;
+}
+
+// Repaint a rectangle (NULL: all) through WM_PAINT; a per-pixel-alpha
+// window gathers it into its dirty rectangle instead
+static void darling_invalidate(DarlingWindow* win, const RECT* rc) {
+    DarlingDamageRect r;
+    if (rc) {
+        r.x0 = rc->left;
+        r.y0 = rc->top;
+        r.x1 = rc->right;
+        r.y1 = rc->bottom;
+    }
+
+    if (!darling_layered_damage(win, rc ? &r : NULL)) {
+        InvalidateRect(win->hwnd, rc, FALSE);
+    }
+}
+
+// The overlay is redrawn on every flush, so it has to reach the screen
+// with each one
+void darling_compositor_invalidate(DarlingWindow* win, const DarlingDamageRect* rect) {
+    if (!win->hwnd) {
+        return;
+    }
+
+    RECT rc = { rect->x0, rect->y0, rect->x1, rect->y1 };
+    darling_invalidate(win, &rc);
+
+    if (win->timing.overlay) {
+        RECT overlay = { 0, 0, (LONG)DARLING_OVERLAY_WIDTH, (LONG)DARLING_OVERLAY_HEIGHT };
+        darling_invalidate(win, &overlay);
+    }
+}
+
+void darling_present_backing_store(DarlingWindow* win) {
+    if (win && win->hwnd) {
+        darling_invalidate(win, NULL);
+    }
+}
+
+// Paint entry: `source` is about to overwrite the backing store. The splash
+// ends, and a display list or surface that drew the store before redraws
+// in full next time.
+void darling_paint_enter(DarlingWindow* win, DarlingPaintSource source) {
+    darling_lock();
+    if (win->splash.showing) {
+        darling_splash_end(win);
+    }
+    if (source != DARLING_PAINT_DISPLAY_LIST) {
+        win->displayList.valid = FALSE;
+    }
+    if (source != DARLING_PAINT_SURFACE) {
+        win->surface.valid = FALSE;
+    }
+    darling_unlock();
+}
+
+// Eviction candidates: hidden (including via a hidden parent) or minimized
+BOOL darling_is_window_hidden(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return TRUE;
+    }
+
+    return !IsWindowVisible(win->hwnd) || IsIconic(win->hwnd);
+}
+
+// The rectangle DWM draws for a window, without the invisible resize borders
+static BOOL darling_visible_bounds(HWND hwnd, DarlingDamageRect* out) {
+    RECT rc;
+    if (FAILED(DwmGetWindowAttribute(hwnd, DWMWA_EXTENDED_FRAME_BOUNDS, &rc, sizeof(rc))) &&
+        !GetWindowRect(hwnd, &rc)) {
+        return FALSE;
+    }
+
+    out->x0 = rc.left;
+    out->y0 = rc.top;
+    out->x1 = rc.right;
+    out->y1 = rc.bottom;
+    return out->x0 < out->x1 && out->y0 < out->y1;
+}
+
+static BOOL darling_is_cloaked(HWND hwnd) {
+    DWORD cloaked = 0;
+    return SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked;
+}
 
-        win->hdcMem = CreateCompatibleDC(hdc);
-        if (!win->hdcMem) {
-            ReleaseDC(hwnd, hdc);
-            return;
+void darling_power_post_resume(DarlingWindow* win) {
+    PostMessageW(win->hwnd, DARLING_WM_POWER_RESUME, 0, 0);
+}
+
+// Hidden (including via a hidden parent), minimized, or occluded: cloaked
+// (another virtual desktop), off the virtual screen, or covered by the
+// opaque top-level windows above its own top-level window. Layered and
+// click-through windows may be see-through and never count as covering.
+DarlingVisibility darling_query_visibility(DarlingWindow* win) {
+    HWND hwnd = win->hwnd;
+    if (!IsWindowVisible(hwnd)) {
+        return DARLING_VISIBILITY_HIDDEN;
+    }
+
+    HWND root = GetAncestor(hwnd, GA_ROOT);
+    root = root ? root : hwnd;
+    if (IsIconic(root)) {
+        return DARLING_VISIBILITY_MINIMIZED;
+    }
+    if (darling_is_cloaked(root)) {
+        return DARLING_VISIBILITY_OCCLUDED;
+    }
+
+    RECT rc;
+    if (!GetWindowRect(hwnd, &rc)) {
+        return DARLING_VISIBILITY_VISIBLE;
+    }
+
+    // Clipped to the virtual screen; nothing left means off every monitor
+    int32_t sx = GetSystemMetrics(SM_XVIRTUALSCREEN);
+    int32_t sy = GetSystemMetrics(SM_YVIRTUALSCREEN);
+    int32_t sr = sx + GetSystemMetrics(SM_CXVIRTUALSCREEN);
+    int32_t sb = sy + GetSystemMetrics(SM_CYVIRTUALSCREEN);
+    DarlingDamageRect target = {
+        rc.left > sx ? rc.left : sx,
+        rc.top > sy ? rc.top : sy,
+        rc.right < sr ? rc.right : sr,
+        rc.bottom < sb ? rc.bottom : sb
+    };
+    if (target.x0 >= target.x1 || target.y0 >= target.y1) {
+        return DARLING_VISIBILITY_OCCLUDED;
+    }
+
+    DarlingDamageRect above[DARLING_POWER_MAX_ABOVE];
+    uint32_t count = 0;
+    for (HWND it = GetWindow(root, GW_HWNDPREV); it && count < DARLING_POWER_MAX_ABOVE; it = GetWindow(it, GW_HWNDPREV)) {
+        LONG_PTR ex = GetWindowLongPtrW(it, GWL_EXSTYLE);
+        if (!IsWindowVisible(it) || IsIconic(it) || (ex & (WS_EX_LAYERED | WS_EX_TRANSPARENT)) || darling_is_cloaked(it)) {
+            continue;
+        }
+        if (darling_visible_bounds(it, &above[count])) {
+            count++;
         }
+    }
+
+    return darling_power_covered(&target, above, count) ? DARLING_VISIBILITY_OCCLUDED : DARLING_VISIBILITY_VISIBLE;
+}
+
+// Reallocate an existing backing store ahead of frames at a new size (DPI
+// change); windows that have never been painted keep allocating lazily.
+void darling_resize_backing_store(DarlingWindow* win, uint32_t w, uint32_t h) {
+    if (!win || !win->hwnd || !win->hdcMem || !darling_frame_size_ok(w, h)) {
+        return;
+    }
+
+    if (win->bitmapWidth == w && win->bitmapHeight == h) {
+        return;
+    }
+
+    darling_alloc_backing_store(win, w, h);
+}
+
+// Window Painting
+// Each paint call copies into the backing store (or the content layer) and
+// invalidates what changed. The public calls wrap these so that every
+// exit past darling_power_begin reaches darling_power_end, and a frame
+// that never reached the store leaves no timing record behind. They hold
+// the lock from finding the store to invalidating it: windows are painted
+// from the JS thread, their own UI thread and producers, and the store can
+// be rebuilt or evicted by any of them.
+
+// Writes a whole w x h frame at dst, w * 4 bytes per row; FALSE if the
+// source could not be converted
+typedef BOOL (*DarlingFrameConvert)(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src);
+
+typedef struct DarlingFramePixels {
+    const unsigned char* data;
+    DarlingPixelFormat format;
+} DarlingFramePixels;
+
+static BOOL darling_convert_pixels(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src) {
+    const DarlingFramePixels* px = (const DarlingFramePixels*)src;
+    DarlingPoolOp op = darling_layered_paint_op(win, px->format, w, h);
+    darling_pool_convert(dst, (size_t)w * 4u, px->data, (size_t)w * 4u, w, h, op);
+    return TRUE;
+}
+
+static BOOL darling_convert_yuv(DarlingWindow* win, uint8_t* dst, uint32_t w, uint32_t h, const void* src) {
+    (void)win;
+    return darling_yuv_convert(dst, (size_t)w * 4u, w, h, (const DarlingYuvFrame*)src);
+}
+
+// FALSE if the backing store could not be had or the frame not converted
+static BOOL darling_paint_whole(DarlingWindow* win, uint32_t w, uint32_t h, DarlingFrameConvert convert, const void* src) {
+    darling_paint_enter(win, DARLING_PAINT_FRAME);
+    darling_timing_begin(win);
+
+    HWND hwnd = win->hwnd;
+    HDC hdc = GetDC(hwnd);
+    if (!hdc) {
+        return FALSE;
+    }
+
+    BOOL ok = darling_ensure_backing_store(win, hdc, w, h);
+    ReleaseDC(hwnd, hdc);
+
+    if (!ok || !win->dibBits) {
+        return FALSE;
+    }
 
-        win->bitmapWidth = w;
-        win->bitmapHeight = h;
-
-        BITMAPINFO bmi = {0};
-        bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        bmi.bmiHeader.biWidth = (LONG)w;
-        bmi.bmiHeader.biHeight = -((LONG)h);  // Top-down
-        bmi.bmiHeader.biPlanes = 1;
-        bmi.bmiHeader.biBitCount = 32;
-        bmi.bmiHeader.biCompression = BI_RGB;
-
-        void* pBits = NULL;
-        win->hBitmap = CreateDIBSection(win->hdcMem, &bmi, DIB_RGB_COLORS, &pBits, NULL, 0);
-        
-        if (!win->hBitmap || !pBits) {
-            darling_free_gdi(win);
-            ReleaseDC(hwnd, hdc);
-            return;
+    // Converted straight into the DIB section or, with layers, the content
+    // layer composited in WM_PAINT
+    uint8_t* content = darling_compositor_content(win);
+    uint8_t* dst = content ? content : (uint8_t*)win->dibBits;
+    if (!convert(win, dst, w, h, src)) {
+        return FALSE;
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+
+    if (content) {
+        darling_compositor_damage(win, 0, 0, (int32_t)w, (int32_t)h);
+    } else {
+        darling_thumbnail_damage(win, 0, 0, (int32_t)w, (int32_t)h);
+        darling_timing_draw_overlay(win);
+        darling_invalidate(win, NULL);
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+    return TRUE;
+}
+
+// The rectangle is inside the backing store
+static void darling_paint_region(
+    DarlingWindow* win,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t w,
+    uint32_t h
+) {
+    darling_paint_enter(win, DARLING_PAINT_FRAME);
+    darling_timing_begin(win);
+
+    uint8_t* content = darling_compositor_content(win);
+    size_t dstStride = (size_t)win->bitmapWidth * 4u;
+    uint8_t* dst = (content ? content : (uint8_t*)win->dibBits) + (size_t)y * dstStride + (size_t)x * 4u;
+
+    DarlingPoolOp op = darling_layered_paint_op(win, DARLING_PIXEL_FORMAT_BGRA8, w, h);
+    darling_pool_convert(dst, dstStride, bgra_data, (size_t)w * 4u, w, h, op);
+    darling_timing_stamp(win, DARLING_STAGE_COPIED);
+
+    if (content) {
+        darling_compositor_damage(win, (int32_t)x, (int32_t)y, (int32_t)(x + w), (int32_t)(y + h));
+    } else {
+        darling_thumbnail_damage(win, (int32_t)x, (int32_t)y, (int32_t)(x + w), (int32_t)(y + h));
+
+        RECT rc = { (LONG)x, (LONG)y, (LONG)(x + w), (LONG)(y + h) };
+        darling_invalidate(win, &rc);
+
+        if (darling_timing_draw_overlay(win)) {
+            RECT overlay = { 0, 0, (LONG)DARLING_OVERLAY_WIDTH, (LONG)DARLING_OVERLAY_HEIGHT };
+            darling_invalidate(win, &overlay);
         }
+    }
+
+    darling_timing_stamp(win, DARLING_STAGE_INVALIDATED);
+    darling_backing_touch(win);
+}
+
+// Public API - Window Painting
 
-        win->dibBits = pBits;
-        SelectObject(win->hdcMem, win->hBitmap);
+void darling_paint_frame_window_format(
+    DarlingWindow* win,
+    const unsigned char* data,
+    uint32_t w,
+    uint32_t h,
+    DarlingPixelFormat format
+) {
+    if (!win || !win->hwnd || !data || !darling_frame_size_ok(w, h)) {
+        return;
     }
 
-    // Update bitmap data
-    if (win->dibBits) {
-        // Check for overflow
-        if (w > SIZE_MAX / h / 4u) {
-            ReleaseDC(hwnd, hdc);
-            return;
+    DarlingFramePixels px = { data, format };
+
+    darling_lock();
+    DarlingPowerSample power;
+    if (darling_power_begin(win, &power)) {
+        if (!darling_paint_whole(win, w, h, darling_convert_pixels, &px)) {
+            darling_timing_cancel(win);
         }
-        
-        size_t size = (size_t)w * (size_t)h * 4u;
-        memcpy(win->dibBits, bgra_data, size);
+        darling_power_end(win, &power);
     }
+    darling_unlock();
+}
 
-    ReleaseDC(hwnd, hdc);
+void darling_paint_frame_window(DarlingWindow* win, const unsigned char* bgra_data, uint32_t w, uint32_t h) {
+    darling_paint_frame_window_format(win, bgra_data, w, h, DARLING_PIXEL_FORMAT_BGRA8);
+}
+
+void darling_paint_yuv_window(DarlingWindow* win, const DarlingYuvFrame* frame, int scale_to_client) {
+    if (!win || !win->hwnd || !darling_yuv_frame_ok(frame)) {
+        return;
+    }
+
+    uint32_t w = frame->width;
+    uint32_t h = frame->height;
+    if (scale_to_client) {
+        int32_t cw = 0;
+        int32_t ch = 0;
+        darling_query_client_size(win, &cw, &ch);
+
+        // A minimized window has no client area; keep the frame's size
+        if (cw > 0 && ch > 0 && darling_frame_size_ok((uint32_t)cw, (uint32_t)ch)) {
+            w = (uint32_t)cw;
+            h = (uint32_t)ch;
+        }
+    }
+
+    darling_lock();
+    DarlingPowerSample power;
+    if (darling_power_begin(win, &power)) {
+        if (!darling_paint_whole(win, w, h, darling_convert_yuv, frame)) {
+            darling_timing_cancel(win);
+        }
+        darling_power_end(win, &power);
+    }
+    darling_unlock();
+}
+
+void darling_paint_frame_window_region(
+    DarlingWindow* win,
+    const unsigned char* bgra_data,
+    uint32_t x,
+    uint32_t y,
+    uint32_t w,
+    uint32_t h
+) {
+    if (!win || !win->hwnd || !bgra_data || w == 0 || h == 0) {
+        return;
+    }
+
+    darling_lock();
+    BOOL inside = win->dibBits && x < win->bitmapWidth && y < win->bitmapHeight &&
+        w <= win->bitmapWidth - x && h <= win->bitmapHeight - y;
 
-    // Trigger repaint
-    InvalidateRect(hwnd, NULL, FALSE);
+    DarlingPowerSample power;
+    if (inside && darling_power_begin(win, &power)) {
+        darling_paint_region(win, bgra_data, x, y, w, h);
+        darling_power_end(win, &power);
+    }
+    darling_unlock();
 }
 
 void darling_paint_frame(const unsigned char* bgra_data, uint32_t w, uint32_t h) {
     darling_paint_frame_window(g_main_window, bgra_data, w, h);
-}
\ No newline at end of file
+}
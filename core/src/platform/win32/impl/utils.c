@@ -1,5 +1,7 @@
 #include "internal.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // Thread Safety
 
@@ -23,6 +25,237 @@ void darling_unlock(void) {
     }
 }
 
+// Worker Threads
+
+typedef struct DarlingThreadStart {
+    void (*fn)(void*);
+    void* arg;
+} DarlingThreadStart;
+
+static DWORD WINAPI darling_thread_main(LPVOID param) {
+    DarlingThreadStart start = *(DarlingThreadStart*)param;
+    free(param);
+    start.fn(start.arg);
+    return 0;
+}
+
+BOOL darling_thread_start(DarlingThread* thread, void (*fn)(void*), void* arg) {
+    DarlingThreadStart* start = (DarlingThreadStart*)malloc(sizeof(DarlingThreadStart));
+    if (!start) {
+        return FALSE;
+    }
+
+    start->fn = fn;
+    start->arg = arg;
+
+    *thread = CreateThread(NULL, 0, darling_thread_main, start, 0, NULL);
+    if (!*thread) {
+        free(start);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void darling_thread_join(DarlingThread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+void darling_thread_pin(DarlingThread thread, uint32_t cpu) {
+    if (cpu < sizeof(DWORD_PTR) * 8u) {
+        SetThreadAffinityMask(thread, (DWORD_PTR)1 << cpu);
+    }
+}
+
+void darling_thread_yield(void) {
+    SwitchToThread();
+}
+
+// Kernel plus user time, in the scheduler's 100 ns units
+double darling_thread_cpu_ms(void) {
+    FILETIME created;
+    FILETIME exited;
+    FILETIME kernel;
+    FILETIME user;
+    if (!GetThreadTimes(GetCurrentThread(), &created, &exited, &kernel, &user)) {
+        return 0.0;
+    }
+
+    uint64_t k = ((uint64_t)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+    uint64_t u = ((uint64_t)user.dwHighDateTime << 32) | user.dwLowDateTime;
+    return (double)(k + u) / 1.0e4;
+}
+
+uint32_t darling_cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (uint32_t)info.dwNumberOfProcessors : 1u;
+}
+
+void darling_gate_init(DarlingGate* gate) {
+    InitializeSRWLock(&gate->lock);
+    InitializeConditionVariable(&gate->cond);
+    gate->epoch = 0;
+}
+
+void darling_gate_destroy(DarlingGate* gate) {
+    // SRW locks and condition variables hold no resources
+    (void)gate;
+}
+
+void darling_gate_wait(DarlingGate* gate, int32_t seen) {
+    AcquireSRWLockExclusive(&gate->lock);
+    while (darling_atomic_load(&gate->epoch) == seen) {
+        SleepConditionVariableSRW(&gate->cond, &gate->lock, INFINITE, 0);
+    }
+    ReleaseSRWLockExclusive(&gate->lock);
+}
+
+void darling_gate_open(DarlingGate* gate) {
+    AcquireSRWLockExclusive(&gate->lock);
+    darling_atomic_add(&gate->epoch, 1);
+    WakeAllConditionVariable(&gate->cond);
+    ReleaseSRWLockExclusive(&gate->lock);
+}
+
+// UI Thread Signal (the wait is with the message loop, window_lifecycle.c)
+
+BOOL darling_ui_signal_init(DarlingUiSignal* signal) {
+    *signal = CreateEventW(NULL, FALSE, FALSE, NULL);
+    return *signal != NULL;
+}
+
+void darling_ui_signal_destroy(DarlingUiSignal* signal) {
+    if (*signal) {
+        CloseHandle(*signal);
+        *signal = NULL;
+    }
+}
+
+void darling_ui_signal_raise(DarlingUiSignal* signal) {
+    SetEvent(*signal);
+}
+
+// Shared Memory
+
+// A pagefile-backed section named "Local\\<name>" (session namespace). The
+// name is checked to be ASCII by the caller. Fails if the name is in use.
+BOOL darling_shm_create(DarlingSharedMemory* shm, const char* name, size_t bytes) {
+    wchar_t objectName[96];
+
+    memset(shm, 0, sizeof(*shm));
+    swprintf_s(objectName, ARRAYSIZE(objectName), L"Local\\%hs", name);
+
+    uint64_t size = (uint64_t)bytes;
+    HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFFu), objectName);
+    if (!mapping) {
+        darling_log_last_error(L"CreateFileMappingW");
+        return FALSE;
+    }
+
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(mapping);
+        return FALSE;
+    }
+
+    void* base = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+    if (!base) {
+        darling_log_last_error(L"MapViewOfFile");
+        CloseHandle(mapping);
+        return FALSE;
+    }
+
+    shm->base = base;
+    shm->bytes = bytes;
+    shm->mapping = mapping;
+    return TRUE;
+}
+
+// The section goes away once producers have closed their handles too
+void darling_shm_close(DarlingSharedMemory* shm) {
+    if (!shm->base) {
+        return;
+    }
+
+    UnmapViewOfFile(shm->base);
+    CloseHandle(shm->mapping);
+    shm->base = NULL;
+    shm->mapping = NULL;
+}
+
+// Mapped Files
+
+static BOOL darling_wide_path(const char* path, wchar_t* out, int capacity) {
+    return MultiByteToWideChar(CP_UTF8, 0, path, -1, out, capacity) > 0;
+}
+
+// With `bytes` 0, map an existing file read only; otherwise create or
+// truncate it to `bytes` and map it writable. The view keeps the file open.
+BOOL darling_file_map(DarlingMappedFile* file, const char* path, size_t bytes) {
+    wchar_t widePath[MAX_PATH];
+
+    memset(file, 0, sizeof(*file));
+    if (!darling_wide_path(path, widePath, MAX_PATH)) {
+        return FALSE;
+    }
+
+    BOOL writable = bytes != 0;
+    HANDLE handle = CreateFileW(widePath, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, writable ? CREATE_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+
+    LARGE_INTEGER size;
+    size.QuadPart = (LONGLONG)bytes;
+    if (!writable && (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0 ||
+                      (uint64_t)size.QuadPart != (size_t)size.QuadPart)) {
+        CloseHandle(handle);
+        return FALSE;
+    }
+
+    HANDLE mapping = CreateFileMappingW(handle, NULL, writable ? PAGE_READWRITE : PAGE_READONLY,
+        (DWORD)((uint64_t)size.QuadPart >> 32), (DWORD)((uint64_t)size.QuadPart & 0xFFFFFFFFu), NULL);
+    CloseHandle(handle);
+    if (!mapping) {
+        darling_log_last_error(L"CreateFileMappingW");
+        return FALSE;
+    }
+
+    void* base = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!base) {
+        darling_log_last_error(L"MapViewOfFile");
+        return FALSE;
+    }
+
+    file->base = base;
+    file->bytes = (size_t)size.QuadPart;
+    return TRUE;
+}
+
+void darling_file_unmap(DarlingMappedFile* file) {
+    if (!file->base) {
+        return;
+    }
+
+    UnmapViewOfFile(file->base);
+    file->base = NULL;
+    file->bytes = 0;
+}
+
+BOOL darling_file_replace(const char* from, const char* to) {
+    wchar_t wideFrom[MAX_PATH];
+    wchar_t wideTo[MAX_PATH];
+
+    if (!darling_wide_path(from, wideFrom, MAX_PATH) || !darling_wide_path(to, wideTo, MAX_PATH)) {
+        return FALSE;
+    }
+    return MoveFileExW(wideFrom, wideTo, MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
 // Logging and Debugging
 
 void darling_output_debug(const wchar_t* text) {
@@ -93,41 +326,58 @@ void darling_log_create_params(uint32_t w, uint32_t h, uintptr_t parent_hwnd, DW
     darling_output_debug(buffer);
 }
 
-// Theme Detection
+// System Settings Provider
 
-BOOL darling_is_system_dark_mode(void) {
+static BOOL darling_read_registry_dword(LPCWSTR path, LPCWSTR name, DWORD* out) {
     DWORD value = 0;
     DWORD size = sizeof(value);
     HKEY key = NULL;
-    BOOL isDark = FALSE;
+    BOOL ok = FALSE;
     
     // Open registry key
-    LONG result = RegOpenKeyExW(
-        HKEY_CURRENT_USER,
-        L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize",
-        0,
-        KEY_READ,
-        &key
-    );
+    LONG result = RegOpenKeyExW(HKEY_CURRENT_USER, path, 0, KEY_READ, &key);
     
     if (result == ERROR_SUCCESS) {
         // Query the value
-        result = RegQueryValueExW(
-            key,
-            L"AppsUseLightTheme",
-            NULL,
-            NULL,
-            (LPBYTE)&value,
-            &size
-        );
+        result = RegQueryValueExW(key, name, NULL, NULL, (LPBYTE)&value, &size);
         
         if (result == ERROR_SUCCESS) {
-            // 0 = Dark mode, 1 = Light mode
-            isDark = (value == 0);
+            *out = value;
+            ok = TRUE;
         }
         
         RegCloseKey(key);
     }
     
-    return isDark;
-}
\ No newline at end of file
+    return ok;
+}
+
+int darling_read_system_settings(void* ctx, DarlingSystemSettings* out) {
+    (void)ctx;
+
+    DWORD value = 0;
+
+    // 0 = Dark mode, 1 = Light mode
+    out->darkMode = darling_read_registry_dword(
+        L"Software\\Microsoft\\Windows\\CurrentVersion\\Themes\\Personalize",
+        L"AppsUseLightTheme",
+        &value
+    ) && value == 0;
+
+    // Stored as 0xAABBGGRR
+    out->accentColor = 0x0078D4;
+    if (darling_read_registry_dword(L"Software\\Microsoft\\Windows\\DWM", L"AccentColor", &value)) {
+        out->accentColor =
+            ((value & 0xFFu) << 16) |
+            (value & 0xFF00u) |
+            ((value >> 16) & 0xFFu);
+    }
+
+    HIGHCONTRASTW hc = {0};
+    hc.cbSize = sizeof(hc);
+    out->highContrast =
+        SystemParametersInfoW(SPI_GETHIGHCONTRAST, sizeof(hc), &hc, 0) &&
+        (hc.dwFlags & HCF_HIGHCONTRASTON) != 0;
+
+    return 1;
+}
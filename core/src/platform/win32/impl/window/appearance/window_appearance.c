@@ -8,40 +8,53 @@ void darling_set_window_title(DarlingWindow* win, const wchar_t* title) {
     SetWindowTextW(win->hwnd, title ? title : L"");
 }
 
+// Recalculate the non-client area and repaint it synchronously
+void darling_apply_frame_change(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    SetWindowPos(
+        win->hwnd, NULL, 0, 0, 0, 0,
+        SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER |
+        SWP_NOACTIVATE | SWP_FRAMECHANGED
+    );
+
+    RedrawWindow(win->hwnd, NULL, NULL, RDW_FRAME | RDW_INVALIDATE | RDW_UPDATENOW);
+}
+
 void darling_set_window_icon_visible(DarlingWindow* win, int visible) {
     if (!win || !win->hwnd) {
         return;
     }
 
     darling_lock();
+    BOOL isChild = win->isChild;
+    darling_unlock();
 
-    if (!win->isChild) {
-        LONG exStyle = GetWindowLongW(win->hwnd, GWL_EXSTYLE);
-        LONG style = GetWindowLongW(win->hwnd, GWL_STYLE);
-
-        if (visible) {
-            exStyle &= ~WS_EX_DLGMODALFRAME;
-            style &= ~(WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX | WS_THICKFRAME);
-            style |= WS_OVERLAPPEDWINDOW;
-        } else {
-            exStyle |= WS_EX_DLGMODALFRAME;
-            style &= ~WS_OVERLAPPEDWINDOW;
-            style |= WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX | WS_THICKFRAME;
-        }
-
-        SetWindowLongW(win->hwnd, GWL_EXSTYLE, exStyle);
-        SetWindowLongW(win->hwnd, GWL_STYLE, style);
+    // Not under the lock: for a window on the UI thread these calls wait for
+    // its window procedure, which may take it
+    if (isChild) {
+        return;
+    }
 
-        SetWindowPos(
-            win->hwnd, NULL, 0, 0, 0, 0,
-            SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER |
-            SWP_NOACTIVATE | SWP_FRAMECHANGED
-        );
+    LONG exStyle = GetWindowLongW(win->hwnd, GWL_EXSTYLE);
+    LONG style = GetWindowLongW(win->hwnd, GWL_STYLE);
 
-        RedrawWindow(win->hwnd, NULL, NULL, RDW_FRAME | RDW_INVALIDATE | RDW_UPDATENOW);
+    if (visible) {
+        exStyle &= ~WS_EX_DLGMODALFRAME;
+        style &= ~(WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX | WS_THICKFRAME);
+        style |= WS_OVERLAPPEDWINDOW;
+    } else {
+        exStyle |= WS_EX_DLGMODALFRAME;
+        style &= ~WS_OVERLAPPEDWINDOW;
+        style |= WS_CAPTION | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX | WS_THICKFRAME;
     }
 
-    darling_unlock();
+    SetWindowLongW(win->hwnd, GWL_EXSTYLE, exStyle);
+    SetWindowLongW(win->hwnd, GWL_STYLE, style);
+
+    darling_request_frame_change(win);
 }
 
 void darling_set_window_opacity(DarlingWindow* win, uint8_t opacity) {
@@ -49,6 +62,16 @@ void darling_set_window_opacity(DarlingWindow* win, uint8_t opacity) {
         return;
     }
 
+    darling_lock();
+    win->opacity = opacity;
+    darling_unlock();
+
+    // A per-pixel-alpha window sends the constant alpha with its next
+    // present
+    if (darling_layered_damage(win, NULL)) {
+        return;
+    }
+
     LONG exStyle = GetWindowLongW(win->hwnd, GWL_EXSTYLE);
 
     if (opacity < 255) {
@@ -86,4 +109,109 @@ void darling_cleanup_window_icon(DarlingWindow* win) {
         DestroyIcon(win->customIcon);
         win->customIcon = NULL;
     }
-}
\ No newline at end of file
+}
+
+// Animations
+
+void darling_anim_read(DarlingWindow* win, uint32_t property, int32_t out[2]) {
+    out[0] = 0;
+    out[1] = 0;
+
+    if (property == DARLING_ANIM_OPACITY) {
+        darling_lock();
+        out[0] = win->opacity;
+        darling_unlock();
+        return;
+    }
+
+    if (property == DARLING_ANIM_TITLEBAR_COLOR) {
+        darling_lock();
+        out[0] = (int32_t)(win->titlebarColorSet ? win->titlebarColor : win->darkMode ? 0x202020u : 0xFFFFFFu);
+        darling_unlock();
+        return;
+    }
+
+    // Child windows are placed in their parent's client coordinates
+    RECT r;
+    if (!GetWindowRect(win->hwnd, &r)) {
+        return;
+    }
+    HWND parent = (GetWindowLongW(win->hwnd, GWL_STYLE) & WS_CHILD) ? GetParent(win->hwnd) : NULL;
+    if (parent) {
+        MapWindowPoints(HWND_DESKTOP, parent, (POINT*)&r, 2);
+    }
+
+    if (property == DARLING_ANIM_POSITION) {
+        out[0] = r.left;
+        out[1] = r.top;
+    } else {
+        out[0] = r.right - r.left;
+        out[1] = r.bottom - r.top;
+    }
+}
+
+// Position and size in one SetWindowPos; the caption color without the
+// frame recalculation darling_set_titlebar_color asks for, since DWM
+// repaints the caption itself
+void darling_anim_apply(DarlingWindow* win, const DarlingAnimFrame* frame) {
+    if (!win->hwnd) {
+        return;
+    }
+
+    if (frame->mask & (1u << DARLING_ANIM_OPACITY)) {
+        darling_set_window_opacity(win, (uint8_t)frame->values[DARLING_ANIM_OPACITY][0]);
+    }
+
+    if (frame->mask & (1u << DARLING_ANIM_TITLEBAR_COLOR)) {
+        uint32_t color = (uint32_t)frame->values[DARLING_ANIM_TITLEBAR_COLOR][0];
+        COLORREF caption = RGB((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+        darling_lock();
+        win->titlebarColor = color;
+        win->titlebarColorSet = TRUE;
+        darling_unlock();
+        if (g_caps.dwmCaptionColor) {
+            DwmSetWindowAttribute(win->hwnd, DWMWA_CAPTION_COLOR, &caption, sizeof(caption));
+        }
+    }
+
+    BOOL move = (frame->mask & (1u << DARLING_ANIM_POSITION)) != 0;
+    BOOL size = (frame->mask & (1u << DARLING_ANIM_SIZE)) != 0;
+    if (move || size) {
+        SetWindowPos(
+            win->hwnd, NULL,
+            frame->values[DARLING_ANIM_POSITION][0], frame->values[DARLING_ANIM_POSITION][1],
+            frame->values[DARLING_ANIM_SIZE][0], frame->values[DARLING_ANIM_SIZE][1],
+            (move ? 0 : SWP_NOMOVE) | (size ? 0 : SWP_NOSIZE) |
+            SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE
+        );
+    }
+}
+
+// The refresh period of the window's monitor (60 Hz if unknown)
+double darling_anim_refresh_ms(DarlingWindow* win) {
+    MONITORINFOEXW info;
+    DEVMODEW mode;
+
+    memset(&info, 0, sizeof(info));
+    memset(&mode, 0, sizeof(mode));
+    info.cbSize = sizeof(info);
+    mode.dmSize = sizeof(mode);
+
+    HMONITOR monitor = MonitorFromWindow(win->hwnd, MONITOR_DEFAULTTONEAREST);
+    if (monitor && GetMonitorInfoW(monitor, (MONITORINFO*)&info) &&
+        EnumDisplaySettingsW(info.szDevice, ENUM_CURRENT_SETTINGS, &mode) && mode.dmDisplayFrequency > 1) {
+        return 1000.0 / (double)mode.dmDisplayFrequency;
+    }
+    return DARLING_ANIM_REFRESH_MS;
+}
+
+// A thread waiting for its windows' messages recomputes its next tick
+void darling_anim_wake(DarlingWindow* win) {
+    if (!darling_window_is_local(win)) {
+        PostMessageW(win->hwnd, WM_NULL, 0, 0);
+    }
+}
+
+BOOL darling_window_is_local(DarlingWindow* win) {
+    return win->hwnd && GetWindowThreadProcessId(win->hwnd, NULL) == GetCurrentThreadId();
+}
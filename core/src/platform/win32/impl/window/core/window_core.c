@@ -7,12 +7,13 @@ DarlingWindow* g_main_window = NULL;
 DarlingWindow* g_window_head = NULL;
 void (*g_close_callback)(void) = NULL;
 DarlingCloseCallbackHWND g_close_callback_hwnd = NULL;
+DarlingDpiChangedCallback g_dpi_changed_callback = NULL;
 
 BOOL g_class_registered = FALSE;
 CRITICAL_SECTION g_lock;
 BOOL g_lock_initialized = FALSE;
 
-static int g_toplevel_count = 0;
+int g_toplevel_count = 0;
 
 static void darling_log(const char* fmt, ...) {
     FILE* f = fopen("C:\\Users\\Public\\darling_debug.log", "a");
@@ -37,6 +38,20 @@ static void darling_handle_size(DarlingWindow* win, HWND hwnd) {
     darling_log("[WM_SIZE] hwnd=%p childHwnd=%p cw=%d ch=%d\n",
         hwnd, win ? win->childHwnd : NULL, cw, ch);
 
+    if (win) {
+        darling_lock();
+        darling_hit_index_resize(&win->hitIndex, cw, ch);
+        darling_unlock();
+    }
+
+    // A layout tree replaces the single-child stretch
+    if (win && win->layout.count > 0) {
+        if (cw > 0 && ch > 0) {
+            darling_layout_apply(win);
+        }
+        return;
+    }
+
     if (win && win->childHwnd && cw > 0 && ch > 0) {
         BOOL ok = SetWindowPos(
             win->childHwnd,
@@ -52,6 +67,40 @@ static void darling_handle_size(DarlingWindow* win, HWND hwnd) {
     }
 }
 
+// Refresh the cached DPI, apply the system-suggested rect for top-level
+// windows, and resize the backing store before the next frame arrives at
+// the new scale.
+static void darling_handle_dpi_changed(DarlingWindow* win, HWND hwnd, uint32_t dpi, const RECT* suggested) {
+    darling_log("[WM_DPICHANGED] hwnd=%p dpi=%u\n", hwnd, dpi);
+
+    if (win) {
+        win->dpi = dpi;
+    }
+
+    if (suggested) {
+        SetWindowPos(
+            hwnd,
+            NULL,
+            suggested->left,
+            suggested->top,
+            suggested->right - suggested->left,
+            suggested->bottom - suggested->top,
+            SWP_NOZORDER | SWP_NOACTIVATE
+        );
+    }
+
+    RECT rc;
+    if (win && GetClientRect(hwnd, &rc)) {
+        darling_resize_backing_store(win, (uint32_t)(rc.right - rc.left), (uint32_t)(rc.bottom - rc.top));
+    }
+
+    darling_state_publish(win);
+
+    if (g_dpi_changed_callback) {
+        g_dpi_changed_callback((uintptr_t)hwnd, dpi);
+    }
+}
+
 LRESULT CALLBACK darling_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
     DarlingWindow* win = (DarlingWindow*)GetWindowLongPtrW(hwnd, GWLP_USERDATA);
 
@@ -72,6 +121,21 @@ LRESULT CALLBACK darling_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
         case WM_ERASEBKGND:
             return 1;
 
+        case WM_NCHITTEST: {
+            LRESULT hit;
+            if (darling_handle_nchittest(win, hwnd, lp, &hit)) {
+                return hit;
+            }
+            break;
+        }
+
+        case WM_ACTIVATE:
+            if (win) {
+                win->active = LOWORD(wp) != WA_INACTIVE;
+                darling_state_publish(win);
+            }
+            break;
+
         case WM_SETFOCUS:
             if (win && win->childHwnd) {
                 SetFocus(win->childHwnd);
@@ -79,11 +143,35 @@ LRESULT CALLBACK darling_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
             return 0;
 
         case WM_LBUTTONDOWN:
+            darling_handle_input(win, hwnd, msg, wp, lp);
             if (win && win->childHwnd) {
                 SetFocus(win->childHwnd);
             }
             return 0;
 
+        // Captured into the input ring, then processed as usual
+        case WM_MOUSEMOVE:
+        case WM_MOUSELEAVE:
+        case WM_LBUTTONUP:
+        case WM_RBUTTONDOWN:
+        case WM_RBUTTONUP:
+        case WM_MBUTTONDOWN:
+        case WM_MBUTTONUP:
+        case WM_XBUTTONDOWN:
+        case WM_XBUTTONUP:
+        case WM_MOUSEWHEEL:
+        case WM_MOUSEHWHEEL:
+        case WM_KEYDOWN:
+        case WM_KEYUP:
+        case WM_SYSKEYDOWN:
+        case WM_SYSKEYUP:
+        case WM_CHAR:
+        case WM_POINTERDOWN:
+        case WM_POINTERUPDATE:
+        case WM_POINTERUP:
+            darling_handle_input(win, hwnd, msg, wp, lp);
+            break;
+
         case WM_PAINT:
             darling_handle_paint(win, hwnd);
             return 0;
@@ -100,19 +188,81 @@ LRESULT CALLBACK darling_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
             return 0;
 
         case WM_SIZE:
+            if (wp == SIZE_MINIMIZED) {
+                darling_backing_enforce_budget();
+            } else {
+                darling_backing_on_shown(win);
+            }
             darling_handle_size(win, hwnd);
+            if (wp != SIZE_MINIMIZED) {
+                darling_surface_refresh(win);
+            }
+            darling_power_update(win);
+            darling_state_publish(win);
             return 0;
 
+        case WM_WINDOWPOSCHANGED: {
+            // Sent after the change, so visibility queries see the new state
+            const WINDOWPOS* pos = (const WINDOWPOS*)lp;
+            if (win && pos) {
+                if (pos->flags & SWP_HIDEWINDOW) {
+                    darling_backing_enforce_budget();
+                } else if (pos->flags & SWP_SHOWWINDOW) {
+                    darling_backing_on_shown(win);
+                }
+            }
+            // Covers moves and show/hide, which send no WM_SIZE; a move
+            // can also cover or uncover the window
+            darling_power_update(win);
+            darling_state_publish(win);
+            // DefWindowProc still has to generate WM_SIZE and WM_MOVE
+            break;
+        }
+
         case WM_SETTINGCHANGE: {
-            if (lp && lstrcmpW((LPCWSTR)lp, L"ImmersiveColorSet") == 0) {
-                if (win && !win->isChild) {
-                    BOOL isDark = darling_is_system_dark_mode();
-                    darling_apply_dark_mode_internal(win, isDark);
+            BOOL colorSet = lp && lstrcmpW((LPCWSTR)lp, L"ImmersiveColorSet") == 0;
+
+            if (colorSet || wp == SPI_SETHIGHCONTRAST) {
+                // The broadcast reaches every top-level window; only the first
+                // one schedules a single refresh that updates all windows.
+                if (darling_settings_notify_change()) {
+                    if (!PostMessageW(hwnd, DARLING_WM_SETTINGS_REFRESH, 0, 0)) {
+                        darling_settings_refresh();
+                    }
                 }
             }
             return 0;
         }
 
+        case WM_DPICHANGED:
+            // Top-level windows: the new DPI is in HIWORD (equal to LOWORD)
+            darling_handle_dpi_changed(win, hwnd, (uint32_t)HIWORD(wp), (const RECT*)lp);
+            return 0;
+
+        case WM_DPICHANGED_AFTERPARENT:
+            // Child windows follow their parent and carry no DPI in the message
+            darling_handle_dpi_changed(win, hwnd, darling_query_window_dpi(hwnd), NULL);
+            return 0;
+
+        case DARLING_WM_SETTINGS_REFRESH:
+            // Non-zero: another thread's refresh re-themes this window
+            if (wp) {
+                darling_apply_dark_mode_internal(win, darling_is_system_dark_mode());
+            } else {
+                darling_settings_refresh();
+            }
+            return 0;
+
+        case DARLING_WM_LAYERED_PRESENT:
+            darling_layered_present(win);
+            return 0;
+
+        case DARLING_WM_POWER_RESUME:
+            if (win) {
+                darling_power_resume(win);
+            }
+            return 0;
+
         case WM_DESTROY: {
             BOOL isChild = FALSE;
 
@@ -142,6 +292,8 @@ LRESULT CALLBACK darling_wnd_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
             if (win) {
                 win->hwnd = NULL;
                 win->childHwnd = NULL;
+                win->active = FALSE;
+                darling_state_publish(win);
 
                 if (win->inList) {
                     darling_list_remove(win);
@@ -2,7 +2,9 @@
 #include <stdlib.h>
 
 DarlingWindow* darling_create_window(uint32_t w, uint32_t h, uintptr_t parent_hwnd) {
+    double createdMs = darling_input_now();
     darling_ensure_lock();
+    darling_probe_capabilities();
 
     if (!darling_register_class()) {
         return NULL;
@@ -67,6 +69,8 @@ DarlingWindow* darling_create_window(uint32_t w, uint32_t h, uintptr_t parent_hw
     }
 
     win->hwnd = hwnd;
+    win->dpi = darling_query_window_dpi(hwnd);
+    win->opacity = 255;
     darling_list_add(win);
 
     darling_lock();
@@ -75,7 +79,8 @@ DarlingWindow* darling_create_window(uint32_t w, uint32_t h, uintptr_t parent_hw
     }
     darling_unlock();
 
-    if (!win->isChild) {
+    // A splash snapshot brings its own theme
+    if (!win->isChild && !darling_splash_begin(win, createdMs)) {
         BOOL isDark = darling_is_system_dark_mode();
         darling_apply_dark_mode_internal(win, isDark);
     }
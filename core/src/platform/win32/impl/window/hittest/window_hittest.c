@@ -0,0 +1,126 @@
+#include "../../internal.h"
+
+// Hit Testing
+// The region index lives in platform/common/hittest.c. The host answers
+// WM_NCHITTEST from it; embedded children that cover the titlebar are
+// subclassed so points over a non-client region fall through to the host.
+
+#define DARLING_HIT_PREV_PROC_PROP L"DarlingHitPrevProc"
+#define DARLING_HIT_HOST_PROP L"DarlingHitHost"
+
+void darling_query_client_size(DarlingWindow* win, int32_t* w, int32_t* h) {
+    RECT rc;
+
+    if (win && win->hwnd && GetClientRect(win->hwnd, &rc)) {
+        *w = (int32_t)(rc.right - rc.left);
+        *h = (int32_t)(rc.bottom - rc.top);
+    } else {
+        *w = 0;
+        *h = 0;
+    }
+}
+
+static LRESULT darling_hit_kind_to_ht(int32_t kind) {
+    switch (kind) {
+        case DARLING_HIT_CAPTION:      return HTCAPTION;
+        case DARLING_HIT_MINIMIZE:     return HTMINBUTTON;
+        case DARLING_HIT_MAXIMIZE:     return HTMAXBUTTON;
+        case DARLING_HIT_CLOSE:        return HTCLOSE;
+        case DARLING_HIT_LEFT:         return HTLEFT;
+        case DARLING_HIT_RIGHT:        return HTRIGHT;
+        case DARLING_HIT_TOP:          return HTTOP;
+        case DARLING_HIT_BOTTOM:       return HTBOTTOM;
+        case DARLING_HIT_TOP_LEFT:     return HTTOPLEFT;
+        case DARLING_HIT_TOP_RIGHT:    return HTTOPRIGHT;
+        case DARLING_HIT_BOTTOM_LEFT:  return HTBOTTOMLEFT;
+        case DARLING_HIT_BOTTOM_RIGHT: return HTBOTTOMRIGHT;
+        default:                       return HTCLIENT;
+    }
+}
+
+// Region kind under a WM_NCHITTEST point (screen coordinates in `lp`)
+static int32_t darling_hit_kind_at(DarlingWindow* win, HWND host, LPARAM lp) {
+    POINT pt = { (LONG)(short)LOWORD(lp), (LONG)(short)HIWORD(lp) };
+    if (!ScreenToClient(host, &pt)) {
+        return DARLING_HIT_NONE;
+    }
+
+    darling_lock();
+    int32_t kind = darling_hit_index_query(&win->hitIndex, (int32_t)pt.x, (int32_t)pt.y);
+    darling_unlock();
+
+    return kind;
+}
+
+BOOL darling_handle_nchittest(DarlingWindow* win, HWND hwnd, LPARAM lp, LRESULT* result) {
+    if (!win || win->hitIndex.live == 0) {
+        return FALSE;
+    }
+
+    int32_t kind = darling_hit_kind_at(win, hwnd, lp);
+    if (kind == DARLING_HIT_NONE) {
+        return FALSE;
+    }
+
+    *result = darling_hit_kind_to_ht(kind);
+    return TRUE;
+}
+
+static LRESULT CALLBACK darling_hit_child_proc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    WNDPROC prev = (WNDPROC)GetPropW(hwnd, DARLING_HIT_PREV_PROC_PROP);
+
+    if (msg == WM_NCHITTEST) {
+        HWND host = (HWND)GetPropW(hwnd, DARLING_HIT_HOST_PROP);
+
+        // The child may have been reparented since it was attached
+        if (host && GetParent(hwnd) == host) {
+            DarlingWindow* win = (DarlingWindow*)GetWindowLongPtrW(host, GWLP_USERDATA);
+            if (win && win->hitIndex.live > 0) {
+                int32_t kind = darling_hit_kind_at(win, host, lp);
+                if (kind != DARLING_HIT_NONE && kind != DARLING_HIT_CLIENT) {
+                    // Same-thread windows underneath, i.e. the host, get the test
+                    return HTTRANSPARENT;
+                }
+            }
+        }
+    } else if (msg == WM_NCDESTROY) {
+        SetWindowLongPtrW(hwnd, GWLP_WNDPROC, (LONG_PTR)prev);
+        RemovePropW(hwnd, DARLING_HIT_PREV_PROC_PROP);
+        RemovePropW(hwnd, DARLING_HIT_HOST_PROP);
+    }
+
+    return prev ? CallWindowProcW(prev, hwnd, msg, wp, lp) : DefWindowProcW(hwnd, msg, wp, lp);
+}
+
+// HTTRANSPARENT only reaches windows of the host's thread, so children
+// owned by other threads are left alone; what matters is the thread that
+// owns the host, not the one attaching. A host on its own UI thread with
+// the main-thread BrowserWindow parented under it (SetParent attaches the
+// two threads' input queues) is such a case: the child keeps its titlebar
+// points. Attaching twice only updates the host.
+void darling_hit_attach_child(DarlingWindow* win, HWND child) {
+    if (!win || !win->hwnd || !child || !IsWindow(child)) {
+        return;
+    }
+
+    if (GetWindowThreadProcessId(child, NULL) != GetWindowThreadProcessId(win->hwnd, NULL)) {
+        return;
+    }
+
+    SetPropW(child, DARLING_HIT_HOST_PROP, (HANDLE)win->hwnd);
+
+    if (GetPropW(child, DARLING_HIT_PREV_PROC_PROP)) {
+        return;
+    }
+
+    WNDPROC prev = (WNDPROC)GetWindowLongPtrW(child, GWLP_WNDPROC);
+    if (!prev || prev == darling_hit_child_proc) {
+        return;
+    }
+
+    SetPropW(child, DARLING_HIT_PREV_PROC_PROP, (HANDLE)prev);
+    if (!SetWindowLongPtrW(child, GWLP_WNDPROC, (LONG_PTR)darling_hit_child_proc)) {
+        darling_log_last_error(L"SetWindowLongPtrW(GWLP_WNDPROC)");
+        RemovePropW(child, DARLING_HIT_PREV_PROC_PROP);
+    }
+}
@@ -0,0 +1,158 @@
+#include "../../internal.h"
+
+// Input Capture
+// Translates mouse, wheel, keyboard and pointer (touch/pen) messages into
+// events for the window's input ring (platform/common/input.c). Messages
+// keep their default processing; capture only records them.
+
+#define DARLING_PT_MOUSE 4
+#define DARLING_MI_WP_SIGNATURE_MASK 0xFFFFFF00u
+#define DARLING_MI_WP_SIGNATURE 0xFF515700u   // mouse message promoted from touch/pen
+
+double darling_input_now(void) {
+    static LARGE_INTEGER frequency = {0};
+    LARGE_INTEGER now;
+
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)frequency.QuadPart;
+}
+
+// GetKeyState reflects the state when the current message was posted
+static uint32_t darling_input_modifiers(void) {
+    uint32_t mods = 0;
+
+    if (GetKeyState(VK_SHIFT) < 0)    mods |= DARLING_INPUT_MOD_SHIFT;
+    if (GetKeyState(VK_CONTROL) < 0)  mods |= DARLING_INPUT_MOD_CTRL;
+    if (GetKeyState(VK_MENU) < 0)     mods |= DARLING_INPUT_MOD_ALT;
+    if (GetKeyState(VK_LWIN) < 0 || GetKeyState(VK_RWIN) < 0) mods |= DARLING_INPUT_MOD_META;
+    if (GetKeyState(VK_LBUTTON) < 0)  mods |= DARLING_INPUT_BUTTON_LEFT;
+    if (GetKeyState(VK_RBUTTON) < 0)  mods |= DARLING_INPUT_BUTTON_RIGHT;
+    if (GetKeyState(VK_MBUTTON) < 0)  mods |= DARLING_INPUT_BUTTON_MIDDLE;
+
+    return mods;
+}
+
+static uint32_t darling_input_mouse_modifiers(void) {
+    uint32_t mods = darling_input_modifiers();
+
+    if (((uint32_t)GetMessageExtraInfo() & DARLING_MI_WP_SIGNATURE_MASK) == DARLING_MI_WP_SIGNATURE) {
+        mods |= DARLING_INPUT_FROM_TOUCH;
+    }
+
+    return mods;
+}
+
+static void darling_input_mouse(DarlingWindow* win, uint32_t type, LPARAM lp, int32_t code) {
+    darling_input_emit(win, type, darling_input_mouse_modifiers(),
+        (int32_t)(short)LOWORD(lp), (int32_t)(short)HIWORD(lp), code, 0);
+}
+
+// Wheel and pointer messages carry screen coordinates
+static void darling_input_screen_point(HWND hwnd, LPARAM lp, POINT* pt) {
+    pt->x = (LONG)(short)LOWORD(lp);
+    pt->y = (LONG)(short)HIWORD(lp);
+    ScreenToClient(hwnd, pt);
+}
+
+// Ask for WM_MOUSELEAVE once the pointer is over the window
+static void darling_input_track_leave(DarlingWindow* win, HWND hwnd) {
+    if (win->trackingMouseLeave) {
+        return;
+    }
+
+    TRACKMOUSEEVENT tme = {0};
+    tme.cbSize = sizeof(tme);
+    tme.dwFlags = TME_LEAVE;
+    tme.hwndTrack = hwnd;
+    win->trackingMouseLeave = TrackMouseEvent(&tme);
+}
+
+void darling_handle_input(DarlingWindow* win, HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
+    if (!win || !win->inputRing) {
+        return;
+    }
+
+    switch (msg) {
+        case WM_MOUSEMOVE:
+            darling_input_track_leave(win, hwnd);
+            darling_input_mouse(win, DARLING_INPUT_MOUSE_MOVE, lp, 0);
+            return;
+
+        case WM_MOUSELEAVE:
+            win->trackingMouseLeave = FALSE;
+            darling_input_emit(win, DARLING_INPUT_MOUSE_LEAVE, darling_input_modifiers(), 0, 0, 0, 0);
+            return;
+
+        case WM_LBUTTONDOWN: darling_input_mouse(win, DARLING_INPUT_MOUSE_DOWN, lp, 0); return;
+        case WM_LBUTTONUP:   darling_input_mouse(win, DARLING_INPUT_MOUSE_UP, lp, 0); return;
+        case WM_RBUTTONDOWN: darling_input_mouse(win, DARLING_INPUT_MOUSE_DOWN, lp, 1); return;
+        case WM_RBUTTONUP:   darling_input_mouse(win, DARLING_INPUT_MOUSE_UP, lp, 1); return;
+        case WM_MBUTTONDOWN: darling_input_mouse(win, DARLING_INPUT_MOUSE_DOWN, lp, 2); return;
+        case WM_MBUTTONUP:   darling_input_mouse(win, DARLING_INPUT_MOUSE_UP, lp, 2); return;
+
+        case WM_XBUTTONDOWN:
+        case WM_XBUTTONUP:
+            darling_input_mouse(win,
+                msg == WM_XBUTTONDOWN ? DARLING_INPUT_MOUSE_DOWN : DARLING_INPUT_MOUSE_UP,
+                lp, HIWORD(wp) == XBUTTON2 ? 4 : 3);
+            return;
+
+        case WM_MOUSEWHEEL:
+        case WM_MOUSEHWHEEL: {
+            POINT pt;
+            darling_input_screen_point(hwnd, lp, &pt);
+            darling_input_emit(win,
+                msg == WM_MOUSEWHEEL ? DARLING_INPUT_WHEEL : DARLING_INPUT_HWHEEL,
+                darling_input_mouse_modifiers(),
+                (int32_t)pt.x, (int32_t)pt.y, 0, (int32_t)(short)HIWORD(wp));
+            return;
+        }
+
+        case WM_KEYDOWN:
+        case WM_SYSKEYDOWN:
+        case WM_KEYUP:
+        case WM_SYSKEYUP: {
+            BOOL down = msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN;
+            uint32_t mods = darling_input_modifiers();
+
+            // Bit 30: the key was already down (auto-repeat)
+            if (down && (lp & 0x40000000)) {
+                mods |= DARLING_INPUT_KEY_REPEAT;
+            }
+
+            // Scan code with the extended-key bit (bits 16-24)
+            darling_input_emit(win, down ? DARLING_INPUT_KEY_DOWN : DARLING_INPUT_KEY_UP,
+                mods, 0, 0, (int32_t)wp, (int32_t)((lp >> 16) & 0x1FF));
+            return;
+        }
+
+        case WM_CHAR:
+            darling_input_emit(win, DARLING_INPUT_CHAR, darling_input_modifiers(), 0, 0, (int32_t)wp, 0);
+            return;
+
+        case WM_POINTERDOWN:
+        case WM_POINTERUPDATE:
+        case WM_POINTERUP: {
+            UINT32 id = (UINT32)LOWORD(wp);
+            DWORD pointerType = 0;
+
+            // Mouse pointers also arrive as WM_MOUSE* messages
+            if (g_caps.getPointerType && g_caps.getPointerType(id, &pointerType) && pointerType == DARLING_PT_MOUSE) {
+                return;
+            }
+
+            uint32_t type = msg == WM_POINTERDOWN ? DARLING_INPUT_TOUCH_DOWN
+                          : msg == WM_POINTERUP   ? DARLING_INPUT_TOUCH_UP
+                                                  : DARLING_INPUT_TOUCH_MOVE;
+            POINT pt;
+            darling_input_screen_point(hwnd, lp, &pt);
+            darling_input_emit(win, type, darling_input_modifiers(),
+                (int32_t)pt.x, (int32_t)pt.y, (int32_t)id, (int32_t)pointerType);
+            return;
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "../../internal.h"
+#include <stdlib.h>
+
+// Child Layout
+// The tree itself lives in platform/common/layout.c; this applies computed
+// rects to the child HWNDs.
+
+static UINT darling_layout_leaf_flags(const DarlingLayoutNode* node) {
+    UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+
+    if (node->visible) {
+        flags |= SWP_SHOWWINDOW;
+    } else {
+        flags |= SWP_HIDEWINDOW | SWP_NOMOVE | SWP_NOSIZE;
+    }
+
+    return flags;
+}
+
+// A pending leaf, copied out of the tree under the lock. Positioning
+// sends messages to the child's thread, so it runs after unlocking.
+typedef struct DarlingLayoutMove {
+    HWND child;
+    DarlingLayoutRect rect;
+    UINT flags;
+    BOOL attach;            // first placement of this child
+} DarlingLayoutMove;
+
+static void darling_layout_set_leaf_pos(const DarlingLayoutMove* move) {
+    SetWindowPos(
+        move->child,
+        NULL,
+        move->rect.x, move->rect.y, move->rect.w, move->rect.h,
+        move->flags
+    );
+}
+
+static void darling_layout_take(DarlingLayoutNode* node, DarlingLayoutMove* move) {
+    move->child = (HWND)node->child;
+    move->rect = node->rect;
+    move->flags = darling_layout_leaf_flags(node);
+    move->attach = !node->applied;
+
+    node->appliedRect = node->rect;
+    node->appliedVisible = node->visible;
+    node->applied = 1;
+}
+
+static BOOL darling_layout_is_pending(const DarlingLayoutNode* node) {
+    return node->kind == DARLING_LAYOUT_NODE_LEAF && node->child && darling_layout_leaf_dirty(node);
+}
+
+void darling_layout_apply(DarlingWindow* win) {
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    RECT rc;
+    if (!GetClientRect(win->hwnd, &rc)) {
+        return;
+    }
+
+    darling_lock();
+
+    DarlingLayoutTree* tree = &win->layout;
+    if (tree->count == 0) {
+        darling_unlock();
+        return;
+    }
+
+    darling_layout_compute(tree, (int32_t)(rc.right - rc.left), (int32_t)(rc.bottom - rc.top));
+
+    int pending = 0;
+    for (uint32_t i = 0; i < tree->count; i++) {
+        if (darling_layout_is_pending(&tree->nodes[i])) {
+            pending++;
+        }
+    }
+
+    DarlingLayoutMove* moves = pending ? (DarlingLayoutMove*)malloc((size_t)pending * sizeof(DarlingLayoutMove)) : NULL;
+    if (!moves) {
+        darling_unlock();
+        return;
+    }
+
+    // Taken as applied now: every move below lands, in the batch or directly
+    int count = 0;
+    for (uint32_t i = 0; i < tree->count; i++) {
+        if (darling_layout_is_pending(&tree->nodes[i])) {
+            darling_layout_take(&tree->nodes[i], &moves[count++]);
+        }
+    }
+
+    darling_unlock();
+
+    // One deferred batch: all children move in a single update, with no
+    // intermediate frames where siblings overlap
+    HDWP hdwp = BeginDeferWindowPos(count);
+
+    for (int i = 0; i < count && hdwp; i++) {
+        const DarlingLayoutMove* move = &moves[i];
+        hdwp = DeferWindowPos(
+            hdwp,
+            move->child,
+            NULL,
+            move->rect.x, move->rect.y, move->rect.w, move->rect.h,
+            move->flags
+        );
+    }
+
+    if (!hdwp || !EndDeferWindowPos(hdwp)) {
+        // A failed DeferWindowPos discards the whole batch; position directly
+        darling_log_last_error(L"DeferWindowPos");
+
+        for (int i = 0; i < count; i++) {
+            darling_layout_set_leaf_pos(&moves[i]);
+        }
+    }
+
+    // First placement of a child: let titlebar regions fall through it
+    for (int i = 0; i < count; i++) {
+        if (moves[i].attach) {
+            darling_hit_attach_child(win, moves[i].child);
+        }
+    }
+
+    free(moves);
+}
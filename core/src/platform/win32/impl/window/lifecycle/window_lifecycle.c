@@ -1,5 +1,6 @@
 #include "../../internal.h"
 #include <stdlib.h>
+#include <string.h>
 
 void darling_show_window(DarlingWindow* win) {
     if (win && win->hwnd) {
@@ -38,6 +39,33 @@ int darling_is_focused(DarlingWindow* win) {
     return GetForegroundWindow() == win->hwnd ? 1 : 0;
 }
 
+void darling_query_window_state(DarlingWindow* win, DarlingWindowState* out) {
+    memset(out, 0, sizeof(*out));
+    if (!win || !win->hwnd) {
+        return;
+    }
+
+    HWND hwnd = win->hwnd;
+    out->flags = (IsWindowVisible(hwnd) ? DARLING_STATE_VISIBLE : 0) |
+        (win->active ? DARLING_STATE_FOCUSED : 0) |
+        (IsIconic(hwnd) ? DARLING_STATE_MINIMIZED : 0) |
+        (IsZoomed(hwnd) ? DARLING_STATE_MAXIMIZED : 0) |
+        (win->darkMode ? DARLING_STATE_DARK : 0);
+    out->dpi = win->dpi ? win->dpi : 96;
+
+    RECT rc;
+    if (GetClientRect(hwnd, &rc)) {
+        out->clientWidth = (int32_t)(rc.right - rc.left);
+        out->clientHeight = (int32_t)(rc.bottom - rc.top);
+    }
+    if (GetWindowRect(hwnd, &rc)) {
+        out->x = (int32_t)rc.left;
+        out->y = (int32_t)rc.top;
+        out->width = (int32_t)(rc.right - rc.left);
+        out->height = (int32_t)(rc.bottom - rc.top);
+    }
+}
+
 void darling_destroy_window(DarlingWindow* win) {
     if (!win) {
         return;
@@ -63,7 +91,18 @@ void darling_destroy_window(DarlingWindow* win) {
     }
 
     darling_cleanup_window_icon(win);
+    darling_backing_discard(win);
     darling_free_gdi(win);
+    darling_layout_tree_free(&win->layout);
+    darling_hit_index_free(&win->hitIndex);
+    darling_compositor_free(win);
+    darling_frame_ring_free(win);
+    darling_thumbnail_free(win);
+    darling_splash_free(win);
+    darling_draw_free(win);
+    darling_surface_free(win);
+    darling_anim_free(win);
+    darling_layered_free(win);
     free(win);
 
     if (hwnd) {
@@ -79,6 +118,8 @@ void darling_set_child_hwnd(DarlingWindow* win, uintptr_t child_hwnd) {
     darling_lock();
     win->childHwnd = (HWND)(uintptr_t)child_hwnd;
     darling_unlock();
+
+    darling_hit_attach_child(win, (HWND)(uintptr_t)child_hwnd);
 }
 
 uintptr_t darling_get_main_hwnd(void) {
@@ -105,9 +146,18 @@ void darling_set_close_callback_hwnd(DarlingCloseCallbackHWND callback) {
     g_close_callback_hwnd = callback;
 }
 
+void darling_set_dpi_changed_callback(DarlingDpiChangedCallback callback) {
+    g_dpi_changed_callback = callback;
+}
+
 void darling_poll_events(void) {
     MSG msg;
 
+    darling_frame_ring_poll();
+    darling_splash_poll();
+    darling_power_poll();
+    darling_anim_poll();
+
     while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
         if (msg.message == WM_QUIT) {
             PostQuitMessage((int)msg.wParam);
@@ -115,17 +165,7 @@ void darling_poll_events(void) {
         }
 
         // dispatch HWND in Darling window list
-        BOOL isDarlingMsg = FALSE;
-        darling_lock();
-        DarlingWindow* cur = g_window_head;
-        while (cur) {
-            if (cur->hwnd == msg.hwnd || cur->childHwnd == msg.hwnd) {
-                isDarlingMsg = TRUE;
-                break;
-            }
-            cur = cur->next;
-        }
-        darling_unlock();
+        BOOL isDarlingMsg = darling_list_find(msg.hwnd) != NULL;
 
         if (isDarlingMsg || msg.hwnd == NULL) {
             TranslateMessage(&msg);
@@ -134,11 +174,63 @@ void darling_poll_events(void) {
     }
 }
 
+// Wakes the UI thread for its windows' animation ticks. High resolution
+// where available (Windows 10 1803+): a plain wait rounds up to the 15.6 ms
+// system tick, which would skip refreshes.
+static HANDLE g_anim_timer = NULL;
+
+// Wait for the UI thread's signal, dispatching the messages of the windows
+// it owns and ticking their animations meanwhile
+void darling_ui_signal_wait(DarlingUiSignal* signal) {
+    if (!g_anim_timer) {
+        g_anim_timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        g_anim_timer = g_anim_timer ? g_anim_timer : CreateWaitableTimerW(NULL, FALSE, NULL);
+    }
+
+    for (;;) {
+        MSG msg;
+        while (PeekMessageW(&msg, NULL, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+
+        darling_anim_poll();
+
+        HANDLE handles[2] = { *signal, g_anim_timer };
+        DWORD count = 1;
+        DWORD timeout = INFINITE;
+        double wait = darling_anim_wait_ms();
+        if (wait >= 0.0 && g_anim_timer) {
+            LARGE_INTEGER due;
+            due.QuadPart = -(LONGLONG)(wait * 10000.0) - 1;    // relative, 100 ns units
+            SetWaitableTimer(g_anim_timer, &due, 0, NULL, NULL, FALSE);
+            count = 2;
+        } else if (wait >= 0.0) {
+            timeout = (DWORD)wait + 1u;
+        }
+
+        // A message, the timer or the timeout goes round again
+        DWORD r = MsgWaitForMultipleObjectsEx(count, handles, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        if (r == WAIT_OBJECT_0 || r == WAIT_FAILED) {
+            return;     // signalled, or the wait failed
+        }
+    }
+}
+
 void darling_init(void) {
     darling_ensure_lock();
+    darling_probe_capabilities();
 }
 
 void darling_cleanup(void) {
+    darling_ui_thread_shutdown();
+    darling_pool_shutdown();
+
+    if (g_anim_timer) {
+        CloseHandle(g_anim_timer);
+        g_anim_timer = NULL;
+    }
+
     if (g_class_registered) {
         UnregisterClassW(DARLING_WINDOW_CLASS, GetModuleHandleW(NULL));
         g_class_registered = FALSE;
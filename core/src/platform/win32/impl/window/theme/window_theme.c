@@ -5,34 +5,27 @@ void darling_apply_dark_mode_internal(DarlingWindow* win, BOOL enable) {
         return;
     }
 
+    win->darkMode = enable;
+    darling_state_publish(win);
+
+    if (!g_caps.dwmDarkModeAttribute) {
+        return;
+    }
+
     BOOL value = enable;
     DwmSetWindowAttribute(
         win->hwnd,
-        DWMWA_USE_IMMERSIVE_DARK_MODE,
+        g_caps.dwmDarkModeAttribute,
         &value,
         sizeof(value)
     );
 
-    win->darkMode = enable;
-
-    SetWindowPos(
-        win->hwnd,
-        NULL,
-        0,
-        0,
-        0,
-        0,
-        SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED
-    );
+    darling_request_frame_change(win);
+}
 
-    RedrawWindow(
-        win->hwnd,
-        NULL,
-        NULL,
-        RDW_FRAME |
-        RDW_INVALIDATE |
-        RDW_UPDATENOW
-    );
+// Handled as DARLING_WM_SETTINGS_REFRESH with a non-zero wParam
+void darling_settings_post_theme(DarlingWindow* win) {
+    PostMessageW(win->hwnd, DARLING_WM_SETTINGS_REFRESH, 1, 0);
 }
 
 int darling_is_dark_mode(void) {
@@ -57,10 +50,13 @@ void darling_set_auto_dark_mode(DarlingWindow* win) {
 }
 
 void darling_set_titlebar_colors(DarlingWindow* win, uint32_t bg_color, uint32_t text_color) {
-    if (!win || !win->hwnd) {
+    if (!win || !win->hwnd || !g_caps.dwmCaptionColor) {
         return;
     }
 
+    win->titlebarColor = bg_color >> 8;
+    win->titlebarColorSet = TRUE;
+
     COLORREF bgColorRef = RGB(
         (bg_color >> 0) & 0xFF,
         (bg_color >> 8) & 0xFF,
@@ -87,31 +83,17 @@ void darling_set_titlebar_colors(DarlingWindow* win, uint32_t bg_color, uint32_t
         sizeof(textColorRef)
     );
 
-    SetWindowPos(
-        win->hwnd,
-        NULL,
-        0,
-        0,
-        0,
-        0,
-        SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED
-    );
-
-    RedrawWindow(
-        win->hwnd,
-        NULL,
-        NULL,
-        RDW_FRAME |
-        RDW_INVALIDATE |
-        RDW_UPDATENOW
-    );
+    darling_request_frame_change(win);
 }
 
 void darling_set_titlebar_color(DarlingWindow* win, uint32_t color) {
-    if (!win || !win->hwnd) {
+    if (!win || !win->hwnd || !g_caps.dwmCaptionColor) {
         return;
     }
 
+    win->titlebarColor = color & 0xFFFFFFu;
+    win->titlebarColorSet = TRUE;
+
     COLORREF titlebarColor = RGB(
         (color >> 16) & 0xFF,
         (color >> 8) & 0xFF,
@@ -125,21 +107,11 @@ void darling_set_titlebar_color(DarlingWindow* win, uint32_t color) {
         sizeof(titlebarColor)
     );
 
-    SetWindowPos(
-        win->hwnd,
-        NULL,
-        0,
-        0,
-        0,
-        0,
-        SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED
-    );
-
-    RedrawWindow(win->hwnd, NULL, NULL, RDW_FRAME | RDW_INVALIDATE | RDW_UPDATENOW);
+    darling_request_frame_change(win);
 }
 
 void darling_set_corner_preference(DarlingWindow* win, DarlingCornerPreference pref) {
-    if (!win || !win->hwnd) {
+    if (!win || !win->hwnd || !g_caps.dwmCornerPreference) {
         return;
     }
 
@@ -174,21 +146,7 @@ uint32_t darling_get_dpi(DarlingWindow* win) {
         return 96;
     }
 
-    HMODULE user32 = GetModuleHandleW(L"user32.dll");
-    if (!user32) {
-        return 96;
-    }
-
-    typedef UINT (WINAPI *DarlingGetDpiForWindowFn)(HWND);
-
-    DarlingGetDpiForWindowFn getDpiForWindow =
-        (DarlingGetDpiForWindowFn)GetProcAddress(user32, "GetDpiForWindow");
-
-    if (!getDpiForWindow) {
-        return 96;
-    }
-
-    return (uint32_t)getDpiForWindow(win->hwnd);
+    return win->dpi ? win->dpi : 96;
 }
 
 float darling_get_scale_factor(DarlingWindow* win) {
@@ -2,10 +2,35 @@
 
 // Include all implementation files
 #include "impl/utils.c"
-#include "impl/list.c"
+#include "impl/caps.c"
+#include "../common/frame.c"
+#include "../common/list.c"
 #include "impl/paint.c"
 #include "impl/window/core/window_core.c"
 #include "impl/window/creation/window_creation.c"
 #include "impl/window/lifecycle/window_lifecycle.c"
+#include "impl/window/layout/window_layout.c"
+#include "impl/window/hittest/window_hittest.c"
+#include "impl/window/input/window_input.c"
 #include "impl/window/appearance/window_appearance.c"
-#include "impl/window/theme/window_theme.c"
\ No newline at end of file
+#include "impl/window/theme/window_theme.c"
+#include "../common/appearance.c"
+#include "../common/layout.c"
+#include "../common/hittest.c"
+#include "../common/settings.c"
+#include "../common/backing.c"
+#include "../common/input.c"
+#include "../common/timing.c"
+#include "../common/compositor.c"
+#include "../common/displaylist.c"
+#include "../common/surface.c"
+#include "../common/pool.c"
+#include "../common/framering.c"
+#include "../common/yuv.c"
+#include "../common/thumbnail.c"
+#include "../common/mirror.c"
+#include "../common/uithread.c"
+#include "../common/snapshot.c"
+#include "../common/power.c"
+#include "../common/anim.c"
+#include "../common/layered.c"
@@ -0,0 +1,326 @@
+// Frame producer SDK. Standalone: built into darling_producer so producer
+// processes do not link the window library. See darling_producer.h for the
+// ring layout and slot protocol.
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "darling_producer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sequentially consistent atomics on the shared 32-bit words
+#if defined(__GNUC__) || defined(__clang__)
+#define producer_load(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define producer_store(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define producer_add(p, v) __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define producer_cas(p, expected, desired) __sync_bool_compare_and_swap((p), (expected), (desired))
+#else
+#define producer_load(p) ((uint32_t)InterlockedCompareExchange((volatile LONG*)(p), 0, 0))
+#define producer_store(p, v) InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+#define producer_add(p, v) InterlockedExchangeAdd((volatile LONG*)(p), (LONG)(v))
+#define producer_cas(p, expected, desired) \
+    (InterlockedCompareExchange((volatile LONG*)(p), (LONG)(desired), (LONG)(expected)) == (LONG)(expected))
+#endif
+
+struct DarlingProducer {
+    DarlingFrameRingHeader* header;
+    size_t bytes;
+    int32_t claimed;                // slot being written, -1 if none
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+};
+
+// Names are portable object names: letters, digits, '.', '_' and '-'
+static int producer_name_valid(const char* name) {
+    size_t len = name ? strlen(name) : 0;
+    if (len == 0 || len > DARLING_FRAME_RING_NAME_MAX) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+              c == '.' || c == '_' || c == '-')) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static uint8_t* producer_slot_pixels(DarlingProducer* p, uint32_t slot) {
+    return (uint8_t*)p->header + p->header->headerBytes + (size_t)p->header->slotBytes * slot;
+}
+
+static void producer_yield(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+// Mapping
+
+#ifdef _WIN32
+
+static void* producer_map(DarlingProducer* p, const char* name) {
+    char objectName[DARLING_FRAME_RING_NAME_MAX + 8];
+    snprintf(objectName, sizeof(objectName), "Local\\%s", name);
+
+    p->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, objectName);
+    if (!p->mapping) {
+        return NULL;
+    }
+
+    void* base = MapViewOfFile(p->mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (!base || !VirtualQuery(base, &info, sizeof(info))) {
+        if (base) {
+            UnmapViewOfFile(base);
+        }
+        CloseHandle(p->mapping);
+        p->mapping = NULL;
+        return NULL;
+    }
+
+    p->bytes = info.RegionSize;
+    return base;
+}
+
+static void producer_unmap(DarlingProducer* p) {
+    UnmapViewOfFile(p->header);
+    CloseHandle(p->mapping);
+}
+
+#else
+
+static void* producer_map(DarlingProducer* p, const char* name) {
+    char objectName[DARLING_FRAME_RING_NAME_MAX + 2];
+    snprintf(objectName, sizeof(objectName), "/%s", name);
+
+    int fd = shm_open(objectName, O_RDWR, 0);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+    void* base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(DarlingFrameRingHeader)) {
+        p->bytes = (size_t)st.st_size;
+        base = mmap(NULL, p->bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    // The mapping keeps the object alive
+    close(fd);
+    return base == MAP_FAILED ? NULL : base;
+}
+
+static void producer_unmap(DarlingProducer* p) {
+    munmap(p->header, p->bytes);
+}
+
+#endif
+
+// Public API
+
+DarlingProducer* darling_producer_open(const char* name) {
+    if (!producer_name_valid(name)) {
+        return NULL;
+    }
+
+    DarlingProducer* p = (DarlingProducer*)calloc(1, sizeof(DarlingProducer));
+    if (!p) {
+        return NULL;
+    }
+
+    p->header = (DarlingFrameRingHeader*)producer_map(p, name);
+    p->claimed = -1;
+
+    DarlingFrameRingHeader* h = p->header;
+    if (!h) {
+        free(p);
+        return NULL;
+    }
+
+    uint64_t needed = (uint64_t)h->headerBytes + h->slotBytes * h->slotCount;
+    if (h->magic != DARLING_FRAME_RING_MAGIC || h->version != DARLING_FRAME_RING_VERSION ||
+        h->slotCount < DARLING_FRAME_RING_MIN_SLOTS || h->slotCount > DARLING_FRAME_RING_MAX_SLOTS ||
+        h->headerBytes < sizeof(DarlingFrameRingHeader) ||
+        h->slotBytes < (uint64_t)h->maxWidth * h->maxHeight * 4u || needed > p->bytes) {
+        producer_unmap(p);
+        free(p);
+        return NULL;
+    }
+
+    // A slot left WRITING belonged to a producer that exited mid-frame
+    for (uint32_t i = 0; i < h->slotCount; i++) {
+        producer_cas(&h->slots[i].state, DARLING_FRAME_SLOT_WRITING, DARLING_FRAME_SLOT_FREE);
+    }
+
+    return p;
+}
+
+void darling_producer_close(DarlingProducer* p) {
+    if (!p) {
+        return;
+    }
+
+    if (p->claimed >= 0) {
+        producer_store(&p->header->slots[p->claimed].state, DARLING_FRAME_SLOT_FREE);
+    }
+
+    producer_unmap(p);
+    free(p);
+}
+
+void darling_producer_get_size(DarlingProducer* p, uint32_t* max_width, uint32_t* max_height) {
+    if (max_width) {
+        *max_width = p ? p->header->maxWidth : 0;
+    }
+    if (max_height) {
+        *max_height = p ? p->header->maxHeight : 0;
+    }
+}
+
+uint8_t* darling_producer_begin(DarlingProducer* p, uint32_t width, uint32_t height) {
+    if (!p || width == 0 || height == 0) {
+        return NULL;
+    }
+
+    DarlingFrameRingHeader* h = p->header;
+    if (width > h->maxWidth || height > h->maxHeight || producer_load(&h->closed)) {
+        return NULL;
+    }
+
+    if (p->claimed >= 0) {
+        h->slots[p->claimed].width = width;
+        h->slots[p->claimed].height = height;
+        return producer_slot_pixels(p, (uint32_t)p->claimed);
+    }
+
+    // Darling holds at most one slot and we hold none, so with three or more
+    // slots a FREE or non-newest READY one turns up within a few passes
+    for (;;) {
+        for (uint32_t i = 0; i < h->slotCount; i++) {
+            if (producer_cas(&h->slots[i].state, DARLING_FRAME_SLOT_FREE, DARLING_FRAME_SLOT_WRITING)) {
+                p->claimed = (int32_t)i;
+                break;
+            }
+        }
+
+        if (p->claimed < 0) {
+            // Darling is behind: overwrite the oldest frame it has not taken
+            int32_t oldest = -1;
+            for (uint32_t i = 0; i < h->slotCount; i++) {
+                if (producer_load(&h->slots[i].state) == DARLING_FRAME_SLOT_READY &&
+                    (oldest < 0 || (int32_t)(h->slots[i].seq - h->slots[oldest].seq) < 0)) {
+                    oldest = (int32_t)i;
+                }
+            }
+
+            if (oldest >= 0 &&
+                producer_cas(&h->slots[oldest].state, DARLING_FRAME_SLOT_READY, DARLING_FRAME_SLOT_WRITING)) {
+                producer_add(&h->dropped, 1);
+                p->claimed = oldest;
+            }
+        }
+
+        if (p->claimed >= 0) {
+            break;
+        }
+        producer_yield();
+    }
+
+    h->slots[p->claimed].width = width;
+    h->slots[p->claimed].height = height;
+    return producer_slot_pixels(p, (uint32_t)p->claimed);
+}
+
+uint32_t darling_producer_commit(DarlingProducer* p, uint32_t format, double submit_ms) {
+    if (!p || p->claimed < 0) {
+        return 0;
+    }
+
+    DarlingFrameRingHeader* h = p->header;
+    DarlingFrameSlot* slot = &h->slots[p->claimed];
+
+    // 0 means "nothing presented yet", so it is skipped on wrap
+    uint32_t seq = h->published + 1u;
+    if (seq == 0) {
+        seq = 1;
+    }
+
+    slot->format = format;
+    slot->submitMs = submit_ms > 0.0 ? submit_ms : darling_producer_now();
+    slot->seq = seq;
+    producer_store(&slot->state, DARLING_FRAME_SLOT_READY);
+    producer_store(&h->published, seq);
+
+    p->claimed = -1;
+    return seq;
+}
+
+uint32_t darling_producer_write(
+    DarlingProducer* p,
+    const uint8_t* pixels,
+    uint32_t width,
+    uint32_t height,
+    uint32_t format
+) {
+    if (!pixels) {
+        return 0;
+    }
+
+    uint8_t* dst = darling_producer_begin(p, width, height);
+    if (!dst) {
+        return 0;
+    }
+
+    memcpy(dst, pixels, (size_t)width * height * 4u);
+    return darling_producer_commit(p, format, 0.0);
+}
+
+uint32_t darling_producer_dropped(DarlingProducer* p) {
+    return p ? producer_load(&p->header->dropped) : 0;
+}
+
+int darling_producer_closed(DarlingProducer* p) {
+    return p ? producer_load(&p->header->closed) != 0 : 1;
+}
+
+int darling_producer_throttled(DarlingProducer* p, uint32_t* rate) {
+    uint32_t throttled = p ? producer_load(&p->header->throttled) : 0;
+    if (rate) {
+        *rate = throttled ? producer_load(&p->header->rate) : 0;
+    }
+    return throttled != 0;
+}
+
+double darling_producer_now(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart * 1000.0 / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1.0e6;
+#endif
+}
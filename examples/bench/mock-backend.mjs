@@ -0,0 +1,69 @@
+// In-memory stand-in for the native addon.
+// Lets the native-side phases of the startup benchmark (create, style/parent)
+// run under plain Node on machines without Win32, e.g. Linux CI. It measures
+// harness + bridge overhead only; real Win32 costs need the native backend.
+
+let nextHandle = 1
+
+export function createMockBackend() {
+    const windows = new Map()
+    const calls = Object.create(null)
+
+    const count = (name) => {
+        calls[name] = (calls[name] || 0) + 1
+    }
+
+    return {
+        calls,
+
+        createWindow(width, height, parent = 0) {
+            count('createWindow')
+            const handle = { id: nextHandle++, width, height, parent, style: 0, visible: false, child: 0n }
+            windows.set(handle.id, handle)
+            return handle
+        },
+
+        destroyWindow(win) {
+            count('destroyWindow')
+            if (win) windows.delete(win.id)
+        },
+
+        showDarlingWindow(win) {
+            count('showDarlingWindow')
+            win.visible = true
+        },
+
+        getWindowHWND(win) {
+            count('getWindowHWND')
+            return BigInt(win.id)
+        },
+
+        getHWND() {
+            count('getHWND')
+            const first = windows.values().next().value
+            return first ? BigInt(first.id) : 0n
+        },
+
+        setParent(child, parent) {
+            count('setParent')
+            return child !== 0n && parent !== 0n
+        },
+
+        setWindowStyles(hwnd, add, remove) {
+            count('setWindowStyles')
+            const win = windows.get(Number(hwnd))
+            if (win) win.style = (win.style | add) & ~remove
+            return true
+        },
+
+        setWindowPos() {
+            count('setWindowPos')
+            return true
+        },
+
+        setChildWindow(win, childHwnd) {
+            count('setChildWindow')
+            win.child = BigInt(childHwnd)
+        }
+    }
+}
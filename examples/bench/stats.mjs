@@ -0,0 +1,117 @@
+// Small statistics helpers for the startup benchmark (no dependencies)
+
+// Deterministic PRNG so bootstrap intervals are reproducible between runs
+function mulberry32(seed) {
+    let a = seed >>> 0
+    return () => {
+        a = (a + 0x6D2B79F5) >>> 0
+        let t = a
+        t = Math.imul(t ^ (t >>> 15), t | 1)
+        t ^= t + Math.imul(t ^ (t >>> 7), t | 61)
+        return ((t ^ (t >>> 14)) >>> 0) / 4294967296
+    }
+}
+
+// Linear-interpolated percentile of an ascending-sorted array (p in [0, 100])
+export function percentile(sorted, p) {
+    if (sorted.length === 0) return NaN
+    if (sorted.length === 1) return sorted[0]
+
+    const rank = (p / 100) * (sorted.length - 1)
+    const lo = Math.floor(rank)
+    const hi = Math.ceil(rank)
+    const frac = rank - lo
+
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * frac
+}
+
+// Percentile bootstrap confidence interval for a percentile estimator
+export function bootstrapCI(samples, p, { resamples = 2000, confidence = 0.95, seed = 0x5EED } = {}) {
+    if (samples.length < 2) {
+        const v = samples.length ? samples[0] : NaN
+        return [v, v]
+    }
+
+    const rand = mulberry32(seed)
+    const n = samples.length
+    const estimates = new Float64Array(resamples)
+    const scratch = new Float64Array(n)
+
+    for (let r = 0; r < resamples; r++) {
+        for (let i = 0; i < n; i++) {
+            scratch[i] = samples[(rand() * n) | 0]
+        }
+        scratch.sort()
+        estimates[r] = percentile(scratch, p)
+    }
+
+    estimates.sort()
+    const alpha = (1 - confidence) / 2
+    return [
+        percentile(estimates, alpha * 100),
+        percentile(estimates, (1 - alpha) * 100)
+    ]
+}
+
+// Summarize raw samples (ms) into the fields written to the JSON report
+export function summarize(samples, options = {}) {
+    const sorted = Float64Array.from(samples).sort()
+    const n = sorted.length
+    const mean = n ? sorted.reduce((a, b) => a + b, 0) / n : NaN
+    const variance = n > 1
+        ? sorted.reduce((a, b) => a + (b - mean) * (b - mean), 0) / (n - 1)
+        : 0
+
+    return {
+        n,
+        mean,
+        stdev: Math.sqrt(variance),
+        min: n ? sorted[0] : NaN,
+        max: n ? sorted[n - 1] : NaN,
+        median: percentile(sorted, 50),
+        p95: percentile(sorted, 95),
+        p99: percentile(sorted, 99),
+        ci95: {
+            median: bootstrapCI(samples, 50, options),
+            p95: bootstrapCI(samples, 95, options),
+            p99: bootstrapCI(samples, 99, options)
+        },
+        samples: Array.from(samples)
+    }
+}
+
+// Compare a report against a baseline report.
+// A phase regresses when the lower bound of its median CI is above the
+// baseline median by more than `threshold` (fraction, e.g. 0.1 = 10%).
+export function compareReports(current, baseline, threshold = 0.1) {
+    const rows = []
+
+    for (const [suiteName, suite] of Object.entries(current.suites)) {
+        const baseSuite = baseline.suites?.[suiteName]
+        if (!baseSuite) continue
+
+        for (const [phase, stats] of Object.entries(suite.phases)) {
+            const base = baseSuite.phases?.[phase]
+            if (!base) continue
+
+            const delta = (stats.median - base.median) / base.median
+            const regressed = stats.ci95.median[0] > base.median * (1 + threshold)
+            const improved = stats.ci95.median[1] < base.median * (1 - threshold)
+
+            rows.push({
+                suite: suiteName,
+                phase,
+                baselineMedian: base.median,
+                median: stats.median,
+                deltaPct: delta * 100,
+                status: regressed ? 'regressed' : improved ? 'improved' : 'unchanged'
+            })
+        }
+    }
+
+    return {
+        threshold,
+        rows,
+        regressions: rows.filter((r) => r.status === 'regressed').length
+    }
+}
@@ -1,96 +1,285 @@
-import { app, BrowserWindow } from 'electron'
 import { createRequire } from 'module'
+import { readFileSync, writeFileSync } from 'fs'
+import os from 'os'
+import { summarize, compareReports } from './bench/stats.mjs'
+import { createMockBackend } from './bench/mock-backend.mjs'
+
 const require = createRequire(import.meta.url)
-const darling = require('../js/darling-bridge.cjs')
+
+/*
+    Startup benchmark: Darling embed vs. plain Electron.
+
+    Electron (Windows, native addon):
+        npx electron ./examples/startup-benchmark.mjs --iterations 30 --out bench.json
+
+    Node (any OS, mock backend, native-side phases only):
+        node ./examples/startup-benchmark.mjs --backend mock --iterations 200
+
+    Options:
+        --warmup <n>        untimed iterations before sampling (default 3)
+        --iterations <n>    timed iterations per suite (default 20)
+        --url <url>         page loaded by the BrowserWindow (default about:blank)
+        --backend <name>    native | mock (default: native under Electron, mock under Node)
+        --out <file>        write the JSON report to <file>
+        --baseline <file>   compare against a previous JSON report
+        --threshold <pct>   regression threshold for the median in percent (default 10)
+
+    Exit code is 1 when any phase regresses against the baseline.
+*/
+
+function parseArgs(argv) {
+    const opts = {
+        warmup: 3,
+        iterations: 20,
+        url: 'about:blank',
+        backend: null,
+        out: null,
+        baseline: null,
+        threshold: 10
+    }
+
+    for (let i = 0; i < argv.length; i++) {
+        const key = argv[i]
+        if (!key.startsWith('--')) continue
+
+        const name = key.slice(2)
+        const value = argv[i + 1]
+        if (!(name in opts) || value === undefined) continue
+
+        i++
+        opts[name] = typeof opts[name] === 'number' ? Number(value) : value
+    }
+
+    return opts
+}
 
 function now() { return performance.now() }
 
-async function benchmarkDarling() {
-    const results = {}
-    const w = 800, h = 600
+// Win32 constants used while embedding
+const WS_CHILD = 0x40000000
+const WS_POPUP = 0x80000000
+const WS_OVERLAPPEDWINDOW = 0x00CF0000
+const SWP_NOZORDER = 0x0004
+const SWP_FRAMECHANGED = 0x0020
+
+const W = 800
+const H = 600
+
+// Native-side phases shared by both backends
+function runNativePhases(darling, phases, childHwnd) {
+    let t = now()
+    const dwin = darling.createWindow(W, H)
+    darling.showDarlingWindow(dwin)
+    const hostHwnd = BigInt(darling.getWindowHWND(dwin))
+    phases.nativeCreate = now() - t
+
+    t = now()
+    darling.setParent(childHwnd, hostHwnd)
+    darling.setWindowStyles(childHwnd, WS_CHILD, WS_POPUP | WS_OVERLAPPEDWINDOW)
+    darling.setWindowPos(childHwnd, 0, 0, W, H, SWP_NOZORDER | SWP_FRAMECHANGED)
+    darling.setChildWindow(dwin, childHwnd)
+    phases.styleParent = now() - t
 
+    return dwin
+}
+
+async function showAndWait(bw) {
+    await new Promise((resolve) => {
+        bw.once('show', resolve)
+        bw.show()
+    })
+}
+
+async function iterateDarlingElectron(darling, BrowserWindow, url) {
+    const phases = {}
     const t0 = now()
-    // measure Darling native window creation
-    const tCreateStart = now()
-    const dwin = darling.createWindow(w, h)
-    const tCreateEnd = now()
-    results.darlingCreateMs = tCreateEnd - tCreateStart
-
-    try { darling.showDarlingWindow(dwin) } catch (e) { }
-
-    // now create BrowserWindow and reparent
-    const tEmbedStart = now()
-    const bw = new BrowserWindow({ width: w, height: h, show: false })
-    const buf = bw.getNativeWindowHandle()
-    const eleHWND = Number(buf.readBigUInt64LE(0))
-
-    // set styles + parent + pos
-    const WS_CHILD = 0x40000000
-    const WS_POPUP = 0x80000000
-    const SWP_SHOWWINDOW = 0x0040
-    try {
-        darling.setWindowStyles(eleHWND, WS_CHILD, WS_POPUP)
-        const dariHWND = darling.getHWND()
-        darling.setParent(eleHWND, dariHWND)
-        darling.setWindowPos(eleHWND, 0, 0, w, h, SWP_SHOWWINDOW)
-    } catch (e) {
-        console.warn('embed ops failed', e)
-    }
 
-    await bw.loadURL('about:blank')
-    bw.show()
-    const tEmbedEnd = now()
+    // BrowserWindow first so the native phases have a child HWND to embed
+    let t = now()
+    const bw = new BrowserWindow({ width: W, height: H, show: false, frame: false })
+    phases.browserCreate = now() - t
+
+    const eleHWND = BigInt.asUintN(64, bw.getNativeWindowHandle().readBigUInt64LE(0))
+    const dwin = runNativePhases(darling, phases, eleHWND)
+
+    t = now()
+    await bw.loadURL(url)
+    phases.loadURL = now() - t
+
+    t = now()
+    await showAndWait(bw)
+    phases.firstShow = now() - t
+
+    phases.total = now() - t0
+
+    bw.destroy()
+    darling.destroyWindow(dwin)
+    darling.pollEvents()
+    return phases
+}
+
+async function iteratePlainElectron(BrowserWindow, url) {
+    const phases = {}
+    const t0 = now()
+
+    let t = now()
+    const bw = new BrowserWindow({ width: W, height: H, show: false })
+    phases.browserCreate = now() - t
+
+    t = now()
+    await bw.loadURL(url)
+    phases.loadURL = now() - t
+
+    t = now()
+    await showAndWait(bw)
+    phases.firstShow = now() - t
 
-    results.embedMs = tEmbedEnd - tEmbedStart
-    results.totalMs = tEmbedEnd - t0
-    // clean up
-    bw.close()
-    return results
+    phases.total = now() - t0
+
+    bw.destroy()
+    return phases
 }
 
-async function benchmarkPlain() {
-    const results = {}
-    const w = 800, h = 600
+async function iterateDarlingMock(darling) {
+    const phases = {}
     const t0 = now()
-    const tCreateStart = now()
-    const bw = new BrowserWindow({ width: w, height: h, show: false })
-    const tCreateEnd = now()
-    results.browserCreateMs = tCreateEnd - tCreateStart
-
-    const tLoadStart = now()
-    await bw.loadURL('about:blank')
-    bw.show()
-    const tLoadEnd = now()
-    results.loadShowMs = tLoadEnd - tLoadStart
-    results.totalMs = tLoadEnd - t0
-    bw.close()
-    return results
+
+    // The mock has no BrowserWindow; a second mock window stands in for the child
+    const child = darling.createWindow(W, H)
+    const childHwnd = BigInt(darling.getWindowHWND(child))
+    const dwin = runNativePhases(darling, phases, childHwnd)
+
+    phases.total = now() - t0
+
+    darling.destroyWindow(dwin)
+    darling.destroyWindow(child)
+    return phases
 }
 
-app.whenReady().then(async () => {
-    console.log('Running startup benchmark...')
-
-    try {
-        const d = await benchmarkDarling()
-        console.log('Darling embed results (ms):', {
-            darlingCreate: Math.round(d.darlingCreateMs),
-            embed: Math.round(d.embedMs),
-            total: Math.round(d.totalMs)
-        })
-    } catch (e) {
-        console.error('Darling benchmark failed:', e)
+// Run warmup + timed iterations for each suite, interleaving suites so slow
+// drift (thermal, background load) affects all of them equally.
+async function runSuites(suites, { warmup, iterations }) {
+    for (let i = 0; i < warmup; i++) {
+        for (const suite of suites) await suite.run()
     }
 
-    try {
-        const p = await benchmarkPlain()
-        console.log('Plain Electron results (ms):', {
-            create: Math.round(p.browserCreateMs),
-            loadShow: Math.round(p.loadShowMs),
-            total: Math.round(p.totalMs)
-        })
-    } catch (e) {
-        console.error('Plain benchmark failed:', e)
+    const samples = Object.fromEntries(suites.map((s) => [s.name, {}]))
+
+    for (let i = 0; i < iterations; i++) {
+        const order = i % 2 === 0 ? suites : [...suites].reverse()
+        for (const suite of order) {
+            const phases = await suite.run()
+            for (const [phase, ms] of Object.entries(phases)) {
+                (samples[suite.name][phase] ||= []).push(ms)
+            }
+        }
+    }
+
+    return samples
+}
+
+function buildReport(samples, opts, backend) {
+    const suites = {}
+    for (const [name, phases] of Object.entries(samples)) {
+        suites[name] = { phases: {} }
+        for (const [phase, values] of Object.entries(phases)) {
+            suites[name].phases[phase] = summarize(values)
+        }
     }
 
-    app.quit()
-})
+    return {
+        meta: {
+            date: new Date().toISOString(),
+            backend,
+            platform: process.platform,
+            arch: process.arch,
+            cpu: os.cpus()[0]?.model ?? 'unknown',
+            node: process.versions.node,
+            electron: process.versions.electron ?? null,
+            warmup: opts.warmup,
+            iterations: opts.iterations,
+            url: opts.url
+        },
+        suites
+    }
+}
+
+function fmt(ms) { return ms.toFixed(3).padStart(10) }
+
+function printReport(report) {
+    for (const [name, suite] of Object.entries(report.suites)) {
+        console.log(`\n${name} (ms, n=${report.meta.iterations})`)
+        console.log('phase'.padEnd(16) + 'median'.padStart(10) + 'p95'.padStart(10) +
+            'p99'.padStart(10) + '   95% CI (median)')
+
+        for (const [phase, s] of Object.entries(suite.phases)) {
+            const [lo, hi] = s.ci95.median
+            console.log(phase.padEnd(16) + fmt(s.median) + fmt(s.p95) + fmt(s.p99) +
+                `   [${lo.toFixed(3)}, ${hi.toFixed(3)}]`)
+        }
+    }
+}
+
+function printComparison(cmp) {
+    console.log(`\nBaseline comparison (median, threshold ${(cmp.threshold * 100).toFixed(0)}%)`)
+    for (const r of cmp.rows) {
+        const sign = r.deltaPct >= 0 ? '+' : ''
+        console.log(`${`${r.suite}.${r.phase}`.padEnd(28)}${fmt(r.baselineMedian)} -> ${fmt(r.median)}` +
+            `  ${(sign + r.deltaPct.toFixed(1) + '%').padStart(8)}  ${r.status}`)
+    }
+}
+
+async function main(opts, exit) {
+    const isElectron = !!process.versions.electron
+    const backend = opts.backend || (isElectron ? 'native' : 'mock')
+    const suites = []
+
+    if (backend === 'mock') {
+        const darling = createMockBackend()
+        suites.push({ name: 'darlingMock', run: () => iterateDarlingMock(darling) })
+    } else {
+        if (!isElectron) {
+            throw new Error('native backend requires Electron; use --backend mock under Node')
+        }
+        const { BrowserWindow } = require('electron')
+        const darling = require('../js/darling-bridge.cjs')
+        suites.push({ name: 'darling', run: () => iterateDarlingElectron(darling, BrowserWindow, opts.url) })
+        suites.push({ name: 'plain', run: () => iteratePlainElectron(BrowserWindow, opts.url) })
+    }
+
+    console.log(`Running startup benchmark (backend=${backend}, warmup=${opts.warmup}, iterations=${opts.iterations})...`)
+
+    const samples = await runSuites(suites, opts)
+    const report = buildReport(samples, opts, backend)
+    printReport(report)
+
+    let code = 0
+    if (opts.baseline) {
+        const baseline = JSON.parse(readFileSync(opts.baseline, 'utf8'))
+        report.comparison = compareReports(report, baseline, opts.threshold / 100)
+        printComparison(report.comparison)
+        if (report.comparison.regressions > 0) code = 1
+    }
+
+    if (opts.out) {
+        writeFileSync(opts.out, JSON.stringify(report, null, 2))
+        console.log(`\nReport written to ${opts.out}`)
+    }
+
+    exit(code)
+}
+
+const opts = parseArgs(process.argv.slice(2))
+
+if (process.versions.electron) {
+    const { app } = require('electron')
+    app.whenReady().then(() => main(opts, (code) => app.exit(code))).catch((e) => {
+        console.error('Startup benchmark failed:', e)
+        app.exit(2)
+    })
+} else {
+    main(opts, (code) => { process.exitCode = code }).catch((e) => {
+        console.error('Startup benchmark failed:', e)
+        process.exitCode = 2
+    })
+}
@@ -12,6 +12,11 @@ try {
             getHWND: () => { throw new Error('Darling native addon not loaded') },
             getWindowHWND: () => { throw new Error('Darling native addon not loaded') },
             onCloseRequestedForWindow: () => { throw new Error('Darling native addon not loaded') },
+            onDpiChangedForWindow: () => { throw new Error('Darling native addon not loaded') },
+            onFrameRequestedForWindow: () => { throw new Error('Darling native addon not loaded') },
+            onTilesRequestedForWindow: () => { throw new Error('Darling native addon not loaded') },
+            onVisibilityChangedForWindow: () => { throw new Error('Darling native addon not loaded') },
+            onAnimationDoneForWindow: () => { throw new Error('Darling native addon not loaded') },
             setParent: () => { throw new Error('Darling native addon not loaded') },
             setWindowStyles: () => { throw new Error('Darling native addon not loaded') },
             setWindowPos: () => { throw new Error('Darling native addon not loaded') },
@@ -28,6 +33,71 @@ try {
             flashWindow: () => { throw new Error('Darling native addon not loaded') },
             getDpi: () => { throw new Error('Darling native addon not loaded') },
             getScaleFactor: () => { throw new Error('Darling native addon not loaded') },
+            setMemoryBudget: () => { throw new Error('Darling native addon not loaded') },
+            getMemoryStats: () => { throw new Error('Darling native addon not loaded') },
+            setThreadPool: () => { throw new Error('Darling native addon not loaded') },
+            getThreadPoolStats: () => { throw new Error('Darling native addon not loaded') },
+            getWindowMemoryStats: () => { throw new Error('Darling native addon not loaded') },
+            inputRingBytes: () => { throw new Error('Darling native addon not loaded') },
+            attachInputRing: () => { throw new Error('Darling native addon not loaded') },
+            detachInputRing: () => { throw new Error('Darling native addon not loaded') },
+            getInputStats: () => { throw new Error('Darling native addon not loaded') },
+            stateMirrorBytes: () => { throw new Error('Darling native addon not loaded') },
+            attachStateMirror: () => { throw new Error('Darling native addon not loaded') },
+            detachStateMirror: () => { throw new Error('Darling native addon not loaded') },
+            inputNow: () => { throw new Error('Darling native addon not loaded') },
+            paintFrameWindow: () => { throw new Error('Darling native addon not loaded') },
+            paintFrameHwnd: () => { throw new Error('Darling native addon not loaded') },
+            paintYuvWindow: () => { throw new Error('Darling native addon not loaded') },
+            frameRingPresentHwnd: () => { throw new Error('Darling native addon not loaded') },
+            getFrameRecord: () => { throw new Error('Darling native addon not loaded') },
+            getFrameTiming: () => { throw new Error('Darling native addon not loaded') },
+            resetFrameTiming: () => { throw new Error('Darling native addon not loaded') },
+            setFrameOverlay: () => { throw new Error('Darling native addon not loaded') },
+            layerCreate: () => { throw new Error('Darling native addon not loaded') },
+            layerDestroy: () => { throw new Error('Darling native addon not loaded') },
+            layerSetPosition: () => { throw new Error('Darling native addon not loaded') },
+            layerSetZ: () => { throw new Error('Darling native addon not loaded') },
+            layerSetOpacity: () => { throw new Error('Darling native addon not loaded') },
+            layerSetVisible: () => { throw new Error('Darling native addon not loaded') },
+            layerUpdate: () => { throw new Error('Darling native addon not loaded') },
+            getCompositorStats: () => { throw new Error('Darling native addon not loaded') },
+            frameRingCreate: () => { throw new Error('Darling native addon not loaded') },
+            frameRingClose: () => { throw new Error('Darling native addon not loaded') },
+            frameRingPresent: () => { throw new Error('Darling native addon not loaded') },
+            getFrameRingStats: () => { throw new Error('Darling native addon not loaded') },
+            getThumbnail: () => { throw new Error('Darling native addon not loaded') },
+            releaseThumbnails: () => { throw new Error('Darling native addon not loaded') },
+            getThumbnailStats: () => { throw new Error('Darling native addon not loaded') },
+            saveSnapshot: () => { throw new Error('Darling native addon not loaded') },
+            readSnapshotInfo: () => { throw new Error('Darling native addon not loaded') },
+            setSplashSnapshot: () => { throw new Error('Darling native addon not loaded') },
+            endSplash: () => { throw new Error('Darling native addon not loaded') },
+            getSplashStats: () => { throw new Error('Darling native addon not loaded') },
+            drawSubmit: () => { throw new Error('Darling native addon not loaded') },
+            drawImageUpload: () => { throw new Error('Darling native addon not loaded') },
+            drawImageRelease: () => { throw new Error('Darling native addon not loaded') },
+            getDrawStats: () => { throw new Error('Darling native addon not loaded') },
+            surfaceCreate: () => { throw new Error('Darling native addon not loaded') },
+            surfaceClose: () => { throw new Error('Darling native addon not loaded') },
+            surfaceUploadTile: () => { throw new Error('Darling native addon not loaded') },
+            surfaceScrollTo: () => { throw new Error('Darling native addon not loaded') },
+            surfaceInvalidate: () => { throw new Error('Darling native addon not loaded') },
+            getSurfaceStats: () => { throw new Error('Darling native addon not loaded') },
+            setThrottlePolicy: () => { throw new Error('Darling native addon not loaded') },
+            getPowerStats: () => { throw new Error('Darling native addon not loaded') },
+            setPresentMode: () => { throw new Error('Darling native addon not loaded') },
+            getPresentStats: () => { throw new Error('Darling native addon not loaded') },
+            animate: () => { throw new Error('Darling native addon not loaded') },
+            animateCancel: () => { throw new Error('Darling native addon not loaded') },
+            getAnimationStats: () => { throw new Error('Darling native addon not loaded') },
+            createWindowAsync: () => { throw new Error('Darling native addon not loaded') },
+            setAppearanceAsync: () => { throw new Error('Darling native addon not loaded') },
+            showWindowAsync: () => { throw new Error('Darling native addon not loaded') },
+            hideWindowAsync: () => { throw new Error('Darling native addon not loaded') },
+            focusWindowAsync: () => { throw new Error('Darling native addon not loaded') },
+            cancelAsync: () => { throw new Error('Darling native addon not loaded') },
+            getUiThreadStats: () => { throw new Error('Darling native addon not loaded') },
         }
     }
 };
@@ -37,6 +107,11 @@ module.exports = {
     destroyWindow: (win) => native.destroyWindow(win),
     onCloseRequested: (cb) => native.onCloseRequested(cb),
     onCloseRequestedForWindow: (win, cb) => native.onCloseRequestedForWindow(win, cb),
+    onDpiChangedForWindow: (win, cb) => native.onDpiChangedForWindow(win, cb),
+    onFrameRequestedForWindow: (win, cb) => native.onFrameRequestedForWindow(win, cb),
+    onTilesRequestedForWindow: (win, cb) => native.onTilesRequestedForWindow(win, cb),
+    onVisibilityChangedForWindow: (win, cb) => native.onVisibilityChangedForWindow(win, cb),
+    onAnimationDoneForWindow: (win, cb) => native.onAnimationDoneForWindow(win, cb),
     showDarlingWindow: (win) => native.showDarlingWindow(win),
     hideDarlingWindow: (win) => native.hideDarlingWindow(win),
     focusDarlingWindow: (win) => native.focusDarlingWindow(win),
@@ -62,7 +137,85 @@ module.exports = {
     setTitlebarColors: (win, bg, text) => native.setTitlebarColors(win, bg, text),
     setTitlebarColor: (win, color) => native.setTitlebarColor(win, color),
     setCornerPreference: (win, pref) => native.setCornerPreference(win, pref),
+    beginAppearanceUpdate: (win) => native.beginAppearanceUpdate(win),
+    commitAppearanceUpdate: (win) => native.commitAppearanceUpdate(win),
+    layoutAdd: (win, parent, kind, fixed, weight) => native.layoutAdd(win, parent, kind, fixed, weight),
+    layoutSetChild: (win, node, hwnd) => native.layoutSetChild(win, node, hwnd),
+    layoutSetSize: (win, node, fixed, weight) => native.layoutSetSize(win, node, fixed, weight),
+    layoutSetActive: (win, node, index) => native.layoutSetActive(win, node, index),
+    layoutClear: (win) => native.layoutClear(win),
+    layoutApply: (win) => native.layoutApply(win),
+    hitRegionAdd: (win, kind, left, top, right, bottom, anchors) => native.hitRegionAdd(win, kind, left, top, right, bottom, anchors),
+    hitRegionSet: (win, id, left, top, right, bottom, anchors) => native.hitRegionSet(win, id, left, top, right, bottom, anchors),
+    hitRegionRemove: (win, id) => native.hitRegionRemove(win, id),
+    hitRegionClear: (win) => native.hitRegionClear(win),
+    hitTest: (win, x, y) => native.hitTest(win, x, y),
     flashWindow: (win, continuous) => native.flashWindow(win, continuous),
     getDpi: (win) => native.getDpi(win),
     getScaleFactor: (win) => native.getScaleFactor(win),
+    setMemoryBudget: (bytes, mode) => native.setMemoryBudget(bytes, mode),
+    getMemoryStats: () => native.getMemoryStats(),
+    setThreadPool: (threads, affinityMask) => native.setThreadPool(threads, affinityMask),
+    getThreadPoolStats: () => native.getThreadPoolStats(),
+    getWindowMemoryStats: (win) => native.getWindowMemoryStats(win),
+    inputRingBytes: (capacity) => native.inputRingBytes(capacity),
+    attachInputRing: (win, view) => native.attachInputRing(win, view),
+    detachInputRing: (win) => native.detachInputRing(win),
+    getInputStats: (win) => native.getInputStats(win),
+    stateMirrorBytes: () => native.stateMirrorBytes(),
+    attachStateMirror: (win, view) => native.attachStateMirror(win, view),
+    detachStateMirror: (win) => native.detachStateMirror(win),
+    inputNow: () => native.inputNow(),
+    paintFrameWindow: (win, buffer, w, h, frameId, submitTime) => native.paintFrameWindow(win, buffer, w, h, frameId, submitTime),
+    paintFrameHwnd: (hwnd, buffer, w, h, format, frameId) => native.paintFrameHwnd(hwnd, buffer, w, h, format, frameId),
+    paintYuvWindow: (win, frame, scaleToClient, frameId, submitMs) => native.paintYuvWindow(win, frame, scaleToClient, frameId, submitMs),
+    frameRingPresentHwnd: (hwnd) => native.frameRingPresentHwnd(hwnd),
+    getFrameRecord: (win, frameId) => native.getFrameRecord(win, frameId),
+    getFrameTiming: (win) => native.getFrameTiming(win),
+    resetFrameTiming: (win) => native.resetFrameTiming(win),
+    setFrameOverlay: (win, enable) => native.setFrameOverlay(win, enable),
+    layerCreate: (win, x, y, w, h, z) => native.layerCreate(win, x, y, w, h, z),
+    layerDestroy: (win, id) => native.layerDestroy(win, id),
+    layerSetPosition: (win, id, x, y) => native.layerSetPosition(win, id, x, y),
+    layerSetZ: (win, id, z) => native.layerSetZ(win, id, z),
+    layerSetOpacity: (win, id, opacity) => native.layerSetOpacity(win, id, opacity),
+    layerSetVisible: (win, id, visible) => native.layerSetVisible(win, id, visible),
+    layerUpdate: (win, id, buffer, x, y, w, h, premultiplied) => native.layerUpdate(win, id, buffer, x, y, w, h, premultiplied),
+    getCompositorStats: (win) => native.getCompositorStats(win),
+    frameRingCreate: (win, name, maxWidth, maxHeight, slots) => native.frameRingCreate(win, name, maxWidth, maxHeight, slots),
+    frameRingClose: (win) => native.frameRingClose(win),
+    frameRingPresent: (win) => native.frameRingPresent(win),
+    getFrameRingStats: (win) => native.getFrameRingStats(win),
+    getThumbnail: (win, width, height) => native.getThumbnail(win, width, height),
+    releaseThumbnails: (win) => native.releaseThumbnails(win),
+    getThumbnailStats: (win) => native.getThumbnailStats(win),
+    saveSnapshot: (win, path, frames, width, height, count, frameMs) => native.saveSnapshot(win, path, frames, width, height, count, frameMs),
+    readSnapshotInfo: (path) => native.readSnapshotInfo(path),
+    setSplashSnapshot: (path) => native.setSplashSnapshot(path),
+    endSplash: (win) => native.endSplash(win),
+    getSplashStats: (win) => native.getSplashStats(win),
+    drawSubmit: (win, words, background) => native.drawSubmit(win, words, background),
+    drawImageUpload: (win, id, pixels, width, height, premultiplied) => native.drawImageUpload(win, id, pixels, width, height, premultiplied),
+    drawImageRelease: (win, id) => native.drawImageRelease(win, id),
+    getDrawStats: (win) => native.getDrawStats(win),
+    surfaceCreate: (win, width, height, tileSize, budget, background) => native.surfaceCreate(win, width, height, tileSize, budget, background),
+    surfaceClose: (win) => native.surfaceClose(win),
+    surfaceUploadTile: (win, col, row, pixels) => native.surfaceUploadTile(win, col, row, pixels),
+    surfaceScrollTo: (win, x, y) => native.surfaceScrollTo(win, x, y),
+    surfaceInvalidate: (win, x, y, width, height) => native.surfaceInvalidate(win, x, y, width, height),
+    getSurfaceStats: (win) => native.getSurfaceStats(win),
+    setThrottlePolicy: (policy) => native.setThrottlePolicy(policy),
+    getPowerStats: (win) => native.getPowerStats(win),
+    setPresentMode: (win, mode) => native.setPresentMode(win, mode),
+    getPresentStats: (win) => native.getPresentStats(win),
+    animate: (win, tween) => native.animate(win, tween),
+    animateCancel: (win, id) => native.animateCancel(win, id),
+    getAnimationStats: (win) => native.getAnimationStats(win),
+    createWindowAsync: (width, height, parentHwnd) => native.createWindowAsync(width, height, parentHwnd),
+    setAppearanceAsync: (win, appearance) => native.setAppearanceAsync(win, appearance),
+    showWindowAsync: (win) => native.showWindowAsync(win),
+    hideWindowAsync: (win) => native.hideWindowAsync(win),
+    focusWindowAsync: (win) => native.focusWindowAsync(win),
+    cancelAsync: (opId) => native.cancelAsync(opId),
+    getUiThreadStats: () => native.getUiThreadStats(),
 };
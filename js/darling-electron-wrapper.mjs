@@ -6,6 +6,153 @@ const require = createRequire(import.meta.url);
 const darling = require('./darling-bridge.cjs');
 
 let windowAllClosedHandlerAttached = false;
+let throttlePolicySet = false;
+
+// Native layout node kinds (DarlingLayoutKind)
+const LAYOUT_LEAF = 0;
+const LAYOUT_SPLIT_H = 1;
+const LAYOUT_SPLIT_V = 2;
+const LAYOUT_STACK = 3;
+
+// DarlingEvictionMode (darling.h)
+const EVICTION_MODES = { release: 0, compress: 1 };
+
+// DarlingYuvLayout, DarlingYuvMatrix, DarlingYuvRange (darling.h)
+const YUV_LAYOUTS = { i420: 0, nv12: 1 };
+const DRAW_OPS = { rect: 1, line: 2, image: 3, glyphs: 4 };
+const YUV_MATRICES = { bt601: 0, bt709: 1 };
+const YUV_RANGES = { limited: 0, full: 1 };
+
+// DarlingVisibility (darling.h), indexed by value
+const VISIBILITIES = ['visible', 'occluded', 'minimized', 'hidden'];
+
+// DarlingPresentMode (darling.h), indexed by value
+const PRESENT_MODES = ['opaque', 'per-pixel-alpha'];
+
+// DarlingAnimProperty and DarlingEasing (darling.h); properties indexed by value
+const ANIM_PROPERTIES = ['opacity', 'position', 'size', 'titlebar-color'];
+const EASINGS = { linear: 0, ease: 1, 'ease-in': 2, 'ease-out': 3, 'ease-in-out': 4 };
+const EASE_CUBIC_BEZIER = 5;
+
+// How often a throttled window still pumps messages, so it notices being
+// shown again
+const THROTTLED_POLL_MS = 100;
+
+// DarlingHitKind (darling.h), indexed by value
+const HIT_KINDS = [
+    'client', 'caption', 'minimize', 'maximize', 'close',
+    'left', 'right', 'top', 'bottom',
+    'top-left', 'top-right', 'bottom-left', 'bottom-right',
+];
+
+// DarlingHitAnchor flags
+const HIT_LEFT_FROM_RIGHT = 1;
+const HIT_TOP_FROM_BOTTOM = 2;
+const HIT_RIGHT_FROM_RIGHT = 4;
+const HIT_BOTTOM_FROM_BOTTOM = 8;
+
+// DarlingInputType (darling.h), indexed by value
+const INPUT_TYPES = [
+    null, 'mouse-move', 'mouse-down', 'mouse-up', 'wheel', 'hwheel',
+    'key-down', 'key-up', 'char', 'touch-down', 'touch-move', 'touch-up', 'mouse-leave',
+];
+
+// Input ring layout (core/src/platform/common/input.h), in 32-bit words
+const INPUT_WRITE_INDEX = 16;
+const INPUT_READ_INDEX = 32;
+const INPUT_HEADER_BYTES = 192;
+const INPUT_EVENT_BYTES = 32;
+
+// Window state mirror layout (core/src/platform/common/mirror.h), in 32-bit
+// words; fields are flags, dpi, clientWidth, clientHeight, x, y, width, height
+const STATE_SEQUENCE = 16;
+const STATE_FIELDS = 32;
+
+// DarlingWindowStateFlags (darling.h)
+const STATE_VISIBLE = 1;
+const STATE_FOCUSED = 2;
+const STATE_MINIMIZED = 4;
+const STATE_MAXIMIZED = 8;
+const STATE_DARK = 16;
+
+/**
+ * Resolve one axis of a CSS-like region (left/width/right) into native edge
+ * offsets in physical pixels. A missing pair stretches to the far edge.
+ * @returns {[number, number, number]} near edge, far edge, anchor flags
+ */
+const resolveHitAxis = (near, size, far, scale, nearFlag, farFlag) => {
+    const px = (v) => Math.round(v * scale);
+
+    if (far !== undefined) {
+        if (near !== undefined) return [px(near), px(far), farFlag];
+        if (size !== undefined) return [px(far + size), px(far), nearFlag | farFlag];
+        return [0, px(far), farFlag];
+    }
+
+    const start = near ?? 0;
+    if (size !== undefined) return [px(start), px(start + size), 0];
+    return [px(start), 0, farFlag];
+};
+
+/**
+ * Reparent a BrowserWindow into a Darling host as a borderless child
+ * @returns {bigint} the child HWND
+ */
+const embedChildWindow = (browserWindow, parentHWND) => {
+    const WS_CHILD = 0x40000000;
+    const WS_POPUP = 0x80000000;
+    const WS_OVERLAPPEDWINDOW = 0x00CF0000;
+
+    const hwnd = BigInt.asUintN(64, browserWindow.getNativeWindowHandle().readBigUInt64LE(0));
+    darling.setParent(hwnd, parentHWND);
+    darling.setWindowStyles(hwnd, WS_CHILD, WS_POPUP | WS_OVERLAPPEDWINDOW);
+    return hwnd;
+};
+
+/**
+ * Startup stage timer
+ * Records per-stage start/end offsets (ms) relative to the pipeline origin
+ * @returns {{ begin: (name: string) => void, end: (name: string) => void, finish: () => Object }}
+ */
+const createStartupTimer = () => {
+    const origin = performance.now();
+    const stages = {};
+    const ops = {};
+    let splashFirstPixel = null;
+
+    return {
+        begin(name) {
+            stages[name] = { start: performance.now() - origin, end: null, duration: null };
+        },
+
+        end(name) {
+            const stage = stages[name];
+            if (!stage || stage.end !== null) return;
+            stage.end = performance.now() - origin;
+            stage.duration = stage.end - stage.start;
+        },
+
+        // Native timing of a settled async call (queue, run, settle)
+        op(name, promise) {
+            if (promise && promise.timing) ops[name] = promise.timing;
+        },
+
+        // Native window creation to the splash snapshot's first pixel
+        splash(stats) {
+            if (stats && stats.frames) splashFirstPixel = stats.firstPixelMs;
+        },
+
+        finish() {
+            return {
+                origin: performance.timeOrigin + origin,
+                total: performance.now() - origin,
+                stages,
+                ops,
+                splashFirstPixel,
+            };
+        },
+    };
+};
 
 /**
  * Darling Window Instance
@@ -20,10 +167,39 @@ class DarlingWindowInstance extends EventEmitter {
         this.browserWindow = browserWindow;
         this.options = options;
         this.closed = false;
+        this.startupTimings = null;
         this._pollInterval = null;
+        this._layoutNodes = {};
+        this._hitRegions = null;
+        this._input = null;
+        this._state = null;
+        this._frameId = 0;
+        this._snapshotInterval = null;
+        this._pollMs = 0;
+        this.visibility = 'visible';
+        this.throttled = false;
+        this.producerRate = 0;
+        this._animations = new Map();   // tween id -> resolve
         
         this._setupEventForwarding();
     }
+
+    // Mirror native window state into a SharedArrayBuffer so queries are
+    // plain loads; without it they fall back to native calls
+    _attachStateMirror() {
+        const words = new Int32Array(new SharedArrayBuffer(darling.stateMirrorBytes()));
+        this._state = darling.attachStateMirror(this.darlingWindow, words) ? words : null;
+    }
+
+    // One mirrored field, retried while the window procedure is rewriting it
+    _stateField(field) {
+        const words = this._state;
+        for (;;) {
+            const before = Atomics.load(words, STATE_SEQUENCE);
+            const value = Atomics.load(words, STATE_FIELDS + field);
+            if ((before & 1) === 0 && Atomics.load(words, STATE_SEQUENCE) === before) return value;
+        }
+    }
     
     _setupEventForwarding() {
         // Forward BrowserWindow events
@@ -32,12 +208,25 @@ class DarlingWindowInstance extends EventEmitter {
             this.emit('closed');
         });
         
+        // Sizes and positions in DIPs, from the mirror when attached. The
+        // BrowserWindow fills the native client area.
         this.browserWindow.on('resize', () => {
+            const state = this.getState();
+            if (state) {
+                this.emit('resize', Math.round(state.clientWidth / state.scaleFactor),
+                    Math.round(state.clientHeight / state.scaleFactor));
+                return;
+            }
             const [width, height] = this.browserWindow.getSize();
             this.emit('resize', width, height);
         });
         
         this.browserWindow.on('move', () => {
+            const state = this.getState();
+            if (state) {
+                this.emit('move', Math.round(state.x / state.scaleFactor), Math.round(state.y / state.scaleFactor));
+                return;
+            }
             const [x, y] = this.browserWindow.getPosition();
             this.emit('move', x, y);
         });
@@ -63,7 +252,18 @@ class DarlingWindowInstance extends EventEmitter {
             clearInterval(this._pollInterval);
             this._pollInterval = null;
         }
+
+        if (this._snapshotInterval) {
+            clearInterval(this._snapshotInterval);
+            this._snapshotInterval = null;
+        }
         
+        this._input = null;
+        this._state = null;
+
+        for (const resolve of this._animations.values()) resolve(false);
+        this._animations.clear();
+
         try {
             if (this.darlingWindow) {
                 darling.destroyWindow(this.darlingWindow);
@@ -182,6 +382,7 @@ class DarlingWindowInstance extends EventEmitter {
 
     isVisible() {
         if (this.closed) return false;
+        if (this._state) return (this._stateField(0) & STATE_VISIBLE) !== 0;
         try {
             return !!darling.isVisible(this.darlingWindow);
         } catch (e) {
@@ -192,6 +393,7 @@ class DarlingWindowInstance extends EventEmitter {
 
     isFocused() {
         if (this.closed) return false;
+        if (this._state) return (this._stateField(0) & STATE_FOCUSED) !== 0;
         try {
             return !!darling.isFocused(this.darlingWindow);
         } catch (e) {
@@ -244,6 +446,561 @@ class DarlingWindowInstance extends EventEmitter {
         }
     }
 
+    /**
+     * Lay out several BrowserWindows inside this window natively. Resizes
+     * reposition every child in one batch without a round trip through JS.
+     *
+     * Spec nodes:
+     *   { window: BrowserWindow }                       leaf
+     *   { split: 'horizontal' | 'vertical', children }  side by side / stacked
+     *   { stack: [...], active }                        tabs: one child visible
+     * Any node may set `size` (fixed px along the parent split), `weight`
+     * (share of the remaining space, default 1) and `name`.
+     * @returns {Object<string, number>} node ids keyed by name
+     */
+    setLayout(spec) {
+        if (this.closed) return {};
+
+        const win = this.darlingWindow;
+        const names = {};
+
+        const add = (node, parent) => {
+            const size = node.size ?? 0;
+            const weight = node.weight ?? 1;
+            let id;
+
+            if (node.window) {
+                id = darling.layoutAdd(win, parent, LAYOUT_LEAF, size, weight);
+                if (id >= 0) {
+                    darling.layoutSetChild(win, id, embedChildWindow(node.window, this.darlingHWND));
+                }
+            } else if (node.stack) {
+                id = darling.layoutAdd(win, parent, LAYOUT_STACK, size, weight);
+                if (id >= 0) {
+                    node.stack.forEach((child) => add(child, id));
+                    darling.layoutSetActive(win, id, node.active ?? 0);
+                }
+            } else {
+                const kind = node.split === 'vertical' ? LAYOUT_SPLIT_V : LAYOUT_SPLIT_H;
+                id = darling.layoutAdd(win, parent, kind, size, weight);
+                if (id >= 0) {
+                    (node.children ?? []).forEach((child) => add(child, id));
+                }
+            }
+
+            if (id < 0) {
+                throw new Error('Failed to add layout node');
+            }
+
+            if (node.name) names[node.name] = id;
+        };
+
+        try {
+            add(spec, -1);
+            darling.layoutApply(win);
+        } catch (e) {
+            console.error('Failed to set layout:', e);
+            throw e;
+        }
+
+        this._layoutNodes = names;
+        return names;
+    }
+
+    _layoutNode(node) {
+        return typeof node === 'string' ? this._layoutNodes[node] ?? -1 : node;
+    }
+
+    // Show child `index` of a stack node (by name or id)
+    setLayoutActive(node, index) {
+        if (this.closed) return;
+        darling.layoutSetActive(this.darlingWindow, this._layoutNode(node), index);
+        darling.layoutApply(this.darlingWindow);
+    }
+
+    // Resize a layout node (by name or id), e.g. while dragging a splitter
+    setLayoutSize(node, { size = 0, weight = 1 } = {}) {
+        if (this.closed) return;
+        darling.layoutSetSize(this.darlingWindow, this._layoutNode(node), size, weight);
+        darling.layoutApply(this.darlingWindow);
+    }
+
+    /**
+     * Answer hit tests natively for a titlebar drawn in web content, so
+     * dragging, caption buttons and resizing skip the round trip through JS.
+     *
+     * Regions: { kind, left, width, right, top, height, bottom } in CSS px,
+     * with at most two of left/width/right (and of top/height/bottom); a
+     * missing edge stretches to the window edge. Kinds: 'caption', 'minimize',
+     * 'maximize', 'close', resize edges ('left', 'top-right', ...) and
+     * 'client' for interactive content inside the caption. Later regions win
+     * where they overlap. Replaces previous regions; they follow resizes and
+     * are rescaled on DPI changes.
+     */
+    setHitRegions(regions) {
+        if (this.closed) return;
+
+        const win = this.darlingWindow;
+
+        try {
+            const scale = darling.getScaleFactor(win);
+            darling.hitRegionClear(win);
+
+            for (const region of regions) {
+                const kind = HIT_KINDS.indexOf(region.kind);
+                if (kind < 0) {
+                    throw new Error(`Unknown hit region kind: ${region.kind}`);
+                }
+
+                const [left, right, anchorsX] = resolveHitAxis(
+                    region.left, region.width, region.right, scale, HIT_LEFT_FROM_RIGHT, HIT_RIGHT_FROM_RIGHT);
+                const [top, bottom, anchorsY] = resolveHitAxis(
+                    region.top, region.height, region.bottom, scale, HIT_TOP_FROM_BOTTOM, HIT_BOTTOM_FROM_BOTTOM);
+
+                darling.hitRegionAdd(win, kind, left, top, right, bottom, anchorsX | anchorsY);
+            }
+        } catch (e) {
+            console.error('Failed to set hit regions:', e);
+            throw e;
+        }
+
+        this._hitRegions = regions;
+    }
+
+    // Kind of the hit region at a client point in CSS px, or null
+    hitTest(x, y) {
+        if (this.closed) return null;
+
+        const scale = darling.getScaleFactor(this.darlingWindow);
+        const kind = darling.hitTest(this.darlingWindow, Math.round(x * scale), Math.round(y * scale));
+        return HIT_KINDS[kind] ?? null;
+    }
+
+    // Capture native input into a ring shared with JS (SharedArrayBuffer).
+    // Events are timestamped on the window procedure; read them with
+    // drainInput once per frame. Returns the ring capacity.
+    enableInput(capacity = 1024) {
+        if (this.closed) return 0;
+
+        const bytes = darling.inputRingBytes(capacity);
+        const buffer = new SharedArrayBuffer(bytes);
+        const attached = darling.attachInputRing(this.darlingWindow, new Uint8Array(buffer));
+        if (!attached) {
+            this._input = null;
+            return 0;
+        }
+
+        this._input = {
+            capacity: attached,
+            words: new Int32Array(buffer),
+            view: new DataView(buffer),
+        };
+        return attached;
+    }
+
+    disableInput() {
+        if (this.closed || !this._input) return;
+        darling.detachInputRing(this.darlingWindow);
+        this._input = null;
+    }
+
+    // Consume pending input events in order. Calls fn(event) for each one
+    // when given, otherwise returns them as an array.
+    drainInput(fn) {
+        const events = fn ? null : [];
+        const ring = this._input;
+        if (!ring) return events;
+
+        const { words, view, capacity } = ring;
+        const write = Atomics.load(words, INPUT_WRITE_INDEX) >>> 0;
+        let read = Atomics.load(words, INPUT_READ_INDEX) >>> 0;
+
+        while (read !== write) {
+            const at = INPUT_HEADER_BYTES + (read & (capacity - 1)) * INPUT_EVENT_BYTES;
+            const modifiers = view.getUint32(at + 12, true);
+            const event = {
+                time: view.getFloat64(at, true),
+                type: INPUT_TYPES[view.getUint32(at + 8, true)] ?? null,
+                modifiers,
+                x: view.getInt32(at + 16, true),
+                y: view.getInt32(at + 20, true),
+                code: view.getInt32(at + 24, true),
+                value: view.getInt32(at + 28, true),
+                shiftKey: (modifiers & 1) !== 0,
+                ctrlKey: (modifiers & 2) !== 0,
+                altKey: (modifiers & 4) !== 0,
+                metaKey: (modifiers & 8) !== 0,
+            };
+            read = (read + 1) >>> 0;
+
+            if (fn) fn(event);
+            else events.push(event);
+        }
+
+        // Release the slots only after they have been copied out
+        Atomics.store(words, INPUT_READ_INDEX, read | 0);
+        return events;
+    }
+
+    // Ring counters: capacity, pending, written, dropped
+    getInputStats() {
+        if (this.closed || !this._input) return null;
+        try {
+            return darling.getInputStats(this.darlingWindow);
+        } catch (e) {
+            console.error('Failed to get input stats:', e);
+            throw e;
+        }
+    }
+
+    // Paint a BGRA buffer into this window. The frame is stamped at each
+    // pipeline stage; returns its ID for getFrameRecord.
+    paintFrame(buffer, width, height, frameId = ++this._frameId) {
+        if (this.closed) return 0;
+        darling.paintFrameWindow(this.darlingWindow, buffer, width, height, frameId, darling.inputNow());
+        return frameId;
+    }
+
+    // Paint a decoded I420 or NV12 frame, converted to BGRA natively.
+    // `frame` holds width, height, the y/u/v planes (NV12: interleaved UV in
+    // u) and optional strides; layout 'i420' | 'nv12', matrix 'bt601' |
+    // 'bt709' and range 'limited' | 'full' default to i420, bt709, limited.
+    paintYuv(frame, { scaleToClient = false, frameId = ++this._frameId } = {}) {
+        if (this.closed) return 0;
+        darling.paintYuvWindow(this.darlingWindow, {
+            ...frame,
+            layout: YUV_LAYOUTS[frame.layout] ?? 0,
+            matrix: YUV_MATRICES[frame.matrix] ?? 1,
+            range: YUV_RANGES[frame.range] ?? 0,
+        }, scaleToClient, frameId, darling.inputNow());
+        return frameId;
+    }
+
+    // A structured-cloneable handle for painting this window from a
+    // worker_thread: postMessage it and pass it to createWorkerSurface from
+    // darling/worker
+    getWorkerHandle() {
+        if (this.closed) return null;
+        return { hwnd: this.darlingHWND };
+    }
+
+    // Stage timestamps of a recent frame (ms on the inputNow clock); null
+    // while in flight. `presented` is null if a newer frame replaced it.
+    getFrameRecord(frameId) {
+        if (this.closed) return null;
+        return darling.getFrameRecord(this.darlingWindow, frameId);
+    }
+
+    // FPS and latency summaries (producer, copy, invalidate, queue, blit, total)
+    getFrameTiming() {
+        if (this.closed) return null;
+        try {
+            return darling.getFrameTiming(this.darlingWindow);
+        } catch (e) {
+            console.error('Failed to get frame timing:', e);
+            throw e;
+        }
+    }
+
+    resetFrameTiming() {
+        if (!this.closed) {
+            darling.resetFrameTiming(this.darlingWindow);
+        }
+    }
+
+    // Draw FPS and p99 latency into the corner of every frame
+    setFrameOverlay(enable) {
+        if (!this.closed) {
+            darling.setFrameOverlay(this.darlingWindow, !!enable);
+        }
+    }
+
+    // Add an overlay layer composited above the window content, positioned
+    // in client px. Pixels are BGRA with straight alpha unless premultiplied.
+    // Only the parts of the window a layer change touches are recomposited.
+    createLayer({ x = 0, y = 0, width, height, z = 0, opacity = 255 } = {}) {
+        if (this.closed) return null;
+        const win = this.darlingWindow;
+        const id = darling.layerCreate(win, x, y, width, height, z);
+        if (id < 0) {
+            throw new Error(`Failed to create a ${width}x${height} layer`);
+        }
+        if (opacity !== 255) {
+            darling.layerSetOpacity(win, id, opacity);
+        }
+
+        let destroyed = false;
+        const alive = () => !this.closed && !destroyed;
+        return {
+            id,
+            update(buffer, rect = { x: 0, y: 0, width, height }, premultiplied = false) {
+                if (alive()) darling.layerUpdate(win, id, buffer, rect.x, rect.y, rect.width, rect.height, premultiplied);
+            },
+            move(nx, ny) {
+                if (alive()) darling.layerSetPosition(win, id, nx, ny);
+            },
+            setZ(nz) {
+                if (alive()) darling.layerSetZ(win, id, nz);
+            },
+            setOpacity(value) {
+                if (alive()) darling.layerSetOpacity(win, id, value);
+            },
+            show() {
+                if (alive()) darling.layerSetVisible(win, id, true);
+            },
+            hide() {
+                if (alive()) darling.layerSetVisible(win, id, false);
+            },
+            destroy() {
+                if (alive()) darling.layerDestroy(win, id);
+                destroyed = true;
+            },
+        };
+    }
+
+    // Layer count and how many pixels compositing touched or skipped
+    getCompositorStats() {
+        if (this.closed) return null;
+        try {
+            return darling.getCompositorStats(this.darlingWindow);
+        } catch (e) {
+            console.error('Failed to get compositor stats:', e);
+            throw e;
+        }
+    }
+
+    // Open a named shared-memory frame ring that another process (a native
+    // renderer or decoder using the darling_producer SDK) writes frames into.
+    // The newest complete frame is presented on every pollEvents; frames are
+    // never copied through JavaScript.
+    createFrameRing({ name, maxWidth, maxHeight, slots = 3 } = {}) {
+        if (this.closed) return false;
+        if (!darling.frameRingCreate(this.darlingWindow, name, maxWidth, maxHeight, slots)) {
+            throw new Error(`Failed to create frame ring "${name}"`);
+        }
+        return true;
+    }
+
+    closeFrameRing() {
+        if (!this.closed) darling.frameRingClose(this.darlingWindow);
+    }
+
+    // Present the newest frame now instead of waiting for pollEvents
+    presentFrameRing() {
+        if (this.closed) return false;
+        return darling.frameRingPresent(this.darlingWindow);
+    }
+
+    getFrameRingStats() {
+        if (this.closed) return null;
+        try {
+            return darling.getFrameRingStats(this.darlingWindow);
+        } catch (e) {
+            console.error('Failed to get frame ring stats:', e);
+            throw e;
+        }
+    }
+
+    // A width x height BGRA preview of the last painted contents, kept
+    // current incrementally; null if there is nothing to show yet
+    getThumbnail(width, height) {
+        if (this.closed) return null;
+        return darling.getThumbnail(this.darlingWindow, width, height);
+    }
+
+    // Free the preview pyramid (e.g. when a tab switcher closes)
+    releaseThumbnails() {
+        if (this.closed) return;
+        darling.releaseThumbnails(this.darlingWindow);
+    }
+
+    getThumbnailStats() {
+        if (this.closed) return null;
+        return darling.getThumbnailStats(this.darlingWindow);
+    }
+
+    // Save the page as it looks now to the `snapshot` file, for the next
+    // launch to show while it starts. Resolves to false if there is no
+    // snapshot path or the capture failed.
+    async saveSnapshot() {
+        const path = this.options.snapshot;
+        if (this.closed || !path) return false;
+
+        const image = await this.browserWindow.webContents.capturePage();
+        if (this.closed || image.isEmpty()) return false;
+
+        const scale = this.getScaleFactor();
+        const { width, height } = image.getSize(scale);
+        const bitmap = image.toBitmap({ scaleFactor: scale });
+        if (bitmap.length < width * height * 4) return false;
+
+        return darling.saveSnapshot(this.darlingWindow, path, bitmap, width, height);
+    }
+
+    getSplashStats() {
+        if (this.closed) return null;
+        return darling.getSplashStats(this.darlingWindow);
+    }
+
+    // Draw the window from a display list (a DisplayList or its words)
+    // instead of frames; only commands that changed since the last list
+    // are rasterized again. Returns false if the list is malformed.
+    drawList(list, background = 0xFF000000) {
+        if (this.closed) return false;
+        const words = list instanceof DisplayList ? list.finish() : list;
+        return darling.drawSubmit(this.darlingWindow, words, background);
+    }
+
+    // Upload a BGRA image once for image() and glyphs() commands to use by ID
+    uploadImage(id, buffer, width, height, premultiplied = false) {
+        if (this.closed) return false;
+        return darling.drawImageUpload(this.darlingWindow, id, buffer, width, height, premultiplied);
+    }
+
+    releaseImage(id) {
+        if (this.closed) return;
+        darling.drawImageRelease(this.darlingWindow, id);
+    }
+
+    getDrawStats() {
+        if (this.closed) return null;
+        return darling.getDrawStats(this.darlingWindow);
+    }
+
+    // Show a viewport into a surface larger than the window, kept as tiles
+    // in a cache of at most budget bytes. Tiles the viewport needs and the
+    // cache lacks are asked for with 'tiles-requested'; answer each with
+    // uploadTile(). Scrolling reuses the pixels already on screen.
+    createSurface({ width, height, tileSize = 256, budget = 64 * 1024 * 1024, background = 0xFF000000 }) {
+        if (this.closed) return false;
+        return darling.surfaceCreate(this.darlingWindow, width, height, tileSize, budget, background);
+    }
+
+    closeSurface() {
+        if (this.closed) return;
+        darling.surfaceClose(this.darlingWindow);
+    }
+
+    // tileSize * tileSize BGRA pixels for the tile at (col, row)
+    uploadTile(col, row, buffer) {
+        if (this.closed) return false;
+        return darling.surfaceUploadTile(this.darlingWindow, col, row, buffer);
+    }
+
+    scrollSurfaceTo(x, y) {
+        if (this.closed) return;
+        darling.surfaceScrollTo(this.darlingWindow, Math.round(x), Math.round(y));
+    }
+
+    // Content in the rectangle changed; its tiles are dropped and the
+    // visible ones requested again
+    invalidateSurface(x, y, width, height) {
+        if (this.closed) return;
+        darling.surfaceInvalidate(this.darlingWindow, x, y, width, height);
+    }
+
+    getSurfaceStats() {
+        if (this.closed) return null;
+        return darling.getSurfaceStats(this.darlingWindow);
+    }
+
+    // Visibility, throttling and the time presents took (wall and CPU)
+    getPowerStats() {
+        if (this.closed) return null;
+        const stats = darling.getPowerStats(this.darlingWindow);
+        return { ...stats, visibility: VISIBILITIES[stats.visibility] ?? 'visible' };
+    }
+
+    // 'per-pixel-alpha' presents the window as a layered window whose
+    // transparent pixels show what is behind it, sending only what changed;
+    // 'opaque' (the default) ignores alpha. Frames stay straight BGRA and
+    // are premultiplied natively.
+    setPresentMode(mode) {
+        if (this.closed) return false;
+        const index = PRESENT_MODES.indexOf(mode);
+        if (index < 0) throw new TypeError(`Unknown present mode: ${mode}`);
+        return darling.setPresentMode(this.darlingWindow, index);
+    }
+
+    // The present mode, layered presents and the pixels they sent or
+    // skipped, and pixels converted for premultiplied alpha
+    getPresentStats() {
+        if (this.closed) return null;
+        const stats = darling.getPresentStats(this.darlingWindow);
+        return { ...stats, mode: PRESENT_MODES[stats.mode] ?? 'opaque' };
+    }
+
+    // Tween a property natively, ticked once per refresh without calls from
+    // JS: 'opacity' (0-255), 'position' ([x, y]), 'size' ([width, height])
+    // in native pixels, or 'titlebar-color' (0xRRGGBB). `easing` is a CSS
+    // name or [x1, y1, x2, y2]. Resolves true at the end value, false if
+    // cancelled, replaced by another tween of the property or closed.
+    animate(property, to, options = {}) {
+        if (this.closed) return Promise.resolve(false);
+        const { duration = 250, delay = 0, easing = 'ease', from } = options;
+        const index = ANIM_PROPERTIES.indexOf(property);
+        if (index < 0) {
+            return Promise.reject(new TypeError(`Unknown animation property: ${property}`));
+        }
+
+        const tween = { property: index, to: [].concat(to), duration, delay };
+        if (Array.isArray(easing)) {
+            tween.easing = EASE_CUBIC_BEZIER;
+            tween.bezier = easing;
+        } else {
+            tween.easing = EASINGS[easing] ?? EASINGS.ease;
+        }
+        if (from !== undefined) tween.from = [].concat(from);
+
+        const id = darling.animate(this.darlingWindow, tween);
+        if (!id) return Promise.resolve(false);
+        return new Promise((resolve) => this._animations.set(id, resolve));
+    }
+
+    // Stop every running tween where it is
+    cancelAnimations() {
+        if (this.closed) return;
+        darling.animateCancel(this.darlingWindow);
+    }
+
+    // Running tweens, the refresh period they tick at and tween counters
+    getAnimationStats() {
+        if (this.closed) return null;
+        return darling.getAnimationStats(this.darlingWindow);
+    }
+
+    // Pump messages every `ms`, replacing the current poller
+    _startPolling(ms, onError) {
+        if (this._pollInterval) {
+            clearInterval(this._pollInterval);
+        }
+        this._pollMs = ms;
+        this._pollInterval = setInterval(() => {
+            try {
+                darling.pollEvents();
+            } catch (e) {
+                console.error('Failed polling events:', e);
+                this.close();
+                if (onError) onError(e);
+            }
+        }, ms);
+    }
+
+    // Batch appearance setters (theme, titlebar colors, icon) so the frame is
+    // recalculated and redrawn once when update returns
+    updateAppearance(update) {
+        if (this.closed) {
+            return;
+        }
+
+        darling.beginAppearanceUpdate(this.darlingWindow);
+        try {
+            update(this);
+        } finally {
+            darling.commitAppearanceUpdate(this.darlingWindow);
+        }
+    }
+
     flashWindow(continuous = false) {
         if (!this.closed) {
             try {
@@ -257,6 +1014,7 @@ class DarlingWindowInstance extends EventEmitter {
 
     getDpi() {
         if (this.closed) return 96;
+        if (this._state) return this._stateField(1);
         try {
             return darling.getDpi(this.darlingWindow);
         } catch (e) {
@@ -267,6 +1025,7 @@ class DarlingWindowInstance extends EventEmitter {
 
     getScaleFactor() {
         if (this.closed) return 1;
+        if (this._state) return this._stateField(1) / 96;
         try {
             return darling.getScaleFactor(this.darlingWindow);
         } catch (e) {
@@ -274,6 +1033,47 @@ class DarlingWindowInstance extends EventEmitter {
             throw e;
         }
     }
+
+    // Consistent snapshot of the mirrored window state (physical px), or
+    // null without a mirror
+    getState() {
+        const words = this._state;
+        if (this.closed || !words) return null;
+
+        for (;;) {
+            const before = Atomics.load(words, STATE_SEQUENCE);
+            const f = [];
+            for (let i = 0; i < 8; i++) f.push(Atomics.load(words, STATE_FIELDS + i));
+            if ((before & 1) !== 0 || Atomics.load(words, STATE_SEQUENCE) !== before) continue;
+
+            const [flags, dpi, clientWidth, clientHeight, x, y, width, height] = f;
+            return {
+                visible: (flags & STATE_VISIBLE) !== 0,
+                focused: (flags & STATE_FOCUSED) !== 0,
+                minimized: (flags & STATE_MINIMIZED) !== 0,
+                maximized: (flags & STATE_MAXIMIZED) !== 0,
+                darkMode: (flags & STATE_DARK) !== 0,
+                dpi,
+                scaleFactor: dpi / 96,
+                clientWidth,
+                clientHeight,
+                x,
+                y,
+                width,
+                height,
+            };
+        }
+    }
+
+    getMemoryStats() {
+        if (this.closed) return null;
+        try {
+            return darling.getWindowMemoryStats(this.darlingWindow);
+        } catch (e) {
+            console.error('Failed to get memory stats:', e);
+            throw e;
+        }
+    }
     
     minimize() {
         if (!this.closed) {
@@ -329,10 +1129,14 @@ export const CreateWindow = async (options = {}) => {
         await app.whenReady();
     }
 
+    // A valid snapshot from the last run is shown the moment the native
+    // window exists and sizes it unless the caller does
+    const snapshot = options.snapshot ? darling.readSnapshotInfo(options.snapshot) : null;
+
     // Extract and validate options
     const {
-        width = 800,
-        height = 600,
+        width = snapshot ? Math.round(snapshot.width * 96 / (snapshot.dpi || 96)) : 800,
+        height = snapshot ? Math.round(snapshot.height * 96 / (snapshot.dpi || 96)) : 600,
         x = undefined,
         y = undefined,
         center = false,
@@ -341,6 +1145,7 @@ export const CreateWindow = async (options = {}) => {
         showIcon = true,
         frameRate = 60,
         theme = null,
+        snapshotIntervalMs = 0,
         
         // Native styles
         nativeStylesAdd = 0,
@@ -366,53 +1171,100 @@ export const CreateWindow = async (options = {}) => {
     let browserWindow = null;
     let instance = null;
 
+    const timer = createStartupTimer();
+    let createPromise = null;
+
+    if (!throttlePolicySet) {
+        SetThrottlePolicy();
+    }
+
     try {
-        // Create the native host window
-        darlingWindowHandle = darling.createWindow(width, height);
-        darling.showDarlingWindow(darlingWindowHandle);
+        // Stage: create the native host window on the UI thread while the
+        // BrowserWindow is built below; it ends when the window is ours
+        timer.begin('nativeCreate');
+        if (snapshot) {
+            darling.setSplashSnapshot(options.snapshot);
+        }
+        createPromise = darling.createWindowAsync(width, height);
+        // Surface rejection at the await below, not as an unhandled rejection
+        createPromise.catch(() => {});
+
+        // Stage: create the Electron BrowserWindow (independent of host appearance)
+        timer.begin('browserCreate');
+        browserWindow = new BrowserWindow({
+            width,
+            height,
+            x,
+            y,
+            show: false,
+            frame: false,
+            webPreferences,
+        });
+        timer.end('browserCreate');
+
+        darlingWindowHandle = await createPromise;
+        timer.end('nativeCreate');
+        timer.op('create', createPromise);
+        if (snapshot) {
+            timer.splash(darling.getSplashStats(darlingWindowHandle));
+        }
         darlingHWND = BigInt.asUintN(64, BigInt(darling.getWindowHWND(darlingWindowHandle)));
+        const showPromise = darling.showWindowAsync(darlingWindowHandle);
+        showPromise.catch(() => {});
 
-        // Set window title
-        if (title) {
-            try {
-                darling.setWindowTitle(darlingWindowHandle, title);
-            } catch (e) {
-                console.warn('Failed to set window title:', e);
+        // Create window instance
+        instance = new DarlingWindowInstance(darlingWindowHandle, darlingHWND, browserWindow, options);
+        instance._attachStateMirror();
+
+        // Apply content theme (must be attached before navigation starts)
+        if (theme && typeof theme === 'object' && theme.content) {
+            const contentTheme = theme.content;
+            if (contentTheme === 'dark' || contentTheme === 'light') {
+                browserWindow.webContents.on('did-finish-load', () => {
+                    const scheme = contentTheme === 'dark' ? 'dark' : 'light';
+                    browserWindow.webContents.insertCSS(`:root{color-scheme:${scheme};}`);
+                });
             }
         }
 
-        // Set icon visibility
-        try {
-            darling.setWindowIconVisible(darlingWindowHandle, !!showIcon);
-        } catch (e) {
-            console.warn('Failed to set window icon visibility:', e);
+        // Stage: start navigation now so page load overlaps native work below
+        timer.begin('load');
+        timer.begin('firstPaint');
+        browserWindow.once('ready-to-show', () => timer.end('firstPaint'));
+
+        const loadPromise = browserWindow.loadURL(url);
+        // Surface rejection at the await below, not as an unhandled rejection
+        loadPromise.catch(() => {});
+
+        // Stage: host appearance (title, icon, titlebar theme), applied in
+        // one batch on the UI thread while the embed below runs here
+        timer.begin('appearance');
+        const appearance = { iconVisible: !!showIcon };
+
+        if (title) {
+            appearance.title = title;
         }
 
-        // Apply theme
         if (theme) {
             const titlebarTheme = typeof theme === 'string' ? theme : theme.titlebar;
             
             if (titlebarTheme === 'dark' || titlebarTheme === 'light') {
-                try {
-                    darling.setDarkMode(darlingWindowHandle, titlebarTheme === 'dark');
-                } catch (e) {
-                    console.warn('Failed to set titlebar theme:', e);
-                }
+                appearance.darkMode = titlebarTheme === 'dark';
             }
         }
 
-        // Create the Electron BrowserWindow
-        browserWindow = new BrowserWindow({
-            width,
-            height,
-            x,
-            y,
-            show: false,
-            frame: false,
-            webPreferences,
-        });
+        const appearanceOp = darling.setAppearanceAsync(darlingWindowHandle, appearance);
+        const appearancePromise = appearanceOp.then(
+            () => {
+                timer.end('appearance');
+                timer.op('appearance', appearanceOp);
+            },
+            (e) => console.warn('Failed to set window appearance:', e)
+        );
+
+        // Stage: embed the Electron window into the native Darling window
+        timer.begin('embed');
 
-        // Embed the Electron window into the native Darling window
         const buf = browserWindow.getNativeWindowHandle();
         const eleHWND = BigInt.asUintN(64, buf.readBigUInt64LE(0));
 
@@ -422,6 +1274,8 @@ export const CreateWindow = async (options = {}) => {
         const SWP_NOZORDER = 0x0004;
         const SWP_FRAMECHANGED = 0x0020;
 
+        // A Darling window on its own UI thread now shares input state with
+        // the main thread: SetParent across threads attaches their input queues
         darling.setParent(
             eleHWND,
             darlingHWND
@@ -447,7 +1301,11 @@ export const CreateWindow = async (options = {}) => {
             eleHWND
         );
 
-        // Apply native window style overrides
+        timer.end('embed');
+
+        // Stage: apply native window style overrides
+        timer.begin('nativeStyles');
+
         if (nativeStylesAdd || nativeStylesRemove) {
             darling.setWindowStyles(
                 darlingHWND,
@@ -482,10 +1340,9 @@ export const CreateWindow = async (options = {}) => {
             );
         }
 
-        // Create window instance
-        instance = new DarlingWindowInstance(darlingWindowHandle, darlingHWND, browserWindow, options);
+        timer.end('nativeStyles');
 
-        // Call electron callback if provided
+        // Call electron callback if provided, once the window is embedded
         if (electron && typeof electron === 'function') {
             try {
                 electron(browserWindow, instance);
@@ -495,19 +1352,15 @@ export const CreateWindow = async (options = {}) => {
             }
         }
 
-        // Apply content theme
-        if (theme && typeof theme === 'object' && theme.content) {
-            const contentTheme = theme.content;
-            if (contentTheme === 'dark' || contentTheme === 'light') {
-                browserWindow.webContents.on('did-finish-load', () => {
-                    const scheme = contentTheme === 'dark' ? 'dark' : 'light';
-                    browserWindow.webContents.insertCSS(`:root{color-scheme:${scheme};}`);
-                });
-            }
-        }
+        // Join: wait for navigation and the native calls started above
+        await loadPromise;
+        timer.end('load');
+        await appearancePromise;
+        await showPromise;
+        timer.op('show', showPromise);
 
-        // Load URL
-        await browserWindow.loadURL(url);
+        // Stage: first show
+        timer.begin('show');
         browserWindow.show();
         
         // Center if requested
@@ -515,6 +1368,14 @@ export const CreateWindow = async (options = {}) => {
             browserWindow.center();
         }
 
+        // The page covers the client area from here on
+        if (snapshot) {
+            darling.endSplash(darlingWindowHandle);
+        }
+        timer.end('show');
+
+        instance.startupTimings = timer.finish();
+
         // Call onReady callback
         if (onReady && typeof onReady === 'function') {
             try {
@@ -526,15 +1387,17 @@ export const CreateWindow = async (options = {}) => {
         }
 
         // Set up message loop poller
-        instance._pollInterval = setInterval(() => {
-            try {
-                darling.pollEvents();
-            } catch (e) {
-                console.error('Failed polling events:', e);
-                instance.close();
-                if (onError) onError(e);
-            }
-        }, 1000 / frameRate);
+        const pollMs = 1000 / frameRate;
+        instance._startPolling(pollMs, onError);
+
+        // Refresh the snapshot while the app runs, so a crash or kill still
+        // leaves a recent one; nothing changes on screen while throttled
+        if (options.snapshot && snapshotIntervalMs > 0) {
+            instance._snapshotInterval = setInterval(() => {
+                if (instance.throttled) return;
+                instance.saveSnapshot().catch((e) => console.warn('Failed to save window snapshot:', e));
+            }, snapshotIntervalMs);
+        }
 
         // Handle native window close
         darling.onCloseRequestedForWindow(darlingWindowHandle, () => {
@@ -542,6 +1405,52 @@ export const CreateWindow = async (options = {}) => {
             instance.close();
         });
 
+        // Push DPI changes (monitor moves) instead of polling getDpi()
+        darling.onDpiChangedForWindow(darlingWindowHandle, (dpi) => {
+            if (instance._hitRegions) {
+                instance.setHitRegions(instance._hitRegions);
+            }
+            instance.emit('dpi-changed', dpi, dpi / 96);
+        });
+
+        // The backing store was released while hidden; the next frame must be re-rendered
+        darling.onFrameRequestedForWindow(darlingWindowHandle, () => {
+            instance.emit('frame-requested');
+        });
+
+        // The virtual surface needs tiles it does not have
+        darling.onTilesRequestedForWindow(darlingWindowHandle, (pairs) => {
+            const tiles = [];
+            for (let i = 0; i + 1 < pairs.length; i += 2) {
+                tiles.push({ col: pairs[i], row: pairs[i + 1] });
+            }
+            instance.emit('tiles-requested', tiles);
+        });
+
+        // Hidden, minimized or covered windows skip presents; producers
+        // should pause (rate 0) or slow to `rate` frames per second until
+        // the window is throttled no more
+        darling.onVisibilityChangedForWindow(darlingWindowHandle, (visibility, throttled, rate) => {
+            instance.visibility = VISIBILITIES[visibility] ?? 'visible';
+            instance.throttled = throttled;
+            instance.producerRate = rate;
+            if (!instance.closed) {
+                const ms = throttled ? Math.max(pollMs, THROTTLED_POLL_MS) : pollMs;
+                if (ms !== instance._pollMs) instance._startPolling(ms, onError);
+            }
+            instance.emit('visibility-changed', { visibility: instance.visibility, throttled, rate });
+        });
+
+        // A native tween ended; settle its promise
+        darling.onAnimationDoneForWindow(darlingWindowHandle, (id, property, finished) => {
+            const resolve = instance._animations.get(id);
+            if (resolve) {
+                instance._animations.delete(id);
+                resolve(finished);
+            }
+            instance.emit('animation-done', { property: ANIM_PROPERTIES[property], finished });
+        });
+
         // Handle app quit
         const cleanupHandler = () => {
             if (!instance.closed) {
@@ -569,6 +1478,9 @@ export const CreateWindow = async (options = {}) => {
             } catch (e) {
                 console.error('Failed to cleanup darling window:', e);
             }
+        } else if (createPromise) {
+            // Failed before the native window arrived; destroy it when it does
+            createPromise.then((handle) => darling.destroyWindow(handle), () => {});
         }
         
         if (browserWindow && !browserWindow.isDestroyed()) {
@@ -590,4 +1502,123 @@ export const GetMainWindow = () => {
     return null;
 };
 
+/**
+ * Cap the memory used by backing stores of all Darling windows
+ * @param {number} bytes - Budget in bytes (0 = unlimited)
+ * @param {'release'|'compress'} [mode='release'] - What happens to hidden windows over budget
+ */
+export const SetMemoryBudget = (bytes, mode = 'release') => {
+    darling.setMemoryBudget(bytes, EVICTION_MODES[mode] ?? 0);
+};
+
+/**
+ * Throttle windows that cannot be seen: their presents are skipped and
+ * producers are asked to pause or slow down. On unless set otherwise before
+ * the first window is created.
+ * @param {Object|null} [policy] - null turns throttling off
+ * @param {boolean} [policy.throttleOccluded=true] - Also throttle windows covered by others
+ * @param {number} [policy.occludedRate=0] - Frames per second asked of producers while covered
+ * @param {number} [policy.minimizedRate=0] - ... while minimized
+ * @param {number} [policy.hiddenRate=0] - ... while hidden
+ * @param {number} [policy.checkMs=250] - How often occlusion is checked
+ */
+export const SetThrottlePolicy = (policy = {}) => {
+    throttlePolicySet = true;
+    darling.setThrottlePolicy(policy === null ? null : { enabled: true, ...policy });
+};
+
+/**
+ * Get process-wide backing-store memory stats
+ * @returns {object}
+ */
+export const GetMemoryStats = () => darling.getMemoryStats();
+
+/**
+ * Size the thread pool that splits large frame copies, conversions and
+ * compositing into row bands
+ * @param {number} [threads=0] - Threads taking part, including the caller (0 = one per CPU, 1 = none)
+ * @param {number[]} [cpus=[]] - CPU indices (0-63) to pin workers to, round-robin
+ */
+export const SetThreadPool = (threads = 0, cpus = []) => {
+    let mask = 0n;
+    for (const cpu of cpus) mask |= 1n << BigInt(cpu);
+    darling.setThreadPool(threads, mask);
+};
+
+/**
+ * Get frame thread pool counters
+ * @returns {object}
+ */
+export const GetThreadPoolStats = () => darling.getThreadPoolStats();
+
+/**
+ * Get UI thread queue counters and this thread's unsettled async calls
+ * @returns {object}
+ */
+export const GetUiThreadStats = () => darling.getUiThreadStats();
+
+/**
+ * Describe a splash snapshot file
+ * @param {string} path
+ * @returns {object|null} null if missing or invalid
+ */
+export const ReadSnapshotInfo = (path) => darling.readSnapshotInfo(path);
+
+/**
+ * Builds the words of a display list for drawList(). Colors are
+ * 0xAARRGGBB; reset() and rebuild each update, and keep commands in the
+ * same order so unchanged ones are recognized.
+ */
+export class DisplayList {
+    constructor(capacity = 1024) {
+        this.words = new Uint32Array(capacity);
+        this.length = 0;
+    }
+
+    reset() {
+        this.length = 0;
+        return this;
+    }
+
+    command(op, operands) {
+        const length = operands.length + 1;
+        if (this.length + length > this.words.length) {
+            const grown = new Uint32Array(Math.max(this.words.length * 2, this.length + length));
+            grown.set(this.words.subarray(0, this.length));
+            this.words = grown;
+        }
+        this.words[this.length] = op | (length << 8);
+        this.words.set(operands, this.length + 1);
+        this.length += length;
+        return this;
+    }
+
+    rect(x, y, width, height, color) {
+        return this.command(DRAW_OPS.rect, [x, y, width, height, color]);
+    }
+
+    line(x0, y0, x1, y1, color, width = 1) {
+        return this.command(DRAW_OPS.line, [x0, y0, x1, y1, color, width]);
+    }
+
+    // Draw width x height of an uploaded image from (srcX, srcY) at x, y
+    image(id, x, y, width, height, srcX = 0, srcY = 0) {
+        return this.command(DRAW_OPS.image, [id, x, y, srcX, srcY, width, height]);
+    }
+
+    // Glyphs are { dx, dy, srcX, srcY, width, height } cells of an
+    // uploaded atlas whose alpha is the coverage, tinted by color
+    glyphs(atlas, color, x, y, glyphs) {
+        const operands = [atlas, color, x, y];
+        for (const g of glyphs) {
+            operands.push((g.dx & 0xFFFF) | (g.dy << 16), g.srcX | (g.srcY << 16), g.width | (g.height << 16));
+        }
+        return this.command(DRAW_OPS.glyphs, operands);
+    }
+
+    finish() {
+        return this.words.subarray(0, this.length);
+    }
+}
+
 export default CreateWindow;
@@ -0,0 +1,15 @@
+import type { DarlingWorkerHandle } from './darling';
+
+export interface DarlingWorkerPaintOptions {
+    format?: 'bgra' | 'rgba';
+    frameId?: number;           // 0 or omitted = untagged
+}
+
+export interface DarlingWorkerSurface {
+    readonly hwnd: bigint;
+    readonly alive: boolean;    // false once the window has been destroyed
+    paint(buffer: Buffer | ArrayBuffer | ArrayBufferView, width: number, height: number, options?: DarlingWorkerPaintOptions): boolean;
+    presentFrameRing(): boolean;
+}
+
+export function createWorkerSurface(handle: DarlingWorkerHandle): DarlingWorkerSurface;
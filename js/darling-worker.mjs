@@ -0,0 +1,39 @@
+// Worker-side painting. Import this (darling/worker) inside a worker_thread
+// to render off the main Electron thread: the main thread passes
+// DarlingWindowInstance.getWorkerHandle() through postMessage, and frames
+// are painted straight from the worker's Buffers, typed arrays or
+// ArrayBuffers. Nothing here imports electron.
+import { createRequire } from 'module';
+
+const require = createRequire(import.meta.url);
+const darling = require('./darling-bridge.cjs');
+
+// DarlingPixelFormat (darling.h)
+const PIXEL_FORMATS = { bgra: 0, rgba: 1 };
+
+export function createWorkerSurface(handle) {
+    const hwnd = BigInt.asUintN(64, BigInt(handle.hwnd));
+    let alive = true;
+
+    return {
+        hwnd,
+
+        // Paint a frame. The pixels are copied before this returns, so the
+        // buffer can be reused or transferred back to its owner right away.
+        // Returns false once the window has been destroyed.
+        paint(buffer, width, height, { format = 'bgra', frameId } = {}) {
+            if (!alive) return false;
+            alive = darling.paintFrameHwnd(hwnd, buffer, width, height, PIXEL_FORMATS[format] ?? 0, frameId);
+            return alive;
+        },
+
+        // Present the newest frame of the window's shared-memory frame ring
+        presentFrameRing() {
+            return alive && darling.frameRingPresentHwnd(hwnd);
+        },
+
+        get alive() {
+            return alive;
+        },
+    };
+}
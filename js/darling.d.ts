@@ -3,6 +3,408 @@ import { EventEmitter } from 'events';
 
 export type DarlingCornerPreference = 0 | 1 | 2 | 3;
 
+export interface DarlingStartupStage {
+    // Offsets (ms) relative to the start of CreateWindow
+    start: number;
+    end: number | null;
+    duration: number | null;
+}
+
+export interface DarlingAsyncTiming {
+    // ms on the inputNow clock
+    queuedMs: number;       // submitted until the UI thread started it
+    runMs: number;          // native work
+    settleMs: number;       // back to the calling thread
+    totalMs: number;
+    uiThread: boolean;      // false if it ran inline on the calling thread
+}
+
+export interface DarlingStartupTimings {
+    // performance.timeOrigin-based timestamp of the pipeline start
+    origin: number;
+    total: number;
+    // nativeCreate, browserCreate, load, firstPaint, appearance, embed, nativeStyles, show
+    stages: Record<string, DarlingStartupStage>;
+    // create, appearance, show: the native calls run on the UI thread
+    ops: Record<string, DarlingAsyncTiming>;
+    // Native window creation to the splash snapshot's first pixel, or null
+    splashFirstPixel: number | null;
+}
+
+export interface DarlingLayoutSizing {
+    size?: number;
+    weight?: number;
+    name?: string;
+}
+
+export type DarlingLayoutSpec =
+    | (DarlingLayoutSizing & { window: BrowserWindow })
+    | (DarlingLayoutSizing & { split: 'horizontal' | 'vertical'; children: DarlingLayoutSpec[] })
+    | (DarlingLayoutSizing & { stack: DarlingLayoutSpec[]; active?: number });
+
+export type DarlingHitKind =
+    | 'client' | 'caption' | 'minimize' | 'maximize' | 'close'
+    | 'left' | 'right' | 'top' | 'bottom'
+    | 'top-left' | 'top-right' | 'bottom-left' | 'bottom-right';
+
+export interface DarlingHitRegion {
+    kind: DarlingHitKind;
+    // CSS px; give at most two per axis, a missing edge stretches to the window edge
+    left?: number;
+    width?: number;
+    right?: number;
+    top?: number;
+    height?: number;
+    bottom?: number;
+}
+
+export interface DarlingMemoryStats {
+    backingBytes: number;
+    compressedBytes: number;
+    gdiObjects: number;
+    backingStores: number;
+    evictedStores: number;
+    evictions: number;
+    restores: number;
+    frameRequests: number;
+    budgetBytes: number;
+}
+
+export type DarlingEvictionMode = 'release' | 'compress';
+
+export type DarlingInputType =
+    | 'mouse-move' | 'mouse-down' | 'mouse-up' | 'wheel' | 'hwheel'
+    | 'key-down' | 'key-up' | 'char'
+    | 'touch-down' | 'touch-move' | 'touch-up' | 'mouse-leave';
+
+export interface DarlingInputEvent {
+    time: number;           // ms on the darling input clock (monotonic)
+    type: DarlingInputType | null;
+    modifiers: number;      // DARLING_INPUT_MOD_* | DARLING_INPUT_BUTTON_* flags
+    x: number;              // client px
+    y: number;
+    code: number;           // button, virtual-key, character or pointer id
+    value: number;          // wheel delta, scan code or pointer type
+    shiftKey: boolean;
+    ctrlKey: boolean;
+    altKey: boolean;
+    metaKey: boolean;
+}
+
+export interface DarlingFrameRecord {
+    frameId: number;
+    // ms on the inputNow clock
+    submit: number;
+    entry: number;
+    copied: number;
+    invalidated: number;
+    paintStart: number;
+    presented: number | null;   // null if a newer frame replaced it
+}
+
+export interface DarlingLatencySummary {
+    count: number;
+    mean: number;               // ms
+    p50: number;
+    p90: number;
+    p99: number;
+    max: number;
+}
+
+export interface DarlingFrameTiming {
+    presented: number;
+    superseded: number;
+    fps: number;
+    producer: DarlingLatencySummary;    // submit -> native entry
+    copy: DarlingLatencySummary;        // entry -> pixels in the backing store
+    invalidate: DarlingLatencySummary;  // copy -> repaint requested
+    queue: DarlingLatencySummary;       // repaint requested -> WM_PAINT
+    blit: DarlingLatencySummary;        // WM_PAINT -> on screen
+    total: DarlingLatencySummary;       // submit -> on screen
+}
+
+export interface DarlingThreadPoolStats {
+    workers: number;            // worker threads running (the caller also takes part)
+    jobs: number;               // operations split across the pool
+    inlineJobs: number;         // operations small enough to run on the caller
+    bands: number;
+    steals: number;             // bands taken from another thread's queue
+}
+
+export interface DarlingCompositorStats {
+    layers: number;
+    damageRects: number;        // waiting for the next paint
+    flushes: number;
+    compositedPixels: number;
+    culledPixels: number;       // skipped under opaque layers
+}
+
+export interface DarlingLayerOptions {
+    // Client px
+    x?: number;
+    y?: number;
+    width: number;
+    height: number;
+    z?: number;                 // window content is below every layer
+    opacity?: number;           // 0-255
+}
+
+export interface DarlingLayerRect {
+    x: number;
+    y: number;
+    width: number;
+    height: number;
+}
+
+export interface DarlingLayer {
+    readonly id: number;
+    // BGRA, straight alpha unless premultiplied; rect defaults to the whole layer
+    update(buffer: Buffer, rect?: DarlingLayerRect, premultiplied?: boolean): void;
+    move(x: number, y: number): void;
+    setZ(z: number): void;
+    setOpacity(opacity: number): void;
+    show(): void;
+    hide(): void;
+    destroy(): void;
+}
+
+export interface DarlingFrameRingOptions {
+    name: string;               // letters, digits, '.', '_', '-'
+    maxWidth: number;
+    maxHeight: number;
+    slots?: number;             // 3-8
+}
+
+export interface DarlingFrameRingStats {
+    slots: number;              // 0 when no ring is open
+    maxWidth: number;
+    maxHeight: number;
+    published: number;          // last sequence number the producer published
+    dropped: number;            // overwritten by the producer before being taken
+    presented: number;
+    skipped: number;            // published but never presented
+}
+
+export interface DarlingThumbnailStats {
+    levels: number;             // 0 until the first getThumbnail
+    width: number;              // largest level (half the backing store)
+    height: number;
+    bytes: number;
+    requests: number;
+    updatedPixels: number;      // level pixels recomputed from dirty regions
+    rebuilds: number;           // pyramids built from scratch
+}
+
+export interface DarlingSnapshotInfo {
+    width: number;              // frame size in physical pixels
+    height: number;
+    frames: number;             // more than 1 plays as a looping strip
+    frameMs: number;
+    x: number;                  // window rectangle when saved
+    y: number;
+    windowWidth: number;
+    windowHeight: number;
+    dpi: number;
+    flags: number;              // window state flags when saved
+}
+
+export interface DarlingSplashStats {
+    showing: boolean;           // no frame from the app yet
+    frames: number;
+    shown: number;              // splash frames presented
+    firstPixelMs: number;       // window creation to the first splash frame
+}
+
+export interface DarlingDrawStats {
+    commands: number;           // in the current list
+    images: number;
+    imageBytes: number;
+    submits: number;
+    reusedCommands: number;     // matched to the previous list, not redrawn for themselves
+    changedCommands: number;    // added, removed or edited
+    fullRedraws: number;
+    rasterPixels: number;       // pixels rasterized so far
+}
+
+export interface DarlingSurfaceOptions {
+    width: number;              // surface size in pixels
+    height: number;
+    tileSize?: number;          // power of two, 16 to 2048 (default 256)
+    budget?: number;            // bytes of cached tiles (default 64 MB)
+    background?: number;        // BGRA shown where a tile has not arrived yet
+}
+
+export interface DarlingSurfaceStats {
+    width: number;
+    height: number;
+    tileSize: number;
+    x: number;                  // viewport origin
+    y: number;
+    cachedTiles: number;
+    pendingTiles: number;       // requested, not uploaded yet
+    tileBytes: number;
+    budgetBytes: number;
+    hits: number;               // tile lookups while painting
+    misses: number;
+    requests: number;           // tiles asked for with 'tiles-requested'
+    uploads: number;
+    evictions: number;
+    scrolls: number;
+    shiftedPixels: number;      // reused from the previous viewport
+    copiedPixels: number;       // copied from tiles or filled
+    fullRedraws: number;
+}
+
+export interface DarlingTile {
+    col: number;
+    row: number;
+}
+
+export type DarlingVisibility = 'visible' | 'occluded' | 'minimized' | 'hidden';
+
+export interface DarlingThrottlePolicy {
+    throttleOccluded?: boolean; // also throttle windows covered by others (default true)
+    occludedRate?: number;      // frames per second asked of producers while covered (default 0)
+    minimizedRate?: number;
+    hiddenRate?: number;
+    checkMs?: number;           // how often occlusion is checked (default 250)
+}
+
+export interface DarlingVisibilityChange {
+    visibility: DarlingVisibility;
+    throttled: boolean;         // presents are skipped
+    rate: number;               // frames per second producers should send; 0 = pause
+}
+
+export interface DarlingPowerStats {
+    visibility: DarlingVisibility;
+    throttled: boolean;
+    rate: number;
+    transitions: number;        // visibility or throttling changes
+    presents: number;
+    skippedPresents: number;    // dropped while throttled
+    presentMs: number;          // wall time spent presenting
+    presentCpuMs: number;       // CPU time of the presenting thread
+    throttledMs: number;
+}
+
+export type DarlingPresentMode = 'opaque' | 'per-pixel-alpha';
+
+export interface DarlingPresentStats {
+    mode: DarlingPresentMode;
+    layeredPresents: number;
+    dirtyPixels: number;        // sent by layered presents
+    cleanPixels: number;        // left out of them as unchanged
+    convertedPixels: number;    // premultiplied or unpremultiplied natively
+}
+
+export type DarlingAnimProperty = 'opacity' | 'position' | 'size' | 'titlebar-color';
+export type DarlingEasing = 'linear' | 'ease' | 'ease-in' | 'ease-out' | 'ease-in-out' | [number, number, number, number];
+
+export interface DarlingAnimateOptions {
+    duration?: number;          // ms (default 250)
+    delay?: number;             // ms before it starts moving
+    easing?: DarlingEasing;     // CSS name or cubic-bezier x1, y1, x2, y2 (default 'ease')
+    from?: number | [number, number];   // default: where the property is now
+}
+
+export interface DarlingAnimationDone {
+    property: DarlingAnimProperty;
+    finished: boolean;          // false if cancelled or replaced
+}
+
+export interface DarlingAnimationStats {
+    active: number;             // tweens running
+    refreshMs: number;          // tick period, from the window's monitor
+    started: number;
+    finished: number;
+    cancelled: number;
+    ticks: number;              // ticks that moved something
+    applied: number;            // property writes
+}
+
+export interface DarlingGlyph {
+    dx: number;                 // offset from the glyphs command's x, y
+    dy: number;
+    srcX: number;               // cell in the atlas image
+    srcY: number;
+    width: number;
+    height: number;
+}
+
+// Builds the words of a display list; colors are 0xAARRGGBB
+export class DisplayList {
+    constructor(capacity?: number);
+    readonly length: number;
+    reset(): this;
+    command(op: number, operands: number[]): this;
+    rect(x: number, y: number, width: number, height: number, color: number): this;
+    line(x0: number, y0: number, x1: number, y1: number, color: number, width?: number): this;
+    image(id: number, x: number, y: number, width: number, height: number, srcX?: number, srcY?: number): this;
+    glyphs(atlas: number, color: number, x: number, y: number, glyphs: DarlingGlyph[]): this;
+    finish(): Uint32Array;
+}
+
+// Mirrored native window state, in physical pixels
+export interface DarlingWindowState {
+    visible: boolean;
+    focused: boolean;
+    minimized: boolean;
+    maximized: boolean;
+    darkMode: boolean;
+    dpi: number;
+    scaleFactor: number;
+    clientWidth: number;
+    clientHeight: number;
+    x: number;                  // window rect, screen coordinates
+    y: number;
+    width: number;
+    height: number;
+}
+
+// One decoded 4:2:0 frame. Chroma planes are ceil(width / 2) samples wide
+// (pairs for NV12, all in `u`) and ceil(height / 2) rows high; strides
+// default to tightly packed rows.
+export interface DarlingYuvFrame {
+    width: number;
+    height: number;
+    layout?: 'i420' | 'nv12';               // default 'i420'
+    matrix?: 'bt601' | 'bt709';             // default 'bt709'
+    range?: 'limited' | 'full';             // default 'limited'
+    y: Buffer | ArrayBuffer | ArrayBufferView;
+    u: Buffer | ArrayBuffer | ArrayBufferView;
+    v?: Buffer | ArrayBuffer | ArrayBufferView;
+    yStride?: number;
+    uStride?: number;
+    vStride?: number;
+}
+
+export interface DarlingYuvPaintOptions {
+    scaleToClient?: boolean;    // resample to the client size instead of sizing the window's store to the frame
+    frameId?: number;
+}
+
+// Structured-cloneable; see darling/worker
+export interface DarlingWorkerHandle {
+    hwnd: bigint;
+}
+
+export interface DarlingInputStats {
+    capacity: number;
+    pending: number;
+    written: number;
+    dropped: number;
+}
+
+export interface DarlingUiThreadStats {
+    running: boolean;
+    pending: number;        // tasks queued
+    peak: number;           // most tasks queued at once
+    posted: number;
+    run: number;
+    inFlight: number;       // async calls of this thread not yet settled
+}
+
 export interface DarlingWindowOptions {
     // Window dimensions
     width?: number;
@@ -24,6 +426,11 @@ export interface DarlingWindowOptions {
         titlebar?: 'dark' | 'light';
         content?: 'dark' | 'light';
     } | 'dark' | 'light';
+
+    // Splash snapshot: shown at once on launch if the file is valid, and
+    // refreshed from the page every snapshotIntervalMs (0: only on saveSnapshot())
+    snapshot?: string;
+    snapshotIntervalMs?: number;
     
     // Win32 Native styles 
     nativeStylesAdd?: number;
@@ -50,6 +457,10 @@ export interface DarlingWindowInstance extends EventEmitter {
     readonly closed: boolean;
     readonly isDestroyed: boolean;
     readonly webContents: Electron.WebContents;
+    readonly startupTimings: DarlingStartupTimings | null;
+    readonly visibility: DarlingVisibility;
+    readonly throttled: boolean;
+    readonly producerRate: number;      // frames per second asked of producers while throttled
     
     // Methods
     close(): void;
@@ -69,9 +480,57 @@ export interface DarlingWindowInstance extends EventEmitter {
     setAlwaysOnTop(enable: boolean): void;
     setTitlebarColor(color: number): void;
     setCornerPreference(preference: DarlingCornerPreference): void;
+    updateAppearance(update: (win: DarlingWindowInstance) => void): void;
+    setLayout(spec: DarlingLayoutSpec): Record<string, number>;
+    setLayoutActive(node: string | number, index: number): void;
+    setLayoutSize(node: string | number, sizing?: { size?: number; weight?: number }): void;
+    setHitRegions(regions: DarlingHitRegion[]): void;
+    hitTest(x: number, y: number): DarlingHitKind | null;
     flashWindow(continuous?: boolean): void;
     getDpi(): number;
     getScaleFactor(): number;
+    getMemoryStats(): DarlingMemoryStats | null;
+    enableInput(capacity?: number): number;
+    disableInput(): void;
+    drainInput(): DarlingInputEvent[];
+    drainInput(fn: (event: DarlingInputEvent) => void): null;
+    getInputStats(): DarlingInputStats | null;
+    paintFrame(buffer: Buffer | ArrayBuffer | ArrayBufferView, width: number, height: number, frameId?: number): number;
+    paintYuv(frame: DarlingYuvFrame, options?: DarlingYuvPaintOptions): number;
+    getWorkerHandle(): DarlingWorkerHandle | null;
+    getFrameRecord(frameId: number): DarlingFrameRecord | null;
+    getFrameTiming(): DarlingFrameTiming | null;
+    resetFrameTiming(): void;
+    setFrameOverlay(enable: boolean): void;
+    createLayer(options: DarlingLayerOptions): DarlingLayer | null;
+    getCompositorStats(): DarlingCompositorStats | null;
+    createFrameRing(options: DarlingFrameRingOptions): boolean;
+    closeFrameRing(): void;
+    presentFrameRing(): boolean;
+    getFrameRingStats(): DarlingFrameRingStats | null;
+    getThumbnail(width: number, height: number): Buffer | null;   // BGRA, width * 4 bytes per row
+    releaseThumbnails(): void;
+    getThumbnailStats(): DarlingThumbnailStats | null;
+    saveSnapshot(): Promise<boolean>;
+    getSplashStats(): DarlingSplashStats | null;
+    drawList(list: DisplayList | Uint32Array, background?: number): boolean;
+    uploadImage(id: number, buffer: Buffer | ArrayBuffer | ArrayBufferView, width: number, height: number, premultiplied?: boolean): boolean;
+    releaseImage(id: number): void;
+    getDrawStats(): DarlingDrawStats | null;
+    createSurface(options: DarlingSurfaceOptions): boolean;
+    closeSurface(): void;
+    uploadTile(col: number, row: number, buffer: Buffer | ArrayBuffer | ArrayBufferView): boolean;  // tileSize * tileSize BGRA
+    scrollSurfaceTo(x: number, y: number): void;
+    invalidateSurface(x: number, y: number, width: number, height: number): void;
+    getSurfaceStats(): DarlingSurfaceStats | null;
+    getPowerStats(): DarlingPowerStats | null;
+    setPresentMode(mode: DarlingPresentMode): boolean;
+    getPresentStats(): DarlingPresentStats | null;
+    animate(property: 'opacity' | 'titlebar-color', to: number, options?: DarlingAnimateOptions): Promise<boolean>;
+    animate(property: 'position' | 'size', to: [number, number], options?: DarlingAnimateOptions): Promise<boolean>;
+    cancelAnimations(): void;
+    getAnimationStats(): DarlingAnimationStats | null;
+    getState(): DarlingWindowState | null;    // null when no mirror is attached
     minimize(): void;
     maximize(): void;
     restore(): void;
@@ -84,9 +543,21 @@ export interface DarlingWindowInstance extends EventEmitter {
     on(event: 'move', listener: (x: number, y: number) => void): this;
     on(event: 'focus', listener: () => void): this;
     on(event: 'blur', listener: () => void): this;
+    on(event: 'dpi-changed', listener: (dpi: number, scaleFactor: number) => void): this;
+    on(event: 'frame-requested', listener: () => void): this;
+    on(event: 'tiles-requested', listener: (tiles: DarlingTile[]) => void): this;
+    on(event: 'visibility-changed', listener: (change: DarlingVisibilityChange) => void): this;
+    on(event: 'animation-done', listener: (done: DarlingAnimationDone) => void): this;
 }
 
 export function CreateWindow(options?: DarlingWindowOptions): Promise<DarlingWindowInstance>;
 export function GetMainWindow(): DarlingWindowInstance | null;
+export function SetMemoryBudget(bytes: number, mode?: DarlingEvictionMode): void;
+export function GetMemoryStats(): DarlingMemoryStats;
+export function SetThrottlePolicy(policy?: DarlingThrottlePolicy | null): void;    // on by default
+export function SetThreadPool(threads?: number, cpus?: number[]): void;
+export function GetThreadPoolStats(): DarlingThreadPoolStats;
+export function GetUiThreadStats(): DarlingUiThreadStats;
+export function ReadSnapshotInfo(path: string): DarlingSnapshotInfo | null;
 
 export default CreateWindow;
@@ -19,6 +19,21 @@ try {
       onCloseRequestedForWindow: () => {
         throw new Error("Darling native addon not loaded");
       },
+      onDpiChangedForWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      onFrameRequestedForWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      onTilesRequestedForWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      onVisibilityChangedForWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      onAnimationDoneForWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
       setParent: () => {
         throw new Error("Darling native addon not loaded");
       },
@@ -58,6 +73,45 @@ try {
       setCornerPreference: () => {
         throw new Error("Darling native addon not loaded");
       },
+      beginAppearanceUpdate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      commitAppearanceUpdate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutAdd: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutSetChild: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutSetSize: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutSetActive: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutClear: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layoutApply: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hitRegionAdd: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hitRegionSet: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hitRegionRemove: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hitRegionClear: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hitTest: () => {
+        throw new Error("Darling native addon not loaded");
+      },
       flashWindow: () => {
         throw new Error("Darling native addon not loaded");
       },
@@ -67,6 +121,201 @@ try {
       getScaleFactor: () => {
         throw new Error("Darling native addon not loaded");
       },
+      setMemoryBudget: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getMemoryStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setThreadPool: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getThreadPoolStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getWindowMemoryStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      inputRingBytes: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      attachInputRing: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      detachInputRing: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getInputStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      stateMirrorBytes: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      attachStateMirror: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      detachStateMirror: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      inputNow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      paintFrameWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      paintFrameHwnd: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      paintYuvWindow: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      frameRingPresentHwnd: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getFrameRecord: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getFrameTiming: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      resetFrameTiming: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setFrameOverlay: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerCreate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerDestroy: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerSetPosition: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerSetZ: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerSetOpacity: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerSetVisible: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      layerUpdate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getCompositorStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      frameRingCreate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      frameRingClose: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      frameRingPresent: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getFrameRingStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getThumbnail: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      releaseThumbnails: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getThumbnailStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      saveSnapshot: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      readSnapshotInfo: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setSplashSnapshot: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      endSplash: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getSplashStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      drawSubmit: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      drawImageUpload: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      drawImageRelease: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getDrawStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      surfaceCreate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      surfaceClose: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      surfaceUploadTile: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      surfaceScrollTo: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      surfaceInvalidate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getSurfaceStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setThrottlePolicy: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getPowerStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setPresentMode: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getPresentStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      animate: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      animateCancel: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getAnimationStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      createWindowAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      setAppearanceAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      showWindowAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      hideWindowAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      focusWindowAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      cancelAsync: () => {
+        throw new Error("Darling native addon not loaded");
+      },
+      getUiThreadStats: () => {
+        throw new Error("Darling native addon not loaded");
+      },
     };
   }
 }
@@ -76,6 +325,20 @@ export const destroyWindow = (win: any) => native.destroyWindow(win);
 export const onCloseRequested = (cb: () => void) => native.onCloseRequested(cb);
 export const onCloseRequestedForWindow = (win: any, cb: () => void) =>
   native.onCloseRequestedForWindow(win, cb);
+export const onDpiChangedForWindow = (win: any, cb: (dpi: number) => void) =>
+  native.onDpiChangedForWindow(win, cb);
+export const onFrameRequestedForWindow = (win: any, cb: () => void) =>
+  native.onFrameRequestedForWindow(win, cb);
+export const onTilesRequestedForWindow = (win: any, cb: (tiles: number[]) => void) =>
+  native.onTilesRequestedForWindow(win, cb);
+export const onVisibilityChangedForWindow = (
+  win: any,
+  cb: (visibility: number, throttled: boolean, rate: number) => void
+) => native.onVisibilityChangedForWindow(win, cb);
+export const onAnimationDoneForWindow = (
+  win: any,
+  cb: (id: number, property: number, finished: boolean) => void
+) => native.onAnimationDoneForWindow(win, cb);
 export const showDarlingWindow = (win: any) => native.showDarlingWindow(win);
 export const hideDarlingWindow = (win: any) => native.hideDarlingWindow(win);
 export const focusDarlingWindow = (win: any) => native.focusDarlingWindow(win);
@@ -122,7 +385,200 @@ export const setTitlebarColor = (win: any, color: number) =>
   native.setTitlebarColor(win, color);
 export const setCornerPreference = (win: any, pref: number) =>
   native.setCornerPreference(win, pref);
+export const beginAppearanceUpdate = (win: any) =>
+  native.beginAppearanceUpdate(win);
+export const commitAppearanceUpdate = (win: any) =>
+  native.commitAppearanceUpdate(win);
+export const layoutAdd = (
+  win: any,
+  parent: number,
+  kind: number,
+  fixed: number,
+  weight: number
+): number => native.layoutAdd(win, parent, kind, fixed, weight);
+export const layoutSetChild = (win: any, node: number, hwnd: bigint) =>
+  native.layoutSetChild(win, node, hwnd);
+export const layoutSetSize = (win: any, node: number, fixed: number, weight: number) =>
+  native.layoutSetSize(win, node, fixed, weight);
+export const layoutSetActive = (win: any, node: number, index: number) =>
+  native.layoutSetActive(win, node, index);
+export const layoutClear = (win: any) => native.layoutClear(win);
+export const layoutApply = (win: any) => native.layoutApply(win);
+export const hitRegionAdd = (
+  win: any,
+  kind: number,
+  left: number,
+  top: number,
+  right: number,
+  bottom: number,
+  anchors: number,
+): number => native.hitRegionAdd(win, kind, left, top, right, bottom, anchors);
+export const hitRegionSet = (
+  win: any,
+  id: number,
+  left: number,
+  top: number,
+  right: number,
+  bottom: number,
+  anchors: number,
+) => native.hitRegionSet(win, id, left, top, right, bottom, anchors);
+export const hitRegionRemove = (win: any, id: number) =>
+  native.hitRegionRemove(win, id);
+export const hitRegionClear = (win: any) => native.hitRegionClear(win);
+export const hitTest = (win: any, x: number, y: number): number =>
+  native.hitTest(win, x, y);
 export const flashWindow = (win: any, continuous: boolean) =>
   native.flashWindow(win, continuous);
 export const getDpi = (win: any) => native.getDpi(win);
 export const getScaleFactor = (win: any) => native.getScaleFactor(win);
+export const setMemoryBudget = (bytes: number, mode: number) =>
+  native.setMemoryBudget(bytes, mode);
+export const getMemoryStats = () => native.getMemoryStats();
+export const setThreadPool = (threads: number, affinityMask: number | bigint) =>
+  native.setThreadPool(threads, affinityMask);
+export const getThreadPoolStats = () => native.getThreadPoolStats();
+export const getWindowMemoryStats = (win: any) =>
+  native.getWindowMemoryStats(win);
+export const inputRingBytes = (capacity: number) =>
+  native.inputRingBytes(capacity);
+export const attachInputRing = (win: any, view: Uint8Array) =>
+  native.attachInputRing(win, view);
+export const detachInputRing = (win: any) => native.detachInputRing(win);
+export const getInputStats = (win: any) => native.getInputStats(win);
+export const stateMirrorBytes = () => native.stateMirrorBytes();
+export const attachStateMirror = (win: any, view: Int32Array) =>
+  native.attachStateMirror(win, view);
+export const detachStateMirror = (win: any) => native.detachStateMirror(win);
+export const inputNow = () => native.inputNow();
+export const paintFrameWindow = (
+  win: any,
+  buffer: Buffer | ArrayBuffer | ArrayBufferView,
+  w: number,
+  h: number,
+  frameId?: number,
+  submitTime?: number,
+) => native.paintFrameWindow(win, buffer, w, h, frameId, submitTime);
+export const paintFrameHwnd = (
+  hwnd: bigint,
+  buffer: Buffer | ArrayBuffer | ArrayBufferView,
+  w: number,
+  h: number,
+  format?: number,
+  frameId?: number,
+) => native.paintFrameHwnd(hwnd, buffer, w, h, format, frameId);
+export const frameRingPresentHwnd = (hwnd: bigint) => native.frameRingPresentHwnd(hwnd);
+export const paintYuvWindow = (
+  win: any,
+  frame: object,
+  scaleToClient?: boolean,
+  frameId?: number,
+  submitMs?: number,
+) => native.paintYuvWindow(win, frame, scaleToClient, frameId, submitMs);
+export const getFrameRecord = (win: any, frameId: number) =>
+  native.getFrameRecord(win, frameId);
+export const getFrameTiming = (win: any) => native.getFrameTiming(win);
+export const resetFrameTiming = (win: any) => native.resetFrameTiming(win);
+export const setFrameOverlay = (win: any, enable: boolean) =>
+  native.setFrameOverlay(win, enable);
+export const layerCreate = (
+  win: any,
+  x: number,
+  y: number,
+  w: number,
+  h: number,
+  z?: number,
+): number => native.layerCreate(win, x, y, w, h, z);
+export const layerDestroy = (win: any, id: number) =>
+  native.layerDestroy(win, id);
+export const layerSetPosition = (win: any, id: number, x: number, y: number) =>
+  native.layerSetPosition(win, id, x, y);
+export const layerSetZ = (win: any, id: number, z: number) =>
+  native.layerSetZ(win, id, z);
+export const layerSetOpacity = (win: any, id: number, opacity: number) =>
+  native.layerSetOpacity(win, id, opacity);
+export const layerSetVisible = (win: any, id: number, visible: boolean) =>
+  native.layerSetVisible(win, id, visible);
+export const layerUpdate = (
+  win: any,
+  id: number,
+  buffer: Buffer,
+  x: number,
+  y: number,
+  w: number,
+  h: number,
+  premultiplied?: boolean,
+) => native.layerUpdate(win, id, buffer, x, y, w, h, premultiplied);
+export const getCompositorStats = (win: any) => native.getCompositorStats(win);
+export const frameRingCreate = (
+  win: any,
+  name: string,
+  maxWidth: number,
+  maxHeight: number,
+  slots?: number,
+) => native.frameRingCreate(win, name, maxWidth, maxHeight, slots);
+export const frameRingClose = (win: any) => native.frameRingClose(win);
+export const frameRingPresent = (win: any) => native.frameRingPresent(win);
+export const getFrameRingStats = (win: any) => native.getFrameRingStats(win);
+export const getThumbnail = (win: any, width: number, height: number) => native.getThumbnail(win, width, height);
+export const releaseThumbnails = (win: any) => native.releaseThumbnails(win);
+export const getThumbnailStats = (win: any) => native.getThumbnailStats(win);
+export const saveSnapshot = (
+  win: any,
+  path: string,
+  frames?: Buffer | ArrayBuffer | ArrayBufferView,
+  width?: number,
+  height?: number,
+  count?: number,
+  frameMs?: number
+) => native.saveSnapshot(win, path, frames, width, height, count, frameMs);
+export const readSnapshotInfo = (path: string) => native.readSnapshotInfo(path);
+export const setSplashSnapshot = (path: string | null) => native.setSplashSnapshot(path);
+export const endSplash = (win: any) => native.endSplash(win);
+export const getSplashStats = (win: any) => native.getSplashStats(win);
+export const drawSubmit = (win: any, words: Uint32Array | ArrayBuffer, background?: number) =>
+  native.drawSubmit(win, words, background);
+export const drawImageUpload = (
+  win: any,
+  id: number,
+  pixels: Buffer | ArrayBuffer | ArrayBufferView,
+  width: number,
+  height: number,
+  premultiplied?: boolean
+) => native.drawImageUpload(win, id, pixels, width, height, premultiplied);
+export const drawImageRelease = (win: any, id: number) => native.drawImageRelease(win, id);
+export const getDrawStats = (win: any) => native.getDrawStats(win);
+export const surfaceCreate = (
+  win: any,
+  width: number,
+  height: number,
+  tileSize?: number,
+  budget?: number,
+  background?: number
+) => native.surfaceCreate(win, width, height, tileSize, budget, background);
+export const surfaceClose = (win: any) => native.surfaceClose(win);
+export const surfaceUploadTile = (
+  win: any,
+  col: number,
+  row: number,
+  pixels: Buffer | ArrayBuffer | ArrayBufferView
+) => native.surfaceUploadTile(win, col, row, pixels);
+export const surfaceScrollTo = (win: any, x: number, y: number) => native.surfaceScrollTo(win, x, y);
+export const surfaceInvalidate = (win: any, x: number, y: number, width: number, height: number) =>
+  native.surfaceInvalidate(win, x, y, width, height);
+export const getSurfaceStats = (win: any) => native.getSurfaceStats(win);
+export const setThrottlePolicy = (policy?: object | null) => native.setThrottlePolicy(policy);
+export const getPowerStats = (win: any) => native.getPowerStats(win);
+export const setPresentMode = (win: any, mode: number): boolean => native.setPresentMode(win, mode);
+export const getPresentStats = (win: any) => native.getPresentStats(win);
+export const animate = (win: any, tween: object): number => native.animate(win, tween);
+export const animateCancel = (win: any, id?: number) => native.animateCancel(win, id);
+export const getAnimationStats = (win: any) => native.getAnimationStats(win);
+export const createWindowAsync = (width: number, height: number, parentHwnd?: number | bigint) =>
+  native.createWindowAsync(width, height, parentHwnd);
+export const setAppearanceAsync = (win: any, appearance: object) =>
+  native.setAppearanceAsync(win, appearance);
+export const showWindowAsync = (win: any) => native.showWindowAsync(win);
+export const hideWindowAsync = (win: any) => native.hideWindowAsync(win);
+export const focusWindowAsync = (win: any) => native.focusWindowAsync(win);
+export const cancelAsync = (opId: number) => native.cancelAsync(opId);
+export const getUiThreadStats = () => native.getUiThreadStats();
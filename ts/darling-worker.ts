@@ -0,0 +1,54 @@
+// Worker-side painting. Import this inside a worker_thread to render off
+// the main Electron thread: the main thread passes
+// DarlingWindowInstance.getWorkerHandle() through postMessage, and frames
+// are painted straight from the worker's Buffers, typed arrays or
+// ArrayBuffers. Nothing here imports electron.
+import * as darling from "./darling-bridge";
+import type { DarlingWorkerHandle } from "./darling-electron-wrapper";
+
+// DarlingPixelFormat (darling.h)
+const PIXEL_FORMATS = { bgra: 0, rgba: 1 } as const;
+
+export interface DarlingWorkerPaintOptions {
+  format?: keyof typeof PIXEL_FORMATS;
+  frameId?: number;
+}
+
+export interface DarlingWorkerSurface {
+  readonly hwnd: bigint;
+  readonly alive: boolean;
+  paint(
+    buffer: Buffer | ArrayBuffer | ArrayBufferView,
+    width: number,
+    height: number,
+    options?: DarlingWorkerPaintOptions,
+  ): boolean;
+  presentFrameRing(): boolean;
+}
+
+export function createWorkerSurface(handle: DarlingWorkerHandle): DarlingWorkerSurface {
+  const hwnd = BigInt.asUintN(64, BigInt(handle.hwnd));
+  let alive = true;
+
+  return {
+    hwnd,
+
+    // Paint a frame. The pixels are copied before this returns, so the
+    // buffer can be reused or transferred back to its owner right away.
+    // Returns false once the window has been destroyed.
+    paint(buffer, width, height, { format = "bgra", frameId } = {}) {
+      if (!alive) return false;
+      alive = darling.paintFrameHwnd(hwnd, buffer, width, height, PIXEL_FORMATS[format] ?? 0, frameId);
+      return alive;
+    },
+
+    // Present the newest frame of the window's shared-memory frame ring
+    presentFrameRing() {
+      return alive && darling.frameRingPresentHwnd(hwnd);
+    },
+
+    get alive() {
+      return alive;
+    },
+  };
+}